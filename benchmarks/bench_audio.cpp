@@ -0,0 +1,90 @@
+#include "benchmark_support.hpp"
+#include "adaptive_audio_processor.hpp"
+#include "audio_analyzer.hpp"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace AnantaSound;
+using BenchmarkSupport::AllocationMeter;
+using BenchmarkSupport::reportSamples;
+
+namespace {
+
+template<typename Sample>
+std::vector<Sample> testSignal(size_t count) {
+    std::vector<Sample> signal(count);
+    uint32_t state = 1;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        double noise = static_cast<double>(state >> 8) / 8388608.0 - 1.0;
+        signal[i] = static_cast<Sample>(0.5 * std::sin(2.0 * M_PI * 440.0 * i / 44100.0) + 0.05 * noise);
+    }
+    return signal;
+}
+
+// One frame per iteration into a reused result (the zero-allocation path)
+template<typename Sample>
+void BM_AnalyzeAudio(benchmark::State& state) {
+    size_t fft_size = static_cast<size_t>(state.range(0));
+    AudioAnalyzer analyzer(fft_size, 44100);
+    analyzer.initialize();
+    std::vector<Sample> frame = testSignal<Sample>(fft_size);
+    BasicAudioAnalysisResult<Sample> result;
+    analyzer.analyzeAudio(frame.data(), frame.size(), result);
+
+    AllocationMeter allocations;
+    for (auto _ : state) {
+        analyzer.analyzeAudio(frame.data(), frame.size(), result);
+        benchmark::DoNotOptimize(result.spectral_centroid);
+    }
+    allocations.report(state);
+    reportSamples(state, fft_size);
+}
+
+// Analysis, emotion detection and the effects chain on one block
+template<typename Sample>
+void BM_AdaptiveChainRealtime(benchmark::State& state) {
+    size_t block = static_cast<size_t>(state.range(0));
+    AdaptiveAudioProcessor processor(1024, 44100);
+    processor.initialize();
+    processor.prepareRealtime();
+    std::vector<Sample> input = testSignal<Sample>(block);
+    std::vector<Sample> output(block);
+    processor.processRealtime(input.data(), output.data(), block);
+
+    AllocationMeter allocations;
+    for (auto _ : state) {
+        RealtimeAdaptation adaptation = processor.processRealtime(input.data(), output.data(), block);
+        benchmark::DoNotOptimize(adaptation);
+        benchmark::DoNotOptimize(output.data());
+    }
+    allocations.report(state);
+    reportSamples(state, block);
+}
+
+// The offline entry point, which allocates its result and may resample
+template<typename Sample>
+void BM_AdaptiveChainOffline(benchmark::State& state) {
+    size_t block = static_cast<size_t>(state.range(0));
+    AdaptiveAudioProcessor processor(1024, 44100);
+    processor.initialize();
+    std::vector<Sample> input = testSignal<Sample>(block);
+
+    AllocationMeter allocations;
+    for (auto _ : state) {
+        auto result = processor.processAudio(input);
+        benchmark::DoNotOptimize(result.processed_audio.data());
+    }
+    allocations.report(state);
+    reportSamples(state, block);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_AnalyzeAudio, double)->RangeMultiplier(2)->Range(256, 8192);
+BENCHMARK_TEMPLATE(BM_AnalyzeAudio, float)->RangeMultiplier(2)->Range(256, 8192);
+BENCHMARK_TEMPLATE(BM_AdaptiveChainRealtime, double)->Arg(256)->Arg(1024)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_AdaptiveChainRealtime, float)->Arg(256)->Arg(1024)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_AdaptiveChainOffline, double)->Arg(1024)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_AdaptiveChainOffline, float)->Arg(1024)->Arg(4096);
@@ -0,0 +1,274 @@
+#include "benchmark_support.hpp"
+#include "anantasound_core.hpp"
+#include "field_arena.hpp"
+#include "interference_backend.hpp"
+#include "interference_cluster_tree.hpp"
+#include "mechanical_devices.hpp"
+#include "thread_pool.hpp"
+#include <complex>
+#include <memory>
+#include <vector>
+
+using namespace AnantaSound;
+using BenchmarkSupport::AllocationMeter;
+using BenchmarkSupport::reportSamples;
+
+namespace {
+
+QuantumSoundField makeField(size_t index) {
+    QuantumSoundField field;
+    field.amplitude = std::complex<double>(1.0 / (1.0 + index % 7), 0.1);
+    field.frequency = 200.0 + 3.0 * static_cast<double>(index);
+    field.phase = 0.01 * static_cast<double>(index);
+    field.quantum_state = index % 3 ? QuantumSoundState::COHERENT : QuantumSoundState::SUPERPOSITION;
+    field.position = SphericalCoord(1.0 + 0.01 * (index % 500), 0.001 * index, 0.002 * index, 1.0);
+    return field;
+}
+
+// A 256-point dome map against a growing number of sources
+void BM_CalculateInterference(benchmark::State& state) {
+    size_t sources = static_cast<size_t>(state.range(0));
+    InterferenceField field(InterferenceFieldType::MIXED, SphericalCoord(0.0, 0.0, 0.0, 0.0), 10.0);
+    for (size_t i = 0; i < sources; ++i) {
+        field.addSourceField(makeField(i));
+    }
+    std::vector<SphericalCoord> positions;
+    for (size_t i = 0; i < 256; ++i) {
+        positions.emplace_back(2.0 + 0.01 * i, 0.01 * i, 0.02 * i, 1.0);
+    }
+    std::vector<std::complex<double>> output(positions.size());
+
+    AllocationMeter allocations;
+    double time = 0.0;
+    for (auto _ : state) {
+        field.calculateInterference(positions.data(), positions.size(), time, output.data());
+        benchmark::DoNotOptimize(output.data());
+        time += 1e-3;
+    }
+    allocations.report(state);
+    reportSamples(state, positions.size() * sources);      // Source-point evaluations
+}
+
+// Full-dome map: 16384 listener points through the CPU backend, serial or threaded
+void BM_InterferenceMap(benchmark::State& state) {
+    size_t sources = static_cast<size_t>(state.range(0));
+    InterferenceField field(InterferenceFieldType::MIXED, SphericalCoord(0.0, 0.0, 0.0, 0.0), 10.0);
+    for (size_t i = 0; i < sources; ++i) {
+        field.addSourceField(makeField(i));
+    }
+    std::vector<SphericalCoord> positions;
+    for (size_t i = 0; i < 16384; ++i) {
+        positions.emplace_back(2.0 + 0.0001 * i, 0.0001 * i, 0.0004 * i, 1.0);
+    }
+    InterferencePointGrid grid(positions);
+    std::vector<std::complex<double>> output(grid.size());
+
+    std::unique_ptr<ThreadPool> pool;
+    if (state.range(1)) {
+        pool = std::make_unique<ThreadPool>();
+    }
+    CPUInterferenceBackend backend(pool.get());
+    double time = 0.0;
+    for (auto _ : state) {
+        field.calculateInterferenceMap(grid, time, output.data(), backend);
+        benchmark::DoNotOptimize(output.data());
+        time += 1e-3;
+    }
+    reportSamples(state, grid.size() * sources);
+}
+
+// Seating-sized baked layout: per tick only the weights change, one amplitude per iteration
+void BM_BakedInterference(benchmark::State& state) {
+    size_t sources = static_cast<size_t>(state.range(0));
+    InterferenceField field(InterferenceFieldType::MIXED, SphericalCoord(0.0, 0.0, 0.0, 0.0), 10.0);
+    std::vector<InterferenceField::SourceHandle> handles;
+    for (size_t i = 0; i < sources; ++i) {
+        handles.push_back(field.addSourceField(makeField(i)));
+    }
+    std::vector<SphericalCoord> positions;
+    for (size_t i = 0; i < 2048; ++i) {
+        positions.emplace_back(2.0 + 0.0008 * i, 0.0008 * i, 0.003 * i, 1.0);
+    }
+    InterferencePointGrid grid(positions);
+    BakedInterferenceLayout layout;
+    field.bakeLayout(grid, layout);
+    std::vector<std::complex<double>> output(grid.size());
+
+    double time = 0.0;
+    size_t next = 0;
+    for (auto _ : state) {
+        field.setSourceAmplitude(handles[next], std::polar(1.0, time));
+        field.calculateBakedInterference(layout, time, output.data());
+        benchmark::DoNotOptimize(output.data());
+        next = (next + 1) % handles.size();
+        time += 1e-3;
+    }
+    reportSamples(state, grid.size() * sources);
+}
+
+// Full-dome map with one source amplitude changing per tick, incremental versus full
+void BM_IncrementalInterferenceMap(benchmark::State& state) {
+    size_t sources = static_cast<size_t>(state.range(0));
+    InterferenceField field(InterferenceFieldType::MIXED, SphericalCoord(0.0, 0.0, 0.0, 0.0), 10.0);
+    std::vector<InterferenceField::SourceHandle> handles;
+    for (size_t i = 0; i < sources; ++i) {
+        handles.push_back(field.addSourceField(makeField(i)));
+    }
+    std::vector<SphericalCoord> positions;
+    for (size_t i = 0; i < 16384; ++i) {
+        positions.emplace_back(2.0 + 0.0001 * i, 0.0001 * i, 0.0004 * i, 1.0);
+    }
+    InterferencePointGrid grid(positions);
+    std::vector<std::complex<double>> output(grid.size());
+    IncrementalInterferenceMap map(grid);
+    CPUInterferenceBackend backend;
+
+    double time = 0.0;
+    size_t next = 0;
+    for (auto _ : state) {
+        field.setSourceAmplitude(handles[next], std::polar(1.0, time));
+        if (state.range(1)) {
+            field.calculateIncrementalInterference(map, time, output.data());
+        } else {
+            field.calculateInterferenceMap(grid, time, output.data(), backend);
+        }
+        benchmark::DoNotOptimize(output.data());
+        next = (next + 1) % handles.size();
+        time += 1e-3;
+    }
+    reportSamples(state, grid.size() * sources);
+}
+
+// 64 listener points against packs of 256 sub-wavelength sources on eight frequencies,
+// exact versus the cluster tree at 1e-4
+void BM_ClusteredInterference(benchmark::State& state) {
+    size_t sources = static_cast<size_t>(state.range(0));
+    InterferenceField field(InterferenceFieldType::MIXED, SphericalCoord(0.0, 0.0, 0.0, 0.0), 10.0);
+    std::vector<QuantumSoundField> fields;
+    for (size_t i = 0; i < sources; ++i) {
+        QuantumSoundField source = makeField(i);
+        size_t pack = i / 256;
+        source.frequency = 110.0 * static_cast<double>(1 + pack % 8);
+        source.position = SphericalCoord(8.0 + 0.00002 * (i % 256), 0.01 * pack,
+                                         0.02 * pack + 0.000002 * (i % 256), 1.0);
+        fields.push_back(source);
+    }
+    field.addSourceFields(fields);
+    std::vector<SphericalCoord> positions;
+    for (size_t i = 0; i < 64; ++i) {
+        positions.emplace_back(1.0 + 0.01 * i, 0.02 * i, 0.05 * i, 1.0);
+    }
+    std::vector<std::complex<double>> output(positions.size());
+    InterferenceClusterTree tree(1e-4);
+    field.buildClusterTree(tree);
+
+    double time = 0.0;
+    for (auto _ : state) {
+        if (state.range(1)) {
+            field.calculateClusteredInterference(tree, positions.data(), positions.size(), time, output.data());
+        } else {
+            field.calculateInterference(positions.data(), positions.size(), time, output.data());
+        }
+        benchmark::DoNotOptimize(output.data());
+        time += 1e-3;
+    }
+    reportSamples(state, positions.size() * sources);
+}
+
+// 256 points against 64 devices emitting eight harmonics each: grouped batch
+// (frequency ladders) versus the same points queried one at a time
+void BM_HarmonicInterference(benchmark::State& state) {
+    InterferenceField field(InterferenceFieldType::MIXED, SphericalCoord(0.0, 0.0, 0.0, 0.0), 10.0);
+    std::vector<QuantumSoundField> fields;
+    for (size_t device = 0; device < 64; ++device) {
+        for (size_t harmonic = 1; harmonic <= 8; ++harmonic) {
+            QuantumSoundField source = makeField(device);
+            source.frequency = (216.0 + 3.0 * static_cast<double>(device)) * static_cast<double>(harmonic);
+            source.amplitude /= static_cast<double>(harmonic);
+            fields.push_back(source);
+        }
+    }
+    field.addSourceFields(fields);
+    std::vector<SphericalCoord> positions;
+    for (size_t i = 0; i < 256; ++i) {
+        positions.emplace_back(2.0 + 0.01 * i, 0.003 * i, 0.012 * i, 1.0);
+    }
+    std::vector<std::complex<double>> output(positions.size());
+
+    double time = 0.0;
+    for (auto _ : state) {
+        if (state.range(0)) {
+            field.calculateInterference(positions.data(), positions.size(), time, output.data());
+        } else {
+            for (size_t i = 0; i < positions.size(); ++i) {
+                output[i] = field.calculateInterference(positions[i], time);
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+        time += 1e-3;
+    }
+    reportSamples(state, positions.size() * fields.size());
+}
+
+// Single-field ingestion (lock, store, snapshot) cycling over a fixed set of positions
+void BM_ProcessSoundField(benchmark::State& state) {
+    size_t resident = static_cast<size_t>(state.range(0));
+    AnantaSoundCore core(10.0, 5.0);
+    core.initialize();
+    std::vector<QuantumSoundField> fields;
+    for (size_t i = 0; i < resident; ++i) {
+        fields.push_back(makeField(i));
+    }
+    core.processSoundFields(fields);
+
+    AllocationMeter allocations;
+    size_t next = 0;
+    for (auto _ : state) {
+        core.processSoundField(fields[next]);
+        next = next + 1 == fields.size() ? 0 : next + 1;
+    }
+    allocations.report(state);
+    reportSamples(state, 1);
+}
+
+void BM_GenerateAllDeviceFields(benchmark::State& state) {
+    size_t devices = static_cast<size_t>(state.range(0));
+    bool arena_backed = state.range(1) != 0;
+    SphericalCoord position{1.0, 0.5, 0.5, 1.0};
+    MechanicalDeviceManager manager;
+    for (size_t i = 0; i < devices; ++i) {
+        switch (i % 3) {
+            case 0: manager.addDevice(std::make_shared<KarmicCluster>(position, 7)); break;
+            case 1: manager.addDevice(std::make_shared<SpiritualMercy>(position, 0.5)); break;
+            default: manager.addDevice(std::make_shared<QuantumResonanceDevice>(position, 300.0 + i)); break;
+        }
+    }
+    std::vector<QuantumSoundField> output;
+    manager.generateAllDeviceFields(output);
+    FieldArena arena;
+
+    AllocationMeter allocations;
+    for (auto _ : state) {
+        if (arena_backed) {
+            arena.reset();
+            FieldVector fields = manager.generateAllDeviceFields(arena);
+            benchmark::DoNotOptimize(fields.data());
+        } else {
+            manager.generateAllDeviceFields(output);
+            benchmark::DoNotOptimize(output.data());
+        }
+    }
+    allocations.report(state);
+    reportSamples(state, output.size());                   // Fields produced
+}
+
+} // namespace
+
+BENCHMARK(BM_CalculateInterference)->RangeMultiplier(4)->Range(1, 1024);
+BENCHMARK(BM_InterferenceMap)->ArgsProduct({{64, 1024}, {0, 1}})->ArgNames({"sources", "threads"});
+BENCHMARK(BM_BakedInterference)->Arg(64)->Arg(512);
+BENCHMARK(BM_IncrementalInterferenceMap)->ArgsProduct({{64, 1024}, {0, 1}})->ArgNames({"sources", "incremental"});
+BENCHMARK(BM_ClusteredInterference)->ArgsProduct({{4096, 65536}, {0, 1}})->ArgNames({"sources", "clustered"});
+BENCHMARK(BM_HarmonicInterference)->Arg(0)->Arg(1)->ArgName("grouped");
+BENCHMARK(BM_ProcessSoundField)->Arg(64)->Arg(1024);
+BENCHMARK(BM_GenerateAllDeviceFields)->ArgsProduct({{12, 120, 1200}, {0, 1}})->ArgNames({"devices", "arena"});
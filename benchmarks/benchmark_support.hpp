@@ -0,0 +1,30 @@
+#pragma once
+
+#include "allocation_counter.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+
+namespace BenchmarkSupport {
+
+// Heap allocations made by the benchmark thread between construction and
+// report(), published as the "allocs/op" counter (averaged per iteration)
+class AllocationMeter {
+public:
+    AllocationMeter() : start_(TestSupport::allocationCount()) {}
+
+    void report(benchmark::State& state) const {
+        double allocations = static_cast<double>(TestSupport::allocationCount() - start_);
+        state.counters["allocs/op"] = benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    size_t start_;
+};
+
+// Publish `per_iteration` samples per iteration as a "samples/s" rate
+inline void reportSamples(benchmark::State& state, size_t per_iteration) {
+    double total = static_cast<double>(state.iterations()) * static_cast<double>(per_iteration);
+    state.counters["samples/s"] = benchmark::Counter(total, benchmark::Counter::kIsRate);
+}
+
+} // namespace BenchmarkSupport
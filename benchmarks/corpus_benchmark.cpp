@@ -0,0 +1,348 @@
+// End-to-end macro-benchmark over the samples corpus.
+// Every WAV and FLAC file in the samples directory is streamed block by
+// block through the full listener pipeline (AudioAnalyzer, the real-time
+// AdaptiveAudioProcessor path and BreathingAnalyzer) in each requested
+// mode. Decoding is timed separately from processing. The report is JSON:
+// realtime factor (audio seconds per processing second), p50/p99/max block
+// latency and the process peak RSS, so runs can be diffed between releases.
+// Files the reader cannot decode are listed under "skipped".
+//
+// Usage: anantasound_corpus_benchmark [--samples DIR] [--mode double|float|threaded|all]
+//                                     [--block N] [--max-seconds S] [--output FILE]
+
+#include "adaptive_audio_processor.hpp"
+#include "audio_analyzer.hpp"
+#include "audio_file_reader.hpp"
+#include "breathing_analyzer.hpp"
+#include "spectral_kernels.hpp"
+#include "thread_pool.hpp"
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef ANANTASOUND_SAMPLES_DIR
+#define ANANTASOUND_SAMPLES_DIR "samples"
+#endif
+
+using namespace AnantaSound;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kFFTSize = 1024;
+
+enum class Mode {
+    DOUBLE,         // Double-precision pipeline, stages in sequence
+    FLOAT,          // Single-precision pipeline, stages in sequence
+    THREADED        // Single precision, the three stages of a block run concurrently
+};
+
+const char* modeName(Mode mode) {
+    switch (mode) {
+        case Mode::DOUBLE: return "double";
+        case Mode::FLOAT: return "float";
+        case Mode::THREADED: return "threaded";
+    }
+    return "unknown";
+}
+
+struct Options {
+    std::string samples_dir = ANANTASOUND_SAMPLES_DIR;
+    std::vector<Mode> modes = {Mode::DOUBLE, Mode::FLOAT, Mode::THREADED};
+    size_t block = 1024;
+    double max_seconds = 0.0;       // 0 - whole file
+    std::string output;             // Empty - stdout
+};
+
+struct RunResult {
+    std::string file;
+    Mode mode;
+    int sample_rate = 0;
+    int channels = 0;
+    double audio_seconds = 0.0;
+    double decode_seconds = 0.0;
+    double processing_seconds = 0.0;
+    size_t blocks = 0;
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+    double max_us = 0.0;
+    long peak_rss_kb = 0;
+};
+
+long peakRSSKilobytes() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;         // Kilobytes on Linux
+}
+
+// Nearest-rank percentile; reorders `values`
+double percentile(std::vector<double>& values, double fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t rank = static_cast<size_t>(fraction * static_cast<double>(values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+// The three per-listener stages on one sample type
+template<typename Sample>
+struct Pipeline {
+    AudioAnalyzer analyzer;
+    BasicAudioAnalysisResult<Sample> analysis;
+    AdaptiveAudioProcessor processor;
+    BreathingAnalyzer breathing;
+    std::vector<Sample> output;
+
+    Pipeline(size_t sample_rate, size_t block)
+        : analyzer(kFFTSize, sample_rate), processor(kFFTSize, sample_rate),
+          breathing(kFFTSize, sample_rate), output(block) {
+        analyzer.initialize();
+        processor.initialize();
+        processor.prepareRealtime();
+        breathing.initialize();
+    }
+
+    void runStage(size_t stage, const Sample* samples, size_t count) {
+        switch (stage) {
+            case 0: analyzer.analyzeAudio(samples, count, analysis); break;
+            case 1: processor.processRealtime(samples, output.data(), count); break;
+            default: breathing.analyzeBreathing(samples, count); break;
+        }
+    }
+};
+
+template<typename Sample>
+bool runFile(const std::string& path, Mode mode, const Options& options, ThreadPool& pool, RunResult& result) {
+    AudioFileReader reader;
+    if (!reader.open(path)) {
+        std::cerr << "corpus benchmark: cannot open " << path << std::endl;
+        return false;
+    }
+    const AudioInfo& info = reader.getInfo();
+    result.sample_rate = info.sample_rate;
+    result.channels = info.channels;
+
+    uint64_t frame_limit = static_cast<uint64_t>(info.total_samples);
+    if (options.max_seconds > 0.0) {
+        frame_limit = std::min<uint64_t>(frame_limit, static_cast<uint64_t>(options.max_seconds * info.sample_rate));
+    }
+
+    Pipeline<Sample> pipeline(static_cast<size_t>(info.sample_rate), options.block);
+    std::vector<double> decoded(options.block);
+    std::vector<Sample> block(options.block);
+    std::vector<double> latencies;
+    latencies.reserve(static_cast<size_t>(frame_limit / options.block + 1));
+
+    uint64_t frames = 0;
+    Clock::duration decode_time{};
+    Clock::duration processing_time{};
+    while (frames < frame_limit) {
+        size_t wanted = static_cast<size_t>(std::min<uint64_t>(options.block, frame_limit - frames));
+        auto decode_start = Clock::now();
+        size_t count = reader.readMono(decoded.data(), wanted);
+        decode_time += Clock::now() - decode_start;
+        if (count == 0) {
+            break;
+        }
+        std::copy(decoded.begin(), decoded.begin() + count, block.begin());
+
+        auto start = Clock::now();
+        if (mode == Mode::THREADED) {
+            pool.parallelFor(3, 1, [&](size_t begin, size_t end, size_t) {
+                for (size_t stage = begin; stage < end; ++stage) {
+                    pipeline.runStage(stage, block.data(), count);
+                }
+            });
+        } else {
+            for (size_t stage = 0; stage < 3; ++stage) {
+                pipeline.runStage(stage, block.data(), count);
+            }
+        }
+        Clock::duration elapsed = Clock::now() - start;
+        processing_time += elapsed;
+        latencies.push_back(std::chrono::duration<double, std::micro>(elapsed).count());
+        frames += count;
+    }
+
+    result.audio_seconds = static_cast<double>(frames) / info.sample_rate;
+    result.decode_seconds = std::chrono::duration<double>(decode_time).count();
+    result.processing_seconds = std::chrono::duration<double>(processing_time).count();
+    result.blocks = latencies.size();
+    result.max_us = latencies.empty() ? 0.0 : *std::max_element(latencies.begin(), latencies.end());
+    result.p50_us = percentile(latencies, 0.50);
+    result.p99_us = percentile(latencies, 0.99);
+    result.peak_rss_kb = peakRSSKilobytes();
+    return true;
+}
+
+std::string jsonString(const std::string& text) {
+    std::string escaped = "\"";
+    for (char c : text) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", c);
+                    escaped += code;
+                } else {
+                    escaped += c;       // UTF-8 passes through unchanged
+                }
+        }
+    }
+    return escaped + "\"";
+}
+
+std::string toJSON(const Options& options, const std::vector<RunResult>& runs,
+                   const std::vector<std::string>& skipped) {
+    std::ostringstream out;
+    out.precision(6);
+    out << "{\n";
+    out << "  \"benchmark\": \"anantasound_corpus\",\n";
+    out << "  \"block_size\": " << options.block << ",\n";
+    out << "  \"fft_size\": " << kFFTSize << ",\n";
+    out << "  \"simd_double\": " << jsonString(getSpectralKernels().name) << ",\n";
+    out << "  \"simd_float\": " << jsonString(getSpectralKernelsF().name) << ",\n";
+    out << "  \"runs\": [";
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const RunResult& run = runs[i];
+        double factor = run.processing_seconds > 0.0 ? run.audio_seconds / run.processing_seconds : 0.0;
+        out << (i ? "," : "") << "\n    {";
+        out << "\"file\": " << jsonString(run.file);
+        out << ", \"mode\": \"" << modeName(run.mode) << "\"";
+        out << ", \"sample_rate\": " << run.sample_rate;
+        out << ", \"channels\": " << run.channels;
+        out << ", \"audio_seconds\": " << run.audio_seconds;
+        out << ", \"decode_seconds\": " << run.decode_seconds;
+        out << ", \"processing_seconds\": " << run.processing_seconds;
+        out << ", \"realtime_factor\": " << factor;
+        out << ", \"blocks\": " << run.blocks;
+        out << ", \"latency_us\": {\"p50\": " << run.p50_us << ", \"p99\": " << run.p99_us
+            << ", \"max\": " << run.max_us << "}";
+        out << ", \"peak_rss_kb\": " << run.peak_rss_kb << "}";
+    }
+    out << "\n  ],\n";
+    out << "  \"skipped\": [";
+    for (size_t i = 0; i < skipped.size(); ++i) {
+        out << (i ? ", " : "") << jsonString(skipped[i]);
+    }
+    out << "],\n";
+    out << "  \"peak_rss_kb\": " << peakRSSKilobytes() << "\n";
+    out << "}\n";
+    return out.str();
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "corpus benchmark: missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--samples") {
+            options.samples_dir = value;
+        } else if (arg == "--block") {
+            options.block = std::max<size_t>(1, std::strtoul(value.c_str(), nullptr, 10));
+        } else if (arg == "--max-seconds") {
+            options.max_seconds = std::strtod(value.c_str(), nullptr);
+        } else if (arg == "--output") {
+            options.output = value;
+        } else if (arg == "--mode") {
+            if (value == "all") {
+                options.modes = {Mode::DOUBLE, Mode::FLOAT, Mode::THREADED};
+            } else if (value == "double") {
+                options.modes = {Mode::DOUBLE};
+            } else if (value == "float") {
+                options.modes = {Mode::FLOAT};
+            } else if (value == "threaded") {
+                options.modes = {Mode::THREADED};
+            } else {
+                std::cerr << "corpus benchmark: unknown mode " << value << std::endl;
+                return false;
+            }
+        } else {
+            std::cerr << "corpus benchmark: unknown option " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    // Sorted for a stable run order
+    std::vector<std::filesystem::path> candidates;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(options.samples_dir, error)) {
+        std::string extension = entry.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (entry.is_regular_file() && (extension == ".wav" || extension == ".flac")) {
+            candidates.push_back(entry.path());
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    
+    std::vector<std::filesystem::path> files;
+    std::vector<std::string> skipped;
+    for (const auto& candidate : candidates) {
+        AudioFileReader probe;
+        if (probe.open(candidate.string())) {
+            files.push_back(candidate);
+        } else {
+            skipped.push_back(candidate.filename().string());
+        }
+    }
+    if (error || files.empty()) {
+        std::cerr << "corpus benchmark: no readable WAV or FLAC files in " << options.samples_dir << std::endl;
+        return 1;
+    }
+
+    ThreadPool pool(2);
+    std::vector<RunResult> runs;
+    for (Mode mode : options.modes) {
+        for (const auto& file : files) {
+            RunResult run;
+            run.file = file.filename().string();
+            run.mode = mode;
+            bool ok = mode == Mode::DOUBLE
+                ? runFile<double>(file.string(), mode, options, pool, run)
+                : runFile<float>(file.string(), mode, options, pool, run);
+            if (ok) {
+                runs.push_back(run);
+            }
+        }
+    }
+
+    std::string report = toJSON(options, runs, skipped);
+    if (options.output.empty()) {
+        std::cout << report;
+    } else {
+        std::ofstream out(options.output);
+        if (!out) {
+            std::cerr << "corpus benchmark: cannot write " << options.output << std::endl;
+            return 1;
+        }
+        out << report;
+    }
+    return runs.size() == options.modes.size() * files.size() ? 0 : 1;
+}
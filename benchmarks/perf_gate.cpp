@@ -0,0 +1,295 @@
+// Performance regression gate, run by ctest.
+// A fast subset of the benchmarks (about a second in total) is measured
+// and compared with the stored baseline of the platform:
+//
+//   analyzer_frames_per_second          AudioAnalyzer, 1024-point float frames
+//   interference_evaluations_per_second 1024 sources x 256 points, source-point pairs
+//   core_tick_ms                        AnantaSoundCore::update with 10000 resident fields
+//   allocations_per_tick                heap allocations per steady-state core update
+//                                       (recorded with tolerance 0: the tick must not allocate)
+//
+// Throughputs are the best of several short runs, which filters out most
+// scheduling noise; the tick time is the median of a few thousand ticks,
+// each too short (tens of microseconds) for a best-of-runs to be stable.
+// A throughput below baseline * (1 - tolerance), or a cost above
+// baseline * (1 + tolerance), fails the gate (exit code 1). The tolerance
+// is the baseline's "<metric>_tolerance" if present, else its "tolerance";
+// --tolerance overrides both. A platform without a baseline is skipped
+// (exit code 77); --update writes the current results as its baseline.
+//
+// Usage: anantasound_perf_gate [--baseline FILE] [--tolerance F] [--update]
+
+#include "allocation_counter.hpp"
+#include "anantasound_core.hpp"
+#include "audio_analyzer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef ANANTASOUND_BASELINE_DIR
+#define ANANTASOUND_BASELINE_DIR "benchmarks/baselines"
+#endif
+
+#ifndef ANANTASOUND_PLATFORM
+#define ANANTASOUND_PLATFORM "unknown"
+#endif
+
+using namespace AnantaSound;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kExitRegression = 1;
+constexpr int kExitUsage = 2;
+constexpr int kExitSkipped = 77;           // ctest SKIP_RETURN_CODE
+constexpr double kDefaultTolerance = 0.3;
+constexpr double kTickTolerance = 0.5;     // A tick is short enough for cache and frequency noise to show
+constexpr int kRuns = 5;
+constexpr double kRunSeconds = 0.04;
+
+struct Metric {
+    const char* name;
+    bool higher_is_better;
+    double value;
+    double tolerance;               // Recorded by --update; negative: the global one
+};
+
+struct Options {
+    std::string baseline = std::string(ANANTASOUND_BASELINE_DIR) + "/" + ANANTASOUND_PLATFORM + ".json";
+    double tolerance = -1.0;        // Negative: the baseline's own, else kDefaultTolerance
+    bool update = false;
+};
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Repeat `operation` for about kRunSeconds; operations per second
+template<typename Operation>
+double measureRate(Operation&& operation) {
+    size_t count = 0;
+    auto start = Clock::now();
+    double elapsed = 0.0;
+    do {
+        operation();
+        ++count;
+        elapsed = secondsSince(start);
+    } while (elapsed < kRunSeconds);
+    return static_cast<double>(count) / elapsed;
+}
+
+QuantumSoundField makeField(size_t index) {
+    QuantumSoundField field;
+    field.amplitude = std::complex<double>(1.0 / (1.0 + index % 7), 0.1);
+    field.frequency = 200.0 + 3.0 * static_cast<double>(index % 4000);
+    field.phase = 0.01 * static_cast<double>(index);
+    field.quantum_state = index % 3 ? QuantumSoundState::COHERENT : QuantumSoundState::SUPERPOSITION;
+    field.position = SphericalCoord(1.0 + 0.01 * (index % 500), 0.001 * index, 0.002 * index, 1.0);
+    return field;
+}
+
+double analyzerFramesPerSecond() {
+    constexpr size_t kFrame = 1024;
+    AudioAnalyzer analyzer(kFrame, 44100);
+    analyzer.initialize();
+    std::vector<float> frame(kFrame);
+    for (size_t i = 0; i < kFrame; ++i) {
+        frame[i] = static_cast<float>(0.5 * std::sin(2.0 * M_PI * 440.0 * i / 44100.0));
+    }
+    BasicAudioAnalysisResult<float> result;
+    analyzer.analyzeAudio(frame.data(), frame.size(), result);
+
+    double best = 0.0;
+    for (int run = 0; run < kRuns; ++run) {
+        best = std::max(best, measureRate([&] { analyzer.analyzeAudio(frame.data(), frame.size(), result); }));
+    }
+    return best;
+}
+
+double interferenceEvaluationsPerSecond() {
+    constexpr size_t kSources = 1024;
+    InterferenceField field(InterferenceFieldType::MIXED, SphericalCoord(0.0, 0.0, 0.0, 0.0), 10.0);
+    std::vector<QuantumSoundField> sources;
+    for (size_t i = 0; i < kSources; ++i) {
+        sources.push_back(makeField(i));
+    }
+    field.addSourceFields(sources);
+    std::vector<SphericalCoord> positions;
+    for (size_t i = 0; i < 256; ++i) {
+        positions.emplace_back(2.0 + 0.01 * i, 0.01 * i, 0.02 * i, 1.0);
+    }
+    std::vector<std::complex<double>> output(positions.size());
+
+    double time = 0.0;
+    double best = 0.0;
+    for (int run = 0; run < kRuns; ++run) {
+        best = std::max(best, measureRate([&] {
+            field.calculateInterference(positions.data(), positions.size(), time, output.data());
+            time += 1e-3;
+        }));
+    }
+    return best * static_cast<double>(kSources * positions.size());
+}
+
+// Median tick, and the allocations of the measured ticks per tick
+void coreTick(double& tick_ms, double& allocations_per_tick) {
+    constexpr size_t kFields = 10000;
+    constexpr size_t kTicks = 4000;
+    AnantaSoundCore core(10.0, 5.0);
+    core.initialize();
+    std::vector<QuantumSoundField> fields;
+    for (size_t i = 0; i < kFields; ++i) {
+        fields.push_back(makeField(i));
+    }
+    core.processSoundFields(fields);
+    // Warm-up: the first ticks size the pooled snapshots
+    for (int tick = 0; tick < 4; ++tick) {
+        core.update(0.016);
+    }
+
+    // Timestamps are taken without allocating, so the count is the core's own
+    std::vector<double> ticks(kTicks);
+    size_t before = TestSupport::allocationCount();
+    for (size_t tick = 0; tick < kTicks; ++tick) {
+        auto start = Clock::now();
+        core.update(0.016);
+        ticks[tick] = secondsSince(start);
+    }
+    size_t allocations = TestSupport::allocationCount() - before;
+    std::nth_element(ticks.begin(), ticks.begin() + kTicks / 2, ticks.end());
+    tick_ms = ticks[kTicks / 2] * 1e3;
+    allocations_per_tick = static_cast<double>(allocations) / kTicks;
+}
+
+// The baseline is a flat JSON object: "tolerance", one number per metric
+// name and optional "<metric>_tolerance" overrides; other keys are ignored
+bool readNumber(const std::string& text, const std::string& key, double& value) {
+    size_t at = text.find("\"" + key + "\"");
+    if (at == std::string::npos) {
+        return false;
+    }
+    at = text.find(':', at);
+    if (at == std::string::npos) {
+        return false;
+    }
+    const char* begin = text.c_str() + at + 1;
+    char* end = nullptr;
+    value = std::strtod(begin, &end);
+    return end != begin;
+}
+
+bool writeBaseline(const std::string& path, const std::vector<Metric>& metrics, double tolerance) {
+    std::ostringstream out;
+    out.precision(6);
+    out << "{\n";
+    out << "  \"platform\": \"" << ANANTASOUND_PLATFORM << "\",\n";
+    out << "  \"tolerance\": " << tolerance;
+    for (const Metric& metric : metrics) {
+        out << ",\n  \"" << metric.name << "\": " << metric.value;
+        if (metric.tolerance >= 0.0) {
+            out << ",\n  \"" << metric.name << "_tolerance\": " << metric.tolerance;
+        }
+    }
+    out << "\n}\n";
+    std::ofstream file(path, std::ios::binary);
+    file << out.str();
+    if (!file) {
+        std::cerr << "perf gate: cannot write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--update") {
+            options.update = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "perf gate: missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--baseline") {
+            options.baseline = value;
+        } else if (arg == "--tolerance") {
+            options.tolerance = std::strtod(value.c_str(), nullptr);
+        } else {
+            std::cerr << "perf gate: unknown option " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return kExitUsage;
+    }
+
+    std::vector<Metric> metrics = {
+        {"analyzer_frames_per_second", true, analyzerFramesPerSecond(), -1.0},
+        {"interference_evaluations_per_second", true, interferenceEvaluationsPerSecond(), -1.0},
+        {"core_tick_ms", false, 0.0, kTickTolerance},
+        {"allocations_per_tick", false, 0.0, 0.0},       // Any allocation is a regression
+    };
+    coreTick(metrics[2].value, metrics[3].value);
+
+    if (options.update) {
+        double tolerance = options.tolerance >= 0.0 ? options.tolerance : kDefaultTolerance;
+        if (!writeBaseline(options.baseline, metrics, tolerance)) {
+            return kExitUsage;
+        }
+        std::cout << "perf gate: baseline written to " << options.baseline << std::endl;
+        return 0;
+    }
+
+    std::ifstream file(options.baseline, std::ios::binary);
+    if (!file) {
+        std::cout << "perf gate: no baseline for " << ANANTASOUND_PLATFORM << " (" << options.baseline
+                  << "), skipped; record one with --update" << std::endl;
+        return kExitSkipped;
+    }
+    std::string baseline((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    double tolerance = options.tolerance;
+    if (tolerance < 0.0 && !readNumber(baseline, "tolerance", tolerance)) {
+        tolerance = kDefaultTolerance;
+    }
+
+    bool regressed = false;
+    for (const Metric& metric : metrics) {
+        double expected = 0.0;
+        if (!readNumber(baseline, metric.name, expected)) {
+            std::cout << "  " << metric.name << ": " << metric.value << " (no baseline)" << std::endl;
+            continue;
+        }
+        double allowed = tolerance;
+        if (options.tolerance < 0.0) {
+            readNumber(baseline, std::string(metric.name) + "_tolerance", allowed);
+        }
+        double limit = metric.higher_is_better ? expected * (1.0 - allowed) : expected * (1.0 + allowed);
+        bool failed = metric.higher_is_better ? metric.value < limit : metric.value > limit;
+        regressed |= failed;
+        std::cout << "  " << metric.name << ": " << metric.value << " (baseline " << expected
+                  << (metric.higher_is_better ? ", min " : ", max ") << limit << ")"
+                  << (failed ? "  REGRESSION" : "") << std::endl;
+    }
+    std::cout << "perf gate: " << (regressed ? "regression past" : "within") << " tolerance "
+              << tolerance << " of " << options.baseline << std::endl;
+    return regressed ? kExitRegression : 0;
+}
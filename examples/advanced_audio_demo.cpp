@@ -1,5 +1,6 @@
 #include "anantasound_core.hpp"
 #include "audio_analyzer.hpp"
+#include "feature_cache.hpp"
 #include <iostream>
 #include <iomanip>
 #include <chrono>
@@ -18,9 +19,10 @@ private:
     std::vector<std::string> sample_files_;
     std::string samples_dir_;
     std::vector<std::unique_ptr<AudioAnalyzer>> analyzers_;
+    FeatureCache feature_cache_;    // Repeat runs read features back instead of re-analyzing
     
 public:
-    AdvancedAudioDemo() : core_(5.0, 3.0) {
+    AdvancedAudioDemo() : core_(5.0, 3.0), feature_cache_(".anantasound_cache") {
         samples_dir_ = "../samples";
         loadSampleFiles();
     }
@@ -88,6 +90,7 @@ public:
         
         // Создаем анализатор для этого файла
         auto analyzer = std::make_unique<AudioAnalyzer>();
+        analyzer->setFeatureCache(&feature_cache_);
         
         // Загружаем и анализируем файл
         if (!analyzer->loadAudioFile(filepath)) {
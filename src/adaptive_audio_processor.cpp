@@ -1,19 +1,251 @@
 #include "adaptive_audio_processor.hpp"
+#include "anantasound_core.hpp"
+#include "instrumentation.hpp"
+#include "metrics.hpp"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <iostream>
+#include <limits>
 
 namespace AnantaSound {
 
+namespace {
+
+// Правило детектора: признак выше (above) или ниже порога дает эмоцию.
+// Значения не выше floor означают, что признак еще не оценен (темп 0),
+// и правило не срабатывает.
+struct EmotionRule {
+    double AudioFeatures::* feature;
+    bool above;
+    double threshold;
+    EmotionalState emotion;
+    double floor = -std::numeric_limits<double>::infinity();
+};
+
+constexpr size_t kEmotionDetectorCount = 3;
+constexpr size_t kRulesPerDetector = 3;
+
+// Детекторы эмоций: срабатывает первое выполненное правило, иначе CALM
+constexpr EmotionRule kEmotionRules[kEmotionDetectorCount][kRulesPerDetector] = {
+    // Паттерны дыхания по частоте и громкости: очень низкая частота - глубокое
+    // дыхание, высокая - учащенное, высокая громкость - стресс
+    {{&AudioFeatures::fundamental_frequency, false, 0.5, EmotionalState::RELAXED},
+     {&AudioFeatures::fundamental_frequency, true, 2.0, EmotionalState::EXCITED},
+     {&AudioFeatures::volume_level, true, 0.7, EmotionalState::STRESSED}},
+    // Ритмические паттерны: быстрый темп, медленный темп, высокая активность
+    {{&AudioFeatures::tempo, true, 120.0, EmotionalState::EXCITED, 0.0},
+     {&AudioFeatures::tempo, false, 80.0, EmotionalState::RELAXED, 0.0},
+     {&AudioFeatures::zero_crossing_rate, true, 0.3, EmotionalState::FOCUSED}},
+    // Спектр: доминируют высокие частоты, низкие частоты, широкий спектр
+    {{&AudioFeatures::spectral_centroid, true, 2000.0, EmotionalState::FOCUSED},
+     {&AudioFeatures::spectral_centroid, false, 500.0, EmotionalState::RELAXED},
+     {&AudioFeatures::spectral_rolloff, true, 4000.0, EmotionalState::EXCITED}},
+};
+
+using DetectorTable = std::array<EmotionalState, size_t(1) << kRulesPerDetector>;
+
+// Маска выполненных правил -> эмоция первого из них
+constexpr DetectorTable buildDetectorTable(size_t detector) {
+    DetectorTable table{};
+    for (size_t mask = 0; mask < table.size(); ++mask) {
+        table[mask] = EmotionalState::CALM;
+        for (size_t rule = kRulesPerDetector; rule-- > 0;) {
+            if (mask & (size_t(1) << rule)) {
+                table[mask] = kEmotionRules[detector][rule].emotion;
+            }
+        }
+    }
+    return table;
+}
+
+constexpr std::array<DetectorTable, kEmotionDetectorCount> kDetectorTables = {
+    buildDetectorTable(0), buildDetectorTable(1), buildDetectorTable(2)
+};
+
+// Голосование трех детекторов: большинство, при равенстве - первое по порядку
+using VoteTable = std::array<std::array<std::array<EmotionalState, kEmotionalStateCount>, kEmotionalStateCount>,
+                             kEmotionalStateCount>;
+
+constexpr VoteTable buildVoteTable() {
+    VoteTable table{};
+    for (size_t a = 0; a < kEmotionalStateCount; ++a) {
+        for (size_t b = 0; b < kEmotionalStateCount; ++b) {
+            for (size_t c = 0; c < kEmotionalStateCount; ++c) {
+                size_t winner = std::min(a, std::min(b, c));
+                if (b == c) {
+                    winner = b;
+                }
+                if (a == b || a == c) {
+                    winner = a;
+                }
+                table[a][b][c] = static_cast<EmotionalState>(winner);
+            }
+        }
+    }
+    return table;
+}
+
+constexpr VoteTable kVoteTable = buildVoteTable();
+
+static_assert(kDetectorTables[0][0b110] == EmotionalState::EXCITED);
+static_assert(kDetectorTables[2][0] == EmotionalState::CALM);
+static_assert(kVoteTable[4][1][1] == EmotionalState::EXCITED);
+static_assert(kVoteTable[4][3][1] == EmotionalState::EXCITED);
+
+using DetectorVotes = std::array<EmotionalState, kEmotionDetectorCount>;
+
+DetectorVotes detectorVotes(const AudioFeatures& analysis) {
+    DetectorVotes votes;
+    for (size_t detector = 0; detector < kEmotionDetectorCount; ++detector) {
+        size_t mask = 0;
+        for (size_t rule = 0; rule < kRulesPerDetector; ++rule) {
+            const EmotionRule& r = kEmotionRules[detector][rule];
+            double value = analysis.*r.feature;
+            bool matched = value > r.floor && (r.above ? value > r.threshold : value < r.threshold);
+            mask |= static_cast<size_t>(matched) << rule;
+        }
+        votes[detector] = kDetectorTables[detector][mask];
+    }
+    return votes;
+}
+
+EmotionalState majorityVote(const DetectorVotes& votes) {
+    return kVoteTable[static_cast<size_t>(votes[0])][static_cast<size_t>(votes[1])][static_cast<size_t>(votes[2])];
+}
+
+double agreement(const DetectorVotes& votes, EmotionalState emotion) {
+    int agreeing = (votes[0] == emotion) + (votes[1] == emotion) + (votes[2] == emotion);
+    return static_cast<double>(agreeing) / 3.0;
+}
+
+// Пресеты по умолчанию (индекс - EmotionalState; UNKNOWN - нейтральные
+// параметры). Таблица строится один раз на процесс и копируется в каждый
+// процессор.
+const std::array<AdaptationParameters, kEmotionalStateCount>& defaultEmotionPresets() {
+    static const std::array<AdaptationParameters, kEmotionalStateCount> table = [] {
+        std::array<AdaptationParameters, kEmotionalStateCount> presets;
+        // Пресет для спокойствия
+        AdaptationParameters calm_params;
+        calm_params.volume_multiplier = 0.8;
+        calm_params.tempo_multiplier = 0.9;
+        calm_params.bass_boost = 0.2;
+        calm_params.treble_boost = 0.1;
+        calm_params.reverb_amount = 0.3;
+        calm_params.echo_delay = 0.1;
+        presets[static_cast<size_t>(EmotionalState::CALM)] = calm_params;
+        
+        // Пресет для возбуждения
+        AdaptationParameters excited_params;
+        excited_params.volume_multiplier = 1.2;
+        excited_params.tempo_multiplier = 1.1;
+        excited_params.bass_boost = 0.4;
+        excited_params.treble_boost = 0.3;
+        excited_params.reverb_amount = 0.1;
+        excited_params.echo_delay = 0.0;
+        presets[static_cast<size_t>(EmotionalState::EXCITED)] = excited_params;
+        
+        // Пресет для стресса
+        AdaptationParameters stressed_params;
+        stressed_params.volume_multiplier = 0.7;
+        stressed_params.tempo_multiplier = 0.8;
+        stressed_params.bass_boost = 0.1;
+        stressed_params.treble_boost = 0.0;
+        stressed_params.reverb_amount = 0.5;
+        stressed_params.echo_delay = 0.2;
+        presets[static_cast<size_t>(EmotionalState::STRESSED)] = stressed_params;
+        
+        // Пресет для сосредоточенности
+        AdaptationParameters focused_params;
+        focused_params.volume_multiplier = 1.0;
+        focused_params.tempo_multiplier = 1.0;
+        focused_params.bass_boost = 0.0;
+        focused_params.treble_boost = 0.2;
+        focused_params.reverb_amount = 0.0;
+        focused_params.echo_delay = 0.0;
+        presets[static_cast<size_t>(EmotionalState::FOCUSED)] = focused_params;
+        
+        // Пресет для расслабления
+        AdaptationParameters relaxed_params;
+        relaxed_params.volume_multiplier = 0.9;
+        relaxed_params.tempo_multiplier = 0.85;
+        relaxed_params.bass_boost = 0.3;
+        relaxed_params.treble_boost = 0.0;
+        relaxed_params.reverb_amount = 0.4;
+        relaxed_params.echo_delay = 0.15;
+        presets[static_cast<size_t>(EmotionalState::RELAXED)] = relaxed_params;
+        return presets;
+    }();
+    return table;
+}
+
+void addRelaxed(std::atomic<double>& target, double value) {
+    double current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+template<>
+EffectsChain& AdaptiveAudioProcessor::effectsChain<double>() {
+    return effects_chain_;
+}
+
+template<>
+EffectsChainF& AdaptiveAudioProcessor::effectsChain<float>() {
+    return effects_chain_f_;
+}
+
+template<>
+EffectsChain& AdaptiveAudioProcessor::multichannelChain<double>(size_t channels) {
+    if (!multichannel_chain_) {
+        multichannel_chain_ = std::make_unique<EffectsChain>(sample_rate_, channels);
+        multichannel_chain_->setReverbTime(control_.reverb_time);
+    }
+    multichannel_chain_->setChannelCount(channels);
+    return *multichannel_chain_;
+}
+
+template<>
+EffectsChainF& AdaptiveAudioProcessor::multichannelChain<float>(size_t channels) {
+    if (!multichannel_chain_f_) {
+        multichannel_chain_f_ = std::make_unique<EffectsChainF>(sample_rate_, channels);
+        multichannel_chain_f_->setReverbTime(control_.reverb_time);
+    }
+    multichannel_chain_f_->setChannelCount(channels);
+    return *multichannel_chain_f_;
+}
+
+AdaptiveSettings::AdaptiveSettings() : adaptation_sensitivity(0.7) {
+    const auto& defaults = defaultEmotionPresets();
+    std::copy(defaults.begin(), defaults.end(), presets);
+}
+
 AdaptiveAudioProcessor::AdaptiveAudioProcessor(size_t fft_size, size_t sample_rate)
-    : analysis_window_size_(fft_size)
+    : tempo_tracker_(fft_size, sample_rate, fft_size)
+    , effects_chain_(sample_rate)
+    , effects_chain_f_(sample_rate)
+    , analysis_window_size_(fft_size)
     , sample_rate_(sample_rate)
-    , adaptation_sensitivity_(0.7)
-    , history_size_(10) {
+    , history_count_(0)
+    , history_next_(0)
+    , most_common_emotion_(EmotionalState::UNKNOWN)
+    , processed_samples_(0)
+    , processed_blocks_(0)
+    , confidence_sum_(0.0)
+    , volume_sum_(0.0)
+    , tempo_sum_(0.0) {
     
     audio_analyzer_ = std::make_unique<AudioAnalyzer>(fft_size, sample_rate);
-    initializeEmotionPresets();
+    // Классификатору нужны только скалярные признаки и спектр модулей для
+    // темпа; фазы и ось частот не вычисляются
+    audio_analyzer_->setFeatures(AnalysisFeature::SCALAR);
+    emotion_counts_.fill(0);
+    
+    control_.reverb_time = effects_chain_.getReverbTime();
+    control_.reset_generation = 0;
+    publishControl();
 }
 
 bool AdaptiveAudioProcessor::initialize() {
@@ -25,350 +257,418 @@ bool AdaptiveAudioProcessor::initialize() {
 }
 
 AdaptationResult AdaptiveAudioProcessor::processAudio(const std::vector<double>& input_audio) {
-    std::lock_guard<std::mutex> lock(processor_mutex_);
+    return adaptAudio(input_audio);
+}
+
+AdaptationResultF AdaptiveAudioProcessor::processAudio(const std::vector<float>& input_audio) {
+    return adaptAudio(input_audio);
+}
+
+AdaptationResult AdaptiveAudioProcessor::processAudio(const AudioBuffer& input, AudioBuffer& output) {
+    return adaptBuffer(input, output);
+}
+
+AdaptationResultF AdaptiveAudioProcessor::processAudio(const AudioBufferF& input, AudioBufferF& output) {
+    return adaptBuffer(input, output);
+}
+
+template<typename Sample>
+BasicAdaptationResult<Sample> AdaptiveAudioProcessor::adaptAudio(const std::vector<Sample>& input_audio) {
+    ANANTASOUND_STAGE_TIMER("adaptive.process");
+    ANANTASOUND_LOCK_GUARD(lock, processor_mutex_, "AdaptiveAudioProcessor::processor_mutex_");
     
-    AdaptationResult result;
+    BasicAdaptationResult<Sample> result;
     
     if (input_audio.empty() || !audio_analyzer_) {
         return result;
     }
     
-    // Анализ входящего аудио
-    AudioAnalysisResult analysis = audio_analyzer_->analyzeAudio(input_audio);
-    
-    // Определение эмоционального состояния
-    result.detected_emotion = detectEmotionalState(analysis);
-    
-    // Получение параметров адаптации
-    AdaptationParameters base_params = getAdaptationParameters(result.detected_emotion);
-    
-    // Сглаживание параметров с учетом истории
-    result.applied_parameters = smoothAdaptationParameters(base_params);
+    classifyBlock(input_audio.data(), input_audio.size(), result);
     
     // Обработка аудио с адаптированными параметрами
-    result.processed_audio = processAudioWithParameters(input_audio, result.applied_parameters);
-    
-    // Расчет уверенности в определении эмоции
-    result.confidence = calculateConfidence(analysis, result.detected_emotion);
+    result.processed_audio = applyEffects(input_audio, result.applied_parameters);
     
     // Обновление истории
-    updateHistory(result.detected_emotion, result.applied_parameters);
+    updateHistory(result.detected_emotion, result.applied_parameters, result.confidence, input_audio.size());
     
     result.timestamp = std::chrono::high_resolution_clock::now();
     
     return result;
 }
 
-std::vector<double> AdaptiveAudioProcessor::processAudioWithParameters(
-    const std::vector<double>& input_audio,
-    const AdaptationParameters& parameters) {
+template<typename Sample>
+BasicAdaptationResult<Sample> AdaptiveAudioProcessor::adaptBuffer(const BasicAudioBuffer<Sample>& input,
+                                                                  BasicAudioBuffer<Sample>& output) {
+    ANANTASOUND_STAGE_TIMER("adaptive.process");
+    ANANTASOUND_LOCK_GUARD(lock, processor_mutex_, "AdaptiveAudioProcessor::processor_mutex_");
+    
+    BasicAdaptationResult<Sample> result;
     
-    std::vector<double> processed_audio = input_audio;
+    if (input.getFrameCount() == 0 || !audio_analyzer_) {
+        output.resize(input.getChannelCount(), 0);
+        return result;
+    }
     
-    // Применение различных эффектов
-    processed_audio = applyVolumeAdjustment(processed_audio, parameters.volume_multiplier);
-    processed_audio = applyTempoAdjustment(processed_audio, parameters.tempo_multiplier);
-    processed_audio = applyBassBoost(processed_audio, parameters.bass_boost);
-    processed_audio = applyTrebleBoost(processed_audio, parameters.treble_boost);
-    processed_audio = applyReverb(processed_audio, parameters.reverb_amount);
-    processed_audio = applyEcho(processed_audio, parameters.echo_delay);
+    // Эмоция - свойство всей программы, поэтому анализируется сведение
+    std::vector<Sample> mixdown;
+    input.mixdown(mixdown);
+    classifyBlock(mixdown.data(), mixdown.size(), result);
     
-    return processed_audio;
+    BasicEffectsChain<Sample>& chain = multichannelChain<Sample>(input.getChannelCount());
+    chain.setParameters(result.applied_parameters);
+    chain.process(input, output);
+    
+    updateHistory(result.detected_emotion, result.applied_parameters, result.confidence, input.getFrameCount());
+    result.timestamp = std::chrono::high_resolution_clock::now();
+    
+    return result;
 }
 
-EmotionalState AdaptiveAudioProcessor::detectEmotionalState(const AudioAnalysisResult& analysis) const {
-    // Анализ различных характеристик для определения эмоции
-    EmotionalState breathing_emotion = analyzeBreathingPattern(analysis);
-    EmotionalState rhythmic_emotion = analyzeRhythmicPattern(analysis);
-    EmotionalState spectral_emotion = analyzeSpectralCharacteristics(analysis);
+template<typename Sample>
+void AdaptiveAudioProcessor::classifyBlock(const Sample* samples, size_t count, BasicAdaptationResult<Sample>& result) {
+    // Анализ входящего аудио
+    BasicAudioAnalysisResult<Sample> analysis;
+    audio_analyzer_->analyzeAudio(samples, count, analysis);
+    tempo_tracker_.setHopSize(count);
+    analysis.tempo = tempo_tracker_.pushSpectrum(analysis.magnitude_spectrum.data(), analysis.magnitude_spectrum.size());
+    
+    // Определение эмоционального состояния
+    result.detected_emotion = detectEmotionalState(analysis);
     
-    // Простое голосование между методами
-    std::map<EmotionalState, int> votes;
-    votes[breathing_emotion]++;
-    votes[rhythmic_emotion]++;
-    votes[spectral_emotion]++;
+    // Параметры адаптации из последнего опубликованного снимка
+    const RealtimeControl& control = block_mailbox_.read();
+    AdaptationParameters base_params = control.settings.presets[static_cast<size_t>(result.detected_emotion)];
     
-    // Найти наиболее частое состояние
-    auto max_vote = std::max_element(votes.begin(), votes.end(),
-        [](const auto& a, const auto& b) { return a.second < b.second; });
+    // Сглаживание параметров с учетом истории
+    result.applied_parameters = smoothAdaptationParameters(base_params);
     
-    return max_vote->first;
+    // Расчет уверенности в определении эмоции
+    result.confidence = calculateConfidence(analysis, result.detected_emotion);
 }
 
-AdaptationParameters AdaptiveAudioProcessor::getAdaptationParameters(EmotionalState emotion) const {
-    auto it = emotion_presets_.find(emotion);
-    if (it != emotion_presets_.end()) {
-        return it->second;
+bool AdaptiveAudioProcessor::prepareRealtime(size_t channels) {
+    ANANTASOUND_LOCK_GUARD(lock, processor_mutex_, "AdaptiveAudioProcessor::processor_mutex_");
+    
+    channels = std::max<size_t>(1, channels);
+    auto prepare = [this, channels](auto& state) {
+        using Sample = typename std::decay_t<decltype(*state)>::SampleType;
+        auto prepared = std::make_unique<RealtimeState<Sample>>(analysis_window_size_, sample_rate_, channels);
+        prepared->frame = audio_analyzer_->makeFrameScratch<Sample>();
+        if (prepared->frame.input.empty()) {
+            return false;
+        }
+        
+        // Анализ тишины задает размер спектров для всех последующих блоков
+        std::vector<Sample> silence(analysis_window_size_, Sample(0));
+        audio_analyzer_->analyzeAudio(silence.data(), silence.size(), prepared->analysis, prepared->frame);
+        
+        prepared->chain.setReverbTime(control_.reverb_time);
+        prepared->reverb_time = control_.reverb_time;
+        prepared->reset_generation = control_.reset_generation;
+        state = std::move(prepared);
+        return true;
+    };
+    
+    if (!audio_analyzer_ || !prepare(realtime_) || !prepare(realtime_f_)) {
+        std::cerr << "AdaptiveAudioProcessor: analyzer has no FFT plan for real-time mode" << std::endl;
+        realtime_.reset();
+        realtime_f_.reset();
+        return false;
     }
-    
-    // Возвращаем нейтральные параметры для неизвестных эмоций
-    return AdaptationParameters();
+    return true;
 }
 
-void AdaptiveAudioProcessor::setEmotionPreset(EmotionalState emotion, const AdaptationParameters& parameters) {
-    std::lock_guard<std::mutex> lock(processor_mutex_);
-    emotion_presets_[emotion] = parameters;
+RealtimeAdaptation AdaptiveAudioProcessor::processRealtime(const double* input, double* output, size_t count) {
+    return adaptRealtime(realtime_.get(), input, output, count, 1);
 }
 
-void AdaptiveAudioProcessor::setAdaptationSensitivity(double sensitivity) {
-    std::lock_guard<std::mutex> lock(processor_mutex_);
-    adaptation_sensitivity_ = std::max(0.0, std::min(1.0, sensitivity));
+RealtimeAdaptation AdaptiveAudioProcessor::processRealtime(const float* input, float* output, size_t count) {
+    return adaptRealtime(realtime_f_.get(), input, output, count, 1);
 }
 
-AdaptiveAudioProcessor::ProcessorStatistics AdaptiveAudioProcessor::getStatistics() const {
-    std::lock_guard<std::mutex> lock(processor_mutex_);
-    
-    ProcessorStatistics stats;
-    stats.total_processed_samples = 0; // TODO: Implement counter
-    stats.most_common_emotion = getMostCommonEmotion();
-    stats.average_confidence = 0.0; // TODO: Calculate from history
-    stats.average_volume_adjustment = 0.0; // TODO: Calculate from history
-    stats.average_tempo_adjustment = 0.0; // TODO: Calculate from history
-    
-    return stats;
+RealtimeAdaptation AdaptiveAudioProcessor::processRealtime(const double* input, double* output,
+                                                           size_t frame_count, size_t channels) {
+    return adaptRealtime(realtime_.get(), input, output, frame_count, channels);
 }
 
-void AdaptiveAudioProcessor::initializeEmotionPresets() {
-    // Пресет для спокойствия
-    AdaptationParameters calm_params;
-    calm_params.volume_multiplier = 0.8;
-    calm_params.tempo_multiplier = 0.9;
-    calm_params.bass_boost = 0.2;
-    calm_params.treble_boost = 0.1;
-    calm_params.reverb_amount = 0.3;
-    calm_params.echo_delay = 0.1;
-    emotion_presets_[EmotionalState::CALM] = calm_params;
-    
-    // Пресет для возбуждения
-    AdaptationParameters excited_params;
-    excited_params.volume_multiplier = 1.2;
-    excited_params.tempo_multiplier = 1.1;
-    excited_params.bass_boost = 0.4;
-    excited_params.treble_boost = 0.3;
-    excited_params.reverb_amount = 0.1;
-    excited_params.echo_delay = 0.0;
-    emotion_presets_[EmotionalState::EXCITED] = excited_params;
-    
-    // Пресет для стресса
-    AdaptationParameters stressed_params;
-    stressed_params.volume_multiplier = 0.7;
-    stressed_params.tempo_multiplier = 0.8;
-    stressed_params.bass_boost = 0.1;
-    stressed_params.treble_boost = 0.0;
-    stressed_params.reverb_amount = 0.5;
-    stressed_params.echo_delay = 0.2;
-    emotion_presets_[EmotionalState::STRESSED] = stressed_params;
-    
-    // Пресет для сосредоточенности
-    AdaptationParameters focused_params;
-    focused_params.volume_multiplier = 1.0;
-    focused_params.tempo_multiplier = 1.0;
-    focused_params.bass_boost = 0.0;
-    focused_params.treble_boost = 0.2;
-    focused_params.reverb_amount = 0.0;
-    focused_params.echo_delay = 0.0;
-    emotion_presets_[EmotionalState::FOCUSED] = focused_params;
-    
-    // Пресет для расслабления
-    AdaptationParameters relaxed_params;
-    relaxed_params.volume_multiplier = 0.9;
-    relaxed_params.tempo_multiplier = 0.85;
-    relaxed_params.bass_boost = 0.3;
-    relaxed_params.treble_boost = 0.0;
-    relaxed_params.reverb_amount = 0.4;
-    relaxed_params.echo_delay = 0.15;
-    emotion_presets_[EmotionalState::RELAXED] = relaxed_params;
+RealtimeAdaptation AdaptiveAudioProcessor::processRealtime(const float* input, float* output,
+                                                           size_t frame_count, size_t channels) {
+    return adaptRealtime(realtime_f_.get(), input, output, frame_count, channels);
 }
 
-AdaptationParameters AdaptiveAudioProcessor::smoothAdaptationParameters(const AdaptationParameters& new_params) {
-    if (parameter_history_.empty()) {
-        return new_params;
+template<typename Sample>
+RealtimeAdaptation AdaptiveAudioProcessor::adaptRealtime(RealtimeState<Sample>* state, const Sample* input,
+                                                         Sample* output, size_t frame_count, size_t channels) {
+    ANANTASOUND_STAGE_TIMER("adaptive.realtime");
+    RealtimeAdaptation result;
+    const size_t count = frame_count * channels;
+    
+    if (!state || frame_count == 0 || channels != state->channels) {
+        if (output != input) {
+            std::copy(input, input + count, output);
+        }
+        return result;
     }
     
-    // Простое сглаживание с предыдущими параметрами
-    AdaptationParameters smoothed;
-    double smoothing_factor = 0.3;
-    
-    smoothed.volume_multiplier = (1.0 - smoothing_factor) * new_params.volume_multiplier + 
-                                smoothing_factor * parameter_history_.back().volume_multiplier;
-    smoothed.tempo_multiplier = (1.0 - smoothing_factor) * new_params.tempo_multiplier + 
-                               smoothing_factor * parameter_history_.back().tempo_multiplier;
-    smoothed.bass_boost = (1.0 - smoothing_factor) * new_params.bass_boost + 
-                         smoothing_factor * parameter_history_.back().bass_boost;
-    smoothed.treble_boost = (1.0 - smoothing_factor) * new_params.treble_boost + 
-                           smoothing_factor * parameter_history_.back().treble_boost;
-    smoothed.reverb_amount = (1.0 - smoothing_factor) * new_params.reverb_amount + 
-                            smoothing_factor * parameter_history_.back().reverb_amount;
-    smoothed.echo_delay = (1.0 - smoothing_factor) * new_params.echo_delay + 
-                         smoothing_factor * parameter_history_.back().echo_delay;
-    
-    return smoothed;
-}
-
-std::vector<double> AdaptiveAudioProcessor::applyVolumeAdjustment(const std::vector<double>& audio, double multiplier) const {
-    std::vector<double> result = audio;
-    for (double& sample : result) {
-        sample *= multiplier;
-        // Ограничение амплитуды
-        sample = std::max(-1.0, std::min(1.0, sample));
+    // Управляющие изменения приходят через почтовый ящик; здесь ничего не блокируется
+    const RealtimeControl& control = control_mailbox_.read();
+    if (control.reset_generation != state->reset_generation) {
+        state->chain.reset();
+        state->reset_generation = control.reset_generation;
     }
-    return result;
-}
-
-std::vector<double> AdaptiveAudioProcessor::applyTempoAdjustment(const std::vector<double>& audio, double multiplier) const {
-    if (std::abs(multiplier - 1.0) < 0.01) {
-        return audio; // Нет изменений
+    if (control.reverb_time != state->reverb_time) {
+        state->chain.setReverbTime(control.reverb_time);
+        state->reverb_time = control.reverb_time;
     }
     
-    // Простая реализация изменения темпа через интерполяцию
-    std::vector<double> result;
-    result.reserve(static_cast<size_t>(audio.size() / multiplier));
-    
-    for (double i = 0; i < audio.size(); i += multiplier) {
-        size_t index = static_cast<size_t>(i);
-        if (index < audio.size()) {
-            result.push_back(audio[index]);
+    // Анализ читает вход до того, как эффекты перезапишут его на месте;
+    // анализатор смотрит не дальше окна, поэтому сводится только оно
+    if (channels > 1) {
+        size_t analyzed = std::min(frame_count, state->mixdown.size());
+        const Sample scale = Sample(1) / static_cast<Sample>(channels);
+        for (size_t frame = 0; frame < analyzed; ++frame) {
+            const Sample* samples = input + frame * channels;
+            Sample sum = Sample(0);
+            for (size_t c = 0; c < channels; ++c) {
+                sum += samples[c];
+            }
+            state->mixdown[frame] = sum * scale;
         }
+        audio_analyzer_->analyzeAudio(state->mixdown.data(), analyzed, state->analysis, state->frame);
+    } else {
+        audio_analyzer_->analyzeAudio(input, count, state->analysis, state->frame);
     }
-    
-    return result;
-}
-
-std::vector<double> AdaptiveAudioProcessor::applyBassBoost(const std::vector<double>& audio, double boost) const {
-    if (boost <= 0.0) {
-        return audio;
+    state->tempo.setHopSize(frame_count);
+    state->analysis.tempo = state->tempo.pushSpectrum(state->analysis.magnitude_spectrum.data(),
+                                                      state->analysis.magnitude_spectrum.size());
+    result.detected_emotion = detectEmotionalState(state->analysis);
+    
+    // Блок callback сохраняет длину, поэтому темп остается нейтральным
+    result.applied_parameters = smoothAdaptationParameters(
+        control.settings.presets[static_cast<size_t>(result.detected_emotion)]);
+    result.applied_parameters.tempo_multiplier = 1.0;
+    
+    if (output != input) {
+        std::copy(input, input + count, output);
     }
+    state->chain.setParameters(result.applied_parameters);
+    state->chain.processInterleaved(output, frame_count);
     
-    // Простое усиление низких частот через фильтр
-    std::vector<double> result = audio;
-    double alpha = boost * 0.1; // Коэффициент усиления
-    
-    for (size_t i = 1; i < result.size(); ++i) {
-        result[i] += alpha * (result[i] - result[i-1]);
-        result[i] = std::max(-1.0, std::min(1.0, result[i]));
-    }
+    result.confidence = calculateConfidence(state->analysis, result.detected_emotion);
+    updateHistory(result.detected_emotion, result.applied_parameters, result.confidence, frame_count);
     
     return result;
 }
 
-std::vector<double> AdaptiveAudioProcessor::applyTrebleBoost(const std::vector<double>& audio, double boost) const {
-    if (boost <= 0.0) {
-        return audio;
-    }
-    
-    // Простое усиление высоких частот
-    std::vector<double> result = audio;
-    double alpha = boost * 0.1;
+std::vector<double> AdaptiveAudioProcessor::processAudioWithParameters(
+    const std::vector<double>& input_audio,
+    const AdaptationParameters& parameters) {
     
-    for (size_t i = 1; i < result.size(); ++i) {
-        result[i] += alpha * (result[i] - result[i-1]);
-        result[i] = std::max(-1.0, std::min(1.0, result[i]));
-    }
+    ANANTASOUND_LOCK_GUARD(lock, processor_mutex_, "AdaptiveAudioProcessor::processor_mutex_");
+    return applyEffects(input_audio, parameters);
+}
+
+std::vector<float> AdaptiveAudioProcessor::processAudioWithParameters(
+    const std::vector<float>& input_audio,
+    const AdaptationParameters& parameters) {
     
-    return result;
+    ANANTASOUND_LOCK_GUARD(lock, processor_mutex_, "AdaptiveAudioProcessor::processor_mutex_");
+    return applyEffects(input_audio, parameters);
+}
+
+void AdaptiveAudioProcessor::processAudioWithParameters(const AudioBuffer& input, AudioBuffer& output,
+                                                        const AdaptationParameters& parameters) {
+    ANANTASOUND_LOCK_GUARD(lock, processor_mutex_, "AdaptiveAudioProcessor::processor_mutex_");
+    EffectsChain& chain = multichannelChain<double>(input.getChannelCount());
+    chain.setParameters(parameters);
+    chain.process(input, output);
 }
 
-std::vector<double> AdaptiveAudioProcessor::applyReverb(const std::vector<double>& audio, double amount) const {
-    if (amount <= 0.0) {
-        return audio;
+void AdaptiveAudioProcessor::processAudioWithParameters(const AudioBufferF& input, AudioBufferF& output,
+                                                        const AdaptationParameters& parameters) {
+    ANANTASOUND_LOCK_GUARD(lock, processor_mutex_, "AdaptiveAudioProcessor::processor_mutex_");
+    EffectsChainF& chain = multichannelChain<float>(input.getChannelCount());
+    chain.setParameters(parameters);
+    chain.process(input, output);
+}
+
+template<typename Sample>
+std::vector<Sample> AdaptiveAudioProcessor::applyEffects(const std::vector<Sample>& input_audio,
+                                                         const AdaptationParameters& parameters) {
+    // Один проход по буферу: темп формирует выходной буфер,
+    // остальные эффекты применяются на месте
+    BasicEffectsChain<Sample>& chain = effectsChain<Sample>();
+    chain.setParameters(parameters);
+    
+    std::vector<Sample> processed_audio;
+    chain.process(input_audio.data(), input_audio.size(), processed_audio);
+    return processed_audio;
+}
+
+void AdaptiveAudioProcessor::resetEffects() {
+    ANANTASOUND_LOCK_GUARD(lock, processor_mutex_, "AdaptiveAudioProcessor::processor_mutex_");
+    effects_chain_.reset();
+    effects_chain_f_.reset();
+    if (multichannel_chain_) {
+        multichannel_chain_->reset();
     }
-    
-    // Простая реверберация через задержку и затухание
-    std::vector<double> result = audio;
-    size_t delay_samples = static_cast<size_t>(sample_rate_ * 0.1 * amount); // 100ms delay
-    double decay = 0.3 * amount;
-    
-    for (size_t i = delay_samples; i < result.size(); ++i) {
-        result[i] += decay * audio[i - delay_samples];
-        result[i] = std::max(-1.0, std::min(1.0, result[i]));
+    if (multichannel_chain_f_) {
+        multichannel_chain_f_->reset();
     }
     
-    return result;
+    ANANTASOUND_LOCK_GUARD(control_lock, control_mutex_, "AdaptiveAudioProcessor::control_mutex_");
+    control_.reset_generation++;
+    publishControl();
 }
 
-std::vector<double> AdaptiveAudioProcessor::applyEcho(const std::vector<double>& audio, double delay) const {
-    if (delay <= 0.0) {
-        return audio;
+void AdaptiveAudioProcessor::setDomeAcoustics(const DomeAcousticResonator& dome, double frequency) {
+    double reverb_time = dome.calculateReverbTime(frequency);
+    
+    ANANTASOUND_LOCK_GUARD(lock, processor_mutex_, "AdaptiveAudioProcessor::processor_mutex_");
+    effects_chain_.setReverbTime(reverb_time);
+    effects_chain_f_.setReverbTime(reverb_time);
+    if (multichannel_chain_) {
+        multichannel_chain_->setReverbTime(reverb_time);
     }
-    
-    std::vector<double> result = audio;
-    size_t delay_samples = static_cast<size_t>(sample_rate_ * delay);
-    double echo_level = 0.3;
-    
-    for (size_t i = delay_samples; i < result.size(); ++i) {
-        result[i] += echo_level * audio[i - delay_samples];
-        result[i] = std::max(-1.0, std::min(1.0, result[i]));
+    if (multichannel_chain_f_) {
+        multichannel_chain_f_->setReverbTime(reverb_time);
     }
     
-    return result;
+    ANANTASOUND_LOCK_GUARD(control_lock, control_mutex_, "AdaptiveAudioProcessor::control_mutex_");
+    control_.reverb_time = reverb_time;
+    publishControl();
 }
 
-EmotionalState AdaptiveAudioProcessor::analyzeBreathingPattern(const AudioAnalysisResult& analysis) const {
-    // Анализ паттернов дыхания по частоте и амплитуде
-    if (analysis.fundamental_frequency < 0.5) { // Очень низкая частота - глубокое дыхание
-        return EmotionalState::RELAXED;
-    } else if (analysis.fundamental_frequency > 2.0) { // Высокая частота - учащенное дыхание
-        return EmotionalState::EXCITED;
-    } else if (analysis.volume_level > 0.7) { // Высокая громкость
-        return EmotionalState::STRESSED;
-    }
-    
-    return EmotionalState::CALM;
+EmotionalState AdaptiveAudioProcessor::detectEmotionalState(const AudioFeatures& analysis) const {
+    // Голосование детекторов дыхания, ритма и спектра по таблицам
+    return majorityVote(detectorVotes(analysis));
 }
 
-EmotionalState AdaptiveAudioProcessor::analyzeRhythmicPattern(const AudioAnalysisResult& analysis) const {
-    // Анализ ритмических паттернов
-    if (analysis.tempo > 120) { // Быстрый темп
-        return EmotionalState::EXCITED;
-    } else if (analysis.tempo < 80) { // Медленный темп
-        return EmotionalState::RELAXED;
-    } else if (analysis.zero_crossing_rate > 0.3) { // Высокая активность
-        return EmotionalState::FOCUSED;
+void AdaptiveAudioProcessor::classifyEmotions(const AudioFeatures* features, size_t count,
+                                              EmotionalState* emotions, double* confidences) const {
+    for (size_t i = 0; i < count; ++i) {
+        DetectorVotes votes = detectorVotes(features[i]);
+        emotions[i] = majorityVote(votes);
+        if (confidences) {
+            confidences[i] = agreement(votes, emotions[i]);
+        }
     }
-    
-    return EmotionalState::CALM;
 }
 
-EmotionalState AdaptiveAudioProcessor::analyzeSpectralCharacteristics(const AudioAnalysisResult& analysis) const {
-    // Анализ спектральных характеристик
-    if (analysis.spectral_centroid > 2000) { // Высокие частоты доминируют
-        return EmotionalState::FOCUSED;
-    } else if (analysis.spectral_centroid < 500) { // Низкие частоты доминируют
-        return EmotionalState::RELAXED;
-    } else if (analysis.spectral_rolloff > 4000) { // Широкий спектр
-        return EmotionalState::EXCITED;
-    }
-    
-    return EmotionalState::CALM;
+AdaptationParameters AdaptiveAudioProcessor::getAdaptationParameters(EmotionalState emotion) const {
+    ANANTASOUND_LOCK_GUARD(lock, control_mutex_, "AdaptiveAudioProcessor::control_mutex_");
+    return control_.settings.presets[static_cast<size_t>(emotion)];
+}
+
+void AdaptiveAudioProcessor::setEmotionPreset(EmotionalState emotion, const AdaptationParameters& parameters) {
+    ANANTASOUND_LOCK_GUARD(lock, control_mutex_, "AdaptiveAudioProcessor::control_mutex_");
+    control_.settings.presets[static_cast<size_t>(emotion)] = parameters;
+    publishControl();
+}
+
+void AdaptiveAudioProcessor::setAdaptationSensitivity(double sensitivity) {
+    ANANTASOUND_LOCK_GUARD(lock, control_mutex_, "AdaptiveAudioProcessor::control_mutex_");
+    control_.settings.adaptation_sensitivity = std::max(0.0, std::min(1.0, sensitivity));
+    publishControl();
 }
 
-void AdaptiveAudioProcessor::updateHistory(EmotionalState emotion, const AdaptationParameters& parameters) {
-    emotion_history_.push_back(emotion);
-    parameter_history_.push_back(parameters);
+double AdaptiveAudioProcessor::getAdaptationSensitivity() const {
+    ANANTASOUND_LOCK_GUARD(lock, control_mutex_, "AdaptiveAudioProcessor::control_mutex_");
+    return control_.settings.adaptation_sensitivity;
+}
+
+void AdaptiveAudioProcessor::applySettings(const AdaptiveSettings& settings) {
+    ANANTASOUND_LOCK_GUARD(lock, control_mutex_, "AdaptiveAudioProcessor::control_mutex_");
+    control_.settings = settings;
+    control_.settings.adaptation_sensitivity = std::max(0.0, std::min(1.0, settings.adaptation_sensitivity));
+    publishControl();
+}
+
+AdaptiveSettings AdaptiveAudioProcessor::getSettings() const {
+    ANANTASOUND_LOCK_GUARD(lock, control_mutex_, "AdaptiveAudioProcessor::control_mutex_");
+    return control_.settings;
+}
+
+AdaptiveAudioProcessor::ProcessorStatistics AdaptiveAudioProcessor::getStatistics() const {
+    ProcessorStatistics stats;
+    uint64_t blocks = processed_blocks_.load(std::memory_order_relaxed);
+    double scale = blocks > 0 ? 1.0 / static_cast<double>(blocks) : 0.0;
+    stats.total_processed_samples = static_cast<size_t>(processed_samples_.load(std::memory_order_relaxed));
+    stats.total_processed_blocks = static_cast<size_t>(blocks);
+    stats.most_common_emotion = getMostCommonEmotion();
+    stats.average_confidence = confidence_sum_.load(std::memory_order_relaxed) * scale;
+    stats.average_volume_adjustment = volume_sum_.load(std::memory_order_relaxed) * scale;
+    stats.average_tempo_adjustment = tempo_sum_.load(std::memory_order_relaxed) * scale;
     
-    // Ограничиваем размер истории
-    if (emotion_history_.size() > history_size_) {
-        emotion_history_.erase(emotion_history_.begin());
-    }
-    if (parameter_history_.size() > history_size_) {
-        parameter_history_.erase(parameter_history_.begin());
-    }
+    return stats;
 }
 
-EmotionalState AdaptiveAudioProcessor::getMostCommonEmotion() const {
-    if (emotion_history_.empty()) {
-        return EmotionalState::UNKNOWN;
+void AdaptiveAudioProcessor::publishControl() {
+    control_mailbox_.publish(control_);
+    block_mailbox_.publish(control_);
+}
+
+AdaptationParameters AdaptiveAudioProcessor::smoothAdaptationParameters(const AdaptationParameters& new_params) {
+    if (history_count_ == 0) {
+        return new_params;
     }
     
-    std::map<EmotionalState, int> counts;
-    for (const auto& emotion : emotion_history_) {
-        counts[emotion]++;
-    }
+    // Простое сглаживание с предыдущими параметрами
+    const AdaptationParameters& previous = parameter_history_[(history_next_ + kHistorySize - 1) % kHistorySize];
+    AdaptationParameters smoothed;
+    double smoothing_factor = 0.3;
     
-    auto max_count = std::max_element(counts.begin(), counts.end(),
-        [](const auto& a, const auto& b) { return a.second < b.second; });
+    smoothed.volume_multiplier = (1.0 - smoothing_factor) * new_params.volume_multiplier + 
+                                smoothing_factor * previous.volume_multiplier;
+    smoothed.tempo_multiplier = (1.0 - smoothing_factor) * new_params.tempo_multiplier + 
+                               smoothing_factor * previous.tempo_multiplier;
+    smoothed.bass_boost = (1.0 - smoothing_factor) * new_params.bass_boost + 
+                         smoothing_factor * previous.bass_boost;
+    smoothed.treble_boost = (1.0 - smoothing_factor) * new_params.treble_boost + 
+                           smoothing_factor * previous.treble_boost;
+    smoothed.reverb_amount = (1.0 - smoothing_factor) * new_params.reverb_amount + 
+                            smoothing_factor * previous.reverb_amount;
+    smoothed.echo_delay = (1.0 - smoothing_factor) * new_params.echo_delay + 
+                         smoothing_factor * previous.echo_delay;
     
-    return max_count->first;
+    return smoothed;
+}
+
+double AdaptiveAudioProcessor::calculateConfidence(const AudioFeatures& analysis, EmotionalState emotion) const {
+    // Доля методов анализа, согласных с итоговым решением
+    return agreement(detectorVotes(analysis), emotion);
+}
+
+void AdaptiveAudioProcessor::updateHistory(EmotionalState emotion, const AdaptationParameters& parameters,
+                                           double confidence, size_t frames) {
+    // Итоги для getStatistics и счетчики метрик процесса
+    addRelaxed(confidence_sum_, confidence);
+    addRelaxed(volume_sum_, parameters.volume_multiplier);
+    addRelaxed(tempo_sum_, parameters.tempo_multiplier);
+    processed_samples_.fetch_add(frames, std::memory_order_relaxed);
+    processed_blocks_.fetch_add(1, std::memory_order_relaxed);
+    ANANTASOUND_COUNT("processed_samples", "adaptive", frames);
+    ANANTASOUND_COUNT("processed_blocks", "adaptive", 1);
+    
+    // Кольцевой буфер: самая старая запись вытесняется на месте
+    if (history_count_ == kHistorySize) {
+        emotion_counts_[static_cast<size_t>(emotion_history_[history_next_])]--;
+    } else {
+        history_count_++;
+    }
+    emotion_history_[history_next_] = emotion;
+    parameter_history_[history_next_] = parameters;
+    emotion_counts_[static_cast<size_t>(emotion)]++;
+    history_next_ = (history_next_ + 1) % kHistorySize;
+    
+    // Наиболее частая эмоция публикуется для getStatistics из других потоков
+    auto max_count = std::max_element(emotion_counts_.begin(), emotion_counts_.end());
+    most_common_emotion_.store(static_cast<EmotionalState>(max_count - emotion_counts_.begin()),
+                               std::memory_order_relaxed);
+}
+
+EmotionalState AdaptiveAudioProcessor::getMostCommonEmotion() const {
+    return most_common_emotion_.load(std::memory_order_relaxed);
 }
 
 } // namespace AnantaSound
@@ -1,14 +1,21 @@
 #pragma once
 
 #include "audio_analyzer.hpp"
+#include "effects_chain.hpp"
+#include "tempo_tracker.hpp"
+#include "parameter_mailbox.hpp"
+#include <array>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <mutex>
 #include <chrono>
-#include <map>
+#include <cstdint>
 
 namespace AnantaSound {
 
+class DomeAcousticResonator;
+
 // Эмоциональные состояния
 enum class EmotionalState {
     CALM,           // Спокойствие
@@ -19,52 +26,131 @@ enum class EmotionalState {
     UNKNOWN         // Неизвестно
 };
 
-// Параметры адаптации
-struct AdaptationParameters {
-    double volume_multiplier;      // Множитель громкости (0.0 - 2.0)
-    double tempo_multiplier;       // Множитель темпа (0.5 - 2.0)
-    double bass_boost;             // Усиление басов (0.0 - 1.0)
-    double treble_boost;           // Усиление высоких частот (0.0 - 1.0)
-    double reverb_amount;          // Количество реверберации (0.0 - 1.0)
-    double echo_delay;             // Задержка эха (0.0 - 1.0)
-    
-    AdaptationParameters() : volume_multiplier(1.0), tempo_multiplier(1.0),
-                           bass_boost(0.0), treble_boost(0.0),
-                           reverb_amount(0.0), echo_delay(0.0) {}
-};
+constexpr size_t kEmotionalStateCount = static_cast<size_t>(EmotionalState::UNKNOWN) + 1;
 
-// Результат адаптации
-struct AdaptationResult {
-    std::vector<double> processed_audio;
+// Результат адаптации (Sample - тип отсчетов: double или float)
+template<typename Sample>
+struct BasicAdaptationResult {
+    std::vector<Sample> processed_audio;
     EmotionalState detected_emotion;
     AdaptationParameters applied_parameters;
     double confidence;             // Уверенность в определении эмоции (0.0 - 1.0)
     std::chrono::high_resolution_clock::time_point timestamp;
     
-    AdaptationResult() : detected_emotion(EmotionalState::UNKNOWN), confidence(0.0),
-                        timestamp(std::chrono::high_resolution_clock::now()) {}
+    BasicAdaptationResult() : detected_emotion(EmotionalState::UNKNOWN), confidence(0.0),
+                             timestamp(std::chrono::high_resolution_clock::now()) {}
+};
+
+using AdaptationResult = BasicAdaptationResult<double>;
+using AdaptationResultF = BasicAdaptationResult<float>;
+
+// Результат блока в режиме реального времени (обработанный звук - в буфере вызывающего)
+struct RealtimeAdaptation {
+    EmotionalState detected_emotion;
+    AdaptationParameters applied_parameters;   // Темп всегда 1.0: блок не меняет длину
+    double confidence;
+    
+    RealtimeAdaptation() : detected_emotion(EmotionalState::UNKNOWN), confidence(0.0) {}
+};
+
+// Параметры процессора, меняемые на лету: пресеты по эмоциям (индекс -
+// EmotionalState) и чувствительность адаптации
+struct AdaptiveSettings {
+    AdaptationParameters presets[kEmotionalStateCount];
+    double adaptation_sensitivity;             // 0.0 - 1.0
+    
+    AdaptiveSettings();                        // Пресеты по умолчанию
 };
 
-// Адаптивный аудио процессор
+// Адаптивный аудио процессор.
+// Режим реального времени: после prepareRealtime() вызов processRealtime()
+// не берет мьютексов и не выделяет память, поэтому годится для аудио
+// callback. Пресеты, время реверберации и сброс эффектов доходят до него
+// через lock-free почтовый ящик параметров; у режима свои цепочки эффектов
+// и буферы анализа. processRealtime() и processAudio() не вызываются
+// одновременно (они делят историю эмоций); управляющие вызовы безопасны из
+// любого потока. Пресеты и чувствительность публикуются под отдельным
+// мьютексом, не занятым обработкой: их установка не ждет идущего блока, а
+// обработка подхватывает новый снимок на границе следующего блока.
 class AdaptiveAudioProcessor {
 private:
+    // Снимок управляющих параметров для потока реального времени
+    struct RealtimeControl {
+        AdaptiveSettings settings;
+        double reverb_time;
+        uint64_t reset_generation;             // Растет при каждом resetEffects()
+    };
+    
+    // Состояние режима реального времени для типа отсчетов
+    template<typename Sample>
+    struct RealtimeState {
+        using SampleType = Sample;
+        
+        BasicEffectsChain<Sample> chain;
+        BasicAudioAnalysisResult<Sample> analysis;
+        AudioAnalyzer::BasicFrameScratch<Sample> frame;
+        TempoTracker tempo;                    // Блоки callback идут подряд: шаг равен длине блока
+        std::vector<Sample> mixdown;           // Сведение каналов для анализа (fft_size кадров)
+        size_t channels;
+        double reverb_time;
+        uint64_t reset_generation;
+        
+        RealtimeState(size_t fft_size, size_t sample_rate, size_t channel_count)
+            : chain(sample_rate, channel_count), tempo(fft_size, sample_rate, fft_size),
+              mixdown(channel_count > 1 ? fft_size : 0), channels(channel_count),
+              reverb_time(chain.getReverbTime()), reset_generation(0) {}
+    };
+    
+    static constexpr size_t kHistorySize = 10;
+    
     std::unique_ptr<AudioAnalyzer> audio_analyzer_;
-    std::map<EmotionalState, AdaptationParameters> emotion_presets_;
     mutable std::mutex processor_mutex_;
     
+    // Управляющий снимок. settings меняются под control_mutex_, reverb_time и
+    // reset_generation - под обоими мьютексами (processor_mutex_ первым)
+    mutable std::mutex control_mutex_;
+    RealtimeControl control_;                  // Последний опубликованный снимок
+    ParameterMailbox<RealtimeControl> control_mailbox_;    // Читает processRealtime
+    ParameterMailbox<RealtimeControl> block_mailbox_;      // Читает processAudio (под processor_mutex_)
+    
+    // Режим реального времени
+    std::unique_ptr<RealtimeState<double>> realtime_;
+    std::unique_ptr<RealtimeState<float>> realtime_f_;
+    
+    // Темп последовательных блоков processAudio (под мьютексом)
+    TempoTracker tempo_tracker_;
+    
+    // Цепочки эффектов; состояние фильтров и задержек сохраняется между блоками
+    EffectsChain effects_chain_;
+    EffectsChainF effects_chain_f_;
+    
+    // Многоканальные цепочки: по полосе состояния на канал; создаются при
+    // первом многоканальном блоке, чтобы не сбивать состояние моно-потока
+    std::unique_ptr<EffectsChain> multichannel_chain_;
+    std::unique_ptr<EffectsChainF> multichannel_chain_f_;
+    
     // Параметры анализа
     size_t analysis_window_size_;
     size_t sample_rate_;
-    double adaptation_sensitivity_;    // Чувствительность адаптации (0.0 - 1.0)
     
-    // История для сглаживания
-    std::vector<EmotionalState> emotion_history_;
-    std::vector<AdaptationParameters> parameter_history_;
-    size_t history_size_;
+    // История для сглаживания: кольцевые буферы фиксированного размера
+    std::array<EmotionalState, kHistorySize> emotion_history_;
+    std::array<AdaptationParameters, kHistorySize> parameter_history_;
+    std::array<size_t, kEmotionalStateCount> emotion_counts_;
+    size_t history_count_;
+    size_t history_next_;
+    std::atomic<EmotionalState> most_common_emotion_;
+    
+    // Накопленные итоги для getStatistics (за все время, без блокировки)
+    std::atomic<uint64_t> processed_samples_;
+    std::atomic<uint64_t> processed_blocks_;
+    std::atomic<double> confidence_sum_;
+    std::atomic<double> volume_sum_;
+    std::atomic<double> tempo_sum_;
     
 public:
     AdaptiveAudioProcessor(size_t fft_size = 1024, size_t sample_rate = 44100);
-    ~AdaptativeAudioProcessor() = default;
+    ~AdaptiveAudioProcessor() = default;
     
     // Инициализация процессора
     bool initialize();
@@ -76,8 +162,62 @@ public:
     std::vector<double> processAudioWithParameters(const std::vector<double>& input_audio,
                                                   const AdaptationParameters& parameters);
     
+    // Обработка в одинарной точности: анализ и эффекты без перевода в double
+    AdaptationResultF processAudio(const std::vector<float>& input_audio);
+    std::vector<float> processAudioWithParameters(const std::vector<float>& input_audio,
+                                                 const AdaptationParameters& parameters);
+    
+    // Многоканальная обработка (чередующиеся или планарные каналы): эмоция
+    // определяется по сведению всех каналов, эффекты с общими параметрами
+    // применяются к каждому каналу со своим состоянием. Результат - в output
+    // в раскладке input; processed_audio остается пустым.
+    AdaptationResult processAudio(const AudioBuffer& input, AudioBuffer& output);
+    AdaptationResultF processAudio(const AudioBufferF& input, AudioBufferF& output);
+    void processAudioWithParameters(const AudioBuffer& input, AudioBuffer& output,
+                                    const AdaptationParameters& parameters);
+    void processAudioWithParameters(const AudioBufferF& input, AudioBufferF& output,
+                                    const AdaptationParameters& parameters);
+    
+    // Подготовка режима реального времени (вне аудио потока, до его запуска)
+    // для channels чередующихся каналов; false, если у анализатора нет плана FFT
+    bool prepareRealtime(size_t channels = 1);
+    bool isRealtimePrepared() const { return realtime_ && realtime_f_; }
+    
+    // Обработка блока в реальном времени: без мьютексов и выделения памяти.
+    // output может совпадать с input; темп не меняется. До prepareRealtime()
+    // блок копируется без изменений. Вызывается из одного потока.
+    RealtimeAdaptation processRealtime(const double* input, double* output, size_t count);
+    RealtimeAdaptation processRealtime(const float* input, float* output, size_t count);
+    
+    // Блок из frame_count чередующихся кадров по channels отсчетов; channels
+    // должно совпадать с prepareRealtime(), иначе блок копируется без изменений
+    RealtimeAdaptation processRealtime(const double* input, double* output, size_t frame_count, size_t channels);
+    RealtimeAdaptation processRealtime(const float* input, float* output, size_t frame_count, size_t channels);
+    
+    // Цепочка эффектов для потоковой обработки без копий (без блокировки;
+    // для одного потока реального времени)
+    EffectsChain& getEffectsChain() { return effects_chain_; }
+    EffectsChainF& getEffectsChainF() { return effects_chain_f_; }
+    
+    // Сброс состояния эффектов (например, при перемотке)
+    void resetEffects();
+    
+    // Время затухания реверберации по акустике купола на заданной частоте
+    void setDomeAcoustics(const DomeAcousticResonator& dome, double frequency = 1000.0);
+    
     // Определение эмоционального состояния
-    EmotionalState detectEmotionalState(const AudioAnalysisResult& analysis) const;
+    EmotionalState detectEmotionalState(const AudioFeatures& analysis) const;
+    
+    // Уверенность в определении эмоции (доля согласных методов анализа)
+    double calculateConfidence(const AudioFeatures& analysis, EmotionalState emotion) const;
+    
+    // Эмоции (и уверенность, если confidences не nullptr) для многих кадров
+    // или сеансов сразу; без блокировок и выделения памяти
+    void classifyEmotions(const AudioFeatures* features, size_t count,
+                          EmotionalState* emotions, double* confidences = nullptr) const;
+    
+    // Анализатор процессора (план FFT и окно; const-вызовы без блокировки)
+    const AudioAnalyzer& getAudioAnalyzer() const { return *audio_analyzer_; }
     
     // Получение параметров адаптации для эмоции
     AdaptationParameters getAdaptationParameters(EmotionalState emotion) const;
@@ -87,44 +227,60 @@ public:
     
     // Настройка чувствительности
     void setAdaptationSensitivity(double sensitivity);
+    double getAdaptationSensitivity() const;
     
-    // Получение статистики
+    // Все пресеты и чувствительность одним снимком (например, из LiveConfig)
+    void applySettings(const AdaptiveSettings& settings);
+    AdaptiveSettings getSettings() const;
+    
+    // Получение статистики: кадры и средние за все обработанные блоки
+    // (processAudio и processRealtime), эмоция - по последним блокам истории
     struct ProcessorStatistics {
-        size_t total_processed_samples;
+        size_t total_processed_samples;         // Кадры (отсчеты на канал)
+        size_t total_processed_blocks;
         EmotionalState most_common_emotion;
         double average_confidence;
-        double average_volume_adjustment;
-        double average_tempo_adjustment;
+        double average_volume_adjustment;       // Средний volume_multiplier
+        double average_tempo_adjustment;        // Средний tempo_multiplier
     };
     
     ProcessorStatistics getStatistics() const;
     
 private:
-    // Инициализация пресетов эмоций
-    void initializeEmotionPresets();
-    
     // Сглаживание параметров адаптации
     AdaptationParameters smoothAdaptationParameters(const AdaptationParameters& new_params);
     
-    // Применение эффектов к аудио
-    std::vector<double> applyVolumeAdjustment(const std::vector<double>& audio, double multiplier) const;
-    std::vector<double> applyTempoAdjustment(const std::vector<double>& audio, double multiplier) const;
-    std::vector<double> applyBassBoost(const std::vector<double>& audio, double boost) const;
-    std::vector<double> applyTrebleBoost(const std::vector<double>& audio, double boost) const;
-    std::vector<double> applyReverb(const std::vector<double>& audio, double amount) const;
-    std::vector<double> applyEcho(const std::vector<double>& audio, double delay) const;
+    // Общая реализация для double и float
+    template<typename Sample>
+    BasicAdaptationResult<Sample> adaptAudio(const std::vector<Sample>& input_audio);
+    template<typename Sample>
+    BasicAdaptationResult<Sample> adaptBuffer(const BasicAudioBuffer<Sample>& input, BasicAudioBuffer<Sample>& output);
+    
+    // Анализ моно-блока, эмоция, сглаженные параметры и уверенность
+    // (вызывается под processor_mutex_)
+    template<typename Sample>
+    void classifyBlock(const Sample* samples, size_t count, BasicAdaptationResult<Sample>& result);
+    
+    // Применение эффектов к аудио (вызывается под processor_mutex_)
+    template<typename Sample>
+    std::vector<Sample> applyEffects(const std::vector<Sample>& input_audio,
+                                     const AdaptationParameters& parameters);
     
-    // Анализ паттернов дыхания
-    EmotionalState analyzeBreathingPattern(const AudioAnalysisResult& analysis) const;
+    // Цепочка эффектов для типа отсчетов (специализации в .cpp)
+    template<typename Sample> BasicEffectsChain<Sample>& effectsChain();
+    template<typename Sample> BasicEffectsChain<Sample>& multichannelChain(size_t channels);
     
-    // Анализ ритмических паттернов
-    EmotionalState analyzeRhythmicPattern(const AudioAnalysisResult& analysis) const;
+    // Общая реализация processRealtime
+    template<typename Sample>
+    RealtimeAdaptation adaptRealtime(RealtimeState<Sample>* state, const Sample* input,
+                                     Sample* output, size_t frame_count, size_t channels);
     
-    // Анализ спектральных характеристик
-    EmotionalState analyzeSpectralCharacteristics(const AudioAnalysisResult& analysis) const;
+    // Публикация управляющего снимка (вызывается под control_mutex_)
+    void publishControl();
     
-    // Обновление истории
-    void updateHistory(EmotionalState emotion, const AdaptationParameters& parameters);
+    // Обновление истории и итогов блока из frames кадров (без выделения памяти)
+    void updateHistory(EmotionalState emotion, const AdaptationParameters& parameters,
+                       double confidence, size_t frames);
     
     // Получение наиболее частой эмоции из истории
     EmotionalState getMostCommonEmotion() const;
@@ -1,87 +1,983 @@
 #include "anantasound_core.hpp"
+#include "instrumentation.hpp"
+#include "interference_backend.hpp"
+#include "interference_cluster_tree.hpp"
+#include "interference_kernels.hpp"
+#include "metrics.hpp"
+#include "session_recorder.hpp"
+#include "shared_field_output.hpp"
+#include "thread_pool.hpp"
+#include "async_task.hpp"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <chrono>
 #include <thread>
+#include <tuple>
 
 namespace AnantaSound {
 
+// FieldBuffer implementation
+void FieldBuffer::assign(const std::vector<QuantumSoundField>& fields) {
+    clear();
+    reserve(fields.size());
+    for (const auto& field : fields) {
+        push_back(field);
+    }
+}
+
+void FieldBuffer::push_back(const QuantumSoundField& field) {
+    amplitude_real_.push_back(field.amplitude.real());
+    amplitude_imag_.push_back(field.amplitude.imag());
+    phase_.push_back(field.phase);
+    frequency_.push_back(field.frequency);
+    state_.push_back(field.quantum_state);
+    r_.push_back(field.position.r);
+    theta_.push_back(field.position.theta);
+    phi_.push_back(field.position.phi);
+    t_.push_back(field.position.t);
+    height_.push_back(field.position.height);
+    timestamp_.push_back(field.timestamp);
+    track(size() - 1);
+}
+
+void FieldBuffer::set(size_t index, const QuantumSoundField& field) {
+    untrack(index);
+    amplitude_real_[index] = field.amplitude.real();
+    amplitude_imag_[index] = field.amplitude.imag();
+    phase_[index] = field.phase;
+    frequency_[index] = field.frequency;
+    state_[index] = field.quantum_state;
+    r_[index] = field.position.r;
+    theta_[index] = field.position.theta;
+    phi_[index] = field.position.phi;
+    t_[index] = field.position.t;
+    height_[index] = field.position.height;
+    timestamp_[index] = field.timestamp;
+    track(index);
+}
+
+void FieldBuffer::setAmplitude(size_t index, std::complex<double> amplitude) {
+    amplitude_magnitude_sum_ +=
+        std::sqrt(amplitude.real() * amplitude.real() + amplitude.imag() * amplitude.imag()) -
+        std::sqrt(amplitude_real_[index] * amplitude_real_[index] + amplitude_imag_[index] * amplitude_imag_[index]);
+    amplitude_real_[index] = amplitude.real();
+    amplitude_imag_[index] = amplitude.imag();
+}
+
+void FieldBuffer::setPhase(size_t index, double phase) {
+    phase_sin_sum_ += std::sin(phase) - std::sin(phase_[index]);
+    phase_cos_sum_ += std::cos(phase) - std::cos(phase_[index]);
+    phase_[index] = phase;
+}
+
+void FieldBuffer::setState(size_t index, QuantumSoundState state) {
+    --state_counts_[static_cast<size_t>(state_[index])];
+    state_[index] = state;
+    ++state_counts_[static_cast<size_t>(state)];
+}
+
+void FieldBuffer::recordStateTransitions(QuantumSoundState from, QuantumSoundState to, size_t count) {
+    state_counts_[static_cast<size_t>(from)] -= count;
+    state_counts_[static_cast<size_t>(to)] += count;
+}
+
+void FieldBuffer::recordPhaseSums(double sin_sum, double cos_sum) {
+    phase_sin_sum_ = sin_sum;
+    phase_cos_sum_ = cos_sum;
+}
+
+void FieldBuffer::track(size_t index) {
+    ++state_counts_[static_cast<size_t>(state_[index])];
+    amplitude_magnitude_sum_ += std::sqrt(amplitude_real_[index] * amplitude_real_[index] +
+                                          amplitude_imag_[index] * amplitude_imag_[index]);
+    phase_sin_sum_ += std::sin(phase_[index]);
+    phase_cos_sum_ += std::cos(phase_[index]);
+}
+
+void FieldBuffer::untrack(size_t index) {
+    --state_counts_[static_cast<size_t>(state_[index])];
+    amplitude_magnitude_sum_ -= std::sqrt(amplitude_real_[index] * amplitude_real_[index] +
+                                          amplitude_imag_[index] * amplitude_imag_[index]);
+    phase_sin_sum_ -= std::sin(phase_[index]);
+    phase_cos_sum_ -= std::cos(phase_[index]);
+}
+
+QuantumSoundField FieldBuffer::get(size_t index) const {
+    QuantumSoundField field;
+    field.amplitude = std::complex<double>(amplitude_real_[index], amplitude_imag_[index]);
+    field.phase = phase_[index];
+    field.frequency = frequency_[index];
+    field.quantum_state = state_[index];
+    field.position = SphericalCoord(r_[index], theta_[index], phi_[index], t_[index], height_[index]);
+    field.timestamp = timestamp_[index];
+    return field;
+}
+
+void FieldBuffer::swapRemove(size_t index) {
+    const size_t last = size() - 1;
+    if (index != last) {
+        set(index, get(last));
+    }
+    untrack(last);
+    if (last == 0) {
+        amplitude_magnitude_sum_ = 0.0;     // Drop accumulated rounding with the last field
+        phase_sin_sum_ = 0.0;
+        phase_cos_sum_ = 0.0;
+    }
+    amplitude_real_.pop_back();
+    amplitude_imag_.pop_back();
+    phase_.pop_back();
+    frequency_.pop_back();
+    state_.pop_back();
+    r_.pop_back();
+    theta_.pop_back();
+    phi_.pop_back();
+    t_.pop_back();
+    height_.pop_back();
+    timestamp_.pop_back();
+}
+
+void FieldBuffer::toFields(std::vector<QuantumSoundField>& fields) const {
+    fields.resize(size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+        fields[i] = get(i);
+    }
+}
+
+void FieldBuffer::toFields(FieldVector& fields) const {
+    fields.resize(size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+        fields[i] = get(i);
+    }
+}
+
+std::vector<QuantumSoundField> FieldBuffer::toFields() const {
+    std::vector<QuantumSoundField> fields;
+    toFields(fields);
+    return fields;
+}
+
+void FieldBuffer::reserve(size_t count) {
+    amplitude_real_.reserve(count);
+    amplitude_imag_.reserve(count);
+    phase_.reserve(count);
+    frequency_.reserve(count);
+    state_.reserve(count);
+    r_.reserve(count);
+    theta_.reserve(count);
+    phi_.reserve(count);
+    t_.reserve(count);
+    height_.reserve(count);
+    timestamp_.reserve(count);
+}
+
+void FieldBuffer::clear() {
+    amplitude_real_.clear();
+    amplitude_imag_.clear();
+    phase_.clear();
+    frequency_.clear();
+    state_.clear();
+    r_.clear();
+    theta_.clear();
+    phi_.clear();
+    t_.clear();
+    height_.clear();
+    timestamp_.clear();
+    std::fill(std::begin(state_counts_), std::end(state_counts_), 0);
+    amplitude_magnitude_sum_ = 0.0;
+    phase_sin_sum_ = 0.0;
+    phase_cos_sum_ = 0.0;
+}
+
+size_t FieldBuffer::countStates(std::initializer_list<QuantumSoundState> states) const {
+    // One bit per state so a state listed twice is counted once
+    uint32_t mask = 0;
+    for (QuantumSoundState state : states) {
+        mask |= 1u << static_cast<uint32_t>(state);
+    }
+
+    size_t matches = 0;
+    for (size_t state = 0; state < kQuantumStateCount; ++state) {
+        if ((mask >> state) & 1u) {
+            matches += state_counts_[state];
+        }
+    }
+    return matches;
+}
+
+// SpatialFieldIndex implementation
+namespace {
+
+// Cell coordinates are packed into 21 bits per axis
+constexpr int64_t kCellCoordinateLimit = (int64_t(1) << 20) - 1;
+
+inline void hashCombine(size_t& seed, double value) {
+    seed ^= std::hash<double>()(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+} // namespace
+
+size_t SpatialFieldIndex::PositionHash::operator()(const SphericalCoord& position) const {
+    // std::hash<double> maps -0.0 and 0.0 alike, matching PositionEqual
+    size_t seed = 0;
+    hashCombine(seed, position.r);
+    hashCombine(seed, position.theta);
+    hashCombine(seed, position.phi);
+    hashCombine(seed, position.t);
+    hashCombine(seed, position.height);
+    return seed;
+}
+
+SpatialFieldIndex::SpatialFieldIndex(double cell_size)
+    : cell_size_(cell_size > 0.0 ? cell_size : 0.5) {
+}
+
+int64_t SpatialFieldIndex::cellCoordinate(double value) const {
+    double cell = std::floor(value / cell_size_);
+    if (!(cell > -static_cast<double>(kCellCoordinateLimit))) {
+        return -kCellCoordinateLimit;
+    }
+    return std::min(static_cast<int64_t>(cell), kCellCoordinateLimit);
+}
+
+uint64_t SpatialFieldIndex::packCell(int64_t x, int64_t y, int64_t z) {
+    const uint64_t mask = (uint64_t(1) << 21) - 1;
+    return (static_cast<uint64_t>(x + kCellCoordinateLimit) & mask) |
+           ((static_cast<uint64_t>(y + kCellCoordinateLimit) & mask) << 21) |
+           ((static_cast<uint64_t>(z + kCellCoordinateLimit) & mask) << 42);
+}
+
+size_t SpatialFieldIndex::insertOrAssign(const QuantumSoundField& field) {
+    auto [slot, inserted] = slots_.try_emplace(field.position, fields_.size());
+    if (!inserted) {
+        // Same position: same cell, only the payload changes
+        fields_.set(slot->second, field);
+        return slot->second;
+    }
+
+    CartesianPosition position = CartesianPosition::fromSpherical(field.position);
+    uint64_t key = packCell(cellCoordinate(position.x), cellCoordinate(position.y),
+                            cellCoordinate(position.z));
+    fields_.push_back(field);
+    positions_.push_back(position);
+    cell_keys_.push_back(key);
+    cells_[key].push_back(slot->second);
+    return slot->second;
+}
+
+void SpatialFieldIndex::removeFromCell(uint64_t key, size_t index) {
+    auto cell = cells_.find(key);
+    if (cell == cells_.end()) {
+        return;
+    }
+    std::vector<size_t>& members = cell->second;
+    auto it = std::find(members.begin(), members.end(), index);
+    if (it != members.end()) {
+        *it = members.back();
+        members.pop_back();
+    }
+    if (members.empty()) {
+        cells_.erase(cell);
+    }
+}
+
+bool SpatialFieldIndex::erase(const SphericalCoord& position) {
+    auto slot = slots_.find(position);
+    if (slot == slots_.end()) {
+        return false;
+    }
+
+    const size_t index = slot->second;
+    const size_t last = fields_.size() - 1;
+    removeFromCell(cell_keys_[index], index);
+    slots_.erase(slot);
+
+    if (index != last) {
+        // Move the last field into the hole and re-point its slot and cell entry
+        positions_[index] = positions_[last];
+        cell_keys_[index] = cell_keys_[last];
+        slots_[fields_.get(last).position] = index;
+
+        std::vector<size_t>& members = cells_[cell_keys_[index]];
+        std::replace(members.begin(), members.end(), last, index);
+    }
+
+    fields_.swapRemove(index);
+    positions_.pop_back();
+    cell_keys_.pop_back();
+    return true;
+}
+
+size_t SpatialFieldIndex::find(const SphericalCoord& position) const {
+    auto slot = slots_.find(position);
+    return slot != slots_.end() ? slot->second : npos;
+}
+
+void SpatialFieldIndex::queryRadius(const SphericalCoord& center, double radius,
+                                    std::vector<size_t>& indices) const {
+    indices.clear();
+    if (fields_.empty() || radius < 0.0) {
+        return;
+    }
+
+    const CartesianPosition c = CartesianPosition::fromSpherical(center);
+    const double radius_squared = radius * radius;
+    auto within = [&](size_t index) {
+        double dx = positions_[index].x - c.x;
+        double dy = positions_[index].y - c.y;
+        double dz = positions_[index].z - c.z;
+        return dx * dx + dy * dy + dz * dz <= radius_squared;
+    };
+
+    const int64_t x0 = cellCoordinate(c.x - radius), x1 = cellCoordinate(c.x + radius);
+    const int64_t y0 = cellCoordinate(c.y - radius), y1 = cellCoordinate(c.y + radius);
+    const int64_t z0 = cellCoordinate(c.z - radius), z1 = cellCoordinate(c.z + radius);
+    const double box_cells = static_cast<double>(x1 - x0 + 1) *
+                             static_cast<double>(y1 - y0 + 1) *
+                             static_cast<double>(z1 - z0 + 1);
+
+    // A query box with more cells than occupied cells is cheaper as a scan
+    if (box_cells > static_cast<double>(cells_.size())) {
+        for (const auto& [key, members] : cells_) {
+            for (size_t index : members) {
+                if (within(index)) {
+                    indices.push_back(index);
+                }
+            }
+        }
+        return;
+    }
+
+    for (int64_t x = x0; x <= x1; ++x) {
+        for (int64_t y = y0; y <= y1; ++y) {
+            for (int64_t z = z0; z <= z1; ++z) {
+                auto cell = cells_.find(packCell(x, y, z));
+                if (cell == cells_.end()) {
+                    continue;
+                }
+                for (size_t index : cell->second) {
+                    if (within(index)) {
+                        indices.push_back(index);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void SpatialFieldIndex::clear() {
+    fields_.clear();
+    positions_.clear();
+    cell_keys_.clear();
+    slots_.clear();
+    cells_.clear();
+}
+
 // InterferenceField implementation
-InterferenceField::InterferenceField(InterferenceFieldType type, SphericalCoord center, double radius)
-    : type_(type), center_(center), field_radius_(radius) {
+namespace {
+
+// Phase/amplitude weighting of a source by its quantum state
+std::complex<double> quantumFactor(QuantumSoundState state) {
+    switch (state) {
+        case QuantumSoundState::COHERENT:
+            return std::complex<double>(1.0, 0.0);
+        case QuantumSoundState::SUPERPOSITION:
+            return std::complex<double>(0.707, 0.707);
+        case QuantumSoundState::ENTANGLED:
+            return std::complex<double>(0.5, 0.866);
+        case QuantumSoundState::COLLAPSED:
+            return std::complex<double>(0.0, 1.0);
+        default:
+            return std::complex<double>(1.0, 0.0);
+    }
+}
+
+constexpr double kSpeedOfSound = 343.0;     // m/s
+
+// Frequency ladders: bounded length keeps the rotation recurrence within a
+// few dozen ulp; the tolerance admits rounding in h·f harmonics. Batches
+// below kLadderMinPoints use the per-point kernel, which vectorizes across
+// sources instead.
+constexpr size_t kMaxLadderLength = 64;
+constexpr double kLadderTolerance = 1e-12;
+constexpr size_t kLadderMinPoints = 8;
+constexpr size_t kLadderBlock = 64;
+
+// Points per block of an asynchronous interference sweep: the unit of
+// progress and the granularity of cancellation
+constexpr size_t kAsyncSweepBlock = 16 * kLadderBlock;
+
+// Decoherence draws are keyed by (seed, tick, field index), so the outcome does
+// not depend on how fields are split across threads or ticks across updates
+constexpr size_t kDecoherenceBlock = 256;
+
+// Returns the number of fields that decohered
+size_t decohereRange(QuantumSoundState* states, size_t begin, size_t end,
+                     uint64_t seed, uint64_t first_tick, uint64_t ticks) {
+    double draws[kDecoherenceBlock];
+    size_t decayed = 0;
+    for (size_t block = begin; block < end; block += kDecoherenceBlock) {
+        size_t length = std::min(kDecoherenceBlock, end - block);
+        for (uint64_t tick = first_tick; tick < first_tick + ticks; ++tick) {
+            // Branch-free draw loop over the block, then a masked state update
+            for (size_t j = 0; j < length; ++j) {
+                draws[j] = QuantumNoiseSource::counterUniform(seed, tick, block + j);
+            }
+            size_t superposed = 0;
+            for (size_t j = 0; j < length; ++j) {
+                QuantumSoundState& state = states[block + j];
+                bool decays = state == QuantumSoundState::SUPERPOSITION &&
+                              draws[j] < AnantaSoundCore::kDecoherenceProbability;
+                state = decays ? QuantumSoundState::GROUND : state;
+                decayed += decays;
+                superposed += state == QuantumSoundState::SUPERPOSITION;
+            }
+            if (superposed == 0) {
+                break;      // Nothing left to decohere in this block
+            }
+        }
+    }
+    return decayed;
 }
 
-void InterferenceField::addSourceField(const QuantumSoundField& field) {
-    std::lock_guard<std::mutex> lock(field_mutex_);
-    source_fields_.push_back(field);
+// Factor a field type applies to the source sum; depends only on the query time
+template<InterferenceFieldType Type>
+std::complex<double> fieldTypeFactor(double time) {
+    if constexpr (Type == InterferenceFieldType::DESTRUCTIVE) {
+        return -1.0;
+    } else if constexpr (Type == InterferenceFieldType::PHASE_MODULATED) {
+        return std::exp(std::complex<double>(0.0, M_PI / 4.0));
+    } else if constexpr (Type == InterferenceFieldType::AMPLITUDE_MODULATED) {
+        return 1.0 + 0.5 * std::sin(2.0 * M_PI * 10.0 * time);
+    } else if constexpr (Type == InterferenceFieldType::QUANTUM_ENTANGLED) {
+        return std::complex<double>(std::cos(M_PI / 6.0), std::sin(M_PI / 6.0));
+    } else {
+        (void)time;
+        return 1.0;
+    }
 }
 
-std::complex<double> InterferenceField::calculateInterference(const SphericalCoord& position, double time) const {
-    std::lock_guard<std::mutex> lock(field_mutex_);
-    
-    if (source_fields_.empty()) {
-        return std::complex<double>(0.0, 0.0);
+std::complex<double> fieldTypeFactor(InterferenceFieldType type, double time) {
+    switch (type) {
+        case InterferenceFieldType::DESTRUCTIVE:
+            return fieldTypeFactor<InterferenceFieldType::DESTRUCTIVE>(time);
+        case InterferenceFieldType::PHASE_MODULATED:
+            return fieldTypeFactor<InterferenceFieldType::PHASE_MODULATED>(time);
+        case InterferenceFieldType::AMPLITUDE_MODULATED:
+            return fieldTypeFactor<InterferenceFieldType::AMPLITUDE_MODULATED>(time);
+        case InterferenceFieldType::QUANTUM_ENTANGLED:
+            return fieldTypeFactor<InterferenceFieldType::QUANTUM_ENTANGLED>(time);
+        default:
+            return fieldTypeFactor<InterferenceFieldType::CONSTRUCTIVE>(time);
     }
+}
+
+// Interference at each point for one field type. The type's factor is
+// computed once per batch, and the type test disappears from the point loop
+template<InterferenceFieldType Type>
+void evaluateInterference(const InterferenceKernelTable& kernels, const InterferenceSources& sources,
+                          const SphericalCoord* positions, size_t count, double time,
+                          std::complex<double>* output) {
+    [[maybe_unused]] const std::complex<double> factor = fieldTypeFactor<Type>(time);
     
-    std::complex<double> total_field(0.0, 0.0);
-    
-    for (const auto& field : source_fields_) {
-        // Calculate distance from source to position
-        double dx = position.r * sin(position.theta) * cos(position.phi) - 
-                   field.position.r * sin(field.position.theta) * cos(field.position.phi);
-        double dy = position.r * sin(position.theta) * sin(position.phi) - 
-                   field.position.r * sin(field.position.theta) * sin(field.position.phi);
-        double dz = position.height - field.position.height;
-        
-        double distance = std::sqrt(dx*dx + dy*dy + dz*dz);
-        
-        // Calculate phase delay
-        double phase_delay = 2.0 * M_PI * field.frequency * distance / 343.0; // 343 m/s is speed of sound
-        
-        // Apply quantum state effects
-        std::complex<double> quantum_factor(1.0, 0.0);
-        switch (field.quantum_state) {
-            case QuantumSoundState::COHERENT:
-                quantum_factor = std::complex<double>(1.0, 0.0);
-                break;
-            case QuantumSoundState::SUPERPOSITION:
-                quantum_factor = std::complex<double>(0.707, 0.707);
-                break;
-            case QuantumSoundState::ENTANGLED:
-                quantum_factor = std::complex<double>(0.5, 0.866);
-                break;
-            case QuantumSoundState::COLLAPSED:
-                quantum_factor = std::complex<double>(0.0, 1.0);
-                break;
-            default:
-                quantum_factor = std::complex<double>(1.0, 0.0);
-                break;
+    for (size_t i = 0; i < count; ++i) {
+        CartesianPosition point = CartesianPosition::fromSpherical(positions[i]);
+        std::complex<double> total = kernels.accumulate(sources, point.x, point.y, point.z);
+        if constexpr (Type == InterferenceFieldType::CONSTRUCTIVE) {
+            output[i] = total;
+        } else if constexpr (Type == InterferenceFieldType::DESTRUCTIVE) {
+            output[i] = -total;
+        } else if constexpr (Type == InterferenceFieldType::AMPLITUDE_MODULATED) {
+            output[i] = total * factor.real();
+        } else {
+            output[i] = total * factor;
         }
-        
-        // Calculate field contribution
-        std::complex<double> field_contribution = field.amplitude * quantum_factor * 
-            std::exp(std::complex<double>(0.0, -phase_delay));
-        
-        total_field += field_contribution;
     }
-    
-    // Apply interference type effects
-    switch (type_) {
-        case InterferenceFieldType::CONSTRUCTIVE:
-            return total_field;
+}
+
+using InterferenceEvaluator = void (*)(const InterferenceKernelTable&, const InterferenceSources&,
+                                       const SphericalCoord*, size_t, double, std::complex<double>*);
+
+InterferenceEvaluator selectInterferenceEvaluator(InterferenceFieldType type) {
+    switch (type) {
         case InterferenceFieldType::DESTRUCTIVE:
-            return -total_field;
+            return &evaluateInterference<InterferenceFieldType::DESTRUCTIVE>;
         case InterferenceFieldType::PHASE_MODULATED:
-            return total_field * std::exp(std::complex<double>(0.0, M_PI / 4.0));
+            return &evaluateInterference<InterferenceFieldType::PHASE_MODULATED>;
         case InterferenceFieldType::AMPLITUDE_MODULATED:
-            return total_field * (1.0 + 0.5 * std::sin(2.0 * M_PI * 10.0 * time));
+            return &evaluateInterference<InterferenceFieldType::AMPLITUDE_MODULATED>;
         case InterferenceFieldType::QUANTUM_ENTANGLED:
-            return total_field * std::complex<double>(std::cos(M_PI / 6.0), std::sin(M_PI / 6.0));
+            return &evaluateInterference<InterferenceFieldType::QUANTUM_ENTANGLED>;
         default:
-            return total_field;
+            return &evaluateInterference<InterferenceFieldType::CONSTRUCTIVE>;
+    }
+}
+
+// Snapshot versions let compute backends skip re-uploading unchanged sources
+uint64_t nextSnapshotVersion() {
+    static std::atomic<uint64_t> version{0};
+    return version.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // namespace
+
+InterferenceField::InterferenceField(InterferenceFieldType type, SphericalCoord center, double radius)
+    : type_(type), center_(center), field_radius_(radius)
+    , snapshot_pool_next_(0)
+    , snapshot_stale_(false)
+    , ladders_stale_(false)
+    , kernels_(&getInterferenceKernels())
+    , evaluate_(selectInterferenceEvaluator(type)) {
+    for (auto& snapshot : snapshot_pool_) {
+        snapshot = std::make_shared<SourceSnapshot>();
+    }
+    pending_.geometry_version = nextSnapshotVersion();
+    publishSnapshot();
+}
+
+std::shared_ptr<const InterferenceField::SourceSnapshot> InterferenceField::loadSnapshot() const {
+    if (snapshot_stale_.load(std::memory_order_acquire)) {
+        ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+        if (snapshot_stale_.load(std::memory_order_relaxed)) {
+            publishSnapshot();
+        }
+    }
+    return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+}
+
+void InterferenceField::publishSnapshot() const {
+    // Same pooling as AnantaSoundCore::publishSnapshot: a pooled snapshot no
+    // reader holds is overwritten in place, reusing its capacity
+    std::shared_ptr<SourceSnapshot> next;
+    for (auto& pooled : snapshot_pool_) {
+        if (pooled.use_count() == 1) {
+            next = pooled;
+            break;
+        }
+    }
+    if (!next) {
+        auto& slot = snapshot_pool_[snapshot_pool_next_];
+        snapshot_pool_next_ = (snapshot_pool_next_ + 1) % kSnapshotPoolSize;
+        slot = std::make_shared<SourceSnapshot>();
+        next = slot;
+    }
+    snapshot_stale_.store(false, std::memory_order_relaxed);
+    if (ladders_stale_) {
+        groupLadders();
+        ladders_stale_ = false;
+    }
+    *next = pending_;
+    next->version = nextSnapshotVersion();
+    std::atomic_store_explicit(&snapshot_, std::shared_ptr<const SourceSnapshot>(next), std::memory_order_release);
+}
+
+void InterferenceField::appendSource(const QuantumSoundField& field) {
+    CartesianPosition position = CartesianPosition::fromSpherical(field.position);
+    pending_.x.push_back(position.x);
+    pending_.y.push_back(position.y);
+    pending_.z.push_back(position.z);
+    pending_.wavenumber.push_back(2.0 * M_PI * field.frequency / kSpeedOfSound);
+    pending_.weight_real.push_back(0.0);
+    pending_.weight_imag.push_back(0.0);
+    cacheWeight(pending_.x.size() - 1);
+    insertLadderMember(pending_.x.size() - 1);
+}
+
+bool InterferenceField::eraseSource(SourceHandle source) {
+    size_t moved_from = 0;
+    size_t index = source_slots_.erase(source, moved_from);
+    if (index == SlotIndex::npos) {
+        return false;
+    }
+    entanglement_.removeNode(source.slot);
+    
+    // The last source takes over the erased index, also in its ladder group
+    eraseLadderMember(index);
+    if (moved_from != index) {
+        auto& members = ladder_groups_[ladderPosition(moved_from)];
+        for (auto& member : members) {
+            if (member.second == moved_from) {
+                member.second = static_cast<uint32_t>(index);
+                break;
+            }
+        }
+    }
+    
+    // Mirror the slot index swap-and-pop in the dense arrays
+    auto swapPop = [&](auto& values) {
+        values[index] = values[moved_from];
+        values.pop_back();
+    };
+    swapPop(source_fields_);
+    swapPop(pending_.x);
+    swapPop(pending_.y);
+    swapPop(pending_.z);
+    swapPop(pending_.wavenumber);
+    swapPop(pending_.weight_real);
+    swapPop(pending_.weight_imag);
+    return true;
+}
+
+InterferenceField::LadderPosition InterferenceField::ladderPosition(size_t index) const {
+    return {pending_.x[index], pending_.y[index], pending_.z[index]};
+}
+
+void InterferenceField::insertLadderMember(size_t index) {
+    // Equal wavenumbers keep insertion order; only the wavenumber order matters
+    auto& members = ladder_groups_[ladderPosition(index)];
+    double k = pending_.wavenumber[index];
+    auto at = std::upper_bound(members.begin(), members.end(), k,
+                               [](double value, const std::pair<double, uint32_t>& member) {
+                                   return value < member.first;
+                               });
+    members.insert(at, {k, static_cast<uint32_t>(index)});
+    ladders_stale_ = true;
+}
+
+void InterferenceField::eraseLadderMember(size_t index) {
+    auto group = ladder_groups_.find(ladderPosition(index));
+    auto& members = group->second;
+    members.erase(std::find_if(members.begin(), members.end(),
+                               [&](const std::pair<double, uint32_t>& member) { return member.second == index; }));
+    if (members.empty()) {
+        ladder_groups_.erase(group);
+    }
+    ladders_stale_ = true;
+}
+
+void InterferenceField::groupLadders() const {
+    SourceSnapshot& snapshot = pending_;
+    auto clear = [&] {
+        snapshot.ladder_x.clear();
+        snapshot.ladder_y.clear();
+        snapshot.ladder_z.clear();
+        snapshot.ladder_wavenumber.clear();
+        snapshot.ladder_step.clear();
+        snapshot.ladder_begin.clear();
+        snapshot.ladder_members.clear();
+    };
+    clear();
+    
+    size_t count = snapshot.x.size();
+    
+    // Mostly lone sources: the per-point kernel over all sources is faster.
+    // A position yields at least one ladder, so this check needs no split
+    if (4 * ladder_groups_.size() > 3 * count) {
+        return;
+    }
+    
+    snapshot.ladder_begin.push_back(0);
+    for (const auto& group : ladder_groups_) {
+        const auto& members = group.second;
+        size_t size = members.size();
+        size_t start = 0;
+        while (start < size) {
+            // Longest arithmetic run of wavenumbers at this position
+            double first = members[start].first;
+            size_t end = start + 1;
+            if (end < size) {
+                double step = members[end].first - first;
+                ++end;
+                while (end < size && end - start < kMaxLadderLength) {
+                    double k = members[end].first;
+                    double predicted = first + static_cast<double>(end - start) * step;
+                    if (std::abs(k - predicted) > kLadderTolerance * k) {
+                        break;
+                    }
+                    ++end;
+                }
+                snapshot.ladder_step.push_back((members[end - 1].first - first) / static_cast<double>(end - start - 1));
+            } else {
+                snapshot.ladder_step.push_back(0.0);
+            }
+            snapshot.ladder_x.push_back(group.first[0]);
+            snapshot.ladder_y.push_back(group.first[1]);
+            snapshot.ladder_z.push_back(group.first[2]);
+            snapshot.ladder_wavenumber.push_back(first);
+            for (size_t i = start; i < end; ++i) {
+                snapshot.ladder_members.push_back(members[i].second);
+            }
+            snapshot.ladder_begin.push_back(static_cast<uint32_t>(snapshot.ladder_members.size()));
+            start = end;
+        }
+    }
+    
+    if (4 * snapshot.ladder_x.size() > 3 * count) {
+        clear();
+    }
+}
+
+void InterferenceField::cacheWeight(size_t index) {
+    const QuantumSoundField& field = source_fields_[index];
+    std::complex<double> weight = field.amplitude * quantumFactor(field.quantum_state);
+    pending_.weight_real[index] = weight.real();
+    pending_.weight_imag[index] = weight.imag();
+}
+
+InterferenceField::SourceHandle InterferenceField::addSourceField(const QuantumSoundField& field) {
+    return addSourceFields({field}).front();
+}
+
+std::vector<InterferenceField::SourceHandle> InterferenceField::addSourceFields(const std::vector<QuantumSoundField>& fields) {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    
+    // Readers keep evaluating the published snapshot until the next publication
+    std::vector<SourceHandle> handles;
+    handles.reserve(fields.size());
+    for (const auto& field : fields) {
+        handles.push_back(source_slots_.insert());
+        source_fields_.push_back(field);
+        appendSource(field);
+    }
+    pending_.geometry_version = nextSnapshotVersion();
+    markSnapshotStale();
+    return handles;
+}
+
+bool InterferenceField::removeSourceField(SourceHandle source) {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    
+    if (!eraseSource(source)) {
+        return false;
+    }
+    pending_.entangled_pairs = entanglement_.edgeCount();
+    pending_.geometry_version = nextSnapshotVersion();
+    markSnapshotStale();
+    return true;
+}
+
+std::vector<InterferenceField::SourceHandle> InterferenceField::replaceSourceFields(
+    const std::vector<SourceHandle>& removed, const std::vector<QuantumSoundField>& fields) {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    
+    for (SourceHandle source : removed) {
+        eraseSource(source);
+    }
+    
+    std::vector<SourceHandle> handles;
+    handles.reserve(fields.size());
+    for (const auto& field : fields) {
+        handles.push_back(source_slots_.insert());
+        source_fields_.push_back(field);
+        appendSource(field);
+    }
+    pending_.entangled_pairs = entanglement_.edgeCount();
+    pending_.geometry_version = nextSnapshotVersion();
+    markSnapshotStale();
+    return handles;
+}
+
+bool InterferenceField::setSourceAmplitude(SourceHandle source, std::complex<double> amplitude) {
+    return setSourceAmplitudes(&source, &amplitude, 1);
+}
+
+bool InterferenceField::setSourceAmplitudes(const SourceHandle* sources, const std::complex<double>* amplitudes,
+                                            size_t count) {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    
+    for (size_t i = 0; i < count; ++i) {
+        if (!source_slots_.contains(sources[i])) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        size_t index = source_slots_.find(sources[i]);
+        source_fields_[index].amplitude = amplitudes[i];
+        cacheWeight(index);
+    }
+    markSnapshotStale();
+    return true;
+}
+
+size_t InterferenceField::getSourceCount() const {
+    return loadSnapshot()->x.size();
+}
+
+bool InterferenceField::containsSource(SourceHandle source) const {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    return source_slots_.contains(source);
+}
+
+InterferenceField::SourceHandle InterferenceField::getSourceHandle(size_t index) const {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    return index < source_slots_.size() ? source_slots_.handleAt(index) : SourceHandle{};
+}
+
+std::complex<double> InterferenceField::calculateInterference(const SphericalCoord& position, double time) const {
+    std::complex<double> result;
+    calculateInterference(&position, 1, time, &result);
+    return result;
+}
+
+void InterferenceField::calculateInterference(const SphericalCoord* positions, size_t count, double time,
+                                              std::complex<double>* output) const {
+    // The snapshot stays alive for the whole batch even if a writer publishes a new one
+    std::shared_ptr<const SourceSnapshot> snapshot = loadSnapshot();
+    evaluateSnapshot(*snapshot, positions, count, time, output);
+}
+
+AsyncResult<std::vector<std::complex<double>>> InterferenceField::calculateInterferenceAsync(
+    std::vector<SphericalCoord> positions, double time) const {
+    return calculateInterferenceAsync(std::move(positions), time, AsyncOptions());
+}
+
+AsyncResult<std::vector<std::complex<double>>> InterferenceField::calculateInterferenceAsync(
+    std::vector<SphericalCoord> positions, double time, const AsyncOptions& options) const {
+    ThreadPool* pool = options.pool ? options.pool : &ThreadPool::shared();
+    std::shared_ptr<const SourceSnapshot> snapshot = loadSnapshot();
+    return runAsync<std::vector<std::complex<double>>>(
+        [this, pool, snapshot, time, positions = std::move(positions)](AsyncControl& control) {
+            std::vector<std::complex<double>> output(positions.size());
+            size_t blocks = (positions.size() + kAsyncSweepBlock - 1) / kAsyncSweepBlock;
+            control.setTotal(blocks);
+            pool->parallelFor(blocks, 1, [&](size_t begin, size_t end, size_t) {
+                for (size_t block = begin; block < end; ++block) {
+                    control.throwIfCancelled();
+                    size_t first = block * kAsyncSweepBlock;
+                    size_t count = std::min(kAsyncSweepBlock, positions.size() - first);
+                    evaluateSnapshot(*snapshot, positions.data() + first, count, time, output.data() + first);
+                    control.advance();
+                }
+            });
+            return output;
+        }, options);
+}
+
+void InterferenceField::evaluateSnapshot(const SourceSnapshot& snapshot, const SphericalCoord* positions,
+                                         size_t count, double time, std::complex<double>* output) const {
+    if (snapshot.x.empty()) {
+        std::fill(output, output + count, std::complex<double>(0.0, 0.0));
+        return;
+    }
+    
+    InterferenceSources sources{snapshot.x.data(), snapshot.y.data(), snapshot.z.data(),
+                                snapshot.wavenumber.data(), snapshot.weight_real.data(),
+                                snapshot.weight_imag.data(), snapshot.x.size()};
+    
+    // Each source contributes amplitude * quantum_factor * exp(-i * 2π f d / c)
+    if (snapshot.ladder_x.empty() || count < kLadderMinPoints) {
+        evaluate_(*kernels_, sources, positions, count, time, output);
+        return;
+    }
+    
+    // Grouped sources: one phasor pair per ladder, vectorized across points
+    InterferenceLadders ladders{snapshot.ladder_x.data(), snapshot.ladder_y.data(), snapshot.ladder_z.data(),
+                                snapshot.ladder_wavenumber.data(), snapshot.ladder_step.data(),
+                                snapshot.ladder_begin.data(), snapshot.ladder_members.data(),
+                                snapshot.ladder_x.size()};
+    double px[kLadderBlock], py[kLadderBlock], pz[kLadderBlock];
+    for (size_t block = 0; block < count; block += kLadderBlock) {
+        size_t points = std::min(kLadderBlock, count - block);
+        for (size_t i = 0; i < points; ++i) {
+            CartesianPosition point = CartesianPosition::fromSpherical(positions[block + i]);
+            px[i] = point.x;
+            py[i] = point.y;
+            pz[i] = point.z;
+        }
+        kernels_->accumulateLadders(ladders, sources.weight_real, sources.weight_imag, px, py, pz, points,
+                                    output + block);
+    }
+    std::complex<double> factor = fieldTypeFactor(type_, time);
+    if (factor != std::complex<double>(1.0, 0.0)) {
+        for (size_t i = 0; i < count; ++i) {
+            output[i] *= factor;
+        }
+    }
+}
+
+std::vector<std::complex<double>> InterferenceField::calculateInterference(const std::vector<SphericalCoord>& positions,
+                                                                           double time) const {
+    std::vector<std::complex<double>> output(positions.size());
+    calculateInterference(positions.data(), positions.size(), time, output.data());
+    return output;
+}
+
+bool InterferenceField::calculateInterferenceMap(const InterferencePointGrid& grid, double time,
+                                                 std::complex<double>* output,
+                                                 InterferenceComputeBackend& backend) const {
+    std::shared_ptr<const SourceSnapshot> snapshot = loadSnapshot();
+    InterferenceSources sources{snapshot->x.data(), snapshot->y.data(), snapshot->z.data(),
+                                snapshot->wavenumber.data(), snapshot->weight_real.data(),
+                                snapshot->weight_imag.data(), snapshot->x.size()};
+    backend.ensureSources(snapshot->version, sources);
+    if (!backend.evaluate(grid, output)) {
+        return false;
+    }
+    
+    std::complex<double> factor = fieldTypeFactor(type_, time);
+    if (factor != std::complex<double>(1.0, 0.0)) {
+        for (size_t i = 0; i < grid.size(); ++i) {
+            output[i] *= factor;
+        }
+    }
+    return true;
+}
+
+void InterferenceField::bakeLayout(const InterferencePointGrid& grid, BakedInterferenceLayout& layout,
+                                   ThreadPool* pool) const {
+    std::shared_ptr<const SourceSnapshot> snapshot = loadSnapshot();
+    InterferenceSources sources{snapshot->x.data(), snapshot->y.data(), snapshot->z.data(),
+                                snapshot->wavenumber.data(), snapshot->weight_real.data(),
+                                snapshot->weight_imag.data(), snapshot->x.size()};
+    layout.bake(sources, snapshot->geometry_version, grid, pool);
+}
+
+bool InterferenceField::calculateBakedInterference(const BakedInterferenceLayout& layout, double time,
+                                                   std::complex<double>* output, ThreadPool* pool) const {
+    std::shared_ptr<const SourceSnapshot> snapshot = loadSnapshot();
+    if (layout.getGeometryVersion() != snapshot->geometry_version) {
+        return false;
+    }
+    
+    layout.evaluate(snapshot->weight_real.data(), snapshot->weight_imag.data(), output, *kernels_, pool);
+    std::complex<double> factor = fieldTypeFactor(type_, time);
+    if (factor != std::complex<double>(1.0, 0.0)) {
+        for (size_t i = 0; i < layout.getListenerCount(); ++i) {
+            output[i] *= factor;
+        }
+    }
+    return true;
+}
+
+void InterferenceField::calculateIncrementalInterference(IncrementalInterferenceMap& map, double time,
+                                                         std::complex<double>* output) const {
+    std::shared_ptr<const SourceSnapshot> snapshot = loadSnapshot();
+    InterferenceSources sources{snapshot->x.data(), snapshot->y.data(), snapshot->z.data(),
+                                snapshot->wavenumber.data(), snapshot->weight_real.data(),
+                                snapshot->weight_imag.data(), snapshot->x.size()};
+    map.update(snapshot->version, sources);
+    
+    std::complex<double> factor = fieldTypeFactor(type_, time);
+    const std::complex<double>* sums = map.getSums();
+    for (size_t i = 0; i < map.size(); ++i) {
+        output[i] = sums[i] * factor;
+    }
+}
+
+void InterferenceField::buildClusterTree(InterferenceClusterTree& tree) const {
+    std::shared_ptr<const SourceSnapshot> snapshot = loadSnapshot();
+    InterferenceSources sources{snapshot->x.data(), snapshot->y.data(), snapshot->z.data(),
+                                snapshot->wavenumber.data(), snapshot->weight_real.data(),
+                                snapshot->weight_imag.data(), snapshot->x.size()};
+    tree.build(snapshot->version, sources);
+}
+
+bool InterferenceField::calculateClusteredInterference(const InterferenceClusterTree& tree,
+                                                       const SphericalCoord* positions, size_t count,
+                                                       double time, std::complex<double>* output) const {
+    if (tree.getVersion() != loadSnapshot()->version) {
+        return false;
     }
+    
+    std::complex<double> factor = fieldTypeFactor(type_, time);
+    for (size_t i = 0; i < count; ++i) {
+        CartesianPosition point = CartesianPosition::fromSpherical(positions[i]);
+        output[i] = tree.evaluate(point.x, point.y, point.z) * factor;
+    }
+    return true;
 }
 
 QuantumSoundField InterferenceField::quantumSuperposition(const std::vector<QuantumSoundField>& fields) const {
@@ -117,15 +1013,18 @@ QuantumSoundField InterferenceField::quantumSuperposition(const std::vector<Quan
 }
 
 void InterferenceField::updateQuantumState(double dt) {
-    std::lock_guard<std::mutex> lock(field_mutex_);
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
     
-    for (auto& field : source_fields_) {
+    for (size_t i = 0; i < source_fields_.size(); ++i) {
+        QuantumSoundField& field = source_fields_[i];
         // Simple quantum state evolution
         switch (field.quantum_state) {
             case QuantumSoundState::EXCITED:
                 // Decay to ground state
                 if (dt > 0.1) {
                     field.quantum_state = QuantumSoundState::GROUND;
+                    cacheWeight(i);
+                    markSnapshotStale();
                 }
                 break;
             case QuantumSoundState::SUPERPOSITION:
@@ -138,83 +1037,525 @@ void InterferenceField::updateQuantumState(double dt) {
                 break;
         }
     }
+    
+    // The tick publishes everything written since the last publication at once
+    if (snapshot_stale_.load(std::memory_order_relaxed)) {
+        publishSnapshot();
+    }
+}
+
+void InterferenceField::createQuantumEntanglement(size_t field1_idx, size_t field2_idx) {
+    createQuantumEntanglement(getSourceHandle(field1_idx), getSourceHandle(field2_idx));
+}
+
+bool InterferenceField::createQuantumEntanglement(SourceHandle first, SourceHandle second) {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    
+    size_t first_index = source_slots_.find(first);
+    size_t second_index = source_slots_.find(second);
+    if (first_index == SlotIndex::npos || second_index == SlotIndex::npos ||
+        !entanglement_.addEdge(first.slot, second.slot)) {
+        return false;
+    }
+    source_fields_[first_index].quantum_state = QuantumSoundState::ENTANGLED;
+    source_fields_[second_index].quantum_state = QuantumSoundState::ENTANGLED;
+    
+    cacheWeight(first_index);
+    cacheWeight(second_index);
+    pending_.entangled_pairs = entanglement_.edgeCount();
+    markSnapshotStale();
+    return true;
+}
+
+bool InterferenceField::removeQuantumEntanglement(SourceHandle first, SourceHandle second) {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    
+    if (!source_slots_.contains(first) || !source_slots_.contains(second) ||
+        !entanglement_.removeEdge(first.slot, second.slot)) {
+        return false;
+    }
+    
+    // Sources keep their ENTANGLED state; only the pair count changes
+    pending_.entangled_pairs = entanglement_.edgeCount();
+    markSnapshotStale();
+    return true;
+}
+
+bool InterferenceField::areEntangled(SourceHandle first, SourceHandle second) const {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    return source_slots_.contains(first) && source_slots_.contains(second) &&
+           entanglement_.hasEdge(first.slot, second.slot);
+}
+
+std::vector<InterferenceField::SourceHandle> InterferenceField::getEntangledPartners(SourceHandle source) const {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    
+    std::vector<SourceHandle> partners;
+    if (!source_slots_.contains(source)) {
+        return partners;
+    }
+    // Partners are always live: removing a source drops its edges
+    for (uint32_t slot : entanglement_.partners(source.slot)) {
+        partners.push_back(source_slots_.handleForSlot(slot));
+    }
+    return partners;
+}
+
+bool InterferenceField::inSameEntanglementComponent(SourceHandle first, SourceHandle second) const {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    return source_slots_.contains(first) && source_slots_.contains(second) &&
+           entanglement_.connected(first.slot, second.slot);
+}
+
+std::vector<QuantumSoundField> InterferenceField::getSourceFields() const {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    return source_fields_;
+}
+
+std::vector<std::pair<size_t, size_t>> InterferenceField::getEntangledPairs() const {
+    ANANTASOUND_LOCK_GUARD(lock, field_mutex_, "InterferenceField::field_mutex_");
+    
+    std::vector<std::pair<size_t, size_t>> pairs;
+    pairs.reserve(entanglement_.edgeCount());
+    for (size_t index = 0; index < source_slots_.size(); ++index) {
+        for (uint32_t slot : entanglement_.partners(source_slots_.handleAt(index).slot)) {
+            size_t partner = source_slots_.find(source_slots_.handleForSlot(slot));
+            if (index < partner) {
+                pairs.emplace_back(index, partner);
+            }
+        }
+    }
+    return pairs;
+}
+
+size_t InterferenceField::getEntangledPairsCount() const {
+    return loadSnapshot()->entangled_pairs;
+}
+
+// DomeAcousticResonator implementation
+namespace {
+
+// Zeros j'_{n,m} of the Bessel function derivative J'_n (rigid side wall),
+// n = 0..7, m = 1..5
+constexpr int kBesselOrders = 8;
+constexpr int kBesselZerosPerOrder = 5;
+constexpr double kBesselDerivativeZeros[kBesselOrders][kBesselZerosPerOrder] = {
+    {3.8317, 7.0156, 10.1735, 13.3237, 16.4706},
+    {1.8412, 5.3314, 8.5363, 11.7060, 14.8636},
+    {3.0542, 6.7061, 9.9695, 13.1704, 16.3475},
+    {4.2012, 8.0152, 11.3459, 14.5858, 17.7887},
+    {5.3176, 9.2824, 12.6819, 15.9641, 19.1960},
+    {6.4156, 10.5199, 13.9872, 17.3128, 20.5755},
+    {7.5013, 11.7349, 15.2682, 18.6374, 21.9317},
+    {8.5778, 12.9324, 16.5294, 19.9419, 23.2681},
+};
+constexpr int kAxialOrders = 4;
+
+// Band grid: third-octave centers 1000 * 2^((band - 17) / 3)
+constexpr double kBandReference = 1000.0;
+constexpr double kBandsPerOctave = 3.0;
+constexpr double kReferenceBand = 17.0;
+
+// Absorption implied by the default reverb time formula
+constexpr double kDefaultAbsorption = 0.1;
+
+double modeFrequency(double radial_zero, int axial_order, double radius, double height) {
+    double radial = radial_zero / radius;
+    double axial = axial_order * M_PI / height;
+    return kSpeedOfSound / (2.0 * M_PI) * std::sqrt(radial * radial + axial * axial);
+}
+
+std::vector<ResonantMode> buildModalTable(double radius, double height) {
+    std::vector<ResonantMode> modes;
+    modes.reserve((kBesselOrders * kBesselZerosPerOrder + 1) * (kAxialOrders + 1));
+    
+    // Purely axial modes (no radial variation)
+    for (int q = 1; q <= kAxialOrders; ++q) {
+        modes.push_back({0, 0, q, modeFrequency(0.0, q, radius, height)});
+    }
+    for (int n = 0; n < kBesselOrders; ++n) {
+        for (int m = 0; m < kBesselZerosPerOrder; ++m) {
+            for (int q = 0; q <= kAxialOrders; ++q) {
+                modes.push_back({n, m + 1, q, modeFrequency(kBesselDerivativeZeros[n][m], q, radius, height)});
+            }
+        }
+    }
+    
+    std::sort(modes.begin(), modes.end(), [](const ResonantMode& a, const ResonantMode& b) {
+        return a.frequency < b.frequency;
+    });
+    return modes;
+}
+
+// Process-wide memo of modal tables keyed by the exact geometry. Tables are
+// immutable and shared; when the cache fills up it starts over rather than
+// tracking recency, which keeps lookups to one hash probe under the lock.
+class ModalTableCache {
+private:
+    struct GeometryKey {
+        double radius;
+        double height;
+        bool operator==(const GeometryKey& other) const {
+            return radius == other.radius && height == other.height;
+        }
+    };
+    struct GeometryHash {
+        size_t operator()(const GeometryKey& key) const {
+            size_t seed = std::hash<double>{}(key.radius);
+            return seed ^ (std::hash<double>{}(key.height) + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2));
+        }
+    };
+    static constexpr size_t kCapacity = 4096;
+
+    std::mutex mutex_;
+    std::unordered_map<GeometryKey, std::shared_ptr<const std::vector<ResonantMode>>, GeometryHash> tables_;
+
+public:
+    std::shared_ptr<const std::vector<ResonantMode>> get(double radius, double height) {
+        GeometryKey key{radius, height};
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = tables_.find(key);
+            if (it != tables_.end()) {
+                return it->second;
+            }
+        }
+        
+        // Build outside the lock; a concurrent miss on the same key is harmless
+        auto table = std::make_shared<const std::vector<ResonantMode>>(buildModalTable(radius, height));
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tables_.size() >= kCapacity) {
+            tables_.clear();
+        }
+        return tables_.emplace(key, std::move(table)).first->second;
+    }
+};
+
+ModalTableCache& modalTableCache() {
+    static ModalTableCache cache;
+    return cache;
+}
+
+// RMS distance in semitones from each target to its nearest mode
+double geometryError(const std::vector<ResonantMode>& modes, const std::vector<double>& targets) {
+    if (targets.empty()) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (double target : targets) {
+        auto upper = std::lower_bound(modes.begin(), modes.end(), target,
+                                      [](const ResonantMode& mode, double f) { return mode.frequency < f; });
+        double best = std::numeric_limits<double>::infinity();
+        if (upper != modes.end()) {
+            best = std::abs(std::log2(upper->frequency / target));
+        }
+        if (upper != modes.begin()) {
+            best = std::min(best, std::abs(std::log2(std::prev(upper)->frequency / target)));
+        }
+        double semitones = 12.0 * best;
+        sum += semitones * semitones;
+    }
+    return std::sqrt(sum / targets.size());
+}
+
+bool validGeometry(const DomeGeometry& geometry) {
+    return geometry.radius > 0.0 && geometry.height > 0.0 &&
+           std::isfinite(geometry.radius) && std::isfinite(geometry.height);
+}
+
+// Optimizer grid: kOptimizerSteps x kOptimizerSteps candidates per round,
+// each round zooming in around the best one
+constexpr size_t kOptimizerSteps = 17;
+constexpr int kOptimizerRounds = 4;
+constexpr double kOptimizerSpan = 2.0;          // First round covers 0.5x - 2x
+constexpr size_t kEvaluationGrain = 16;
+
+// RT60 multiplier of the material points at a frequency: linear in
+// log-frequency between points, constant beyond the outermost ones
+double materialFactor(const std::map<double, double>& properties, double frequency) {
+    if (properties.empty()) {
+        return 1.0;
+    }
+    auto upper = properties.lower_bound(frequency);
+    if (upper == properties.begin()) {
+        return upper->second;
+    }
+    if (upper == properties.end()) {
+        return std::prev(upper)->second;
+    }
+    auto lower = std::prev(upper);
+    if (lower->first <= 0.0) {
+        return upper->second;
+    }
+    double t = std::log(frequency / lower->first) / std::log(upper->first / lower->first);
+    return lower->second + t * (upper->second - lower->second);
+}
+
+} // namespace
+
+DomeAcousticResonator::DomeAcousticResonator(double radius, double height)
+    : dome_radius_(radius), dome_height_(height) {
+    setGeometry(radius, height);
+}
+
+std::shared_ptr<const std::vector<ResonantMode>> DomeAcousticResonator::modalTable(double radius, double height) {
+    return modalTableCache().get(radius, height);
+}
+
+void DomeAcousticResonator::setGeometry(double radius, double height) {
+    dome_radius_ = radius;
+    dome_height_ = height;
+    modes_ = modalTable(radius, height);
+    buildBandTables();
+    // Calculate fundamental resonant frequencies
+    resonant_frequencies_ = calculateEigenFrequencies();
+}
+
+void DomeAcousticResonator::buildBandTables() {
+    base_reverb_time_ = 0.161 * dome_radius_ * dome_height_ / (0.1 * dome_radius_ + 0.1 * dome_height_);
+    
+    for (size_t band = 0; band < kBandCount; ++band) {
+        double factor = materialFactor(acoustic_properties_, bandCenterFrequency(band));
+        band_reverb_time_[band] = base_reverb_time_ * factor;
+        band_absorption_[band] = factor > 0.0 ? std::min(1.0, kDefaultAbsorption / factor) : 1.0;
+    }
+}
+
+double DomeAcousticResonator::bandCenterFrequency(size_t band) {
+    return kBandReference * std::exp2((static_cast<double>(band) - kReferenceBand) / kBandsPerOctave);
+}
+
+double DomeAcousticResonator::interpolateBands(const double* bands, double frequency) const {
+    // Fractional band position, clamped to the grid
+    double position = frequency > 0.0
+        ? kReferenceBand + kBandsPerOctave * std::log2(frequency / kBandReference)
+        : 0.0;
+    position = std::clamp(position, 0.0, static_cast<double>(kBandCount - 1));
+    
+    size_t band = std::min(static_cast<size_t>(position), kBandCount - 2);
+    double t = position - static_cast<double>(band);
+    return bands[band] + t * (bands[band + 1] - bands[band]);
+}
+
+std::vector<double> DomeAcousticResonator::calculateEigenFrequencies() const {
+    std::vector<double> frequencies;
+    frequencies.reserve(modes_->size());
+    for (const auto& mode : *modes_) {
+        frequencies.push_back(mode.frequency);
+    }
+    return frequencies;
+}
+
+void DomeAcousticResonator::setMaterialProperties(const std::map<double, double>& properties) {
+    acoustic_properties_ = properties;
+    buildBandTables();
+}
+
+double DomeAcousticResonator::calculateReverbTime(double frequency) const {
+    return interpolateBands(band_reverb_time_, frequency);
+}
+
+double DomeAcousticResonator::getAbsorption(double frequency) const {
+    return interpolateBands(band_absorption_, frequency);
+}
+
+std::vector<DomeGeometryScore> DomeAcousticResonator::evaluateGeometries(const std::vector<DomeGeometry>& candidates,
+                                                                        const std::vector<double>& target_frequencies) {
+    return evaluateGeometries(candidates, target_frequencies, ThreadPool::shared());
+}
+
+std::vector<DomeGeometryScore> DomeAcousticResonator::evaluateGeometries(const std::vector<DomeGeometry>& candidates,
+                                                                        const std::vector<double>& target_frequencies,
+                                                                        ThreadPool& pool) {
+    std::vector<DomeGeometryScore> scores(candidates.size());
+    scoreGeometries(candidates, target_frequencies, pool, nullptr, scores.data());
+    return scores;
+}
+
+void DomeAcousticResonator::scoreGeometries(const std::vector<DomeGeometry>& candidates,
+                                            const std::vector<double>& target_frequencies, ThreadPool& pool,
+                                            AsyncControl* control, DomeGeometryScore* scores) {
+    pool.parallelFor(candidates.size(), kEvaluationGrain, [&](size_t begin, size_t end, size_t) {
+        if (control) {
+            control->throwIfCancelled();
+        }
+        for (size_t i = begin; i < end; ++i) {
+            const DomeGeometry& geometry = candidates[i];
+            double error = std::numeric_limits<double>::infinity();
+            if (validGeometry(geometry)) {
+                error = geometryError(*modalTable(geometry.radius, geometry.height), target_frequencies);
+            }
+            scores[i] = {geometry, error};
+        }
+        if (control) {
+            control->advance(end - begin);
+        }
+    });
+}
+
+DomeGeometryScore DomeAcousticResonator::optimizeFrequencyResponse(const std::vector<double>& target_frequencies) {
+    return optimizeFrequencyResponse(target_frequencies, ThreadPool::shared());
 }
 
-void InterferenceField::createQuantumEntanglement(size_t field1_idx, size_t field2_idx) {
-    std::lock_guard<std::mutex> lock(field_mutex_);
-    
-    if (field1_idx < source_fields_.size() && field2_idx < source_fields_.size()) {
-        source_fields_[field1_idx].quantum_state = QuantumSoundState::ENTANGLED;
-        source_fields_[field2_idx].quantum_state = QuantumSoundState::ENTANGLED;
-        entangled_pairs_.emplace_back(field1_idx, field2_idx);
+DomeGeometryScore DomeAcousticResonator::optimizeFrequencyResponse(const std::vector<double>& target_frequencies,
+                                                                   ThreadPool& pool) {
+    DomeGeometryScore best = searchGeometry(target_frequencies, pool, nullptr);
+    if (!target_frequencies.empty() && validGeometry(best.geometry)) {
+        setGeometry(best.geometry.radius, best.geometry.height);
     }
+    return best;
 }
 
-size_t InterferenceField::getEntangledPairsCount() const {
-    std::lock_guard<std::mutex> lock(field_mutex_);
-    return entangled_pairs_.size();
+AsyncResult<DomeGeometryScore> DomeAcousticResonator::optimizeFrequencyResponseAsync(
+    std::vector<double> target_frequencies) const {
+    return optimizeFrequencyResponseAsync(std::move(target_frequencies), AsyncOptions());
 }
 
-// DomeAcousticResonator implementation
-DomeAcousticResonator::DomeAcousticResonator(double radius, double height)
-    : dome_radius_(radius), dome_height_(height) {
-    // Calculate fundamental resonant frequencies
-    resonant_frequencies_ = calculateEigenFrequencies();
+AsyncResult<DomeGeometryScore> DomeAcousticResonator::optimizeFrequencyResponseAsync(
+    std::vector<double> target_frequencies, const AsyncOptions& options) const {
+    ThreadPool* pool = options.pool ? options.pool : &ThreadPool::shared();
+    return runAsync<DomeGeometryScore>(
+        [this, pool, targets = std::move(target_frequencies)](AsyncControl& control) {
+            return searchGeometry(targets, *pool, &control);
+        }, options);
 }
 
-std::vector<double> DomeAcousticResonator::calculateEigenFrequencies() const {
-    std::vector<double> frequencies;
-    
-    // Fundamental frequency (0,1) mode
-    double f01 = 343.0 / (2.0 * M_PI) * std::sqrt(std::pow(1.84 / dome_radius_, 2) + 
-                                                   std::pow(M_PI / dome_height_, 2));
-    frequencies.push_back(f01);
+DomeGeometryScore DomeAcousticResonator::searchGeometry(const std::vector<double>& target_frequencies,
+                                                        ThreadPool& pool, AsyncControl* control) const {
+    DomeGeometryScore best{{dome_radius_, dome_height_},
+                           geometryError(*modes_, target_frequencies)};
+    if (target_frequencies.empty() || !validGeometry(best.geometry)) {
+        return best;
+    }
     
-    // Higher order modes
-    for (int n = 1; n <= 5; ++n) {
-        for (int m = 0; m <= 3; ++m) {
-            double jnm = 0.0;
-            if (n == 1 && m == 0) jnm = 3.83;
-            else if (n == 2 && m == 0) jnm = 7.02;
-            else if (n == 0 && m == 1) jnm = 1.84;
-            else if (n == 1 && m == 1) jnm = 5.33;
-            else continue;
-            
-            double freq = 343.0 / (2.0 * M_PI) * std::sqrt(std::pow(jnm / dome_radius_, 2) + 
-                                                           std::pow(m * M_PI / dome_height_, 2));
-            frequencies.push_back(freq);
+    // Search log-spaced scale factors; each round shrinks the span around the best point
+    std::vector<DomeGeometry> candidates;
+    std::vector<DomeGeometryScore> scores(kOptimizerSteps * kOptimizerSteps);
+    candidates.reserve(kOptimizerSteps * kOptimizerSteps);
+    if (control) {
+        control->setTotal(kOptimizerRounds * kOptimizerSteps * kOptimizerSteps);
+    }
+    DomeGeometry center = best.geometry;
+    double log_span = std::log(kOptimizerSpan);
+    for (int round = 0; round < kOptimizerRounds; ++round) {
+        candidates.clear();
+        for (size_t i = 0; i < kOptimizerSteps; ++i) {
+            double radius_scale = std::exp(log_span * (2.0 * i / (kOptimizerSteps - 1) - 1.0));
+            for (size_t j = 0; j < kOptimizerSteps; ++j) {
+                double height_scale = std::exp(log_span * (2.0 * j / (kOptimizerSteps - 1) - 1.0));
+                candidates.push_back({center.radius * radius_scale, center.height * height_scale});
+            }
+        }
+        
+        scoreGeometries(candidates, target_frequencies, pool, control, scores.data());
+        for (const auto& score : scores) {
+            if (score.error < best.error) {
+                best = score;
+            }
         }
+        center = best.geometry;
+        log_span *= 2.0 / (kOptimizerSteps - 1);
     }
-    
-    std::sort(frequencies.begin(), frequencies.end());
-    return frequencies;
+    return best;
 }
 
-void DomeAcousticResonator::setMaterialProperties(const std::map<double, double>& properties) {
-    acoustic_properties_ = properties;
-}
+// AnantaSoundCore implementation
+struct AnantaSoundCore::Snapshot {
+    FieldBuffer fields;
+    SystemStatistics statistics{};
+};
 
-double DomeAcousticResonator::calculateReverbTime(double frequency) const {
-    // Default reverb time calculation
-    double rt60 = 0.161 * dome_radius_ * dome_height_ / (0.1 * dome_radius_ + 0.1 * dome_height_);
+AnantaSoundCore::AnantaSoundCore(double radius, double height)
+    : snapshot_(std::make_shared<Snapshot>())
+    , snapshot_pool_next_(0)
+    , snapshot_stale_(false)
+    , dome_radius_(radius)
+    , dome_height_(height)
+    , quantum_uncertainty_(0.1)
+    , is_initialized_(false)
+    , noise_seed_(std::random_device{}())
+    , decoherence_time_ns_(0)
+    , decoherence_tick_(0)
+    , phase_sync_(0.0)
+    , recorder_(nullptr)
+    , shared_output_(nullptr) {
     
-    // Adjust based on material properties if available
-    auto it = acoustic_properties_.find(frequency);
-    if (it != acoustic_properties_.end()) {
-        rt60 *= it->second;
+    noise_.seed(noise_seed_);
+    for (auto& snapshot : snapshot_pool_) {
+        snapshot = std::make_shared<Snapshot>();
     }
     
-    return rt60;
+    dome_resonator_ = std::make_unique<DomeAcousticResonator>(radius, height);
 }
 
-// AnantaSoundCore implementation
-AnantaSoundCore::AnantaSoundCore(double radius, double height)
-    : dome_radius_(radius)
-    , dome_height_(height)
-    , quantum_uncertainty_(0.1)
-    , is_initialized_(false) {
+std::shared_ptr<const AnantaSoundCore::Snapshot> AnantaSoundCore::loadSnapshot() const {
+    return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+}
+
+std::shared_ptr<const AnantaSoundCore::Snapshot> AnantaSoundCore::readSnapshot() const {
+    if (snapshot_stale_.load(std::memory_order_acquire)) {
+        ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+        if (snapshot_stale_.load(std::memory_order_relaxed)) {
+            publishSnapshot();
+        }
+    }
+    return loadSnapshot();
+}
+
+void AnantaSoundCore::publishSnapshot() const {
+    // A pooled snapshot nobody holds any more is refilled in place; its
+    // buffers keep their capacity, so a steady-state publication does not
+    // allocate. The published snapshot itself is never free
+    std::shared_ptr<Snapshot> next;
+    for (auto& pooled : snapshot_pool_) {
+        if (pooled.use_count() == 1) {
+            next = pooled;
+            break;
+        }
+    }
+    if (!next) {
+        // Every pooled snapshot is still held by readers: replace one
+        auto& slot = snapshot_pool_[snapshot_pool_next_];
+        snapshot_pool_next_ = (snapshot_pool_next_ + 1) % kSnapshotPoolSize;
+        slot = std::make_shared<Snapshot>();
+        next = slot;
+    }
+    snapshot_stale_.store(false, std::memory_order_relaxed);
+    next->fields = sound_fields_.fields();
     
-    dome_resonator_ = std::make_unique<DomeAcousticResonator>(radius, height);
+    SystemStatistics& stats = next->statistics;
+    stats.active_fields = sound_fields_.size();
+    
+    // Count entangled pairs from interference fields
+    stats.entangled_pairs = 0;
+    for (const auto& field : interference_fields_) {
+        if (field) {
+            stats.entangled_pairs += field->getEntangledPairsCount();
+        }
+    }
+    
+    // Calculate coherence ratio based on quantum states
+    stats.coherence_ratio = calculateCoherenceRatio();
+    
+    // Calculate energy efficiency based on field amplitudes
+    stats.energy_efficiency = calculateEnergyEfficiency();
+    
+    // Phase order parameter from the incrementally maintained sums
+    stats.phase_coherence = 0.0;
+    if (!sound_fields_.empty()) {
+        double sin_sum, cos_sum;
+        sound_fields_.fields().phaseSums(sin_sum, cos_sum);
+        stats.phase_coherence = std::hypot(sin_sum, cos_sum) / sound_fields_.size();
+    }
+    
+    // Check QRD connection status
+    stats.qrd_connected = checkQRDConnection();
+    
+    // Count active mechanical devices
+    stats.mechanical_devices_active = countActiveMechanicalDevices();
+    
+    std::atomic_store_explicit(&snapshot_, std::shared_ptr<const Snapshot>(std::move(next)),
+                               std::memory_order_release);
 }
 
 AnantaSoundCore::~AnantaSoundCore() {
@@ -252,21 +1593,26 @@ void AnantaSoundCore::shutdown() {
     
     // Clear all fields
     {
-        std::lock_guard<std::mutex> lock(core_mutex_);
+        ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
         interference_fields_.clear();
+        interference_slots_.clear();
         sound_fields_.clear();
+        publishSnapshot();
     }
     
     is_initialized_ = false;
 }
 
-void AnantaSoundCore::addInterferenceField(std::unique_ptr<InterferenceField> field) {
+AnantaSoundCore::InterferenceFieldHandle AnantaSoundCore::addInterferenceField(std::unique_ptr<InterferenceField> field) {
     if (!is_initialized_) {
-        return;
+        return {};
     }
     
-    std::lock_guard<std::mutex> lock(core_mutex_);
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    InterferenceFieldHandle handle = interference_slots_.insert();
     interference_fields_.push_back(std::move(field));
+    markSnapshotStale();
+    return handle;
 }
 
 void AnantaSoundCore::removeInterferenceField(size_t field_index) {
@@ -274,10 +1620,49 @@ void AnantaSoundCore::removeInterferenceField(size_t field_index) {
         return;
     }
     
-    std::lock_guard<std::mutex> lock(core_mutex_);
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
     if (field_index < interference_fields_.size()) {
-        interference_fields_.erase(interference_fields_.begin() + field_index);
+        eraseInterferenceField(interference_slots_.handleAt(field_index));
+    }
+}
+
+bool AnantaSoundCore::removeInterferenceField(InterferenceFieldHandle handle) {
+    if (!is_initialized_) {
+        return false;
+    }
+    
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    return eraseInterferenceField(handle);
+}
+
+bool AnantaSoundCore::eraseInterferenceField(InterferenceFieldHandle handle) {
+    size_t moved_from = 0;
+    size_t index = interference_slots_.erase(handle, moved_from);
+    if (index == SlotIndex::npos) {
+        return false;
     }
+    
+    // Swap-and-pop, mirroring the slot index
+    interference_fields_[index] = std::move(interference_fields_[moved_from]);
+    interference_fields_.pop_back();
+    markSnapshotStale();
+    return true;
+}
+
+InterferenceField* AnantaSoundCore::getInterferenceField(InterferenceFieldHandle handle) const {
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    size_t index = interference_slots_.find(handle);
+    return index == SlotIndex::npos ? nullptr : interference_fields_[index].get();
+}
+
+size_t AnantaSoundCore::getInterferenceFieldCount() const {
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    return interference_fields_.size();
+}
+
+AnantaSoundCore::InterferenceFieldHandle AnantaSoundCore::getInterferenceFieldHandle(size_t index) const {
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    return index < interference_slots_.size() ? interference_slots_.handleAt(index) : InterferenceFieldHandle{};
 }
 
 QuantumSoundField AnantaSoundCore::createQuantumSoundField(double frequency, 
@@ -289,7 +1674,7 @@ QuantumSoundField AnantaSoundCore::createQuantumSoundField(double frequency,
     field.phase = 0.0;
     field.quantum_state = state;
     field.position = position;
-    field.timestamp = std::chrono::high_resolution_clock::now();
+    field.timestamp = clock_.now();
     
     return field;
 }
@@ -299,21 +1684,121 @@ void AnantaSoundCore::processSoundField(const QuantumSoundField& input_field) {
         return;
     }
     
-    std::lock_guard<std::mutex> lock(core_mutex_);
+    ANANTASOUND_STAGE_TIMER("core.process_fields");
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    if (recorder_) {
+        recorder_->recordField(input_field);
+    }
+    storeSoundField(input_field);
+    markSnapshotStale();
+}
+
+void AnantaSoundCore::processSoundFields(const std::vector<QuantumSoundField>& input_fields) {
+    if (!is_initialized_) {
+        return;
+    }
+    
+    ANANTASOUND_STAGE_TIMER("core.process_fields");
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    if (recorder_) {
+        recorder_->recordFields(input_fields);
+    }
+    for (const auto& input_field : input_fields) {
+        storeSoundField(input_field);
+    }
+    markSnapshotStale();
+}
+
+void AnantaSoundCore::restoreSoundFields(const std::vector<QuantumSoundField>& fields) {
+    if (!is_initialized_) {
+        return;
+    }
     
-    // Store the field
-    sound_fields_[input_field.position] = input_field;
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    if (recorder_) {
+        recorder_->recordRestore(fields);
+    }
+    sound_fields_.clear();
+    for (const auto& field : fields) {
+        sound_fields_.insertOrAssign(field);
+    }
+    markSnapshotStale();
+}
+
+void AnantaSoundCore::storeSoundField(const QuantumSoundField& input_field) {
+    // Store the field (single lookup; replaces a field at the same position)
+    size_t index = sound_fields_.insertOrAssign(input_field);
     
     // Apply quantum uncertainty
     if (quantum_uncertainty_ > 0.0) {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::normal_distribution<double> dist(0.0, quantum_uncertainty_);
-        
         // Add quantum noise to amplitude
-        double noise = dist(gen);
-        sound_fields_[input_field.position].amplitude += std::complex<double>(noise, noise);
+        double noise = quantum_uncertainty_ * noise_.gaussian();
+        FieldBuffer& fields = sound_fields_.fields();
+        fields.setAmplitude(index, std::complex<double>(fields.amplitudeReal()[index] + noise,
+                                                        fields.amplitudeImag()[index] + noise));
+    }
+}
+
+void AnantaSoundCore::setNoiseSeed(uint64_t seed) {
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    if (recorder_) {
+        recorder_->recordNoiseSeed(seed);
+    }
+    noise_seed_ = seed;
+    noise_.seed(seed);
+}
+
+AnantaSoundCore::RunState AnantaSoundCore::getRunState() const {
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    return {noise_seed_, decoherence_time_ns_, decoherence_tick_, clock_.current().sample,
+            phase_sync_.getCoupling()};
+}
+
+void AnantaSoundCore::setRunState(const RunState& state) {
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    noise_seed_ = state.noise_seed;
+    noise_.seed(state.noise_seed);
+    decoherence_time_ns_ = state.decoherence_time_ns;
+    decoherence_tick_ = state.decoherence_tick;
+    uint64_t sample = clock_.current().sample;
+    if (state.clock_sample > sample) {
+        clock_.advance(state.clock_sample - sample);
+    }
+    phase_sync_.setCoupling(std::max(state.phase_coupling, 0.0));
+}
+
+void AnantaSoundCore::attachRecorder(SessionRecorder* recorder) {
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    recorder_ = recorder;
+    if (recorder_) {
+        noise_.seed(noise_seed_);
+        recorder_->beginSession({noise_seed_, decoherence_time_ns_, decoherence_tick_, clock_.current().sample,
+                                 phase_sync_.getCoupling()});
+    }
+}
+
+void AnantaSoundCore::attachSharedOutput(SharedFieldOutput* output) {
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    shared_output_ = output;
+    if (shared_output_) {
+        if (snapshot_stale_.load(std::memory_order_relaxed)) {
+            publishSnapshot();
+        }
+        shared_output_->publish(sound_fields_.fields(), loadSnapshot()->statistics, clock_.current());
+    }
+}
+
+void AnantaSoundCore::setPhaseCoupling(double coupling) {
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    if (recorder_) {
+        recorder_->recordPhaseCoupling(coupling);
     }
+    phase_sync_.setCoupling(std::max(coupling, 0.0));
+}
+
+double AnantaSoundCore::getPhaseCoupling() const {
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    return phase_sync_.getCoupling();
 }
 
 std::vector<QuantumSoundField> AnantaSoundCore::getOutputFields() const {
@@ -321,48 +1806,117 @@ std::vector<QuantumSoundField> AnantaSoundCore::getOutputFields() const {
         return {};
     }
     
-    std::lock_guard<std::mutex> lock(core_mutex_);
-    
-    std::vector<QuantumSoundField> output_fields;
-    output_fields.reserve(sound_fields_.size());
+    return readSnapshot()->fields.toFields();
+}
+
+void AnantaSoundCore::getOutputFields(std::vector<QuantumSoundField>& output) const {
+    if (!is_initialized_) {
+        output.clear();
+        return;
+    }
     
-    for (const auto& [pos, field] : sound_fields_) {
-        output_fields.push_back(field);
+    readSnapshot()->fields.toFields(output);
+}
+
+FieldVector AnantaSoundCore::getOutputFields(FieldArena& arena) const {
+    FieldVector output(&arena);
+    if (is_initialized_) {
+        readSnapshot()->fields.toFields(output);
+    }
+    return output;
+}
+
+std::vector<QuantumSoundField> AnantaSoundCore::getFieldsInRadius(const SphericalCoord& center, double radius) const {
+    if (!is_initialized_) {
+        return {};
     }
     
-    return output_fields;
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    
+    std::vector<size_t> indices;
+    sound_fields_.queryRadius(center, radius, indices);
+    
+    std::vector<QuantumSoundField> nearby_fields;
+    nearby_fields.reserve(indices.size());
+    for (size_t index : indices) {
+        nearby_fields.push_back(sound_fields_.get(index));
+    }
+    return nearby_fields;
 }
 
 void AnantaSoundCore::update(double dt) {
+    updateLocked(dt, nullptr);
+}
+
+void AnantaSoundCore::update(double dt, ThreadPool& pool) {
+    updateLocked(dt, &pool);
+}
+
+void AnantaSoundCore::updateLocked(double dt, ThreadPool* pool) {
     if (!is_initialized_) {
         return;
     }
     
-    // Update interference fields
-    for (auto& field : interference_fields_) {
-        if (field) {
-            field->updateQuantumState(dt);
+    ANANTASOUND_STAGE_TIMER("core.update");
+    ANANTASOUND_STAGE_METRIC("core.update", kDecoherenceTickNs);
+    ANANTASOUND_COUNT("ticks", "core", 1);
+    ANANTASOUND_LOCK_GUARD(lock, core_mutex_, "AnantaSoundCore::core_mutex_");
+    if (recorder_) {
+        recorder_->recordUpdate(dt, pool != nullptr);
+    }
+    clock_.advanceSeconds(dt);
+    
+    // Update interference fields (each one guards its own sources)
+    auto update_fields = [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) {
+            if (interference_fields_[i]) {
+                interference_fields_[i]->updateQuantumState(dt);
+            }
         }
+    };
+    if (pool) {
+        pool->parallelFor(interference_fields_.size(), 1, update_fields);
+    } else {
+        update_fields(0, interference_fields_.size(), 0);
     }
     
-    // Update quantum effects
-    static double time_accumulator = 0.0;
-    time_accumulator += dt;
+    // Update quantum effects: every elapsed tick, including catch-up ticks of a long dt
+    decoherence_time_ns_ += static_cast<int64_t>(std::llround(std::max(dt, 0.0) * 1e9));
+    uint64_t ticks = static_cast<uint64_t>(decoherence_time_ns_ / kDecoherenceTickNs);
+    decoherence_time_ns_ %= kDecoherenceTickNs;
     
-    if (time_accumulator >= 0.016) { // ~60 FPS
-        // Simulate quantum decoherence
-        for (auto& [pos, field] : sound_fields_) {
-            if (field.quantum_state == QuantumSoundState::SUPERPOSITION) {
-                static std::random_device rd;
-                static std::mt19937 gen(rd());
-                static std::uniform_real_distribution<double> dist(0.0, 1.0);
-                
-                if (dist(gen) < 0.05) { // 5% chance of decoherence
-                    field.quantum_state = QuantumSoundState::GROUND;
-                }
-            }
+    if (ticks > 0) {
+        QuantumSoundState* states = sound_fields_.fields().states();
+        size_t count = sound_fields_.size();
+        uint64_t first_tick = decoherence_tick_;
+        std::atomic<size_t> decayed{0};
+        auto decohere = [&](size_t begin, size_t end, size_t) {
+            decayed += decohereRange(states, begin, end, noise_seed_, first_tick, ticks);
+        };
+        if (pool && count > kDecoherenceBlock) {
+            size_t grain = std::max(kDecoherenceBlock, count / (pool->getConcurrency() * 4));
+            pool->parallelFor(count, grain, decohere);
+        } else {
+            decohere(0, count, 0);
         }
-        time_accumulator = 0.0;
+        sound_fields_.fields().recordStateTransitions(QuantumSoundState::SUPERPOSITION,
+                                                      QuantumSoundState::GROUND, decayed.load());
+        decoherence_tick_ += ticks;
+    }
+    
+    // Pull phases toward their circular mean, in place
+    if (phase_sync_.getCoupling() > 0.0 && !sound_fields_.empty()) {
+        FieldBuffer& fields = sound_fields_.fields();
+        double sin_sum, cos_sum;
+        fields.phaseSums(sin_sum, cos_sum);
+        std::complex<double> order_sum = phase_sync_.step(fields.phases(), fields.size(),
+                                                          std::complex<double>(cos_sum, sin_sum), dt);
+        fields.recordPhaseSums(order_sum.imag(), order_sum.real());
+    }
+    
+    publishSnapshot();
+    if (shared_output_) {
+        shared_output_->publish(sound_fields_.fields(), loadSnapshot()->statistics, clock_.current());
     }
 }
 
@@ -373,31 +1927,7 @@ AnantaSoundCore::SystemStatistics AnantaSoundCore::getStatistics() const {
         return stats;
     }
     
-    std::lock_guard<std::mutex> lock(core_mutex_);
-    
-    stats.active_fields = sound_fields_.size();
-    
-    // Count entangled pairs from interference fields
-    stats.entangled_pairs = 0;
-    for (const auto& field : interference_fields_) {
-        if (field) {
-            stats.entangled_pairs += field->getEntangledPairsCount();
-        }
-    }
-    
-    // Calculate coherence ratio based on quantum states
-    stats.coherence_ratio = calculateCoherenceRatio();
-    
-    // Calculate energy efficiency based on field amplitudes
-    stats.energy_efficiency = calculateEnergyEfficiency();
-    
-    // Check QRD connection status
-    stats.qrd_connected = checkQRDConnection();
-    
-    // Count active mechanical devices
-    stats.mechanical_devices_active = countActiveMechanicalDevices();
-    
-    return stats;
+    return readSnapshot()->statistics;
 }
 
 // Helper methods implementation
@@ -406,16 +1936,10 @@ double AnantaSoundCore::calculateCoherenceRatio() const {
         return 0.0;
     }
     
-    size_t coherent_fields = 0;
+    size_t coherent_fields = sound_fields_.fields().countStates(
+        {QuantumSoundState::COHERENT, QuantumSoundState::SUPERPOSITION});
     size_t total_fields = sound_fields_.size();
     
-    for (const auto& [pos, field] : sound_fields_) {
-        if (field.quantum_state == QuantumSoundState::COHERENT || 
-            field.quantum_state == QuantumSoundState::SUPERPOSITION) {
-            coherent_fields++;
-        }
-    }
-    
     return static_cast<double>(coherent_fields) / static_cast<double>(total_fields);
 }
 
@@ -424,14 +1948,8 @@ double AnantaSoundCore::calculateEnergyEfficiency() const {
         return 1.0;
     }
     
-    double total_energy = 0.0;
-    double max_possible_energy = 0.0;
-    
-    for (const auto& [pos, field] : sound_fields_) {
-        double field_energy = std::abs(field.amplitude);
-        total_energy += field_energy;
-        max_possible_energy += 1.0; // Assuming max amplitude is 1.0
-    }
+    double total_energy = sound_fields_.fields().amplitudeMagnitudeSum();
+    double max_possible_energy = static_cast<double>(sound_fields_.size()); // Assuming max amplitude is 1.0
     
     if (max_possible_energy == 0.0) {
         return 1.0;
@@ -449,71 +1967,313 @@ bool AnantaSoundCore::checkQRDConnection() const {
 size_t AnantaSoundCore::countActiveMechanicalDevices() const {
     // Simulate mechanical device counting
     // In a real implementation, this would check actual device status
-    size_t device_count = 0;
-    
     // Count devices based on active fields and their quantum states
-    for (const auto& [pos, field] : sound_fields_) {
-        if (field.quantum_state == QuantumSoundState::EXCITED ||
-            field.quantum_state == QuantumSoundState::ENTANGLED) {
-            device_count++;
-        }
-    }
-    
-    return device_count;
+    return sound_fields_.fields().countStates(
+        {QuantumSoundState::EXCITED, QuantumSoundState::ENTANGLED});
 }
 
 // QuantumAcousticProcessor implementation
-QuantumAcousticProcessor::QuantumAcousticProcessor(size_t max_fields)
-    : processing_enabled_(true) {
-    processing_thread_ = std::thread(&QuantumAcousticProcessor::processingLoop, this);
+struct QuantumAcousticProcessor::Control {
+    std::atomic<bool> processing_enabled{true};
+    std::atomic<int64_t> tick_interval_us{0};
+    ThreadPool* pool = nullptr;
+    
+    std::chrono::microseconds tickInterval() const {
+        return std::chrono::microseconds(tick_interval_us.load());
+    }
+};
+
+struct QuantumAcousticProcessor::Shard {
+    size_t index = 0;                           // Noise stream of this shard
+    size_t capacity = 0;
+    std::shared_ptr<Control> control;
+    std::vector<QuantumSoundField> fields;      // Working set, owned by the running task
+    size_t oldest = 0;                          // Next slot REPLACE_OLDEST overwrites
+    QuantumNoiseSource noise;                   // Task-only
+    std::chrono::steady_clock::time_point last_tick;
+    
+    // Submission queue and task state
+    mutable std::mutex queue_mutex;
+    std::condition_variable idle_condition;     // Signalled when a task finishes
+    std::vector<QuantumSoundField> pending;
+    std::vector<QuantumSoundField> incoming;
+    size_t stored = 0;                          // fields + pending, guarded by queue_mutex
+    bool stop_requested = false;
+    bool reseed_requested = false;              // noise_seed applies on the next drain
+    uint64_t noise_seed = 0;
+    bool queued = false;                        // A task is waiting in the pool
+    bool running = false;                       // A task is running
+    bool rerun = false;                         // Woken while running: go round again
+    uint64_t timer_generation = 0;              // Only the latest armed tick fires
+    
+    // Double-buffered output: snapshot is published, back_buffer is being filled
+    std::shared_ptr<std::vector<QuantumSoundField>> back_buffer;
+    std::shared_ptr<const std::vector<QuantumSoundField>> snapshot;
+};
+
+QuantumAcousticProcessor::QuantumAcousticProcessor(size_t max_fields, std::chrono::microseconds tick_interval,
+                                                   size_t worker_count, FieldOverflowPolicy overflow_policy,
+                                                   ThreadPool* pool)
+    : control_(std::make_shared<Control>())
+    , max_fields_(max_fields)
+    , overflow_policy_(overflow_policy)
+    , next_shard_(0)
+    , dropped_fields_(0) {
+    
+    control_->tick_interval_us = tick_interval.count();
+    control_->pool = pool ? pool : &ThreadPool::shared();
+    MetricsRegistry::shared().setStageBudget("qap.tick", static_cast<uint64_t>(tick_interval.count()) * 1000);
+    
+    if (worker_count == 0) {
+        worker_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    worker_count = std::max<size_t>(1, std::min(worker_count, max_fields));
+    
+    // Split the capacity as evenly as possible and preallocate every store
+    uint64_t noise_seed = std::random_device{}();
+    auto now = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto shard = std::make_shared<Shard>();
+        shard->index = i;
+        shard->control = control_;
+        shard->last_tick = now;
+        shard->noise.seed(noise_seed, i);
+        shard->capacity = max_fields / worker_count + (i < max_fields % worker_count ? 1 : 0);
+        shard->fields.reserve(shard->capacity);
+        shard->pending.reserve(shard->capacity);
+        shard->incoming.reserve(shard->capacity);
+        shard->back_buffer = std::make_shared<std::vector<QuantumSoundField>>();
+        shard->back_buffer->reserve(shard->capacity);
+        shard->snapshot = std::make_shared<const std::vector<QuantumSoundField>>();
+        shards_.push_back(std::move(shard));
+    }
 }
 
 QuantumAcousticProcessor::~QuantumAcousticProcessor() {
-    processing_enabled_ = false;
-    if (processing_thread_.joinable()) {
-        processing_thread_.join();
+    // Queued tasks and armed ticks see stop_requested and return; only a
+    // task already running is waited for
+    for (auto& shard : shards_) {
+        std::unique_lock<std::mutex> lock(shard->queue_mutex);
+        shard->stop_requested = true;
+        shard->idle_condition.wait(lock, [&]() { return !shard->running; });
     }
 }
 
-void QuantumAcousticProcessor::addField(const QuantumSoundField& field) {
-    std::lock_guard<std::mutex> lock(fields_mutex_);
-    fields_.push_back(field);
+bool QuantumAcousticProcessor::submit(Shard& shard, const QuantumSoundField& field, bool replace_oldest) {
+    std::lock_guard<std::mutex> lock(shard.queue_mutex);
+    if (shard.stored == shard.capacity) {
+        if (!replace_oldest || shard.capacity == 0) {
+            return false;
+        }
+        // The worker overwrites the oldest slot when it drains this submission
+        ++dropped_fields_;
+        ANANTASOUND_COUNT("dropped_fields", "qap", 1);
+    } else {
+        ++shard.stored;
+    }
+    shard.pending.push_back(field);
+    return true;
+}
+
+bool QuantumAcousticProcessor::addField(const QuantumSoundField& field) {
+    // Round-robin, falling through to the next shard when one is full;
+    // only when every shard is full does the overflow policy apply
+    size_t start = next_shard_.fetch_add(1, std::memory_order_relaxed);
+    for (size_t attempt = 0; attempt < shards_.size(); ++attempt) {
+        const std::shared_ptr<Shard>& shard = shards_[(start + attempt) % shards_.size()];
+        bool last_attempt = attempt + 1 == shards_.size();
+        if (submit(*shard, field, last_attempt && overflow_policy_ == FieldOverflowPolicy::REPLACE_OLDEST)) {
+            wake(shard);
+            return true;
+        }
+    }
+    ++dropped_fields_;
+    ANANTASOUND_COUNT("dropped_fields", "qap", 1);
+    return false;
+}
+
+size_t QuantumAcousticProcessor::addFields(const std::vector<QuantumSoundField>& fields) {
+    size_t accepted = 0;
+    for (const auto& field : fields) {
+        if (addField(field)) {
+            ++accepted;
+        }
+    }
+    return accepted;
 }
 
 std::vector<QuantumSoundField> QuantumAcousticProcessor::getProcessedFields() const {
-    std::lock_guard<std::mutex> lock(fields_mutex_);
-    return fields_;
+    std::vector<QuantumSoundField> fields;
+    for (const auto& snapshot : getProcessedSnapshots()) {
+        fields.insert(fields.end(), snapshot->begin(), snapshot->end());
+    }
+    return fields;
+}
+
+std::vector<QuantumAcousticProcessor::FieldSnapshot> QuantumAcousticProcessor::getProcessedSnapshots() const {
+    std::vector<FieldSnapshot> snapshots;
+    snapshots.reserve(shards_.size());
+    for (const auto& shard : shards_) {
+        snapshots.push_back(std::atomic_load_explicit(&shard->snapshot, std::memory_order_acquire));
+    }
+    return snapshots;
+}
+
+void QuantumAcousticProcessor::notifyAll() {
+    for (auto& shard : shards_) {
+        wake(shard);
+    }
 }
 
 void QuantumAcousticProcessor::setProcessingEnabled(bool enabled) {
-    processing_enabled_ = enabled;
+    control_->processing_enabled = enabled;
+    notifyAll();
+}
+
+void QuantumAcousticProcessor::setTickInterval(std::chrono::microseconds tick_interval) {
+    control_->tick_interval_us = tick_interval.count();
+    MetricsRegistry::shared().setStageBudget("qap.tick", static_cast<uint64_t>(tick_interval.count()) * 1000);
+    notifyAll();
+}
+
+void QuantumAcousticProcessor::setNoiseSeed(uint64_t seed) {
+    for (auto& shard : shards_) {
+        {
+            std::lock_guard<std::mutex> lock(shard->queue_mutex);
+            shard->reseed_requested = true;
+            shard->noise_seed = seed;
+        }
+        wake(shard);
+    }
+}
+
+std::chrono::microseconds QuantumAcousticProcessor::getTickInterval() const {
+    return control_->tickInterval();
+}
+
+void QuantumAcousticProcessor::wake(const std::shared_ptr<Shard>& shard) {
+    {
+        std::lock_guard<std::mutex> lock(shard->queue_mutex);
+        if (shard->stop_requested || shard->queued) {
+            return;
+        }
+        if (shard->running) {
+            shard->rerun = true;
+            return;
+        }
+        shard->queued = true;
+    }
+    // Outside the lock: a pool without workers runs the task right here
+    shard->control->pool->submit([shard]() { runShard(shard); }, TaskPriority::HIGH);
 }
 
-void QuantumAcousticProcessor::processingLoop() {
-    while (processing_enabled_) {
-        std::lock_guard<std::mutex> lock(fields_mutex_);
+void QuantumAcousticProcessor::runShard(const std::shared_ptr<Shard>& shard_ptr) {
+    Shard& shard = *shard_ptr;
+    const Control& control = *shard.control;
+    std::unique_lock<std::mutex> lock(shard.queue_mutex);
+    shard.queued = false;
+    if (shard.stop_requested) {
+        return;
+    }
+    shard.running = true;
+    
+    std::chrono::steady_clock::time_point next_tick;
+    bool enabled = false;
+    do {
+        shard.rerun = false;
+        shard.incoming.swap(shard.pending);
+        if (shard.reseed_requested) {
+            shard.noise.seed(shard.noise_seed, shard.index);
+            shard.reseed_requested = false;
+        }
+        // A changed interval applies from the previous tick
+        next_tick = shard.last_tick + control.tickInterval();
+        lock.unlock();
         
-        for (auto& field : fields_) {
-            // Apply quantum processing
-            field.amplitude *= std::exp(std::complex<double>(0.0, field.phase));
-            
-            // Update quantum state
-            if (field.quantum_state == QuantumSoundState::SUPERPOSITION) {
-                static std::random_device rd;
-                static std::mt19937 gen(rd());
-                static std::uniform_real_distribution<double> dist(0.0, 1.0);
-                
-                if (dist(gen) < 0.1) { // 10% chance of collapse
-                    field.quantum_state = QuantumSoundState::COLLAPSED;
-                }
+        // Drain the whole batch outside the queue lock; the store never grows past capacity
+        bool changed = !shard.incoming.empty();
+        for (const auto& field : shard.incoming) {
+            if (shard.fields.size() < shard.capacity) {
+                shard.fields.push_back(field);
+            } else {
+                shard.fields[shard.oldest] = field;
+                shard.oldest = (shard.oldest + 1) % shard.capacity;
+            }
+        }
+        shard.incoming.clear();
+        
+        auto now = std::chrono::steady_clock::now();
+        enabled = control.processing_enabled;
+        if (now >= next_tick) {
+            if (enabled) {
+                processFields(shard);
+                changed = true;
             }
+            shard.last_tick = now;
+            next_tick = now + control.tickInterval();
         }
         
-        std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
+        if (changed) {
+            publishFields(shard);
+        }
+        lock.lock();
+    } while (!shard.stop_requested && (shard.rerun || !shard.pending.empty() || shard.reseed_requested));
+    
+    // Tick only while there is something to process; an older armed tick
+    // is superseded
+    bool arm = !shard.stop_requested && enabled && !shard.fields.empty();
+    uint64_t generation = ++shard.timer_generation;
+    shard.running = false;
+    shard.idle_condition.notify_all();
+    lock.unlock();
+    
+    if (arm) {
+        std::weak_ptr<Shard> weak = shard_ptr;
+        control.pool->submitAt(next_tick, [weak, generation]() {
+            std::shared_ptr<Shard> ticking = weak.lock();
+            if (!ticking) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> tick_lock(ticking->queue_mutex);
+                if (ticking->timer_generation != generation) {
+                    return;
+                }
+            }
+            wake(ticking);
+        }, TaskPriority::HIGH);
     }
 }
 
+void QuantumAcousticProcessor::processFields(Shard& shard) {
+    ANANTASOUND_STAGE_METRIC("qap.tick", 0);
+    ANANTASOUND_COUNT("ticks", "qap", 1);
+    for (auto& field : shard.fields) {
+        // Apply quantum processing
+        field.amplitude *= std::exp(std::complex<double>(0.0, field.phase));
+        
+        // Update quantum state
+        if (field.quantum_state == QuantumSoundState::SUPERPOSITION) {
+            if (shard.noise.uniform() < 0.1) { // 10% chance of collapse
+                field.quantum_state = QuantumSoundState::COLLAPSED;
+            }
+        }
+    }
+}
 
+void QuantumAcousticProcessor::publishFields(Shard& shard) {
+    // Reuse the back buffer unless a reader still holds it from an earlier frame
+    if (shard.back_buffer.use_count() != 1) {
+        shard.back_buffer = std::make_shared<std::vector<QuantumSoundField>>();
+        shard.back_buffer->reserve(shard.capacity);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);     // Pairs with the readers' release
+    shard.back_buffer->assign(shard.fields.begin(), shard.fields.end());
+    
+    std::shared_ptr<const std::vector<QuantumSoundField>> front = shard.back_buffer;
+    front = std::atomic_exchange_explicit(&shard.snapshot, std::move(front), std::memory_order_acq_rel);
+    shard.back_buffer = std::const_pointer_cast<std::vector<QuantumSoundField>>(front);
+}
 
 // Global functions
 std::string getVersion() {
@@ -1,10 +1,20 @@
 #pragma once
 
+#include "quantum_noise.hpp"
+#include "entanglement_graph.hpp"
+#include "phase_synchronizer.hpp"
+#include "sample_clock.hpp"
+#include "field_arena.hpp"
 #include <complex>
+#include <cstdint>
 #include <vector>
 #include <map>
+#include <initializer_list>
+#include <unordered_map>
+#include <array>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
 #include <chrono>
 #include <string>
 #include <cmath>
@@ -23,6 +33,8 @@ enum class QuantumSoundState {
     COLLAPSED       // Коллапсированное состояние
 };
 
+constexpr size_t kQuantumStateCount = 6;
+
 // Сферические координаты
 struct SphericalCoord {
     double r;       // Радиус
@@ -53,9 +65,170 @@ struct QuantumSoundField {
     SphericalCoord position;           // Позиция в пространстве
     std::chrono::high_resolution_clock::time_point timestamp; // Временная метка
     
+    // Метка времени не задана (эпоха часов), пока поле не проштампует
+    // генератор: конструктор не читает часы, поэтому буферы полей
+    // создаются без обращения к часам на каждое поле
     QuantumSoundField() : amplitude(0.0, 0.0), phase(0.0), frequency(0.0), 
                           quantum_state(QuantumSoundState::GROUND), 
-                          position(), timestamp(std::chrono::high_resolution_clock::now()) {}
+                          position(), timestamp() {}
+};
+
+// Вектор полей в арене тика (FieldArena): действителен до ее reset()
+using FieldVector = std::pmr::vector<QuantumSoundField>;
+
+// Набор звуковых полей в виде структуры массивов.
+// Каждое поле QuantumSoundField разложено по отдельным непрерывным массивам,
+// поэтому редукции, которым нужны одно-два поля (фаза, амплитуда, состояние),
+// читают память подряд и векторизуются. get/set/toFields - адаптеры к
+// привычному std::vector<QuantumSoundField>. Счетчики состояний и сумма
+// модулей амплитуд поддерживаются при каждой записи, поэтому статистика
+// набора читается за O(1).
+class FieldBuffer {
+private:
+    std::vector<double> amplitude_real_;
+    std::vector<double> amplitude_imag_;
+    std::vector<double> phase_;
+    std::vector<double> frequency_;
+    std::vector<QuantumSoundState> state_;
+    std::vector<double> r_, theta_, phi_, t_, height_;
+    std::vector<std::chrono::high_resolution_clock::time_point> timestamp_;
+    
+    // Инкрементальная статистика
+    size_t state_counts_[kQuantumStateCount] = {};
+    double amplitude_magnitude_sum_ = 0.0;
+    double phase_sin_sum_ = 0.0;
+    double phase_cos_sum_ = 0.0;
+    
+public:
+    FieldBuffer() = default;
+    explicit FieldBuffer(const std::vector<QuantumSoundField>& fields) { assign(fields); }
+    
+    // Заменить содержимое (емкость массивов переиспользуется)
+    void assign(const std::vector<QuantumSoundField>& fields);
+    void push_back(const QuantumSoundField& field);
+    void set(size_t index, const QuantumSoundField& field);
+    QuantumSoundField get(size_t index) const;
+    
+    // Удалить поле, перенеся на его место последнее
+    void swapRemove(size_t index);
+    
+    void toFields(std::vector<QuantumSoundField>& fields) const;
+    void toFields(FieldVector& fields) const;
+    std::vector<QuantumSoundField> toFields() const;
+    
+    size_t size() const { return phase_.size(); }
+    bool empty() const { return phase_.empty(); }
+    void reserve(size_t count);
+    void clear();
+    
+    // Точечные изменения с обновлением статистики
+    void setAmplitude(size_t index, std::complex<double> amplitude);
+    void setState(size_t index, QuantumSoundState state);
+    void setPhase(size_t index, double phase);
+    
+    // Отдельные массивы. Переходы состояний, записанные напрямую через
+    // states(), нужно сообщить через recordStateTransitions, а фазы,
+    // записанные через phases(), - новыми суммами через recordPhaseSums
+    double* phases() { return phase_.data(); }
+    double* frequencies() { return frequency_.data(); }
+    QuantumSoundState* states() { return state_.data(); }
+    void recordStateTransitions(QuantumSoundState from, QuantumSoundState to, size_t count);
+    void recordPhaseSums(double sin_sum, double cos_sum);
+    const double* amplitudeReal() const { return amplitude_real_.data(); }
+    const double* amplitudeImag() const { return amplitude_imag_.data(); }
+    const double* phases() const { return phase_.data(); }
+    const double* frequencies() const { return frequency_.data(); }
+    const QuantumSoundState* states() const { return state_.data(); }
+    const double* radii() const { return r_.data(); }
+    const double* polarAngles() const { return theta_.data(); }
+    const double* azimuthAngles() const { return phi_.data(); }
+    const double* heights() const { return height_.data(); }
+    
+    // Статистика за O(1)
+    double amplitudeMagnitudeSum() const { return amplitude_magnitude_sum_; }  // Σ |amplitude|
+    size_t countState(QuantumSoundState state) const { return state_counts_[static_cast<size_t>(state)]; }
+    size_t countStates(std::initializer_list<QuantumSoundState> states) const; // Поля в любом из состояний
+    void phaseSums(double& sin_sum, double& cos_sum) const {                    // Σ sin(phase), Σ cos(phase)
+        sin_sum = phase_sin_sum_;
+        cos_sum = phase_cos_sum_;
+    }
+    
+private:
+    void track(size_t index);       // Учесть поле index в статистике
+    void untrack(size_t index);     // Исключить поле index из статистики
+};
+
+// Декартова позиция поля: x, y из (r, theta, phi), z - высота
+// (та же геометрия, что и в InterferenceField::calculateInterference)
+struct CartesianPosition {
+    double x, y, z;
+    
+    static CartesianPosition fromSpherical(const SphericalCoord& position) {
+        double planar = position.r * std::sin(position.theta);
+        return {planar * std::cos(position.phi), planar * std::sin(position.phi), position.height};
+    }
+};
+
+// Пространственный индекс звуковых полей.
+// Поля хранятся в FieldBuffer (последовательный обход по массивам), точная
+// позиция ищется по хешу за O(1), а кубическая сетка с ребром cell_size
+// отвечает на запросы по радиусу, просматривая только пересекаемые ячейки.
+// Удаление переносит последнее поле на место удаленного, поэтому порядок
+// обхода - порядок вставки с точностью до удалений.
+class SpatialFieldIndex {
+private:
+    struct PositionHash {
+        size_t operator()(const SphericalCoord& position) const;
+    };
+    
+    struct PositionEqual {
+        bool operator()(const SphericalCoord& a, const SphericalCoord& b) const {
+            return a.r == b.r && a.theta == b.theta && a.phi == b.phi &&
+                   a.t == b.t && a.height == b.height;
+        }
+    };
+    
+    double cell_size_;
+    FieldBuffer fields_;
+    std::vector<CartesianPosition> positions_;     // Параллельно fields_
+    std::vector<uint64_t> cell_keys_;              // Ячейка каждого поля
+    std::unordered_map<SphericalCoord, size_t, PositionHash, PositionEqual> slots_;
+    std::unordered_map<uint64_t, std::vector<size_t>> cells_;
+    
+public:
+    explicit SpatialFieldIndex(double cell_size = 0.5);
+    
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    
+    // Вставить поле или заменить поле с той же позицией; возвращает его индекс
+    size_t insertOrAssign(const QuantumSoundField& field);
+    
+    // Удалить поле в точной позиции
+    bool erase(const SphericalCoord& position);
+    
+    // Индекс поля в точной позиции или npos
+    size_t find(const SphericalCoord& position) const;
+    
+    // Индексы полей не дальше radius от center (порядок не определен)
+    void queryRadius(const SphericalCoord& center, double radius, std::vector<size_t>& indices) const;
+    
+    size_t size() const { return fields_.size(); }
+    bool empty() const { return fields_.empty(); }
+    void clear();
+    
+    double getCellSize() const { return cell_size_; }
+    
+    // Массивы полей. Изменяемый доступ не дает менять позиции:
+    // индекс их не отслеживает
+    const FieldBuffer& fields() const { return fields_; }
+    FieldBuffer& fields() { return fields_; }
+    const std::vector<CartesianPosition>& positions() const { return positions_; }
+    QuantumSoundField get(size_t index) const { return fields_.get(index); }
+    
+private:
+    int64_t cellCoordinate(double value) const;
+    static uint64_t packCell(int64_t x, int64_t y, int64_t z);
+    void removeFromCell(uint64_t key, size_t index);
 };
 
 // Типы интерференции
@@ -68,46 +241,245 @@ enum class InterferenceFieldType {
     QUANTUM_ENTANGLED    // Квантово-запутанная
 };
 
+struct InterferenceKernelTable;
+struct InterferenceSources;
+class InterferenceComputeBackend;
+class InterferencePointGrid;
+class BakedInterferenceLayout;
+class IncrementalInterferenceMap;
+class InterferenceClusterTree;
+class ThreadPool;
+class AsyncControl;
+struct AsyncOptions;
+template<typename T> class AsyncResult;
+class SessionRecorder;
+class SharedFieldOutput;
+
 // Интерференционное поле
 class InterferenceField {
 private:
     InterferenceFieldType type_;
     SphericalCoord center_;
     double radius_;
-    std::vector<QuantumSoundField> source_fields_;
-    std::vector<std::pair<size_t, size_t>> entangled_pairs_;
+    std::vector<QuantumSoundField> source_fields_;     // Плотный массив источников
+    SlotIndex source_slots_;                            // Стабильные дескрипторы источников
+    EntanglementGraph entanglement_;                     // Вершины - слоты источников
     double field_radius_;
-    mutable std::mutex field_mutex_;
+    mutable std::mutex field_mutex_;       // Сериализует только писателей
+    
+    // Неизменяемый снимок источников для ядер интерференции: декартовы
+    // координаты, волновое число 2πf/c и вес amplitude * quantum_factor.
+    // Писатели меняют рабочую копию pending_ под field_mutex_ и только
+    // помечают снимок устаревшим; updateQuantumState публикует его раз за
+    // тик, а читатель, заставший устаревший снимок, публикует его сам.
+    // Иначе читатели берут текущий снимок без блокировки
+    struct SourceSnapshot {
+        std::vector<double> x;
+        std::vector<double> y;
+        std::vector<double> z;
+        std::vector<double> wavenumber;
+        std::vector<double> weight_real;
+        std::vector<double> weight_imag;
+        size_t entangled_pairs = 0;
+        
+        // Частотные лестницы (см. InterferenceLadders): совпадающие позиции
+        // с арифметической прогрессией волновых чисел. Пусто, если
+        // группировка не окупается
+        std::vector<double> ladder_x;
+        std::vector<double> ladder_y;
+        std::vector<double> ladder_z;
+        std::vector<double> ladder_wavenumber;
+        std::vector<double> ladder_step;
+        std::vector<uint32_t> ladder_begin;
+        std::vector<uint32_t> ladder_members;
+        
+        uint64_t version = 0;           // Уникален в процессе; ставится при публикации
+        uint64_t geometry_version = 0;  // Меняется только с составом, позициями и частотами
+    };
+    static constexpr size_t kSnapshotPoolSize = 3;
+    mutable SourceSnapshot pending_;                    // Под field_mutex_
+    mutable std::shared_ptr<const SourceSnapshot> snapshot_;
+    mutable std::array<std::shared_ptr<SourceSnapshot>, kSnapshotPoolSize> snapshot_pool_;     // Под field_mutex_
+    mutable size_t snapshot_pool_next_;
+    mutable std::atomic<bool> snapshot_stale_;
+    
+    // Источники каждой позиции, упорядоченные по волновому числу (пары
+    // волновое число - индекс): добавление и удаление меняют одну группу,
+    // а лестницы pending_ пересобираются из групп при публикации без сортировки
+    using LadderPosition = std::array<double, 3>;
+    std::map<LadderPosition, std::vector<std::pair<double, uint32_t>>> ladder_groups_;     // Под field_mutex_
+    mutable bool ladders_stale_;
+    const InterferenceKernelTable* kernels_;
+    
+    // Цикл по точкам, специализированный по типу поля на этапе компиляции;
+    // выбирается один раз в конструкторе
+    using PointEvaluator = void (*)(const InterferenceKernelTable& kernels, const InterferenceSources& sources,
+                                    const SphericalCoord* positions, size_t count, double time,
+                                    std::complex<double>* output);
+    PointEvaluator evaluate_;
 
 public:
     InterferenceField(InterferenceFieldType type, SphericalCoord center, double radius);
     
-    // Добавить источник звукового поля
-    void addSourceField(const QuantumSoundField& field);
+    using SourceHandle = SlotHandle;
+    
+    // Добавить источник звукового поля; дескриптор остается валидным до удаления источника
+    SourceHandle addSourceField(const QuantumSoundField& field);
+    
+    // Добавить несколько источников с одной публикацией снимка
+    std::vector<SourceHandle> addSourceFields(const std::vector<QuantumSoundField>& fields);
+    
+    // Удалить источник за O(1) (последний источник занимает его позицию)
+    // вместе со всеми его связями запутанности
+    bool removeSourceField(SourceHandle source);
+    
+    // Удалить источники removed (недействительные пропускаются) и добавить
+    // fields с одной публикацией снимка: читатели видят либо старый, либо
+    // новый набор целиком
+    std::vector<SourceHandle> replaceSourceFields(const std::vector<SourceHandle>& removed,
+                                                  const std::vector<QuantumSoundField>& fields);
+    
+    size_t getSourceCount() const;
+    bool containsSource(SourceHandle source) const;
+    SourceHandle getSourceHandle(size_t index) const;   // Текущая позиция -> дескриптор
+    
+    // Параметры и содержимое поля (например, для сохранения сцены)
+    InterferenceFieldType getType() const { return type_; }
+    const SphericalCoord& getCenter() const { return center_; }
+    double getFieldRadius() const { return field_radius_; }
+    std::vector<QuantumSoundField> getSourceFields() const;             // В порядке текущих позиций
+    std::vector<std::pair<size_t, size_t>> getEntangledPairs() const;  // Пары позиций, first < second
     
     // Вычислить результирующую интерференцию в точке
     std::complex<double> calculateInterference(const SphericalCoord& position, double time) const;
     
+    // Интерференция в наборе точек по одному снимку источников (например,
+    // карта поля купола); output должен вмещать count значений
+    void calculateInterference(const SphericalCoord* positions, size_t count, double time,
+                               std::complex<double>* output) const;
+    std::vector<std::complex<double>> calculateInterference(const std::vector<SphericalCoord>& positions,
+                                                            double time) const;
+    
+    // Та же карта без блокировки вызывающего (например, развертка по всему
+    // куполу для интерфейса): блоки точек считаются в пуле (см.
+    // async_task.hpp) по одному снимку источников, с прогрессом и отменой
+    // между блоками. Поле должно пережить задачу
+    AsyncResult<std::vector<std::complex<double>>> calculateInterferenceAsync(
+        std::vector<SphericalCoord> positions, double time) const;
+    AsyncResult<std::vector<std::complex<double>>> calculateInterferenceAsync(
+        std::vector<SphericalCoord> positions, double time, const AsyncOptions& options) const;
+    
+    // Карта интерференции по сетке точек на вычислительном бэкенде (см.
+    // interference_backend.hpp): источники выгружаются в бэкенд только после
+    // смены снимка; output должен вмещать grid.size() значений. false, если
+    // бэкенд не смог выполнить расчет
+    bool calculateInterferenceMap(const InterferencePointGrid& grid, double time, std::complex<double>* output,
+                                  InterferenceComputeBackend& backend) const;
+    
+    // Неподвижная раскладка источников и слушателей: матрица фазоров
+    // считается один раз, а каждый тик - это произведение матрицы на вектор
+    // текущих весов источников. Расчет возвращает false, если после
+    // запекания источники добавлялись или удалялись (нужно запечь заново)
+    void bakeLayout(const InterferencePointGrid& grid, BakedInterferenceLayout& layout,
+                    ThreadPool* pool = nullptr) const;
+    bool calculateBakedInterference(const BakedInterferenceLayout& layout, double time,
+                                    std::complex<double>* output, ThreadPool* pool = nullptr) const;
+    
+    // Карта, которая пересчитывает только изменившиеся с прошлого вызова
+    // источники (см. IncrementalInterferenceMap); output - map.size() значений
+    void calculateIncrementalInterference(IncrementalInterferenceMap& map, double time,
+                                          std::complex<double>* output) const;
+    
+    // Иерархическое приближение для сцен с десятками тысяч источников
+    // (см. InterferenceClusterTree): дерево строится по текущему снимку,
+    // расчет возвращает false, если источники с тех пор менялись
+    void buildClusterTree(InterferenceClusterTree& tree) const;
+    bool calculateClusteredInterference(const InterferenceClusterTree& tree, const SphericalCoord* positions,
+                                        size_t count, double time, std::complex<double>* output) const;
+    
+    // Новая комплексная амплитуда источников (меняет и фазу) без изменения
+    // геометрии; видна читателям целиком со следующей публикацией. false, если какой-либо
+    // дескриптор недействителен (тогда ничего не меняется)
+    bool setSourceAmplitude(SourceHandle source, std::complex<double> amplitude);
+    bool setSourceAmplitudes(const SourceHandle* sources, const std::complex<double>* amplitudes, size_t count);
+    
     // Квантовая суперпозиция полей
     QuantumSoundField quantumSuperposition(const std::vector<QuantumSoundField>& fields) const;
     
     // Обновить поле с учетом квантовых эффектов
     void updateQuantumState(double dt);
     
-    // Создать квантовую запутанность между полями
+    // Создать квантовую запутанность между полями (по текущим позициям)
     void createQuantumEntanglement(size_t field1_idx, size_t field2_idx);
     
-    // Получить количество запутанных пар
+    // false для недействительных дескрипторов, пары с самим собой и повторной пары
+    bool createQuantumEntanglement(SourceHandle first, SourceHandle second);
+    bool removeQuantumEntanglement(SourceHandle first, SourceHandle second);
+    
+    // Запросы к графу запутанности
+    bool areEntangled(SourceHandle first, SourceHandle second) const;
+    std::vector<SourceHandle> getEntangledPartners(SourceHandle source) const;
+    bool inSameEntanglementComponent(SourceHandle first, SourceHandle second) const;
+    
+    // Получить количество запутанных пар (без повторов)
     size_t getEntangledPairsCount() const;
+    
+private:
+    std::shared_ptr<const SourceSnapshot> loadSnapshot() const;     // Публикует устаревший снимок
+    void markSnapshotStale() { snapshot_stale_.store(true, std::memory_order_release); }
+    void publishSnapshot() const;       // Вызывается под field_mutex_
+    void evaluateSnapshot(const SourceSnapshot& snapshot, const SphericalCoord* positions, size_t count,
+                          double time, std::complex<double>* output) const;
+    void appendSource(const QuantumSoundField& field);
+    // Убрать источник из плотных массивов и pending_ (своп с последним); false, если его нет
+    bool eraseSource(SourceHandle source);
+    void cacheWeight(size_t index);
+    LadderPosition ladderPosition(size_t index) const;
+    void insertLadderMember(size_t index);
+    void eraseLadderMember(size_t index);
+    void groupLadders() const;          // Лестницы pending_ из ladder_groups_
+};
+
+// Собственная мода купола (цилиндрическое приближение): n - азимутальный
+// порядок, m - радиальный номер нуля J'_n, q - осевой порядок
+struct ResonantMode {
+    int n;
+    int m;
+    int q;
+    double frequency;
+};
+
+// Геометрия купола и ее оценка относительно целевых частот
+struct DomeGeometry {
+    double radius;
+    double height;
 };
 
-// Акустический резонатор для купола
+struct DomeGeometryScore {
+    DomeGeometry geometry;
+    double error;       // Среднеквадратичное отклонение целей от ближайших мод, полутоны
+};
+
+// Акустический резонатор купола.
+// Таблица мод строится один раз на геометрию. Поглощение и RT60 хранятся
+// на фиксированной сетке третьоктавных полос (20 Гц - 20 кГц) и
+// интерполируются по логарифму частоты: запрос O(1), без блокировок и
+// выделений памяти, его можно вызывать из аудиопотока. Таблицы мод
+// кэшируются по геометрии и разделяются между резонаторами, поэтому перебор
+// вариантов геометрии не пересчитывает уже встречавшиеся таблицы.
 class DomeAcousticResonator {
+public:
+    static constexpr size_t kBandCount = 31;            // Третьоктавные полосы 20 Гц - 20 кГц
+    
 private:
     double dome_radius_;
     double dome_height_;
     std::vector<double> resonant_frequencies_;
+    std::shared_ptr<const std::vector<ResonantMode>> modes_;   // По возрастанию частоты
     std::map<double, double> acoustic_properties_;
+    double base_reverb_time_;
+    double band_absorption_[kBandCount];
+    double band_reverb_time_[kBandCount];
 
 public:
     DomeAcousticResonator(double radius, double height);
@@ -115,34 +487,139 @@ public:
     // Вычислить собственные частоты купола
     std::vector<double> calculateEigenFrequencies() const;
     
-    // Моделирование акустических свойств материалов
+    // Предвычисленная таблица мод
+    const std::vector<ResonantMode>& getModes() const { return *modes_; }
+    
+    // Таблица мод для произвольной геометрии (из кэша)
+    static std::shared_ptr<const std::vector<ResonantMode>> modalTable(double radius, double height);
+    
+    // Сменить геометрию: таблица мод берется из кэша, полосы пересчитываются
+    void setGeometry(double radius, double height);
+    double getRadius() const { return dome_radius_; }
+    double getHeight() const { return dome_height_; }
+    
+    // Моделирование акустических свойств материалов: частота -> множитель RT60.
+    // Точки интерполируются на сетку полос, за крайними точками значение постоянно.
     void setMaterialProperties(const std::map<double, double>& properties);
     
     // Вычислить время реверберации
     double calculateReverbTime(double frequency) const;
     
-    // Оптимизация частотной характеристики
-    void optimizeFrequencyResponse(const std::vector<double>& target_frequencies);
+    // Коэффициент поглощения по Сэбину на частоте
+    double getAbsorption(double frequency) const;
+    
+    // Центральная частота полосы сетки
+    static double bandCenterFrequency(size_t band);
+    
+    // Оценить варианты геометрии параллельно; результат в порядке candidates.
+    // Некорректная геометрия получает бесконечную ошибку.
+    static std::vector<DomeGeometryScore> evaluateGeometries(const std::vector<DomeGeometry>& candidates,
+                                                             const std::vector<double>& target_frequencies);
+    static std::vector<DomeGeometryScore> evaluateGeometries(const std::vector<DomeGeometry>& candidates,
+                                                             const std::vector<double>& target_frequencies,
+                                                             ThreadPool& pool);
+    
+    // Оптимизация частотной характеристики: сеточный поиск радиуса и высоты
+    // вокруг текущей геометрии (0.5x - 2x) с последовательным сужением;
+    // лучшая геометрия применяется к резонатору и возвращается
+    DomeGeometryScore optimizeFrequencyResponse(const std::vector<double>& target_frequencies);
+    DomeGeometryScore optimizeFrequencyResponse(const std::vector<double>& target_frequencies,
+                                                ThreadPool& pool);
+    
+    // Тот же поиск без блокировки вызывающего, с прогрессом и отменой (см.
+    // async_task.hpp). Геометрия резонатора не меняется: найденную применяет
+    // вызывающий через setGeometry. Резонатор должен пережить задачу
+    AsyncResult<DomeGeometryScore> optimizeFrequencyResponseAsync(std::vector<double> target_frequencies) const;
+    AsyncResult<DomeGeometryScore> optimizeFrequencyResponseAsync(std::vector<double> target_frequencies,
+                                                                  const AsyncOptions& options) const;
+
+private:
+    // Сеточный поиск без применения результата; control - прогресс и отмена
+    DomeGeometryScore searchGeometry(const std::vector<double>& target_frequencies, ThreadPool& pool,
+                                     AsyncControl* control) const;
+    static void scoreGeometries(const std::vector<DomeGeometry>& candidates,
+                                const std::vector<double>& target_frequencies, ThreadPool& pool,
+                                AsyncControl* control, DomeGeometryScore* scores);
+    void buildBandTables();
+    double interpolateBands(const double* bands, double frequency) const;
+};
+
+// Политика при заполнении хранилища QuantumAcousticProcessor
+enum class FieldOverflowPolicy {
+    REJECT_NEW,     // addField возвращает false, поле отбрасывается
+    REPLACE_OLDEST  // Новое поле вытесняет самое старое в своем шарде
 };
 
-// Квантовый акустический процессор
+// Квантовый акустический процессор.
+// Поля распределяются по шардам; хранилище шарда выделяется заранее (всего
+// max_fields полей). Своих потоков у процессора нет: шард - задача пула
+// (по умолчанию ThreadPool::shared(), полоса HIGH), которая ставится в
+// очередь при поступлении полей (забирает всю очередь одним пакетом) или по
+// таймеру пула к следующему тику, если есть что обрабатывать. Одновременно
+// выполняется не больше одной задачи шарда. Результат шарда публикуется
+// неизменяемым снимком; два буфера снимка чередуются, так что читатели
+// получают указатели без копирования векторов.
 class QuantumAcousticProcessor {
+public:
+    using FieldSnapshot = std::shared_ptr<const std::vector<QuantumSoundField>>;
+    
 private:
-    std::vector<QuantumSoundField> fields_;
-    std::atomic<bool> processing_enabled_;
-    std::thread processing_thread_;
-    mutable std::mutex fields_mutex_;
+    struct Shard;
+    struct Control;                         // Общие для шардов настройки и пул
+    std::vector<std::shared_ptr<Shard>> shards_;
+    std::shared_ptr<Control> control_;
+    size_t max_fields_;
+    FieldOverflowPolicy overflow_policy_;
+    std::atomic<size_t> next_shard_;        // Round-robin распределение
+    std::atomic<size_t> dropped_fields_;
 
 public:
-    explicit QuantumAcousticProcessor(size_t max_fields);
+    // worker_count - число шардов (0: по числу ядер, не больше max_fields);
+    // pool = nullptr: ThreadPool::shared(). Пул должен пережить процессор.
+    explicit QuantumAcousticProcessor(size_t max_fields,
+                                      std::chrono::microseconds tick_interval = std::chrono::milliseconds(16),
+                                      size_t worker_count = 0,
+                                      FieldOverflowPolicy overflow_policy = FieldOverflowPolicy::REJECT_NEW,
+                                      ThreadPool* pool = nullptr);
     ~QuantumAcousticProcessor();
     
-    void addField(const QuantumSoundField& field);
+    // false, если хранилище заполнено и политика REJECT_NEW
+    bool addField(const QuantumSoundField& field);
+    
+    // Возвращает число принятых полей
+    size_t addFields(const std::vector<QuantumSoundField>& fields);
+    
+    // Копия последних опубликованных наборов всех шардов
     std::vector<QuantumSoundField> getProcessedFields() const;
+    
+    // Последние опубликованные наборы шардов без копирования; остаются
+    // валидными, пока читатель держит указатели
+    std::vector<FieldSnapshot> getProcessedSnapshots() const;
+    
+    // Выключение приостанавливает обработку; новые поля по-прежнему публикуются
     void setProcessingEnabled(bool enabled);
     
+    void setTickInterval(std::chrono::microseconds tick_interval);
+    std::chrono::microseconds getTickInterval() const;
+    
+    // Фиксированное зерно шума коллапса: шард i получает поток i этого зерна
+    void setNoiseSeed(uint64_t seed);
+    
+    size_t getWorkerCount() const { return shards_.size(); }
+    size_t getMaxFields() const { return max_fields_; }
+    FieldOverflowPolicy getOverflowPolicy() const { return overflow_policy_; }
+    size_t getDroppedFieldsCount() const { return dropped_fields_.load(); }
+    
 private:
-    void processingLoop();
+    bool submit(Shard& shard, const QuantumSoundField& field, bool replace_oldest);
+    void notifyAll();
+    
+    // Задачи шарда не обращаются к процессору: таймер пула может сработать
+    // после его разрушения
+    static void wake(const std::shared_ptr<Shard>& shard);
+    static void runShard(const std::shared_ptr<Shard>& shard);
+    static void processFields(Shard& shard);
+    static void publishFields(Shard& shard);
 };
 
 
@@ -151,15 +628,51 @@ private:
 class AnantaSoundCore {
 private:
     std::vector<std::unique_ptr<InterferenceField>> interference_fields_;
+    SlotIndex interference_slots_;      // Стабильные дескрипторы interference_fields_
     std::unique_ptr<DomeAcousticResonator> dome_resonator_;
-    std::map<SphericalCoord, QuantumSoundField> sound_fields_;
-    mutable std::mutex core_mutex_;
+    SpatialFieldIndex sound_fields_;
+    mutable std::mutex core_mutex_;     // Сериализует писателей и пространственные запросы
+    
+    // Снимок полей и статистики, публикуемый атомарно не чаще раза за тик:
+    // писатели только помечают его устаревшим, update публикует в конце
+    // тика, а читатель, заставший устаревший снимок между тиками, публикует
+    // его сам под core_mutex_. Иначе getOutputFields и getStatistics читают
+    // снимок без блокировки. Снимки берутся из небольшого пула и
+    // переиспользуют емкость буферов, поэтому тик не выделяет память
+    struct Snapshot;
+    static constexpr size_t kSnapshotPoolSize = 3;
+    mutable std::shared_ptr<const Snapshot> snapshot_;
+    mutable std::array<std::shared_ptr<Snapshot>, kSnapshotPoolSize> snapshot_pool_;     // Под core_mutex_
+    mutable size_t snapshot_pool_next_;
+    mutable std::atomic<bool> snapshot_stale_;
     
     // Параметры системы
     double dome_radius_;
     double dome_height_;
     double quantum_uncertainty_;
     bool is_initialized_;
+    QuantumNoiseSource noise_;          // Под core_mutex_
+    uint64_t noise_seed_;
+    
+    // Декогеренция идет фиксированными тиками; время хранится в наносекундах,
+    // чтобы длинный dt давал те же тики, что и много коротких
+    int64_t decoherence_time_ns_;       // Остаток до следующего тика
+    uint64_t decoherence_tick_;         // Номер следующего тика (ключ случайных чисел)
+    
+    // Синхронизация фаз по Курамото на каждом update (0 - выключена);
+    // параметр порядка берется из сумм FieldBuffer::phaseSums
+    KuramotoSynchronizer phase_sync_;
+    
+    // Часы отсчетов: update продвигает их на dt, createQuantumSoundField
+    // штампует поля текущим тиком
+    SampleClock clock_;
+    
+    // Запись сессии (nullptr - выключена); события добавляются под core_mutex_
+    SessionRecorder* recorder_;
+    
+    // Выход полей в разделяемую память (nullptr - выключен); кадр пишется
+    // в конце каждого update под core_mutex_
+    SharedFieldOutput* shared_output_;
 
 public:
     AnantaSoundCore(double radius, double height);
@@ -168,10 +681,22 @@ public:
     // Инициализация системы
     bool initialize();
     void shutdown();
+    bool isInitialized() const { return is_initialized_; }
     
-    // Управление интерференционными полями
-    void addInterferenceField(std::unique_ptr<InterferenceField> field);
+    // Управление интерференционными полями. Удаление за O(1): последнее поле
+    // занимает освободившуюся позицию, дескрипторы остаются валидными
+    using InterferenceFieldHandle = SlotHandle;
+    InterferenceFieldHandle addInterferenceField(std::unique_ptr<InterferenceField> field);
     void removeInterferenceField(size_t field_index);
+    bool removeInterferenceField(InterferenceFieldHandle handle);
+    
+    // nullptr для недействительного дескриптора
+    InterferenceField* getInterferenceField(InterferenceFieldHandle handle) const;
+    size_t getInterferenceFieldCount() const;
+    InterferenceFieldHandle getInterferenceFieldHandle(size_t index) const;    // Текущая позиция -> дескриптор
+    
+    double getDomeRadius() const { return dome_radius_; }
+    double getDomeHeight() const { return dome_height_; }
     
     // Создание квантовых звуковых полей
     QuantumSoundField createQuantumSoundField(double frequency, 
@@ -181,11 +706,64 @@ public:
     // Обработка звукового поля
     void processSoundField(const QuantumSoundField& input_field);
     
+    // Обработка пакета полей с одной публикацией снимка
+    void processSoundFields(const std::vector<QuantumSoundField>& input_fields);
+    
+    // Заменить все звуковые поля сохраненными (без шума квантовой
+    // неопределенности), одна публикация снимка; для восстановления сцены
+    void restoreSoundFields(const std::vector<QuantumSoundField>& fields);
+    
+    // Фиксированное зерно квантового шума (воспроизводимые прогоны)
+    void setNoiseSeed(uint64_t seed);
+    
+    // Состояние прогона, от которого зависит результат при тех же входах:
+    // зерно шума, фаза тиков декогеренции, позиция часов, связь фаз
+    struct RunState {
+        uint64_t noise_seed;
+        int64_t decoherence_time_ns;
+        uint64_t decoherence_tick;
+        uint64_t clock_sample;
+        double phase_coupling;
+    };
+    
+    // setRunState перезапускает поток шума с noise_seed; часы только
+    // догоняют clock_sample (назад не идут)
+    RunState getRunState() const;
+    void setRunState(const RunState& state);
+    
+    // Подключить запись сессии (nullptr - отключить). Поток шума
+    // перезапускается с текущего зерна, и recorder получает состояние
+    // прогона до первого записанного события
+    void attachRecorder(SessionRecorder* recorder);
+    
+    // Подключить выход в разделяемую память (nullptr - отключить); текущие
+    // поля публикуются сразу, дальше - по кадру на update. output должен
+    // жить, пока подключен
+    void attachSharedOutput(SharedFieldOutput* output);
+    
+    // Связь K синхронизации фаз звуковых полей в update (0 - выключена)
+    void setPhaseCoupling(double coupling);
+    double getPhaseCoupling() const;
+    
+    // Часы отсчетов системы (например, для MechanicalDeviceManager::synchronizeDevices)
+    const SampleClock& getClock() const { return clock_; }
+    
     // Получение результирующего звукового поля
     std::vector<QuantumSoundField> getOutputFields() const;
+    void getOutputFields(std::vector<QuantumSoundField>& output) const;     // Переиспользует емкость output
+    FieldVector getOutputFields(FieldArena& arena) const;                   // Память - из арены тика
     
-    // Обновление системы
+    // Поля не дальше radius от center (для расчета интерференции по окрестности)
+    std::vector<QuantumSoundField> getFieldsInRadius(const SphericalCoord& center, double radius) const;
+    
+    // Обновление системы; вариант с пулом делит поля между потоками
+    // и дает тот же результат, что и последовательный
     void update(double dt);
+    void update(double dt, ThreadPool& pool);
+    
+    // Шаг декогеренции: 5% полей в суперпозиции переходят в GROUND
+    static constexpr int64_t kDecoherenceTickNs = 16000000;    // ~60 FPS
+    static constexpr double kDecoherenceProbability = 0.05;
     
     // Получение статистики системы
     struct SystemStatistics {
@@ -193,6 +771,7 @@ public:
         size_t entangled_pairs;
         double coherence_ratio;
         double energy_efficiency;
+        double phase_coherence;         // |Σ exp(i φ)| / N
         bool qrd_connected;
         size_t mechanical_devices_active;
     };
@@ -200,6 +779,14 @@ public:
     SystemStatistics getStatistics() const;
     
 private:
+    void updateLocked(double dt, ThreadPool* pool);
+    bool eraseInterferenceField(InterferenceFieldHandle handle);     // Под core_mutex_
+    void storeSoundField(const QuantumSoundField& input_field);
+    void markSnapshotStale() { snapshot_stale_.store(true, std::memory_order_release); }
+    void publishSnapshot() const;      // Вызывается под core_mutex_
+    std::shared_ptr<const Snapshot> loadSnapshot() const;
+    std::shared_ptr<const Snapshot> readSnapshot() const;  // Публикует устаревший снимок; без core_mutex_
+    
     // Helper methods for statistics calculation
     double calculateCoherenceRatio() const;
     double calculateEnergyEfficiency() const;
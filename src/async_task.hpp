@@ -0,0 +1,148 @@
+#pragma once
+
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace AnantaSound {
+
+// Thrown from AsyncResult::get() when a job stopped because it was cancelled
+class OperationCancelled : public std::runtime_error {
+public:
+    OperationCancelled() : std::runtime_error("operation cancelled") {}
+};
+
+// Cancellation flag and progress of one asynchronous job, shared by the job
+// and its AsyncResult. Jobs poll isCancelled() (or throwIfCancelled())
+// between units of work and report progress as they go; the progress
+// callback runs on the worker that reports, one call at a time, with
+// strictly increasing fractions.
+class AsyncControl {
+public:
+    using ProgressCallback = std::function<void(double fraction)>;
+
+private:
+    std::atomic<bool> cancelled_;
+    std::atomic<size_t> done_;
+    std::atomic<size_t> total_;
+    std::atomic<double> progress_;
+    std::mutex callback_mutex_;
+    ProgressCallback callback_;
+    double reported_;                       // Under callback_mutex_
+
+public:
+    explicit AsyncControl(ProgressCallback callback = ProgressCallback())
+        : cancelled_(false), done_(0), total_(0), progress_(0.0),
+          callback_(std::move(callback)), reported_(0.0) {}
+
+    AsyncControl(const AsyncControl&) = delete;
+    AsyncControl& operator=(const AsyncControl&) = delete;
+
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+    void throwIfCancelled() const {
+        if (isCancelled()) {
+            throw OperationCancelled();
+        }
+    }
+
+    // Progress in [0, 1]
+    double getProgress() const { return progress_.load(std::memory_order_relaxed); }
+
+    // Count progress in units of work: setTotal once, then advance from any thread
+    void setTotal(size_t units) {
+        done_.store(0, std::memory_order_relaxed);
+        total_.store(units, std::memory_order_relaxed);
+    }
+    void advance(size_t units = 1) {
+        size_t done = done_.fetch_add(units, std::memory_order_relaxed) + units;
+        size_t total = total_.load(std::memory_order_relaxed);
+        if (total > 0) {
+            report(static_cast<double>(std::min(done, total)) / static_cast<double>(total));
+        }
+    }
+
+    void report(double fraction) {
+        fraction = std::clamp(fraction, 0.0, 1.0);
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        if (fraction <= reported_) {
+            return;
+        }
+        reported_ = fraction;
+        progress_.store(fraction, std::memory_order_relaxed);
+        if (callback_) {
+            callback_(fraction);
+        }
+    }
+};
+
+// How an asynchronous call runs
+struct AsyncOptions {
+    AsyncControl::ProgressCallback on_progress;             // Called from pool workers
+    TaskPriority priority = TaskPriority::BACKGROUND;
+    ThreadPool* pool = nullptr;                             // nullptr: ThreadPool::shared()
+};
+
+// Future of an asynchronous job together with its cancellation and progress
+template<typename T>
+class AsyncResult {
+private:
+    std::future<T> future_;
+    std::shared_ptr<AsyncControl> control_;
+
+public:
+    AsyncResult() = default;
+    AsyncResult(std::future<T> future, std::shared_ptr<AsyncControl> control)
+        : future_(std::move(future)), control_(std::move(control)) {}
+
+    bool valid() const { return future_.valid(); }
+    bool isReady() const {
+        return future_.valid() && future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+    void wait() const { future_.wait(); }
+    template<typename Rep, typename Period>
+    bool waitFor(const std::chrono::duration<Rep, Period>& timeout) const {
+        return future_.wait_for(timeout) == std::future_status::ready;
+    }
+
+    // Result; rethrows the job's exception (OperationCancelled after cancel())
+    T get() { return future_.get(); }
+
+    // Ask the job to stop at its next check; get() then throws
+    // OperationCancelled unless the job had already finished
+    void cancel() { control_->cancel(); }
+    bool isCancelled() const { return control_->isCancelled(); }
+    double getProgress() const { return control_->getProgress(); }
+};
+
+// Run job(control) on the pool in options.priority and return its future.
+// With a pool without workers the job runs before runAsync returns.
+template<typename T, typename Job>
+AsyncResult<T> runAsync(Job job, const AsyncOptions& options) {
+    auto control = std::make_shared<AsyncControl>(options.on_progress);
+    auto promise = std::make_shared<std::promise<T>>();
+    AsyncResult<T> result(promise->get_future(), control);
+    ThreadPool& pool = options.pool ? *options.pool : ThreadPool::shared();
+
+    pool.submit([job = std::move(job), control, promise]() mutable {
+        try {
+            control->throwIfCancelled();
+            T value = job(*control);
+            control->report(1.0);
+            promise->set_value(std::move(value));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    }, options.priority);
+    return result;
+}
+
+} // namespace AnantaSound
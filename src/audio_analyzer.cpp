@@ -1,20 +1,57 @@
 #include "audio_analyzer.hpp"
+#include "feature_cache.hpp"
+#include "instrumentation.hpp"
+#include "streaming_analyzer.hpp"
+#include "tempo_tracker.hpp"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <iostream>
+#include <fstream>
+#include <iomanip>
 
 namespace AnantaSound {
 
+namespace {
+
+// Frames per chunk of an asynchronous overlapped analysis: the job checks
+// for cancellation and reports progress once per chunk
+constexpr size_t kAsyncFrameGrain = 64;
+
+} // namespace
+
+template<>
+AudioAnalyzer::PrecisionState<double>& AudioAnalyzer::state<double>() {
+    return double_state_;
+}
+
+template<>
+AudioAnalyzer::PrecisionState<float>& AudioAnalyzer::state<float>() {
+    return float_state_;
+}
+
+template<>
+const AudioAnalyzer::PrecisionState<double>& AudioAnalyzer::state<double>() const {
+    return double_state_;
+}
+
+template<>
+const AudioAnalyzer::PrecisionState<float>& AudioAnalyzer::state<float>() const {
+    return float_state_;
+}
+
 AudioAnalyzer::AudioAnalyzer(size_t fft_size, size_t sample_rate)
     : fft_size_(fft_size)
     , sample_rate_(sample_rate)
     , min_frequency_(20.0)
     , max_frequency_(sample_rate_ / 2.0)
-    , hop_size_(fft_size_ / 4) {
+    , hop_size_(fft_size_ / 4)
+    , features_(AnalysisFeature::ALL)
+    , feature_cache_(nullptr) {
     
-    fft_buffer_.resize(fft_size_);
-    generateWindowFunction();
+    double_state_.kernels = &getSpectralKernels();
+    float_state_.kernels = &getSpectralKernelsF();
+    planFFT();
 }
 
 bool AudioAnalyzer::initialize() {
@@ -28,77 +65,571 @@ bool AudioAnalyzer::initialize() {
         return false;
     }
     
-    generateWindowFunction();
+    return double_state_.fft_plan || planFFT();
+}
+
+bool AudioAnalyzer::planFFT() {
+    if (!FFTPlan::isValidSize(fft_size_)) {
+        double_state_.fft_plan.reset();
+        float_state_.fft_plan.reset();
+        return false;
+    }
+    
+    // Plans and windows come from the process-wide tables; the locked
+    // scratch is sized on first use, so an analyzer that is only ever used
+    // in one precision never allocates the other's buffers
+    double_state_.fft_plan = sharedFFTPlan<double>(fft_size_);
+    float_state_.fft_plan = sharedFFTPlan<float>(fft_size_);
+    double_state_.window_function = sharedHannWindow<double>(fft_size_);
+    float_state_.window_function = sharedHannWindow<float>(fft_size_);
+    
+    // The frequency axis is identical for every frame
+    size_t bin_count = double_state_.fft_plan->getBinCount();
+    double bin_width = getFrequency(1);
+    double_state_.frequency_axis.resize(bin_count);
+    float_state_.frequency_axis.resize(bin_count);
+    for (size_t i = 0; i < bin_count; ++i) {
+        double frequency = static_cast<double>(i) * bin_width;
+        double_state_.frequency_axis[i] = frequency;
+        float_state_.frequency_axis[i] = static_cast<float>(frequency);
+    }
     return true;
 }
 
 AudioAnalysisResult AudioAnalyzer::analyzeAudio(const std::vector<double>& audio_buffer) {
-    std::lock_guard<std::mutex> lock(analysis_mutex_);
-    
     AudioAnalysisResult result;
-    
-    if (audio_buffer.empty()) {
-        return result;
+    analyzeAudio(audio_buffer.data(), audio_buffer.size(), result);
+    return result;
+}
+
+AudioAnalysisResultF AudioAnalyzer::analyzeAudio(const std::vector<float>& audio_buffer) {
+    AudioAnalysisResultF result;
+    analyzeAudio(audio_buffer.data(), audio_buffer.size(), result);
+    return result;
+}
+
+template<typename Real>
+AudioAnalyzer::BasicFrameScratch<Real> AudioAnalyzer::makeFrameScratch() const {
+    BasicFrameScratch<Real> scratch;
+    const auto& plan = state<Real>().fft_plan;
+    if (plan) {
+        scratch.input.assign(fft_size_, Real(0));
+        scratch.spectrum.assign(plan->getBinCount(), std::complex<Real>(0, 0));
+        scratch.correlation.assign(fft_size_, std::complex<Real>(0, 0));
+        scratch.channel.assign(fft_size_, Real(0));
+    }
+    return scratch;
+}
+
+template AudioAnalyzer::BasicFrameScratch<double> AudioAnalyzer::makeFrameScratch<double>() const;
+template AudioAnalyzer::BasicFrameScratch<float> AudioAnalyzer::makeFrameScratch<float>() const;
+
+void AudioAnalyzer::analyzeAudio(const double* samples, size_t sample_count, AudioAnalysisResult& reuse) {
+    analyzeLocked(samples, sample_count, reuse);
+}
+
+void AudioAnalyzer::analyzeAudio(const float* samples, size_t sample_count, AudioAnalysisResultF& reuse) {
+    analyzeLocked(samples, sample_count, reuse);
+}
+
+void AudioAnalyzer::analyzeAudio(const double* samples, size_t sample_count, AudioAnalysisResult& reuse,
+                                 FrameScratch& scratch) const {
+    analyzeFrame(samples, sample_count, reuse, scratch);
+}
+
+void AudioAnalyzer::analyzeAudio(const float* samples, size_t sample_count, AudioAnalysisResultF& reuse,
+                                 FrameScratchF& scratch) const {
+    analyzeFrame(samples, sample_count, reuse, scratch);
+}
+
+template<typename Real>
+AudioAnalyzer::BasicFrameScratch<Real>& AudioAnalyzer::lockedScratch() {
+    BasicFrameScratch<Real>& scratch = state<Real>().scratch;
+    if (scratch.input.empty()) {
+        scratch = makeFrameScratch<Real>();
     }
+    return scratch;
+}
+
+template<typename Real>
+void AudioAnalyzer::analyzeLocked(const Real* samples, size_t sample_count, BasicAudioAnalysisResult<Real>& reuse) {
+    ANANTASOUND_LOCK_GUARD(lock, analysis_mutex_, "AudioAnalyzer::analysis_mutex_");
+    analyzeFrame(samples, sample_count, reuse, lockedScratch<Real>());
+}
+
+template<typename Real>
+void AudioAnalyzer::analyzeFrame(const Real* samples, size_t sample_count,
+                                 BasicAudioAnalysisResult<Real>& result, BasicFrameScratch<Real>& scratch) const {
+    ANANTASOUND_STAGE_TIMER("analyzer.analyze");
+    const PrecisionState<Real>& precision = state<Real>();
+    
+    result.magnitude_spectrum.clear();
+    result.phase_spectrum.clear();
+    result.frequency_spectrum.clear();
+    result.fundamental_frequency = 0.0;
+    result.volume_level = 0.0;
+    result.spectral_centroid = 0.0;
+    result.spectral_rolloff = 0.0;
+    result.zero_crossing_rate = 0.0;
+    result.tempo = 0.0;
+    result.timestamp = std::chrono::high_resolution_clock::now();
     
-    // Prepare buffer for FFT (pad with zeros if necessary)
-    std::vector<double> padded_buffer = audio_buffer;
-    if (padded_buffer.size() < fft_size_) {
-        padded_buffer.resize(fft_size_, 0.0);
-    } else if (padded_buffer.size() > fft_size_) {
-        padded_buffer.resize(fft_size_);
+    if (samples == nullptr || sample_count == 0 || !precision.fft_plan) {
+        return;
     }
     
-    // Apply window function
-    applyWindow(padded_buffer);
+    const uint32_t features = getFeatures();
+    const bool magnitudes = (features & (AnalysisFeature::SPECTRAL_SHAPE | AnalysisFeature::TEMPO)) != 0;
     
-    // Copy to complex buffer
-    for (size_t i = 0; i < fft_size_; ++i) {
-        fft_buffer_[i] = std::complex<double>(padded_buffer[i], 0.0);
+    if (magnitudes || (features & AnalysisFeature::PHASE_SPECTRUM)) {
+        // Prepare frame for FFT (pad with zeros if necessary)
+        size_t frame_length = std::min(sample_count, fft_size_);
+        std::copy(samples, samples + frame_length, scratch.input.begin());
+        std::fill(scratch.input.begin() + frame_length, scratch.input.end(), Real(0));
+        
+        // Apply window function
+        applyWindow(scratch.input);
+        
+        // Real-input FFT: only the non-redundant half of the spectrum is computed
+        precision.fft_plan->forwardReal(scratch.input.data(), scratch.spectrum.data());
     }
     
-    // Perform FFT
-    performFFT(fft_buffer_);
+    // Calculate spectra and spectral features in one pass over the bins
+    if (magnitudes) {
+        calculateSpectralFeatures(scratch.spectrum, result);
+    }
     
-    // Calculate spectra
-    result.magnitude_spectrum = magnitudeSpectrum(fft_buffer_);
-    result.phase_spectrum = phaseSpectrum(fft_buffer_);
-    result.frequency_spectrum.resize(result.magnitude_spectrum.size());
+    // Periodic frames get a sub-bin pitch; the others keep the spectral peak
+    if (features & AnalysisFeature::PITCH) {
+        double pitch = estimatePitch(samples, sample_count, scratch);
+        if (pitch > 0.0) {
+            result.fundamental_frequency = pitch;
+        }
+    }
+    if (features & AnalysisFeature::PHASE_SPECTRUM) {
+        phaseSpectrum(scratch.spectrum, result.phase_spectrum);
+    }
+    if (features & AnalysisFeature::FREQUENCY_SPECTRUM) {
+        result.frequency_spectrum.assign(precision.frequency_axis.begin(), precision.frequency_axis.end());
+    }
+    
+    // Calculate time-domain features
+    if (features & AnalysisFeature::ZERO_CROSSINGS) {
+        result.zero_crossing_rate = calculateZeroCrossingRate(samples, sample_count);
+    }
+    if (features & AnalysisFeature::VOLUME) {
+        result.volume_level = calculateVolumeLevel(samples, sample_count);
+    }
+}
+
+std::vector<AudioAnalysisResult> AudioAnalyzer::analyzeAudioWithOverlap(const std::vector<double>& audio_buffer) {
+    return analyzeOverlapping(audio_buffer);
+}
+
+std::vector<AudioAnalysisResultF> AudioAnalyzer::analyzeAudioWithOverlap(const std::vector<float>& audio_buffer) {
+    return analyzeOverlapping(audio_buffer);
+}
+
+std::vector<AudioAnalysisResult> AudioAnalyzer::analyzeAudioWithOverlap(const std::vector<double>& audio_buffer,
+                                                                        ThreadPool& pool) {
+    return analyzeOverlapping(audio_buffer, pool);
+}
+
+std::vector<AudioAnalysisResultF> AudioAnalyzer::analyzeAudioWithOverlap(const std::vector<float>& audio_buffer,
+                                                                         ThreadPool& pool) {
+    return analyzeOverlapping(audio_buffer, pool);
+}
+
+AsyncResult<std::vector<AudioAnalysisResult>> AudioAnalyzer::analyzeAudioWithOverlapAsync(
+    std::vector<double> audio_buffer, const AsyncOptions& options) {
+    return analyzeOverlappingAsync(std::move(audio_buffer), options);
+}
+
+AsyncResult<std::vector<AudioAnalysisResultF>> AudioAnalyzer::analyzeAudioWithOverlapAsync(
+    std::vector<float> audio_buffer, const AsyncOptions& options) {
+    return analyzeOverlappingAsync(std::move(audio_buffer), options);
+}
+
+void AudioAnalyzer::analyzeChannels(const AudioBuffer& buffer, std::vector<AudioAnalysisResult>& results,
+                                    ChannelAnalysis mode) {
+    analyzeChannelBatch(buffer, results, mode, nullptr);
+}
+
+void AudioAnalyzer::analyzeChannels(const AudioBufferF& buffer, std::vector<AudioAnalysisResultF>& results,
+                                    ChannelAnalysis mode) {
+    analyzeChannelBatch(buffer, results, mode, nullptr);
+}
+
+void AudioAnalyzer::analyzeChannels(const AudioBuffer& buffer, std::vector<AudioAnalysisResult>& results,
+                                    ThreadPool& pool, ChannelAnalysis mode) {
+    analyzeChannelBatch(buffer, results, mode, &pool);
+}
+
+void AudioAnalyzer::analyzeChannels(const AudioBufferF& buffer, std::vector<AudioAnalysisResultF>& results,
+                                    ThreadPool& pool, ChannelAnalysis mode) {
+    analyzeChannelBatch(buffer, results, mode, &pool);
+}
+
+template<typename Real>
+void AudioAnalyzer::analyzeChannelBatch(const BasicAudioBuffer<Real>& buffer,
+                                        std::vector<BasicAudioAnalysisResult<Real>>& results,
+                                        ChannelAnalysis mode, ThreadPool* pool) {
+    const size_t channels = buffer.getChannelCount();
+    if (mode == ChannelAnalysis::MID_SIDE) {
+        results.resize(channels == 2 ? 2 : 1);
+    } else {
+        results.resize(channels);
+    }
     
-    // Fill frequency spectrum
-    for (size_t i = 0; i < result.frequency_spectrum.size(); ++i) {
-        result.frequency_spectrum[i] = getFrequency(i);
+    if (pool == nullptr || results.size() < 2) {
+        ANANTASOUND_LOCK_GUARD(lock, analysis_mutex_, "AudioAnalyzer::analysis_mutex_");
+        BasicFrameScratch<Real>& scratch = lockedScratch<Real>();
+        for (size_t index = 0; index < results.size(); ++index) {
+            size_t length = scratch.channel.empty() ? 0 : gatherChannel(buffer, index, mode, scratch.channel.data());
+            analyzeFrame(scratch.channel.data(), length, results[index], scratch);
+        }
+        return;
     }
     
-    // Calculate analysis features
-    result.fundamental_frequency = calculateFundamentalFrequency(result.magnitude_spectrum);
-    result.spectral_centroid = calculateSpectralCentroid(result.magnitude_spectrum);
-    result.spectral_rolloff = calculateSpectralRolloff(result.magnitude_spectrum);
-    result.zero_crossing_rate = calculateZeroCrossingRate(audio_buffer);
-    result.tempo = estimateTempo(audio_buffer);
-    result.volume_level = calculateVolumeLevel(audio_buffer);
-    result.timestamp = std::chrono::high_resolution_clock::now();
+    std::vector<BasicFrameScratch<Real>> scratch(pool->getConcurrency());
+    pool->parallelFor(results.size(), 1, [&](size_t begin, size_t end, size_t slot) {
+        BasicFrameScratch<Real>& local = scratch[slot];
+        if (local.input.empty()) {
+            local = makeFrameScratch<Real>();
+        }
+        for (size_t index = begin; index < end; ++index) {
+            size_t length = local.channel.empty() ? 0 : gatherChannel(buffer, index, mode, local.channel.data());
+            analyzeFrame(local.channel.data(), length, results[index], local);
+        }
+    });
+}
+
+template<typename Real>
+size_t AudioAnalyzer::gatherChannel(const BasicAudioBuffer<Real>& buffer, size_t index, ChannelAnalysis mode,
+                                    Real* frame) const {
+    const size_t length = std::min(buffer.getFrameCount(), fft_size_);
+    const size_t stride = buffer.getFrameStride();
+    const size_t channels = buffer.getChannelCount();
+    
+    if (mode == ChannelAnalysis::PER_CHANNEL) {
+        const Real* source = buffer.channel(index);
+        for (size_t i = 0; i < length; ++i) {
+            frame[i] = source[i * stride];
+        }
+    } else if (channels == 2) {
+        // Mid and side from the same two channels; no extra pass over the buffer
+        const Real* left = buffer.channel(0);
+        const Real* right = buffer.channel(1);
+        const Real sign = index == 0 ? Real(1) : Real(-1);
+        for (size_t i = 0; i < length; ++i) {
+            frame[i] = Real(0.5) * (left[i * stride] + sign * right[i * stride]);
+        }
+    } else {
+        const Real scale = Real(1) / static_cast<Real>(channels);
+        std::fill(frame, frame + length, Real(0));
+        for (size_t c = 0; c < channels; ++c) {
+            const Real* source = buffer.channel(c);
+            for (size_t i = 0; i < length; ++i) {
+                frame[i] += source[i * stride];
+            }
+        }
+        for (size_t i = 0; i < length; ++i) {
+            frame[i] *= scale;
+        }
+    }
+    return length;
+}
+
+ConstantQSpectrum AudioAnalyzer::analyzeConstantQ(const std::vector<double>& audio_buffer,
+                                                  const ConstantQOptions& options) {
+    std::shared_ptr<const ConstantQKernel> kernel;
+    {
+        ANANTASOUND_LOCK_GUARD(lock, analysis_mutex_, "AudioAnalyzer::analysis_mutex_");
+        if (!constant_q_kernel_ || !constant_q_kernel_->matches(sample_rate_, options)) {
+            ConstantQOptions on_demand = options;
+            on_demand.hop_size = 0;
+            constant_q_kernel_ = std::make_shared<const ConstantQKernel>(sample_rate_, on_demand);
+        }
+        kernel = constant_q_kernel_;
+    }
     
-    return result;
+    // Samples older than twice the lowest octave's window only settle the
+    // decimators, and are long gone from every ring
+    ConstantQAnalyzer analyzer(kernel);
+    size_t history = std::min(audio_buffer.size(), 2 * analyzer.getLatencySamples());
+    analyzer.pushSamples(audio_buffer.data() + audio_buffer.size() - history, history);
+    return analyzer.computeSpectrum();
 }
 
-std::vector<AudioAnalysisResult> AudioAnalyzer::analyzeAudioWithOverlap(const std::vector<double>& audio_buffer) {
-    std::vector<AudioAnalysisResult> results;
+template<typename Real>
+std::vector<BasicAudioAnalysisResult<Real>> AudioAnalyzer::analyzeOverlapping(const std::vector<Real>& audio_buffer) {
+    std::vector<BasicAudioAnalysisResult<Real>> results;
     
     if (audio_buffer.size() < fft_size_) {
         results.push_back(analyzeAudio(audio_buffer));
         return results;
     }
     
+    // Frames are analyzed in place; no per-hop window copy
+    results.reserve((audio_buffer.size() - fft_size_) / hop_size_ + 1);
     for (size_t start = 0; start + fft_size_ <= audio_buffer.size(); start += hop_size_) {
-        std::vector<double> window_buffer(audio_buffer.begin() + start, 
-                                        audio_buffer.begin() + start + fft_size_);
-        results.push_back(analyzeAudio(window_buffer));
+        results.emplace_back();
+        analyzeAudio(audio_buffer.data() + start, fft_size_, results.back());
+    }
+    
+    trackTempo(results);
+    return results;
+}
+
+template<typename Real>
+std::vector<BasicAudioAnalysisResult<Real>> AudioAnalyzer::analyzeOverlapping(const std::vector<Real>& audio_buffer,
+                                                                              ThreadPool& pool, AsyncControl* control) {
+    if (audio_buffer.size() < fft_size_) {
+        return analyzeOverlapping(audio_buffer);
+    }
+    
+    size_t frame_count = (audio_buffer.size() - fft_size_) / hop_size_ + 1;
+    std::vector<BasicAudioAnalysisResult<Real>> results(frame_count);
+    std::vector<BasicFrameScratch<Real>> scratch(pool.getConcurrency());
+    
+    // Several chunks per thread so faster threads pick up the tail; an
+    // asynchronous run also caps chunks so cancellation and progress stay prompt
+    size_t grain = std::max<size_t>(1, frame_count / (pool.getConcurrency() * 8));
+    if (control) {
+        grain = std::min(grain, kAsyncFrameGrain);
+        control->setTotal(frame_count);
     }
     
+    pool.parallelFor(frame_count, grain, [&](size_t begin, size_t end, size_t slot) {
+        if (control) {
+            control->throwIfCancelled();
+        }
+        BasicFrameScratch<Real>& local = scratch[slot];
+        if (local.input.empty()) {
+            local = makeFrameScratch<Real>();
+        }
+        for (size_t frame = begin; frame < end; ++frame) {
+            analyzeFrame(audio_buffer.data() + frame * hop_size_, fft_size_, results[frame], local);
+        }
+        if (control) {
+            control->advance(end - begin);
+        }
+    });
+    
+    trackTempo(results);
     return results;
 }
 
+template<typename Real>
+AsyncResult<std::vector<BasicAudioAnalysisResult<Real>>> AudioAnalyzer::analyzeOverlappingAsync(
+    std::vector<Real> audio_buffer, const AsyncOptions& options) {
+    ThreadPool* pool = options.pool ? options.pool : &ThreadPool::shared();
+    return runAsync<std::vector<BasicAudioAnalysisResult<Real>>>(
+        [this, pool, buffer = std::move(audio_buffer)](AsyncControl& control) {
+            return analyzeOverlapping(buffer, *pool, &control);
+        }, options);
+}
+
+template<typename Real>
+void AudioAnalyzer::trackTempo(std::vector<BasicAudioAnalysisResult<Real>>& results) const {
+    if (!(getFeatures() & AnalysisFeature::TEMPO)) {
+        return;
+    }
+    
+    // Sequential pass over spectra that are already computed: O(bins) per frame
+    TempoTracker tracker(fft_size_, sample_rate_, hop_size_);
+    for (auto& result : results) {
+        result.tempo = tracker.pushSpectrum(result.magnitude_spectrum.data(), result.magnitude_spectrum.size());
+    }
+}
+
+bool AudioAnalyzer::loadAudioFile(const std::string& filepath) {
+    AudioFileReader reader;
+    if (!reader.open(filepath)) {
+        return false;
+    }
+    
+    const AudioInfo& info = reader.getInfo();
+    SpectralData spectral;
+    
+    // A cache entry for the same content and frame layout replaces decoding and FFT
+    FeatureCacheKey key;
+    std::shared_ptr<const FeatureTable> features;
+    if (feature_cache_ != nullptr && FeatureCache::hashFile(filepath, key.content_hash)) {
+        key.fft_size = static_cast<uint32_t>(fft_size_);
+        key.hop_size = static_cast<uint32_t>(hop_size_);
+        key.window = kFeatureWindowHann;
+        features = feature_cache_->load(key);
+    }
+    
+    if (features) {
+        spectral.frame_count = features->getFrameCount();
+        if (spectral.frame_count > 0) {
+            size_t bin_count = features->getBinCount();
+            double bin_width = static_cast<double>(static_cast<size_t>(info.sample_rate)) / static_cast<double>(fft_size_);
+            spectral.frequencies.resize(bin_count);
+            for (size_t k = 0; k < bin_count; ++k) {
+                spectral.frequencies[k] = static_cast<double>(k) * bin_width;
+            }
+            spectral.magnitudes.assign(features->meanMagnitudes(), features->meanMagnitudes() + bin_count);
+            spectral.phases.assign(features->lastPhases(), features->lastPhases() + bin_count);
+        }
+    } else {
+        // Frames come from a streaming analyzer at the file's own sample rate
+        StreamingAnalyzer stream(fft_size_, static_cast<size_t>(info.sample_rate), hop_size_);
+        if (!stream.initialize()) {
+            return false;
+        }
+        
+        std::unique_ptr<FeatureTableBuilder> builder;
+        if (feature_cache_ != nullptr && key.fft_size != 0) {
+            builder = std::make_unique<FeatureTableBuilder>(key, static_cast<uint32_t>(info.sample_rate));
+        }
+        
+        std::vector<double> magnitude_sum;
+        auto accumulate = [&](const AudioAnalysisResult& frame) {
+            if (magnitude_sum.empty()) {
+                magnitude_sum.assign(frame.magnitude_spectrum.size(), 0.0);
+                spectral.frequencies = frame.frequency_spectrum;
+            }
+            for (size_t k = 0; k < magnitude_sum.size(); ++k) {
+                magnitude_sum[k] += frame.magnitude_spectrum[k];
+            }
+            spectral.phases.assign(frame.phase_spectrum.begin(), frame.phase_spectrum.end());
+            spectral.frame_count++;
+            if (builder) {
+                builder->addFrame(frame);
+            }
+        };
+        stream.setFrameCallback(accumulate);
+        
+        // Fixed-size read block: memory stays O(fft_size_) for any file length
+        std::vector<double> block(fft_size_);
+        size_t frames_read = 0;
+        while ((frames_read = reader.readMono(block.data(), block.size())) > 0) {
+            stream.pushSamples(block.data(), frames_read);
+        }
+        
+        // Files shorter than one window still get a single frame, zero-padded
+        // at the end as analyzeAudio pads. The ring window holds the samples
+        // at its end, behind the zeros, where the window function would
+        // attenuate them
+        if (spectral.frame_count == 0 && stream.getSamplesPushed() > 0) {
+            size_t pushed = static_cast<size_t>(stream.getSamplesPushed());
+            const double* window = stream.getCurrentWindow();
+            std::copy(window + fft_size_ - pushed, window + fft_size_, block.begin());
+            std::fill(block.begin() + pushed, block.end(), 0.0);
+            AudioAnalysisResult frame;
+            stream.getAnalyzer().analyzeAudio(block.data(), pushed, frame);
+            accumulate(frame);
+        }
+        
+        if (reader.getDecodeErrors() > 0) {
+            std::cerr << "Skipped " << reader.getDecodeErrors() << " corrupt frame(s) in " << filepath << std::endl;
+        }
+        
+        if (spectral.frame_count > 0) {
+            const double inv_frames = 1.0 / static_cast<double>(spectral.frame_count);
+            spectral.magnitudes.resize(magnitude_sum.size());
+            for (size_t k = 0; k < magnitude_sum.size(); ++k) {
+                spectral.magnitudes[k] = magnitude_sum[k] * inv_frames;
+            }
+        }
+        
+        // Files with decode errors are not cached: a later run may read them whole
+        if (builder && reader.getDecodeErrors() == 0) {
+            std::shared_ptr<FeatureTable> table = builder->finish();
+            feature_cache_->store(*table);
+            features = std::move(table);
+        }
+    }
+    
+    // Long-term spectrum features
+    if (spectral.frame_count > 0) {
+        spectral.fft_data.resize(spectral.magnitudes.size());
+        
+        double total = 0.0;
+        double weighted = 0.0;
+        size_t peak_bin = 0;
+        for (size_t k = 0; k < spectral.magnitudes.size(); ++k) {
+            double magnitude = spectral.magnitudes[k];
+            spectral.fft_data[k] = std::polar(magnitude, spectral.phases[k]);
+            total += magnitude;
+            weighted += magnitude * spectral.frequencies[k];
+            if (magnitude > spectral.magnitudes[peak_bin]) {
+                peak_bin = k;
+            }
+        }
+        
+        spectral.dominant_frequency = spectral.frequencies[peak_bin];
+        if (total > 0.0) {
+            spectral.spectral_centroid = weighted / total;
+            
+            double spread = 0.0;
+            for (size_t k = 0; k < spectral.magnitudes.size(); ++k) {
+                double deviation = spectral.frequencies[k] - spectral.spectral_centroid;
+                spread += deviation * deviation * spectral.magnitudes[k];
+            }
+            spectral.spectral_bandwidth = std::sqrt(spread / total);
+            
+            size_t rolloff_bin = findRolloffBin(spectral.magnitudes.data(), spectral.magnitudes.size(), total, 0.85);
+            spectral.spectral_rolloff = spectral.frequencies[std::min(rolloff_bin, spectral.frequencies.size() - 1)];
+        }
+    }
+    
+    ANANTASOUND_LOCK_GUARD(lock, analysis_mutex_, "AudioAnalyzer::analysis_mutex_");
+    audio_info_ = info;
+    metadata_ = reader.getMetadata();
+    spectral_data_ = std::move(spectral);
+    frame_features_ = std::move(features);
+    loaded_file_ = filepath;
+    return true;
+}
+
+bool AudioAnalyzer::exportAnalysisReport(const std::string& filepath) const {
+    ANANTASOUND_LOCK_GUARD(lock, analysis_mutex_, "AudioAnalyzer::analysis_mutex_");
+    
+    if (loaded_file_.empty()) {
+        std::cerr << "No audio file loaded; nothing to export" << std::endl;
+        return false;
+    }
+    
+    std::ofstream report(filepath);
+    if (!report) {
+        std::cerr << "Failed to open report file: " << filepath << std::endl;
+        return false;
+    }
+    
+    report << "anAntaSound Audio Analysis Report" << std::endl;
+    report << "=================================" << std::endl;
+    report << "File: " << loaded_file_ << std::endl << std::endl;
+    
+    report << "Technical Information" << std::endl;
+    report << "  Format: " << audio_info_.format << " (" << audio_info_.codec << ")" << std::endl;
+    report << "  Sample Rate: " << audio_info_.sample_rate << " Hz" << std::endl;
+    report << "  Channels: " << audio_info_.channels << std::endl;
+    report << "  Bits Per Sample: " << audio_info_.bits_per_sample << std::endl;
+    report << "  Duration: " << std::fixed << std::setprecision(2) << audio_info_.duration_seconds << " s" << std::endl;
+    report << "  Total Samples: " << audio_info_.total_samples << std::endl << std::endl;
+    
+    report << "Metadata" << std::endl;
+    report << "  Title: " << metadata_.title << std::endl;
+    report << "  Artist: " << metadata_.artist << std::endl;
+    report << "  Album: " << metadata_.album << std::endl;
+    report << "  Genre: " << metadata_.genre << std::endl;
+    report << "  Year: " << metadata_.year << std::endl << std::endl;
+    
+    report << "Spectral Analysis (" << spectral_data_.frame_count << " frames, FFT " << fft_size_
+           << ", hop " << hop_size_ << ")" << std::endl;
+    report << std::setprecision(1);
+    report << "  Dominant Frequency: " << spectral_data_.dominant_frequency << " Hz" << std::endl;
+    report << "  Spectral Centroid: " << spectral_data_.spectral_centroid << " Hz" << std::endl;
+    report << "  Spectral Rolloff: " << spectral_data_.spectral_rolloff << " Hz" << std::endl;
+    report << "  Spectral Bandwidth: " << spectral_data_.spectral_bandwidth << " Hz" << std::endl;
+    
+    return static_cast<bool>(report);
+}
+
 size_t AudioAnalyzer::getFrequencyBin(double frequency) const {
     return static_cast<size_t>(frequency * fft_size_ / sample_rate_);
 }
@@ -117,166 +648,187 @@ void AudioAnalyzer::setHopSize(size_t hop_size) {
 }
 
 void AudioAnalyzer::performFFT(std::vector<std::complex<double>>& data) {
-    size_t n = data.size();
-    
-    // Bit-reverse permutation
-    for (size_t i = 1, j = 0; i < n; ++i) {
-        size_t bit = n >> 1;
-        while (j & bit) {
-            j ^= bit;
-            bit >>= 1;
-        }
-        j ^= bit;
-        
-        if (i < j) {
-            std::swap(data[i], data[j]);
-        }
-    }
-    
-    // FFT computation
-    for (size_t len = 2; len <= n; len <<= 1) {
-        double angle = -2.0 * M_PI / len;
-        std::complex<double> wlen(std::cos(angle), std::sin(angle));
-        
-        for (size_t i = 0; i < n; i += len) {
-            std::complex<double> w(1.0, 0.0);
-            for (size_t j = 0; j < len / 2; ++j) {
-                std::complex<double> u = data[i + j];
-                std::complex<double> v = data[i + j + len / 2] * w;
-                data[i + j] = u + v;
-                data[i + j + len / 2] = u - v;
-                w *= wlen;
-            }
-        }
+    if (double_state_.fft_plan && data.size() == fft_size_) {
+        double_state_.fft_plan->forward(data.data());
+    } else if (FFTPlan::isValidSize(data.size())) {
+        sharedFFTPlan<double>(data.size())->forward(data.data());
     }
 }
 
-void AudioAnalyzer::generateWindowFunction() {
-    window_function_.resize(fft_size_);
-    
-    // Generate Hann window
-    for (size_t i = 0; i < fft_size_; ++i) {
-        window_function_[i] = 0.5 * (1.0 - std::cos(2.0 * M_PI * i / (fft_size_ - 1)));
+void AudioAnalyzer::performIFFT(std::vector<std::complex<double>>& data) {
+    if (double_state_.fft_plan && data.size() == fft_size_) {
+        double_state_.fft_plan->inverse(data.data());
+    } else if (FFTPlan::isValidSize(data.size())) {
+        sharedFFTPlan<double>(data.size())->inverse(data.data());
     }
 }
 
-double AudioAnalyzer::calculateFundamentalFrequency(const std::vector<double>& magnitude_spectrum) const {
-    if (magnitude_spectrum.empty()) {
-        return 0.0;
+template<typename Real>
+void AudioAnalyzer::calculateSpectralFeatures(const std::vector<std::complex<Real>>& fft_result,
+                                              BasicAudioAnalysisResult<Real>& result, double rolloff_threshold) const {
+    result.magnitude_spectrum.resize(fft_result.size());
+    if (fft_result.empty()) {
+        return;
     }
     
-    // Find the peak in the magnitude spectrum
-    auto max_it = std::max_element(magnitude_spectrum.begin(), magnitude_spectrum.end());
-    if (max_it == magnitude_spectrum.end()) {
-        return 0.0;
-    }
+    SpectralMoments moments;
+    state<Real>().kernels->magnitude_moments(fft_result.data(), fft_result.size(),
+                                result.magnitude_spectrum.data(), moments);
+    
+    // Bin frequencies are k * bin_width, so no per-bin getFrequency() calls
+    double bin_width = getFrequency(1);
+    result.fundamental_frequency = static_cast<double>(moments.peak_bin) * bin_width;
+    result.spectral_centroid = moments.magnitude_sum > 0.0
+        ? bin_width * moments.weighted_sum / moments.magnitude_sum : 0.0;
     
-    size_t peak_bin = std::distance(magnitude_spectrum.begin(), max_it);
-    return getFrequency(peak_bin);
+    size_t rolloff_bin = findRolloffBin(result.magnitude_spectrum.data(), result.magnitude_spectrum.size(),
+                                        moments.magnitude_sum, rolloff_threshold);
+    result.spectral_rolloff = static_cast<double>(rolloff_bin) * bin_width;
 }
 
-double AudioAnalyzer::calculateSpectralCentroid(const std::vector<double>& magnitude_spectrum) const {
-    if (magnitude_spectrum.empty()) {
+template<typename Real>
+double AudioAnalyzer::estimatePitch(const Real* samples, size_t sample_count, BasicFrameScratch<Real>& scratch) const {
+    const auto& plan = state<Real>().fft_plan;
+    const size_t half = fft_size_ / 2;
+    if (!plan || scratch.correlation.size() != fft_size_ || half < 8) {
         return 0.0;
     }
     
-    double weighted_sum = 0.0;
-    double magnitude_sum = 0.0;
-    
-    for (size_t i = 0; i < magnitude_spectrum.size(); ++i) {
-        double frequency = getFrequency(i);
-        double magnitude = magnitude_spectrum[i];
-        weighted_sum += frequency * magnitude;
-        magnitude_sum += magnitude;
+    // YIN over an integration window of half a frame, for lags below half a
+    // frame, so the cross-correlation of x[0, N/2) with x[0, N) fits the
+    // analyzer's own N-point transform without wrapping. Both real inputs go
+    // through one complex FFT as z = a + i·b.
+    std::vector<std::complex<Real>>& z = scratch.correlation;
+    const size_t frame_length = std::min(sample_count, fft_size_);
+    for (size_t j = 0; j < fft_size_; ++j) {
+        Real x = j < frame_length ? samples[j] : Real(0);
+        z[j] = std::complex<Real>(j < half ? x : Real(0), x);
+    }
+    plan->forward(z.data());
+    
+    // A = (Z[k] + conj Z[-k]) / 2, B = (Z[k] - conj Z[-k]) / 2i; the
+    // cross-spectrum conj(A)·B of real signals is Hermitian
+    for (size_t k = 0; k <= half; ++k) {
+        size_t mirror = (fft_size_ - k) & (fft_size_ - 1);
+        std::complex<Real> zk = z[k];
+        std::complex<Real> zm = std::conj(z[mirror]);
+        std::complex<Real> a = (zk + zm) * Real(0.5);
+        std::complex<Real> b = (zk - zm) * std::complex<Real>(0, Real(-0.5));
+        std::complex<Real> cross = std::conj(a) * b;
+        z[k] = cross;
+        z[mirror] = std::conj(cross);
+    }
+    plan->inverse(z.data());
+    
+    // Difference function d(τ) = Σ x[j]² + Σ x[j+τ]² - 2 r(τ), then the
+    // cumulative mean normalized difference d'(τ) = τ·d(τ) / Σ_{k<=τ} d(k),
+    // kept in the real frame buffer (free once the spectrum is computed)
+    const double rate = static_cast<double>(sample_rate_);
+    const size_t min_lag = std::max<size_t>(2, static_cast<size_t>(rate / std::max(1.0, max_frequency_)));
+    const size_t max_lag = std::min(half - 2, static_cast<size_t>(std::ceil(rate / std::max(1.0, min_frequency_))));
+    if (min_lag + 1 >= max_lag) {
+        return 0.0;
     }
     
-    return magnitude_sum > 0.0 ? weighted_sum / magnitude_sum : 0.0;
-}
-
-double AudioAnalyzer::calculateSpectralRolloff(const std::vector<double>& magnitude_spectrum, double threshold) const {
-    if (magnitude_spectrum.empty()) {
+    auto sample = [&](size_t j) { return j < frame_length ? static_cast<double>(samples[j]) : 0.0; };
+    double head_energy = 0.0;
+    for (size_t j = 0; j < half; ++j) {
+        head_energy += sample(j) * sample(j);
+    }
+    if (!(head_energy > 0.0)) {
         return 0.0;
     }
     
-    double total_energy = std::accumulate(magnitude_spectrum.begin(), magnitude_spectrum.end(), 0.0);
-    double target_energy = total_energy * threshold;
-    double cumulative_energy = 0.0;
+    std::vector<Real>& normalized = scratch.input;
+    normalized[0] = Real(1);
+    double lag_energy = head_energy;
+    double running = 0.0;
+    for (size_t lag = 1; lag <= max_lag + 1; ++lag) {
+        lag_energy += sample(lag + half - 1) * sample(lag + half - 1) - sample(lag - 1) * sample(lag - 1);
+        double difference = std::max(0.0, head_energy + lag_energy - 2.0 * static_cast<double>(z[lag].real()));
+        z[lag].imag(static_cast<Real>(difference));
+        running += difference;
+        normalized[lag] = static_cast<Real>(running > 0.0 ? difference * static_cast<double>(lag) / running : 1.0);
+    }
     
-    for (size_t i = 0; i < magnitude_spectrum.size(); ++i) {
-        cumulative_energy += magnitude_spectrum[i];
-        if (cumulative_energy >= target_energy) {
-            return getFrequency(i);
+    // First dip under the threshold, followed to its minimum; otherwise the
+    // global minimum, if the frame is periodic enough at all
+    constexpr double kThreshold = 0.15;
+    constexpr double kUnvoiced = 0.5;
+    size_t best = 0;
+    for (size_t lag = min_lag; lag <= max_lag; ++lag) {
+        if (normalized[lag] < kThreshold) {
+            while (lag + 1 <= max_lag && normalized[lag + 1] < normalized[lag]) {
+                ++lag;
+            }
+            best = lag;
+            break;
+        }
+    }
+    if (best == 0) {
+        best = min_lag;
+        for (size_t lag = min_lag + 1; lag <= max_lag; ++lag) {
+            if (normalized[lag] < normalized[best]) {
+                best = lag;
+            }
+        }
+        if (normalized[best] > kUnvoiced) {
+            return 0.0;
         }
     }
     
-    return getFrequency(magnitude_spectrum.size() - 1);
+    // Parabolic interpolation of the raw difference (kept in the imaginary
+    // parts) gives the sub-sample period
+    double left = z[best - 1].imag();
+    double centre = z[best].imag();
+    double right = z[best + 1].imag();
+    double curvature = left - 2.0 * centre + right;
+    double period = static_cast<double>(best);
+    if (curvature > 0.0) {
+        period += std::clamp(0.5 * (left - right) / curvature, -0.5, 0.5);
+    }
+    return rate / period;
 }
 
-double AudioAnalyzer::calculateZeroCrossingRate(const std::vector<double>& audio_buffer) const {
-    if (audio_buffer.size() < 2) {
+template<typename Real>
+double AudioAnalyzer::calculateZeroCrossingRate(const Real* samples, size_t sample_count) const {
+    if (sample_count < 2) {
         return 0.0;
     }
     
-    size_t zero_crossings = 0;
-    for (size_t i = 1; i < audio_buffer.size(); ++i) {
-        if ((audio_buffer[i] >= 0.0) != (audio_buffer[i-1] >= 0.0)) {
-            zero_crossings++;
-        }
-    }
-    
-    return static_cast<double>(zero_crossings) / static_cast<double>(audio_buffer.size() - 1);
-}
-
-double AudioAnalyzer::estimateTempo(const std::vector<double>& audio_buffer) const {
-    // Simple tempo estimation based on zero crossing rate
-    double zcr = calculateZeroCrossingRate(audio_buffer);
-    double estimated_bpm = zcr * 60.0 * 2.0; // Rough conversion
-    return std::max(60.0, std::min(200.0, estimated_bpm));
+    size_t zero_crossings = state<Real>().kernels->zero_crossings(samples, sample_count);
+    return static_cast<double>(zero_crossings) / static_cast<double>(sample_count - 1);
 }
 
-double AudioAnalyzer::calculateVolumeLevel(const std::vector<double>& audio_buffer) const {
-    if (audio_buffer.empty()) {
+template<typename Real>
+double AudioAnalyzer::calculateVolumeLevel(const Real* samples, size_t sample_count) const {
+    if (sample_count == 0) {
         return 0.0;
     }
     
     // Calculate RMS (Root Mean Square) volume
-    double sum_squares = 0.0;
-    for (double sample : audio_buffer) {
-        sum_squares += sample * sample;
-    }
-    
-    double rms = std::sqrt(sum_squares / static_cast<double>(audio_buffer.size()));
+    double sum_squares = state<Real>().kernels->sum_of_squares(samples, sample_count);
+    double rms = std::sqrt(sum_squares / static_cast<double>(sample_count));
     return std::min(1.0, rms);
 }
 
-void AudioAnalyzer::applyWindow(std::vector<double>& buffer) const {
-    if (buffer.size() != window_function_.size()) {
+template<typename Real>
+void AudioAnalyzer::applyWindow(std::vector<Real>& buffer) const {
+    const auto& window = state<Real>().window_function;
+    if (!window || buffer.size() != window->size()) {
         return;
     }
     
+    const Real* weights = window->data();
     for (size_t i = 0; i < buffer.size(); ++i) {
-        buffer[i] *= window_function_[i];
+        buffer[i] *= weights[i];
     }
 }
 
-std::vector<double> AudioAnalyzer::magnitudeSpectrum(const std::vector<std::complex<double>>& fft_result) const {
-    std::vector<double> magnitude(fft_result.size() / 2 + 1);
-    
-    for (size_t i = 0; i < magnitude.size(); ++i) {
-        magnitude[i] = std::abs(fft_result[i]);
-    }
-    
-    return magnitude;
-}
-
-std::vector<double> AudioAnalyzer::phaseSpectrum(const std::vector<std::complex<double>>& fft_result) const {
-    std::vector<double> phase(fft_result.size() / 2 + 1);
-    
-    for (size_t i = 0; i < phase.size(); ++i) {
-        phase[i] = std::arg(fft_result[i]);
-    }
-    
-    return phase;
+template<typename Real>
+void AudioAnalyzer::phaseSpectrum(const std::vector<std::complex<Real>>& fft_result, std::vector<Real>& phase) const {
+    phase.resize(fft_result.size());
+    computePhases(fft_result.data(), fft_result.size(), phase.data());
 }
 
 } // namespace AnantaSound
\ No newline at end of file
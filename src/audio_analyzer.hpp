@@ -1,45 +1,143 @@
 #pragma once
 
+#include "fft_engine.hpp"
+#include "spectral_kernels.hpp"
+#include "thread_pool.hpp"
+#include "async_task.hpp"
+#include "audio_file_reader.hpp"
+#include "constant_q.hpp"
+#include "audio_buffer.hpp"
 #include <vector>
 #include <complex>
 #include <memory>
 #include <mutex>
+#include <atomic>
+#include <cstdint>
 #include <chrono>
+#include <string>
 
 namespace AnantaSound {
 
-// Audio analysis results
-struct AudioAnalysisResult {
-    std::vector<double> frequency_spectrum;    // FFT frequency spectrum
-    std::vector<double> magnitude_spectrum;    // Magnitude spectrum
-    std::vector<double> phase_spectrum;        // Phase spectrum
+class FeatureCache;
+class FeatureTable;
+
+// Scalar features of one analyzed frame; identical for every sample type
+struct AudioFeatures {
     double fundamental_frequency;              // Fundamental frequency (Hz)
     double volume_level;                       // Volume level (0.0 - 1.0)
     double spectral_centroid;                  // Spectral centroid (Hz)
     double spectral_rolloff;                   // Spectral rolloff (Hz)
     double zero_crossing_rate;                 // Zero crossing rate
-    double tempo;                              // Estimated tempo (BPM)
+    double tempo;                              // Tempo (BPM) from a TempoTracker; 0 for a lone frame
     std::chrono::high_resolution_clock::time_point timestamp;
     
-    AudioAnalysisResult() : fundamental_frequency(0.0), volume_level(0.0),
-                           spectral_centroid(0.0), spectral_rolloff(0.0),
-                           zero_crossing_rate(0.0), tempo(0.0),
-                           timestamp(std::chrono::high_resolution_clock::now()) {}
+    AudioFeatures() : fundamental_frequency(0.0), volume_level(0.0),
+                      spectral_centroid(0.0), spectral_rolloff(0.0),
+                      zero_crossing_rate(0.0), tempo(0.0),
+                      timestamp(std::chrono::high_resolution_clock::now()) {}
+};
+
+// Audio analysis results; spectra are stored in the analyzed sample type
+template<typename Real>
+struct BasicAudioAnalysisResult : AudioFeatures {
+    std::vector<Real> frequency_spectrum;      // FFT frequency spectrum
+    std::vector<Real> magnitude_spectrum;      // Magnitude spectrum
+    std::vector<Real> phase_spectrum;          // Phase spectrum
+};
+
+using AudioAnalysisResult = BasicAudioAnalysisResult<double>;
+using AudioAnalysisResultF = BasicAudioAnalysisResult<float>;
+
+// Long-term spectrum of a loaded file, averaged over all frames
+struct SpectralData {
+    std::vector<std::complex<double>> fft_data;  // Average magnitude with last-frame phase
+    std::vector<double> frequencies;             // Bin centre frequencies (Hz)
+    std::vector<double> magnitudes;              // Average magnitude spectrum
+    std::vector<double> phases;                  // Phase spectrum of the last frame
+    double dominant_frequency;                   // Dominant frequency (Hz)
+    double spectral_centroid;                    // Spectral centroid (Hz)
+    double spectral_rolloff;                     // Spectral rolloff (Hz)
+    double spectral_bandwidth;                   // Spectral bandwidth (Hz)
+    size_t frame_count;                          // Frames averaged
+    
+    SpectralData() : dominant_frequency(0.0), spectral_centroid(0.0),
+                     spectral_rolloff(0.0), spectral_bandwidth(0.0), frame_count(0) {}
+};
+
+// How analyzeChannels treats a multichannel buffer
+enum class ChannelAnalysis {
+    PER_CHANNEL,    // One result per channel
+    MID_SIDE        // Stereo: mid (L + R) / 2 and side (L - R) / 2; other counts: the mixdown only
+};
+
+// Features an analyzer computes per frame (AudioAnalyzer::setFeatures);
+// combine with |. Unrequested fields are left at zero or empty, and the
+// FFT is skipped when no requested feature needs it.
+namespace AnalysisFeature {
+enum : uint32_t {
+    VOLUME             = 1u << 0,   // volume_level
+    ZERO_CROSSINGS     = 1u << 1,   // zero_crossing_rate
+    SPECTRAL_SHAPE     = 1u << 2,   // magnitude_spectrum, centroid, rolloff, spectral-peak fundamental
+    PITCH              = 1u << 3,   // YIN fundamental_frequency
+    PHASE_SPECTRUM     = 1u << 4,   // phase_spectrum (one atan2 per bin)
+    FREQUENCY_SPECTRUM = 1u << 5,   // frequency_spectrum (bin centre frequencies)
+    TEMPO              = 1u << 6,   // tempo of overlapping frames; computes magnitude_spectrum
+    
+    SCALAR = VOLUME | ZERO_CROSSINGS | SPECTRAL_SHAPE | PITCH | TEMPO,
+    ALL    = SCALAR | PHASE_SPECTRUM | FREQUENCY_SPECTRUM
 };
+}
 
-// Audio analyzer class
+// Audio analyzer class.
+// Every analysis entry point exists for double and float samples. The float
+// path has its own plan, window and kernels, so it never converts to double;
+// the double path stays the reference for offline runs.
 class AudioAnalyzer {
+public:
+    // Work buffers for one frame; one per thread analyzing concurrently
+    template<typename Real>
+    struct BasicFrameScratch {
+        std::vector<Real> input;                        // Windowed real frame
+        std::vector<std::complex<Real>> spectrum;       // fft_size_ / 2 + 1 bins
+        std::vector<std::complex<Real>> correlation;    // fft_size_ points for the pitch detector
+        std::vector<Real> channel;                      // One channel gathered from a multichannel buffer
+    };
+    
+    using FrameScratch = BasicFrameScratch<double>;
+    using FrameScratchF = BasicFrameScratch<float>;
+    
 private:
+    // Plan, tables and scratch for one sample type
+    template<typename Real>
+    struct PrecisionState {
+        std::shared_ptr<const BasicFFTPlan<Real>> fft_plan;  // Shared by every analyzer of this size
+        BasicFrameScratch<Real> scratch;                     // Locked entry points; sized on first use
+        std::vector<Real> frequency_axis;                    // Bin centre frequencies
+        std::shared_ptr<const std::vector<Real>> window_function;  // Shared Hann window
+        const BasicSpectralKernelTable<Real>* kernels;       // Selected once for the running CPU
+    };
+    
     size_t fft_size_;
     size_t sample_rate_;
-    std::vector<std::complex<double>> fft_buffer_;
-    std::vector<double> window_function_;
+    PrecisionState<double> double_state_;
+    PrecisionState<float> float_state_;
     mutable std::mutex analysis_mutex_;
     
     // Analysis parameters
     double min_frequency_;
     double max_frequency_;
     size_t hop_size_;
+    std::atomic<uint32_t> features_;    // AnalysisFeature mask
+    
+    // Results of the last loadAudioFile
+    AudioInfo audio_info_;
+    AudioMetadata metadata_;
+    SpectralData spectral_data_;
+    std::shared_ptr<const FeatureTable> frame_features_;
+    std::string loaded_file_;
+    
+    FeatureCache* feature_cache_;       // Not owned; nullptr disables caching
+    std::shared_ptr<const ConstantQKernel> constant_q_kernel_;  // Last options used by analyzeConstantQ
     
 public:
     AudioAnalyzer(size_t fft_size = 1024, size_t sample_rate = 44100);
@@ -51,8 +149,91 @@ public:
     // Analyze audio buffer
     AudioAnalysisResult analyzeAudio(const std::vector<double>& audio_buffer);
     
-    // Analyze audio buffer with overlap
+    // Analyze audio buffer into a caller-owned result. The spectrum vectors of
+    // `reuse` keep their capacity, so repeated calls do no heap allocation.
+    void analyzeAudio(const double* samples, size_t sample_count, AudioAnalysisResult& reuse);
+    
+    // Single-precision counterparts of the two calls above
+    AudioAnalysisResultF analyzeAudio(const std::vector<float>& audio_buffer);
+    void analyzeAudio(const float* samples, size_t sample_count, AudioAnalysisResultF& reuse);
+    
+    // Lock-free variants with caller-owned scratch from makeFrameScratch; with
+    // a warmed-up `reuse` they neither lock nor allocate (real-time threads)
+    void analyzeAudio(const double* samples, size_t sample_count, AudioAnalysisResult& reuse,
+                      FrameScratch& scratch) const;
+    void analyzeAudio(const float* samples, size_t sample_count, AudioAnalysisResultF& reuse,
+                      FrameScratchF& scratch) const;
+    
+    // Analyze audio buffer with overlap; frames carry the running tempo of
+    // the frames up to them
     std::vector<AudioAnalysisResult> analyzeAudioWithOverlap(const std::vector<double>& audio_buffer);
+    std::vector<AudioAnalysisResultF> analyzeAudioWithOverlap(const std::vector<float>& audio_buffer);
+    
+    // Analyze audio buffer with overlap, splitting the frames across a pool.
+    // Each pool thread gets its own scratch; results are in frame order.
+    std::vector<AudioAnalysisResult> analyzeAudioWithOverlap(const std::vector<double>& audio_buffer,
+                                                             ThreadPool& pool);
+    std::vector<AudioAnalysisResultF> analyzeAudioWithOverlap(const std::vector<float>& audio_buffer,
+                                                              ThreadPool& pool);
+    
+    // Overlapped analysis of a whole track without blocking the caller: runs
+    // on options.pool (frames split across it as above), reports the share of
+    // frames done and stops between chunks of frames once cancelled. The
+    // buffer is moved into the job; the analyzer must outlive it.
+    AsyncResult<std::vector<AudioAnalysisResult>> analyzeAudioWithOverlapAsync(
+        std::vector<double> audio_buffer, const AsyncOptions& options = AsyncOptions());
+    AsyncResult<std::vector<AudioAnalysisResultF>> analyzeAudioWithOverlapAsync(
+        std::vector<float> audio_buffer, const AsyncOptions& options = AsyncOptions());
+    
+    // One frame per channel (the first fft_size_ frames of an interleaved or
+    // planar buffer) under a single lock with a single scratch; no per-channel
+    // copies of the buffer. `results` is resized and keeps its capacity.
+    void analyzeChannels(const AudioBuffer& buffer, std::vector<AudioAnalysisResult>& results,
+                         ChannelAnalysis mode = ChannelAnalysis::PER_CHANNEL);
+    void analyzeChannels(const AudioBufferF& buffer, std::vector<AudioAnalysisResultF>& results,
+                         ChannelAnalysis mode = ChannelAnalysis::PER_CHANNEL);
+    
+    // Channels split across a pool, one scratch per thread; for large domes
+    // the cost per channel stays flat as channels are added
+    void analyzeChannels(const AudioBuffer& buffer, std::vector<AudioAnalysisResult>& results,
+                         ThreadPool& pool, ChannelAnalysis mode = ChannelAnalysis::PER_CHANNEL);
+    void analyzeChannels(const AudioBufferF& buffer, std::vector<AudioAnalysisResultF>& results,
+                         ThreadPool& pool, ChannelAnalysis mode = ChannelAnalysis::PER_CHANNEL);
+    
+    // Constant-Q mode: log-frequency spectrum of the end of the buffer, one
+    // small FFT per octave of a recursively decimated signal. Resolves the
+    // lowest octaves (tens of Hz) independently of fft_size_; the lowest
+    // octave looks back ConstantQAnalyzer::getLatencySamples() samples. The
+    // kernel is kept for the next call with the same options.
+    ConstantQSpectrum analyzeConstantQ(const std::vector<double>& audio_buffer,
+                                       const ConstantQOptions& options = ConstantQOptions());
+    
+    // Scratch sized for this analyzer's FFT (instantiated for double and float)
+    template<typename Real = double>
+    BasicFrameScratch<Real> makeFrameScratch() const;
+    
+    // Stream a WAV or FLAC file through the analyzer in fixed-size blocks.
+    // Memory use is bounded by the FFT size, not by the file length.
+    // With a feature cache attached, a file analyzed before with the same FFT
+    // and hop size is read back from its cache entry instead; on a miss the
+    // per-frame features are kept (O(frames)) and written to the cache.
+    bool loadAudioFile(const std::string& filepath);
+    
+    // Cache for loadAudioFile (not owned; nullptr to detach). Must outlive
+    // the loads that use it.
+    void setFeatureCache(FeatureCache* cache) { feature_cache_ = cache; }
+    FeatureCache* getFeatureCache() const { return feature_cache_; }
+    
+    // Results of the last loaded file
+    const AudioInfo& getAudioInfo() const { return audio_info_; }
+    const AudioMetadata& getMetadata() const { return metadata_; }
+    const SpectralData& getSpectralData() const { return spectral_data_; }
+    // Per-frame features of the last loaded file; only kept with a feature
+    // cache attached (nullptr otherwise)
+    std::shared_ptr<const FeatureTable> getFrameFeatures() const { return frame_features_; }
+    
+    // Write a plain-text report of the last loaded file
+    bool exportAnalysisReport(const std::string& filepath) const;
     
     // Get frequency bin for a given frequency
     size_t getFrequencyBin(double frequency) const;
@@ -64,6 +245,11 @@ public:
     void setFrequencyRange(double min_freq, double max_freq);
     void setHopSize(size_t hop_size);
     
+    // Features computed by every analysis entry point (AnalysisFeature mask;
+    // ALL by default). Takes effect for frames that start after the call.
+    void setFeatures(uint32_t features) { features_.store(features, std::memory_order_relaxed); }
+    uint32_t getFeatures() const { return features_.load(std::memory_order_relaxed); }
+    
     // Get current parameters
     size_t getFFTSize() const { return fft_size_; }
     size_t getSampleRate() const { return sample_rate_; }
@@ -71,25 +257,63 @@ public:
     double getMaxFrequency() const { return max_frequency_; }
     
 private:
-    // FFT implementation (simple radix-2)
+    // Full-length complex FFT through the cached plan
     void performFFT(std::vector<std::complex<double>>& data);
     void performIFFT(std::vector<std::complex<double>>& data);
     
-    // Window function generation
-    void generateWindowFunction();
+    // (Re)build the FFT plan and work buffers for fft_size_
+    bool planFFT();
+    
+    // State for one sample type (specialized in the .cpp)
+    template<typename Real> PrecisionState<Real>& state();
+    template<typename Real> const PrecisionState<Real>& state() const;
+    // Scratch of the locked entry points (caller holds analysis_mutex_)
+    template<typename Real> BasicFrameScratch<Real>& lockedScratch();
+    
+    // Shared implementations of the double and float entry points
+    template<typename Real>
+    void analyzeLocked(const Real* samples, size_t sample_count, BasicAudioAnalysisResult<Real>& reuse);
+    template<typename Real>
+    std::vector<BasicAudioAnalysisResult<Real>> analyzeOverlapping(const std::vector<Real>& audio_buffer);
+    template<typename Real>
+    std::vector<BasicAudioAnalysisResult<Real>> analyzeOverlapping(const std::vector<Real>& audio_buffer,
+                                                                   ThreadPool& pool, AsyncControl* control = nullptr);
+    template<typename Real>
+    AsyncResult<std::vector<BasicAudioAnalysisResult<Real>>> analyzeOverlappingAsync(std::vector<Real> audio_buffer,
+                                                                                      const AsyncOptions& options);
+    template<typename Real>
+    void analyzeChannelBatch(const BasicAudioBuffer<Real>& buffer, std::vector<BasicAudioAnalysisResult<Real>>& results,
+                             ChannelAnalysis mode, ThreadPool* pool);
+    // Gather result `index` of a channel batch into `frame`; returns its length
+    template<typename Real>
+    size_t gatherChannel(const BasicAudioBuffer<Real>& buffer, size_t index, ChannelAnalysis mode, Real* frame) const;
+    // Fill the tempo of consecutive frames from their spectra
+    template<typename Real>
+    void trackTempo(std::vector<BasicAudioAnalysisResult<Real>>& results) const;
+    
+    // Lock-free frame analysis; reads only plan, window and axis
+    template<typename Real>
+    void analyzeFrame(const Real* samples, size_t sample_count,
+                      BasicAudioAnalysisResult<Real>& result, BasicFrameScratch<Real>& scratch) const;
     
     // Analysis helper methods
-    double calculateFundamentalFrequency(const std::vector<double>& magnitude_spectrum) const;
-    double calculateSpectralCentroid(const std::vector<double>& magnitude_spectrum) const;
-    double calculateSpectralRolloff(const std::vector<double>& magnitude_spectrum, double threshold = 0.85) const;
-    double calculateZeroCrossingRate(const std::vector<double>& audio_buffer) const;
-    double estimateTempo(const std::vector<double>& audio_buffer) const;
-    double calculateVolumeLevel(const std::vector<double>& audio_buffer) const;
+    // Fused pass: magnitude spectrum, fundamental, centroid and rolloff
+    template<typename Real>
+    void calculateSpectralFeatures(const std::vector<std::complex<Real>>& fft_result,
+                                   BasicAudioAnalysisResult<Real>& result, double rolloff_threshold = 0.85) const;
+    // YIN pitch (Hz) of the unwindowed frame; 0 when it is not periodic
+    template<typename Real>
+    double estimatePitch(const Real* samples, size_t sample_count, BasicFrameScratch<Real>& scratch) const;
+    template<typename Real>
+    double calculateZeroCrossingRate(const Real* samples, size_t sample_count) const;
+    template<typename Real>
+    double calculateVolumeLevel(const Real* samples, size_t sample_count) const;
     
     // Utility functions
-    void applyWindow(std::vector<double>& buffer) const;
-    std::vector<double> magnitudeSpectrum(const std::vector<std::complex<double>>& fft_result) const;
-    std::vector<double> phaseSpectrum(const std::vector<std::complex<double>>& fft_result) const;
+    template<typename Real>
+    void applyWindow(std::vector<Real>& buffer) const;
+    template<typename Real>
+    void phaseSpectrum(const std::vector<std::complex<Real>>& fft_result, std::vector<Real>& phase) const;
 };
 
 } // namespace AnantaSound
\ No newline at end of file
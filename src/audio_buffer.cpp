@@ -0,0 +1,92 @@
+#include "audio_buffer.hpp"
+#include <algorithm>
+
+namespace AnantaSound {
+
+template<typename Sample>
+BasicAudioBuffer<Sample>::BasicAudioBuffer(size_t channels, size_t frames, ChannelLayout layout)
+    : channels_(std::max<size_t>(1, channels))
+    , frames_(frames)
+    , layout_(layout) {
+    samples_.assign(channels_ * frames_, Sample(0));
+}
+
+template<typename Sample>
+BasicAudioBuffer<Sample>::BasicAudioBuffer(std::vector<Sample> samples, size_t channels, ChannelLayout layout)
+    : samples_(std::move(samples))
+    , channels_(std::max<size_t>(1, channels))
+    , frames_(samples_.size() / channels_)
+    , layout_(layout) {
+    // A trailing partial frame is dropped
+    samples_.resize(channels_ * frames_);
+}
+
+template<typename Sample>
+void BasicAudioBuffer<Sample>::resize(size_t channels, size_t frames) {
+    channels_ = std::max<size_t>(1, channels);
+    frames_ = frames;
+    samples_.assign(channels_ * frames_, Sample(0));
+}
+
+template<typename Sample>
+void BasicAudioBuffer<Sample>::setLayout(ChannelLayout layout) {
+    if (layout == layout_) {
+        return;
+    }
+    if (channels_ > 1) {
+        std::vector<Sample> reordered(samples_.size());
+        if (layout == ChannelLayout::PLANAR) {
+            deinterleave(samples_.data(), channels_, frames_, reordered.data());
+        } else {
+            interleave(samples_.data(), channels_, frames_, reordered.data());
+        }
+        samples_.swap(reordered);
+    }
+    layout_ = layout;
+}
+
+template<typename Sample>
+void BasicAudioBuffer<Sample>::mixdown(std::vector<Sample>& mono) const {
+    mono.assign(frames_, Sample(0));
+    const Sample scale = Sample(1) / static_cast<Sample>(channels_);
+    const size_t frame_stride = getFrameStride();
+    for (size_t c = 0; c < channels_; ++c) {
+        const Sample* source = channel(c);
+        for (size_t frame = 0; frame < frames_; ++frame) {
+            mono[frame] += source[frame * frame_stride];
+        }
+    }
+    for (Sample& sample : mono) {
+        sample *= scale;
+    }
+}
+
+template<typename Sample>
+void interleave(const Sample* planar, size_t channels, size_t frames, Sample* interleaved) {
+    for (size_t c = 0; c < channels; ++c) {
+        const Sample* source = planar + c * frames;
+        for (size_t frame = 0; frame < frames; ++frame) {
+            interleaved[frame * channels + c] = source[frame];
+        }
+    }
+}
+
+template<typename Sample>
+void deinterleave(const Sample* interleaved, size_t channels, size_t frames, Sample* planar) {
+    for (size_t c = 0; c < channels; ++c) {
+        Sample* target = planar + c * frames;
+        for (size_t frame = 0; frame < frames; ++frame) {
+            target[frame] = interleaved[frame * channels + c];
+        }
+    }
+}
+
+// Sample types used by the analyzer and the effects chain
+template class BasicAudioBuffer<double>;
+template class BasicAudioBuffer<float>;
+template void interleave<double>(const double*, size_t, size_t, double*);
+template void interleave<float>(const float*, size_t, size_t, float*);
+template void deinterleave<double>(const double*, size_t, size_t, double*);
+template void deinterleave<float>(const float*, size_t, size_t, float*);
+
+} // namespace AnantaSound
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace AnantaSound {
+
+// Sample order of a multichannel block
+enum class ChannelLayout {
+    INTERLEAVED,    // Frame-major: L R L R ... (device and file order)
+    PLANAR          // Channel-major: one contiguous run of frames per channel
+};
+
+// Multichannel block in one contiguous allocation, interleaved or planar.
+// Sample (frame, channel) lives at frame * getFrameStride() +
+// channel * getChannelStride(), so code that walks strides handles both
+// layouts without converting.
+template<typename Sample>
+class BasicAudioBuffer {
+private:
+    std::vector<Sample> samples_;
+    size_t channels_;
+    size_t frames_;
+    ChannelLayout layout_;
+
+public:
+    explicit BasicAudioBuffer(size_t channels = 1, size_t frames = 0,
+                              ChannelLayout layout = ChannelLayout::INTERLEAVED);
+
+    // Adopt samples already in `layout`; frames = samples.size() / channels
+    BasicAudioBuffer(std::vector<Sample> samples, size_t channels,
+                     ChannelLayout layout = ChannelLayout::INTERLEAVED);
+
+    // Resize to channels x frames (silence), keeping the layout
+    void resize(size_t channels, size_t frames);
+
+    // Reorder the samples in place; no-op when already in `layout`
+    void setLayout(ChannelLayout layout);
+
+    size_t getChannelCount() const { return channels_; }
+    size_t getFrameCount() const { return frames_; }
+    ChannelLayout getLayout() const { return layout_; }
+    bool isInterleaved() const { return layout_ == ChannelLayout::INTERLEAVED; }
+
+    size_t getFrameStride() const { return isInterleaved() ? channels_ : 1; }
+    size_t getChannelStride() const { return isInterleaved() ? 1 : frames_; }
+
+    Sample& at(size_t frame, size_t channel) {
+        return samples_[frame * getFrameStride() + channel * getChannelStride()];
+    }
+    const Sample& at(size_t frame, size_t channel) const {
+        return samples_[frame * getFrameStride() + channel * getChannelStride()];
+    }
+
+    // First sample of a channel; consecutive frames are getFrameStride() apart
+    Sample* channel(size_t channel) { return samples_.data() + channel * getChannelStride(); }
+    const Sample* channel(size_t channel) const { return samples_.data() + channel * getChannelStride(); }
+
+    Sample* data() { return samples_.data(); }
+    const Sample* data() const { return samples_.data(); }
+    size_t size() const { return samples_.size(); }
+    std::vector<Sample>& samples() { return samples_; }
+    const std::vector<Sample>& samples() const { return samples_; }
+
+    // Mean of all channels, frame by frame (reuses the capacity of `mono`)
+    void mixdown(std::vector<Sample>& mono) const;
+};
+
+// Layout conversion between caller-owned arrays of channels x frames
+template<typename Sample>
+void interleave(const Sample* planar, size_t channels, size_t frames, Sample* interleaved);
+template<typename Sample>
+void deinterleave(const Sample* interleaved, size_t channels, size_t frames, Sample* planar);
+
+// Instantiated in audio_buffer.cpp
+extern template class BasicAudioBuffer<double>;
+extern template class BasicAudioBuffer<float>;
+extern template void interleave<double>(const double*, size_t, size_t, double*);
+extern template void interleave<float>(const float*, size_t, size_t, float*);
+extern template void deinterleave<double>(const double*, size_t, size_t, double*);
+extern template void deinterleave<float>(const float*, size_t, size_t, float*);
+
+using AudioBuffer = BasicAudioBuffer<double>;
+using AudioBufferF = BasicAudioBuffer<float>;
+
+} // namespace AnantaSound
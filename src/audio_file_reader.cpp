@@ -0,0 +1,758 @@
+#include "audio_file_reader.hpp"
+#include "resampler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AnantaSound {
+
+namespace {
+
+constexpr uint16_t kWaveFormatPCM = 0x0001;
+constexpr uint16_t kWaveFormatFloat = 0x0003;
+constexpr uint16_t kWaveFormatExtensible = 0xFFFE;
+
+// Consumed WAV pages are dropped in steps of this size to keep RSS bounded
+constexpr size_t kReleaseStep = 4 * 1024 * 1024;
+
+inline uint16_t readLE16(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+inline uint32_t readLE32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) |
+           (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) |
+           (static_cast<uint32_t>(data[3]) << 24);
+}
+
+inline void writeLE16(std::ostream& out, uint16_t value) {
+    const char bytes[2] = {static_cast<char>(value & 0xFF), static_cast<char>(value >> 8)};
+    out.write(bytes, 2);
+}
+
+inline void writeLE32(std::ostream& out, uint32_t value) {
+    const char bytes[4] = {static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+                           static_cast<char>((value >> 16) & 0xFF), static_cast<char>(value >> 24)};
+    out.write(bytes, 4);
+}
+
+// Canonical 44-byte header of a 16-bit PCM WAV file
+void writeWAVHeader(std::ostream& out, int channels, int sample_rate, uint32_t data_bytes) {
+    const uint16_t block_align = static_cast<uint16_t>(channels * 2);
+    out.write("RIFF", 4);
+    writeLE32(out, 36 + data_bytes);
+    out.write("WAVEfmt ", 8);
+    writeLE32(out, 16);
+    writeLE16(out, kWaveFormatPCM);
+    writeLE16(out, static_cast<uint16_t>(channels));
+    writeLE32(out, static_cast<uint32_t>(sample_rate));
+    writeLE32(out, static_cast<uint32_t>(sample_rate) * block_align);
+    writeLE16(out, block_align);
+    writeLE16(out, 16);
+    out.write("data", 4);
+    writeLE32(out, data_bytes);
+}
+
+void writePCM16(std::ostream& out, const double* samples, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        double clamped = std::max(-1.0, std::min(1.0, samples[i]));
+        writeLE16(out, static_cast<uint16_t>(static_cast<int16_t>(std::lround(clamped * 32767.0))));
+    }
+}
+
+// Stream input to a 16-bit PCM WAV file, every sample multiplied by gain
+bool streamToWAV(AudioFileReader& reader, const std::string& output, double gain) {
+    const int channels = reader.getInfo().channels;
+    const int sample_rate = reader.getInfo().sample_rate;
+
+    std::ofstream out(output, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to create WAV file: " << output << std::endl;
+        return false;
+    }
+    writeWAVHeader(out, channels, sample_rate, 0);    // Sizes patched at the end
+
+    const size_t block_frames = 4096;
+    std::vector<double> block(block_frames * channels);
+    uint64_t written_samples = 0;
+    size_t frames;
+    while ((frames = reader.readInterleaved(block.data(), block_frames)) > 0) {
+        size_t samples = frames * channels;
+        for (size_t i = 0; i < samples; ++i) {
+            block[i] *= gain;
+        }
+        writePCM16(out, block.data(), samples);
+        written_samples += samples;
+    }
+
+    out.seekp(0);
+    writeWAVHeader(out, channels, sample_rate, static_cast<uint32_t>(written_samples * 2));
+    return static_cast<bool>(out);
+}
+
+// Sample decoders for the supported WAV encodings (little-endian)
+struct DecodeUnsigned8 {
+    double operator()(const uint8_t* p) const {
+        return (static_cast<int>(p[0]) - 128) / 128.0;
+    }
+};
+
+struct DecodeInt16 {
+    double operator()(const uint8_t* p) const {
+        return static_cast<int16_t>(readLE16(p)) / 32768.0;
+    }
+};
+
+struct DecodeInt24 {
+    double operator()(const uint8_t* p) const {
+        int32_t value = static_cast<int32_t>(p[0] | (p[1] << 8) | (p[2] << 16));
+        if (value & 0x800000) {
+            value -= 0x1000000;
+        }
+        return value / 8388608.0;
+    }
+};
+
+struct DecodeInt32 {
+    double operator()(const uint8_t* p) const {
+        return static_cast<int32_t>(readLE32(p)) / 2147483648.0;
+    }
+};
+
+struct DecodeFloat32 {
+    double operator()(const uint8_t* p) const {
+        float value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+};
+
+struct DecodeFloat64 {
+    double operator()(const uint8_t* p) const {
+        double value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+};
+
+template<typename Decoder, typename Sink>
+void convertFrames(const uint8_t* source, size_t frames, size_t channels,
+                   size_t bytes_per_sample, Sink& sink) {
+    Decoder decode;
+    for (size_t frame = 0; frame < frames; ++frame) {
+        for (size_t channel = 0; channel < channels; ++channel) {
+            sink(frame, channel, decode(source));
+            source += bytes_per_sample;
+        }
+    }
+}
+
+AudioFileFormat detectFormat(const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    char magic[4] = {0, 0, 0, 0};
+    if (!file.read(magic, 4)) {
+        return AudioFileFormat::UNKNOWN;
+    }
+
+    if (std::memcmp(magic, "RIFF", 4) == 0) {
+        return AudioFileFormat::WAV;
+    }
+    if (std::memcmp(magic, "fLaC", 4) == 0 || std::memcmp(magic, "ID3", 3) == 0) {
+        return AudioFileFormat::FLAC;
+    }
+    return AudioFileFormat::UNKNOWN;
+}
+
+} // namespace
+
+AudioFileReader::AudioFileReader()
+    : format_(AudioFileFormat::UNKNOWN)
+    , frame_position_(0)
+    , mapping_(nullptr)
+    , mapping_size_(0)
+    , wav_data_(nullptr)
+    , wav_frames_(0)
+    , wav_bytes_per_sample_(0)
+    , wav_float_(false)
+    , released_bytes_(0)
+    , flac_block_position_(0)
+    , flac_scale_(1.0) {
+}
+
+AudioFileReader::~AudioFileReader() {
+    close();
+}
+
+bool AudioFileReader::open(const std::string& filepath) {
+    close();
+
+    switch (detectFormat(filepath)) {
+        case AudioFileFormat::WAV:
+            return openWAV(filepath);
+        case AudioFileFormat::FLAC:
+            return openFLAC(filepath);
+        default:
+            std::cerr << "Unsupported or unreadable audio file: " << filepath << std::endl;
+            return false;
+    }
+}
+
+void AudioFileReader::close() {
+    unmap();
+    flac_decoder_.reset();
+    flac_block_position_ = 0;
+    flac_scale_ = 1.0;
+
+    format_ = AudioFileFormat::UNKNOWN;
+    info_ = AudioInfo();
+    metadata_ = AudioMetadata();
+    frame_position_ = 0;
+}
+
+bool AudioFileReader::openWAV(const std::string& filepath) {
+#if defined(_WIN32)
+    std::cerr << "Memory-mapped WAV reading is not available on this platform" << std::endl;
+    return false;
+#else
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open WAV file: " << filepath << std::endl;
+        return false;
+    }
+
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+        ::close(fd);
+        std::cerr << "Failed to stat WAV file: " << filepath << std::endl;
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(file_stat.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (address == MAP_FAILED) {
+        std::cerr << "Failed to map WAV file: " << filepath << std::endl;
+        return false;
+    }
+
+    // Pages are read once, front to back
+    ::madvise(address, size, MADV_SEQUENTIAL);
+
+    mapping_ = static_cast<const uint8_t*>(address);
+    mapping_size_ = size;
+
+    if (!parseWAVChunks()) {
+        std::cerr << "Invalid or unsupported WAV file: " << filepath << std::endl;
+        unmap();
+        return false;
+    }
+
+    format_ = AudioFileFormat::WAV;
+    return true;
+#endif
+}
+
+void AudioFileReader::unmap() {
+#if !defined(_WIN32)
+    if (mapping_ != nullptr) {
+        ::munmap(const_cast<uint8_t*>(mapping_), mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    wav_data_ = nullptr;
+    wav_frames_ = 0;
+    wav_bytes_per_sample_ = 0;
+    wav_float_ = false;
+    released_bytes_ = 0;
+}
+
+void AudioFileReader::releaseConsumedPages() {
+#if !defined(_WIN32)
+    size_t consumed = static_cast<size_t>(wav_data_ - mapping_) +
+                      static_cast<size_t>(frame_position_) * info_.channels * wav_bytes_per_sample_;
+    if (consumed < released_bytes_ + kReleaseStep) {
+        return;
+    }
+
+    // Read-only private mapping: dropped pages are re-read from the file if touched again
+    size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_t release_end = consumed / page_size * page_size;
+    ::madvise(const_cast<uint8_t*>(mapping_) + released_bytes_, release_end - released_bytes_, MADV_DONTNEED);
+    released_bytes_ = release_end;
+#endif
+}
+
+bool AudioFileReader::parseWAVChunks() {
+    if (mapping_size_ < 12 ||
+        std::memcmp(mapping_, "RIFF", 4) != 0 ||
+        std::memcmp(mapping_ + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    bool have_format = false;
+    uint16_t format_tag = 0;
+    uint16_t channels = 0;
+    uint32_t sample_rate = 0;
+    uint16_t block_align = 0;
+    uint16_t bits_per_sample = 0;
+
+    const uint8_t* data = nullptr;
+    size_t data_size = 0;
+
+    size_t offset = 12;
+    while (offset + 8 <= mapping_size_) {
+        const uint8_t* chunk_id = mapping_ + offset;
+        size_t chunk_size = readLE32(mapping_ + offset + 4);
+        size_t body = offset + 8;
+        size_t available = std::min(chunk_size, mapping_size_ - body);
+
+        if (std::memcmp(chunk_id, "fmt ", 4) == 0 && available >= 16) {
+            const uint8_t* fmt = mapping_ + body;
+            format_tag = readLE16(fmt);
+            channels = readLE16(fmt + 2);
+            sample_rate = readLE32(fmt + 4);
+            block_align = readLE16(fmt + 12);
+            bits_per_sample = readLE16(fmt + 14);
+
+            // WAVE_FORMAT_EXTENSIBLE: the sub-format GUID starts with the tag
+            if (format_tag == kWaveFormatExtensible && available >= 40) {
+                format_tag = readLE16(fmt + 24);
+            }
+            have_format = true;
+        } else if (std::memcmp(chunk_id, "data", 4) == 0) {
+            // Streaming writers may leave the size unset; clamp to the file
+            data = mapping_ + body;
+            data_size = available;
+        } else if (std::memcmp(chunk_id, "LIST", 4) == 0 && available >= 4 &&
+                   std::memcmp(mapping_ + body, "INFO", 4) == 0) {
+            parseWAVInfoList(mapping_ + body + 4, available - 4);
+        }
+
+        if (chunk_size > mapping_size_ - body) {
+            break;
+        }
+        offset = body + chunk_size + (chunk_size & 1);
+    }
+
+    if (!have_format || data == nullptr || channels == 0 || sample_rate == 0 ||
+        block_align == 0 || block_align % channels != 0) {
+        return false;
+    }
+
+    unsigned bytes_per_sample = block_align / channels;
+    bool is_float = format_tag == kWaveFormatFloat;
+
+    if (format_tag == kWaveFormatPCM) {
+        if (bytes_per_sample < 1 || bytes_per_sample > 4) {
+            return false;
+        }
+    } else if (is_float) {
+        if (bytes_per_sample != 4 && bytes_per_sample != 8) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+
+    wav_data_ = data;
+    wav_frames_ = data_size / block_align;
+    wav_bytes_per_sample_ = bytes_per_sample;
+    wav_float_ = is_float;
+
+    info_.format = "WAV";
+    info_.codec = is_float ? "IEEE float" : "PCM";
+    info_.sample_rate = static_cast<int>(sample_rate);
+    info_.channels = channels;
+    info_.bits_per_sample = bits_per_sample != 0 ? bits_per_sample : static_cast<int>(bytes_per_sample * 8);
+    info_.total_samples = static_cast<int64_t>(wav_frames_);
+    info_.duration_seconds = static_cast<double>(wav_frames_) / sample_rate;
+    return true;
+}
+
+void AudioFileReader::parseWAVInfoList(const uint8_t* data, size_t size) {
+    size_t offset = 0;
+
+    while (offset + 8 <= size) {
+        const char* id = reinterpret_cast<const char*>(data + offset);
+        size_t length = std::min<size_t>(readLE32(data + offset + 4), size - offset - 8);
+        const char* text = reinterpret_cast<const char*>(data + offset + 8);
+
+        // Values are NUL-terminated and padded to an even length
+        std::string value(text, strnlen(text, length));
+
+        if (std::memcmp(id, "INAM", 4) == 0) {
+            metadata_.title = value;
+        } else if (std::memcmp(id, "IART", 4) == 0) {
+            metadata_.artist = value;
+        } else if (std::memcmp(id, "IPRD", 4) == 0) {
+            metadata_.album = value;
+        } else if (std::memcmp(id, "IGNR", 4) == 0) {
+            metadata_.genre = value;
+        } else if (std::memcmp(id, "ICRD", 4) == 0) {
+            metadata_.year = std::atoi(value.c_str());
+        } else if (std::memcmp(id, "ITRK", 4) == 0 || std::memcmp(id, "IPRT", 4) == 0) {
+            metadata_.track_number = std::atoi(value.c_str());
+        } else if (std::memcmp(id, "ICMT", 4) == 0) {
+            metadata_.comment = value;
+        } else if (std::memcmp(id, "ICOP", 4) == 0) {
+            metadata_.copyright = value;
+        } else if (std::memcmp(id, "ISFT", 4) == 0) {
+            metadata_.software = value;
+        }
+
+        offset += 8 + length + (length & 1);
+    }
+}
+
+bool AudioFileReader::openFLAC(const std::string& filepath) {
+    flac_decoder_ = std::make_unique<FLACDecoder>();
+    if (!flac_decoder_->open(filepath)) {
+        flac_decoder_.reset();
+        return false;
+    }
+
+    const FLACStreamInfo& stream = flac_decoder_->getStreamInfo();
+    flac_scale_ = 1.0 / static_cast<double>(static_cast<uint64_t>(1) << (stream.bits_per_sample - 1));
+    flac_block_position_ = 0;
+
+    info_.format = "FLAC";
+    info_.codec = "FLAC";
+    info_.sample_rate = static_cast<int>(stream.sample_rate);
+    info_.channels = static_cast<int>(stream.channels);
+    info_.bits_per_sample = static_cast<int>(stream.bits_per_sample);
+    info_.total_samples = static_cast<int64_t>(stream.total_samples);
+    info_.duration_seconds = static_cast<double>(stream.total_samples) / stream.sample_rate;
+
+    applyVorbisComments(flac_decoder_->getVorbisComments());
+
+    format_ = AudioFileFormat::FLAC;
+    return true;
+}
+
+void AudioFileReader::applyVorbisComments(const std::vector<std::pair<std::string, std::string>>& comments) {
+    for (const auto& comment : comments) {
+        const std::string& key = comment.first;
+        const std::string& value = comment.second;
+
+        if (key == "TITLE") {
+            metadata_.title = value;
+        } else if (key == "ARTIST") {
+            metadata_.artist = value;
+        } else if (key == "ALBUM") {
+            metadata_.album = value;
+        } else if (key == "GENRE") {
+            metadata_.genre = value;
+        } else if (key == "DATE" || key == "YEAR") {
+            metadata_.year = std::atoi(value.c_str());
+        } else if (key == "TRACKNUMBER") {
+            metadata_.track_number = std::atoi(value.c_str());
+        } else if (key == "COMMENT" || key == "DESCRIPTION") {
+            metadata_.comment = value;
+        } else if (key == "COPYRIGHT") {
+            metadata_.copyright = value;
+        } else if (key == "ENCODER" || key == "ENCODED-BY") {
+            metadata_.software = value;
+        }
+    }
+}
+
+template<typename Sink>
+size_t AudioFileReader::readFrames(size_t max_frames, Sink&& sink) {
+    size_t channels = static_cast<size_t>(info_.channels);
+
+    if (format_ == AudioFileFormat::WAV) {
+        size_t frames = static_cast<size_t>(std::min<uint64_t>(max_frames, wav_frames_ - frame_position_));
+        const uint8_t* source = wav_data_ + frame_position_ * channels * wav_bytes_per_sample_;
+
+        // Encoding is resolved once per block, not per sample
+        if (wav_float_) {
+            if (wav_bytes_per_sample_ == 4) {
+                convertFrames<DecodeFloat32>(source, frames, channels, 4, sink);
+            } else {
+                convertFrames<DecodeFloat64>(source, frames, channels, 8, sink);
+            }
+        } else {
+            switch (wav_bytes_per_sample_) {
+                case 1: convertFrames<DecodeUnsigned8>(source, frames, channels, 1, sink); break;
+                case 2: convertFrames<DecodeInt16>(source, frames, channels, 2, sink); break;
+                case 3: convertFrames<DecodeInt24>(source, frames, channels, 3, sink); break;
+                default: convertFrames<DecodeInt32>(source, frames, channels, 4, sink); break;
+            }
+        }
+
+        frame_position_ += frames;
+        releaseConsumedPages();
+        return frames;
+    }
+
+    if (format_ == AudioFileFormat::FLAC) {
+        size_t written = 0;
+
+        while (written < max_frames) {
+            if (flac_block_position_ >= flac_decoder_->getBlockSize()) {
+                if (!flac_decoder_->decodeFrame()) {
+                    break;
+                }
+                flac_block_position_ = 0;
+            }
+
+            size_t count = std::min(max_frames - written,
+                                    flac_decoder_->getBlockSize() - flac_block_position_);
+            for (size_t channel = 0; channel < channels; ++channel) {
+                const int64_t* samples = flac_decoder_->getChannel(channel) + flac_block_position_;
+                for (size_t i = 0; i < count; ++i) {
+                    sink(written + i, channel, static_cast<double>(samples[i]) * flac_scale_);
+                }
+            }
+
+            flac_block_position_ += count;
+            written += count;
+        }
+
+        frame_position_ += written;
+        return written;
+    }
+
+    return 0;
+}
+
+size_t AudioFileReader::readMono(double* output, size_t max_frames) {
+    if (output == nullptr || !isOpen()) {
+        return 0;
+    }
+
+    std::fill(output, output + max_frames, 0.0);
+    const double gain = 1.0 / static_cast<double>(info_.channels);
+
+    return readFrames(max_frames, [output, gain](size_t frame, size_t, double value) {
+        output[frame] += value * gain;
+    });
+}
+
+size_t AudioFileReader::readInterleaved(double* output, size_t max_frames) {
+    if (output == nullptr || !isOpen()) {
+        return 0;
+    }
+
+    const size_t channels = static_cast<size_t>(info_.channels);
+
+    return readFrames(max_frames, [output, channels](size_t frame, size_t channel, double value) {
+        output[frame * channels + channel] = value;
+    });
+}
+
+bool AudioFileReader::rewind() {
+    if (format_ == AudioFileFormat::WAV) {
+        frame_position_ = 0;
+        released_bytes_ = 0;
+        return true;
+    }
+
+    if (format_ == AudioFileFormat::FLAC && flac_decoder_->rewind()) {
+        flac_block_position_ = 0;
+        frame_position_ = 0;
+        return true;
+    }
+
+    return false;
+}
+
+size_t AudioFileReader::getDecodeErrors() const {
+    return flac_decoder_ ? flac_decoder_->getCRCErrors() : 0;
+}
+
+namespace AudioUtils {
+
+bool validateFLACQuality(const std::string& filepath) {
+    FLACDecoder decoder;
+    if (!decoder.open(filepath)) {
+        return false;
+    }
+
+    uint64_t decoded_samples = 0;
+    while (decoder.decodeFrame()) {
+        decoded_samples += decoder.getBlockSize();
+    }
+
+    const FLACStreamInfo& stream = decoder.getStreamInfo();
+    bool complete = stream.total_samples == 0 || decoded_samples == stream.total_samples;
+
+    if (decoder.getCRCErrors() > 0) {
+        std::cerr << "FLAC validation: " << decoder.getCRCErrors()
+                  << " corrupt frame(s) in " << filepath << std::endl;
+    }
+    if (!complete) {
+        std::cerr << "FLAC validation: decoded " << decoded_samples << " of "
+                  << stream.total_samples << " samples in " << filepath << std::endl;
+    }
+
+    return decoder.getCRCErrors() == 0 && decoded_samples > 0 && complete;
+}
+
+std::string getFileInfo(const std::string& filepath) {
+    AudioFileReader reader;
+    if (!reader.open(filepath)) {
+        return "Unable to read audio file: " + filepath;
+    }
+
+    const AudioInfo& info = reader.getInfo();
+    const AudioMetadata& metadata = reader.getMetadata();
+
+    std::ostringstream out;
+    out << "Format: " << info.format << " (" << info.codec << ")\n";
+    out << "Sample Rate: " << info.sample_rate << " Hz\n";
+    out << "Channels: " << info.channels << "\n";
+    out << "Bits Per Sample: " << info.bits_per_sample << "\n";
+    out << "Duration: " << std::fixed << std::setprecision(2) << info.duration_seconds << " s\n";
+    out << "Total Samples: " << info.total_samples;
+
+    if (!metadata.title.empty()) out << "\nTitle: " << metadata.title;
+    if (!metadata.artist.empty()) out << "\nArtist: " << metadata.artist;
+    if (!metadata.album.empty()) out << "\nAlbum: " << metadata.album;
+    if (!metadata.genre.empty()) out << "\nGenre: " << metadata.genre;
+    if (metadata.year > 0) out << "\nYear: " << metadata.year;
+    if (metadata.track_number > 0) out << "\nTrack: " << metadata.track_number;
+
+    return out.str();
+}
+
+bool writeWAV(const std::string& filepath, const std::vector<double>& interleaved,
+              int channels, int sample_rate) {
+    if (channels <= 0 || sample_rate <= 0) {
+        std::cerr << "Invalid WAV format: " << channels << " channel(s) at "
+                  << sample_rate << " Hz" << std::endl;
+        return false;
+    }
+
+    std::ofstream out(filepath, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to create WAV file: " << filepath << std::endl;
+        return false;
+    }
+
+    writeWAVHeader(out, channels, sample_rate, static_cast<uint32_t>(interleaved.size() * 2));
+    writePCM16(out, interleaved.data(), interleaved.size());
+    return static_cast<bool>(out);
+}
+
+bool resampleAudio(const std::string& input, const std::string& output, int sample_rate) {
+    if (sample_rate <= 0) {
+        std::cerr << "Invalid target sample rate: " << sample_rate << std::endl;
+        return false;
+    }
+
+    AudioFileReader reader;
+    if (!reader.open(input)) {
+        return false;
+    }
+    const int channels = reader.getInfo().channels;
+    const int source_rate = reader.getInfo().sample_rate;
+
+    std::ofstream out(output, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to create WAV file: " << output << std::endl;
+        return false;
+    }
+    writeWAVHeader(out, channels, sample_rate, 0);    // Sizes patched at the end
+
+    // One resampler per channel; blocks are de-interleaved, resampled and re-interleaved
+    const size_t block_frames = 4096;
+    std::vector<PolyphaseResampler> resamplers(
+        channels, PolyphaseResampler(static_cast<size_t>(source_rate), static_cast<size_t>(sample_rate)));
+    std::vector<double> block(block_frames * channels);
+    std::vector<double> channel_input(block_frames);
+    std::vector<std::vector<double>> channel_output(channels);
+    std::vector<double> interleaved;
+    uint64_t written_samples = 0;
+
+    auto emit = [&]() {
+        size_t frames = channel_output[0].size();
+        interleaved.resize(frames * channels);
+        for (int c = 0; c < channels; ++c) {
+            for (size_t i = 0; i < frames; ++i) {
+                interleaved[i * channels + c] = channel_output[c][i];
+            }
+            channel_output[c].clear();
+        }
+        writePCM16(out, interleaved.data(), interleaved.size());
+        written_samples += interleaved.size();
+    };
+
+    size_t frames;
+    while ((frames = reader.readInterleaved(block.data(), block_frames)) > 0) {
+        for (int c = 0; c < channels; ++c) {
+            for (size_t i = 0; i < frames; ++i) {
+                channel_input[i] = block[i * channels + c];
+            }
+            resamplers[c].process(channel_input.data(), frames, channel_output[c]);
+        }
+        emit();
+    }
+    for (int c = 0; c < channels; ++c) {
+        resamplers[c].flush(channel_output[c]);
+    }
+    emit();
+
+    out.seekp(0);
+    writeWAVHeader(out, channels, sample_rate, static_cast<uint32_t>(written_samples * 2));
+    return static_cast<bool>(out);
+}
+
+bool convertFormat(const std::string& input, const std::string& output, const std::string& format) {
+    std::string extension = format;
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    if (extension != "wav" && extension != ".wav") {
+        std::cerr << "Unsupported output format: " << format << " (only WAV can be written)" << std::endl;
+        return false;
+    }
+
+    AudioFileReader reader;
+    if (!reader.open(input)) {
+        return false;
+    }
+    return streamToWAV(reader, output, 1.0);
+}
+
+bool normalizeAudio(const std::string& input, const std::string& output, double level_db) {
+    AudioFileReader reader;
+    if (!reader.open(input)) {
+        return false;
+    }
+
+    // First pass finds the peak, second pass writes the scaled samples
+    const int channels = reader.getInfo().channels;
+    const size_t block_frames = 4096;
+    std::vector<double> block(block_frames * channels);
+    double peak = 0.0;
+    size_t frames;
+    while ((frames = reader.readInterleaved(block.data(), block_frames)) > 0) {
+        for (size_t i = 0; i < frames * channels; ++i) {
+            peak = std::max(peak, std::abs(block[i]));
+        }
+    }
+    if (!reader.rewind()) {
+        return false;
+    }
+
+    double gain = peak > 0.0 ? std::pow(10.0, level_db / 20.0) / peak : 1.0;
+    return streamToWAV(reader, output, gain);
+}
+
+} // namespace AudioUtils
+
+} // namespace AnantaSound
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "flac_decoder.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace AnantaSound {
+
+// Tags read from the file (Vorbis comments for FLAC, LIST/INFO for WAV)
+struct AudioMetadata {
+    std::string title;      // Track title
+    std::string artist;     // Artist
+    std::string album;      // Album
+    std::string genre;      // Genre
+    int year;               // Release year
+    int track_number;       // Track number
+    std::string comment;    // Comment
+    std::string copyright;  // Copyright
+    std::string software;   // Encoding software
+
+    AudioMetadata() : year(0), track_number(0) {}
+};
+
+// Technical stream parameters
+struct AudioInfo {
+    int sample_rate;        // Sample rate (Hz)
+    int channels;           // Channel count
+    int bits_per_sample;    // Bit depth
+    double duration_seconds; // Duration (seconds)
+    int64_t total_samples;  // Samples per channel
+    std::string format;     // Container ("WAV", "FLAC")
+    std::string codec;      // Sample encoding
+
+    AudioInfo() : sample_rate(0), channels(0), bits_per_sample(0),
+                  duration_seconds(0.0), total_samples(0) {}
+};
+
+enum class AudioFileFormat {
+    UNKNOWN,
+    WAV,
+    FLAC
+};
+
+// Sequential reader for PCM WAV and FLAC files.
+// WAV data is memory-mapped and converted straight from the mapping; FLAC is
+// decoded one frame at a time. Callers pull fixed-size blocks, so memory use
+// is bounded by the block size rather than the file length.
+class AudioFileReader {
+private:
+    AudioFileFormat format_;
+    AudioInfo info_;
+    AudioMetadata metadata_;
+    uint64_t frame_position_;           // Frames (samples per channel) delivered so far
+
+    // WAV: mapped file and the location of the sample data
+    const uint8_t* mapping_;
+    size_t mapping_size_;
+    const uint8_t* wav_data_;
+    uint64_t wav_frames_;
+    unsigned wav_bytes_per_sample_;
+    bool wav_float_;
+    size_t released_bytes_;             // Mapping prefix already handed back to the OS
+
+    // FLAC: one decoded block at a time
+    std::unique_ptr<FLACDecoder> flac_decoder_;
+    size_t flac_block_position_;
+    double flac_scale_;
+
+public:
+    AudioFileReader();
+    ~AudioFileReader();
+
+    AudioFileReader(const AudioFileReader&) = delete;
+    AudioFileReader& operator=(const AudioFileReader&) = delete;
+
+    // Open a file; the format is detected from its contents
+    bool open(const std::string& filepath);
+    void close();
+    bool isOpen() const { return format_ != AudioFileFormat::UNKNOWN; }
+
+    // Read up to max_frames frames, each downmixed to one sample.
+    // Returns the number of frames written; 0 at end of stream.
+    size_t readMono(double* output, size_t max_frames);
+
+    // Read up to max_frames frames of interleaved samples (channels per frame)
+    size_t readInterleaved(double* output, size_t max_frames);
+
+    // Restart from the first frame
+    bool rewind();
+
+    AudioFileFormat getFormat() const { return format_; }
+    const AudioInfo& getInfo() const { return info_; }
+    const AudioMetadata& getMetadata() const { return metadata_; }
+    uint64_t getFramePosition() const { return frame_position_; }
+
+    // FLAC frames dropped on CRC mismatch (always 0 for WAV)
+    size_t getDecodeErrors() const;
+
+private:
+    bool openWAV(const std::string& filepath);
+    bool openFLAC(const std::string& filepath);
+    bool parseWAVChunks();
+    void parseWAVInfoList(const uint8_t* data, size_t size);
+    void applyVorbisComments(const std::vector<std::pair<std::string, std::string>>& comments);
+    void unmap();
+    void releaseConsumedPages();
+
+    // Decode up to max_frames frames into sink(frame, channel, value)
+    template<typename Sink>
+    size_t readFrames(size_t max_frames, Sink&& sink);
+};
+
+// File-level helpers built on AudioFileReader
+namespace AudioUtils {
+
+    // Decode every FLAC frame and check the stream for CRC errors and truncation
+    bool validateFLACQuality(const std::string& filepath);
+
+    // Human-readable summary of the format and tags of a file
+    std::string getFileInfo(const std::string& filepath);
+
+    // Write interleaved samples in [-1, 1] as a 16-bit PCM WAV file
+    bool writeWAV(const std::string& filepath, const std::vector<double>& interleaved,
+                  int channels, int sample_rate);
+
+    // Convert a WAV/FLAC file to sample_rate with the polyphase resampler.
+    // Streams block by block; the output is written as 16-bit PCM WAV.
+    bool resampleAudio(const std::string& input, const std::string& output, int sample_rate);
+
+    // Re-encode a WAV/FLAC file; only WAV output (16-bit PCM) can be written
+    bool convertFormat(const std::string& input, const std::string& output, const std::string& format);
+
+    // Scale a WAV/FLAC file so its peak reaches level_db dBFS; written as 16-bit PCM WAV
+    bool normalizeAudio(const std::string& input, const std::string& output, double level_db);
+
+} // namespace AudioUtils
+
+} // namespace AnantaSound
@@ -0,0 +1,418 @@
+#include "batch_analyzer.hpp"
+#include "audio_analyzer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace AnantaSound {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Blocking FIFO between two pipeline stages; capacity 0 means unbounded.
+// pop returns false once the queue is closed and drained.
+template<typename T>
+class StageQueue {
+private:
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<T> items_;
+    size_t capacity_;
+    bool closed_;
+
+public:
+    explicit StageQueue(size_t capacity) : capacity_(capacity), closed_(false) {}
+
+    void push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [&] { return capacity_ == 0 || items_.size() < capacity_ || closed_; });
+        items_.push_back(std::move(item));
+        not_empty_.notify_one();
+    }
+
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [&] { return !items_.empty() || closed_; });
+        if (items_.empty()) {
+            return false;
+        }
+        item = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+};
+
+// Running totals of one file; chunks of it may be analyzed concurrently
+struct FileJob {
+    BatchFileReport report;
+    std::mutex mutex;
+    uint64_t samples = 0;
+    double sum_of_squares = 0.0;
+    double volume_sum = 0.0;
+    double centroid_sum = 0.0;
+    double rolloff_sum = 0.0;
+    double zcr_sum = 0.0;
+    double fundamental_sum = 0.0;
+    std::vector<double> magnitude_sum;
+    std::atomic<size_t> pending{1};     // Chunks in flight, plus one held by the decoder
+};
+
+struct Chunk {
+    std::shared_ptr<FileJob> job;
+    std::vector<double> samples;
+    size_t count = 0;
+};
+
+std::string lowercase(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+    return text;
+}
+
+void finalize(FileJob& job, size_t fft_size) {
+    BatchFileReport& report = job.report;
+    report.ok = true;
+    if (job.samples > 0) {
+        report.rms = std::sqrt(job.sum_of_squares / static_cast<double>(job.samples));
+    }
+    if (report.frames_analyzed > 0) {
+        double frames = static_cast<double>(report.frames_analyzed);
+        report.volume_level = job.volume_sum / frames;
+        report.spectral_centroid = job.centroid_sum / frames;
+        report.spectral_rolloff = job.rolloff_sum / frames;
+        report.zero_crossing_rate = job.zcr_sum / frames;
+        report.fundamental_frequency = job.fundamental_sum / frames;
+    }
+    if (job.magnitude_sum.size() > 1) {
+        size_t peak = static_cast<size_t>(
+            std::max_element(job.magnitude_sum.begin() + 1, job.magnitude_sum.end()) - job.magnitude_sum.begin());
+        report.dominant_frequency = static_cast<double>(peak) * report.info.sample_rate / static_cast<double>(fft_size);
+    }
+}
+
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (char c : text) {
+        quoted += c;
+        if (c == '"') {
+            quoted += '"';
+        }
+    }
+    return quoted + "\"";
+}
+
+std::string jsonString(const std::string& text) {
+    std::ostringstream out;
+    out << '"';
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (c < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+} // namespace
+
+// BatchAnalyzer
+BatchAnalyzer::BatchAnalyzer(const BatchAnalysisOptions& options) : options_(options) {
+    options_.decoder_threads = std::max<size_t>(options_.decoder_threads, 1);
+    if (options_.analyzer_threads == 0) {
+        size_t hardware = std::thread::hardware_concurrency();
+        options_.analyzer_threads = hardware > options_.decoder_threads ? hardware - options_.decoder_threads : 1;
+    }
+    if (!BasicFFTPlan<double>::isValidSize(options_.fft_size)) {
+        options_.fft_size = 2048;
+    }
+    options_.chunk_frames = std::max(options_.chunk_frames / options_.fft_size, size_t(1)) * options_.fft_size;
+    if (options_.chunks_in_flight == 0) {
+        options_.chunks_in_flight = 4 * options_.analyzer_threads;
+    }
+    for (auto& extension : options_.extensions) {
+        extension = lowercase(extension);
+    }
+}
+
+BatchAnalysisSummary BatchAnalyzer::run(const std::string& directory, const ReportCallback& report) const {
+    BatchAnalysisSummary summary;
+    auto started = std::chrono::steady_clock::now();
+    std::error_code error;
+    if (!fs::is_directory(directory, error)) {
+        return summary;
+    }
+
+    const size_t fft_size = options_.fft_size;
+    StageQueue<std::string> paths(options_.chunks_in_flight);
+    StageQueue<std::unique_ptr<Chunk>> free_chunks(0);
+    StageQueue<std::unique_ptr<Chunk>> ready_chunks(0);
+    StageQueue<BatchFileReport> reports(0);
+    for (size_t i = 0; i < options_.chunks_in_flight; ++i) {
+        auto chunk = std::make_unique<Chunk>();
+        chunk->samples.resize(options_.chunk_frames);
+        free_chunks.push(std::move(chunk));
+    }
+
+    auto complete = [&](const std::shared_ptr<FileJob>& job) {
+        if (job->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            finalize(*job, fft_size);
+            reports.push(job->report);
+        }
+    };
+
+    std::thread walker([&]() {
+        auto matches = [&](const fs::directory_entry& entry) {
+            std::error_code status_error;
+            if (!entry.is_regular_file(status_error)) {
+                return false;
+            }
+            std::string extension = lowercase(entry.path().extension().string());
+            return std::find(options_.extensions.begin(), options_.extensions.end(), extension) !=
+                   options_.extensions.end();
+        };
+        std::error_code walk_error;
+        if (options_.recursive) {
+            fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, walk_error);
+            for (; !walk_error && it != fs::recursive_directory_iterator(); it.increment(walk_error)) {
+                if (matches(*it)) {
+                    paths.push(it->path().string());
+                }
+            }
+        } else {
+            fs::directory_iterator it(directory, walk_error);
+            for (; !walk_error && it != fs::directory_iterator(); it.increment(walk_error)) {
+                if (matches(*it)) {
+                    paths.push(it->path().string());
+                }
+            }
+        }
+        paths.close();
+    });
+
+    std::atomic<size_t> decoders_running{options_.decoder_threads};
+    std::vector<std::thread> decoders;
+    for (size_t d = 0; d < options_.decoder_threads; ++d) {
+        decoders.emplace_back([&]() {
+            std::string path;
+            while (paths.pop(path)) {
+                auto job = std::make_shared<FileJob>();
+                job->report.path = path;
+                AudioFileReader reader;
+                if (!reader.open(path)) {
+                    job->report.error = "unreadable or unsupported audio file";
+                    reports.push(job->report);
+                    continue;
+                }
+                job->report.info = reader.getInfo();
+
+                std::unique_ptr<Chunk> chunk;
+                while (free_chunks.pop(chunk)) {
+                    chunk->count = reader.readMono(chunk->samples.data(), chunk->samples.size());
+                    if (chunk->count == 0) {
+                        free_chunks.push(std::move(chunk));
+                        break;
+                    }
+                    chunk->job = job;
+                    job->pending.fetch_add(1, std::memory_order_relaxed);
+                    ready_chunks.push(std::move(chunk));
+                }
+                if (reader.getDecodeErrors() > 0) {
+                    std::lock_guard<std::mutex> lock(job->mutex);
+                    job->report.error = std::to_string(reader.getDecodeErrors()) + " corrupt frame(s) skipped";
+                }
+                complete(job);
+            }
+            if (decoders_running.fetch_sub(1) == 1) {
+                ready_chunks.close();
+            }
+        });
+    }
+
+    std::atomic<size_t> analyzers_running{options_.analyzer_threads};
+    std::vector<std::thread> analyzers;
+    for (size_t a = 0; a < options_.analyzer_threads; ++a) {
+        analyzers.emplace_back([&]() {
+            std::map<int, std::unique_ptr<AudioAnalyzer>> by_rate;
+            AudioAnalysisResult frame;
+            std::vector<double> magnitude_sum;
+            std::unique_ptr<Chunk> chunk;
+            while (ready_chunks.pop(chunk)) {
+                FileJob& job = *chunk->job;
+                int rate = job.report.info.sample_rate;
+                auto& analyzer = by_rate[rate];
+                if (!analyzer) {
+                    analyzer = std::make_unique<AudioAnalyzer>(fft_size, static_cast<size_t>(rate));
+                    analyzer->initialize();
+                }
+
+                const double* samples = chunk->samples.data();
+                double sum_of_squares = 0.0;
+                double peak = 0.0;
+                for (size_t i = 0; i < chunk->count; ++i) {
+                    sum_of_squares += samples[i] * samples[i];
+                    peak = std::max(peak, std::abs(samples[i]));
+                }
+                uint64_t frames = 0;
+                double volume = 0.0, centroid = 0.0, rolloff = 0.0, zcr = 0.0, fundamental = 0.0;
+                magnitude_sum.clear();
+                for (size_t offset = 0; offset + fft_size <= chunk->count; offset += fft_size) {
+                    analyzer->analyzeAudio(samples + offset, fft_size, frame);
+                    volume += frame.volume_level;
+                    centroid += frame.spectral_centroid;
+                    rolloff += frame.spectral_rolloff;
+                    zcr += frame.zero_crossing_rate;
+                    fundamental += frame.fundamental_frequency;
+                    magnitude_sum.resize(frame.magnitude_spectrum.size(), 0.0);
+                    for (size_t k = 0; k < magnitude_sum.size(); ++k) {
+                        magnitude_sum[k] += frame.magnitude_spectrum[k];
+                    }
+                    ++frames;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(job.mutex);
+                    job.samples += chunk->count;
+                    job.sum_of_squares += sum_of_squares;
+                    job.report.peak = std::max(job.report.peak, peak);
+                    job.report.frames_analyzed += frames;
+                    job.volume_sum += volume;
+                    job.centroid_sum += centroid;
+                    job.rolloff_sum += rolloff;
+                    job.zcr_sum += zcr;
+                    job.fundamental_sum += fundamental;
+                    job.magnitude_sum.resize(std::max(job.magnitude_sum.size(), magnitude_sum.size()), 0.0);
+                    for (size_t k = 0; k < magnitude_sum.size(); ++k) {
+                        job.magnitude_sum[k] += magnitude_sum[k];
+                    }
+                }
+
+                std::shared_ptr<FileJob> owner = std::move(chunk->job);
+                free_chunks.push(std::move(chunk));
+                complete(owner);
+            }
+            if (analyzers_running.fetch_sub(1) == 1) {
+                reports.close();
+            }
+        });
+    }
+
+    // Reports arrive here while the other stages keep working
+    BatchFileReport finished;
+    while (reports.pop(finished)) {
+        ++summary.files;
+        if (finished.ok) {
+            ++summary.succeeded;
+            summary.audio_seconds += finished.info.duration_seconds;
+        } else {
+            ++summary.failed;
+        }
+        if (report) {
+            report(finished);
+        }
+    }
+
+    walker.join();
+    for (auto& thread : decoders) {
+        thread.join();
+    }
+    for (auto& thread : analyzers) {
+        thread.join();
+    }
+    summary.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return summary;
+}
+
+// BatchReportWriter
+BatchReportWriter::BatchReportWriter() : json_(false), rows_(0) {
+}
+
+BatchReportWriter::~BatchReportWriter() {
+    close();
+}
+
+bool BatchReportWriter::open(const std::string& path) {
+    close();
+    json_ = lowercase(fs::path(path).extension().string()) == ".json";
+    rows_ = 0;
+    out_.open(path, std::ios::trunc);
+    if (!out_) {
+        std::cerr << "Failed to create batch report: " << path << std::endl;
+        return false;
+    }
+    out_ << std::setprecision(10);
+    if (json_) {
+        out_ << "[";
+    } else {
+        out_ << "path,ok,error,format,sample_rate,channels,duration_seconds,frames_analyzed,rms,peak,"
+                "volume_level,spectral_centroid,spectral_rolloff,zero_crossing_rate,fundamental_frequency,"
+                "dominant_frequency\n";
+    }
+    return true;
+}
+
+void BatchReportWriter::write(const BatchFileReport& report) {
+    if (!out_.is_open()) {
+        return;
+    }
+    const AudioInfo& info = report.info;
+    if (json_) {
+        out_ << (rows_ > 0 ? ",\n  {" : "\n  {")
+             << "\"path\": " << jsonString(report.path) << ", \"ok\": " << (report.ok ? "true" : "false")
+             << ", \"error\": " << jsonString(report.error) << ", \"format\": " << jsonString(info.format)
+             << ", \"sample_rate\": " << info.sample_rate << ", \"channels\": " << info.channels
+             << ", \"duration_seconds\": " << info.duration_seconds
+             << ", \"frames_analyzed\": " << report.frames_analyzed << ", \"rms\": " << report.rms
+             << ", \"peak\": " << report.peak << ", \"volume_level\": " << report.volume_level
+             << ", \"spectral_centroid\": " << report.spectral_centroid
+             << ", \"spectral_rolloff\": " << report.spectral_rolloff
+             << ", \"zero_crossing_rate\": " << report.zero_crossing_rate
+             << ", \"fundamental_frequency\": " << report.fundamental_frequency
+             << ", \"dominant_frequency\": " << report.dominant_frequency << "}";
+    } else {
+        out_ << csvField(report.path) << ',' << (report.ok ? 1 : 0) << ',' << csvField(report.error) << ','
+             << csvField(info.format) << ',' << info.sample_rate << ',' << info.channels << ','
+             << info.duration_seconds << ',' << report.frames_analyzed << ',' << report.rms << ','
+             << report.peak << ',' << report.volume_level << ',' << report.spectral_centroid << ','
+             << report.spectral_rolloff << ',' << report.zero_crossing_rate << ','
+             << report.fundamental_frequency << ',' << report.dominant_frequency << '\n';
+    }
+    ++rows_;
+}
+
+void BatchReportWriter::close() {
+    if (!out_.is_open()) {
+        return;
+    }
+    if (json_) {
+        out_ << (rows_ > 0 ? "\n]\n" : "]\n");
+    }
+    out_.close();
+}
+
+} // namespace AnantaSound
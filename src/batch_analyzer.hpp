@@ -0,0 +1,96 @@
+#pragma once
+
+#include "audio_file_reader.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace AnantaSound {
+
+struct BatchAnalysisOptions {
+    size_t decoder_threads = 2;         // Files decoded at once
+    size_t analyzer_threads = 0;        // 0: hardware_concurrency() - decoder_threads (at least 1)
+    size_t chunk_frames = 65536;        // Mono frames per decoded chunk (rounded to whole FFT frames)
+    size_t chunks_in_flight = 0;        // Decoded chunks buffered; 0: 4 per analyzer thread
+    size_t fft_size = 2048;
+    bool recursive = true;
+    std::vector<std::string> extensions = {".flac", ".wav"};   // Lowercase, with the dot
+};
+
+// Features of one file, averaged over its non-overlapping FFT frames
+struct BatchFileReport {
+    std::string path;
+    bool ok = false;
+    std::string error;
+    AudioInfo info;
+    uint64_t frames_analyzed = 0;
+    double rms = 0.0;
+    double peak = 0.0;
+    double volume_level = 0.0;
+    double spectral_centroid = 0.0;     // Hz
+    double spectral_rolloff = 0.0;      // Hz
+    double zero_crossing_rate = 0.0;
+    double fundamental_frequency = 0.0; // Hz
+    double dominant_frequency = 0.0;    // Peak of the long-term spectrum (Hz)
+};
+
+struct BatchAnalysisSummary {
+    size_t files = 0;
+    size_t succeeded = 0;
+    size_t failed = 0;
+    double audio_seconds = 0.0;         // Σ duration of the analyzed files
+    double elapsed_seconds = 0.0;
+};
+
+// Pipelined feature extraction over a directory tree.
+// A walker thread lists matching files into a bounded queue; decoder
+// threads stream each file through AudioFileReader into mono chunks taken
+// from a fixed pool of chunk buffers, so memory stays bounded however large
+// the files are and decoding stalls when the analyzers fall behind.
+// Analyzer threads take chunks of any file, analyze their FFT frames and
+// fold the sums into that file's totals; the chunk that completes a file
+// hands its report to the calling thread, which delivers reports in
+// completion order while the other stages keep running. Decoding of one
+// file overlaps with analysis of the files before it.
+class BatchAnalyzer {
+public:
+    using ReportCallback = std::function<void(const BatchFileReport&)>;
+
+private:
+    BatchAnalysisOptions options_;
+
+public:
+    explicit BatchAnalyzer(const BatchAnalysisOptions& options = BatchAnalysisOptions());
+
+    // Analyze every matching file under directory; report runs on the
+    // calling thread once per file
+    BatchAnalysisSummary run(const std::string& directory, const ReportCallback& report) const;
+
+    const BatchAnalysisOptions& getOptions() const { return options_; }
+};
+
+// Consolidated report of a batch run: CSV, or a JSON array when the path
+// ends in .json. Rows are written as they arrive.
+class BatchReportWriter {
+private:
+    std::ofstream out_;
+    bool json_;
+    size_t rows_;
+
+public:
+    BatchReportWriter();
+    ~BatchReportWriter();
+
+    bool open(const std::string& path);
+    void write(const BatchFileReport& report);
+    // Terminate the document (closes the JSON array)
+    void close();
+    bool isOpen() const { return out_.is_open(); }
+    size_t getRowCount() const { return rows_; }
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,149 @@
+#include "biquad_filter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace AnantaSound {
+
+namespace {
+
+// Shared terms of the RBJ shelf designs
+struct ShelfTerms {
+    double a;           // sqrt of the linear gain
+    double cos_w0;
+    double two_sqrt_a_alpha;
+};
+
+ShelfTerms shelfTerms(double sample_rate, double frequency, double gain_db, double slope) {
+    ShelfTerms terms;
+    terms.a = std::pow(10.0, gain_db / 40.0);
+
+    double w0 = 2.0 * M_PI * frequency / sample_rate;
+    terms.cos_w0 = std::cos(w0);
+
+    double alpha = std::sin(w0) / 2.0 *
+                   std::sqrt((terms.a + 1.0 / terms.a) * (1.0 / slope - 1.0) + 2.0);
+    terms.two_sqrt_a_alpha = 2.0 * std::sqrt(terms.a) * alpha;
+    return terms;
+}
+
+BiquadCoefficients normalize(double b0, double b1, double b2, double a0, double a1, double a2) {
+    BiquadCoefficients coefficients;
+    coefficients.b0 = b0 / a0;
+    coefficients.b1 = b1 / a0;
+    coefficients.b2 = b2 / a0;
+    coefficients.a1 = a1 / a0;
+    coefficients.a2 = a2 / a0;
+    return coefficients;
+}
+
+} // namespace
+
+BiquadCoefficients BiquadCoefficients::lowShelf(double sample_rate, double frequency, double gain_db, double slope) {
+    ShelfTerms t = shelfTerms(sample_rate, frequency, gain_db, slope);
+    const double a = t.a;
+
+    return normalize(a * ((a + 1.0) - (a - 1.0) * t.cos_w0 + t.two_sqrt_a_alpha),
+                     2.0 * a * ((a - 1.0) - (a + 1.0) * t.cos_w0),
+                     a * ((a + 1.0) - (a - 1.0) * t.cos_w0 - t.two_sqrt_a_alpha),
+                     (a + 1.0) + (a - 1.0) * t.cos_w0 + t.two_sqrt_a_alpha,
+                     -2.0 * ((a - 1.0) + (a + 1.0) * t.cos_w0),
+                     (a + 1.0) + (a - 1.0) * t.cos_w0 - t.two_sqrt_a_alpha);
+}
+
+BiquadCoefficients BiquadCoefficients::highShelf(double sample_rate, double frequency, double gain_db, double slope) {
+    ShelfTerms t = shelfTerms(sample_rate, frequency, gain_db, slope);
+    const double a = t.a;
+
+    return normalize(a * ((a + 1.0) + (a - 1.0) * t.cos_w0 + t.two_sqrt_a_alpha),
+                     -2.0 * a * ((a - 1.0) + (a + 1.0) * t.cos_w0),
+                     a * ((a + 1.0) + (a - 1.0) * t.cos_w0 - t.two_sqrt_a_alpha),
+                     (a + 1.0) - (a - 1.0) * t.cos_w0 + t.two_sqrt_a_alpha,
+                     2.0 * ((a - 1.0) - (a + 1.0) * t.cos_w0),
+                     (a + 1.0) - (a - 1.0) * t.cos_w0 - t.two_sqrt_a_alpha);
+}
+
+double BiquadCoefficients::magnitudeAt(double sample_rate, double frequency) const {
+    const std::complex<double> z1 = std::polar(1.0, -2.0 * M_PI * frequency / sample_rate);
+    const std::complex<double> z2 = z1 * z1;
+    return std::abs((b0 + b1 * z1 + b2 * z2) / (1.0 + a1 * z1 + a2 * z2));
+}
+
+template<typename Sample>
+BasicBiquadFilter<Sample>::BasicBiquadFilter(size_t channels)
+    : channels_(0)
+    , b0_(1), b1_(0), b2_(0), a1_(0), a2_(0) {
+    setChannelCount(channels);
+}
+
+template<typename Sample>
+void BasicBiquadFilter<Sample>::setCoefficients(const BiquadCoefficients& coefficients) {
+    b0_ = static_cast<Sample>(coefficients.b0);
+    b1_ = static_cast<Sample>(coefficients.b1);
+    b2_ = static_cast<Sample>(coefficients.b2);
+    a1_ = static_cast<Sample>(coefficients.a1);
+    a2_ = static_cast<Sample>(coefficients.a2);
+}
+
+template<typename Sample>
+void BasicBiquadFilter<Sample>::setChannelCount(size_t channels) {
+    channels_ = std::max<size_t>(1, channels);
+    z1_.assign(channels_, Sample(0));
+    z2_.assign(channels_, Sample(0));
+}
+
+template<typename Sample>
+void BasicBiquadFilter<Sample>::processInterleaved(Sample* samples, size_t frame_count) {
+    if (channels_ == 1) {
+        processBlock(samples, frame_count);
+        return;
+    }
+
+    const Sample b0 = b0_, b1 = b1_, b2 = b2_, a1 = a1_, a2 = a2_;
+    Sample* z1 = z1_.data();
+    Sample* z2 = z2_.data();
+    const size_t channels = channels_;
+
+    // Frames are serially dependent; channels are independent lanes
+    for (size_t frame = 0; frame < frame_count; ++frame) {
+        Sample* x = samples + frame * channels;
+        for (size_t c = 0; c < channels; ++c) {
+            Sample input = x[c];
+            Sample output = b0 * input + z1[c];
+            z1[c] = b1 * input - a1 * output + z2[c];
+            z2[c] = b2 * input - a2 * output;
+            x[c] = output;
+        }
+    }
+}
+
+template<typename Sample>
+void BasicBiquadFilter<Sample>::processBlock(Sample* samples, size_t count, size_t channel) {
+    // State in registers for the whole block
+    const Sample b0 = b0_, b1 = b1_, b2 = b2_, a1 = a1_, a2 = a2_;
+    Sample z1 = z1_[channel];
+    Sample z2 = z2_[channel];
+
+    for (size_t i = 0; i < count; ++i) {
+        Sample input = samples[i];
+        Sample output = b0 * input + z1;
+        z1 = b1 * input - a1 * output + z2;
+        z2 = b2 * input - a2 * output;
+        samples[i] = output;
+    }
+
+    z1_[channel] = z1;
+    z2_[channel] = z2;
+}
+
+template<typename Sample>
+void BasicBiquadFilter<Sample>::reset() {
+    std::fill(z1_.begin(), z1_.end(), Sample(0));
+    std::fill(z2_.begin(), z2_.end(), Sample(0));
+}
+
+// Sample types used by the effects chain
+template class BasicBiquadFilter<double>;
+template class BasicBiquadFilter<float>;
+
+} // namespace AnantaSound
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace AnantaSound {
+
+// Normalized biquad coefficients (a0 == 1), always designed in double
+struct BiquadCoefficients {
+    double b0, b1, b2;
+    double a1, a2;
+
+    BiquadCoefficients() : b0(1.0), b1(0.0), b2(0.0), a1(0.0), a2(0.0) {}
+
+    // RBJ cookbook shelves; slope 1.0 is the steepest monotonic shelf
+    static BiquadCoefficients lowShelf(double sample_rate, double frequency, double gain_db, double slope = 1.0);
+    static BiquadCoefficients highShelf(double sample_rate, double frequency, double gain_db, double slope = 1.0);
+
+    // Magnitude response |H(e^{jw})| at the given frequency
+    double magnitudeAt(double sample_rate, double frequency) const;
+
+    bool isIdentity() const { return b0 == 1.0 && b1 == 0.0 && b2 == 0.0 && a1 == 0.0 && a2 == 0.0; }
+};
+
+// Biquad in transposed direct form II with per-channel state.
+// State persists between calls, so a stream can be filtered in blocks of
+// any size. Interleaved processing runs the channel loop innermost over
+// contiguous state arrays, which the compiler vectorizes across channels.
+template<typename Sample>
+class BasicBiquadFilter {
+private:
+    size_t channels_;
+    Sample b0_, b1_, b2_, a1_, a2_;
+    std::vector<Sample> z1_;        // First state variable per channel
+    std::vector<Sample> z2_;        // Second state variable per channel
+
+public:
+    explicit BasicBiquadFilter(size_t channels = 1);
+
+    // New coefficients keep the current state (no click on parameter changes)
+    void setCoefficients(const BiquadCoefficients& coefficients);
+
+    // Resizes and clears the state
+    void setChannelCount(size_t channels);
+    size_t getChannelCount() const { return channels_; }
+
+    // Filter one sample of one channel
+    Sample processSample(Sample input, size_t channel = 0) {
+        Sample output = b0_ * input + z1_[channel];
+        z1_[channel] = b1_ * input - a1_ * output + z2_[channel];
+        z2_[channel] = b2_ * input - a2_ * output;
+        return output;
+    }
+
+    // Filter frame_count interleaved frames of getChannelCount() samples in place
+    void processInterleaved(Sample* samples, size_t frame_count);
+
+    // Filter a single-channel block in place
+    void processBlock(Sample* samples, size_t count, size_t channel = 0);
+
+    void reset();
+};
+
+// Instantiated in biquad_filter.cpp
+extern template class BasicBiquadFilter<double>;
+extern template class BasicBiquadFilter<float>;
+
+using BiquadFilter = BasicBiquadFilter<double>;
+using BiquadFilterF = BasicBiquadFilter<float>;
+
+} // namespace AnantaSound
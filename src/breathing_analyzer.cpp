@@ -1,58 +1,196 @@
 #include "breathing_analyzer.hpp"
+#include "instrumentation.hpp"
+#include "metrics.hpp"
 #include <algorithm>
 #include <cmath>
-#include <numeric>
 #include <iostream>
 
 namespace AnantaSound {
 
+namespace {
+
+// Результаты сравнений с порогами, по биту на сравнение
+constexpr unsigned kSlowRate = 1u << 0;      // rate < normal_min
+constexpr unsigned kRapidRate = 1u << 1;     // rate > rapid
+constexpr unsigned kFastRate = 1u << 2;      // rate > normal_max
+constexpr unsigned kDeep = 1u << 3;          // depth > deep
+constexpr unsigned kShallow = 1u << 4;       // depth < shallow
+constexpr unsigned kIrregular = 1u << 5;     // regularity < irregularity
+constexpr size_t kBreathingConditionCount = 1u << 6;
+
+// Каскад правил классификации для одного набора признаков
+constexpr BreathingState decideBreathingState(unsigned conditions) {
+    if (conditions & kSlowRate) {
+        return (conditions & kDeep) ? BreathingState::DEEP : BreathingState::HOLDING;
+    }
+    if (conditions & kRapidRate) {
+        return BreathingState::RAPID;
+    }
+    if (conditions & kFastRate) {
+        return (conditions & kShallow) ? BreathingState::SHALLOW : BreathingState::RAPID;
+    }
+    if (conditions & kIrregular) {
+        return BreathingState::IRREGULAR;
+    }
+    if (conditions & kDeep) {
+        return BreathingState::DEEP;
+    }
+    if (conditions & kShallow) {
+        return BreathingState::SHALLOW;
+    }
+    return BreathingState::NORMAL;
+}
+
+constexpr std::array<BreathingState, kBreathingConditionCount> buildBreathingStateTable() {
+    std::array<BreathingState, kBreathingConditionCount> table{};
+    for (unsigned conditions = 0; conditions < kBreathingConditionCount; ++conditions) {
+        table[conditions] = decideBreathingState(conditions);
+    }
+    return table;
+}
+
+// Каскад, развернутый в таблицу: классификация - шесть сравнений и одна выборка
+constexpr std::array<BreathingState, kBreathingConditionCount> kBreathingStateTable = buildBreathingStateTable();
+
+static_assert(kBreathingStateTable[kSlowRate | kDeep] == BreathingState::DEEP);
+static_assert(kBreathingStateTable[kFastRate | kShallow | kIrregular] == BreathingState::SHALLOW);
+static_assert(kBreathingStateTable[0] == BreathingState::NORMAL);
+
+} // namespace
+
 BreathingAnalyzer::BreathingAnalyzer(size_t fft_size, size_t sample_rate)
     : sample_rate_(sample_rate)
     , analysis_window_size_(fft_size)
     , min_breathing_frequency_(0.1)    // 0.1 Гц = 6 вдохов в минуту
     , max_breathing_frequency_(1.0)    // 1.0 Гц = 60 вдохов в минуту
-    , history_size_(20) {
-    
-    audio_analyzer_ = std::make_unique<AudioAnalyzer>(fft_size, sample_rate);
-    initializeDefaultThresholds();
+    , front_end_(sample_rate, kEnvelopeRate)
+    , envelope_next_(0)
+    , envelope_count_(0)
+    , envelope_total_(0)
+    , pending_estimate_(0)
+    , breathing_frequency_(0.0)
+    , rate_stats_(kHistorySize)
+    , stress_stats_(kHistorySize)
+    , relaxation_stats_(kHistorySize)
+    , history_next_(0)
+    , history_count_(0) {
+    
+    // Все буферы выделяются один раз: история огибающей фиксированной длины
+    size_t capacity = static_cast<size_t>(std::ceil(kAnalysisHorizon * front_end_.getOutputRate()));
+    envelope_.assign(std::max<size_t>(capacity, 1), 0.0);
+    window_.reserve(envelope_.size());
+    correlation_.reserve(envelope_.size());
+    state_counts_.fill(0);
+    pattern_counts_.fill(0);
 }
 
 bool BreathingAnalyzer::initialize() {
-    if (!audio_analyzer_) {
-        return false;
-    }
+    // Огибающая должна разрешать самую быструю частоту дыхания
+    return sample_rate_ > 0 && front_end_.getOutputRate() > 2.0 * max_breathing_frequency_;
+}
+
+void BreathingAnalyzer::resetStream() {
+    ANANTASOUND_LOCK_GUARD(lock, analyzer_mutex_, "BreathingAnalyzer::analyzer_mutex_");
+    front_end_.reset();
+    
+    // envelope_total_ продолжает счет, поэтому прежние окна циклов недействительны
+    envelope_next_ = 0;
+    envelope_count_ = 0;
+    pending_estimate_ = 0;
+    breathing_frequency_ = 0.0;
+}
+
+BreathingAnalysisResult BreathingAnalyzer::analyzeBreathing(const std::vector<double>& audio_buffer) {
+    return analyzeBreathing(audio_buffer.data(), audio_buffer.size());
+}
+
+BreathingAnalysisResult BreathingAnalyzer::analyzeBreathing(const double* samples, size_t sample_count) {
+    return analyzeSamples(samples, sample_count);
+}
+
+BreathingAnalysisResult BreathingAnalyzer::analyzeBreathing(const std::vector<float>& audio_buffer) {
+    return analyzeBreathing(audio_buffer.data(), audio_buffer.size());
+}
+
+BreathingAnalysisResult BreathingAnalyzer::analyzeBreathing(const float* samples, size_t sample_count) {
+    return analyzeSamples(samples, sample_count);
+}
+
+BreathingAnalysisResult BreathingAnalyzer::analyzeBreathing(const AudioBuffer& buffer) {
+    return analyzeFrames(buffer);
+}
+
+BreathingAnalysisResult BreathingAnalyzer::analyzeBreathing(const AudioBufferF& buffer) {
+    return analyzeFrames(buffer);
+}
+
+template<typename Sample>
+BreathingAnalysisResult BreathingAnalyzer::analyzeSamples(const Sample* samples, size_t sample_count) {
+    ANANTASOUND_STAGE_TIMER("breathing.analyze");
+    ANANTASOUND_LOCK_GUARD(lock, analyzer_mutex_, "BreathingAnalyzer::analyzer_mutex_");
     
-    // Настройка анализатора для дыхательных частот
-    audio_analyzer_->setFrequencyRange(min_breathing_frequency_, max_breathing_frequency_);
+    if (samples == nullptr || sample_count == 0) {
+        return BreathingAnalysisResult();
+    }
+    ANANTASOUND_COUNT("processed_samples", "breathing", sample_count);
+    ANANTASOUND_COUNT("processed_blocks", "breathing", 1);
     
-    return audio_analyzer_->initialize();
+    block_envelope_.clear();
+    front_end_.process(samples, sample_count, block_envelope_);
+    return analyzeBlockEnvelope();
 }
 
-BreathingAnalysisResult BreathingAnalyzer::analyzeBreathing(const std::vector<double>& audio_buffer) {
-    std::lock_guard<std::mutex> lock(analyzer_mutex_);
+template<typename Sample>
+BreathingAnalysisResult BreathingAnalyzer::analyzeFrames(const BasicAudioBuffer<Sample>& buffer) {
+    ANANTASOUND_STAGE_TIMER("breathing.analyze");
+    ANANTASOUND_LOCK_GUARD(lock, analyzer_mutex_, "BreathingAnalyzer::analyzer_mutex_");
     
+    if (buffer.getFrameCount() == 0) {
+        return BreathingAnalysisResult();
+    }
+    ANANTASOUND_COUNT("processed_samples", "breathing", buffer.getFrameCount());
+    ANANTASOUND_COUNT("processed_blocks", "breathing", 1);
+    
+    block_envelope_.clear();
+    front_end_.process(buffer, block_envelope_);
+    return analyzeBlockEnvelope();
+}
+
+BreathingAnalysisResult BreathingAnalyzer::analyzeBlockEnvelope() {
     BreathingAnalysisResult result;
+    syncThresholds();
     
-    if (audio_buffer.empty() || !audio_analyzer_) {
-        return result;
+    // Огибающая блока дописывается в кольцевую историю
+    for (double value : block_envelope_) {
+        envelope_[envelope_next_] = value;
+        envelope_next_ = (envelope_next_ + 1) % envelope_.size();
+        envelope_count_ = std::min(envelope_count_ + 1, envelope_.size());
     }
+    envelope_total_ += block_envelope_.size();
     
-    // Фильтрация дыхательных частот
-    std::vector<double> filtered_audio = filterBreathingFrequencies(audio_buffer);
+    // Автокорреляция пересчитывается не чаще раза в kEstimateInterval
+    const double envelope_rate = front_end_.getOutputRate();
+    pending_estimate_ += block_envelope_.size();
+    if (pending_estimate_ >= static_cast<size_t>(kEstimateInterval * envelope_rate)) {
+        breathing_frequency_ = estimateBreathingFrequency();
+        pending_estimate_ = 0;
+    }
     
-    // Анализ аудио
-    AudioAnalysisResult audio_analysis = audio_analyzer_->analyzeAudio(filtered_audio);
+    // Пока нет двух периодов самого быстрого дыхания, классифицировать нечего
+    if (static_cast<double>(envelope_count_) < 2.0 * envelope_rate / max_breathing_frequency_) {
+        return result;
+    }
     
     // Расчет основных параметров дыхания
-    result.breathing_rate = calculateBreathingRate(audio_analysis);
-    result.breathing_depth = calculateBreathingDepth(audio_analysis);
-    result.breathing_regularity = calculateBreathingRegularity(breathing_rate_history_);
+    result.breathing_rate = breathing_frequency_ * 60.0;
+    result.breathing_depth = calculateBreathingDepth();
+    result.breathing_regularity = calculateBreathingRegularity(rate_stats_);
     
     // Классификация состояния и паттерна
     result.current_state = classifyBreathingState(result.breathing_rate, 
                                                  result.breathing_depth, 
                                                  result.breathing_regularity);
-    result.pattern = classifyBreathingPattern(breathing_rate_history_);
+    result.pattern = classifyBreathingPattern(rate_stats_);
     
     // Расчет уровней стресса и расслабления
     result.stress_level = calculateStressLevel(result.breathing_rate, 
@@ -63,7 +201,7 @@ BreathingAnalysisResult BreathingAnalyzer::analyzeBreathing(const std::vector<do
                                                       result.breathing_regularity);
     
     // Извлечение дыхательного цикла
-    result.breathing_cycle = extractBreathingCycle(filtered_audio);
+    result.breathing_cycle = extractBreathingCycle();
     
     result.timestamp = std::chrono::high_resolution_clock::now();
     
@@ -74,6 +212,15 @@ BreathingAnalysisResult BreathingAnalyzer::analyzeBreathing(const std::vector<do
 }
 
 std::vector<BreathingAnalysisResult> BreathingAnalyzer::analyzeBreathingWithOverlap(const std::vector<double>& audio_buffer) {
+    return analyzeOverlapping(audio_buffer);
+}
+
+std::vector<BreathingAnalysisResult> BreathingAnalyzer::analyzeBreathingWithOverlap(const std::vector<float>& audio_buffer) {
+    return analyzeOverlapping(audio_buffer);
+}
+
+template<typename Sample>
+std::vector<BreathingAnalysisResult> BreathingAnalyzer::analyzeOverlapping(const std::vector<Sample>& audio_buffer) {
     std::vector<BreathingAnalysisResult> results;
     
     if (audio_buffer.size() < analysis_window_size_) {
@@ -81,181 +228,147 @@ std::vector<BreathingAnalysisResult> BreathingAnalyzer::analyzeBreathingWithOver
         return results;
     }
     
-    // Анализ с перекрытием окон
-    size_t hop_size = analysis_window_size_ / 4;
-    for (size_t start = 0; start + analysis_window_size_ <= audio_buffer.size(); start += hop_size) {
-        std::vector<double> window_buffer(audio_buffer.begin() + start, 
-                                        audio_buffer.begin() + start + analysis_window_size_);
-        results.push_back(analyzeBreathing(window_buffer));
+    // Анализ с перекрытием окон: поток получает каждый отсчет один раз,
+    // после первого окна - по одному шагу на результат
+    size_t hop_size = std::max<size_t>(analysis_window_size_ / 4, 1);
+    results.reserve((audio_buffer.size() - analysis_window_size_) / hop_size + 1);
+    results.push_back(analyzeBreathing(audio_buffer.data(), analysis_window_size_));
+    for (size_t start = hop_size; start + analysis_window_size_ <= audio_buffer.size(); start += hop_size) {
+        results.push_back(analyzeBreathing(audio_buffer.data() + start + analysis_window_size_ - hop_size,
+                                           hop_size));
     }
     
     return results;
 }
 
 BreathingState BreathingAnalyzer::getCurrentBreathingState() const {
-    std::lock_guard<std::mutex> lock(analyzer_mutex_);
+    ANANTASOUND_LOCK_GUARD(lock, analyzer_mutex_, "BreathingAnalyzer::analyzer_mutex_");
     
-    if (analysis_history_.empty()) {
+    if (history_count_ == 0) {
         return BreathingState::UNKNOWN;
     }
     
-    return analysis_history_.back().current_state;
+    return state_history_[(history_next_ + kHistorySize - 1) % kHistorySize];
 }
 
 BreathingPattern BreathingAnalyzer::getBreathingPattern() const {
-    std::lock_guard<std::mutex> lock(analyzer_mutex_);
+    ANANTASOUND_LOCK_GUARD(lock, analyzer_mutex_, "BreathingAnalyzer::analyzer_mutex_");
     
-    if (analysis_history_.empty()) {
+    if (history_count_ == 0) {
         return BreathingPattern::UNKNOWN;
     }
     
-    return analysis_history_.back().pattern;
+    return pattern_history_[(history_next_ + kHistorySize - 1) % kHistorySize];
 }
 
 double BreathingAnalyzer::getAverageBreathingRate() const {
-    std::lock_guard<std::mutex> lock(analyzer_mutex_);
-    
-    if (breathing_rate_history_.empty()) {
-        return 0.0;
-    }
-    
-    double sum = std::accumulate(breathing_rate_history_.begin(), breathing_rate_history_.end(), 0.0);
-    return sum / breathing_rate_history_.size();
+    ANANTASOUND_LOCK_GUARD(lock, analyzer_mutex_, "BreathingAnalyzer::analyzer_mutex_");
+    return rate_stats_.mean();
 }
 
 double BreathingAnalyzer::getStressLevel() const {
-    std::lock_guard<std::mutex> lock(analyzer_mutex_);
-    
-    if (analysis_history_.empty()) {
-        return 0.0;
-    }
-    
-    return analysis_history_.back().stress_level;
+    ANANTASOUND_LOCK_GUARD(lock, analyzer_mutex_, "BreathingAnalyzer::analyzer_mutex_");
+    return stress_stats_.empty() ? 0.0 : stress_stats_.back();
 }
 
 double BreathingAnalyzer::getRelaxationLevel() const {
-    std::lock_guard<std::mutex> lock(analyzer_mutex_);
-    
-    if (analysis_history_.empty()) {
-        return 0.0;
-    }
-    
-    return analysis_history_.back().relaxation_level;
+    ANANTASOUND_LOCK_GUARD(lock, analyzer_mutex_, "BreathingAnalyzer::analyzer_mutex_");
+    return relaxation_stats_.empty() ? 0.0 : relaxation_stats_.back();
+}
+
+template<typename Update>
+void BreathingAnalyzer::updateThresholds(Update update) {
+    ANANTASOUND_LOCK_GUARD(lock, threshold_mutex_, "BreathingAnalyzer::threshold_mutex_");
+    update(published_thresholds_);
+    threshold_mailbox_.publish(published_thresholds_);
 }
 
 void BreathingAnalyzer::setBreathingRateThresholds(double min_normal, double max_normal) {
-    std::lock_guard<std::mutex> lock(analyzer_mutex_);
-    normal_breathing_rate_min_ = min_normal;
-    normal_breathing_rate_max_ = max_normal;
+    updateThresholds([&](BreathingThresholds& thresholds) {
+        thresholds.normal_rate_min = min_normal;
+        thresholds.normal_rate_max = max_normal;
+    });
 }
 
 void BreathingAnalyzer::setDepthThresholds(double deep_threshold, double shallow_threshold) {
-    std::lock_guard<std::mutex> lock(analyzer_mutex_);
-    deep_breathing_threshold_ = deep_threshold;
-    shallow_breathing_threshold_ = shallow_threshold;
+    updateThresholds([&](BreathingThresholds& thresholds) {
+        thresholds.deep_depth = deep_threshold;
+        thresholds.shallow_depth = shallow_threshold;
+    });
 }
 
 void BreathingAnalyzer::setRapidBreathingThreshold(double threshold) {
-    std::lock_guard<std::mutex> lock(analyzer_mutex_);
-    rapid_breathing_threshold_ = threshold;
+    updateThresholds([&](BreathingThresholds& thresholds) { thresholds.rapid_rate = threshold; });
 }
 
 void BreathingAnalyzer::setIrregularityThreshold(double threshold) {
-    std::lock_guard<std::mutex> lock(analyzer_mutex_);
-    irregularity_threshold_ = threshold;
+    updateThresholds([&](BreathingThresholds& thresholds) { thresholds.irregularity = threshold; });
+}
+
+void BreathingAnalyzer::setThresholds(const BreathingThresholds& thresholds) {
+    updateThresholds([&](BreathingThresholds& published) { published = thresholds; });
+}
+
+BreathingThresholds BreathingAnalyzer::getThresholds() const {
+    ANANTASOUND_LOCK_GUARD(lock, threshold_mutex_, "BreathingAnalyzer::threshold_mutex_");
+    return published_thresholds_;
 }
 
 BreathingAnalyzer::BreathingStatistics BreathingAnalyzer::getStatistics() const {
-    std::lock_guard<std::mutex> lock(analyzer_mutex_);
+    ANANTASOUND_LOCK_GUARD(lock, analyzer_mutex_, "BreathingAnalyzer::analyzer_mutex_");
     
-    BreathingStatistics stats;
+    BreathingStatistics stats{};
+    stats.most_common_state = BreathingState::UNKNOWN;
+    stats.most_common_pattern = BreathingPattern::UNKNOWN;
     
-    if (analysis_history_.empty()) {
+    if (history_count_ == 0) {
         return stats;
     }
     
-    // Средняя частота дыхания
-    stats.average_breathing_rate = getAverageBreathingRate();
-    
-    // Средний уровень стресса
-    double stress_sum = 0.0;
-    double relaxation_sum = 0.0;
-    std::map<BreathingState, int> state_counts;
-    std::map<BreathingPattern, int> pattern_counts;
-    
-    for (const auto& result : analysis_history_) {
-        stress_sum += result.stress_level;
-        relaxation_sum += result.relaxation_level;
-        state_counts[result.current_state]++;
-        pattern_counts[result.pattern]++;
-    }
-    
-    stats.average_stress_level = stress_sum / analysis_history_.size();
-    stats.average_relaxation_level = relaxation_sum / analysis_history_.size();
-    
-    // Наиболее частое состояние
-    auto max_state = std::max_element(state_counts.begin(), state_counts.end(),
-        [](const auto& a, const auto& b) { return a.second < b.second; });
-    stats.most_common_state = max_state->first;
+    // Средние по окну - из накопителей
+    stats.average_breathing_rate = rate_stats_.mean();
+    stats.average_stress_level = stress_stats_.mean();
+    stats.average_relaxation_level = relaxation_stats_.mean();
     
-    // Наиболее частый паттерн
-    auto max_pattern = std::max_element(pattern_counts.begin(), pattern_counts.end(),
-        [](const auto& a, const auto& b) { return a.second < b.second; });
-    stats.most_common_pattern = max_pattern->first;
+    // Наиболее частые состояние и паттерн (при равенстве - первые по порядку)
+    auto max_state = std::max_element(state_counts_.begin(), state_counts_.end());
+    stats.most_common_state = static_cast<BreathingState>(max_state - state_counts_.begin());
+    auto max_pattern = std::max_element(pattern_counts_.begin(), pattern_counts_.end());
+    stats.most_common_pattern = static_cast<BreathingPattern>(max_pattern - pattern_counts_.begin());
     
-    stats.total_analyses = analysis_history_.size();
+    stats.total_analyses = history_count_;
     
     return stats;
 }
 
 BreathingState BreathingAnalyzer::classifyBreathingState(double rate, double depth, double regularity) const {
-    // Классификация по частоте дыхания
-    if (rate < normal_breathing_rate_min_) {
-        if (depth > deep_breathing_threshold_) {
-            return BreathingState::DEEP;
-        } else {
-            return BreathingState::HOLDING;
-        }
-    } else if (rate > rapid_breathing_threshold_) {
-        return BreathingState::RAPID;
-    } else if (rate > normal_breathing_rate_max_) {
-        if (depth < shallow_breathing_threshold_) {
-            return BreathingState::SHALLOW;
-        } else {
-            return BreathingState::RAPID;
-        }
-    }
-    
-    // Классификация по регулярности
-    if (regularity < irregularity_threshold_) {
-        return BreathingState::IRREGULAR;
-    }
-    
-    // Классификация по глубине
-    if (depth > deep_breathing_threshold_) {
-        return BreathingState::DEEP;
-    } else if (depth < shallow_breathing_threshold_) {
-        return BreathingState::SHALLOW;
+    unsigned conditions = (rate < thresholds_.normal_rate_min ? kSlowRate : 0u) |
+                          (rate > thresholds_.rapid_rate ? kRapidRate : 0u) |
+                          (rate > thresholds_.normal_rate_max ? kFastRate : 0u) |
+                          (depth > thresholds_.deep_depth ? kDeep : 0u) |
+                          (depth < thresholds_.shallow_depth ? kShallow : 0u) |
+                          (regularity < thresholds_.irregularity ? kIrregular : 0u);
+    return kBreathingStateTable[conditions];
+}
+
+void BreathingAnalyzer::classifyBreathingStates(const double* rates, const double* depths,
+                                                const double* regularities, size_t count,
+                                                BreathingState* states) const {
+    ANANTASOUND_LOCK_GUARD(lock, analyzer_mutex_, "BreathingAnalyzer::analyzer_mutex_");
+    syncThresholds();
+    for (size_t i = 0; i < count; ++i) {
+        states[i] = classifyBreathingState(rates[i], depths[i], regularities[i]);
     }
-    
-    return BreathingState::NORMAL;
 }
 
-BreathingPattern BreathingAnalyzer::classifyBreathingPattern(const std::vector<double>& rate_history) const {
+BreathingPattern BreathingAnalyzer::classifyBreathingPattern(const SlidingWindowStats& rate_history) const {
     if (rate_history.size() < 3) {
         return BreathingPattern::UNKNOWN;
     }
     
     // Анализ вариабельности частоты дыхания
-    double mean_rate = std::accumulate(rate_history.begin(), rate_history.end(), 0.0) / rate_history.size();
-    double variance = 0.0;
-    
-    for (double rate : rate_history) {
-        variance += (rate - mean_rate) * (rate - mean_rate);
-    }
-    variance /= rate_history.size();
-    double std_dev = std::sqrt(variance);
-    double coefficient_of_variation = std_dev / mean_rate;
+    double mean_rate = rate_history.mean();
+    double coefficient_of_variation = rate_history.standardDeviation() / mean_rate;
     
     // Классификация паттернов
     if (coefficient_of_variation < 0.1) {
@@ -273,36 +386,92 @@ BreathingPattern BreathingAnalyzer::classifyBreathingPattern(const std::vector<d
     return BreathingPattern::CYCLICAL;
 }
 
-double BreathingAnalyzer::calculateBreathingRate(const AudioAnalysisResult& analysis) const {
-    // Используем основную частоту как частоту дыхания
-    double frequency_hz = analysis.fundamental_frequency;
+size_t BreathingAnalyzer::envelopeIndex(size_t age) const {
+    return (envelope_next_ + envelope_.size() - 1 - age) % envelope_.size();
+}
+
+double BreathingAnalyzer::estimateBreathingFrequency() {
+    const double envelope_rate = front_end_.getOutputRate();
+    const size_t count = envelope_count_;
+    
+    // Лаги от периода самого быстрого до периода самого медленного дыхания,
+    // не длиннее половины истории
+    size_t min_lag = std::max<size_t>(2, static_cast<size_t>(envelope_rate / max_breathing_frequency_));
+    size_t max_lag = std::min(static_cast<size_t>(std::ceil(envelope_rate / min_breathing_frequency_)), count / 2);
+    if (max_lag < min_lag + 1) {
+        return 0.0;
+    }
     
-    // Конвертируем в вдохи в минуту
-    double breathing_rate = frequency_hz * 60.0;
+    // История от старых отсчетов к новым, без среднего
+    window_.resize(count);
+    double mean = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        window_[i] = envelope_[envelopeIndex(count - 1 - i)];
+        mean += window_[i];
+    }
+    mean /= static_cast<double>(count);
+    double energy = 0.0;
+    for (double& value : window_) {
+        value -= mean;
+        energy += value * value;
+    }
+    if (energy <= 1e-12 * static_cast<double>(count)) {
+        return 0.0;
+    }
     
-    // Ограничиваем разумными пределами
-    return std::max(4.0, std::min(60.0, breathing_rate));
+    // Несмещенная нормированная автокорреляция; соседние лаги - для интерполяции
+    correlation_.assign(max_lag + 2, 0.0);
+    for (size_t lag = min_lag - 1; lag <= max_lag + 1; ++lag) {
+        double sum = 0.0;
+        for (size_t i = 0; i + lag < count; ++i) {
+            sum += window_[i] * window_[i + lag];
+        }
+        correlation_[lag] = sum / energy * static_cast<double>(count) / static_cast<double>(count - lag);
+    }
+    
+    // Первый локальный максимум, близкий к наибольшему, защищает от кратных периодов
+    double best = 0.0;
+    for (size_t lag = min_lag; lag <= max_lag; ++lag) {
+        if (correlation_[lag] > correlation_[lag - 1] && correlation_[lag] >= correlation_[lag + 1]) {
+            best = std::max(best, correlation_[lag]);
+        }
+    }
+    if (best < kMinPeriodicity) {
+        return 0.0;
+    }
+    for (size_t lag = min_lag; lag <= max_lag; ++lag) {
+        double previous = correlation_[lag - 1];
+        double current = correlation_[lag];
+        double next = correlation_[lag + 1];
+        if (current > previous && current >= next && current >= 0.8 * best) {
+            // Параболическая интерполяция вершины
+            double curvature = previous - 2.0 * current + next;
+            double offset = curvature < 0.0 ? 0.5 * (previous - next) / curvature : 0.0;
+            return envelope_rate / (static_cast<double>(lag) + offset);
+        }
+    }
+    return 0.0;
 }
 
-double BreathingAnalyzer::calculateBreathingDepth(const AudioAnalysisResult& analysis) const {
-    // Используем объем как индикатор глубины дыхания
-    return std::min(1.0, analysis.volume_level * 2.0);
+double BreathingAnalyzer::calculateBreathingDepth() const {
+    // Пик огибающей за последний цикл (или за самый быстрый период без оценки)
+    double frequency = breathing_frequency_ > 0.0 ? breathing_frequency_ : max_breathing_frequency_;
+    size_t span = std::min(envelope_count_,
+                           static_cast<size_t>(std::ceil(front_end_.getOutputRate() / frequency)));
+    double peak = 0.0;
+    for (size_t age = 0; age < span; ++age) {
+        peak = std::max(peak, envelope_[envelopeIndex(age)]);
+    }
+    return std::min(1.0, peak * 2.0);
 }
 
-double BreathingAnalyzer::calculateBreathingRegularity(const std::vector<double>& rate_history) const {
+double BreathingAnalyzer::calculateBreathingRegularity(const SlidingWindowStats& rate_history) const {
     if (rate_history.size() < 2) {
         return 1.0; // Считаем регулярным, если недостаточно данных
     }
     
-    // Расчет стандартного отклонения
-    double mean = std::accumulate(rate_history.begin(), rate_history.end(), 0.0) / rate_history.size();
-    double variance = 0.0;
-    
-    for (double rate : rate_history) {
-        variance += (rate - mean) * (rate - mean);
-    }
-    variance /= rate_history.size();
-    double std_dev = std::sqrt(variance);
+    double mean = rate_history.mean();
+    double std_dev = rate_history.standardDeviation();
     
     // Нормализуем к диапазону 0.0 - 1.0 (1.0 = очень регулярно)
     double regularity = 1.0 - std::min(1.0, std_dev / mean);
@@ -313,16 +482,16 @@ double BreathingAnalyzer::calculateStressLevel(double rate, double depth, double
     double stress = 0.0;
     
     // Стресс от высокой частоты дыхания
-    if (rate > normal_breathing_rate_max_) {
-        stress += (rate - normal_breathing_rate_max_) / (rapid_breathing_threshold_ - normal_breathing_rate_max_);
+    if (rate > thresholds_.normal_rate_max) {
+        stress += (rate - thresholds_.normal_rate_max) / (thresholds_.rapid_rate - thresholds_.normal_rate_max);
     }
     
     // Стресс от нерегулярности
     stress += (1.0 - regularity) * 0.5;
     
     // Стресс от поверхностного дыхания
-    if (depth < shallow_breathing_threshold_) {
-        stress += (shallow_breathing_threshold_ - depth) / shallow_breathing_threshold_;
+    if (depth < thresholds_.shallow_depth) {
+        stress += (thresholds_.shallow_depth - depth) / thresholds_.shallow_depth;
     }
     
     return std::min(1.0, stress);
@@ -332,7 +501,7 @@ double BreathingAnalyzer::calculateRelaxationLevel(double rate, double depth, do
     double relaxation = 0.0;
     
     // Расслабление от нормальной частоты дыхания
-    if (rate >= normal_breathing_rate_min_ && rate <= normal_breathing_rate_max_) {
+    if (rate >= thresholds_.normal_rate_min && rate <= thresholds_.normal_rate_max) {
         relaxation += 0.4;
     }
     
@@ -340,103 +509,66 @@ double BreathingAnalyzer::calculateRelaxationLevel(double rate, double depth, do
     relaxation += regularity * 0.3;
     
     // Расслабление от глубокого дыхания
-    if (depth > deep_breathing_threshold_) {
-        relaxation += (depth - deep_breathing_threshold_) * 0.3;
+    if (depth > thresholds_.deep_depth) {
+        relaxation += (depth - thresholds_.deep_depth) * 0.3;
     }
     
     return std::min(1.0, relaxation);
 }
 
-std::vector<double> BreathingAnalyzer::extractBreathingCycle(const std::vector<double>& audio_buffer) const {
-    // Поиск пиков дыхания
-    std::vector<size_t> peaks = findBreathingPeaks(audio_buffer);
-    
-    if (peaks.size() < 2) {
-        return audio_buffer; // Возвращаем исходный буфер, если недостаточно пиков
-    }
-    
-    // Извлекаем один полный цикл между двумя пиками
-    size_t cycle_start = peaks[0];
-    size_t cycle_end = peaks[1];
-    
-    if (cycle_end > cycle_start && cycle_end < audio_buffer.size()) {
-        return std::vector<double>(audio_buffer.begin() + cycle_start, 
-                                 audio_buffer.begin() + cycle_end);
-    }
-    
-    return audio_buffer;
-}
-
-void BreathingAnalyzer::updateHistory(const BreathingAnalysisResult& result) {
-    analysis_history_.push_back(result);
-    breathing_rate_history_.push_back(result.breathing_rate);
-    amplitude_history_.push_back(result.breathing_depth);
-    
-    // Ограничиваем размер истории
-    if (analysis_history_.size() > history_size_) {
-        analysis_history_.pop_front();
-    }
-    if (breathing_rate_history_.size() > history_size_) {
-        breathing_rate_history_.pop_front();
-    }
-    if (amplitude_history_.size() > history_size_) {
-        amplitude_history_.pop_front();
-    }
-}
-
-std::vector<double> BreathingAnalyzer::filterBreathingFrequencies(const std::vector<double>& audio_buffer) const {
-    // Простой полосовой фильтр для дыхательных частот
-    std::vector<double> filtered = audio_buffer;
-    
-    // Простое сглаживание для выделения низкочастотных компонентов
-    for (size_t i = 1; i < filtered.size() - 1; ++i) {
-        filtered[i] = 0.25 * (audio_buffer[i-1] + 2*audio_buffer[i] + audio_buffer[i+1]);
+BreathingCycleView BreathingAnalyzer::extractBreathingCycle() const {
+    if (breathing_frequency_ <= 0.0) {
+        return BreathingCycleView();
     }
     
-    return filtered;
+    // Последний период огибающей
+    size_t period = std::min(envelope_count_,
+                             static_cast<size_t>(std::lround(front_end_.getOutputRate() / breathing_frequency_)));
+    return BreathingCycleView(envelope_total_ - period, period);
 }
 
-std::vector<size_t> BreathingAnalyzer::findBreathingPeaks(const std::vector<double>& filtered_audio) const {
-    std::vector<size_t> peaks;
+bool BreathingAnalyzer::copyBreathingCycle(const BreathingCycleView& cycle, std::vector<double>& output) const {
+    ANANTASOUND_LOCK_GUARD(lock, analyzer_mutex_, "BreathingAnalyzer::analyzer_mutex_");
     
-    if (filtered_audio.size() < 3) {
-        return peaks;
+    output.clear();
+    if (cycle.empty()) {
+        return true;
     }
     
-    // Поиск локальных максимумов
-    for (size_t i = 1; i < filtered_audio.size() - 1; ++i) {
-        if (filtered_audio[i] > filtered_audio[i-1] && 
-            filtered_audio[i] > filtered_audio[i+1] &&
-            filtered_audio[i] > 0.1) { // Минимальный порог
-            peaks.push_back(i);
-        }
-    }
-    
-    return peaks;
-}
-
-std::vector<double> BreathingAnalyzer::calculateBreathingIntervals(const std::vector<size_t>& peaks) const {
-    std::vector<double> intervals;
-    
-    if (peaks.size() < 2) {
-        return intervals;
+    // Окно должно целиком лежать в хранимой части потока
+    uint64_t oldest = envelope_total_ - envelope_count_;
+    if (cycle.offset < oldest || cycle.offset + cycle.length > envelope_total_) {
+        return false;
     }
     
-    for (size_t i = 1; i < peaks.size(); ++i) {
-        double interval_seconds = static_cast<double>(peaks[i] - peaks[i-1]) / sample_rate_;
-        intervals.push_back(interval_seconds);
+    output.resize(cycle.length);
+    for (size_t i = 0; i < cycle.length; ++i) {
+        size_t age = static_cast<size_t>(envelope_total_ - 1 - (cycle.offset + i));
+        output[i] = envelope_[envelopeIndex(age)];
     }
-    
-    return intervals;
+    return true;
 }
 
-void BreathingAnalyzer::initializeDefaultThresholds() {
-    normal_breathing_rate_min_ = 8.0;   // 8 вдохов в минуту
-    normal_breathing_rate_max_ = 20.0;  // 20 вдохов в минуту
-    deep_breathing_threshold_ = 0.7;    // 70% от максимальной амплитуды
-    shallow_breathing_threshold_ = 0.3; // 30% от максимальной амплитуды
-    rapid_breathing_threshold_ = 25.0;  // 25 вдохов в минуту
-    irregularity_threshold_ = 0.7;      // 70% регулярности
+void BreathingAnalyzer::updateHistory(const BreathingAnalysisResult& result) {
+    // В историю частот попадают только найденные периоды
+    if (result.breathing_rate > 0.0) {
+        rate_stats_.push(result.breathing_rate);
+    }
+    stress_stats_.push(result.stress_level);
+    relaxation_stats_.push(result.relaxation_level);
+    
+    // Счетчики состояний и паттернов: самая старая запись вытесняется на месте
+    if (history_count_ == kHistorySize) {
+        state_counts_[static_cast<size_t>(state_history_[history_next_])]--;
+        pattern_counts_[static_cast<size_t>(pattern_history_[history_next_])]--;
+    } else {
+        history_count_++;
+    }
+    state_history_[history_next_] = result.current_state;
+    pattern_history_[history_next_] = result.pattern;
+    state_counts_[static_cast<size_t>(result.current_state)]++;
+    pattern_counts_[static_cast<size_t>(result.pattern)]++;
+    history_next_ = (history_next_ + 1) % kHistorySize;
 }
 
 } // namespace AnantaSound
@@ -1,8 +1,11 @@
 #pragma once
 
-#include "audio_analyzer.hpp"
+#include "envelope_decimator.hpp"
+#include "sliding_window_stats.hpp"
+#include "parameter_mailbox.hpp"
+#include <array>
+#include <cstdint>
 #include <vector>
-#include <deque>
 #include <memory>
 #include <mutex>
 #include <chrono>
@@ -20,6 +23,8 @@ enum class BreathingState {
     UNKNOWN         // Неизвестно
 };
 
+constexpr size_t kBreathingStateCount = static_cast<size_t>(BreathingState::UNKNOWN) + 1;
+
 // Паттерны дыхания
 enum class BreathingPattern {
     REGULAR,        // Регулярный ритм
@@ -31,6 +36,38 @@ enum class BreathingPattern {
     UNKNOWN         // Неизвестно
 };
 
+constexpr size_t kBreathingPatternCount = static_cast<size_t>(BreathingPattern::UNKNOWN) + 1;
+
+// Пороги классификации дыхания (частоты - вдохов в минуту, глубина и
+// регулярность - 0.0 - 1.0)
+struct BreathingThresholds {
+    double normal_rate_min;         // Минимальная нормальная частота дыхания
+    double normal_rate_max;         // Максимальная нормальная частота дыхания
+    double deep_depth;              // Порог для глубокого дыхания
+    double shallow_depth;           // Порог для поверхностного дыхания
+    double rapid_rate;              // Порог для учащенного дыхания
+    double irregularity;            // Порог для нерегулярности
+    
+    BreathingThresholds() : normal_rate_min(8.0), normal_rate_max(20.0),
+                            deep_depth(0.7), shallow_depth(0.3),
+                            rapid_rate(25.0), irregularity(0.7) {}
+};
+
+// Дыхательный цикл как окно в общую историю огибающей анализатора:
+// offset - абсолютный номер первого отсчета огибающей в потоке. Отсчеты
+// копируются только по запросу (BreathingAnalyzer::copyBreathingCycle),
+// пока они остаются в истории.
+struct BreathingCycleView {
+    uint64_t offset;
+    size_t length;
+    
+    BreathingCycleView() : offset(0), length(0) {}
+    BreathingCycleView(uint64_t first, size_t count) : offset(first), length(count) {}
+    
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+};
+
 // Результат анализа дыхания
 struct BreathingAnalysisResult {
     BreathingState current_state;
@@ -40,7 +77,7 @@ struct BreathingAnalysisResult {
     double breathing_regularity;        // Регулярность дыхания (0.0 - 1.0)
     double stress_level;                // Уровень стресса (0.0 - 1.0)
     double relaxation_level;            // Уровень расслабления (0.0 - 1.0)
-    std::vector<double> breathing_cycle; // Полный цикл дыхания
+    BreathingCycleView breathing_cycle;  // Последний цикл огибающей (частота getEnvelopeRate())
     std::chrono::high_resolution_clock::time_point timestamp;
     
     BreathingAnalysisResult() : current_state(BreathingState::UNKNOWN),
@@ -51,10 +88,21 @@ struct BreathingAnalysisResult {
                                timestamp(std::chrono::high_resolution_clock::now()) {}
 };
 
-// Анализатор дыхания
+// Анализатор дыхания.
+// Потоковый многоскоростной тракт: квадрат сигнала прореживается CIC и
+// полуполосными фильтрами до RMS-огибающей около 25 Гц, которая хранится за
+// последние kAnalysisHorizon секунд. Частота дыхания - пик автокорреляции
+// огибающей в диапазоне 0.1 - 1.0 Гц, пересчитываемый раз в kEstimateInterval.
+// Блоки подаются подряд, в любом размере; до двух периодов самого быстрого
+// дыхания результат остается UNKNOWN.
 class BreathingAnalyzer {
 private:
-    std::unique_ptr<AudioAnalyzer> audio_analyzer_;
+    static constexpr double kEnvelopeRate = 25.0;       // Целевая частота огибающей (Гц)
+    static constexpr double kAnalysisHorizon = 60.0;    // Длина истории огибающей (с)
+    static constexpr double kEstimateInterval = 0.5;    // Период пересчета частоты (с)
+    static constexpr double kMinPeriodicity = 0.3;      // Минимальный пик автокорреляции
+    static constexpr size_t kHistorySize = 20;          // Окно истории (анализов)
+    
     mutable std::mutex analyzer_mutex_;
     
     // Параметры анализа
@@ -63,19 +111,37 @@ private:
     double min_breathing_frequency_;    // Минимальная частота дыхания (Гц)
     double max_breathing_frequency_;    // Максимальная частота дыхания (Гц)
     
-    // История для анализа паттернов
-    std::deque<BreathingAnalysisResult> analysis_history_;
-    std::deque<double> breathing_rate_history_;
-    std::deque<double> amplitude_history_;
-    size_t history_size_;
+    // Многоскоростной входной тракт и история огибающей (кольцевой буфер)
+    EnvelopeDecimator front_end_;
+    std::vector<double> envelope_;
+    size_t envelope_next_;
+    size_t envelope_count_;
+    uint64_t envelope_total_;                   // Отсчетов огибающей за все время
+    std::vector<double> block_envelope_;        // Отсчеты огибающей текущего блока
+    std::vector<double> window_;                // Линейная копия истории без среднего
+    std::vector<double> correlation_;           // Нормированная автокорреляция по лагам
+    size_t pending_estimate_;                   // Новых отсчетов с последней оценки
+    double breathing_frequency_;                // Последняя оценка (Гц); 0 - периода нет
+    
+    // История для анализа паттернов: скользящие окна с накопителями, так что
+    // каждый запрос - O(1) и без выделения памяти
+    SlidingWindowStats rate_stats_;             // Найденные частоты дыхания
+    SlidingWindowStats stress_stats_;
+    SlidingWindowStats relaxation_stats_;
+    std::array<BreathingState, kHistorySize> state_history_;
+    std::array<BreathingPattern, kHistorySize> pattern_history_;
+    std::array<size_t, kBreathingStateCount> state_counts_;
+    std::array<size_t, kBreathingPatternCount> pattern_counts_;
+    size_t history_next_;
+    size_t history_count_;
     
-    // Пороги для классификации
-    double normal_breathing_rate_min_;  // Минимальная нормальная частота дыхания
-    double normal_breathing_rate_max_;  // Максимальная нормальная частота дыхания
-    double deep_breathing_threshold_;   // Порог для глубокого дыхания
-    double shallow_breathing_threshold_; // Порог для поверхностного дыхания
-    double rapid_breathing_threshold_;  // Порог для учащенного дыхания
-    double irregularity_threshold_;     // Порог для нерегулярности
+    // Пороги для классификации: анализ берет последний опубликованный снимок
+    // в начале блока (под analyzer_mutex_), установщики пишут только в
+    // почтовый ящик и никогда не ждут анализа
+    mutable BreathingThresholds thresholds_;                    // Снимок текущего блока
+    mutable ParameterMailbox<BreathingThresholds> threshold_mailbox_;
+    mutable std::mutex threshold_mutex_;                        // Упорядочивает установщиков
+    BreathingThresholds published_thresholds_;                  // Последний опубликованный (под threshold_mutex_)
     
 public:
     BreathingAnalyzer(size_t fft_size = 1024, size_t sample_rate = 44100);
@@ -86,9 +152,32 @@ public:
     
     // Анализ дыхания по аудио сигналу
     BreathingAnalysisResult analyzeBreathing(const std::vector<double>& audio_buffer);
+    BreathingAnalysisResult analyzeBreathing(const double* samples, size_t sample_count);
     
-    // Анализ дыхания с перекрытием окон
+    // Анализ дыхания в одинарной точности (float-путь AudioAnalyzer)
+    BreathingAnalysisResult analyzeBreathing(const std::vector<float>& audio_buffer);
+    BreathingAnalysisResult analyzeBreathing(const float* samples, size_t sample_count);
+    
+    // Многоканальный блок (микрофоны купола, чередующиеся или планарные
+    // каналы): огибающая строится по средней энергии кадра по всем каналам,
+    // без предварительного сведения в моно
+    BreathingAnalysisResult analyzeBreathing(const AudioBuffer& buffer);
+    BreathingAnalysisResult analyzeBreathing(const AudioBufferF& buffer);
+    
+    // Анализ дыхания с перекрытием окон: каждый отсчет попадает в поток один
+    // раз, результат выдается через каждую четверть окна
     std::vector<BreathingAnalysisResult> analyzeBreathingWithOverlap(const std::vector<double>& audio_buffer);
+    std::vector<BreathingAnalysisResult> analyzeBreathingWithOverlap(const std::vector<float>& audio_buffer);
+    
+    // Сброс потокового состояния (новый источник сигнала)
+    void resetStream();
+    
+    // Копия отсчетов цикла из истории огибающей; false, если цикл уже
+    // вытеснен из истории (или потерян при resetStream)
+    bool copyBreathingCycle(const BreathingCycleView& cycle, std::vector<double>& output) const;
+    
+    // Частота отсчетов огибающей (Гц)
+    double getEnvelopeRate() const { return front_end_.getOutputRate(); }
     
     // Получение текущего состояния дыхания
     BreathingState getCurrentBreathingState() const;
@@ -105,11 +194,20 @@ public:
     // Получение уровня расслабления
     double getRelaxationLevel() const;
     
-    // Настройка порогов
+    // Настройка порогов. Не ждут идущего анализа: новые пороги действуют
+    // со следующего блока
     void setBreathingRateThresholds(double min_normal, double max_normal);
     void setDepthThresholds(double deep_threshold, double shallow_threshold);
     void setRapidBreathingThreshold(double threshold);
     void setIrregularityThreshold(double threshold);
+    void setThresholds(const BreathingThresholds& thresholds);
+    BreathingThresholds getThresholds() const;
+    
+    // Классификация состояний по готовым признакам (частота, глубина,
+    // регулярность) для многих кадров или сеансов за одну блокировку;
+    // states должен вмещать count значений
+    void classifyBreathingStates(const double* rates, const double* depths, const double* regularities,
+                                 size_t count, BreathingState* states) const;
     
     // Получение статистики
     struct BreathingStatistics {
@@ -124,18 +222,28 @@ public:
     BreathingStatistics getStatistics() const;
     
 private:
+    // Общая реализация для double и float
+    template<typename Sample>
+    BreathingAnalysisResult analyzeSamples(const Sample* samples, size_t sample_count);
+    template<typename Sample>
+    BreathingAnalysisResult analyzeFrames(const BasicAudioBuffer<Sample>& buffer);
+    // Дописывает block_envelope_ в историю и классифицирует (под analyzer_mutex_)
+    BreathingAnalysisResult analyzeBlockEnvelope();
+    template<typename Sample>
+    std::vector<BreathingAnalysisResult> analyzeOverlapping(const std::vector<Sample>& audio_buffer);
+    
     // Основные методы анализа
     BreathingState classifyBreathingState(double rate, double depth, double regularity) const;
-    BreathingPattern classifyBreathingPattern(const std::vector<double>& rate_history) const;
+    BreathingPattern classifyBreathingPattern(const SlidingWindowStats& rate_history) const;
     
-    // Анализ частоты дыхания
-    double calculateBreathingRate(const AudioAnalysisResult& analysis) const;
+    // Частота дыхания (Гц) по автокорреляции истории огибающей; 0 без периода
+    double estimateBreathingFrequency();
     
-    // Анализ глубины дыхания
-    double calculateBreathingDepth(const AudioAnalysisResult& analysis) const;
+    // Анализ глубины дыхания по пику огибающей за последний цикл
+    double calculateBreathingDepth() const;
     
     // Анализ регулярности дыхания
-    double calculateBreathingRegularity(const std::vector<double>& rate_history) const;
+    double calculateBreathingRegularity(const SlidingWindowStats& rate_history) const;
     
     // Анализ уровня стресса
     double calculateStressLevel(double rate, double depth, double regularity) const;
@@ -143,23 +251,21 @@ private:
     // Анализ уровня расслабления
     double calculateRelaxationLevel(double rate, double depth, double regularity) const;
     
-    // Выделение дыхательного цикла
-    std::vector<double> extractBreathingCycle(const std::vector<double>& audio_buffer) const;
+    // Окно последнего дыхательного цикла в истории огибающей
+    BreathingCycleView extractBreathingCycle() const;
+    
+    // Индекс отсчета огибающей по возрасту (0 - самый новый)
+    size_t envelopeIndex(size_t age) const;
     
     // Обновление истории
     void updateHistory(const BreathingAnalysisResult& result);
     
-    // Фильтрация дыхательных частот
-    std::vector<double> filterBreathingFrequencies(const std::vector<double>& audio_buffer) const;
-    
-    // Поиск пиков дыхания
-    std::vector<size_t> findBreathingPeaks(const std::vector<double>& filtered_audio) const;
-    
-    // Расчет интервалов между вдохами
-    std::vector<double> calculateBreathingIntervals(const std::vector<size_t>& peaks) const;
+    // Изменить и опубликовать пороги (под threshold_mutex_)
+    template<typename Update>
+    void updateThresholds(Update update);
     
-    // Инициализация порогов по умолчанию
-    void initializeDefaultThresholds();
+    // Взять последние опубликованные пороги (под analyzer_mutex_)
+    void syncThresholds() const { thresholds_ = threshold_mailbox_.read(); }
 };
 
 } // namespace AnantaSound
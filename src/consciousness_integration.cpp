@@ -1,4 +1,5 @@
 #include "consciousness_integration.hpp"
+#include "harmonic_bank.hpp"
 #include <algorithm>
 #include <numeric>
 #include <random>
@@ -9,7 +10,12 @@ ConsciousnessIntegration::ConsciousnessIntegration()
     : coherence_threshold_(0.7)
     , integration_depth_(5)
     , consciousness_state_(ConsciousnessState::AWARE)
-    , last_update_(std::chrono::high_resolution_clock::now()) {
+    , last_update_(std::chrono::high_resolution_clock::now())
+    , last_coherence_(0.0)
+    , last_energy_(0.0)
+    , spectrum_amplitude_(0.0)
+    , spectrum_state_(ConsciousnessState::AWARE)
+    , spectrum_valid_(false) {
     
     // Initialize consciousness field
     consciousness_field_.amplitude = std::complex<double>(1.0, 0.0);
@@ -20,12 +26,47 @@ ConsciousnessIntegration::ConsciousnessIntegration()
 }
 
 void ConsciousnessIntegration::updateConsciousnessState(const std::vector<QuantumSoundField>& sound_fields) {
-    auto now = std::chrono::high_resolution_clock::now();
-    auto dt = std::chrono::duration<double>(now - last_update_).count();
+    ingest(sound_fields.data(), sound_fields.size());
+}
+
+void ConsciousnessIntegration::ingest(const std::vector<QuantumSoundField>& sound_fields) {
+    ingest(sound_fields.data(), sound_fields.size());
+}
+
+void ConsciousnessIntegration::ingest(const QuantumSoundField* sound_fields, size_t count) {
+    last_update_ = std::chrono::high_resolution_clock::now();
+    
+    // One pass: phase vector, energy and the averages of the field update
+    double sin_sum = 0.0, cos_sum = 0.0, energy = 0.0;
+    double frequency_sum = 0.0, phase_sum = 0.0;
+    std::complex<double> amplitude_sum(0.0, 0.0);
+    for (size_t i = 0; i < count; ++i) {
+        const QuantumSoundField& field = sound_fields[i];
+        sin_sum += std::sin(field.phase);
+        cos_sum += std::cos(field.phase);
+        energy += std::norm(field.amplitude);
+        frequency_sum += field.frequency;
+        phase_sum += field.phase;
+        amplitude_sum += field.amplitude;
+    }
     
-    // Calculate consciousness coherence from sound fields
-    double coherence = calculateConsciousnessCoherence(sound_fields);
+    // Coherence is the length of the mean phase vector (1 - circular variance)
+    double coherence = 0.0;
+    if (count > 0) {
+        double n = static_cast<double>(count);
+        coherence = std::sqrt(sin_sum * sin_sum + cos_sum * cos_sum) / n;
+        last_energy_ = energy / n;
+    }
+    last_coherence_ = coherence;
+    applyCoherence(coherence);
     
+    if (count > 0) {
+        double n = static_cast<double>(count);
+        blendConsciousnessField(frequency_sum / n, phase_sum / n, amplitude_sum / n);
+    }
+}
+
+void ConsciousnessIntegration::applyCoherence(double coherence) {
     // Update consciousness state based on coherence
     if (coherence > coherence_threshold_) {
         consciousness_state_ = ConsciousnessState::COHERENT;
@@ -34,11 +75,6 @@ void ConsciousnessIntegration::updateConsciousnessState(const std::vector<Quantu
     } else {
         consciousness_state_ = ConsciousnessState::DISSOCIATED;
     }
-    
-    // Update consciousness field
-    updateConsciousnessField(sound_fields, dt);
-    
-    last_update_ = now;
 }
 
 double ConsciousnessIntegration::calculateConsciousnessCoherence(const std::vector<QuantumSoundField>& sound_fields) const {
@@ -46,22 +82,14 @@ double ConsciousnessIntegration::calculateConsciousnessCoherence(const std::vect
         return 0.0;
     }
     
-    // Calculate phase coherence across all sound fields
-    std::vector<double> phases;
-    phases.reserve(sound_fields.size());
-    
-    for (const auto& field : sound_fields) {
-        phases.push_back(field.phase);
-    }
-    
     // Calculate circular variance (measure of phase coherence)
     double mean_sin = 0.0, mean_cos = 0.0;
-    for (double phase : phases) {
-        mean_sin += std::sin(phase);
-        mean_cos += std::cos(phase);
+    for (const auto& field : sound_fields) {
+        mean_sin += std::sin(field.phase);
+        mean_cos += std::cos(field.phase);
     }
-    mean_sin /= phases.size();
-    mean_cos /= phases.size();
+    mean_sin /= sound_fields.size();
+    mean_cos /= sound_fields.size();
     
     double circular_variance = 1.0 - std::sqrt(mean_sin * mean_sin + mean_cos * mean_cos);
     
@@ -69,6 +97,20 @@ double ConsciousnessIntegration::calculateConsciousnessCoherence(const std::vect
     return 1.0 - circular_variance;
 }
 
+double ConsciousnessIntegration::calculateConsciousnessCoherence(const FieldBuffer& sound_fields) const {
+    if (sound_fields.empty()) {
+        return 0.0;
+    }
+    
+    double mean_sin, mean_cos;
+    sound_fields.phaseSums(mean_sin, mean_cos);
+    mean_sin /= sound_fields.size();
+    mean_cos /= sound_fields.size();
+    
+    // Coherence is the length of the mean phase vector (1 - circular variance)
+    return std::sqrt(mean_sin * mean_sin + mean_cos * mean_cos);
+}
+
 void ConsciousnessIntegration::updateConsciousnessField(const std::vector<QuantumSoundField>& sound_fields, double dt) {
     if (sound_fields.empty()) {
         return;
@@ -89,6 +131,11 @@ void ConsciousnessIntegration::updateConsciousnessField(const std::vector<Quantu
     avg_phase /= sound_fields.size();
     avg_amplitude /= static_cast<double>(sound_fields.size());
     
+    blendConsciousnessField(avg_frequency, avg_phase, avg_amplitude);
+}
+
+void ConsciousnessIntegration::blendConsciousnessField(double avg_frequency, double avg_phase,
+                                                       std::complex<double> avg_amplitude) {
     // Update consciousness field with weighted average
     double alpha = 0.1; // Learning rate
     consciousness_field_.frequency = (1.0 - alpha) * consciousness_field_.frequency + alpha * avg_frequency;
@@ -126,33 +173,48 @@ void ConsciousnessIntegration::setIntegrationDepth(int depth) {
 }
 
 std::vector<double> ConsciousnessIntegration::getConsciousnessSpectrum() const {
-    std::vector<double> spectrum;
-    spectrum.reserve(integration_depth_);
-    
-    // Generate consciousness spectrum based on current state
-    double base_frequency = consciousness_field_.frequency;
-    
-    for (int i = 0; i < integration_depth_; ++i) {
-        double harmonic = base_frequency * (i + 1);
-        double amplitude = consciousness_field_.amplitude.real() / (i + 1);
-        
-        // Apply consciousness state modulation
-        switch (consciousness_state_) {
-            case ConsciousnessState::COHERENT:
-                amplitude *= 1.5; // Enhanced harmonics
-                break;
-            case ConsciousnessState::AWARE:
-                amplitude *= 1.0; // Normal harmonics
-                break;
-            case ConsciousnessState::DISSOCIATED:
-                amplitude *= 0.5; // Reduced harmonics
-                break;
-        }
-        
-        spectrum.push_back(amplitude);
+    return spectrum();
+}
+
+void ConsciousnessIntegration::getConsciousnessSpectrum(std::vector<double>& output) const {
+    const std::vector<double>& cached = spectrum();
+    output.assign(cached.begin(), cached.end());
+}
+
+const std::vector<double>& ConsciousnessIntegration::spectrum() const {
+    double amplitude = consciousness_field_.amplitude.real();
+    if (spectrum_valid_ && spectrum_amplitude_ == amplitude && spectrum_state_ == consciousness_state_ &&
+        spectrum_.size() == static_cast<size_t>(integration_depth_)) {
+        return spectrum_;
+    }
+    
+    // Apply consciousness state modulation
+    double modulation = 1.0;
+    switch (consciousness_state_) {
+        case ConsciousnessState::COHERENT:
+            modulation = 1.5; // Enhanced harmonics
+            break;
+        case ConsciousnessState::AWARE:
+            modulation = 1.0; // Normal harmonics
+            break;
+        case ConsciousnessState::DISSOCIATED:
+            modulation = 0.5; // Reduced harmonics
+            break;
     }
     
-    return spectrum;
+    // Generate consciousness spectrum based on current state: harmonic h gets A/h
+    HarmonicSeries series;
+    series.frequency = consciousness_field_.frequency;
+    series.amplitude = amplitude * modulation;
+    spectrum_.resize(static_cast<size_t>(integration_depth_));
+    HarmonicBuffers output;
+    output.amplitude = spectrum_.data();
+    HarmonicBank().generate(series, spectrum_.size(), output);
+    
+    spectrum_amplitude_ = amplitude;
+    spectrum_state_ = consciousness_state_;
+    spectrum_valid_ = true;
+    return spectrum_;
 }
 
 // Additional methods for compatibility
@@ -21,17 +21,33 @@ private:
     ConsciousnessState consciousness_state_;
     QuantumSoundField consciousness_field_;
     std::chrono::high_resolution_clock::time_point last_update_;
+    double last_coherence_;     // Coherence of the last ingested batch
+    double last_energy_;        // Mean |amplitude|^2 of the last ingested batch
+    
+    // Spectrum cache, rebuilt only when the field amplitude, state or depth changes
+    mutable std::vector<double> spectrum_;
+    mutable double spectrum_amplitude_;
+    mutable ConsciousnessState spectrum_state_;
+    mutable bool spectrum_valid_;
 
 public:
     ConsciousnessIntegration();
     
-    // Consciousness State Management
+    // Consciousness State Management. ingest is the fused per-tick update: one
+    // streaming pass gathers the phase vector sums, amplitude energy and field
+    // averages, then applies the state transition and the field update, with
+    // no temporary allocations. updateConsciousnessState forwards to it.
+    void ingest(const QuantumSoundField* sound_fields, size_t count);
+    void ingest(const std::vector<QuantumSoundField>& sound_fields);
     void updateConsciousnessState(const std::vector<QuantumSoundField>& sound_fields);
     ConsciousnessState getConsciousnessState() const;
     
     // Coherence Analysis
     double calculateConsciousnessCoherence(const std::vector<QuantumSoundField>& sound_fields) const;
+    double calculateConsciousnessCoherence(const FieldBuffer& sound_fields) const;    // Reads only the phase array
     double getConsciousnessCoherence() const;
+    double getLastCoherence() const { return last_coherence_; }
+    double getLastEnergy() const { return last_energy_; }
     
     // Field Management
     void updateConsciousnessField(const std::vector<QuantumSoundField>& sound_fields, double dt);
@@ -41,13 +57,20 @@ public:
     void setCoherenceThreshold(double threshold);
     void setIntegrationDepth(int depth);
     
-    // Analysis
+    // Analysis: integration_depth_ harmonics from the cached spectrum buffer;
+    // the output overload reuses the caller's capacity
     std::vector<double> getConsciousnessSpectrum() const;
+    void getConsciousnessSpectrum(std::vector<double>& output) const;
     
     // Additional methods for compatibility
     void updateConsciousnessLevel(double level);
     void setConsciousnessParameter(const std::string& param, double value);
 
+private:
+    void applyCoherence(double coherence);
+    void blendConsciousnessField(double avg_frequency, double avg_phase, std::complex<double> avg_amplitude);
+    const std::vector<double>& spectrum() const;
+
 }; // class ConsciousnessIntegration
 
 } // namespace AnantaSound
@@ -0,0 +1,225 @@
+#include "constant_q.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+// ConstantQKernel
+ConstantQKernel::ConstantQKernel(size_t sample_rate, const ConstantQOptions& options)
+    : sample_rate_(std::max<size_t>(1, sample_rate))
+    , options_(options)
+    , octave_count_(1)
+    , bins_per_octave_(std::max<size_t>(1, options.bins_per_octave))
+    , leading_stages_(0) {
+
+    const double rate = static_cast<double>(sample_rate_);
+    double limit = kMaxRelativeFrequency * rate;
+    if (options.max_frequency > 0.0) {
+        limit = std::min(limit, options.max_frequency);
+    }
+    const double min_frequency = std::clamp(options.min_frequency, 1e-3, 0.5 * limit);
+    octave_count_ = std::max<size_t>(1, static_cast<size_t>(std::floor(std::log2(limit / min_frequency) + 1e-9)));
+    const double top = min_frequency * std::pow(2.0, static_cast<double>(octave_count_));
+
+    // A low upper limit would need a long frame at the input rate; decimate
+    // first, so the top octave again sits just below kMaxRelativeFrequency
+    while (top * std::pow(2.0, static_cast<double>(leading_stages_ + 1)) <= kMaxRelativeFrequency * rate) {
+        leading_stages_++;
+    }
+
+    quality_ = 1.0 / (std::pow(2.0, 1.0 / static_cast<double>(bins_per_octave_)) - 1.0);
+
+    // Bin frequencies relative to the top octave's sample rate
+    const double octave_rate = rate / std::pow(2.0, static_cast<double>(leading_stages_));
+    const double base = 0.5 * top / octave_rate;
+    size_t longest = static_cast<size_t>(std::ceil(quality_ / base));
+    size_t fft_size = 4;
+    while (fft_size < longest) {
+        fft_size *= 2;
+    }
+    plan_ = sharedFFTPlan<double>(fft_size);
+
+    frequencies_.resize(octave_count_ * bins_per_octave_);
+    for (size_t bin = 0; bin < frequencies_.size(); ++bin) {
+        frequencies_[bin] = min_frequency * std::pow(2.0, static_cast<double>(bin) / static_cast<double>(bins_per_octave_));
+    }
+
+    // Temporal kernels, Q periods long and normalized so a sinusoid at the
+    // bin centre yields half its amplitude, then thresholded in frequency.
+    // Only the positive-frequency half is kept: the kernels are analytic, so
+    // their negative-frequency content is negligible for real input.
+    std::vector<std::complex<double>> kernel(fft_size);
+    offsets_.assign(1, 0);
+    for (size_t bin = 0; bin < bins_per_octave_; ++bin) {
+        double relative = base * std::pow(2.0, static_cast<double>(bin) / static_cast<double>(bins_per_octave_));
+        size_t length = std::min(fft_size, static_cast<size_t>(std::ceil(quality_ / relative)));
+        size_t start = (fft_size - length) / 2;
+
+        std::fill(kernel.begin(), kernel.end(), std::complex<double>());
+        double weight_sum = 0.0;
+        for (size_t n = 0; n < length; ++n) {
+            weight_sum += 0.5 * (1.0 - std::cos(2.0 * M_PI * n / (length - 1)));
+        }
+        for (size_t n = 0; n < length; ++n) {
+            double weight = 0.5 * (1.0 - std::cos(2.0 * M_PI * n / (length - 1))) / weight_sum;
+            kernel[start + n] = std::polar(weight, 2.0 * M_PI * relative * static_cast<double>(start + n));
+        }
+        plan_->forward(kernel.data());
+
+        double peak = 0.0;
+        for (size_t k = 0; k <= fft_size / 2; ++k) {
+            peak = std::max(peak, std::abs(kernel[k]));
+        }
+        // Parseval: sum x(n) conj(t(n)) = (1 / N) sum X[k] conj(T[k])
+        for (size_t k = 0; k <= fft_size / 2; ++k) {
+            if (std::abs(kernel[k]) >= options.kernel_threshold * peak) {
+                entries_.emplace_back(k, std::conj(kernel[k]) / static_cast<double>(fft_size));
+            }
+        }
+        offsets_.push_back(entries_.size());
+    }
+}
+
+void ConstantQKernel::transform(const double* frame, std::complex<double>* spectrum,
+                                std::complex<double>* coefficients) const {
+    plan_->forwardReal(frame, spectrum);
+    for (size_t bin = 0; bin < bins_per_octave_; ++bin) {
+        std::complex<double> sum;
+        for (size_t e = offsets_[bin]; e < offsets_[bin + 1]; ++e) {
+            sum += spectrum[entries_[e].first] * entries_[e].second;
+        }
+        coefficients[bin] = sum;
+    }
+}
+
+bool ConstantQKernel::matches(size_t sample_rate, const ConstantQOptions& options) const {
+    return sample_rate == sample_rate_ && options.min_frequency == options_.min_frequency &&
+           options.max_frequency == options_.max_frequency &&
+           options.bins_per_octave == options_.bins_per_octave &&
+           options.kernel_threshold == options_.kernel_threshold;
+}
+
+size_t ConstantQKernel::getBin(double frequency) const {
+    if (!(frequency > frequencies_.front())) {
+        return 0;
+    }
+    double bin = std::round(static_cast<double>(bins_per_octave_) * std::log2(frequency / frequencies_.front()));
+    return std::min(static_cast<size_t>(bin), frequencies_.size() - 1);
+}
+
+// ConstantQAnalyzer
+ConstantQAnalyzer::ConstantQAnalyzer(size_t sample_rate, const ConstantQOptions& options)
+    : ConstantQAnalyzer(std::make_shared<const ConstantQKernel>(sample_rate, options)) {
+}
+
+ConstantQAnalyzer::ConstantQAnalyzer(std::shared_ptr<const ConstantQKernel> kernel)
+    : kernel_(kernel ? std::move(kernel) : std::make_shared<const ConstantQKernel>())
+    , hop_size_(kernel_->getOptions().hop_size)
+    , refresh_samples_(std::max<size_t>(1, kernel_->getFFTSize() / 4))
+    , samples_until_frame_(hop_size_)
+    , frames_emitted_(0)
+    , samples_pushed_(0) {
+
+    const size_t fft_size = kernel_->getFFTSize();
+    octaves_.resize(kernel_->getLeadingStages() + kernel_->getOctaveCount());
+    for (size_t level = kernel_->getLeadingStages(); level < octaves_.size(); ++level) {
+        octaves_[level].ring.assign(2 * fft_size, 0.0);
+    }
+    spectrum_.resize(fft_size / 2 + 1);
+    coefficients_.resize(kernel_->getBinsPerOctave());
+    result_.frequencies = kernel_->getFrequencies();
+    result_.magnitudes.assign(kernel_->getBinCount(), 0.0);
+    reset();
+}
+
+void ConstantQAnalyzer::setFrameCallback(FrameCallback callback) {
+    frame_callback_ = std::move(callback);
+}
+
+void ConstantQAnalyzer::pushSample(double sample) {
+    const size_t fft_size = kernel_->getFFTSize();
+    double value = sample;
+    for (size_t level = 0; level < octaves_.size(); ++level) {
+        Octave& octave = octaves_[level];
+        if (!octave.ring.empty()) {
+            octave.ring[octave.write_position] = value;
+            octave.ring[octave.write_position + fft_size] = value;
+            octave.write_position = octave.write_position + 1 == fft_size ? 0 : octave.write_position + 1;
+            octave.pending++;
+        }
+        if (level + 1 == octaves_.size() || !octave.decimator.push(value, value)) {
+            break;
+        }
+    }
+}
+
+void ConstantQAnalyzer::transformOctave(size_t level) {
+    Octave& octave = octaves_[level];
+    kernel_->transform(octave.ring.data() + octave.write_position, spectrum_.data(), coefficients_.data());
+
+    // Level leading_stages + o holds the o-th octave from the top
+    const size_t bins = kernel_->getBinsPerOctave();
+    const size_t first = (octaves_.size() - 1 - level) * bins;
+    for (size_t bin = 0; bin < bins; ++bin) {
+        result_.magnitudes[first + bin] = 2.0 * std::abs(coefficients_[bin]);
+    }
+    octave.pending = 0;
+}
+
+size_t ConstantQAnalyzer::pushSamples(const double* samples, size_t sample_count) {
+    if (samples == nullptr) {
+        return 0;
+    }
+
+    size_t frames = 0;
+    for (size_t i = 0; i < sample_count; ++i) {
+        pushSample(samples[i]);
+        samples_pushed_++;
+        if (hop_size_ == 0 || --samples_until_frame_ > 0) {
+            continue;
+        }
+        samples_until_frame_ = hop_size_;
+
+        for (size_t level = kernel_->getLeadingStages(); level < octaves_.size(); ++level) {
+            if (octaves_[level].pending >= refresh_samples_) {
+                transformOctave(level);
+            }
+        }
+        frames_emitted_++;
+        frames++;
+        if (frame_callback_) {
+            frame_callback_(result_);
+        }
+    }
+    return frames;
+}
+
+size_t ConstantQAnalyzer::pushSamples(const std::vector<double>& samples) {
+    return pushSamples(samples.data(), samples.size());
+}
+
+const ConstantQSpectrum& ConstantQAnalyzer::computeSpectrum() {
+    for (size_t level = kernel_->getLeadingStages(); level < octaves_.size(); ++level) {
+        transformOctave(level);
+    }
+    return result_;
+}
+
+void ConstantQAnalyzer::reset() {
+    for (Octave& octave : octaves_) {
+        std::fill(octave.ring.begin(), octave.ring.end(), 0.0);
+        octave.write_position = 0;
+        octave.pending = 0;
+        octave.decimator.reset();
+    }
+    std::fill(result_.magnitudes.begin(), result_.magnitudes.end(), 0.0);
+    samples_until_frame_ = hop_size_;
+    frames_emitted_ = 0;
+    samples_pushed_ = 0;
+}
+
+size_t ConstantQAnalyzer::getLatencySamples() const {
+    return kernel_->getFFTSize() << (octaves_.size() - 1);
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "fft_engine.hpp"
+#include "envelope_decimator.hpp"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace AnantaSound {
+
+struct ConstantQOptions {
+    double min_frequency = 27.5;        // Lowest bin centre (Hz)
+    double max_frequency = 0.0;         // Upper limit (Hz); 0 = kMaxRelativeFrequency * sample rate
+    size_t bins_per_octave = 12;
+    size_t hop_size = 512;              // Input samples between streamed frames; 0 = on demand only
+    double kernel_threshold = 0.0054;   // Spectral kernel entries below this fraction of the peak are dropped
+};
+
+// Log-frequency spectrum: one amplitude per bin, bins ascending in frequency
+struct ConstantQSpectrum {
+    std::vector<double> frequencies;    // Bin centre frequencies (Hz)
+    std::vector<double> magnitudes;     // Amplitude of a sinusoid at the bin centre
+};
+
+// Spectral kernel of one octave of a constant-Q transform (Brown–Puckette).
+// Every octave has the same layout relative to its sample rate, so the
+// kernel is built once and reused for all of them: octave o of the
+// transform is read from the signal decimated by 2^o. Each bin's temporal
+// kernel is a Hann-windowed complex exponential Q periods long, centred in
+// the frame; its FFT is thresholded to a few nonzero entries, so a bin costs
+// a handful of multiplies on top of one small real FFT per octave.
+// The frame length is about 2Q / kMaxRelativeFrequency samples (128 for 12
+// bins per octave) whatever the lowest frequency, where a single FFT with
+// the same resolution at 27.5 Hz would need tens of thousands.
+// Immutable after construction; analyzers of many streams can share one.
+class ConstantQKernel {
+public:
+    // The top octave ends below this fraction of the sample rate, so every
+    // decimated octave stays inside the half-band filter's passband
+    static constexpr double kMaxRelativeFrequency = 0.35;
+
+private:
+    size_t sample_rate_;
+    ConstantQOptions options_;
+    size_t octave_count_;
+    size_t bins_per_octave_;
+    double quality_;                                    // Q = f / bandwidth
+    size_t leading_stages_;                             // Decimations before the top octave
+    std::shared_ptr<const FFTPlan> plan_;
+
+    std::vector<double> frequencies_;                   // All bins, ascending
+    std::vector<std::pair<size_t, std::complex<double>>> entries_;  // conj(K[k]) / N
+    std::vector<size_t> offsets_;                       // bins_per_octave_ + 1 ranges into entries_
+
+public:
+    ConstantQKernel(size_t sample_rate = 44100, const ConstantQOptions& options = ConstantQOptions());
+
+    // Coefficients of one octave from getFFTSize() samples of that octave's
+    // signal; writes bins_per_octave_ complex values. spectrum holds
+    // getFFTSize() / 2 + 1 bins of scratch.
+    void transform(const double* frame, std::complex<double>* spectrum, std::complex<double>* coefficients) const;
+
+    // True when built for this rate and these options (hop size aside)
+    bool matches(size_t sample_rate, const ConstantQOptions& options) const;
+
+    // Nearest bin to a frequency
+    size_t getBin(double frequency) const;
+    double getFrequency(size_t bin) const { return frequencies_[bin]; }
+    const std::vector<double>& getFrequencies() const { return frequencies_; }
+
+    size_t getSampleRate() const { return sample_rate_; }
+    const ConstantQOptions& getOptions() const { return options_; }
+    size_t getOctaveCount() const { return octave_count_; }
+    size_t getBinsPerOctave() const { return bins_per_octave_; }
+    // Half-band stages between the input and the top octave; nonzero only
+    // when max_frequency is well below the sample rate
+    size_t getLeadingStages() const { return leading_stages_; }
+    size_t getBinCount() const { return frequencies_.size(); }
+    double getQuality() const { return quality_; }
+    size_t getFFTSize() const { return plan_->getSize(); }
+    // Nonzero spectral kernel entries per octave
+    size_t getKernelEntries() const { return entries_.size(); }
+};
+
+// Streaming constant-Q analysis by recursive octave decimation.
+// Each incoming sample feeds the top octave; a cascade of half-band
+// decimators derives the signal of every lower octave at half the rate of
+// the one above, and each octave keeps the last getFFTSize() samples of its
+// own signal in a mirrored ring. A frame is produced every hop_size input
+// samples. An octave is transformed again only once a quarter of its window
+// is new, so the low octaves, whose samples arrive slowly, are refreshed
+// rarely and keep their previous coefficients in between.
+// The lowest octave's window spans getLatencySamples() input samples; each
+// decimation stage also delays its octave by HalfBandDecimator::kTaps / 2
+// samples at its input rate. Nothing is allocated after construction.
+class ConstantQAnalyzer {
+public:
+    using FrameCallback = std::function<void(const ConstantQSpectrum&)>;
+
+private:
+    struct Octave {
+        std::vector<double> ring;       // 2 * fft size, mirrored halves
+        size_t write_position;
+        size_t pending;                 // Samples since the last transform
+        HalfBandDecimator decimator;    // Feeds the octave below
+    };
+
+    std::shared_ptr<const ConstantQKernel> kernel_;
+    size_t hop_size_;
+    size_t refresh_samples_;            // New samples that trigger a transform
+
+    std::vector<Octave> octaves_;       // [0] = top octave at the input rate
+    std::vector<std::complex<double>> spectrum_;
+    std::vector<std::complex<double>> coefficients_;
+    ConstantQSpectrum result_;
+
+    size_t samples_until_frame_;
+    uint64_t frames_emitted_;
+    uint64_t samples_pushed_;
+    FrameCallback frame_callback_;
+
+    void pushSample(double sample);
+    void transformOctave(size_t octave);
+
+public:
+    ConstantQAnalyzer(size_t sample_rate = 44100, const ConstantQOptions& options = ConstantQOptions());
+    // Uses a shared kernel; its options supply the hop size
+    explicit ConstantQAnalyzer(std::shared_ptr<const ConstantQKernel> kernel);
+
+    // Called with each frame as soon as its last sample arrives
+    void setFrameCallback(FrameCallback callback);
+
+    // Push a chunk of samples; returns the number of frames emitted
+    size_t pushSamples(const double* samples, size_t sample_count);
+    size_t pushSamples(const std::vector<double>& samples);
+
+    // Transform every octave now and return the spectrum ending at the
+    // last pushed sample (no callback)
+    const ConstantQSpectrum& computeSpectrum();
+
+    // Drop buffered samples and start a new stream
+    void reset();
+
+    // Most recent frame
+    const ConstantQSpectrum& getSpectrum() const { return result_; }
+    const ConstantQKernel& getKernel() const { return *kernel_; }
+    const std::shared_ptr<const ConstantQKernel>& getSharedKernel() const { return kernel_; }
+
+    size_t getHopSize() const { return hop_size_; }
+    size_t getLatencySamples() const;
+    uint64_t getFramesEmitted() const { return frames_emitted_; }
+    uint64_t getSamplesPushed() const { return samples_pushed_; }
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,189 @@
+#include "deadline_scheduler.hpp"
+#include "instrumentation.hpp"
+#include "metrics.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+uint64_t blend(uint64_t estimate, uint64_t sample, double weight) {
+    if (estimate == 0) {
+        return sample;
+    }
+    double blended = static_cast<double>(estimate) + weight * (static_cast<double>(sample) - static_cast<double>(estimate));
+    return static_cast<uint64_t>(std::llround(std::max(blended, 0.0)));
+}
+
+} // namespace
+
+DeadlineScheduler::DeadlineScheduler(const DeadlineOptions& options)
+    : options_(options)
+    , budget_ns_(options.budget_ns)
+    , level_(0)
+    , calm_ticks_(0)
+    , tick_start_ns_(0)
+    , stage_count_(0)
+    , ticks_(0)
+    , deadline_misses_(0)
+    , shed_stages_(0)
+    , level_changes_(0)
+    , last_tick_ns_(0)
+    , average_tick_ns_(0)
+    , level_metric_(nullptr)
+    , miss_metric_(nullptr)
+    , shed_metric_(nullptr) {
+    options_.smoothing = std::clamp(options_.smoothing, 0.01, 1.0);
+    options_.recovery_ticks = std::max<uint32_t>(options_.recovery_ticks, 1);
+    if (options_.metrics_component) {
+        MetricsRegistry& metrics = MetricsRegistry::shared();
+        level_metric_ = metrics.registerGauge("degradation_level", options_.metrics_component);
+        miss_metric_ = metrics.registerCounter("deadline_misses", options_.metrics_component);
+        shed_metric_ = metrics.registerCounter("shed_stages", options_.metrics_component);
+    }
+}
+
+uint64_t DeadlineScheduler::now() {
+    return Instrumentation::now();
+}
+
+DeadlineScheduler::StageId DeadlineScheduler::addStage(const std::string& name, OptionalWork work) {
+    std::lock_guard<std::mutex> lock(stage_mutex_);
+    size_t count = stage_count_.load(std::memory_order_relaxed);
+    if (count == kMaxStages) {
+        return npos;
+    }
+    stages_[count].name = name;
+    stages_[count].work.store(work, std::memory_order_relaxed);
+    stage_count_.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+void DeadlineScheduler::setStageWork(StageId stage, OptionalWork work) {
+    if (stage < getStageCount()) {
+        stages_[stage].work.store(work, std::memory_order_relaxed);
+    }
+}
+
+void DeadlineScheduler::beginTick() {
+    tick_start_ns_.store(now(), std::memory_order_relaxed);
+}
+
+void DeadlineScheduler::endTick() {
+    recordTick(now() - tick_start_ns_.load(std::memory_order_relaxed));
+}
+
+void DeadlineScheduler::recordTick(uint64_t tick_ns) {
+    uint64_t budget = getBudget();
+    ticks_.fetch_add(1, std::memory_order_relaxed);
+    last_tick_ns_.store(tick_ns, std::memory_order_relaxed);
+    average_tick_ns_.store(blend(average_tick_ns_.load(std::memory_order_relaxed), tick_ns, options_.smoothing),
+                           std::memory_order_relaxed);
+    if (budget > 0 && tick_ns > budget) {
+        deadline_misses_.fetch_add(1, std::memory_order_relaxed);
+        if (miss_metric_) {
+            miss_metric_->add();
+        }
+    }
+    if (budget == 0) {
+        return;
+    }
+
+    // Fast attack, slow release
+    double load = static_cast<double>(tick_ns) / static_cast<double>(budget);
+    int level = getLevel();
+    if (load > options_.shed_fraction) {
+        calm_ticks_ = 0;
+        if (level < kMaxDegradationLevel) {
+            changeLevel(level + 1);
+        }
+    } else if (load < options_.recover_fraction) {
+        if (level > 0 && ++calm_ticks_ >= options_.recovery_ticks) {
+            calm_ticks_ = 0;
+            changeLevel(level - 1);
+        }
+    } else {
+        calm_ticks_ = 0;
+    }
+}
+
+void DeadlineScheduler::changeLevel(int level) {
+    level_.store(level, std::memory_order_relaxed);
+    level_changes_.fetch_add(1, std::memory_order_relaxed);
+    if (level_metric_) {
+        level_metric_->set(level);
+    }
+}
+
+bool DeadlineScheduler::shouldRun(StageId stage) {
+    if (stage >= getStageCount()) {
+        return true;
+    }
+    StageSlot& slot = stages_[stage];
+    OptionalWork work = slot.work.load(std::memory_order_relaxed);
+    if (work == OptionalWork::MANDATORY) {
+        return true;
+    }
+
+    // Shed by level, or when the estimate no longer fits what is left of the tick.
+    // The estimate only learns from runs, so a shed run decays it: one slow
+    // outlier cannot keep the stage shed once the load is gone
+    bool run = allows(work);
+    uint64_t budget = getBudget();
+    if (run && budget > 0) {
+        uint64_t elapsed = now() - tick_start_ns_.load(std::memory_order_relaxed);
+        uint64_t estimate = slot.estimate_ns.load(std::memory_order_relaxed);
+        run = elapsed + estimate <= budget;
+        if (!run) {
+            slot.estimate_ns.store(blend(estimate, 0, options_.smoothing), std::memory_order_relaxed);
+        }
+    }
+    if (!run) {
+        slot.shed.fetch_add(1, std::memory_order_relaxed);
+        shed_stages_.fetch_add(1, std::memory_order_relaxed);
+        if (shed_metric_) {
+            shed_metric_->add();
+        }
+    }
+    return run;
+}
+
+void DeadlineScheduler::recordStage(StageId stage, uint64_t duration_ns) {
+    if (stage >= getStageCount()) {
+        return;
+    }
+    StageSlot& slot = stages_[stage];
+    slot.runs.fetch_add(1, std::memory_order_relaxed);
+    slot.estimate_ns.store(blend(slot.estimate_ns.load(std::memory_order_relaxed), duration_ns, options_.smoothing),
+                           std::memory_order_relaxed);
+}
+
+DeadlineStatistics DeadlineScheduler::getStatistics() const {
+    DeadlineStatistics statistics;
+    statistics.level = getLevel();
+    statistics.ticks = ticks_.load(std::memory_order_relaxed);
+    statistics.deadline_misses = deadline_misses_.load(std::memory_order_relaxed);
+    statistics.shed_stages = shed_stages_.load(std::memory_order_relaxed);
+    statistics.level_changes = level_changes_.load(std::memory_order_relaxed);
+    statistics.last_tick_ns = last_tick_ns_.load(std::memory_order_relaxed);
+    statistics.average_tick_ns = average_tick_ns_.load(std::memory_order_relaxed);
+    statistics.budget_ns = getBudget();
+    return statistics;
+}
+
+std::vector<DeadlineStageCost> DeadlineScheduler::getStageCosts() const {
+    std::vector<DeadlineStageCost> costs;
+    size_t count = getStageCount();
+    costs.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const StageSlot& slot = stages_[i];
+        costs.push_back({slot.name, slot.work.load(std::memory_order_relaxed),
+                         slot.estimate_ns.load(std::memory_order_relaxed),
+                         slot.runs.load(std::memory_order_relaxed),
+                         slot.shed.load(std::memory_order_relaxed)});
+    }
+    return costs;
+}
+
+} // namespace AnantaSound
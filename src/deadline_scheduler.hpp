@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AnantaSound {
+
+struct CounterSlot;
+struct GaugeSlot;
+
+// Work a tick may shed when it runs out of time, in shedding order:
+// degradation level n drops every kind of work with a value of at most n.
+// Audio output is MANDATORY and is never shed.
+enum class OptionalWork : uint8_t {
+    MANDATORY = 0,
+    CONSCIOUSNESS = 1,          // Consciousness ingest and spectrum
+    RESONANCE_DETECTION = 2,    // QRD resonance and resonance tracking
+    FAR_FIELD_DETAIL = 3,       // Exact far-field interference (coarser cluster tolerance instead)
+    UNFOCUSED_SESSIONS = 4,     // Analysis of listeners out of focus
+};
+
+constexpr int kMaxDegradationLevel = 4;
+
+struct DeadlineOptions {
+    uint64_t budget_ns = 16000000;      // Per tick; the 60 FPS frame
+    double shed_fraction = 0.85;        // A tick above this share of the budget raises the level
+    double recover_fraction = 0.6;      // Ticks below this share count towards recovery
+    uint32_t recovery_ticks = 30;       // Consecutive calm ticks per level of recovery
+    double smoothing = 0.25;            // Weight of the newest cost in the running estimates
+    const char* metrics_component = nullptr;   // Publish to MetricsRegistry under this component
+};
+
+struct DeadlineStatistics {
+    int level;                  // 0: full quality
+    uint64_t ticks;
+    uint64_t deadline_misses;   // Ticks over budget
+    uint64_t shed_stages;       // Stage runs skipped, by level or by the remaining budget
+    uint64_t level_changes;
+    uint64_t last_tick_ns;
+    uint64_t average_tick_ns;   // Running estimate
+    uint64_t budget_ns;
+};
+
+struct DeadlineStageCost {
+    std::string name;
+    OptionalWork work;
+    uint64_t estimate_ns;       // Running estimate of one run; 0 before the first
+    uint64_t runs;
+    uint64_t shed;
+};
+
+// Keeps a per-tick pipeline inside its time budget by shedding optional
+// work. The tick owner brackets every tick with beginTick / endTick (or a
+// TickScope); stages ask shouldRun before running and report their cost
+// with recordStage (runStage does both). Two mechanisms decide:
+//
+//  - the degradation level, raised by one after every tick that used more
+//    than shed_fraction of the budget and lowered by one after
+//    recovery_ticks consecutive ticks below recover_fraction, so quality
+//    drops quickly under load and returns gradually, without oscillating
+//    around a single threshold;
+//  - within a tick, an optional stage whose estimated cost no longer fits
+//    the time left is skipped for that tick only; every such skip decays
+//    the estimate, so the stage is probed again after an outlier.
+//
+// Mandatory stages always run. Work outside the stage bookkeeping (e.g. a
+// session pool's unfocused listeners) follows the level through allows().
+// One thread owns the tick; shouldRun and recordStage may be called from
+// the workers of a parallel tick, and the getters from any thread.
+class DeadlineScheduler {
+public:
+    using StageId = size_t;
+    static constexpr size_t kMaxStages = 64;
+    static constexpr StageId npos = static_cast<size_t>(-1);
+
+private:
+    struct StageSlot {
+        std::string name;
+        std::atomic<OptionalWork> work;
+        std::atomic<uint64_t> estimate_ns;
+        std::atomic<uint64_t> runs;
+        std::atomic<uint64_t> shed;
+
+        StageSlot() : work(OptionalWork::MANDATORY), estimate_ns(0), runs(0), shed(0) {}
+    };
+
+    DeadlineOptions options_;
+    std::atomic<uint64_t> budget_ns_;
+    std::atomic<int> level_;
+    uint32_t calm_ticks_;                       // Tick owner only
+    std::atomic<uint64_t> tick_start_ns_;
+
+    std::mutex stage_mutex_;                    // Registration only
+    std::array<StageSlot, kMaxStages> stages_;
+    std::atomic<size_t> stage_count_;
+
+    std::atomic<uint64_t> ticks_;
+    std::atomic<uint64_t> deadline_misses_;
+    std::atomic<uint64_t> shed_stages_;
+    std::atomic<uint64_t> level_changes_;
+    std::atomic<uint64_t> last_tick_ns_;
+    std::atomic<uint64_t> average_tick_ns_;
+
+    GaugeSlot* level_metric_;
+    CounterSlot* miss_metric_;
+    CounterSlot* shed_metric_;
+
+public:
+    explicit DeadlineScheduler(const DeadlineOptions& options = DeadlineOptions());
+
+    DeadlineScheduler(const DeadlineScheduler&) = delete;
+    DeadlineScheduler& operator=(const DeadlineScheduler&) = delete;
+
+    // Stage bookkeeping; npos when the table is full (such a stage always runs)
+    StageId addStage(const std::string& name, OptionalWork work = OptionalWork::MANDATORY);
+    void setStageWork(StageId stage, OptionalWork work);
+    size_t getStageCount() const { return stage_count_.load(std::memory_order_acquire); }
+
+    void setBudget(uint64_t budget_ns) { budget_ns_.store(budget_ns, std::memory_order_relaxed); }
+    uint64_t getBudget() const { return budget_ns_.load(std::memory_order_relaxed); }
+
+    // Tick bracket; endTick measures the tick and adjusts the level
+    void beginTick();
+    void endTick();
+
+    // Feed a tick cost measured elsewhere (endTick calls this)
+    void recordTick(uint64_t tick_ns);
+
+    // Whether a stage should run in the current tick; a refusal counts as shed
+    bool shouldRun(StageId stage);
+    void recordStage(StageId stage, uint64_t duration_ns);
+
+    // shouldRun, then time function() into recordStage; false when shed
+    template<typename Function>
+    bool runStage(StageId stage, Function&& function) {
+        if (!shouldRun(stage)) {
+            return false;
+        }
+        uint64_t start = now();
+        function();
+        recordStage(stage, now() - start);
+        return true;
+    }
+
+    int getLevel() const { return level_.load(std::memory_order_relaxed); }
+    bool allows(OptionalWork work) const {
+        return work == OptionalWork::MANDATORY || static_cast<int>(work) > getLevel();
+    }
+
+    DeadlineStatistics getStatistics() const;
+    std::vector<DeadlineStageCost> getStageCosts() const;
+
+    // Brackets one tick
+    class TickScope {
+    public:
+        explicit TickScope(DeadlineScheduler& scheduler) : scheduler_(scheduler) { scheduler_.beginTick(); }
+        ~TickScope() { scheduler_.endTick(); }
+
+        TickScope(const TickScope&) = delete;
+        TickScope& operator=(const TickScope&) = delete;
+
+    private:
+        DeadlineScheduler& scheduler_;
+    };
+
+private:
+    static uint64_t now();
+    void changeLevel(int level);
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,360 @@
+#include "effects_chain.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+// Longest echo spacing for the documented parameter range (seconds at 1.0)
+constexpr double kMaxEchoDelaySeconds = 1.0;
+
+// Reverb wet level and echo first-tap gain at amount 1.0
+constexpr double kReverbWetLevel = 0.3;
+constexpr double kEchoLevel = 0.3;
+
+// Tempo multipliers this close to 1 leave the block untouched
+constexpr double kTempoTolerance = 0.01;
+
+// Shelf corners and the gain at boost 1.0
+constexpr double kBassShelfFrequency = 200.0;
+constexpr double kTrebleShelfFrequency = 4000.0;
+constexpr double kMaxShelfGainDb = 12.0;
+
+// Keep a corner below Nyquist for low sample rates
+double shelfFrequency(double frequency, size_t sample_rate) {
+    return std::min(frequency, 0.45 * static_cast<double>(sample_rate));
+}
+
+} // namespace
+
+template<typename Sample>
+BasicEffectsChain<Sample>::BasicEffectsChain(size_t sample_rate, size_t channels)
+    : sample_rate_(sample_rate)
+    , channels_(0)
+    , volume_gain_(1)
+    , reverb_wet_(0)
+    , tempo_resamplers_(1)
+    , reverb_(sample_rate)
+    , echo_(static_cast<size_t>(sample_rate * kMaxEchoDelaySeconds)) {
+
+    std::fill(bypass_, bypass_ + kStageCount, false);
+    echo_.setLevel(kEchoLevel);
+
+    // Shelves start neutral; setParameters designs them once a boost is set
+    setParameters(AdaptationParameters());
+    setChannelCount(channels);
+}
+
+template<typename Sample>
+void BasicEffectsChain<Sample>::setChannelCount(size_t channels) {
+    channels = std::max<size_t>(1, channels);
+    if (channels == channels_) {
+        return;
+    }
+    channels_ = channels;
+
+    // Every lane runs the current tempo ratio from an empty history
+    tempo_resamplers_.resize(1);
+    tempo_resamplers_[0].reset();
+    tempo_resamplers_.resize(channels_, tempo_resamplers_[0]);
+    bass_shelf_.setChannelCount(channels_);
+    treble_shelf_.setChannelCount(channels_);
+    reverb_.setChannelCount(channels_);
+    echo_.setChannelCount(channels_);
+
+    frame_wet_.assign(channels_, Sample(0));
+    planar_chunk_.assign(channels_ > 1 ? kPlanarChunk * channels_ : 0, Sample(0));
+    channel_output_.resize(channels_);
+}
+
+template<typename Sample>
+void BasicEffectsChain<Sample>::setParameters(const AdaptationParameters& parameters) {
+    // Shelf design costs a few transcendental calls; skip it when unchanged
+    const double rate = static_cast<double>(sample_rate_);
+    if (parameters.bass_boost != parameters_.bass_boost) {
+        bass_shelf_.setCoefficients(BiquadCoefficients::lowShelf(
+            rate, shelfFrequency(kBassShelfFrequency, sample_rate_),
+            kMaxShelfGainDb * std::max(0.0, parameters.bass_boost)));
+    }
+    if (parameters.treble_boost != parameters_.treble_boost) {
+        treble_shelf_.setCoefficients(BiquadCoefficients::highShelf(
+            rate, shelfFrequency(kTrebleShelfFrequency, sample_rate_),
+            kMaxShelfGainDb * std::max(0.0, parameters.treble_boost)));
+    }
+
+    // The filter bank is rebuilt only when the resampling fraction changes
+    if (parameters.tempo_multiplier > 0.0) {
+        for (BasicPolyphaseResampler<Sample>& resampler : tempo_resamplers_) {
+            resampler.setRatio(1.0 / parameters.tempo_multiplier);
+        }
+    }
+
+    parameters_ = parameters;
+    volume_gain_ = static_cast<Sample>(parameters.volume_multiplier);
+
+    reverb_wet_ = static_cast<Sample>(kReverbWetLevel * std::max(0.0, parameters.reverb_amount));
+
+    double echo_delay = std::max(0.0, parameters.echo_delay);
+    echo_.setDelay(static_cast<size_t>(sample_rate_ * echo_delay));
+}
+
+template<typename Sample>
+void BasicEffectsChain<Sample>::setBypass(EffectStage stage, bool bypass) {
+    bypass_[static_cast<size_t>(stage)] = bypass;
+}
+
+template<typename Sample>
+bool BasicEffectsChain<Sample>::isBypassed(EffectStage stage) const {
+    return bypass_[static_cast<size_t>(stage)];
+}
+
+template<typename Sample>
+bool BasicEffectsChain<Sample>::isActive(EffectStage stage) const {
+    if (isBypassed(stage)) {
+        return false;
+    }
+
+    switch (stage) {
+        case EffectStage::TEMPO:
+            return parameters_.tempo_multiplier > 0.0 &&
+                   std::abs(parameters_.tempo_multiplier - 1.0) >= kTempoTolerance;
+        case EffectStage::VOLUME:
+            return parameters_.volume_multiplier != 1.0;
+        case EffectStage::BASS_BOOST:
+            return parameters_.bass_boost > 0.0;
+        case EffectStage::TREBLE_BOOST:
+            return parameters_.treble_boost > 0.0;
+        case EffectStage::REVERB:
+            return parameters_.reverb_amount > 0.0;
+        case EffectStage::ECHO:
+            return parameters_.echo_delay > 0.0;
+    }
+    return false;
+}
+
+template<typename Sample>
+void BasicEffectsChain<Sample>::process(const Sample* input, size_t count, std::vector<Sample>& output) {
+    if (channels_ > 1) {
+        const size_t frame_count = count / channels_;
+        if (isActive(EffectStage::TEMPO)) {
+            size_t produced = resampleChannels(input, frame_count, channels_, 1);
+            output.resize(produced * channels_);
+            for (size_t c = 0; c < channels_; ++c) {
+                const Sample* source = channel_output_[c].data();
+                for (size_t frame = 0; frame < produced; ++frame) {
+                    output[frame * channels_ + c] = source[frame];
+                }
+            }
+        } else {
+            output.assign(input, input + frame_count * channels_);
+        }
+        processInterleaved(output.data(), output.size() / channels_);
+        return;
+    }
+
+    if (isActive(EffectStage::TEMPO)) {
+        applyTempo(input, count, output);
+    } else {
+        output.assign(input, input + count);
+    }
+
+    processInPlace(output.data(), output.size());
+}
+
+template<typename Sample>
+void BasicEffectsChain<Sample>::processInPlace(Sample* samples, size_t count) {
+    if (channels_ > 1) {
+        processInterleaved(samples, count / channels_);
+        return;
+    }
+
+    const bool volume = isActive(EffectStage::VOLUME);
+    const bool bass = isActive(EffectStage::BASS_BOOST);
+    const bool treble = isActive(EffectStage::TREBLE_BOOST);
+    const bool reverb = isActive(EffectStage::REVERB);
+    const bool echo = isActive(EffectStage::ECHO);
+
+    for (size_t i = 0; i < count; ++i) {
+        Sample x = samples[i];
+
+        if (volume) {
+            x *= volume_gain_;
+        }
+        if (bass) {
+            x = bass_shelf_.processSample(x);
+        }
+        if (treble) {
+            x = treble_shelf_.processSample(x);
+        }
+        if (reverb) {
+            x += reverb_wet_ * reverb_.processSample(x);
+        }
+        if (echo) {
+            x += echo_.processSample(x);
+        }
+
+        // Single clipping point for the whole chain
+        samples[i] = std::max(Sample(-1), std::min(Sample(1), x));
+    }
+}
+
+template<typename Sample>
+void BasicEffectsChain<Sample>::process(const BasicAudioBuffer<Sample>& input, BasicAudioBuffer<Sample>& output) {
+    setChannelCount(input.getChannelCount());
+    if (output.getLayout() != input.getLayout()) {
+        output = BasicAudioBuffer<Sample>(channels_, 0, input.getLayout());
+    }
+
+    if (isActive(EffectStage::TEMPO)) {
+        size_t produced = resampleChannels(input.data(), input.getFrameCount(),
+                                           input.getFrameStride(), input.getChannelStride());
+        output.resize(channels_, produced);
+        const size_t frame_stride = output.getFrameStride();
+        for (size_t c = 0; c < channels_; ++c) {
+            Sample* target = output.channel(c);
+            const Sample* source = channel_output_[c].data();
+            for (size_t frame = 0; frame < produced; ++frame) {
+                target[frame * frame_stride] = source[frame];
+            }
+        }
+    } else {
+        output.resize(channels_, input.getFrameCount());
+        std::copy(input.data(), input.data() + input.size(), output.data());
+    }
+
+    processInPlace(output);
+}
+
+template<typename Sample>
+void BasicEffectsChain<Sample>::processInPlace(BasicAudioBuffer<Sample>& buffer) {
+    setChannelCount(buffer.getChannelCount());
+    if (buffer.isInterleaved()) {
+        processInterleaved(buffer.data(), buffer.getFrameCount());
+    } else {
+        processPlanar(buffer.data(), buffer.getFrameCount());
+    }
+}
+
+template<typename Sample>
+void BasicEffectsChain<Sample>::processInterleaved(Sample* samples, size_t frame_count) {
+    if (channels_ == 1) {
+        processInPlace(samples, frame_count);
+        return;
+    }
+
+    const bool volume = isActive(EffectStage::VOLUME);
+    const bool bass = isActive(EffectStage::BASS_BOOST);
+    const bool treble = isActive(EffectStage::TREBLE_BOOST);
+    const bool reverb = isActive(EffectStage::REVERB);
+    const bool echo = isActive(EffectStage::ECHO);
+    const size_t channels = channels_;
+    const size_t count = frame_count * channels;
+
+    // Stage by stage over the block: each stage only depends on its own
+    // past, so this matches the fused per-sample order of the mono pass
+    if (volume) {
+        for (size_t i = 0; i < count; ++i) {
+            samples[i] *= volume_gain_;
+        }
+    }
+    if (bass) {
+        bass_shelf_.processInterleaved(samples, frame_count);
+    }
+    if (treble) {
+        treble_shelf_.processInterleaved(samples, frame_count);
+    }
+    if (reverb || echo) {
+        Sample* wet = frame_wet_.data();
+        for (size_t frame = 0; frame < frame_count; ++frame) {
+            Sample* x = samples + frame * channels;
+            if (reverb) {
+                reverb_.processFrame(x, wet);
+                for (size_t c = 0; c < channels; ++c) {
+                    x[c] += reverb_wet_ * wet[c];
+                }
+            }
+            if (echo) {
+                echo_.processFrame(x, wet);
+                for (size_t c = 0; c < channels; ++c) {
+                    x[c] += wet[c];
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = std::max(Sample(-1), std::min(Sample(1), samples[i]));
+    }
+}
+
+template<typename Sample>
+void BasicEffectsChain<Sample>::processPlanar(Sample* samples, size_t frame_count) {
+    if (channels_ == 1) {
+        processInPlace(samples, frame_count);
+        return;
+    }
+
+    // Short interleaved runs keep the channel lanes of every stage contiguous
+    const size_t channels = channels_;
+    Sample* chunk = planar_chunk_.data();
+    for (size_t start = 0; start < frame_count; start += kPlanarChunk) {
+        size_t frames = std::min(kPlanarChunk, frame_count - start);
+        for (size_t c = 0; c < channels; ++c) {
+            const Sample* source = samples + c * frame_count + start;
+            for (size_t frame = 0; frame < frames; ++frame) {
+                chunk[frame * channels + c] = source[frame];
+            }
+        }
+        processInterleaved(chunk, frames);
+        for (size_t c = 0; c < channels; ++c) {
+            Sample* target = samples + c * frame_count + start;
+            for (size_t frame = 0; frame < frames; ++frame) {
+                target[frame] = chunk[frame * channels + c];
+            }
+        }
+    }
+}
+
+template<typename Sample>
+void BasicEffectsChain<Sample>::reset() {
+    for (BasicPolyphaseResampler<Sample>& resampler : tempo_resamplers_) {
+        resampler.reset();
+    }
+    bass_shelf_.reset();
+    treble_shelf_.reset();
+
+    reverb_.reset();
+    echo_.reset();
+}
+
+template<typename Sample>
+void BasicEffectsChain<Sample>::applyTempo(const Sample* input, size_t count, std::vector<Sample>& output) {
+    output.clear();
+    output.reserve(tempo_resamplers_[0].maxOutputSize(count));
+    tempo_resamplers_[0].process(input, count, output);
+}
+
+template<typename Sample>
+size_t BasicEffectsChain<Sample>::resampleChannels(const Sample* input, size_t frame_count,
+                                                   size_t frame_stride, size_t channel_stride) {
+    // Every lane holds the same history and phase, so all produce the same count
+    channel_input_.resize(frame_count);
+    for (size_t c = 0; c < channels_; ++c) {
+        const Sample* source = input + c * channel_stride;
+        for (size_t frame = 0; frame < frame_count; ++frame) {
+            channel_input_[frame] = source[frame * frame_stride];
+        }
+        std::vector<Sample>& lane = channel_output_[c];
+        lane.clear();
+        lane.reserve(tempo_resamplers_[c].maxOutputSize(frame_count));
+        tempo_resamplers_[c].process(channel_input_.data(), frame_count, lane);
+    }
+    return channel_output_[0].size();
+}
+
+// Sample types used by AdaptiveAudioProcessor
+template class BasicEffectsChain<double>;
+template class BasicEffectsChain<float>;
+
+} // namespace AnantaSound
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "biquad_filter.hpp"
+#include "reverb_engine.hpp"
+#include "resampler.hpp"
+#include "audio_buffer.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace AnantaSound {
+
+// Параметры адаптации
+struct AdaptationParameters {
+    double volume_multiplier;      // Множитель громкости (0.0 - 2.0)
+    double tempo_multiplier;       // Множитель темпа (0.5 - 2.0)
+    double bass_boost;             // Усиление басов (0.0 - 1.0)
+    double treble_boost;           // Усиление высоких частот (0.0 - 1.0)
+    double reverb_amount;          // Количество реверберации (0.0 - 1.0)
+    double echo_delay;             // Задержка эха (0.0 - 1.0)
+
+    AdaptationParameters() : volume_multiplier(1.0), tempo_multiplier(1.0),
+                           bass_boost(0.0), treble_boost(0.0),
+                           reverb_amount(0.0), echo_delay(0.0) {}
+};
+
+// Stages of the effects chain, in processing order
+enum class EffectStage {
+    TEMPO,
+    VOLUME,
+    BASS_BOOST,
+    TREBLE_BOOST,
+    REVERB,
+    ECHO
+};
+
+// Effects chain for AdaptiveAudioProcessor.
+// The tempo stage, the only one that changes the block length, resamples
+// into the output buffer; all other stages then run fused in one in-place pass.
+// Filter, reverb, echo and tempo state is carried from block to block, so a
+// stream can be processed in blocks of any size. Samples are clipped to
+// [-1, 1] once, after the last stage.
+// A chain with several channels keeps one state lane per channel in each
+// stage and processes interleaved or planar blocks stage by stage, with the
+// channel loop innermost, so the filters, reverb and echo vectorize across
+// channels. The raw-pointer calls then take interleaved samples.
+template<typename Sample>
+class BasicEffectsChain {
+private:
+    static constexpr size_t kStageCount = 6;    // Entries of EffectStage
+    static constexpr size_t kPlanarChunk = 256; // Frames interleaved at a time for planar blocks
+
+    size_t sample_rate_;
+    size_t channels_;
+    AdaptationParameters parameters_;
+    bool bypass_[kStageCount];
+
+    // Per-stage coefficients, derived once per setParameters
+    Sample volume_gain_;
+    Sample reverb_wet_;
+
+    // State carried across blocks
+    // Ratio 1 / tempo_multiplier, one per channel; holds back getLatency() input samples
+    std::vector<BasicPolyphaseResampler<Sample>> tempo_resamplers_;
+    BasicBiquadFilter<Sample> bass_shelf_;      // Low shelf; redesigned only when bass_boost changes
+    BasicBiquadFilter<Sample> treble_shelf_;    // High shelf; redesigned only when treble_boost changes
+    BasicFDNReverb<Sample> reverb_;             // Tail length set by setReverbTime, level by reverb_amount
+    BasicMultiTapEcho<Sample> echo_;            // Tap spacing set by echo_delay
+
+    // Multichannel work areas, sized by setChannelCount
+    std::vector<Sample> frame_wet_;             // One frame of reverb or echo output
+    std::vector<Sample> planar_chunk_;          // kPlanarChunk interleaved frames
+    std::vector<Sample> channel_input_;         // One channel of a tempo block
+    std::vector<std::vector<Sample>> channel_output_;
+
+public:
+    explicit BasicEffectsChain(size_t sample_rate = 44100, size_t channels = 1);
+
+    // Resizes every stage and clears the carried state
+    void setChannelCount(size_t channels);
+    size_t getChannelCount() const { return channels_; }
+
+    // Parameters for subsequent blocks; the echo buffer only grows beyond
+    // the documented parameter range
+    void setParameters(const AdaptationParameters& parameters);
+    const AdaptationParameters& getParameters() const { return parameters_; }
+
+    // Reverb decay time T60 in seconds (e.g. from DomeAcousticResonator)
+    void setReverbTime(double seconds) { reverb_.setDecayTime(seconds); }
+    double getReverbTime() const { return reverb_.getDecayTime(); }
+
+    // Per-stage bypass; a bypassed stage keeps its state untouched
+    void setBypass(EffectStage stage, bool bypass);
+    bool isBypassed(EffectStage stage) const;
+
+    // Whether the stage currently changes the signal (not bypassed, non-neutral)
+    bool isActive(EffectStage stage) const;
+
+    // Process one block into `output`, reusing its capacity.
+    // `input` must not point into `output`. With several channels, count
+    // is in samples of interleaved frames.
+    void process(const Sample* input, size_t count, std::vector<Sample>& output);
+
+    // Fused in-place pass over every stage except tempo
+    void processInPlace(Sample* samples, size_t count);
+
+    // Multichannel counterparts; the buffer's channel count must match the
+    // chain's. `output` takes the layout of `input`.
+    void process(const BasicAudioBuffer<Sample>& input, BasicAudioBuffer<Sample>& output);
+    void processInPlace(BasicAudioBuffer<Sample>& buffer);
+
+    // In-place passes over raw frames of getChannelCount() samples; planar
+    // blocks are channel-major (channel c starts at c * frame_count)
+    void processInterleaved(Sample* samples, size_t frame_count);
+    void processPlanar(Sample* samples, size_t frame_count);
+
+    // Clear all carried state (e.g. after a seek)
+    void reset();
+
+    size_t getSampleRate() const { return sample_rate_; }
+
+private:
+    // Resample for the tempo multiplier (windowed-sinc polyphase)
+    void applyTempo(const Sample* input, size_t count, std::vector<Sample>& output);
+    // Resample every channel of a strided block into channel_output_;
+    // returns the frames produced
+    size_t resampleChannels(const Sample* input, size_t frame_count, size_t frame_stride, size_t channel_stride);
+};
+
+// Instantiated in effects_chain.cpp
+extern template class BasicEffectsChain<double>;
+extern template class BasicEffectsChain<float>;
+
+using EffectsChain = BasicEffectsChain<double>;
+using EffectsChainF = BasicEffectsChain<float>;
+
+} // namespace AnantaSound
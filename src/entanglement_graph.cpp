@@ -0,0 +1,191 @@
+#include "entanglement_graph.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace AnantaSound {
+
+// SlotIndex implementation
+SlotHandle SlotIndex::insert() {
+    uint32_t slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots_.size());
+        slots_.push_back({kFreeSlot, 0});
+    }
+    slots_[slot].dense = static_cast<uint32_t>(dense_to_slot_.size());
+    dense_to_slot_.push_back(slot);
+    return {slot, slots_[slot].generation};
+}
+
+size_t SlotIndex::erase(SlotHandle handle, size_t& moved_from) {
+    size_t index = find(handle);
+    if (index == npos) {
+        return npos;
+    }
+
+    // Swap-and-pop: the last element takes the freed dense position
+    moved_from = dense_to_slot_.size() - 1;
+    uint32_t moved_slot = dense_to_slot_[moved_from];
+    dense_to_slot_[index] = moved_slot;
+    slots_[moved_slot].dense = static_cast<uint32_t>(index);
+    dense_to_slot_.pop_back();
+
+    Slot& slot = slots_[handle.slot];
+    slot.dense = kFreeSlot;
+    ++slot.generation;
+    free_slots_.push_back(handle.slot);
+    return index;
+}
+
+size_t SlotIndex::find(SlotHandle handle) const {
+    if (handle.slot >= slots_.size()) {
+        return npos;
+    }
+    const Slot& slot = slots_[handle.slot];
+    if (slot.dense == kFreeSlot || slot.generation != handle.generation) {
+        return npos;
+    }
+    return slot.dense;
+}
+
+SlotHandle SlotIndex::handleAt(size_t dense_index) const {
+    uint32_t slot = dense_to_slot_[dense_index];
+    return {slot, slots_[slot].generation};
+}
+
+void SlotIndex::clear() {
+    // Bump every live generation so outstanding handles go stale
+    free_slots_.clear();
+    for (uint32_t slot = 0; slot < slots_.size(); ++slot) {
+        if (slots_[slot].dense != kFreeSlot) {
+            ++slots_[slot].generation;
+            slots_[slot].dense = kFreeSlot;
+        }
+        free_slots_.push_back(static_cast<uint32_t>(slots_.size() - 1 - slot));
+    }
+    dense_to_slot_.clear();
+}
+
+// EntanglementGraph implementation
+uint64_t EntanglementGraph::edgeKey(uint32_t a, uint32_t b) {
+    if (a > b) {
+        std::swap(a, b);
+    }
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+void EntanglementGraph::ensureNode(uint32_t node) {
+    if (node >= adjacency_.size()) {
+        size_t old_size = adjacency_.size();
+        adjacency_.resize(static_cast<size_t>(node) + 1);
+        parent_.resize(adjacency_.size());
+        rank_.resize(adjacency_.size(), 0);
+        std::iota(parent_.begin() + old_size, parent_.end(), static_cast<uint32_t>(old_size));
+    }
+}
+
+bool EntanglementGraph::addEdge(uint32_t a, uint32_t b) {
+    if (a == b || !edges_.insert(edgeKey(a, b)).second) {
+        return false;
+    }
+    ensureNode(std::max(a, b));
+    adjacency_[a].push_back(b);
+    adjacency_[b].push_back(a);
+    if (!components_stale_) {
+        unite(a, b);
+    }
+    return true;
+}
+
+void EntanglementGraph::eraseNeighbor(std::vector<uint32_t>& list, uint32_t node) {
+    auto it = std::find(list.begin(), list.end(), node);
+    if (it != list.end()) {
+        *it = list.back();
+        list.pop_back();
+    }
+}
+
+bool EntanglementGraph::removeEdge(uint32_t a, uint32_t b) {
+    if (edges_.erase(edgeKey(a, b)) == 0) {
+        return false;
+    }
+    eraseNeighbor(adjacency_[a], b);
+    eraseNeighbor(adjacency_[b], a);
+    components_stale_ = true;
+    return true;
+}
+
+void EntanglementGraph::removeNode(uint32_t node) {
+    if (node >= adjacency_.size() || adjacency_[node].empty()) {
+        return;
+    }
+    for (uint32_t partner : adjacency_[node]) {
+        edges_.erase(edgeKey(node, partner));
+        eraseNeighbor(adjacency_[partner], node);
+    }
+    adjacency_[node].clear();
+    components_stale_ = true;
+}
+
+const std::vector<uint32_t>& EntanglementGraph::partners(uint32_t node) const {
+    static const std::vector<uint32_t> kNoPartners;
+    return node < adjacency_.size() ? adjacency_[node] : kNoPartners;
+}
+
+bool EntanglementGraph::connected(uint32_t a, uint32_t b) const {
+    if (a == b) {
+        return true;
+    }
+    if (a >= adjacency_.size() || b >= adjacency_.size()) {
+        return false;
+    }
+    if (components_stale_) {
+        rebuildComponents();
+    }
+    return findRoot(a) == findRoot(b);
+}
+
+void EntanglementGraph::clear() {
+    adjacency_.clear();
+    edges_.clear();
+    parent_.clear();
+    rank_.clear();
+    components_stale_ = false;
+}
+
+uint32_t EntanglementGraph::findRoot(uint32_t node) const {
+    // Path halving
+    while (parent_[node] != node) {
+        parent_[node] = parent_[parent_[node]];
+        node = parent_[node];
+    }
+    return node;
+}
+
+void EntanglementGraph::unite(uint32_t a, uint32_t b) const {
+    uint32_t root_a = findRoot(a);
+    uint32_t root_b = findRoot(b);
+    if (root_a == root_b) {
+        return;
+    }
+    if (rank_[root_a] < rank_[root_b]) {
+        std::swap(root_a, root_b);
+    }
+    parent_[root_b] = root_a;
+    if (rank_[root_a] == rank_[root_b]) {
+        ++rank_[root_a];
+    }
+}
+
+void EntanglementGraph::rebuildComponents() const {
+    std::iota(parent_.begin(), parent_.end(), 0u);
+    std::fill(rank_.begin(), rank_.end(), 0u);
+    for (uint64_t key : edges_) {
+        unite(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key));
+    }
+    components_stale_ = false;
+}
+
+} // namespace AnantaSound
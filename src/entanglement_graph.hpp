@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace AnantaSound {
+
+// Stable reference to an element of a densely packed collection.
+// The generation changes whenever the slot is reused, so a handle to a
+// removed element never aliases the element that later takes its slot.
+struct SlotHandle {
+    uint32_t slot = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool operator==(const SlotHandle& other) const { return slot == other.slot && generation == other.generation; }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+// Handle <-> dense index mapping for collections stored as packed arrays.
+// The owner keeps its data in [0, size()) and mirrors erase() with a
+// swap-and-pop: the element at the returned `moved_from` index (the last
+// one) moves into the erased position. Insert and erase are O(1).
+class SlotIndex {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+private:
+    struct Slot {
+        uint32_t dense;         // Dense index, or kFreeSlot
+        uint32_t generation;
+    };
+    static constexpr uint32_t kFreeSlot = UINT32_MAX;
+
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+    std::vector<uint32_t> dense_to_slot_;
+
+public:
+    // Handle for a new element appended at dense index size()
+    SlotHandle insert();
+
+    // Remove the element; returns its dense index, or npos for a stale handle.
+    // moved_from receives the index of the element that now fills the gap
+    // (equal to the returned index when the last element was removed).
+    size_t erase(SlotHandle handle, size_t& moved_from);
+
+    // Dense index of a live handle, or npos
+    size_t find(SlotHandle handle) const;
+    bool contains(SlotHandle handle) const { return find(handle) != npos; }
+
+    SlotHandle handleAt(size_t dense_index) const;
+    SlotHandle handleForSlot(uint32_t slot) const { return {slot, slots_[slot].generation}; }
+
+    size_t size() const { return dense_to_slot_.size(); }
+    bool empty() const { return dense_to_slot_.empty(); }
+    size_t slotCapacity() const { return slots_.size(); }
+    void clear();
+};
+
+// Undirected entanglement graph over slot ids.
+// Adjacency lists answer "partners of X" in O(degree), a hash set of edge
+// keys rejects duplicate pairs in O(1), and a union-find forest answers
+// component queries in near-constant amortized time. Adding edges updates
+// the forest incrementally; removals mark it stale and the next component
+// query rebuilds it in O(V + E).
+class EntanglementGraph {
+private:
+    std::vector<std::vector<uint32_t>> adjacency_;
+    std::unordered_set<uint64_t> edges_;
+
+    mutable std::vector<uint32_t> parent_;
+    mutable std::vector<uint32_t> rank_;
+    mutable bool components_stale_ = false;
+
+public:
+    // Returns false for self-pairs and for pairs that are already connected by an edge
+    bool addEdge(uint32_t a, uint32_t b);
+    bool removeEdge(uint32_t a, uint32_t b);
+    bool hasEdge(uint32_t a, uint32_t b) const { return edges_.count(edgeKey(a, b)) != 0; }
+
+    // Drop every edge of a node (its id may then be reused)
+    void removeNode(uint32_t node);
+
+    const std::vector<uint32_t>& partners(uint32_t node) const;
+    bool connected(uint32_t a, uint32_t b) const;
+
+    size_t edgeCount() const { return edges_.size(); }
+    void clear();
+
+private:
+    static uint64_t edgeKey(uint32_t a, uint32_t b);
+    void ensureNode(uint32_t node);
+    static void eraseNeighbor(std::vector<uint32_t>& list, uint32_t node);
+    uint32_t findRoot(uint32_t node) const;
+    void unite(uint32_t a, uint32_t b) const;
+    void rebuildComponents() const;
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,191 @@
+#include "envelope_decimator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+// Fixed-point scale of CIC inputs; with the factor limit below the order 3
+// gain keeps every output inside int64
+constexpr double kFixedPointScale = 16777216.0;     // 2^24
+constexpr size_t kMaxCICFactor = 2048;
+
+} // namespace
+
+// CICDecimator
+CICDecimator::CICDecimator(size_t factor)
+    : factor_(std::min(std::max<size_t>(factor, 1), kMaxCICFactor))
+    , phase_(0) {
+    double gain = 1.0;
+    for (size_t stage = 0; stage < kOrder; ++stage) {
+        gain *= static_cast<double>(factor_);
+    }
+    output_scale_ = 1.0 / (gain * kFixedPointScale);
+    reset();
+}
+
+bool CICDecimator::push(double sample, double& output) {
+    double clamped = std::max(-kInputLimit, std::min(kInputLimit, sample));
+    uint64_t value = static_cast<uint64_t>(static_cast<int64_t>(std::llround(clamped * kFixedPointScale)));
+
+    // Unsigned wrap-around is exact modular arithmetic
+    for (uint64_t& integrator : integrators_) {
+        integrator += value;
+        value = integrator;
+    }
+    if (++phase_ < factor_) {
+        return false;
+    }
+    phase_ = 0;
+
+    for (uint64_t& previous : combs_) {
+        uint64_t difference = value - previous;
+        previous = value;
+        value = difference;
+    }
+    output = static_cast<double>(static_cast<int64_t>(value)) * output_scale_;
+    return true;
+}
+
+void CICDecimator::reset() {
+    integrators_.fill(0);
+    combs_.fill(0);
+    phase_ = 0;
+}
+
+// HalfBandDecimator
+HalfBandDecimator::HalfBandDecimator() {
+    reset();
+}
+
+const std::array<double, HalfBandDecimator::kTaps>& HalfBandDecimator::coefficients() {
+    static const std::array<double, kTaps> taps = []() {
+        std::array<double, kTaps> h{};
+        const int centre = static_cast<int>(kTaps / 2);
+        const double span = static_cast<double>(kTaps + 1);
+        double sum = 0.0;
+        for (int n = 0; n < static_cast<int>(kTaps); ++n) {
+            int offset = n - centre;
+            // Sinc at a quarter of the input rate: even offsets other than 0 vanish
+            double sinc = offset == 0 ? 0.5
+                                      : (offset % 2 == 0 ? 0.0 : std::sin(M_PI * offset / 2.0) / (M_PI * offset));
+            double x = static_cast<double>(n + 1) / span;
+            double window = 0.42 - 0.5 * std::cos(2.0 * M_PI * x) + 0.08 * std::cos(4.0 * M_PI * x);
+            h[n] = sinc * window;
+            sum += h[n];
+        }
+        for (double& tap : h) {
+            tap /= sum;
+        }
+        return h;
+    }();
+    return taps;
+}
+
+bool HalfBandDecimator::push(double sample, double& output) {
+    history_[position_] = sample;
+    position_ = (position_ + 1) % kTaps;
+    odd_ = !odd_;
+    if (odd_) {
+        return false;
+    }
+
+    // The table is symmetric, so the delay line's rotation does not matter
+    const std::array<double, kTaps>& taps = coefficients();
+    double sum = 0.0;
+    for (size_t k = 0; k < kTaps; ++k) {
+        size_t index = position_ + k < kTaps ? position_ + k : position_ + k - kTaps;
+        sum += taps[k] * history_[index];
+    }
+    output = sum;
+    return true;
+}
+
+void HalfBandDecimator::reset() {
+    history_.fill(0.0);
+    position_ = 0;
+    odd_ = false;
+}
+
+// EnvelopeDecimator
+EnvelopeDecimator::EnvelopeDecimator(size_t input_rate, double target_rate)
+    : input_rate_(std::max<size_t>(input_rate, 1))
+    , cic_(static_cast<size_t>(std::llround(static_cast<double>(std::max<size_t>(input_rate, 1)) /
+                                            (std::max(target_rate, 1e-3) * (1 << kHalfBandStages))))) {
+}
+
+double EnvelopeDecimator::getOutputRate() const {
+    return static_cast<double>(input_rate_) / static_cast<double>(getDecimation());
+}
+
+size_t EnvelopeDecimator::process(const double* samples, size_t sample_count, std::vector<double>& envelope) {
+    return processSamples(samples, sample_count, envelope);
+}
+
+size_t EnvelopeDecimator::process(const float* samples, size_t sample_count, std::vector<double>& envelope) {
+    return processSamples(samples, sample_count, envelope);
+}
+
+size_t EnvelopeDecimator::process(const AudioBuffer& buffer, std::vector<double>& envelope) {
+    return processFrames(buffer, envelope);
+}
+
+size_t EnvelopeDecimator::process(const AudioBufferF& buffer, std::vector<double>& envelope) {
+    return processFrames(buffer, envelope);
+}
+
+template<typename Sample>
+size_t EnvelopeDecimator::processSamples(const Sample* samples, size_t sample_count, std::vector<double>& envelope) {
+    size_t produced = 0;
+    for (size_t i = 0; i < sample_count; ++i) {
+        double energy = static_cast<double>(samples[i]) * static_cast<double>(samples[i]);
+        produced += pushEnergy(energy, envelope);
+    }
+    return produced;
+}
+
+template<typename Sample>
+size_t EnvelopeDecimator::processFrames(const BasicAudioBuffer<Sample>& buffer, std::vector<double>& envelope) {
+    const size_t channels = buffer.getChannelCount();
+    const size_t frame_stride = buffer.getFrameStride();
+    const size_t channel_stride = buffer.getChannelStride();
+    const double scale = 1.0 / static_cast<double>(channels);
+    const Sample* samples = buffer.data();
+
+    size_t produced = 0;
+    for (size_t frame = 0; frame < buffer.getFrameCount(); ++frame) {
+        const Sample* first = samples + frame * frame_stride;
+        double energy = 0.0;
+        for (size_t c = 0; c < channels; ++c) {
+            double sample = static_cast<double>(first[c * channel_stride]);
+            energy += sample * sample;
+        }
+        produced += pushEnergy(energy * scale, envelope);
+    }
+    return produced;
+}
+
+bool EnvelopeDecimator::pushEnergy(double energy, std::vector<double>& envelope) {
+    double value;
+    if (!cic_.push(energy, value)) {
+        return false;
+    }
+    for (HalfBandDecimator& stage : half_bands_) {
+        if (!stage.push(value, value)) {
+            return false;
+        }
+    }
+    // Half-band ripple may dip just below zero on a step
+    envelope.push_back(std::sqrt(std::max(0.0, value)));
+    return true;
+}
+
+void EnvelopeDecimator::reset() {
+    cic_.reset();
+    for (HalfBandDecimator& stage : half_bands_) {
+        stage.reset();
+    }
+}
+
+} // namespace AnantaSound
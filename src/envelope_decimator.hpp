@@ -0,0 +1,102 @@
+#pragma once
+
+#include "audio_buffer.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AnantaSound {
+
+// Cascaded integrator-comb decimator (order 3, differential delay 1).
+// The integrators run in wrapping 64-bit fixed point, so they never drift
+// however long the stream runs; the combs undo the wrap exactly. Output is
+// normalized to unity DC gain. Inputs are clamped to +-kInputLimit.
+class CICDecimator {
+public:
+    static constexpr size_t kOrder = 3;
+    static constexpr double kInputLimit = 16.0;
+
+private:
+    size_t factor_;
+    size_t phase_;
+    double output_scale_;
+    std::array<uint64_t, kOrder> integrators_;
+    std::array<uint64_t, kOrder> combs_;        // Previous comb inputs
+
+public:
+    explicit CICDecimator(size_t factor = 1);
+
+    // One input sample; true when `output` holds a new decimated sample
+    bool push(double sample, double& output);
+    void reset();
+
+    size_t getFactor() const { return factor_; }
+};
+
+// Decimate-by-two half-band FIR (windowed sinc, kTaps taps). Every other
+// tap is zero, so each output costs kTaps / 2 + 1 multiplies.
+class HalfBandDecimator {
+public:
+    static constexpr size_t kTaps = 15;
+
+private:
+    std::array<double, kTaps> history_;
+    size_t position_;
+    bool odd_;
+
+public:
+    HalfBandDecimator();
+
+    // One input sample; true when `output` holds a new decimated sample
+    bool push(double sample, double& output);
+    void reset();
+
+    // Shared coefficient table (symmetric, unity DC gain)
+    static const std::array<double, kTaps>& coefficients();
+};
+
+// Streaming RMS envelope at a low rate. The input is squared, the energy is
+// decimated by a CIC stage and kHalfBandStages half-band stages, and the
+// square root of the result is the envelope. The CIC factor is chosen so the
+// output rate lands near target_rate; state carries across calls, so the
+// stream may arrive in blocks of any size. Per input sample the cost is a
+// square and three integer adds.
+class EnvelopeDecimator {
+public:
+    static constexpr size_t kHalfBandStages = 2;
+
+private:
+    size_t input_rate_;
+    CICDecimator cic_;
+    std::array<HalfBandDecimator, kHalfBandStages> half_bands_;
+
+public:
+    explicit EnvelopeDecimator(size_t input_rate = 44100, double target_rate = 25.0);
+
+    // Append the envelope samples completed by this block; returns how many
+    size_t process(const double* samples, size_t sample_count, std::vector<double>& envelope);
+    size_t process(const float* samples, size_t sample_count, std::vector<double>& envelope);
+
+    // Multichannel blocks: the energy of a frame is the mean square over
+    // its channels, so the envelope is the RMS of the whole array
+    size_t process(const AudioBuffer& buffer, std::vector<double>& envelope);
+    size_t process(const AudioBufferF& buffer, std::vector<double>& envelope);
+
+    void reset();
+
+    size_t getInputRate() const { return input_rate_; }
+    size_t getDecimation() const { return cic_.getFactor() << kHalfBandStages; }
+    double getOutputRate() const;
+
+private:
+    template<typename Sample>
+    size_t processSamples(const Sample* samples, size_t sample_count, std::vector<double>& envelope);
+    template<typename Sample>
+    size_t processFrames(const BasicAudioBuffer<Sample>& buffer, std::vector<double>& envelope);
+
+    // Decimate one energy value; true when an envelope sample was appended
+    bool pushEnergy(double energy, std::vector<double>& envelope);
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,288 @@
+#include "feature_cache.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AnantaSound {
+
+namespace {
+
+static_assert(sizeof(FeatureCacheHeader) == 64, "FeatureCacheHeader is part of the file format");
+
+constexpr uint64_t kHashPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kHashPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr size_t kHashBlock = 1 << 20;
+
+uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t mixWord(uint64_t hash, uint64_t word) {
+    return rotateLeft(hash ^ (word * kHashPrime2), 31) * kHashPrime1;
+}
+
+uint64_t finalizeHash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= kHashPrime2;
+    hash ^= hash >> 29;
+    hash *= kHashPrime1;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+} // namespace
+
+FeatureTable::FeatureTable()
+    : mapping_(nullptr)
+    , mapping_size_(0)
+    , data_(nullptr)
+    , sample_rate_(0)
+    , frame_count_(0)
+    , bin_count_(0) {
+}
+
+FeatureTable::~FeatureTable() {
+#if !defined(_WIN32)
+    if (mapping_ != nullptr) {
+        ::munmap(const_cast<uint8_t*>(mapping_), mapping_size_);
+    }
+#endif
+}
+
+bool FeatureTable::map(const std::string& path, const FeatureCacheKey& key) {
+#if defined(_WIN32)
+    (void)path;
+    (void)key;
+    return false;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(FeatureCacheHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(file_stat.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+    mapping_ = static_cast<const uint8_t*>(address);
+    mapping_size_ = size;
+
+    const auto* header = reinterpret_cast<const FeatureCacheHeader*>(mapping_);
+    FeatureCacheKey stored{header->content_hash, header->fft_size, header->hop_size, header->window};
+    size_t values = (size - sizeof(FeatureCacheHeader)) / sizeof(double);
+    if (std::memcmp(header->magic, kFeatureCacheMagic, sizeof(kFeatureCacheMagic)) != 0 ||
+        header->version != kFeatureCacheFormatVersion || header->byte_order != kFeatureCacheByteOrderMark ||
+        header->file_size != size || !(stored == key) || header->band_count != kFeatureBandCount ||
+        header->bin_count != header->fft_size / 2 + 1 ||
+        header->frame_count > values / (kFeatureColumnCount + kFeatureBandCount)) {
+        return false;
+    }
+
+    key_ = stored;
+    sample_rate_ = header->sample_rate;
+    frame_count_ = static_cast<size_t>(header->frame_count);
+    bin_count_ = header->bin_count;
+    data_ = reinterpret_cast<const double*>(mapping_ + sizeof(FeatureCacheHeader));
+    return sizeof(FeatureCacheHeader) + getValueCount() * sizeof(double) == size;
+#endif
+}
+
+FeatureTableBuilder::FeatureTableBuilder(const FeatureCacheKey& key, uint32_t sample_rate)
+    : key_(key)
+    , sample_rate_(sample_rate) {
+    // Band b spans bins [edge b, edge b+1), log-spaced from bin 1 to Nyquist
+    size_t bin_count = key.fft_size / 2 + 1;
+    band_edges_.resize(kFeatureBandCount + 1);
+    band_edges_[0] = 1;
+    for (size_t b = 1; b <= kFeatureBandCount; ++b) {
+        double ratio = static_cast<double>(b) / kFeatureBandCount;
+        size_t edge = static_cast<size_t>(std::pow(static_cast<double>(bin_count), ratio));
+        band_edges_[b] = std::min(bin_count, std::max(edge, band_edges_[b - 1] + 1));
+    }
+    band_edges_[kFeatureBandCount] = bin_count;
+}
+
+void FeatureTableBuilder::addFrame(const AudioAnalysisResult& frame) {
+    columns_[kFeatureVolume].push_back(frame.volume_level);
+    columns_[kFeatureCentroid].push_back(frame.spectral_centroid);
+    columns_[kFeatureRolloff].push_back(frame.spectral_rolloff);
+    columns_[kFeatureZeroCrossing].push_back(frame.zero_crossing_rate);
+    columns_[kFeatureTempo].push_back(frame.tempo);
+    columns_[kFeatureFundamental].push_back(frame.fundamental_frequency);
+
+    const std::vector<double>& magnitude = frame.magnitude_spectrum;
+    for (size_t b = 0; b < kFeatureBandCount; ++b) {
+        size_t begin = std::min(band_edges_[b], magnitude.size());
+        size_t end = std::min(band_edges_[b + 1], magnitude.size());
+        double sum = 0.0;
+        for (size_t k = begin; k < end; ++k) {
+            sum += magnitude[k];
+        }
+        bands_.push_back(end > begin ? sum / static_cast<double>(end - begin) : 0.0);
+    }
+
+    if (magnitude_sum_.empty()) {
+        magnitude_sum_.assign(magnitude.size(), 0.0);
+    }
+    for (size_t k = 0; k < magnitude_sum_.size() && k < magnitude.size(); ++k) {
+        magnitude_sum_[k] += magnitude[k];
+    }
+    last_phases_.assign(frame.phase_spectrum.begin(), frame.phase_spectrum.end());
+}
+
+std::shared_ptr<FeatureTable> FeatureTableBuilder::finish() {
+    auto table = std::make_shared<FeatureTable>();
+    table->key_ = key_;
+    table->sample_rate_ = sample_rate_;
+    table->frame_count_ = getFrameCount();
+    table->bin_count_ = key_.fft_size / 2 + 1;
+
+    std::vector<double>& data = table->owned_;
+    data.reserve(table->getValueCount());
+    for (auto& column : columns_) {
+        data.insert(data.end(), column.begin(), column.end());
+        column.clear();
+    }
+    data.insert(data.end(), bands_.begin(), bands_.end());
+    bands_.clear();
+
+    // Mean spectrum and last phases, zero-padded to bin_count
+    const double inv_frames = table->frame_count_ > 0 ? 1.0 / static_cast<double>(table->frame_count_) : 0.0;
+    for (size_t k = 0; k < table->bin_count_; ++k) {
+        data.push_back(k < magnitude_sum_.size() ? magnitude_sum_[k] * inv_frames : 0.0);
+    }
+    for (size_t k = 0; k < table->bin_count_; ++k) {
+        data.push_back(k < last_phases_.size() ? last_phases_[k] : 0.0);
+    }
+    magnitude_sum_.clear();
+    last_phases_.clear();
+
+    table->data_ = data.data();
+    return table;
+}
+
+FeatureCache::FeatureCache(const std::string& directory)
+    : directory_(directory)
+    , hits_(0)
+    , misses_(0) {
+}
+
+bool FeatureCache::hashFile(const std::string& path, uint64_t& hash) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    // Whole 8-byte words, the tail zero-padded; the length is folded in last
+    std::vector<char> block(kHashBlock);
+    uint64_t state = kHashPrime1;
+    uint64_t length = 0;
+    while (in) {
+        in.read(block.data(), static_cast<std::streamsize>(block.size()));
+        size_t count = static_cast<size_t>(in.gcount());
+        if (count == 0) {
+            break;
+        }
+        size_t padded = (count + 7) / 8 * 8;
+        std::fill(block.begin() + count, block.begin() + padded, 0);
+        for (size_t offset = 0; offset < padded; offset += 8) {
+            uint64_t word;
+            std::memcpy(&word, block.data() + offset, sizeof(word));
+            state = mixWord(state, word);
+        }
+        length += count;
+    }
+    if (in.bad()) {
+        return false;
+    }
+    hash = finalizeHash(state ^ length);
+    return true;
+}
+
+std::string FeatureCache::getEntryPath(const FeatureCacheKey& key) const {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << key.content_hash << std::dec
+         << "-" << key.fft_size << "-" << key.hop_size << "-" << key.window << ".anfeat";
+    return (std::filesystem::path(directory_) / name.str()).string();
+}
+
+std::shared_ptr<const FeatureTable> FeatureCache::load(const FeatureCacheKey& key) const {
+    auto table = std::make_shared<FeatureTable>();
+    if (!table->map(getEntryPath(key), key)) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return table;
+}
+
+bool FeatureCache::store(const FeatureTable& table) const {
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+
+    FeatureCacheHeader header{};
+    std::memcpy(header.magic, kFeatureCacheMagic, sizeof(kFeatureCacheMagic));
+    header.version = kFeatureCacheFormatVersion;
+    header.byte_order = kFeatureCacheByteOrderMark;
+    header.file_size = sizeof(FeatureCacheHeader) + table.getValueCount() * sizeof(double);
+    header.content_hash = table.key_.content_hash;
+    header.fft_size = table.key_.fft_size;
+    header.hop_size = table.key_.hop_size;
+    header.window = table.key_.window;
+    header.sample_rate = table.sample_rate_;
+    header.frame_count = table.frame_count_;
+    header.bin_count = static_cast<uint32_t>(table.bin_count_);
+    header.band_count = kFeatureBandCount;
+
+    std::string path = getEntryPath(table.key_);
+    std::string temporary = path + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to write feature cache entry: " << path << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(table.data_),
+                  static_cast<std::streamsize>(table.getValueCount() * sizeof(double)));
+        if (!out) {
+            out.close();
+            std::remove(temporary.c_str());
+            std::cerr << "Failed to write feature cache entry: " << path << std::endl;
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::remove(temporary.c_str());
+        std::cerr << "Failed to write feature cache entry: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace AnantaSound
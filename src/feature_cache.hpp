@@ -0,0 +1,172 @@
+#pragma once
+
+#include "audio_analyzer.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace AnantaSound {
+
+// On-disk cache of per-frame analysis features, so repeated analyses of the
+// same file skip decoding and FFT.
+//
+// An entry is keyed by the content hash of the audio file together with the
+// parameters that shape the frames (FFT size, hop size, window); changing
+// any of them selects a different entry, and entries for other parameters
+// stay valid. Renaming or touching a file does not invalidate its entries.
+//
+// Layout (native byte order, checked on open):
+//   FeatureCacheHeader | double block
+// The double block holds, in order: kFeatureColumnCount columns of
+// frame_count values, frame_count rows of band_count band magnitudes, the
+// long-term mean magnitude spectrum (bin_count) and the phase spectrum of
+// the last frame (bin_count). Entries are used in place through a
+// read-only mapping.
+constexpr char kFeatureCacheMagic[8] = {'A', 'N', 'F', 'E', 'A', 'T', 'S', '\0'};
+constexpr uint32_t kFeatureCacheFormatVersion = 3;   // 2: tracked tempo, 3: YIN fundamental
+constexpr uint32_t kFeatureCacheByteOrderMark = 0x01020304;
+
+// Analysis windows; part of the key
+enum FeatureWindow : uint32_t {
+    kFeatureWindowHann = 1,
+};
+
+// Log-spaced bands of the per-frame magnitude summary
+constexpr size_t kFeatureBandCount = 16;
+
+// Per-frame scalar features, one column each
+enum FeatureColumn : uint32_t {
+    kFeatureVolume, kFeatureCentroid, kFeatureRolloff, kFeatureZeroCrossing, kFeatureTempo, kFeatureFundamental,
+    kFeatureColumnCount
+};
+
+struct FeatureCacheKey {
+    uint64_t content_hash = 0;
+    uint32_t fft_size = 0;
+    uint32_t hop_size = 0;
+    uint32_t window = kFeatureWindowHann;
+
+    bool operator==(const FeatureCacheKey& other) const {
+        return content_hash == other.content_hash && fft_size == other.fft_size &&
+               hop_size == other.hop_size && window == other.window;
+    }
+};
+
+struct FeatureCacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t file_size;
+    uint64_t content_hash;
+    uint32_t fft_size;
+    uint32_t hop_size;
+    uint32_t window;
+    uint32_t sample_rate;       // Of the analyzed file
+    uint64_t frame_count;
+    uint32_t bin_count;
+    uint32_t band_count;
+};
+
+// Per-frame features of one file and its long-term spectrum; either built
+// by a FeatureTableBuilder or mapped from a cache entry
+class FeatureTable {
+private:
+    std::vector<double> owned_;
+    const uint8_t* mapping_;
+    size_t mapping_size_;
+    const double* data_;
+    FeatureCacheKey key_;
+    uint32_t sample_rate_;
+    size_t frame_count_;
+    size_t bin_count_;
+
+    friend class FeatureTableBuilder;
+    friend class FeatureCache;
+
+    bool map(const std::string& path, const FeatureCacheKey& key);
+
+public:
+    FeatureTable();
+    ~FeatureTable();
+
+    FeatureTable(const FeatureTable&) = delete;
+    FeatureTable& operator=(const FeatureTable&) = delete;
+
+    const FeatureCacheKey& getKey() const { return key_; }
+    uint32_t getSampleRate() const { return sample_rate_; }
+    size_t getFrameCount() const { return frame_count_; }
+    size_t getBinCount() const { return bin_count_; }
+    bool isMapped() const { return mapping_ != nullptr; }
+
+    // frame_count values
+    const double* column(FeatureColumn column) const { return data_ + column * frame_count_; }
+    // kFeatureBandCount band magnitudes of one frame
+    const double* bands(size_t frame) const {
+        return data_ + kFeatureColumnCount * frame_count_ + frame * kFeatureBandCount;
+    }
+    // Mean magnitude spectrum over all frames (bin_count values)
+    const double* meanMagnitudes() const {
+        return data_ + (kFeatureColumnCount + kFeatureBandCount) * frame_count_;
+    }
+    // Phase spectrum of the last frame (bin_count values)
+    const double* lastPhases() const { return meanMagnitudes() + bin_count_; }
+
+    // Doubles in the block described above
+    size_t getValueCount() const {
+        return (kFeatureColumnCount + kFeatureBandCount) * frame_count_ + 2 * bin_count_;
+    }
+};
+
+// Collects frames as they are analyzed and packs them into a FeatureTable
+class FeatureTableBuilder {
+private:
+    FeatureCacheKey key_;
+    uint32_t sample_rate_;
+    std::vector<double> columns_[kFeatureColumnCount];
+    std::vector<double> bands_;
+    std::vector<size_t> band_edges_;    // kFeatureBandCount + 1 bin indices
+    std::vector<double> magnitude_sum_;
+    std::vector<double> last_phases_;
+
+public:
+    FeatureTableBuilder(const FeatureCacheKey& key, uint32_t sample_rate);
+
+    void addFrame(const AudioAnalysisResult& frame);
+    size_t getFrameCount() const { return columns_[0].size(); }
+
+    // Table of the frames added so far; the builder is left empty
+    std::shared_ptr<FeatureTable> finish();
+};
+
+// Directory of cache entries, one file per key. Entries are written to a
+// temporary file and renamed into place, so concurrent readers and writers
+// never see a partial entry.
+class FeatureCache {
+private:
+    std::string directory_;
+    mutable std::atomic<uint64_t> hits_;
+    mutable std::atomic<uint64_t> misses_;
+
+public:
+    explicit FeatureCache(const std::string& directory);
+
+    // 64-bit content hash of a file; false when it cannot be read
+    static bool hashFile(const std::string& path, uint64_t& hash);
+
+    std::string getEntryPath(const FeatureCacheKey& key) const;
+
+    // Mapped entry for key, or nullptr when there is none (or it is invalid)
+    std::shared_ptr<const FeatureTable> load(const FeatureCacheKey& key) const;
+
+    // Write an entry for table's key; false on I/O error
+    bool store(const FeatureTable& table) const;
+
+    const std::string& getDirectory() const { return directory_; }
+    uint64_t getHits() const { return hits_.load(std::memory_order_relaxed); }
+    uint64_t getMisses() const { return misses_.load(std::memory_order_relaxed); }
+};
+
+} // namespace AnantaSound
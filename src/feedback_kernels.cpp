@@ -0,0 +1,260 @@
+#include "feedback_kernels.hpp"
+#include "simd_sincos.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+using namespace detail;
+
+// Frequency difference at which the frequency correlation halves, Hz
+constexpr double kFrequencyScale = 1000.0;
+
+// Contribution of feedback fields [start, count)
+std::complex<double> accumulateTail(const FeedbackSources& sources, size_t start,
+                                    const double* state_correlation,
+                                    double cos_phase, double sin_phase,
+                                    double frequency, double threshold) {
+    double re = 0.0, im = 0.0;
+    for (size_t j = start; j < sources.count; ++j) {
+        double phase_corr = cos_phase * sources.cos_phase[j] + sin_phase * sources.sin_phase[j];
+        double freq_corr = 1.0 / (1.0 + std::abs(frequency - sources.frequency[j]) / kFrequencyScale);
+        double correlation = std::clamp((phase_corr + freq_corr + state_correlation[j]) / 3.0, 0.0, 1.0);
+        if (correlation > threshold) {
+            re += correlation * sources.phasor_real[j];
+            im += correlation * sources.phasor_imag[j];
+        }
+    }
+    return std::complex<double>(re, im);
+}
+
+// Resonance of fields [start, count)
+double resonanceTail(const double* frequency, const double* phase, const double* amplitude,
+                     size_t start, size_t count, double reference_frequency, double reference_phase,
+                     double inverse_amplitude, double inverse_bandwidth) {
+    double total = 0.0;
+    for (size_t i = start; i < count; ++i) {
+        double freq_resonance = 1.0 / (1.0 + std::abs(frequency[i] - reference_frequency) * inverse_bandwidth);
+        double phase_resonance = std::cos(phase[i] - reference_phase);
+        double amp_resonance = std::min(amplitude[i] * inverse_amplitude, 1.0);
+        total += freq_resonance + phase_resonance + amp_resonance;
+    }
+    return total;
+}
+
+// ---- Scalar reference -------------------------------------------------------
+
+std::complex<double> accumulateScalar(const FeedbackSources& sources, const double* state_correlation,
+                                      double cos_phase, double sin_phase,
+                                      double frequency, double threshold) {
+    return accumulateTail(sources, 0, state_correlation, cos_phase, sin_phase, frequency, threshold);
+}
+
+double resonanceSumScalar(const double* frequency, const double* phase, const double* amplitude,
+                          size_t count, double reference_frequency, double reference_phase,
+                          double reference_amplitude, double bandwidth) {
+    return resonanceTail(frequency, phase, amplitude, 0, count, reference_frequency, reference_phase,
+                         1.0 / reference_amplitude, 1.0 / bandwidth) / 3.0;
+}
+
+#ifdef ANANTASOUND_X86_DISPATCH
+
+// ---- AVX2 -------------------------------------------------------------------
+
+__attribute__((target("avx2,fma")))
+std::complex<double> accumulateAVX2(const FeedbackSources& sources, const double* state_correlation,
+                                    double cos_phase, double sin_phase,
+                                    double frequency, double threshold) {
+    const __m256d c_in = _mm256_set1_pd(cos_phase);
+    const __m256d s_in = _mm256_set1_pd(sin_phase);
+    const __m256d f_in = _mm256_set1_pd(frequency);
+    const __m256d limit = _mm256_set1_pd(threshold);
+    const __m256d scale = _mm256_set1_pd(kFrequencyScale);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d three = _mm256_set1_pd(3.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d re = zero;
+    __m256d im = zero;
+
+    size_t j = 0;
+    for (; j + 4 <= sources.count; j += 4) {
+        __m256d phase_corr = _mm256_fmadd_pd(c_in, _mm256_loadu_pd(sources.cos_phase + j),
+                                             _mm256_mul_pd(s_in, _mm256_loadu_pd(sources.sin_phase + j)));
+        __m256d freq_diff = _mm256_andnot_pd(sign, _mm256_sub_pd(f_in, _mm256_loadu_pd(sources.frequency + j)));
+        __m256d freq_corr = _mm256_div_pd(one, _mm256_add_pd(one, _mm256_div_pd(freq_diff, scale)));
+        __m256d sum = _mm256_add_pd(_mm256_add_pd(phase_corr, freq_corr),
+                                    _mm256_loadu_pd(state_correlation + j));
+        __m256d correlation = _mm256_max_pd(_mm256_min_pd(_mm256_div_pd(sum, three), one), zero);
+
+        // Zero the correlation of pairs at or below the threshold
+        correlation = _mm256_and_pd(correlation, _mm256_cmp_pd(correlation, limit, _CMP_GT_OQ));
+        re = _mm256_fmadd_pd(correlation, _mm256_loadu_pd(sources.phasor_real + j), re);
+        im = _mm256_fmadd_pd(correlation, _mm256_loadu_pd(sources.phasor_imag + j), im);
+    }
+
+    alignas(32) double lane_re[4], lane_im[4];
+    _mm256_store_pd(lane_re, re);
+    _mm256_store_pd(lane_im, im);
+    std::complex<double> total(lane_re[0] + lane_re[1] + lane_re[2] + lane_re[3],
+                               lane_im[0] + lane_im[1] + lane_im[2] + lane_im[3]);
+    return total + accumulateTail(sources, j, state_correlation, cos_phase, sin_phase, frequency, threshold);
+}
+
+__attribute__((target("avx2,fma")))
+double resonanceSumAVX2(const double* frequency, const double* phase, const double* amplitude,
+                        size_t count, double reference_frequency, double reference_phase,
+                        double reference_amplitude, double bandwidth) {
+    const double inverse_amplitude = 1.0 / reference_amplitude;
+    const double inverse_bandwidth = 1.0 / bandwidth;
+    const __m256d f_ref = _mm256_set1_pd(reference_frequency);
+    const __m256d phi_ref = _mm256_set1_pd(reference_phase);
+    const __m256d inv_amp = _mm256_set1_pd(inverse_amplitude);
+    const __m256d inv_bw = _mm256_set1_pd(inverse_bandwidth);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d total = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d freq_diff = _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(frequency + i), f_ref));
+        __m256d freq_resonance = _mm256_div_pd(one, _mm256_fmadd_pd(freq_diff, inv_bw, one));
+        __m256d sn, c;
+        sincosAVX2(_mm256_sub_pd(_mm256_loadu_pd(phase + i), phi_ref), sn, c);
+        // min(x, 1) with x second so a NaN ratio propagates like std::min
+        __m256d amp_resonance = _mm256_min_pd(one, _mm256_mul_pd(_mm256_loadu_pd(amplitude + i), inv_amp));
+        total = _mm256_add_pd(total, _mm256_add_pd(_mm256_add_pd(freq_resonance, c), amp_resonance));
+    }
+
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, total);
+    double sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    sum += resonanceTail(frequency, phase, amplitude, i, count, reference_frequency, reference_phase,
+                         inverse_amplitude, inverse_bandwidth);
+    return sum / 3.0;
+}
+
+// ---- AVX-512 ----------------------------------------------------------------
+
+ANANTASOUND_AVX512_DIAGNOSTICS_PUSH
+
+__attribute__((target("avx512f")))
+std::complex<double> accumulateAVX512(const FeedbackSources& sources, const double* state_correlation,
+                                      double cos_phase, double sin_phase,
+                                      double frequency, double threshold) {
+    const __m512d c_in = _mm512_set1_pd(cos_phase);
+    const __m512d s_in = _mm512_set1_pd(sin_phase);
+    const __m512d f_in = _mm512_set1_pd(frequency);
+    const __m512d limit = _mm512_set1_pd(threshold);
+    const __m512d scale = _mm512_set1_pd(kFrequencyScale);
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d three = _mm512_set1_pd(3.0);
+    const __m512d zero = _mm512_setzero_pd();
+    __m512d re = zero;
+    __m512d im = zero;
+
+    size_t j = 0;
+    for (; j + 8 <= sources.count; j += 8) {
+        __m512d phase_corr = _mm512_fmadd_pd(c_in, _mm512_loadu_pd(sources.cos_phase + j),
+                                             _mm512_mul_pd(s_in, _mm512_loadu_pd(sources.sin_phase + j)));
+        __m512d freq_diff = _mm512_abs_pd(_mm512_sub_pd(f_in, _mm512_loadu_pd(sources.frequency + j)));
+        __m512d freq_corr = _mm512_div_pd(one, _mm512_add_pd(one, _mm512_div_pd(freq_diff, scale)));
+        __m512d sum = _mm512_add_pd(_mm512_add_pd(phase_corr, freq_corr),
+                                    _mm512_loadu_pd(state_correlation + j));
+        __m512d correlation = _mm512_max_pd(_mm512_min_pd(_mm512_div_pd(sum, three), one), zero);
+
+        // Accumulate only the pairs above the threshold
+        __mmask8 above = _mm512_cmp_pd_mask(correlation, limit, _CMP_GT_OQ);
+        re = _mm512_mask3_fmadd_pd(correlation, _mm512_loadu_pd(sources.phasor_real + j), re, above);
+        im = _mm512_mask3_fmadd_pd(correlation, _mm512_loadu_pd(sources.phasor_imag + j), im, above);
+    }
+
+    std::complex<double> total(_mm512_reduce_add_pd(re), _mm512_reduce_add_pd(im));
+    return total + accumulateTail(sources, j, state_correlation, cos_phase, sin_phase, frequency, threshold);
+}
+
+__attribute__((target("avx512f")))
+double resonanceSumAVX512(const double* frequency, const double* phase, const double* amplitude,
+                          size_t count, double reference_frequency, double reference_phase,
+                          double reference_amplitude, double bandwidth) {
+    const double inverse_amplitude = 1.0 / reference_amplitude;
+    const double inverse_bandwidth = 1.0 / bandwidth;
+    const __m512d f_ref = _mm512_set1_pd(reference_frequency);
+    const __m512d phi_ref = _mm512_set1_pd(reference_phase);
+    const __m512d inv_amp = _mm512_set1_pd(inverse_amplitude);
+    const __m512d inv_bw = _mm512_set1_pd(inverse_bandwidth);
+    const __m512d one = _mm512_set1_pd(1.0);
+    __m512d total = _mm512_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d freq_diff = _mm512_abs_pd(_mm512_sub_pd(_mm512_loadu_pd(frequency + i), f_ref));
+        __m512d freq_resonance = _mm512_div_pd(one, _mm512_fmadd_pd(freq_diff, inv_bw, one));
+        __m512d sn, c;
+        sincosAVX512(_mm512_sub_pd(_mm512_loadu_pd(phase + i), phi_ref), sn, c);
+        __m512d amp_resonance = _mm512_min_pd(one, _mm512_mul_pd(_mm512_loadu_pd(amplitude + i), inv_amp));
+        total = _mm512_add_pd(total, _mm512_add_pd(_mm512_add_pd(freq_resonance, c), amp_resonance));
+    }
+
+    double sum = _mm512_reduce_add_pd(total);
+    sum += resonanceTail(frequency, phase, amplitude, i, count, reference_frequency, reference_phase,
+                         inverse_amplitude, inverse_bandwidth);
+    return sum / 3.0;
+}
+
+ANANTASOUND_AVX512_DIAGNOSTICS_POP
+
+#endif // ANANTASOUND_X86_DISPATCH
+
+const FeedbackKernelTable kScalarKernels = {
+    SIMDLevel::SCALAR, "scalar", accumulateScalar, resonanceSumScalar
+};
+
+#ifdef ANANTASOUND_X86_DISPATCH
+const FeedbackKernelTable kAVX2Kernels = {
+    SIMDLevel::AVX2, "avx2", accumulateAVX2, resonanceSumAVX2
+};
+
+const FeedbackKernelTable kAVX512Kernels = {
+    SIMDLevel::AVX512, "avx512", accumulateAVX512, resonanceSumAVX512
+};
+#endif
+
+// Tables compiled into this build, indexed by SIMDLevel; NEON uses the scalar path
+const FeedbackKernelTable* const kTables[4] = {
+    &kScalarKernels,
+#ifdef ANANTASOUND_X86_DISPATCH
+    &kAVX2Kernels, &kAVX512Kernels,
+#else
+    nullptr, nullptr,
+#endif
+    nullptr
+};
+
+const FeedbackKernelTable& selectBestKernels() {
+    for (SIMDLevel level : {SIMDLevel::AVX512, SIMDLevel::AVX2}) {
+        if (isSIMDLevelSupported(level) && kTables[static_cast<size_t>(level)]) {
+            return *kTables[static_cast<size_t>(level)];
+        }
+    }
+    return kScalarKernels;
+}
+
+} // namespace
+
+const FeedbackKernelTable& getFeedbackKernels(SIMDLevel level) {
+    const FeedbackKernelTable* table = nullptr;
+    if (isSIMDLevelSupported(level)) {
+        table = kTables[static_cast<size_t>(level)];
+    }
+    return table ? *table : kScalarKernels;
+}
+
+const FeedbackKernelTable& getFeedbackKernels() {
+    static const FeedbackKernelTable& best = selectBestKernels();
+    return best;
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "spectral_kernels.hpp"
+#include <complex>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Structure-of-arrays view of a precomputed feedback field set.
+// phasor = amplitude · exp(i · phase); state_correlation is the row of the
+// state lookup table for the input's state, one entry per feedback field.
+struct FeedbackSources {
+    const double* cos_phase;
+    const double* sin_phase;
+    const double* frequency;
+    const double* phasor_real;
+    const double* phasor_imag;
+    size_t count;
+};
+
+// Dispatch table of feedback kernels for one instruction set
+struct FeedbackKernelTable {
+    SIMDLevel level;
+    const char* name;
+
+    // Σ_j [c_j > threshold] · c_j · phasor_j for one input field, where
+    // c_j = clamp((cos(φ_in - φ_j) + 1 / (1 + |f_in - f_j| / 1000) + state_j) / 3, 0, 1)
+    // and cos(φ_in - φ_j) is expanded as cos·cos + sin·sin
+    std::complex<double> (*accumulate)(const FeedbackSources& sources,
+                                       const double* state_correlation,
+                                       double cos_phase, double sin_phase,
+                                       double frequency, double threshold);
+
+    // Σ_i (1 / (1 + |f_i - f_ref| / bandwidth) + cos(φ_i - φ_ref) + min(a_i / a_ref, 1)) / 3
+    // over contiguous frequency, phase and real-amplitude arrays (QRD resonance)
+    double (*resonanceSum)(const double* frequency, const double* phase, const double* amplitude,
+                           size_t count, double reference_frequency, double reference_phase,
+                           double reference_amplitude, double bandwidth);
+};
+
+// Best kernel table for the running CPU (detected once, thread-safe)
+const FeedbackKernelTable& getFeedbackKernels();
+
+// Kernel table for a specific level; falls back to SCALAR when unsupported
+const FeedbackKernelTable& getFeedbackKernels(SIMDLevel level);
+
+} // namespace AnantaSound
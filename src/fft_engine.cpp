@@ -0,0 +1,277 @@
+#include "fft_engine.hpp"
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace AnantaSound {
+
+namespace {
+
+// Multiply by -i without a full complex multiplication
+template<typename Real>
+inline std::complex<Real> mulNegI(const std::complex<Real>& z) {
+    return std::complex<Real>(z.imag(), -z.real());
+}
+
+// Memo of immutable tables keyed by size. Tables are built outside the lock
+// (a concurrent miss on the same key builds twice and keeps the first), and
+// the map starts over when full, which only matters for callers cycling
+// through unusual window sizes.
+template<typename Key, typename Table>
+class SharedTableCache {
+private:
+    static constexpr size_t kCapacity = 64;
+
+    std::mutex mutex_;
+    std::map<Key, std::shared_ptr<const Table>> tables_;
+
+public:
+    template<typename Build>
+    std::shared_ptr<const Table> get(const Key& key, Build build) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = tables_.find(key);
+            if (it != tables_.end()) {
+                return it->second;
+            }
+        }
+
+        std::shared_ptr<const Table> table = build();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tables_.size() >= kCapacity) {
+            tables_.clear();
+        }
+        return tables_.emplace(key, std::move(table)).first->second;
+    }
+};
+
+} // namespace
+
+template<typename Real>
+BasicFFTPlan<Real>::BasicFFTPlan(size_t size, FFTAlgorithm algorithm)
+    : size_(size)
+    , complex_size_(size / 2)
+    , algorithm_(algorithm) {
+
+    if (!isValidSize(size_)) {
+        throw std::invalid_argument("FFT size must be a power of 2");
+    }
+
+    // Packed half-length complex transform used by forwardReal
+    buildTables(complex_size_, twiddles_, bit_reverse_swaps_);
+
+    // Unpacking twiddles; W_{M-k} = -conj(W_k) covers the upper half
+    real_twiddles_.resize(size_ / 4 + 1);
+    for (size_t k = 0; k < real_twiddles_.size(); ++k) {
+        double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(size_);
+        real_twiddles_[k] = Complex(static_cast<Real>(std::cos(angle)), static_cast<Real>(std::sin(angle)));
+    }
+
+    // Full-length complex transform
+    buildTables(size_, full_twiddles_, full_bit_reverse_swaps_);
+}
+
+template<typename Real>
+bool BasicFFTPlan<Real>::isValidSize(size_t size) {
+    return size >= 2 && (size & (size - 1)) == 0;
+}
+
+template<typename Real>
+void BasicFFTPlan<Real>::buildTables(size_t n,
+                                     std::vector<Complex>& twiddles,
+                                     std::vector<std::pair<size_t, size_t>>& swaps) {
+    twiddles.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+        double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(n);
+        twiddles[k] = Complex(static_cast<Real>(std::cos(angle)), static_cast<Real>(std::sin(angle)));
+    }
+
+    swaps.clear();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j ^= bit;
+
+        if (i < j) {
+            swaps.emplace_back(i, j);
+        }
+    }
+}
+
+template<typename Real>
+void BasicFFTPlan<Real>::forwardReal(const Real* input, Complex* output) const {
+    const size_t m = complex_size_;
+
+    // Pack even/odd samples into the real/imaginary parts of an M-point signal
+    for (size_t i = 0; i < m; ++i) {
+        output[i] = Complex(input[2 * i], input[2 * i + 1]);
+    }
+
+    transform(output, m, twiddles_, bit_reverse_swaps_);
+
+    // Unpack: X[k] = (Z[k] + Z*[M-k]) / 2 - i W^k (Z[k] - Z*[M-k]) / 2
+    const Complex z0 = output[0];
+    output[0] = Complex(z0.real() + z0.imag(), Real(0));
+    output[m] = Complex(z0.real() - z0.imag(), Real(0));
+
+    for (size_t k = 1; k <= m / 2; ++k) {
+        const size_t mk = m - k;
+        const Complex a = output[k];
+        const Complex b = output[mk];
+        const Complex w = real_twiddles_[k];
+
+        const Complex even_k = Real(0.5) * (a + std::conj(b));
+        const Complex odd_k = Real(0.5) * (a - std::conj(b));
+        output[k] = even_k + mulNegI(w * odd_k);
+
+        if (mk != k) {
+            const Complex even_mk = std::conj(even_k);
+            const Complex odd_mk = -std::conj(odd_k);
+            output[mk] = even_mk + mulNegI(-std::conj(w) * odd_mk);
+        }
+    }
+}
+
+template<typename Real>
+void BasicFFTPlan<Real>::forward(Complex* data) const {
+    transform(data, size_, full_twiddles_, full_bit_reverse_swaps_);
+}
+
+template<typename Real>
+void BasicFFTPlan<Real>::inverse(Complex* data) const {
+    // IFFT(x) = conj(FFT(conj(x))) / N
+    for (size_t i = 0; i < size_; ++i) {
+        data[i] = std::conj(data[i]);
+    }
+
+    transform(data, size_, full_twiddles_, full_bit_reverse_swaps_);
+
+    const Real scale = Real(1) / static_cast<Real>(size_);
+    for (size_t i = 0; i < size_; ++i) {
+        data[i] = std::conj(data[i]) * scale;
+    }
+}
+
+template<typename Real>
+void BasicFFTPlan<Real>::transform(Complex* data, size_t n,
+                                   const std::vector<Complex>& twiddles,
+                                   const std::vector<std::pair<size_t, size_t>>& swaps) const {
+    if (n < 2) {
+        return;
+    }
+
+    for (const auto& swap : swaps) {
+        std::swap(data[swap.first], data[swap.second]);
+    }
+
+    if (algorithm_ == FFTAlgorithm::RADIX2) {
+        radix2Stages(data, n, twiddles.data());
+    } else {
+        radix4Stages(data, n, twiddles.data());
+    }
+}
+
+template<typename Real>
+void BasicFFTPlan<Real>::radix2Stages(Complex* data, size_t n, const Complex* twiddles) {
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        const size_t stride = n / len;
+
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < half; ++j) {
+                Complex u = data[i + j];
+                Complex v = data[i + j + half] * twiddles[j * stride];
+                data[i + j] = u + v;
+                data[i + j + half] = u - v;
+            }
+        }
+    }
+}
+
+template<typename Real>
+void BasicFFTPlan<Real>::radix4Stages(Complex* data, size_t n, const Complex* twiddles) {
+    size_t log2n = 0;
+    while ((static_cast<size_t>(1) << log2n) < n) {
+        ++log2n;
+    }
+
+    size_t len = 4;
+
+    // Odd power of two: one twiddle-free radix-2 stage first
+    if (log2n % 2 == 1) {
+        for (size_t i = 0; i < n; i += 2) {
+            Complex u = data[i];
+            Complex v = data[i + 1];
+            data[i] = u + v;
+            data[i + 1] = u - v;
+        }
+        len = 8;
+    }
+
+    // Each pass merges two radix-2 stages into one radix-4 butterfly
+    for (; len <= n; len <<= 2) {
+        const size_t quarter = len / 4;
+        const size_t stride = n / len;
+
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < quarter; ++j) {
+                const Complex w1 = twiddles[j * stride];
+                const Complex w2 = twiddles[2 * j * stride];
+                const Complex w3 = twiddles[3 * j * stride];
+
+                const Complex a = data[i + j];
+                const Complex b = data[i + j + quarter] * w2;
+                const Complex c = data[i + j + 2 * quarter] * w1;
+                const Complex d = data[i + j + 3 * quarter] * w3;
+
+                const Complex apb = a + b;
+                const Complex amb = a - b;
+                const Complex cpd = c + d;
+                const Complex cmd_rot = mulNegI(c - d);
+
+                data[i + j] = apb + cpd;
+                data[i + j + quarter] = amb + cmd_rot;
+                data[i + j + 2 * quarter] = apb - cpd;
+                data[i + j + 3 * quarter] = amb - cmd_rot;
+            }
+        }
+    }
+}
+
+template<typename Real>
+std::shared_ptr<const BasicFFTPlan<Real>> sharedFFTPlan(size_t size, FFTAlgorithm algorithm) {
+    static SharedTableCache<std::pair<size_t, FFTAlgorithm>, BasicFFTPlan<Real>> cache;
+    if (!BasicFFTPlan<Real>::isValidSize(size)) {
+        throw std::invalid_argument("FFT size must be a power of 2");
+    }
+    return cache.get({size, algorithm}, [&] {
+        return std::make_shared<const BasicFFTPlan<Real>>(size, algorithm);
+    });
+}
+
+template<typename Real>
+std::shared_ptr<const std::vector<Real>> sharedHannWindow(size_t size) {
+    static SharedTableCache<size_t, std::vector<Real>> cache;
+    return cache.get(size, [size] {
+        auto window = std::make_shared<std::vector<Real>>(size);
+        for (size_t i = 0; i < size; ++i) {
+            double weight = size > 1 ? 0.5 * (1.0 - std::cos(2.0 * M_PI * i / (size - 1))) : 1.0;
+            (*window)[i] = static_cast<Real>(weight);
+        }
+        return std::shared_ptr<const std::vector<Real>>(std::move(window));
+    });
+}
+
+// Sample precisions used by the analyzers
+template class BasicFFTPlan<double>;
+template class BasicFFTPlan<float>;
+template std::shared_ptr<const BasicFFTPlan<double>> sharedFFTPlan<double>(size_t, FFTAlgorithm);
+template std::shared_ptr<const BasicFFTPlan<float>> sharedFFTPlan<float>(size_t, FFTAlgorithm);
+template std::shared_ptr<const std::vector<double>> sharedHannWindow<double>(size_t);
+template std::shared_ptr<const std::vector<float>> sharedHannWindow<float>(size_t);
+
+} // namespace AnantaSound
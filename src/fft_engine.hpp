@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace AnantaSound {
+
+// FFT kernel selection
+enum class FFTAlgorithm {
+    RADIX2,     // Classic iterative radix-2 (reference kernel)
+    RADIX4      // Radix-4 (radix-2^2) kernel, 3 complex multiplies per butterfly
+};
+
+// Precomputed FFT plan for a fixed transform size.
+// Twiddle factors and the bit-reversal permutation are computed once in the
+// constructor; all transform methods are const, so one plan can be shared by
+// any number of threads. Real is the sample precision (double or float);
+// float plans compute their twiddles in double and round them once.
+template<typename Real>
+class BasicFFTPlan {
+public:
+    using Complex = std::complex<Real>;
+
+private:
+    size_t size_;                    // Real transform length N
+    size_t complex_size_;            // Length of the packed complex transform (N / 2)
+    FFTAlgorithm algorithm_;
+
+    std::vector<Complex> twiddles_;       // e^{-2πik/M}, k < M (M = N / 2)
+    std::vector<Complex> real_twiddles_;  // e^{-2πik/N}, k <= N / 4
+    std::vector<std::pair<size_t, size_t>> bit_reverse_swaps_;
+
+    // Tables for full-length complex transforms (performFFT / performIFFT)
+    std::vector<Complex> full_twiddles_;  // e^{-2πik/N}, k < N
+    std::vector<std::pair<size_t, size_t>> full_bit_reverse_swaps_;
+
+public:
+    explicit BasicFFTPlan(size_t size, FFTAlgorithm algorithm = FFTAlgorithm::RADIX4);
+
+    // Transform parameters
+    size_t getSize() const { return size_; }
+    size_t getBinCount() const { return size_ / 2 + 1; }
+    FFTAlgorithm getAlgorithm() const { return algorithm_; }
+
+    // Size must be a power of two and at least 2
+    static bool isValidSize(size_t size);
+
+    // Real-to-complex transform: N real samples -> N/2 + 1 complex bins.
+    // The input is packed into an N/2-point complex transform and unpacked
+    // in place, so `output` must hold getBinCount() elements.
+    void forwardReal(const Real* input, Complex* output) const;
+
+    // In-place complex transforms of length N
+    void forward(Complex* data) const;
+    void inverse(Complex* data) const;
+
+private:
+    static void buildTables(size_t n,
+                            std::vector<Complex>& twiddles,
+                            std::vector<std::pair<size_t, size_t>>& swaps);
+
+    void transform(Complex* data, size_t n,
+                   const std::vector<Complex>& twiddles,
+                   const std::vector<std::pair<size_t, size_t>>& swaps) const;
+
+    static void radix2Stages(Complex* data, size_t n, const Complex* twiddles);
+    static void radix4Stages(Complex* data, size_t n, const Complex* twiddles);
+};
+
+// Instantiated in fft_engine.cpp
+extern template class BasicFFTPlan<double>;
+extern template class BasicFFTPlan<float>;
+
+using FFTPlan = BasicFFTPlan<double>;      // Reference precision
+using FFTPlanF = BasicFFTPlan<float>;      // Single precision
+
+// Process-wide tables, built on first request and shared by every caller
+// afterwards; thread-safe. Plans and windows are immutable, so analyzers,
+// trackers and sessions of the same size hold one copy between them
+// instead of rebuilding it per instance.
+
+// Plan for (size, algorithm); throws like the constructor for invalid sizes
+template<typename Real>
+std::shared_ptr<const BasicFFTPlan<Real>> sharedFFTPlan(size_t size, FFTAlgorithm algorithm = FFTAlgorithm::RADIX4);
+
+// Symmetric Hann window 0.5 (1 - cos(2πi / (size - 1))) of `size` points
+template<typename Real>
+std::shared_ptr<const std::vector<Real>> sharedHannWindow(size_t size);
+
+} // namespace AnantaSound
@@ -0,0 +1,65 @@
+#include "field_arena.hpp"
+#include <algorithm>
+
+namespace AnantaSound {
+
+FieldArena::FieldArena(size_t block_size)
+    : block_size_(std::max<size_t>(block_size, 1))
+    , current_(0)
+    , offset_(0)
+    , bytes_allocated_(0) {
+}
+
+void FieldArena::reset() {
+    current_ = 0;
+    offset_ = 0;
+    bytes_allocated_ = 0;
+}
+
+size_t FieldArena::getCapacity() const {
+    size_t capacity = 0;
+    for (const Block& block : blocks_) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+FieldArena& FieldArena::threadLocal() {
+    thread_local FieldArena arena;
+    return arena;
+}
+
+void* FieldArena::do_allocate(size_t bytes, size_t alignment) {
+    // Blocks are revisited in the same order every tick
+    for (; current_ < blocks_.size(); ++current_, offset_ = 0) {
+        Block& block = blocks_[current_];
+        void* pointer = block.data.get() + offset_;
+        size_t space = block.size - offset_;
+        if (std::align(alignment, bytes, pointer, space)) {
+            offset_ = static_cast<size_t>(static_cast<std::byte*>(pointer) - block.data.get()) + bytes;
+            bytes_allocated_ += bytes;
+            return pointer;
+        }
+    }
+
+    // Peak not reached before: grow by a block that fits the request
+    size_t size = blocks_.empty() ? block_size_ : blocks_.back().size * 2;
+    size = std::max(size, bytes + alignment);
+    blocks_.push_back(Block{std::make_unique<std::byte[]>(size), size});
+    current_ = blocks_.size() - 1;
+    offset_ = 0;
+    return do_allocate(bytes, alignment);
+}
+
+void FieldArena::do_deallocate(void* pointer, size_t bytes, size_t alignment) {
+    // Memory comes back all at once in reset()
+    (void)pointer;
+    (void)bytes;
+    (void)alignment;
+}
+
+bool FieldArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace AnantaSound
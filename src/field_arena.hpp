@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace AnantaSound {
+
+// Monotonic arena for the short-lived vectors of one processing tick.
+// Allocation bumps a pointer through a list of blocks and deallocation is a
+// no-op; reset() rewinds to the first block but keeps every block, so once
+// a tick has reached its peak size the following ticks take nothing from
+// the global heap. An arena belongs to one thread (threadLocal() gives each
+// worker its own), so workers never contend on an allocator lock.
+// Containers built on the arena must not be used after the next reset().
+class FieldArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    size_t block_size_;         // Size of the first block; later blocks double
+    size_t current_;            // Block being bumped
+    size_t offset_;             // Bytes used in the current block
+    size_t bytes_allocated_;    // Requested since the last reset
+
+public:
+    explicit FieldArena(size_t block_size = kDefaultBlockSize);
+
+    FieldArena(const FieldArena&) = delete;
+    FieldArena& operator=(const FieldArena&) = delete;
+
+    // Start the next tick; every earlier allocation becomes invalid
+    void reset();
+
+    size_t getBytesAllocated() const { return bytes_allocated_; }
+    size_t getCapacity() const;
+    size_t getBlockCount() const { return blocks_.size(); }
+
+    // Arena of the calling thread
+    static FieldArena& threadLocal();
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+} // namespace AnantaSound
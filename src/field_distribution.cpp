@@ -0,0 +1,408 @@
+#include "field_distribution.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace AnantaSound {
+
+namespace {
+
+constexpr uint32_t kMaxFieldsPerNode = 1u << 20;   // Bounds what one header can make a receiver allocate
+
+} // namespace
+
+// UdpFieldTransport
+#if !defined(_WIN32)
+struct UdpFieldTransport::Peer {
+    sockaddr_in address;
+};
+#else
+struct UdpFieldTransport::Peer {
+};
+#endif
+
+UdpFieldTransport::UdpFieldTransport() : socket_(-1), port_(0) {
+}
+
+UdpFieldTransport::~UdpFieldTransport() {
+    close();
+}
+
+bool UdpFieldTransport::open(uint16_t port) {
+    close();
+#if defined(_WIN32)
+    (void)port;
+    std::cerr << "UDP field transport is not available on this platform" << std::endl;
+    return false;
+#else
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        std::cerr << "Failed to create UDP socket" << std::endl;
+        return false;
+    }
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(port);
+    socklen_t length = sizeof(local);
+    if (::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK) != 0 ||
+        ::bind(fd, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&local), &length) != 0) {
+        ::close(fd);
+        std::cerr << "Failed to bind UDP port " << port << std::endl;
+        return false;
+    }
+    socket_ = fd;
+    port_ = ntohs(local.sin_port);
+    return true;
+#endif
+}
+
+void UdpFieldTransport::close() {
+#if !defined(_WIN32)
+    if (socket_ >= 0) {
+        ::close(socket_);
+    }
+#endif
+    socket_ = -1;
+    port_ = 0;
+}
+
+bool UdpFieldTransport::addPeer(const std::string& address, uint16_t port) {
+#if defined(_WIN32)
+    (void)address;
+    (void)port;
+    return false;
+#else
+    auto peer = std::make_unique<Peer>();
+    peer->address = sockaddr_in{};
+    peer->address.sin_family = AF_INET;
+    peer->address.sin_port = htons(port);
+    if (::inet_pton(AF_INET, address.c_str(), &peer->address.sin_addr) != 1) {
+        return false;
+    }
+    peers_.push_back(std::move(peer));
+    return true;
+#endif
+}
+
+bool UdpFieldTransport::send(const void* data, size_t size) {
+#if defined(_WIN32)
+    (void)data;
+    (void)size;
+    return false;
+#else
+    if (socket_ < 0) {
+        return false;
+    }
+    bool sent = true;
+    for (const auto& peer : peers_) {
+        ssize_t written = ::sendto(socket_, data, size, MSG_DONTWAIT,
+                                   reinterpret_cast<const sockaddr*>(&peer->address), sizeof(peer->address));
+        sent = sent && written == static_cast<ssize_t>(size);
+    }
+    return sent;
+#endif
+}
+
+size_t UdpFieldTransport::receive(void* buffer, size_t capacity, std::chrono::microseconds timeout) {
+#if defined(_WIN32)
+    (void)buffer;
+    (void)capacity;
+    (void)timeout;
+    return 0;
+#else
+    if (socket_ < 0) {
+        return 0;
+    }
+    ssize_t received = ::recv(socket_, buffer, capacity, MSG_DONTWAIT);
+    if (received < 0 && timeout.count() > 0) {
+        pollfd descriptor{socket_, POLLIN, 0};
+        int milliseconds = static_cast<int>((timeout.count() + 999) / 1000);
+        if (::poll(&descriptor, 1, milliseconds) > 0) {
+            received = ::recv(socket_, buffer, capacity, MSG_DONTWAIT);
+        }
+    }
+    return received > 0 ? static_cast<size_t>(received) : 0;
+#endif
+}
+
+// FieldPublisher
+FieldPublisher::FieldPublisher(FieldTransport& transport, uint32_t node_id, double max_radius,
+                               uint32_t keyframe_interval)
+    : transport_(&transport)
+    , node_id_(node_id)
+    , session_(std::random_device{}())
+    , keyframe_interval_(std::max<uint32_t>(keyframe_interval, 1))
+    , codec_(max_radius, SampleClock::shared())
+    , frame_(0)
+    , datagram_(kMaxDatagramSize)
+    , datagrams_sent_(0)
+    , entries_sent_(0) {
+}
+
+bool FieldPublisher::publish(const std::vector<QuantumSoundField>& fields) {
+    codec_.pack(fields, packed_);
+    // Timestamps are not sent, so they must not make a field look changed
+    for (auto& packed : packed_) {
+        packed.state_tick &= ~PackedFieldCodec::kMaxTick;
+    }
+
+    bool keyframe = frame_ % keyframe_interval_ == 0;
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < packed_.size(); ++i) {
+        if (keyframe || i >= previous_.size() ||
+            std::memcmp(&packed_[i], &previous_[i], sizeof(PackedSoundField)) != 0) {
+            indices.push_back(i);
+        }
+    }
+
+    uint32_t flags = keyframe ? static_cast<uint32_t>(kFieldPacketKeyframe) : 0;
+    bool sent = sendEntries(indices, static_cast<uint32_t>(packed_.size()), flags);
+    previous_.swap(packed_);
+    ++frame_;
+    return sent;
+}
+
+bool FieldPublisher::sendEntries(const std::vector<uint32_t>& indices, uint32_t field_count, uint32_t flags) {
+    FieldPacketHeader header{};
+    std::memcpy(header.magic, kFieldPacketMagic, sizeof(kFieldPacketMagic));
+    header.version = kFieldPacketVersion;
+    header.node_id = node_id_;
+    header.session = session_;
+    header.frame = frame_;
+    header.field_count = field_count;
+    header.flags = flags;
+    header.max_radius = codec_.getMaxRadius();
+
+    bool sent = true;
+    size_t begin = 0;
+    do {
+        size_t count = std::min(kMaxEntriesPerDatagram, indices.size() - begin);
+        header.entry_count = static_cast<uint16_t>(count);
+        std::memcpy(datagram_.data(), &header, sizeof(header));
+        uint8_t* entries = datagram_.data() + sizeof(header);
+        for (size_t i = 0; i < count; ++i) {
+            FieldPacketEntry entry{indices[begin + i], packed_[indices[begin + i]]};
+            std::memcpy(entries + i * sizeof(FieldPacketEntry), &entry, sizeof(entry));
+        }
+        sent = transport_->send(datagram_.data(), sizeof(header) + count * sizeof(FieldPacketEntry)) && sent;
+        ++datagrams_sent_;
+        entries_sent_ += count;
+        begin += count;
+    } while (begin < indices.size());
+    return sent;
+}
+
+// FieldSubscriber
+FieldSubscriber::FieldSubscriber(FieldTransport& transport, uint32_t local_node_id, const SampleClock& clock,
+                                 std::chrono::microseconds node_timeout, std::chrono::microseconds poll_interval)
+    : transport_(&transport)
+    , local_node_id_(local_node_id)
+    , clock_(&clock)
+    , node_timeout_(node_timeout)
+    , poll_interval_(poll_interval)
+    , snapshot_(std::make_shared<const RemoteFieldSet>())
+    , running_(false)
+    , datagrams_received_(0)
+    , datagrams_rejected_(0) {
+}
+
+FieldSubscriber::~FieldSubscriber() {
+    stop();
+}
+
+bool FieldSubscriber::start() {
+    if (isRunning()) {
+        return false;
+    }
+    running_.store(true, std::memory_order_release);
+    receiver_ = std::thread([this]() { receiverLoop(); });
+    return true;
+}
+
+void FieldSubscriber::stop() {
+    running_.store(false, std::memory_order_release);
+    if (receiver_.joinable()) {
+        receiver_.join();
+    }
+}
+
+FieldSubscriber::RemoteFieldSnapshot FieldSubscriber::getRemoteFields() const {
+    return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+}
+
+void FieldSubscriber::receiverLoop() {
+    std::vector<uint8_t> datagram(kMaxDatagramSize);
+    while (running_.load(std::memory_order_acquire)) {
+        // Apply everything that has arrived, then publish once
+        bool changed = false;
+        std::chrono::microseconds wait = poll_interval_;
+        while (size_t size = transport_->receive(datagram.data(), datagram.size(), wait)) {
+            datagrams_received_.fetch_add(1, std::memory_order_relaxed);
+            if (apply(datagram.data(), size)) {
+                changed = true;
+            }
+            wait = std::chrono::microseconds(0);
+        }
+        if (expireNodes() || changed) {
+            publishSnapshot();
+        }
+    }
+}
+
+bool FieldSubscriber::apply(const uint8_t* datagram, size_t size) {
+    FieldPacketHeader header;
+    if (size < sizeof(header)) {
+        datagrams_rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    std::memcpy(&header, datagram, sizeof(header));
+    if (std::memcmp(header.magic, kFieldPacketMagic, sizeof(kFieldPacketMagic)) != 0 ||
+        header.version != kFieldPacketVersion ||
+        size != sizeof(header) + header.entry_count * sizeof(FieldPacketEntry) ||
+        header.field_count > kMaxFieldsPerNode || !(header.max_radius > 0.0)) {
+        datagrams_rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (header.node_id == local_node_id_) {
+        return false;
+    }
+
+    auto inserted = nodes_.try_emplace(header.node_id);
+    RemoteNode& node = inserted.first->second;
+    bool restarted = !inserted.second && header.session != node.session;
+    if (!inserted.second && !restarted && static_cast<int32_t>(header.frame - node.frame) < 0) {
+        return false;
+    }
+
+    // Validate every index before touching the node
+    const uint8_t* entries = datagram + sizeof(header);
+    for (size_t i = 0; i < header.entry_count; ++i) {
+        uint32_t index;
+        std::memcpy(&index, entries + i * sizeof(FieldPacketEntry), sizeof(index));
+        if (index >= header.field_count) {
+            datagrams_rejected_.fetch_add(1, std::memory_order_relaxed);
+            if (inserted.second) {
+                nodes_.erase(inserted.first);
+            }
+            return false;
+        }
+    }
+
+    // A restarted publisher counts frames from 0 again: start the node over,
+    // dropping its fields until the new session's first keyframe
+    bool dropped = false;
+    if (restarted) {
+        dropped = node.synchronized;
+        node = RemoteNode{};
+    }
+    node.session = header.session;
+    node.last_seen = std::chrono::steady_clock::now();
+    node.frame = header.frame;
+    node.max_radius = header.max_radius;
+
+    if ((header.flags & kFieldPacketKeyframe) != 0) {
+        // Held until every fragment is in, so a partial keyframe never
+        // shows as zeroed fields
+        if (!node.assembling || node.keyframe_frame != header.frame) {
+            node.keyframe.assign(header.field_count, PackedSoundField{});
+            node.keyframe_present.assign(header.field_count, 0);
+            node.keyframe_received = 0;
+            node.keyframe_frame = header.frame;
+            node.assembling = true;
+        }
+        for (size_t i = 0; i < header.entry_count; ++i) {
+            FieldPacketEntry entry;
+            std::memcpy(&entry, entries + i * sizeof(FieldPacketEntry), sizeof(entry));
+            node.keyframe[entry.index] = entry.field;
+            if (!node.keyframe_present[entry.index]) {
+                node.keyframe_present[entry.index] = 1;
+                ++node.keyframe_received;
+            }
+        }
+        if (node.keyframe_received < node.keyframe.size()) {
+            return dropped;
+        }
+        node.assembling = false;
+        bool changed = !node.synchronized || node.fields.size() != node.keyframe.size() ||
+                       (!node.keyframe.empty() &&
+                        std::memcmp(node.fields.data(), node.keyframe.data(),
+                                    node.keyframe.size() * sizeof(PackedSoundField)) != 0);
+        node.fields.swap(node.keyframe);
+        node.synchronized = true;
+        return changed || dropped;
+    }
+
+    // A newer delta means the rest of an incomplete keyframe was lost
+    node.assembling = false;
+    bool changed = node.fields.size() != header.field_count;
+    node.fields.resize(header.field_count);
+    for (size_t i = 0; i < header.entry_count; ++i) {
+        FieldPacketEntry entry;
+        std::memcpy(&entry, entries + i * sizeof(FieldPacketEntry), sizeof(entry));
+        if (std::memcmp(&node.fields[entry.index], &entry.field, sizeof(entry.field)) != 0) {
+            node.fields[entry.index] = entry.field;
+            changed = true;
+        }
+    }
+    return (changed && node.synchronized) || dropped;
+}
+
+bool FieldSubscriber::expireNodes() {
+    auto now = std::chrono::steady_clock::now();
+    bool expired = false;
+    for (auto it = nodes_.begin(); it != nodes_.end();) {
+        if (now - it->second.last_seen > node_timeout_) {
+            expired = expired || it->second.synchronized;
+            it = nodes_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return expired;
+}
+
+void FieldSubscriber::publishSnapshot() {
+    auto next = std::make_shared<RemoteFieldSet>();
+    next->version = getRemoteFields()->version + 1;
+    auto timestamp = clock_->now();
+    for (const auto& [node_id, node] : nodes_) {
+        if (!node.synchronized) {
+            continue;
+        }
+        PackedFieldCodec codec(node.max_radius, *clock_);
+        next->nodes.push_back(node_id);
+        for (const PackedSoundField& packed : node.fields) {
+            next->fields.push_back(codec.unpack(packed));
+            next->fields.back().timestamp = timestamp;
+        }
+    }
+    std::atomic_store_explicit(&snapshot_, RemoteFieldSnapshot(std::move(next)), std::memory_order_release);
+}
+
+// RemoteFieldMerge
+RemoteFieldMerge::RemoteFieldMerge(InterferenceField& field) : field_(&field), version_(0) {
+}
+
+bool RemoteFieldMerge::update(const FieldSubscriber& subscriber) {
+    FieldSubscriber::RemoteFieldSnapshot remote = subscriber.getRemoteFields();
+    if (remote->version == version_) {
+        return false;
+    }
+    handles_ = field_->replaceSourceFields(handles_, remote->fields);
+    version_ = remote->version;
+    return true;
+}
+
+} // namespace AnantaSound
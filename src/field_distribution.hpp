@@ -0,0 +1,236 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include "packed_field.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AnantaSound {
+
+// Field distribution between the hosts of a multi-dome deployment.
+// Every node publishes its field set once per tick; every node subscribes
+// to the others and merges their fields into local InterferenceFields.
+//
+// Wire format (native byte order): one datagram is a FieldPacketHeader and
+// entry_count FieldPacketEntry records, at most kMaxDatagramSize bytes. A
+// frame is one publish(); it is split over as many datagrams as it needs.
+// Entries carry only the fields whose packed bytes changed since the last
+// frame, plus every field on keyframes, so a lost datagram is repaired by
+// the next change of that field or the next keyframe. A keyframe covers
+// every index exactly once, so receivers know it is complete once they hold
+// field_count entries of it. Every publisher instance picks a random session
+// id; frame counters restart with it. Timestamps are not sent: receivers
+// stamp remote fields with their own clock.
+constexpr char kFieldPacketMagic[4] = {'A', 'N', 'F', 'D'};
+constexpr uint16_t kFieldPacketVersion = 2;
+constexpr size_t kMaxDatagramSize = 1472;       // Ethernet MTU minus IPv4 and UDP headers
+
+enum FieldPacketFlags : uint32_t {
+    kFieldPacketKeyframe = 1        // Entries cover the whole frame
+};
+
+struct FieldPacketHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t entry_count;
+    uint32_t node_id;
+    uint32_t session;               // Publisher instance; a new one restarts the frame counter
+    uint32_t frame;                 // Publisher's frame counter
+    uint32_t field_count;           // Size of the node's field set in this frame
+    uint32_t flags;
+    uint32_t reserved;              // Zero
+    double max_radius;              // Radius range of the packed positions
+};
+
+struct FieldPacketEntry {
+    uint32_t index;
+    PackedSoundField field;
+};
+
+static_assert(sizeof(FieldPacketHeader) == 40, "packet header layout is part of the wire format");
+static_assert(sizeof(FieldPacketEntry) == 28, "packet entry layout is part of the wire format");
+
+constexpr size_t kMaxEntriesPerDatagram = (kMaxDatagramSize - sizeof(FieldPacketHeader)) / sizeof(FieldPacketEntry);
+
+// Datagram transport between nodes. send and receive are called from one
+// thread each; receive waits at most timeout and returns 0 when nothing
+// arrived.
+class FieldTransport {
+public:
+    virtual ~FieldTransport() = default;
+
+    virtual bool send(const void* data, size_t size) = 0;
+    virtual size_t receive(void* buffer, size_t capacity, std::chrono::microseconds timeout) = 0;
+};
+
+// UDP transport: receives on a bound port and sends every datagram to each
+// registered peer. Sends never block; a datagram the socket cannot take is
+// dropped, like one lost on the network.
+class UdpFieldTransport : public FieldTransport {
+private:
+    struct Peer;
+
+    int socket_;
+    uint16_t port_;
+    std::vector<std::unique_ptr<Peer>> peers_;
+
+public:
+    UdpFieldTransport();
+    ~UdpFieldTransport() override;
+
+    UdpFieldTransport(const UdpFieldTransport&) = delete;
+    UdpFieldTransport& operator=(const UdpFieldTransport&) = delete;
+
+    // Bind to port on every interface (0 picks a free port); false on error
+    bool open(uint16_t port = 0);
+    void close();
+    bool isOpen() const { return socket_ >= 0; }
+    uint16_t getPort() const { return port_; }
+
+    // Destination of every sent datagram (IPv4 address); false when invalid
+    bool addPeer(const std::string& address, uint16_t port);
+    size_t getPeerCount() const { return peers_.size(); }
+
+    bool send(const void* data, size_t size) override;
+    size_t receive(void* buffer, size_t capacity, std::chrono::microseconds timeout) override;
+};
+
+// Sends the field set of one node. publish() packs the fields, compares
+// them with the previous frame and sends only the changed ones; every
+// keyframe_interval frames (and on the first) it sends them all. An empty
+// delta still sends a header so subscribers see the node alive.
+class FieldPublisher {
+public:
+    static constexpr uint32_t kDefaultKeyframeInterval = 50;
+
+private:
+    FieldTransport* transport_;
+    uint32_t node_id_;
+    uint32_t session_;
+    uint32_t keyframe_interval_;
+    PackedFieldCodec codec_;
+    uint32_t frame_;
+    std::vector<PackedSoundField> previous_;
+    std::vector<PackedSoundField> packed_;
+    std::vector<uint8_t> datagram_;
+    uint64_t datagrams_sent_;
+    uint64_t entries_sent_;
+
+    bool sendEntries(const std::vector<uint32_t>& indices, uint32_t field_count, uint32_t flags);
+
+public:
+    // max_radius bounds the positions sent (usually the dome radius)
+    FieldPublisher(FieldTransport& transport, uint32_t node_id, double max_radius,
+                   uint32_t keyframe_interval = kDefaultKeyframeInterval);
+
+    // Send one frame; false when the transport rejected a datagram
+    bool publish(const std::vector<QuantumSoundField>& fields);
+
+    uint32_t getNodeId() const { return node_id_; }
+    uint32_t getSession() const { return session_; }
+    uint32_t getFrame() const { return frame_; }
+    uint64_t getDatagramsSent() const { return datagrams_sent_; }
+    uint64_t getEntriesSent() const { return entries_sent_; }
+};
+
+// Latest fields of every live remote node, concatenated in node order
+struct RemoteFieldSet {
+    std::vector<QuantumSoundField> fields;
+    std::vector<uint32_t> nodes;            // Node ids contributing
+    uint64_t version = 0;                   // Increases with every change
+};
+
+// Receives field frames on a network thread and publishes the merged remote
+// set as an immutable snapshot. Readers (the local tick) take the snapshot
+// with one atomic load and never wait for the network. A node is included
+// once a complete keyframe from it has arrived (keyframe datagrams are held
+// until all of them are in) and is dropped after node_timeout without
+// datagrams. A new session id from a node (its publisher restarted) resets
+// the node as if it were new. Datagrams from an older frame than one already
+// applied in the session (reordering) and from local_node_id are ignored.
+class FieldSubscriber {
+public:
+    using RemoteFieldSnapshot = std::shared_ptr<const RemoteFieldSet>;
+
+private:
+    struct RemoteNode {
+        std::vector<PackedSoundField> fields;
+        uint32_t session = 0;
+        uint32_t frame = 0;
+        double max_radius = 0.0;
+        bool synchronized = false;          // A keyframe has arrived
+        std::chrono::steady_clock::time_point last_seen;
+
+        // Keyframe being assembled; applied to fields once every index is in
+        std::vector<PackedSoundField> keyframe;
+        std::vector<uint8_t> keyframe_present;
+        size_t keyframe_received = 0;
+        uint32_t keyframe_frame = 0;
+        bool assembling = false;
+    };
+
+    FieldTransport* transport_;
+    uint32_t local_node_id_;
+    const SampleClock* clock_;
+    std::chrono::microseconds node_timeout_;
+    std::chrono::microseconds poll_interval_;
+    std::map<uint32_t, RemoteNode> nodes_;  // Network thread only
+    RemoteFieldSnapshot snapshot_;
+    std::thread receiver_;
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> datagrams_received_;
+    std::atomic<uint64_t> datagrams_rejected_;
+
+    void receiverLoop();
+    bool apply(const uint8_t* datagram, size_t size);
+    bool expireNodes();
+    void publishSnapshot();
+
+public:
+    // Remote fields are stamped with clock (the local core's clock)
+    FieldSubscriber(FieldTransport& transport, uint32_t local_node_id, const SampleClock& clock,
+                    std::chrono::microseconds node_timeout = std::chrono::milliseconds(500),
+                    std::chrono::microseconds poll_interval = std::chrono::milliseconds(5));
+    ~FieldSubscriber();
+
+    FieldSubscriber(const FieldSubscriber&) = delete;
+    FieldSubscriber& operator=(const FieldSubscriber&) = delete;
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    // Current merged remote set; never null
+    RemoteFieldSnapshot getRemoteFields() const;
+
+    uint64_t getDatagramsReceived() const { return datagrams_received_.load(std::memory_order_relaxed); }
+    uint64_t getDatagramsRejected() const { return datagrams_rejected_.load(std::memory_order_relaxed); }
+};
+
+// Keeps the remote fields of a subscriber as sources of one local
+// InterferenceField. update() is meant for the local tick: when the remote
+// set is unchanged it costs one atomic load; otherwise it swaps the old
+// remote sources for the new ones in a single snapshot publication. Local
+// sources of the field are left alone.
+class RemoteFieldMerge {
+private:
+    InterferenceField* field_;
+    std::vector<InterferenceField::SourceHandle> handles_;
+    uint64_t version_;
+
+public:
+    explicit RemoteFieldMerge(InterferenceField& field);
+
+    // true when the field's sources changed
+    bool update(const FieldSubscriber& subscriber);
+
+    size_t getMergedCount() const { return handles_.size(); }
+};
+
+} // namespace AnantaSound
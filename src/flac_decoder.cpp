@@ -0,0 +1,712 @@
+#include "flac_decoder.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+
+namespace AnantaSound {
+
+namespace {
+
+constexpr size_t kReadBufferSize = 64 * 1024;
+
+// Raised by the bit reader; never escapes the decoder
+struct EndOfStream {};
+struct CorruptFrame {};
+
+uint8_t crc8(const uint8_t* data, size_t count) {
+    static const std::array<uint8_t, 256> table = []() {
+        std::array<uint8_t, 256> t{};
+        for (unsigned i = 0; i < 256; ++i) {
+            unsigned crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 0x80) ? ((crc << 1) ^ 0x07) : (crc << 1);
+            }
+            t[i] = static_cast<uint8_t>(crc);
+        }
+        return t;
+    }();
+
+    uint8_t crc = 0;
+    for (size_t i = 0; i < count; ++i) {
+        crc = table[crc ^ data[i]];
+    }
+    return crc;
+}
+
+uint16_t crc16(const uint8_t* data, size_t count) {
+    static const std::array<uint16_t, 256> table = []() {
+        std::array<uint16_t, 256> t{};
+        for (unsigned i = 0; i < 256; ++i) {
+            unsigned crc = i << 8;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 0x8000) ? ((crc << 1) ^ 0x8005) : (crc << 1);
+            }
+            t[i] = static_cast<uint16_t>(crc);
+        }
+        return t;
+    }();
+
+    uint16_t crc = 0;
+    for (size_t i = 0; i < count; ++i) {
+        crc = static_cast<uint16_t>((crc << 8) ^ table[(crc >> 8) ^ data[i]]);
+    }
+    return crc;
+}
+
+} // namespace
+
+FLACDecoder::FLACDecoder()
+    : buffer_end_(0)
+    , byte_pos_(0)
+    , bit_pos_(0)
+    , anchor_(0)
+    , buffer_file_offset_(0)
+    , first_frame_offset_(0)
+    , block_size_(0)
+    , crc_errors_(0)
+    , open_(false) {
+}
+
+bool FLACDecoder::open(const std::string& filepath) {
+    close();
+
+    file_.open(filepath, std::ios::binary);
+    if (!file_) {
+        std::cerr << "Failed to open FLAC file: " << filepath << std::endl;
+        return false;
+    }
+
+    buffer_.assign(kReadBufferSize, 0);
+
+    bool valid = false;
+    try {
+        valid = parseMetadata();
+    } catch (const EndOfStream&) {
+        valid = false;
+    } catch (const CorruptFrame&) {
+        valid = false;
+    }
+
+    if (!valid || stream_info_.channels == 0 || stream_info_.sample_rate == 0 ||
+        stream_info_.bits_per_sample < 4 || stream_info_.bits_per_sample > 32) {
+        std::cerr << "Invalid FLAC stream: " << filepath << std::endl;
+        close();
+        return false;
+    }
+
+    size_t capacity = std::max<size_t>(stream_info_.max_block_size, 16);
+    channel_samples_.assign(stream_info_.channels, std::vector<int64_t>(capacity, 0));
+    open_ = true;
+    return true;
+}
+
+void FLACDecoder::close() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+    file_.clear();
+
+    buffer_.clear();
+    buffer_end_ = 0;
+    byte_pos_ = 0;
+    bit_pos_ = 0;
+    anchor_ = 0;
+    buffer_file_offset_ = 0;
+    first_frame_offset_ = 0;
+
+    stream_info_ = FLACStreamInfo();
+    vorbis_comments_.clear();
+    channel_samples_.clear();
+    block_size_ = 0;
+    crc_errors_ = 0;
+    open_ = false;
+}
+
+bool FLACDecoder::rewind() {
+    if (!open_) {
+        return false;
+    }
+
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(first_frame_offset_));
+
+    buffer_file_offset_ = first_frame_offset_;
+    buffer_end_ = 0;
+    byte_pos_ = 0;
+    bit_pos_ = 0;
+    anchor_ = 0;
+    block_size_ = 0;
+    crc_errors_ = 0;
+    return static_cast<bool>(file_);
+}
+
+bool FLACDecoder::decodeFrame() {
+    if (!open_) {
+        return false;
+    }
+
+    while (findSync()) {
+        try {
+            parseFrame();
+            anchor_ = byte_pos_;
+            return true;
+        } catch (const EndOfStream&) {
+            // Truncated final frame
+            crc_errors_++;
+            return false;
+        } catch (const CorruptFrame&) {
+            crc_errors_++;
+        }
+
+        // Resume the search one byte past the false or damaged header
+        byte_pos_ = anchor_ + 1;
+        bit_pos_ = 0;
+    }
+
+    return false;
+}
+
+// Byte source
+
+bool FLACDecoder::refill(size_t needed) {
+    if (buffer_end_ - byte_pos_ >= needed) {
+        return true;
+    }
+
+    // Keep everything from the anchor so the unit being parsed stays
+    // contiguous for its CRC
+    if (anchor_ > 0) {
+        std::memmove(buffer_.data(), buffer_.data() + anchor_, buffer_end_ - anchor_);
+        buffer_end_ -= anchor_;
+        byte_pos_ -= anchor_;
+        buffer_file_offset_ += anchor_;
+        anchor_ = 0;
+    }
+
+    size_t required = byte_pos_ + needed;
+    if (required > buffer_.size()) {
+        buffer_.resize(std::max(required, buffer_.size() * 2));
+    }
+
+    while (buffer_end_ - byte_pos_ < needed && file_) {
+        file_.read(reinterpret_cast<char*>(buffer_.data() + buffer_end_),
+                   static_cast<std::streamsize>(buffer_.size() - buffer_end_));
+        size_t received = static_cast<size_t>(file_.gcount());
+        if (received == 0) {
+            break;
+        }
+        buffer_end_ += received;
+    }
+
+    return buffer_end_ - byte_pos_ >= needed;
+}
+
+uint8_t FLACDecoder::currentByte() {
+    if (byte_pos_ >= buffer_end_ && !refill(1)) {
+        throw EndOfStream();
+    }
+    return buffer_[byte_pos_];
+}
+
+void FLACDecoder::skipBytes(uint64_t count) {
+    uint64_t available = buffer_end_ - byte_pos_;
+    if (count <= available) {
+        byte_pos_ += static_cast<size_t>(count);
+        return;
+    }
+
+    // Past the buffered data: seek instead of reading
+    count -= available;
+    buffer_file_offset_ += buffer_end_ + count;
+    buffer_end_ = 0;
+    byte_pos_ = 0;
+    anchor_ = 0;
+    file_.seekg(static_cast<std::streamoff>(count), std::ios::cur);
+}
+
+// Bit reader
+
+uint64_t FLACDecoder::readBits(unsigned count) {
+    uint64_t value = 0;
+
+    while (count > 0) {
+        uint8_t byte = currentByte();
+        unsigned available = 8 - bit_pos_;
+        unsigned take = count < available ? count : available;
+        unsigned shift = available - take;
+
+        value = (value << take) | ((byte >> shift) & ((1u << take) - 1));
+        bit_pos_ += take;
+        count -= take;
+
+        if (bit_pos_ == 8) {
+            bit_pos_ = 0;
+            ++byte_pos_;
+        }
+    }
+
+    return value;
+}
+
+int64_t FLACDecoder::readSigned(unsigned count) {
+    if (count == 0) {
+        return 0;
+    }
+
+    uint64_t value = readBits(count);
+    if (count < 64 && ((value >> (count - 1)) & 1)) {
+        value |= ~static_cast<uint64_t>(0) << count;
+    }
+    return static_cast<int64_t>(value);
+}
+
+uint32_t FLACDecoder::readUnary() {
+    uint32_t zeros = 0;
+
+    while (true) {
+        // Remaining bits of the current byte, aligned to the MSB
+        uint8_t bits = static_cast<uint8_t>(currentByte() << bit_pos_);
+
+        if (bits == 0) {
+            zeros += 8 - bit_pos_;
+            bit_pos_ = 0;
+            ++byte_pos_;
+            continue;
+        }
+
+        unsigned leading = 0;
+        while ((bits & 0x80) == 0) {
+            bits = static_cast<uint8_t>(bits << 1);
+            ++leading;
+        }
+
+        zeros += leading;
+        bit_pos_ += leading + 1;
+        if (bit_pos_ == 8) {
+            bit_pos_ = 0;
+            ++byte_pos_;
+        }
+        return zeros;
+    }
+}
+
+uint32_t FLACDecoder::readLittleEndian32() {
+    uint32_t value = 0;
+    for (unsigned i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(readBits(8)) << (8 * i);
+    }
+    return value;
+}
+
+void FLACDecoder::alignToByte() {
+    if (bit_pos_ != 0) {
+        bit_pos_ = 0;
+        ++byte_pos_;
+    }
+}
+
+// Stream structure
+
+bool FLACDecoder::parseMetadata() {
+    if (!refill(4)) {
+        return false;
+    }
+
+    // Optional ID3v2 tag in front of the stream marker
+    if (std::memcmp(buffer_.data() + byte_pos_, "ID3", 3) == 0) {
+        if (!refill(10)) {
+            return false;
+        }
+        const uint8_t* header = buffer_.data() + byte_pos_;
+        uint64_t tag_size = (static_cast<uint64_t>(header[6] & 0x7F) << 21) |
+                            (static_cast<uint64_t>(header[7] & 0x7F) << 14) |
+                            (static_cast<uint64_t>(header[8] & 0x7F) << 7) |
+                            static_cast<uint64_t>(header[9] & 0x7F);
+        bool has_footer = (header[5] & 0x10) != 0;
+        skipBytes(10 + tag_size + (has_footer ? 10 : 0));
+        anchor_ = byte_pos_;
+        if (!refill(4)) {
+            return false;
+        }
+    }
+
+    if (std::memcmp(buffer_.data() + byte_pos_, "fLaC", 4) != 0) {
+        return false;
+    }
+    byte_pos_ += 4;
+
+    bool have_stream_info = false;
+    bool last_block = false;
+
+    while (!last_block) {
+        anchor_ = byte_pos_;
+        last_block = readBits(1) != 0;
+        unsigned type = static_cast<unsigned>(readBits(7));
+        uint32_t length = static_cast<uint32_t>(readBits(24));
+
+        if (type == 0) {
+            if (length < 34) {
+                return false;
+            }
+            parseStreamInfo();
+            skipBytes(length - 34);
+            have_stream_info = true;
+        } else if (type == 4) {
+            parseVorbisComment(length);
+        } else {
+            skipBytes(length);
+        }
+    }
+
+    anchor_ = byte_pos_;
+    first_frame_offset_ = buffer_file_offset_ + byte_pos_;
+    return have_stream_info;
+}
+
+void FLACDecoder::parseStreamInfo() {
+    stream_info_.min_block_size = static_cast<uint32_t>(readBits(16));
+    stream_info_.max_block_size = static_cast<uint32_t>(readBits(16));
+    stream_info_.min_frame_size = static_cast<uint32_t>(readBits(24));
+    stream_info_.max_frame_size = static_cast<uint32_t>(readBits(24));
+    stream_info_.sample_rate = static_cast<uint32_t>(readBits(20));
+    stream_info_.channels = static_cast<uint32_t>(readBits(3)) + 1;
+    stream_info_.bits_per_sample = static_cast<uint32_t>(readBits(5)) + 1;
+    stream_info_.total_samples = readBits(36);
+
+    // MD5 signature of the unencoded audio is not verified
+    skipBytes(16);
+}
+
+void FLACDecoder::parseVorbisComment(uint32_t length) {
+    uint64_t remaining = length;
+
+    auto readString = [this](uint32_t size) {
+        std::string text;
+        text.reserve(size);
+        for (uint32_t i = 0; i < size; ++i) {
+            text.push_back(static_cast<char>(currentByte()));
+            ++byte_pos_;
+        }
+        return text;
+    };
+
+    // Vendor string
+    if (remaining < 4) {
+        skipBytes(remaining);
+        return;
+    }
+    uint32_t vendor_length = readLittleEndian32();
+    remaining -= 4;
+    if (vendor_length > remaining) {
+        skipBytes(remaining);
+        return;
+    }
+    skipBytes(vendor_length);
+    remaining -= vendor_length;
+
+    if (remaining < 4) {
+        skipBytes(remaining);
+        return;
+    }
+    uint32_t comment_count = readLittleEndian32();
+    remaining -= 4;
+
+    for (uint32_t i = 0; i < comment_count && remaining >= 4; ++i) {
+        anchor_ = byte_pos_;
+        uint32_t comment_length = readLittleEndian32();
+        remaining -= 4;
+        if (comment_length > remaining) {
+            break;
+        }
+
+        std::string comment = readString(comment_length);
+        remaining -= comment_length;
+
+        size_t separator = comment.find('=');
+        if (separator == std::string::npos) {
+            continue;
+        }
+
+        // Field names are case-insensitive ASCII
+        std::string key = comment.substr(0, separator);
+        std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) {
+            return static_cast<char>(std::toupper(c));
+        });
+        vorbis_comments_.emplace_back(key, comment.substr(separator + 1));
+    }
+
+    skipBytes(remaining);
+}
+
+bool FLACDecoder::findSync() {
+    alignToByte();
+
+    while (true) {
+        anchor_ = byte_pos_;
+        if (!refill(2)) {
+            return false;
+        }
+        if (buffer_[byte_pos_] == 0xFF && (buffer_[byte_pos_ + 1] & 0xFE) == 0xF8) {
+            return true;
+        }
+        ++byte_pos_;
+    }
+}
+
+void FLACDecoder::parseFrame() {
+    readBits(15);                       // Sync code, already matched
+    readBits(1);                        // Blocking strategy
+    unsigned block_code = static_cast<unsigned>(readBits(4));
+    unsigned rate_code = static_cast<unsigned>(readBits(4));
+    unsigned channel_code = static_cast<unsigned>(readBits(4));
+    unsigned size_code = static_cast<unsigned>(readBits(3));
+    if (readBits(1) != 0) {
+        throw CorruptFrame();
+    }
+
+    // Frame or sample number, UTF-8 style variable length
+    uint64_t lead = readBits(8);
+    if (lead & 0x80) {
+        unsigned extra = 0;
+        for (uint64_t mask = 0x40; (lead & mask) != 0; mask >>= 1) {
+            ++extra;
+        }
+        if (extra == 0 || extra > 6) {
+            throw CorruptFrame();
+        }
+        for (unsigned i = 0; i < extra; ++i) {
+            if ((readBits(8) & 0xC0) != 0x80) {
+                throw CorruptFrame();
+            }
+        }
+    }
+
+    size_t block_size = 0;
+    if (block_code == 0) {
+        throw CorruptFrame();
+    } else if (block_code == 1) {
+        block_size = 192;
+    } else if (block_code <= 5) {
+        block_size = static_cast<size_t>(576) << (block_code - 2);
+    } else if (block_code == 6) {
+        block_size = static_cast<size_t>(readBits(8)) + 1;
+    } else if (block_code == 7) {
+        block_size = static_cast<size_t>(readBits(16)) + 1;
+    } else {
+        block_size = static_cast<size_t>(256) << (block_code - 8);
+    }
+
+    // Only the size of the optional field matters; STREAMINFO gives the rate
+    if (rate_code == 12) {
+        readBits(8);
+    } else if (rate_code == 13 || rate_code == 14) {
+        readBits(16);
+    } else if (rate_code == 15) {
+        throw CorruptFrame();
+    }
+
+    static const unsigned kSampleSizes[8] = {0, 8, 12, 0, 16, 20, 24, 32};
+    unsigned bits_per_sample = size_code == 0 ? stream_info_.bits_per_sample : kSampleSizes[size_code];
+    if (bits_per_sample == 0) {
+        throw CorruptFrame();
+    }
+
+    size_t channels = channel_code < 8 ? channel_code + 1 : 2;
+    if (channel_code > 10 || channels != stream_info_.channels) {
+        throw CorruptFrame();
+    }
+
+    uint8_t header_crc = static_cast<uint8_t>(readBits(8));
+    if (crc8(buffer_.data() + anchor_, byte_pos_ - 1 - anchor_) != header_crc) {
+        throw CorruptFrame();
+    }
+
+    for (auto& samples : channel_samples_) {
+        if (samples.size() < block_size) {
+            samples.resize(block_size);
+        }
+    }
+
+    for (size_t channel = 0; channel < channels; ++channel) {
+        // Side channels carry one extra bit
+        bool side = (channel_code == 8 && channel == 1) ||
+                    (channel_code == 9 && channel == 0) ||
+                    (channel_code == 10 && channel == 1);
+        decodeSubframe(channel_samples_[channel].data(), block_size, bits_per_sample + (side ? 1 : 0));
+    }
+
+    alignToByte();
+    size_t frame_length = byte_pos_ - anchor_;
+    uint16_t expected_crc = crc16(buffer_.data() + anchor_, frame_length);
+    if (static_cast<uint16_t>(readBits(16)) != expected_crc) {
+        throw CorruptFrame();
+    }
+
+    // Undo inter-channel decorrelation
+    if (channel_code >= 8) {
+        int64_t* first = channel_samples_[0].data();
+        int64_t* second = channel_samples_[1].data();
+
+        for (size_t i = 0; i < block_size; ++i) {
+            if (channel_code == 8) {
+                second[i] = first[i] - second[i];
+            } else if (channel_code == 9) {
+                first[i] = first[i] + second[i];
+            } else {
+                int64_t side = second[i];
+                int64_t mid = static_cast<int64_t>(static_cast<uint64_t>(first[i]) << 1) | (side & 1);
+                first[i] = (mid + side) >> 1;
+                second[i] = (mid - side) >> 1;
+            }
+        }
+    }
+
+    block_size_ = block_size;
+}
+
+void FLACDecoder::decodeSubframe(int64_t* output, size_t block_size, unsigned bits_per_sample) {
+    if (readBits(1) != 0) {
+        throw CorruptFrame();
+    }
+
+    unsigned type = static_cast<unsigned>(readBits(6));
+
+    unsigned wasted_bits = 0;
+    if (readBits(1) != 0) {
+        wasted_bits = readUnary() + 1;
+        if (wasted_bits >= bits_per_sample) {
+            throw CorruptFrame();
+        }
+        bits_per_sample -= wasted_bits;
+    }
+
+    if (type == 0) {
+        // CONSTANT
+        int64_t value = readSigned(bits_per_sample);
+        std::fill(output, output + block_size, value);
+    } else if (type == 1) {
+        // VERBATIM
+        for (size_t i = 0; i < block_size; ++i) {
+            output[i] = readSigned(bits_per_sample);
+        }
+    } else if (type >= 8 && type <= 12) {
+        // FIXED polynomial predictor
+        unsigned order = type - 8;
+        if (order > block_size) {
+            throw CorruptFrame();
+        }
+        for (unsigned i = 0; i < order; ++i) {
+            output[i] = readSigned(bits_per_sample);
+        }
+
+        decodeResidual(output, block_size, order);
+
+        switch (order) {
+            case 1:
+                for (size_t i = 1; i < block_size; ++i) {
+                    output[i] += output[i - 1];
+                }
+                break;
+            case 2:
+                for (size_t i = 2; i < block_size; ++i) {
+                    output[i] += 2 * output[i - 1] - output[i - 2];
+                }
+                break;
+            case 3:
+                for (size_t i = 3; i < block_size; ++i) {
+                    output[i] += 3 * output[i - 1] - 3 * output[i - 2] + output[i - 3];
+                }
+                break;
+            case 4:
+                for (size_t i = 4; i < block_size; ++i) {
+                    output[i] += 4 * output[i - 1] - 6 * output[i - 2] + 4 * output[i - 3] - output[i - 4];
+                }
+                break;
+            default:
+                break;
+        }
+    } else if (type >= 32) {
+        // LPC with quantized coefficients
+        unsigned order = (type & 31) + 1;
+        if (order > block_size) {
+            throw CorruptFrame();
+        }
+        for (unsigned i = 0; i < order; ++i) {
+            output[i] = readSigned(bits_per_sample);
+        }
+
+        unsigned precision = static_cast<unsigned>(readBits(4)) + 1;
+        if (precision == 16) {
+            throw CorruptFrame();
+        }
+        int64_t shift = readSigned(5);
+        if (shift < 0) {
+            throw CorruptFrame();
+        }
+
+        int64_t coefficients[32];
+        for (unsigned i = 0; i < order; ++i) {
+            coefficients[i] = readSigned(precision);
+        }
+
+        decodeResidual(output, block_size, order);
+
+        for (size_t i = order; i < block_size; ++i) {
+            int64_t prediction = 0;
+            for (unsigned j = 0; j < order; ++j) {
+                prediction += coefficients[j] * output[i - 1 - j];
+            }
+            output[i] += prediction >> shift;
+        }
+    } else {
+        throw CorruptFrame();
+    }
+
+    if (wasted_bits > 0) {
+        for (size_t i = 0; i < block_size; ++i) {
+            output[i] = static_cast<int64_t>(static_cast<uint64_t>(output[i]) << wasted_bits);
+        }
+    }
+}
+
+void FLACDecoder::decodeResidual(int64_t* output, size_t block_size, unsigned predictor_order) {
+    unsigned method = static_cast<unsigned>(readBits(2));
+    if (method > 1) {
+        throw CorruptFrame();
+    }
+
+    unsigned parameter_bits = method == 0 ? 4 : 5;
+    uint64_t escape_code = method == 0 ? 15 : 31;
+
+    unsigned partition_order = static_cast<unsigned>(readBits(4));
+    size_t partitions = static_cast<size_t>(1) << partition_order;
+    size_t partition_size = block_size >> partition_order;
+    if ((block_size & (partitions - 1)) != 0 || partition_size < predictor_order) {
+        throw CorruptFrame();
+    }
+
+    size_t index = predictor_order;
+    for (size_t partition = 0; partition < partitions; ++partition) {
+        size_t count = partition == 0 ? partition_size - predictor_order : partition_size;
+        uint64_t parameter = readBits(parameter_bits);
+
+        if (parameter == escape_code) {
+            // Unencoded partition
+            unsigned raw_bits = static_cast<unsigned>(readBits(5));
+            for (size_t i = 0; i < count; ++i) {
+                output[index++] = readSigned(raw_bits);
+            }
+        } else {
+            // Rice coded: unary quotient, then `parameter` low bits, zigzag signed
+            unsigned k = static_cast<unsigned>(parameter);
+            for (size_t i = 0; i < count; ++i) {
+                uint64_t folded = (static_cast<uint64_t>(readUnary()) << k) | readBits(k);
+                output[index++] = static_cast<int64_t>(folded >> 1) ^ -static_cast<int64_t>(folded & 1);
+            }
+        }
+    }
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace AnantaSound {
+
+// Contents of the FLAC STREAMINFO block
+struct FLACStreamInfo {
+    uint32_t min_block_size;
+    uint32_t max_block_size;
+    uint32_t min_frame_size;
+    uint32_t max_frame_size;
+    uint32_t sample_rate;
+    uint32_t channels;
+    uint32_t bits_per_sample;
+    uint64_t total_samples;         // Per channel; 0 when unknown
+
+    FLACStreamInfo() : min_block_size(0), max_block_size(0), min_frame_size(0),
+                       max_frame_size(0), sample_rate(0), channels(0),
+                       bits_per_sample(0), total_samples(0) {}
+};
+
+// Native streaming FLAC decoder.
+// The file is read through a small refillable buffer and decoded one frame
+// at a time, so memory use depends on the block size, not the file length.
+// Frame headers (CRC-8) and frames (CRC-16) are checked; a corrupt frame is
+// counted, then the decoder resynchronizes on the next frame header.
+class FLACDecoder {
+private:
+    std::ifstream file_;
+    std::vector<uint8_t> buffer_;
+    size_t buffer_end_;             // Valid bytes in buffer_
+    size_t byte_pos_;               // Current byte in buffer_
+    unsigned bit_pos_;              // Bits consumed in the current byte (0-7)
+    size_t anchor_;                 // Start of the unit being parsed; kept on refill
+    uint64_t buffer_file_offset_;   // File offset of buffer_[0]
+    uint64_t first_frame_offset_;
+
+    FLACStreamInfo stream_info_;
+    std::vector<std::pair<std::string, std::string>> vorbis_comments_;
+
+    std::vector<std::vector<int64_t>> channel_samples_;
+    size_t block_size_;
+    size_t crc_errors_;
+    bool open_;
+
+public:
+    FLACDecoder();
+    ~FLACDecoder() = default;
+
+    FLACDecoder(const FLACDecoder&) = delete;
+    FLACDecoder& operator=(const FLACDecoder&) = delete;
+
+    // Open a file and parse its metadata blocks
+    bool open(const std::string& filepath);
+    void close();
+    bool isOpen() const { return open_; }
+
+    // Return to the first audio frame
+    bool rewind();
+
+    // Decode the next frame; false at end of stream
+    bool decodeFrame();
+
+    // Samples of the last decoded frame
+    size_t getBlockSize() const { return block_size_; }
+    const int64_t* getChannel(size_t channel) const { return channel_samples_[channel].data(); }
+
+    const FLACStreamInfo& getStreamInfo() const { return stream_info_; }
+    const std::vector<std::pair<std::string, std::string>>& getVorbisComments() const { return vorbis_comments_; }
+
+    // Frames dropped because of a header or frame CRC mismatch
+    size_t getCRCErrors() const { return crc_errors_; }
+
+private:
+    // Byte source
+    bool refill(size_t needed);
+    uint8_t currentByte();
+    void skipBytes(uint64_t count);
+
+    // Bit reader (MSB first)
+    uint64_t readBits(unsigned count);
+    int64_t readSigned(unsigned count);
+    uint32_t readUnary();
+    uint32_t readLittleEndian32();
+    void alignToByte();
+
+    // Stream structure
+    bool parseMetadata();
+    void parseStreamInfo();
+    void parseVorbisComment(uint32_t length);
+    bool findSync();
+    void parseFrame();
+    void decodeSubframe(int64_t* output, size_t block_size, unsigned bits_per_sample);
+    void decodeResidual(int64_t* output, size_t block_size, unsigned predictor_order);
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,83 @@
+#include "harmonic_bank.hpp"
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kTwoPi = 2.0 * kPi;
+
+// Bring a phase that drifted by less than one turn back into [-π, π]
+inline double wrapStep(double phase) {
+    if (phase > kPi) {
+        phase -= kTwoPi;
+    } else if (phase < -kPi) {
+        phase += kTwoPi;
+    }
+    return phase;
+}
+
+} // namespace
+
+HarmonicBank::HarmonicBank(size_t renormalize_interval)
+    : renormalize_interval_(renormalize_interval) {
+}
+
+void HarmonicBank::generate(const HarmonicSeries& series, size_t count, const HarmonicBuffers& output) const {
+    if (count == 0) {
+        return;
+    }
+
+    if (output.frequency) {
+        for (size_t i = 0; i < count; ++i) {
+            output.frequency[i] = series.frequency * static_cast<double>(i + 1);
+        }
+    }
+
+    if (output.amplitude) {
+        // g_h = exp(-a (h - 1)^2), a = (f_1 / width)^2: g_{h+1} = g_h · r_h, r_{h+1} = r_h · q
+        double envelope = 1.0, ratio = 1.0, ratio_step = 1.0;
+        if (series.envelope_width != 0.0) {
+            double a = series.frequency / series.envelope_width;
+            a *= a;
+            ratio = std::exp(-a);
+            ratio_step = std::exp(-2.0 * a);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            output.amplitude[i] = series.amplitude / static_cast<double>(i + 1) * envelope;
+            envelope *= ratio;
+            ratio *= ratio_step;
+        }
+    }
+
+    if (output.phase) {
+        if (series.wrap_phase) {
+            double step = std::remainder(series.phase, kTwoPi);
+            double phase = std::remainder(series.phase_offset + step, kTwoPi);
+            for (size_t i = 0; i < count; ++i) {
+                output.phase[i] = phase;
+                phase = wrapStep(phase + step);
+            }
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                output.phase[i] = series.phase * static_cast<double>(i + 1) + series.phase_offset;
+            }
+        }
+    }
+
+    if (output.phasor) {
+        const std::complex<double> step = std::polar(1.0, series.phase);
+        std::complex<double> phasor = std::polar(1.0, series.phase_offset) * step;
+        for (size_t i = 0; i < count; ++i) {
+            output.phasor[i] = phasor;
+            phasor *= step;
+            if (renormalize_interval_ != 0 && (i + 1) % renormalize_interval_ == 0) {
+                // Newton step toward |z| = 1: z · (3 - |z|^2) / 2
+                phasor *= 0.5 * (3.0 - std::norm(phasor));
+            }
+        }
+    }
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// One harmonic series h = 1..N of a fundamental
+struct HarmonicSeries {
+    double frequency = 0.0;         // f_1; harmonic h sits at h · f_1
+    double amplitude = 1.0;         // a_1; harmonic h gets a_1 / h · envelope_h
+    double phase = 0.0;             // φ_1; harmonic h gets h · φ_1 + phase_offset
+    double phase_offset = 0.0;
+    double envelope_width = 0.0;    // envelope_h = exp(-((f_h - f_1) / width)^2); 0 - flat
+    bool wrap_phase = false;        // Wrap the harmonic phases to [-π, π]
+};
+
+// Caller-owned output arrays of at least count entries; null ones are skipped
+struct HarmonicBuffers {
+    double* frequency = nullptr;
+    double* amplitude = nullptr;
+    double* phase = nullptr;
+    std::complex<double>* phasor = nullptr;     // exp(i · phase_h)
+};
+
+// Harmonic series generator.
+// Everything is produced by recurrences over h, so a series of N harmonics
+// costs a few transcendental calls in total instead of several per harmonic:
+// the Gaussian envelope ratio g_{h+1} / g_h is itself a geometric sequence,
+// phasors advance by one complex multiply per harmonic, and wrapped phases
+// by one add. Phasors are pulled back to unit magnitude every
+// renormalize_interval harmonics (0 - never) with one Newton step, which
+// costs no square root.
+class HarmonicBank {
+private:
+    size_t renormalize_interval_;
+
+public:
+    static constexpr size_t kDefaultRenormalizeInterval = 32;
+
+    explicit HarmonicBank(size_t renormalize_interval = kDefaultRenormalizeInterval);
+
+    size_t getRenormalizeInterval() const { return renormalize_interval_; }
+
+    // Fill harmonics 1..count of series into the non-null buffers
+    void generate(const HarmonicSeries& series, size_t count, const HarmonicBuffers& output) const;
+};
+
+} // namespace AnantaSound
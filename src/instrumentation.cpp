@@ -0,0 +1,350 @@
+#include "instrumentation.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace AnantaSound {
+
+namespace {
+
+constexpr uint64_t kNoMinimum = std::numeric_limits<uint64_t>::max();
+
+void storeMax(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void storeMin(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+int highestBit(uint64_t value) {
+    return 63 - __builtin_clzll(value);
+}
+
+void appendJsonString(std::ostringstream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+void appendMicroseconds(std::ostringstream& out, uint64_t ns) {
+    out << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000 << std::setfill(' ');
+}
+
+} // namespace
+
+// LatencyHistogram
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(value, std::memory_order_relaxed);
+    storeMin(min_, value);
+    storeMax(max_, value);
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    total_.store(0, std::memory_order_relaxed);
+    min_.store(kNoMinimum, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMin() const {
+    uint64_t min = min_.load(std::memory_order_relaxed);
+    return min == kNoMinimum ? 0 : min;
+}
+
+uint64_t LatencyHistogram::getPercentile(double quantile) const {
+    uint64_t count = getCount();
+    if (count == 0) {
+        return 0;
+    }
+    quantile = std::clamp(quantile, 0.0, 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(quantile * static_cast<double>(count) + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), getMax());
+        }
+    }
+    return getMax();
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < kSubBuckets) {
+        return static_cast<size_t>(value);
+    }
+    // The three bits below the leading one pick the sub-bucket
+    int msb = highestBit(value);
+    size_t sub = static_cast<size_t>(value >> (msb - 3)) & (kSubBuckets - 1);
+    return static_cast<size_t>(msb - 2) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    int shift = static_cast<int>(index / kSubBuckets) - 1;
+    uint64_t lower = (kSubBuckets + index % kSubBuckets) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+// Instrumentation
+Instrumentation::Instrumentation()
+    : stage_count_(0)
+    , lock_count_(0)
+    , trace_enabled_(false)
+    , trace_(nullptr)
+    , trace_next_(0)
+    , allocation_counter_(nullptr) {
+}
+
+Instrumentation& Instrumentation::shared() {
+    static Instrumentation instance;
+    return instance;
+}
+
+bool Instrumentation::isEnabled() {
+#ifdef ANANTASOUND_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t Instrumentation::now() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+uint32_t Instrumentation::threadId() {
+    static std::atomic<uint32_t> next_id{1};
+    thread_local uint32_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+StageSlot* Instrumentation::registerStage(const char* name) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    size_t count = stage_count_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (std::strcmp(stages_[i].name, name) == 0) {
+            return &stages_[i];
+        }
+    }
+    if (count == kMaxStages) {
+        return nullptr;
+    }
+    stages_[count].name = name;
+    stages_[count].index = static_cast<uint32_t>(count);
+    stage_count_.store(count + 1, std::memory_order_release);
+    return &stages_[count];
+}
+
+LockSlot* Instrumentation::registerLock(const char* name) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    size_t count = lock_count_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (std::strcmp(locks_[i].name, name) == 0) {
+            return &locks_[i];
+        }
+    }
+    if (count == kMaxLocks) {
+        return nullptr;
+    }
+    locks_[count].name = name;
+    lock_count_.store(count + 1, std::memory_order_release);
+    return &locks_[count];
+}
+
+void Instrumentation::setTraceEnabled(bool enabled) {
+    if (enabled && !trace_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        if (!trace_.load(std::memory_order_relaxed)) {
+            TraceEvent* events = new TraceEvent[kTraceCapacity];
+            for (size_t i = 0; i < kTraceCapacity; ++i) {
+                events[i].start_ns.store(0, std::memory_order_relaxed);
+                events[i].duration_ns.store(0, std::memory_order_relaxed);
+                events[i].stage.store(0, std::memory_order_relaxed);
+                events[i].thread.store(0, std::memory_order_relaxed);
+            }
+            trace_.store(events, std::memory_order_release);
+        }
+    }
+    trace_enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Instrumentation::setAllocationCounter(AllocationCounter counter) {
+    allocation_counter_.store(counter, std::memory_order_relaxed);
+}
+
+void Instrumentation::recordStage(StageSlot& stage, uint64_t start_ns, uint64_t duration_ns, uint64_t allocations) {
+    stage.latency_ns.record(duration_ns);
+    if (allocations > 0) {
+        stage.allocations.fetch_add(allocations, std::memory_order_relaxed);
+    }
+
+    if (!trace_enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    TraceEvent* events = trace_.load(std::memory_order_acquire);
+    if (!events) {
+        return;
+    }
+    TraceEvent& event = events[trace_next_.fetch_add(1, std::memory_order_relaxed) % kTraceCapacity];
+    event.start_ns.store(start_ns, std::memory_order_relaxed);
+    event.duration_ns.store(duration_ns, std::memory_order_relaxed);
+    event.stage.store(stage.index, std::memory_order_relaxed);
+    event.thread.store(threadId(), std::memory_order_relaxed);
+}
+
+InstrumentationStatistics Instrumentation::getStatistics() const {
+    InstrumentationStatistics statistics;
+    statistics.enabled = isEnabled();
+
+    size_t stage_count = stage_count_.load(std::memory_order_acquire);
+    statistics.stages.reserve(stage_count);
+    for (size_t i = 0; i < stage_count; ++i) {
+        const StageSlot& slot = stages_[i];
+        StageStatistics stage;
+        stage.name = slot.name;
+        stage.count = slot.latency_ns.getCount();
+        stage.total_ns = slot.latency_ns.getTotal();
+        stage.min_ns = slot.latency_ns.getMin();
+        stage.max_ns = slot.latency_ns.getMax();
+        stage.p50_ns = slot.latency_ns.getPercentile(0.50);
+        stage.p90_ns = slot.latency_ns.getPercentile(0.90);
+        stage.p99_ns = slot.latency_ns.getPercentile(0.99);
+        stage.allocations = slot.allocations.load(std::memory_order_relaxed);
+        statistics.stages.push_back(stage);
+    }
+
+    size_t lock_count = lock_count_.load(std::memory_order_acquire);
+    statistics.locks.reserve(lock_count);
+    for (size_t i = 0; i < lock_count; ++i) {
+        const LockSlot& slot = locks_[i];
+        LockStatistics lock;
+        lock.name = slot.name;
+        lock.acquisitions = slot.acquisitions.load(std::memory_order_relaxed);
+        lock.contended = slot.contended.load(std::memory_order_relaxed);
+        lock.total_wait_ns = slot.total_wait_ns.load(std::memory_order_relaxed);
+        lock.max_wait_ns = slot.max_wait_ns.load(std::memory_order_relaxed);
+        statistics.locks.push_back(lock);
+    }
+
+    uint64_t recorded = trace_next_.load(std::memory_order_relaxed);
+    statistics.trace_events = static_cast<size_t>(std::min<uint64_t>(recorded, kTraceCapacity));
+    statistics.dropped_trace_events = static_cast<size_t>(recorded - statistics.trace_events);
+    return statistics;
+}
+
+void Instrumentation::reset() {
+    size_t stage_count = stage_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < stage_count; ++i) {
+        stages_[i].latency_ns.reset();
+        stages_[i].allocations.store(0, std::memory_order_relaxed);
+    }
+    size_t lock_count = lock_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < lock_count; ++i) {
+        locks_[i].acquisitions.store(0, std::memory_order_relaxed);
+        locks_[i].contended.store(0, std::memory_order_relaxed);
+        locks_[i].total_wait_ns.store(0, std::memory_order_relaxed);
+        locks_[i].max_wait_ns.store(0, std::memory_order_relaxed);
+    }
+    trace_next_.store(0, std::memory_order_relaxed);
+}
+
+std::string Instrumentation::toChromeTrace() const {
+    std::ostringstream out;
+    out << "{\"traceEvents\":[";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"anAntaSound\"}}";
+
+    // Events are read oldest first; tracing should be quiet while exporting
+    TraceEvent* events = trace_.load(std::memory_order_acquire);
+    uint64_t recorded = trace_next_.load(std::memory_order_relaxed);
+    uint64_t first = recorded > kTraceCapacity ? recorded - kTraceCapacity : 0;
+    size_t stage_count = stage_count_.load(std::memory_order_acquire);
+    for (uint64_t i = first; events && i < recorded; ++i) {
+        const TraceEvent& event = events[i % kTraceCapacity];
+        uint32_t stage = event.stage.load(std::memory_order_relaxed);
+        if (stage >= stage_count) {
+            continue;
+        }
+        out << ",\n{\"name\":";
+        appendJsonString(out, stages_[stage].name);
+        out << ",\"cat\":\"anantasound\",\"ph\":\"X\",\"ts\":";
+        appendMicroseconds(out, event.start_ns.load(std::memory_order_relaxed));
+        out << ",\"dur\":";
+        appendMicroseconds(out, event.duration_ns.load(std::memory_order_relaxed));
+        out << ",\"pid\":1,\"tid\":" << event.thread.load(std::memory_order_relaxed) << "}";
+    }
+    out << "],\"displayTimeUnit\":\"ns\"}\n";
+    return out.str();
+}
+
+bool Instrumentation::exportChromeTrace(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file << toChromeTrace();
+    return static_cast<bool>(file);
+}
+
+// ScopedStageTimer
+ScopedStageTimer::ScopedStageTimer(StageSlot* stage)
+    : stage_(stage)
+    , counter_(nullptr)
+    , start_ns_(0)
+    , start_allocations_(0) {
+    if (!stage_) {
+        return;
+    }
+    counter_ = Instrumentation::shared().getAllocationCounter();
+    start_allocations_ = counter_ ? counter_() : 0;
+    start_ns_ = Instrumentation::now();
+}
+
+ScopedStageTimer::~ScopedStageTimer() {
+    if (!stage_) {
+        return;
+    }
+    uint64_t end_ns = Instrumentation::now();
+    size_t allocations = counter_ ? counter_() - start_allocations_ : 0;
+    Instrumentation::shared().recordStage(*stage_, start_ns_, end_ns - start_ns_, allocations);
+}
+
+void recordLockAcquisition(LockSlot* lock, bool contended, uint64_t wait_ns) {
+    if (!lock) {
+        return;
+    }
+    lock->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if (contended) {
+        lock->contended.fetch_add(1, std::memory_order_relaxed);
+        lock->total_wait_ns.fetch_add(wait_ns, std::memory_order_relaxed);
+        storeMax(lock->max_wait_ns, wait_ns);
+    }
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace AnantaSound {
+
+// Log-linear latency histogram in the HDR style: values below 8 are exact,
+// above that every power of two is split into 8 sub-buckets, so any recorded
+// value is reported within 12.5% over the full 64-bit range. Buckets are
+// relaxed atomics; recording never locks or allocates.
+class LatencyHistogram {
+public:
+    static constexpr size_t kSubBuckets = 8;
+    static constexpr size_t kBucketCount = 62 * kSubBuckets;
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> total_;
+    std::atomic<uint64_t> min_;
+    std::atomic<uint64_t> max_;
+
+public:
+    LatencyHistogram();
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t getTotal() const { return total_.load(std::memory_order_relaxed); }
+    uint64_t getMin() const;
+    uint64_t getMax() const { return max_.load(std::memory_order_relaxed); }
+
+    // Upper bound of the bucket holding the given quantile (0..1), capped at
+    // the largest recorded value; 0 when empty
+    uint64_t getPercentile(double quantile) const;
+
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(size_t index);
+};
+
+// Accumulators for one named stage; owned by Instrumentation
+struct StageSlot {
+    const char* name;
+    uint32_t index;
+    LatencyHistogram latency_ns;
+    std::atomic<uint64_t> allocations;
+
+    StageSlot() : name(nullptr), index(0), allocations(0) {}
+};
+
+// Accumulators for one named mutex; owned by Instrumentation
+struct LockSlot {
+    const char* name;
+    std::atomic<uint64_t> acquisitions;
+    std::atomic<uint64_t> contended;        // Acquisitions that had to wait
+    std::atomic<uint64_t> total_wait_ns;
+    std::atomic<uint64_t> max_wait_ns;
+
+    LockSlot() : name(nullptr), acquisitions(0), contended(0), total_wait_ns(0), max_wait_ns(0) {}
+};
+
+struct StageStatistics {
+    const char* name;
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t min_ns;
+    uint64_t max_ns;
+    uint64_t p50_ns;
+    uint64_t p90_ns;
+    uint64_t p99_ns;
+    uint64_t allocations;       // Needs an allocation counter, see setAllocationCounter
+};
+
+struct LockStatistics {
+    const char* name;
+    uint64_t acquisitions;
+    uint64_t contended;
+    uint64_t total_wait_ns;
+    uint64_t max_wait_ns;
+};
+
+struct InstrumentationStatistics {
+    bool enabled;               // Library built with ENABLE_INSTRUMENTATION
+    std::vector<StageStatistics> stages;
+    std::vector<LockStatistics> locks;
+    size_t trace_events;        // Events currently held by the trace buffer
+    size_t dropped_trace_events;  // Overwritten by newer events
+};
+
+// Process-wide registry of stage timers and lock counters.
+// The library's hot paths are instrumented through the macros below, which
+// compile to nothing (or a plain std::lock_guard) unless the library is built
+// with ENABLE_INSTRUMENTATION. Stages and locks are fixed slots registered
+// once per call site and keyed by name, so names must have static storage
+// duration (string literals). Recording is lock-free and does not allocate;
+// when tracing is on, each timed stage also lands in a fixed ring buffer that
+// exportChromeTrace writes in the Chrome trace event format, which Perfetto
+// and chrome://tracing both load.
+class Instrumentation {
+public:
+    static constexpr size_t kMaxStages = 64;
+    static constexpr size_t kMaxLocks = 32;
+    static constexpr size_t kTraceCapacity = size_t(1) << 16;
+
+    // Returns the calling thread's running allocation count
+    using AllocationCounter = size_t (*)();
+
+private:
+    struct TraceEvent {
+        std::atomic<uint64_t> start_ns;
+        std::atomic<uint64_t> duration_ns;
+        std::atomic<uint32_t> stage;
+        std::atomic<uint32_t> thread;
+    };
+
+    std::mutex registry_mutex_;
+    std::array<StageSlot, kMaxStages> stages_;
+    std::array<LockSlot, kMaxLocks> locks_;
+    std::atomic<size_t> stage_count_;
+    std::atomic<size_t> lock_count_;
+
+    std::atomic<bool> trace_enabled_;
+    std::atomic<TraceEvent*> trace_;       // Allocated on first enable, kept for the process
+    std::atomic<uint64_t> trace_next_;
+    std::atomic<AllocationCounter> allocation_counter_;
+
+    Instrumentation();
+
+public:
+    static Instrumentation& shared();
+
+    // True when the library was compiled with ENABLE_INSTRUMENTATION
+    static bool isEnabled();
+
+    // Nanoseconds on the steady clock since the first call in this process
+    static uint64_t now();
+
+    // Small sequential id of the calling thread, as used in traces
+    static uint32_t threadId();
+
+    // Slot for a name, created on first use; nullptr when the table is full
+    StageSlot* registerStage(const char* name);
+    LockSlot* registerLock(const char* name);
+
+    void setTraceEnabled(bool enabled);
+    bool isTraceEnabled() const { return trace_enabled_.load(std::memory_order_relaxed); }
+
+    // Stage allocation counts come from this per-thread counter (for example
+    // one kept by an application's replacement operator new); nullptr turns
+    // them off
+    void setAllocationCounter(AllocationCounter counter);
+    AllocationCounter getAllocationCounter() const { return allocation_counter_.load(std::memory_order_relaxed); }
+
+    void recordStage(StageSlot& stage, uint64_t start_ns, uint64_t duration_ns, uint64_t allocations);
+
+    InstrumentationStatistics getStatistics() const;
+
+    // Clear all counters, histograms and the trace; registrations are kept
+    void reset();
+
+    // Write the trace buffer as {"traceEvents": [...]} JSON; false on I/O error
+    bool exportChromeTrace(const std::string& path) const;
+    std::string toChromeTrace() const;
+};
+
+// Times one stage from construction to destruction
+class ScopedStageTimer {
+public:
+    explicit ScopedStageTimer(StageSlot* stage);
+    ~ScopedStageTimer();
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+    StageSlot* stage_;
+    Instrumentation::AllocationCounter counter_;
+    uint64_t start_ns_;
+    size_t start_allocations_;
+};
+
+void recordLockAcquisition(LockSlot* lock, bool contended, uint64_t wait_ns);
+
+// std::lock_guard that counts acquisitions and, when try_lock fails, the time
+// spent waiting for the owner
+template<typename Mutex>
+class InstrumentedLockGuard {
+public:
+    InstrumentedLockGuard(Mutex& mutex, LockSlot* lock) : mutex_(mutex) {
+        if (mutex_.try_lock()) {
+            recordLockAcquisition(lock, false, 0);
+            return;
+        }
+        uint64_t start = Instrumentation::now();
+        mutex_.lock();
+        recordLockAcquisition(lock, true, Instrumentation::now() - start);
+    }
+
+    ~InstrumentedLockGuard() { mutex_.unlock(); }
+
+    InstrumentedLockGuard(const InstrumentedLockGuard&) = delete;
+    InstrumentedLockGuard& operator=(const InstrumentedLockGuard&) = delete;
+
+private:
+    Mutex& mutex_;
+};
+
+} // namespace AnantaSound
+
+#define ANANTASOUND_CONCAT_IMPL(a, b) a##b
+#define ANANTASOUND_CONCAT(a, b) ANANTASOUND_CONCAT_IMPL(a, b)
+
+#ifdef ANANTASOUND_INSTRUMENTATION
+
+// Time the rest of the enclosing scope as the named stage
+#define ANANTASOUND_STAGE_TIMER(name)                                                           \
+    static ::AnantaSound::StageSlot* const ANANTASOUND_CONCAT(anantasound_stage_, __LINE__) =   \
+        ::AnantaSound::Instrumentation::shared().registerStage(name);                           \
+    ::AnantaSound::ScopedStageTimer ANANTASOUND_CONCAT(anantasound_timer_, __LINE__)(           \
+        ANANTASOUND_CONCAT(anantasound_stage_, __LINE__))
+
+// Lock a mutex for the rest of the scope, counting contention under the name
+#define ANANTASOUND_LOCK_GUARD(guard, mutex, name)                                              \
+    static ::AnantaSound::LockSlot* const ANANTASOUND_CONCAT(anantasound_lock_, __LINE__) =     \
+        ::AnantaSound::Instrumentation::shared().registerLock(name);                            \
+    ::AnantaSound::InstrumentedLockGuard<std::decay_t<decltype(mutex)>> guard(                  \
+        mutex, ANANTASOUND_CONCAT(anantasound_lock_, __LINE__))
+
+#else
+
+#define ANANTASOUND_STAGE_TIMER(name) ((void)0)
+#define ANANTASOUND_LOCK_GUARD(guard, mutex, name) std::lock_guard<std::decay_t<decltype(mutex)>> guard(mutex)
+
+#endif
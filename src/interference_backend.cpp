@@ -0,0 +1,278 @@
+#include "interference_backend.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+// Points per parallelFor chunk; each point already walks every source
+constexpr size_t kPointGrain = 64;
+
+uint64_t nextGridVersion() {
+    static std::atomic<uint64_t> version{0};
+    return version.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // namespace
+
+// InterferencePointGrid
+InterferencePointGrid::InterferencePointGrid() : version_(nextGridVersion()) {
+}
+
+InterferencePointGrid::InterferencePointGrid(const SphericalCoord* positions, size_t count)
+    : version_(0) {
+    assign(positions, count);
+}
+
+InterferencePointGrid::InterferencePointGrid(const std::vector<SphericalCoord>& positions)
+    : InterferencePointGrid(positions.data(), positions.size()) {
+}
+
+void InterferencePointGrid::assign(const SphericalCoord* positions, size_t count) {
+    x_.resize(count);
+    y_.resize(count);
+    z_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        CartesianPosition point = CartesianPosition::fromSpherical(positions[i]);
+        x_[i] = point.x;
+        y_[i] = point.y;
+        z_[i] = point.z;
+    }
+    version_ = nextGridVersion();
+}
+
+// BakedInterferenceLayout
+BakedInterferenceLayout::BakedInterferenceLayout()
+    : listener_count_(0)
+    , source_count_(0)
+    , geometry_version_(0) {
+}
+
+void BakedInterferenceLayout::bake(const InterferenceSources& sources, uint64_t geometry_version,
+                                   const InterferencePointGrid& grid, ThreadPool* pool) {
+    listener_count_ = grid.size();
+    source_count_ = sources.count;
+    geometry_version_ = geometry_version;
+    phasor_real_.resize(listener_count_ * source_count_);
+    phasor_imag_.resize(listener_count_ * source_count_);
+
+    // Baked once, so the exact libm phasor rather than the kernels' polynomial
+    auto bake_rows = [&](size_t begin, size_t end, size_t) {
+        for (size_t l = begin; l < end; ++l) {
+            double* row_real = phasor_real_.data() + l * source_count_;
+            double* row_imag = phasor_imag_.data() + l * source_count_;
+            for (size_t s = 0; s < source_count_; ++s) {
+                double dx = grid.x()[l] - sources.x[s];
+                double dy = grid.y()[l] - sources.y[s];
+                double dz = grid.z()[l] - sources.z[s];
+                double phase = sources.wavenumber[s] * std::sqrt(dx * dx + dy * dy + dz * dz);
+                row_real[s] = std::cos(phase);
+                row_imag[s] = -std::sin(phase);
+            }
+        }
+    };
+    if (pool) {
+        pool->parallelFor(listener_count_, kPointGrain, bake_rows);
+    } else {
+        bake_rows(0, listener_count_, 0);
+    }
+}
+
+void BakedInterferenceLayout::evaluate(const double* weight_real, const double* weight_imag,
+                                       std::complex<double>* output, const InterferenceKernelTable& kernels,
+                                       ThreadPool* pool) const {
+    auto evaluate_rows = [&](size_t begin, size_t end, size_t) {
+        for (size_t l = begin; l < end; ++l) {
+            output[l] = kernels.accumulatePhasors(phasor_real_.data() + l * source_count_,
+                                                  phasor_imag_.data() + l * source_count_,
+                                                  weight_real, weight_imag, source_count_);
+        }
+    };
+    if (pool) {
+        pool->parallelFor(listener_count_, kPointGrain, evaluate_rows);
+    } else {
+        evaluate_rows(0, listener_count_, 0);
+    }
+}
+
+// IncrementalInterferenceMap
+IncrementalInterferenceMap::IncrementalInterferenceMap(const InterferencePointGrid& grid, ThreadPool* pool,
+                                                       size_t rebase_interval)
+    : IncrementalInterferenceMap(grid, pool, rebase_interval, getInterferenceKernels()) {
+}
+
+IncrementalInterferenceMap::IncrementalInterferenceMap(const InterferencePointGrid& grid, ThreadPool* pool,
+                                                       size_t rebase_interval,
+                                                       const InterferenceKernelTable& kernels)
+    : grid_(grid)
+    , pool_(pool)
+    , kernels_(&kernels)
+    , rebase_interval_(rebase_interval > 0 ? rebase_interval : 1)
+    , sums_(grid.size())
+    , resident_version_(0)
+    , initialized_(false)
+    , updates_since_rebase_(0)
+    , rebase_count_(0)
+    , last_changed_(0) {
+}
+
+void IncrementalInterferenceMap::update(uint64_t version, const InterferenceSources& sources) {
+    if (initialized_ && version == resident_version_) {
+        return;
+    }
+    
+    if (!initialized_ || updates_since_rebase_ + 1 >= rebase_interval_) {
+        rebase(sources);
+    } else {
+        delta_x_.clear();
+        delta_y_.clear();
+        delta_z_.clear();
+        delta_wavenumber_.clear();
+        delta_weight_real_.clear();
+        delta_weight_imag_.clear();
+        
+        size_t resident = x_.size();
+        size_t common = std::min(resident, sources.count);
+        size_t changed = 0;
+        for (size_t i = 0; i < std::max(resident, sources.count); ++i) {
+            bool had = i < resident;
+            bool has = i < sources.count;
+            if (i < common && x_[i] == sources.x[i] && y_[i] == sources.y[i] && z_[i] == sources.z[i] &&
+                wavenumber_[i] == sources.wavenumber[i] && weight_real_[i] == sources.weight_real[i] &&
+                weight_imag_[i] == sources.weight_imag[i]) {
+                continue;
+            }
+            if (had) {
+                pushDelta(x_[i], y_[i], z_[i], wavenumber_[i], -weight_real_[i], -weight_imag_[i]);
+            }
+            if (has) {
+                pushDelta(sources.x[i], sources.y[i], sources.z[i], sources.wavenumber[i],
+                          sources.weight_real[i], sources.weight_imag[i]);
+            }
+            ++changed;
+        }
+        
+        // Past this point the full sum touches fewer terms than the delta
+        if (delta_x_.size() >= sources.count) {
+            rebase(sources);
+        } else {
+            applyDelta();
+            updates_since_rebase_++;
+        }
+        last_changed_ = changed;
+    }
+    
+    x_.assign(sources.x, sources.x + sources.count);
+    y_.assign(sources.y, sources.y + sources.count);
+    z_.assign(sources.z, sources.z + sources.count);
+    wavenumber_.assign(sources.wavenumber, sources.wavenumber + sources.count);
+    weight_real_.assign(sources.weight_real, sources.weight_real + sources.count);
+    weight_imag_.assign(sources.weight_imag, sources.weight_imag + sources.count);
+    resident_version_ = version;
+    initialized_ = true;
+}
+
+void IncrementalInterferenceMap::rebase(const InterferenceSources& sources) {
+    auto evaluate_points = [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) {
+            sums_[i] = sources.count == 0 ? std::complex<double>(0.0, 0.0)
+                                          : kernels_->accumulate(sources, grid_.x()[i], grid_.y()[i], grid_.z()[i]);
+        }
+    };
+    if (pool_) {
+        pool_->parallelFor(grid_.size(), kPointGrain, evaluate_points);
+    } else {
+        evaluate_points(0, grid_.size(), 0);
+    }
+    updates_since_rebase_ = 0;
+    rebase_count_++;
+    last_changed_ = sources.count;
+}
+
+void IncrementalInterferenceMap::pushDelta(double x, double y, double z, double wavenumber,
+                                           double weight_real, double weight_imag) {
+    delta_x_.push_back(x);
+    delta_y_.push_back(y);
+    delta_z_.push_back(z);
+    delta_wavenumber_.push_back(wavenumber);
+    delta_weight_real_.push_back(weight_real);
+    delta_weight_imag_.push_back(weight_imag);
+}
+
+void IncrementalInterferenceMap::applyDelta() {
+    if (delta_x_.empty()) {
+        return;
+    }
+    InterferenceSources delta{delta_x_.data(), delta_y_.data(), delta_z_.data(), delta_wavenumber_.data(),
+                              delta_weight_real_.data(), delta_weight_imag_.data(), delta_x_.size()};
+    auto apply_points = [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) {
+            sums_[i] += kernels_->accumulate(delta, grid_.x()[i], grid_.y()[i], grid_.z()[i]);
+        }
+    };
+    if (pool_) {
+        pool_->parallelFor(grid_.size(), kPointGrain, apply_points);
+    } else {
+        apply_points(0, grid_.size(), 0);
+    }
+}
+
+// InterferenceComputeBackend
+InterferenceComputeBackend::InterferenceComputeBackend()
+    : resident_sources_(0)
+    , upload_count_(0) {
+}
+
+void InterferenceComputeBackend::ensureSources(uint64_t version, const InterferenceSources& sources) {
+    if (upload_count_ > 0 && version == resident_sources_) {
+        return;
+    }
+    uploadSources(sources);
+    resident_sources_ = version;
+    upload_count_++;
+}
+
+// CPUInterferenceBackend
+CPUInterferenceBackend::CPUInterferenceBackend(ThreadPool* pool)
+    : CPUInterferenceBackend(pool, getInterferenceKernels()) {
+}
+
+CPUInterferenceBackend::CPUInterferenceBackend(ThreadPool* pool, const InterferenceKernelTable& kernels)
+    : pool_(pool)
+    , kernels_(&kernels) {
+}
+
+const char* CPUInterferenceBackend::getName() const {
+    return kernels_->name;
+}
+
+void CPUInterferenceBackend::uploadSources(const InterferenceSources& sources) {
+    x_.assign(sources.x, sources.x + sources.count);
+    y_.assign(sources.y, sources.y + sources.count);
+    z_.assign(sources.z, sources.z + sources.count);
+    wavenumber_.assign(sources.wavenumber, sources.wavenumber + sources.count);
+    weight_real_.assign(sources.weight_real, sources.weight_real + sources.count);
+    weight_imag_.assign(sources.weight_imag, sources.weight_imag + sources.count);
+}
+
+bool CPUInterferenceBackend::evaluate(const InterferencePointGrid& grid, std::complex<double>* output) {
+    InterferenceSources sources{x_.data(), y_.data(), z_.data(), wavenumber_.data(),
+                                weight_real_.data(), weight_imag_.data(), x_.size()};
+    auto evaluate_points = [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) {
+            output[i] = sources.count == 0 ? std::complex<double>(0.0, 0.0)
+                                           : kernels_->accumulate(sources, grid.x()[i], grid.y()[i], grid.z()[i]);
+        }
+    };
+    if (pool_) {
+        pool_->parallelFor(grid.size(), kPointGrain, evaluate_points);
+    } else {
+        evaluate_points(0, grid.size(), 0);
+    }
+    return true;
+}
+
+} // namespace AnantaSound
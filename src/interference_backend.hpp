@@ -0,0 +1,204 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include "interference_kernels.hpp"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AnantaSound {
+
+class ThreadPool;
+
+// Listener points of an interference map in structure-of-arrays form.
+// Built once from spherical coordinates and reused for every tick, so a
+// backend can keep the grid resident and only the sources change.
+class InterferencePointGrid {
+private:
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> z_;
+    uint64_t version_;
+
+public:
+    InterferencePointGrid();
+    InterferencePointGrid(const SphericalCoord* positions, size_t count);
+    explicit InterferencePointGrid(const std::vector<SphericalCoord>& positions);
+
+    void assign(const SphericalCoord* positions, size_t count);
+
+    size_t size() const { return x_.size(); }
+    const double* x() const { return x_.data(); }
+    const double* y() const { return y_.data(); }
+    const double* z() const { return z_.data(); }
+
+    // Process-wide unique stamp of the current contents
+    uint64_t getVersion() const { return version_; }
+};
+
+// Source -> listener phasor matrix for a fixed speaker and seating layout.
+// Baking evaluates exp(-i · 2π f_s d_ls / c) once for every pair; each tick
+// then reduces to a complex matrix-vector product of the current source
+// weights (amplitude · quantum factor) with the matrix rows. The matrix
+// holds listeners × sources complex values (16 bytes each), so it suits
+// seating-sized grids rather than dense visualization maps. A layout stays
+// valid while the field's sources keep their positions, frequencies and
+// order; weight changes (setSourceAmplitude, state changes) do not stale it.
+class BakedInterferenceLayout {
+private:
+    size_t listener_count_;
+    size_t source_count_;
+    uint64_t geometry_version_;
+    std::vector<double> phasor_real_;           // Listener-major rows
+    std::vector<double> phasor_imag_;
+
+public:
+    BakedInterferenceLayout();
+
+    // Precompute the phasors of every source at every grid point
+    void bake(const InterferenceSources& sources, uint64_t geometry_version, const InterferencePointGrid& grid,
+              ThreadPool* pool = nullptr);
+
+    // output[l] = Σ_s weight_s · phasor_ls; output must hold getListenerCount() values
+    void evaluate(const double* weight_real, const double* weight_imag, std::complex<double>* output,
+                  const InterferenceKernelTable& kernels, ThreadPool* pool = nullptr) const;
+
+    bool isBaked() const { return geometry_version_ != 0; }
+    size_t getListenerCount() const { return listener_count_; }
+    size_t getSourceCount() const { return source_count_; }
+    uint64_t getGeometryVersion() const { return geometry_version_; }
+    size_t getMemoryBytes() const { return (phasor_real_.size() + phasor_imag_.size()) * sizeof(double); }
+};
+
+// Interference map that follows source changes incrementally.
+// Keeps the raw source sum at every grid point together with a copy of the
+// sources it was built from. Each update diffs the new sources against that
+// copy slot by slot and, for the slots that differ, subtracts the old
+// contribution and adds the new one, so the cost scales with the changed
+// sources rather than all of them. A swap-pop removal touches two slots.
+// Every rebase_interval incremental updates (or when most sources changed)
+// the sums are recomputed from scratch to bound rounding drift. Driven by
+// InterferenceField::calculateIncrementalInterference; serves one caller at
+// a time.
+class IncrementalInterferenceMap {
+public:
+    static constexpr size_t kDefaultRebaseInterval = 256;
+
+private:
+    InterferencePointGrid grid_;
+    ThreadPool* pool_;
+    const InterferenceKernelTable* kernels_;
+    size_t rebase_interval_;
+    std::vector<std::complex<double>> sums_;
+
+    // Sources the sums currently describe
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> z_;
+    std::vector<double> wavenumber_;
+    std::vector<double> weight_real_;
+    std::vector<double> weight_imag_;
+    uint64_t resident_version_;
+    bool initialized_;
+
+    // Changed contributions of one update: old ones negated, then new ones
+    std::vector<double> delta_x_;
+    std::vector<double> delta_y_;
+    std::vector<double> delta_z_;
+    std::vector<double> delta_wavenumber_;
+    std::vector<double> delta_weight_real_;
+    std::vector<double> delta_weight_imag_;
+
+    size_t updates_since_rebase_;
+    size_t rebase_count_;
+    size_t last_changed_;
+
+    void rebase(const InterferenceSources& sources);
+    void pushDelta(double x, double y, double z, double wavenumber, double weight_real, double weight_imag);
+    void applyDelta();
+
+public:
+    explicit IncrementalInterferenceMap(const InterferencePointGrid& grid, ThreadPool* pool = nullptr,
+                                        size_t rebase_interval = kDefaultRebaseInterval);
+    IncrementalInterferenceMap(const InterferencePointGrid& grid, ThreadPool* pool, size_t rebase_interval,
+                               const InterferenceKernelTable& kernels);
+
+    // Bring the sums up to date with the sources of a snapshot version;
+    // a no-op when that version is already applied
+    void update(uint64_t version, const InterferenceSources& sources);
+
+    // Drop the sums; the next update recomputes them from scratch
+    void invalidate() { initialized_ = false; }
+
+    const InterferencePointGrid& getGrid() const { return grid_; }
+    const std::complex<double>* getSums() const { return sums_.data(); }
+    size_t size() const { return sums_.size(); }
+
+    size_t getRebaseCount() const { return rebase_count_; }
+    // Source slots that differed in the last update that changed anything
+    size_t getLastChangedCount() const { return last_changed_; }
+};
+
+// Compute backend for dome-wide interference maps.
+// InterferenceField::calculateInterferenceMap hands the backend its source
+// snapshot through ensureSources, which uploads only when the snapshot
+// changed since the last upload (typically once per tick), and then asks for
+// the raw source sum at every grid point; the field applies its type factor.
+// Accelerator backends (Metal, Vulkan, CUDA) implement uploadSources and
+// evaluate against device buffers; CPUInterferenceBackend is the portable
+// implementation. A backend serves one map evaluation at a time.
+class InterferenceComputeBackend {
+private:
+    uint64_t resident_sources_;
+    size_t upload_count_;
+
+public:
+    InterferenceComputeBackend();
+    virtual ~InterferenceComputeBackend() = default;
+
+    InterferenceComputeBackend(const InterferenceComputeBackend&) = delete;
+    InterferenceComputeBackend& operator=(const InterferenceComputeBackend&) = delete;
+
+    virtual const char* getName() const = 0;
+
+    // Upload the sources unless the snapshot with this version is resident
+    void ensureSources(uint64_t version, const InterferenceSources& sources);
+
+    // Σ_s weight_s · exp(-i · wavenumber_s · |p - source_s|) for every grid
+    // point; output must hold grid.size() values. false if the backend failed.
+    virtual bool evaluate(const InterferencePointGrid& grid, std::complex<double>* output) = 0;
+
+    // Number of source uploads so far
+    size_t getUploadCount() const { return upload_count_; }
+
+protected:
+    // Copy the sources to backend memory; the pointers are not retained
+    virtual void uploadSources(const InterferenceSources& sources) = 0;
+};
+
+// Portable backend: the SIMD interference kernels over the points, split
+// across a ThreadPool when one is given
+class CPUInterferenceBackend : public InterferenceComputeBackend {
+private:
+    ThreadPool* pool_;
+    const InterferenceKernelTable* kernels_;
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> z_;
+    std::vector<double> wavenumber_;
+    std::vector<double> weight_real_;
+    std::vector<double> weight_imag_;
+
+public:
+    explicit CPUInterferenceBackend(ThreadPool* pool = nullptr);
+    CPUInterferenceBackend(ThreadPool* pool, const InterferenceKernelTable& kernels);
+
+    const char* getName() const override;
+    bool evaluate(const InterferencePointGrid& grid, std::complex<double>* output) override;
+
+protected:
+    void uploadSources(const InterferenceSources& sources) override;
+};
+
+} // namespace AnantaSound
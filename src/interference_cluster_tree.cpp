@@ -0,0 +1,228 @@
+#include "interference_cluster_tree.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace AnantaSound {
+
+InterferenceClusterTree::InterferenceClusterTree(double tolerance, double frequency_resolution)
+    : InterferenceClusterTree(tolerance, frequency_resolution, getInterferenceKernels()) {
+}
+
+InterferenceClusterTree::InterferenceClusterTree(double tolerance, double frequency_resolution,
+                                                 const InterferenceKernelTable& kernels)
+    : tolerance_(std::max(tolerance, 0.0))
+    , frequency_resolution_(std::max(frequency_resolution, 0.0))
+    , kernels_(&kernels)
+    , version_(0)
+    , magnitude_(0.0) {
+}
+
+void InterferenceClusterTree::build(uint64_t version, const InterferenceSources& sources) {
+    version_ = version;
+    nodes_.clear();
+    roots_.clear();
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    wavenumber_.clear();
+    weight_real_.clear();
+    weight_imag_.clear();
+    magnitude_ = 0.0;
+
+    std::vector<uint32_t> order(sources.count);
+    for (uint32_t i = 0; i < sources.count; ++i) {
+        order[i] = i;
+        magnitude_ += std::hypot(sources.weight_real[i], sources.weight_imag[i]);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return sources.wavenumber[a] < sources.wavenumber[b];
+    });
+
+    // Greedy bands: every wavenumber within (1 + resolution) of the band's lowest
+    uint32_t begin = 0;
+    while (begin < sources.count) {
+        double limit = sources.wavenumber[order[begin]] * (1.0 + frequency_resolution_);
+        uint32_t end = begin + 1;
+        while (end < sources.count && sources.wavenumber[order[end]] <= limit) {
+            ++end;
+        }
+        uint32_t root = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+        roots_.push_back(root);
+        buildNode(root, order, begin, end, sources, 0);
+        begin = end;
+    }
+}
+
+void InterferenceClusterTree::buildNode(uint32_t index, std::vector<uint32_t>& order, uint32_t begin,
+                                        uint32_t end, const InterferenceSources& sources, size_t depth) {
+    double low[3] = {sources.x[order[begin]], sources.y[order[begin]], sources.z[order[begin]]};
+    double high[3] = {low[0], low[1], low[2]};
+    for (uint32_t i = begin + 1; i < end; ++i) {
+        double point[3] = {sources.x[order[i]], sources.y[order[i]], sources.z[order[i]]};
+        for (int axis = 0; axis < 3; ++axis) {
+            low[axis] = std::min(low[axis], point[axis]);
+            high[axis] = std::max(high[axis], point[axis]);
+        }
+    }
+
+    uint32_t first_source = static_cast<uint32_t>(x_.size());
+    bool degenerate = low[0] == high[0] && low[1] == high[1] && low[2] == high[2];
+    if (end - begin <= kLeafSize || depth >= kMaxDepth || degenerate) {
+        for (uint32_t i = begin; i < end; ++i) {
+            uint32_t source = order[i];
+            x_.push_back(sources.x[source]);
+            y_.push_back(sources.y[source]);
+            z_.push_back(sources.z[source]);
+            wavenumber_.push_back(sources.wavenumber[source]);
+            weight_real_.push_back(sources.weight_real[source]);
+            weight_imag_.push_back(sources.weight_imag[source]);
+        }
+        nodes_[index].first_child = 0;
+        nodes_[index].child_count = 0;
+    } else {
+        // Split the range into octants of the bounding box
+        double mid[3] = {0.5 * (low[0] + high[0]), 0.5 * (low[1] + high[1]), 0.5 * (low[2] + high[2])};
+        auto octant = [&](uint32_t source) {
+            return (sources.x[source] > mid[0] ? 1 : 0) | (sources.y[source] > mid[1] ? 2 : 0) |
+                   (sources.z[source] > mid[2] ? 4 : 0);
+        };
+        std::array<uint32_t, 9> bounds{};
+        for (uint32_t i = begin; i < end; ++i) {
+            bounds[octant(order[i]) + 1]++;
+        }
+        size_t children = 0;
+        for (int o = 0; o < 8; ++o) {
+            children += bounds[o + 1] > 0 ? 1 : 0;
+            bounds[o + 1] += bounds[o];
+        }
+        std::vector<uint32_t> sorted(end - begin);
+        std::array<uint32_t, 9> cursor = bounds;
+        for (uint32_t i = begin; i < end; ++i) {
+            sorted[cursor[octant(order[i])]++] = order[i];
+        }
+        std::copy(sorted.begin(), sorted.end(), order.begin() + begin);
+
+        uint32_t first_child = static_cast<uint32_t>(nodes_.size());
+        nodes_.resize(nodes_.size() + children);
+        nodes_[index].first_child = first_child;
+        nodes_[index].child_count = static_cast<uint32_t>(children);
+        uint32_t child = first_child;
+        for (int o = 0; o < 8; ++o) {
+            if (bounds[o + 1] > bounds[o]) {
+                buildNode(child++, order, begin + bounds[o], begin + bounds[o + 1], sources, depth + 1);
+            }
+        }
+    }
+
+    Node& node = nodes_[index];
+    node.begin = first_source;
+    node.end = static_cast<uint32_t>(x_.size());
+    summarize(node);
+}
+
+void InterferenceClusterTree::summarize(Node& node) const {
+    uint32_t count = node.end - node.begin;
+    double magnitude = 0.0;
+    double weighted[3] = {0.0, 0.0, 0.0};
+    double plain[3] = {0.0, 0.0, 0.0};
+    double k_low = wavenumber_[node.begin];
+    double k_high = k_low;
+    node.weight_real = 0.0;
+    node.weight_imag = 0.0;
+    for (uint32_t i = node.begin; i < node.end; ++i) {
+        double w = std::hypot(weight_real_[i], weight_imag_[i]);
+        magnitude += w;
+        weighted[0] += w * x_[i];
+        weighted[1] += w * y_[i];
+        weighted[2] += w * z_[i];
+        plain[0] += x_[i];
+        plain[1] += y_[i];
+        plain[2] += z_[i];
+        node.weight_real += weight_real_[i];
+        node.weight_imag += weight_imag_[i];
+        k_low = std::min(k_low, wavenumber_[i]);
+        k_high = std::max(k_high, wavenumber_[i]);
+    }
+
+    // Magnitude-weighted centroid keeps the dipole term small
+    for (int axis = 0; axis < 3; ++axis) {
+        node.center[axis] = magnitude > 0.0 ? weighted[axis] / magnitude : plain[axis] / count;
+        node.dipole_real[axis] = 0.0;
+        node.dipole_imag[axis] = 0.0;
+    }
+    node.magnitude = magnitude;
+    node.wavenumber = 0.5 * (k_low + k_high);
+    node.wavenumber_spread = 0.5 * (k_high - k_low);
+
+    double radius_squared = 0.0;
+    for (uint32_t i = node.begin; i < node.end; ++i) {
+        double offset[3] = {x_[i] - node.center[0], y_[i] - node.center[1], z_[i] - node.center[2]};
+        radius_squared = std::max(radius_squared,
+                                  offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2]);
+        for (int axis = 0; axis < 3; ++axis) {
+            node.dipole_real[axis] += weight_real_[i] * offset[axis];
+            node.dipole_imag[axis] += weight_imag_[i] * offset[axis];
+        }
+    }
+    node.radius = std::sqrt(radius_squared);
+}
+
+std::complex<double> InterferenceClusterTree::evaluate(double px, double py, double pz, size_t* visited) const {
+    std::complex<double> sum(0.0, 0.0);
+    size_t touched = 0;
+    std::array<uint32_t, 8 * (kMaxDepth + 1)> stack;
+
+    for (uint32_t root : roots_) {
+        size_t top = 0;
+        stack[top++] = root;
+        while (top > 0) {
+            const Node& node = nodes_[stack[--top]];
+            ++touched;
+            double dx = px - node.center[0];
+            double dy = py - node.center[1];
+            double dz = pz - node.center[2];
+            double d = std::sqrt(dx * dx + dy * dy + dz * dz);
+            double r = node.radius;
+
+            if (d > r) {
+                double k_high = node.wavenumber + node.wavenumber_spread;
+                double error = 0.5 * (k_high * r) * (k_high * r) + k_high * r * r / (2.0 * (d - r)) +
+                               node.wavenumber_spread * (d + r);
+                if (error <= tolerance_) {
+                    // exp(-i k d) · (W + i k u·D)
+                    double k = node.wavenumber;
+                    double ux = dx / d, uy = dy / d, uz = dz / d;
+                    double dipole_real = ux * node.dipole_real[0] + uy * node.dipole_real[1] +
+                                         uz * node.dipole_real[2];
+                    double dipole_imag = ux * node.dipole_imag[0] + uy * node.dipole_imag[1] +
+                                         uz * node.dipole_imag[2];
+                    std::complex<double> moment(node.weight_real - k * dipole_imag,
+                                                node.weight_imag + k * dipole_real);
+                    sum += std::complex<double>(std::cos(k * d), -std::sin(k * d)) * moment;
+                    continue;
+                }
+            }
+
+            if (node.child_count == 0) {
+                InterferenceSources leaf{x_.data() + node.begin, y_.data() + node.begin, z_.data() + node.begin,
+                                         wavenumber_.data() + node.begin, weight_real_.data() + node.begin,
+                                         weight_imag_.data() + node.begin, node.end - node.begin};
+                sum += kernels_->accumulate(leaf, px, py, pz);
+                touched += leaf.count;
+            } else {
+                for (uint32_t c = 0; c < node.child_count; ++c) {
+                    stack[top++] = node.first_child + c;
+                }
+            }
+        }
+    }
+
+    if (visited) {
+        *visited = touched;
+    }
+    return sum;
+}
+
+} // namespace AnantaSound
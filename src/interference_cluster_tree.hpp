@@ -0,0 +1,101 @@
+#pragma once
+
+#include "interference_kernels.hpp"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AnantaSound {
+
+// Barnes-Hut style approximation of the interference sum for large scenes.
+// Sources are split into wavenumber bands (relative width frequency_resolution;
+// 0 groups equal frequencies only) and each band gets an octree over the
+// Cartesian positions. Every node keeps a first-order far-field expansion of
+// its sources about their centroid c:
+//
+//   Σ_s w_s · exp(-i k_s |p - s|)  ≈  exp(-i k |p - c|) · (W + i k · u·D)
+//
+// with W = Σ w_s, D = Σ w_s (s - c), u the unit vector from c to p and k the
+// band's mid wavenumber. A query accepts a node when the bound on the
+// expansion's error per unit source magnitude,
+//
+//   (k r)² / 2  +  k r² / (2 (d - r))  +  Δk (d + r),
+//
+// (r the node radius, d = |p - c|, Δk the half-spread of the band) is within
+// the tolerance, and otherwise opens it; leaves are summed exactly with the
+// interference kernels. The total error is therefore at most
+// tolerance · Σ_s |w_s|.
+//
+// The kernel does not attenuate with distance, so a cluster only collapses
+// once it is small against the wavelength (k r ≲ √(2 · tolerance)); query
+// cost approaches O(log N) for dense clusters of sub-wavelength sources and
+// stays O(N) for sparse ones. The tree is a snapshot of one source version.
+class InterferenceClusterTree {
+public:
+    static constexpr double kDefaultTolerance = 1e-3;
+    static constexpr size_t kLeafSize = 8;
+    static constexpr size_t kMaxDepth = 24;
+
+private:
+    struct Node {
+        double center[3];
+        double radius;
+        double wavenumber;          // Band midpoint
+        double wavenumber_spread;   // Half-width of the node's wavenumbers
+        double weight_real;         // W
+        double weight_imag;
+        double dipole_real[3];      // D
+        double dipole_imag[3];
+        double magnitude;           // Σ |w_s|
+        uint32_t begin;             // Source range in the reordered arrays
+        uint32_t end;
+        uint32_t first_child;
+        uint32_t child_count;
+    };
+
+    double tolerance_;
+    double frequency_resolution_;
+    const InterferenceKernelTable* kernels_;
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> roots_;   // One per band
+    uint64_t version_;
+    double magnitude_;
+
+    // Sources in tree order: every node covers a contiguous range
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> z_;
+    std::vector<double> wavenumber_;
+    std::vector<double> weight_real_;
+    std::vector<double> weight_imag_;
+
+    void buildNode(uint32_t index, std::vector<uint32_t>& order, uint32_t begin, uint32_t end,
+                   const InterferenceSources& sources, size_t depth);
+    void summarize(Node& node) const;
+
+public:
+    explicit InterferenceClusterTree(double tolerance = kDefaultTolerance, double frequency_resolution = 0.0);
+    InterferenceClusterTree(double tolerance, double frequency_resolution, const InterferenceKernelTable& kernels);
+
+    // Rebuild over the sources of a snapshot version
+    void build(uint64_t version, const InterferenceSources& sources);
+
+    // Approximate Σ_s w_s · exp(-i k_s |p - s|); visited (optional) receives
+    // the number of nodes and exactly summed sources the query touched
+    std::complex<double> evaluate(double px, double py, double pz, size_t* visited = nullptr) const;
+
+    // The tolerance only steers queries, so it can change without a rebuild,
+    // e.g. coarsened while a DeadlineScheduler sheds far-field detail; not
+    // concurrently with evaluate
+    void setTolerance(double tolerance) { tolerance_ = tolerance > 0.0 ? tolerance : 0.0; }
+    double getTolerance() const { return tolerance_; }
+    uint64_t getVersion() const { return version_; }
+    size_t getSourceCount() const { return x_.size(); }
+    size_t getNodeCount() const { return nodes_.size(); }
+    size_t getBandCount() const { return roots_.size(); }
+    // Σ_s |w_s|; the absolute error of evaluate is at most tolerance times this
+    double getTotalMagnitude() const { return magnitude_; }
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,363 @@
+#include "interference_kernels.hpp"
+#include "simd_sincos.hpp"
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+using namespace detail;
+
+// Contribution of sources [start, count) with the libm phasor
+std::complex<double> accumulateTail(const InterferenceSources& sources, size_t start,
+                                    double px, double py, double pz) {
+    double re = 0.0, im = 0.0;
+    for (size_t s = start; s < sources.count; ++s) {
+        double dx = px - sources.x[s];
+        double dy = py - sources.y[s];
+        double dz = pz - sources.z[s];
+        double phase = sources.wavenumber[s] * std::sqrt(dx * dx + dy * dy + dz * dz);
+        double c = std::cos(phase);
+        double sn = std::sin(phase);
+
+        // w · (cos φ - i sin φ)
+        re += sources.weight_real[s] * c + sources.weight_imag[s] * sn;
+        im += sources.weight_imag[s] * c - sources.weight_real[s] * sn;
+    }
+    return std::complex<double>(re, im);
+}
+
+// Weighted phasor sum over [start, count)
+std::complex<double> accumulatePhasorsTail(const double* pr, const double* pi, const double* wr, const double* wi,
+                                           size_t start, size_t count) {
+    double re = 0.0, im = 0.0;
+    for (size_t s = start; s < count; ++s) {
+        re += wr[s] * pr[s] - wi[s] * pi[s];
+        im += wr[s] * pi[s] + wi[s] * pr[s];
+    }
+    return std::complex<double>(re, im);
+}
+
+// Ladder sums for points [start, count) with the libm phasors
+void accumulateLaddersTail(const InterferenceLadders& ladders, const double* wr, const double* wi,
+                           const double* px, const double* py, const double* pz, size_t start, size_t count,
+                           std::complex<double>* output) {
+    for (size_t i = start; i < count; ++i) {
+        double re = 0.0, im = 0.0;
+        for (size_t l = 0; l < ladders.count; ++l) {
+            double dx = px[i] - ladders.x[l];
+            double dy = py[i] - ladders.y[l];
+            double dz = pz[i] - ladders.z[l];
+            double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+            double phase = ladders.wavenumber[l] * distance;
+            double zr = std::cos(phase), zi = -std::sin(phase);
+            double sr = 1.0, si = 0.0;
+            if (ladders.begin[l + 1] - ladders.begin[l] > 1) {
+                double step = ladders.step[l] * distance;
+                sr = std::cos(step);
+                si = -std::sin(step);
+            }
+            for (uint32_t m = ladders.begin[l]; m < ladders.begin[l + 1]; ++m) {
+                uint32_t s = ladders.members[m];
+                re += wr[s] * zr - wi[s] * zi;
+                im += wr[s] * zi + wi[s] * zr;
+                double next = zr * sr - zi * si;
+                zi = zr * si + zi * sr;
+                zr = next;
+            }
+        }
+        output[i] = std::complex<double>(re, im);
+    }
+}
+
+// ---- Scalar reference -------------------------------------------------------
+
+std::complex<double> accumulateScalar(const InterferenceSources& sources,
+                                      double px, double py, double pz) {
+    return accumulateTail(sources, 0, px, py, pz);
+}
+
+std::complex<double> accumulatePhasorsScalar(const double* pr, const double* pi, const double* wr, const double* wi,
+                                             size_t count) {
+    return accumulatePhasorsTail(pr, pi, wr, wi, 0, count);
+}
+
+void accumulateLaddersScalar(const InterferenceLadders& ladders, const double* wr, const double* wi,
+                             const double* px, const double* py, const double* pz, size_t count,
+                             std::complex<double>* output) {
+    accumulateLaddersTail(ladders, wr, wi, px, py, pz, 0, count, output);
+}
+
+#ifdef ANANTASOUND_X86_DISPATCH
+
+// ---- AVX2 -------------------------------------------------------------------
+
+__attribute__((target("avx2,fma")))
+std::complex<double> accumulateAVX2(const InterferenceSources& sources,
+                                    double px, double py, double pz) {
+    const __m256d x = _mm256_set1_pd(px);
+    const __m256d y = _mm256_set1_pd(py);
+    const __m256d z = _mm256_set1_pd(pz);
+    __m256d re = _mm256_setzero_pd();
+    __m256d im = _mm256_setzero_pd();
+
+    size_t s = 0;
+    for (; s + 4 <= sources.count; s += 4) {
+        __m256d dx = _mm256_sub_pd(x, _mm256_loadu_pd(sources.x + s));
+        __m256d dy = _mm256_sub_pd(y, _mm256_loadu_pd(sources.y + s));
+        __m256d dz = _mm256_sub_pd(z, _mm256_loadu_pd(sources.z + s));
+        __m256d distance = _mm256_sqrt_pd(_mm256_fmadd_pd(dx, dx, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dz, dz))));
+        __m256d phase = _mm256_mul_pd(_mm256_loadu_pd(sources.wavenumber + s), distance);
+
+        __m256d sn, c;
+        sincosAVX2(phase, sn, c);
+
+        __m256d wr = _mm256_loadu_pd(sources.weight_real + s);
+        __m256d wi = _mm256_loadu_pd(sources.weight_imag + s);
+        re = _mm256_fmadd_pd(wr, c, _mm256_fmadd_pd(wi, sn, re));
+        im = _mm256_fmadd_pd(wi, c, _mm256_fnmadd_pd(wr, sn, im));
+    }
+
+    alignas(32) double lane_re[4], lane_im[4];
+    _mm256_store_pd(lane_re, re);
+    _mm256_store_pd(lane_im, im);
+    std::complex<double> total(lane_re[0] + lane_re[1] + lane_re[2] + lane_re[3],
+                               lane_im[0] + lane_im[1] + lane_im[2] + lane_im[3]);
+    return total + accumulateTail(sources, s, px, py, pz);
+}
+
+__attribute__((target("avx2,fma")))
+std::complex<double> accumulatePhasorsAVX2(const double* pr, const double* pi, const double* wr, const double* wi,
+                                           size_t count) {
+    __m256d re = _mm256_setzero_pd();
+    __m256d im = _mm256_setzero_pd();
+
+    size_t s = 0;
+    for (; s + 4 <= count; s += 4) {
+        __m256d p_re = _mm256_loadu_pd(pr + s);
+        __m256d p_im = _mm256_loadu_pd(pi + s);
+        __m256d w_re = _mm256_loadu_pd(wr + s);
+        __m256d w_im = _mm256_loadu_pd(wi + s);
+        re = _mm256_fmadd_pd(w_re, p_re, _mm256_fnmadd_pd(w_im, p_im, re));
+        im = _mm256_fmadd_pd(w_re, p_im, _mm256_fmadd_pd(w_im, p_re, im));
+    }
+
+    alignas(32) double lane_re[4], lane_im[4];
+    _mm256_store_pd(lane_re, re);
+    _mm256_store_pd(lane_im, im);
+    std::complex<double> total(lane_re[0] + lane_re[1] + lane_re[2] + lane_re[3],
+                               lane_im[0] + lane_im[1] + lane_im[2] + lane_im[3]);
+    return total + accumulatePhasorsTail(pr, pi, wr, wi, s, count);
+}
+
+__attribute__((target("avx2,fma")))
+void accumulateLaddersAVX2(const InterferenceLadders& ladders, const double* wr, const double* wi,
+                           const double* px, const double* py, const double* pz, size_t count,
+                           std::complex<double>* output) {
+    const __m256d zero = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d x = _mm256_loadu_pd(px + i);
+        const __m256d y = _mm256_loadu_pd(py + i);
+        const __m256d z = _mm256_loadu_pd(pz + i);
+        __m256d re = zero;
+        __m256d im = zero;
+
+        for (size_t l = 0; l < ladders.count; ++l) {
+            __m256d dx = _mm256_sub_pd(x, _mm256_set1_pd(ladders.x[l]));
+            __m256d dy = _mm256_sub_pd(y, _mm256_set1_pd(ladders.y[l]));
+            __m256d dz = _mm256_sub_pd(z, _mm256_set1_pd(ladders.z[l]));
+            __m256d distance = _mm256_sqrt_pd(_mm256_fmadd_pd(dx, dx, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dz, dz))));
+
+            // exp(-i φ) = cos φ - i sin φ
+            __m256d sn, c;
+            sincosAVX2(_mm256_mul_pd(_mm256_set1_pd(ladders.wavenumber[l]), distance), sn, c);
+            __m256d zr = c, zi = _mm256_sub_pd(zero, sn);
+            __m256d sr = _mm256_set1_pd(1.0), si = zero;
+            if (ladders.begin[l + 1] - ladders.begin[l] > 1) {
+                sincosAVX2(_mm256_mul_pd(_mm256_set1_pd(ladders.step[l]), distance), sn, c);
+                sr = c;
+                si = _mm256_sub_pd(zero, sn);
+            }
+
+            for (uint32_t m = ladders.begin[l]; m < ladders.begin[l + 1]; ++m) {
+                uint32_t s = ladders.members[m];
+                __m256d w_re = _mm256_set1_pd(wr[s]);
+                __m256d w_im = _mm256_set1_pd(wi[s]);
+                re = _mm256_fmadd_pd(w_re, zr, _mm256_fnmadd_pd(w_im, zi, re));
+                im = _mm256_fmadd_pd(w_re, zi, _mm256_fmadd_pd(w_im, zr, im));
+                __m256d next = _mm256_fmsub_pd(zr, sr, _mm256_mul_pd(zi, si));
+                zi = _mm256_fmadd_pd(zr, si, _mm256_mul_pd(zi, sr));
+                zr = next;
+            }
+        }
+
+        alignas(32) double lane_re[4], lane_im[4];
+        _mm256_store_pd(lane_re, re);
+        _mm256_store_pd(lane_im, im);
+        for (size_t j = 0; j < 4; ++j) {
+            output[i + j] = std::complex<double>(lane_re[j], lane_im[j]);
+        }
+    }
+    accumulateLaddersTail(ladders, wr, wi, px, py, pz, i, count, output);
+}
+
+// ---- AVX-512 ----------------------------------------------------------------
+
+ANANTASOUND_AVX512_DIAGNOSTICS_PUSH
+
+__attribute__((target("avx512f")))
+std::complex<double> accumulateAVX512(const InterferenceSources& sources,
+                                      double px, double py, double pz) {
+    const __m512d x = _mm512_set1_pd(px);
+    const __m512d y = _mm512_set1_pd(py);
+    const __m512d z = _mm512_set1_pd(pz);
+    __m512d re = _mm512_setzero_pd();
+    __m512d im = _mm512_setzero_pd();
+
+    size_t s = 0;
+    for (; s + 8 <= sources.count; s += 8) {
+        __m512d dx = _mm512_sub_pd(x, _mm512_loadu_pd(sources.x + s));
+        __m512d dy = _mm512_sub_pd(y, _mm512_loadu_pd(sources.y + s));
+        __m512d dz = _mm512_sub_pd(z, _mm512_loadu_pd(sources.z + s));
+        __m512d distance = _mm512_sqrt_pd(_mm512_fmadd_pd(dx, dx, _mm512_fmadd_pd(dy, dy, _mm512_mul_pd(dz, dz))));
+        __m512d phase = _mm512_mul_pd(_mm512_loadu_pd(sources.wavenumber + s), distance);
+
+        __m512d sn, c;
+        sincosAVX512(phase, sn, c);
+
+        __m512d wr = _mm512_loadu_pd(sources.weight_real + s);
+        __m512d wi = _mm512_loadu_pd(sources.weight_imag + s);
+        re = _mm512_fmadd_pd(wr, c, _mm512_fmadd_pd(wi, sn, re));
+        im = _mm512_fmadd_pd(wi, c, _mm512_fnmadd_pd(wr, sn, im));
+    }
+
+    std::complex<double> total(_mm512_reduce_add_pd(re), _mm512_reduce_add_pd(im));
+    return total + accumulateTail(sources, s, px, py, pz);
+}
+
+__attribute__((target("avx512f")))
+std::complex<double> accumulatePhasorsAVX512(const double* pr, const double* pi, const double* wr, const double* wi,
+                                             size_t count) {
+    __m512d re = _mm512_setzero_pd();
+    __m512d im = _mm512_setzero_pd();
+
+    size_t s = 0;
+    for (; s + 8 <= count; s += 8) {
+        __m512d p_re = _mm512_loadu_pd(pr + s);
+        __m512d p_im = _mm512_loadu_pd(pi + s);
+        __m512d w_re = _mm512_loadu_pd(wr + s);
+        __m512d w_im = _mm512_loadu_pd(wi + s);
+        re = _mm512_fmadd_pd(w_re, p_re, _mm512_fnmadd_pd(w_im, p_im, re));
+        im = _mm512_fmadd_pd(w_re, p_im, _mm512_fmadd_pd(w_im, p_re, im));
+    }
+
+    std::complex<double> total(_mm512_reduce_add_pd(re), _mm512_reduce_add_pd(im));
+    return total + accumulatePhasorsTail(pr, pi, wr, wi, s, count);
+}
+
+__attribute__((target("avx512f")))
+void accumulateLaddersAVX512(const InterferenceLadders& ladders, const double* wr, const double* wi,
+                             const double* px, const double* py, const double* pz, size_t count,
+                             std::complex<double>* output) {
+    const __m512d zero = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512d x = _mm512_loadu_pd(px + i);
+        const __m512d y = _mm512_loadu_pd(py + i);
+        const __m512d z = _mm512_loadu_pd(pz + i);
+        __m512d re = zero;
+        __m512d im = zero;
+
+        for (size_t l = 0; l < ladders.count; ++l) {
+            __m512d dx = _mm512_sub_pd(x, _mm512_set1_pd(ladders.x[l]));
+            __m512d dy = _mm512_sub_pd(y, _mm512_set1_pd(ladders.y[l]));
+            __m512d dz = _mm512_sub_pd(z, _mm512_set1_pd(ladders.z[l]));
+            __m512d distance = _mm512_sqrt_pd(_mm512_fmadd_pd(dx, dx, _mm512_fmadd_pd(dy, dy, _mm512_mul_pd(dz, dz))));
+
+            __m512d sn, c;
+            sincosAVX512(_mm512_mul_pd(_mm512_set1_pd(ladders.wavenumber[l]), distance), sn, c);
+            __m512d zr = c, zi = _mm512_sub_pd(zero, sn);
+            __m512d sr = _mm512_set1_pd(1.0), si = zero;
+            if (ladders.begin[l + 1] - ladders.begin[l] > 1) {
+                sincosAVX512(_mm512_mul_pd(_mm512_set1_pd(ladders.step[l]), distance), sn, c);
+                sr = c;
+                si = _mm512_sub_pd(zero, sn);
+            }
+
+            for (uint32_t m = ladders.begin[l]; m < ladders.begin[l + 1]; ++m) {
+                uint32_t s = ladders.members[m];
+                __m512d w_re = _mm512_set1_pd(wr[s]);
+                __m512d w_im = _mm512_set1_pd(wi[s]);
+                re = _mm512_fmadd_pd(w_re, zr, _mm512_fnmadd_pd(w_im, zi, re));
+                im = _mm512_fmadd_pd(w_re, zi, _mm512_fmadd_pd(w_im, zr, im));
+                __m512d next = _mm512_fmsub_pd(zr, sr, _mm512_mul_pd(zi, si));
+                zi = _mm512_fmadd_pd(zr, si, _mm512_mul_pd(zi, sr));
+                zr = next;
+            }
+        }
+
+        alignas(64) double lane_re[8], lane_im[8];
+        _mm512_store_pd(lane_re, re);
+        _mm512_store_pd(lane_im, im);
+        for (size_t j = 0; j < 8; ++j) {
+            output[i + j] = std::complex<double>(lane_re[j], lane_im[j]);
+        }
+    }
+    accumulateLaddersTail(ladders, wr, wi, px, py, pz, i, count, output);
+}
+
+ANANTASOUND_AVX512_DIAGNOSTICS_POP
+
+#endif // ANANTASOUND_X86_DISPATCH
+
+const InterferenceKernelTable kScalarKernels = {
+    SIMDLevel::SCALAR, "scalar", accumulateScalar, accumulatePhasorsScalar, accumulateLaddersScalar
+};
+
+#ifdef ANANTASOUND_X86_DISPATCH
+const InterferenceKernelTable kAVX2Kernels = {
+    SIMDLevel::AVX2, "avx2", accumulateAVX2, accumulatePhasorsAVX2, accumulateLaddersAVX2
+};
+
+const InterferenceKernelTable kAVX512Kernels = {
+    SIMDLevel::AVX512, "avx512", accumulateAVX512, accumulatePhasorsAVX512, accumulateLaddersAVX512
+};
+#endif
+
+// Tables compiled into this build, indexed by SIMDLevel; NEON uses the scalar path
+const InterferenceKernelTable* const kTables[4] = {
+    &kScalarKernels,
+#ifdef ANANTASOUND_X86_DISPATCH
+    &kAVX2Kernels, &kAVX512Kernels,
+#else
+    nullptr, nullptr,
+#endif
+    nullptr
+};
+
+const InterferenceKernelTable& selectBestKernels() {
+    for (SIMDLevel level : {SIMDLevel::AVX512, SIMDLevel::AVX2}) {
+        if (isSIMDLevelSupported(level) && kTables[static_cast<size_t>(level)]) {
+            return *kTables[static_cast<size_t>(level)];
+        }
+    }
+    return kScalarKernels;
+}
+
+} // namespace
+
+const InterferenceKernelTable& getInterferenceKernels(SIMDLevel level) {
+    const InterferenceKernelTable* table = nullptr;
+    if (isSIMDLevelSupported(level)) {
+        table = kTables[static_cast<size_t>(level)];
+    }
+    return table ? *table : kScalarKernels;
+}
+
+const InterferenceKernelTable& getInterferenceKernels() {
+    static const InterferenceKernelTable& best = selectBestKernels();
+    return best;
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "spectral_kernels.hpp"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+namespace AnantaSound {
+
+// Structure-of-arrays view of the sources of one interference field.
+// weight = amplitude * quantum factor; wavenumber = 2π f / c.
+struct InterferenceSources {
+    const double* x;
+    const double* y;
+    const double* z;
+    const double* wavenumber;
+    const double* weight_real;
+    const double* weight_imag;
+    size_t count;
+};
+
+// Sources grouped into frequency ladders: co-located sources whose
+// wavenumbers form an arithmetic progression k0, k0 + Δk, k0 + 2Δk, ...
+// (a harmonic series, evenly spaced device tones); a lone source is a ladder
+// of one. Members refer to sources by index, so weights are read from the
+// source arrays and weight changes leave the grouping valid.
+struct InterferenceLadders {
+    const double* x;
+    const double* y;
+    const double* z;
+    const double* wavenumber;   // k0 of each ladder
+    const double* step;         // Δk of each ladder
+    const uint32_t* begin;      // count + 1 offsets into members
+    const uint32_t* members;    // Source indices in ladder order
+    size_t count;
+};
+
+// Dispatch table of interference kernels for one instruction set
+struct InterferenceKernelTable {
+    SIMDLevel level;
+    const char* name;
+
+    // Σ_s weight_s · exp(-i · wavenumber_s · |p - source_s|) at the point p.
+    // Vector kernels evaluate the phasor with a polynomial sincos
+    // (Cody-Waite reduction), accurate to a few ulp for phases up to ~1e5 rad.
+    std::complex<double> (*accumulate)(const InterferenceSources& sources,
+                                       double px, double py, double pz);
+
+    // Σ_s weight_s · phasor_s over precomputed phasors (one row of a baked
+    // source -> listener matrix)
+    std::complex<double> (*accumulatePhasors)(const double* phasor_real, const double* phasor_imag,
+                                              const double* weight_real, const double* weight_imag,
+                                              size_t count);
+
+    // output[i] = Σ_s weight_s · exp(-i · wavenumber_s · |p_i - source_s|) for
+    // count points, vectorized across points: per ladder and point one sincos
+    // for the base phasor and one for the step, then a complex rotation per
+    // member instead of a sincos
+    void (*accumulateLadders)(const InterferenceLadders& ladders, const double* weight_real,
+                              const double* weight_imag, const double* px, const double* py, const double* pz,
+                              size_t count, std::complex<double>* output);
+};
+
+// Best kernel table for the running CPU (detected once, thread-safe)
+const InterferenceKernelTable& getInterferenceKernels();
+
+// Kernel table for a specific level; falls back to SCALAR when unsupported
+const InterferenceKernelTable& getInterferenceKernels(SIMDLevel level);
+
+} // namespace AnantaSound
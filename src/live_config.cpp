@@ -0,0 +1,301 @@
+#include "live_config.hpp"
+#include "instrumentation.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace AnantaSound {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+std::string trim(const std::string& text) {
+    size_t begin = 0, end = text.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) ++begin;
+    while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) --end;
+    return text.substr(begin, end - begin);
+}
+
+std::string lower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+bool parseNumber(const std::string& text, double& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    double parsed = std::strtod(text.c_str(), &end);
+    if (end != text.c_str() + text.size()) return false;
+    value = parsed;
+    return true;
+}
+
+bool parseFlag(const std::string& text, bool& value) {
+    std::string word = lower(text);
+    if (word == "true" || word == "on" || word == "yes" || word == "1") {
+        value = true;
+        return true;
+    }
+    if (word == "false" || word == "off" || word == "no" || word == "0") {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+// Preset section suffixes, indexed by EmotionalState
+const char* const kPresetNames[kEmotionalStateCount] = {
+    "calm", "excited", "stressed", "focused", "relaxed", "unknown"
+};
+
+struct NumberKey {
+    const char* name;
+    double* value;
+};
+
+bool assignNumber(std::initializer_list<NumberKey> keys, const std::string& key,
+                  const std::string& text, bool& known) {
+    for (const NumberKey& entry : keys) {
+        if (key == entry.name) {
+            known = true;
+            return parseNumber(text, *entry.value);
+        }
+    }
+    known = false;
+    return false;
+}
+
+bool fileStamp(const std::string& path, fs::file_time_type& time, uintmax_t& size) {
+    std::error_code error;
+    time = fs::last_write_time(path, error);
+    if (error) return false;
+    size = fs::file_size(path, error);
+    return !error;
+}
+
+} // namespace
+
+bool parseLiveConfig(const std::string& text, LiveConfig& config, std::string* error) {
+    LiveConfig parsed;
+    std::istringstream stream(text);
+    std::string line, section;
+    size_t line_number = 0;
+
+    auto fail = [&](const std::string& message) {
+        if (error) *error = "line " + std::to_string(line_number) + ": " + message;
+        return false;
+    };
+
+    while (std::getline(stream, line)) {
+        ++line_number;
+        size_t comment = line.find_first_of("#;");
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        if (line.front() == '[') {
+            if (line.back() != ']') return fail("unterminated section header");
+            section = lower(trim(line.substr(1, line.size() - 2)));
+            bool known = section == "adaptive" || section == "breathing" || section == "feedback";
+            for (const char* name : kPresetNames) {
+                known = known || section == std::string("preset.") + name;
+            }
+            if (!known) return fail("unknown section [" + section + "]");
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) return fail("expected key = value");
+        std::string key = lower(trim(line.substr(0, equals)));
+        std::string value = trim(line.substr(equals + 1));
+        if (section.empty()) return fail("key '" + key + "' outside a section");
+
+        bool known = false, ok = false;
+        if (section == "adaptive") {
+            ok = assignNumber({{"sensitivity", &parsed.adaptive.adaptation_sensitivity}}, key, value, known);
+        } else if (section == "breathing") {
+            BreathingThresholds& b = parsed.breathing;
+            ok = assignNumber({{"rate_min", &b.normal_rate_min}, {"rate_max", &b.normal_rate_max},
+                               {"deep", &b.deep_depth}, {"shallow", &b.shallow_depth},
+                               {"rapid", &b.rapid_rate}, {"irregularity", &b.irregularity}},
+                              key, value, known);
+        } else if (section == "feedback") {
+            FeedbackSettings& f = parsed.feedback;
+            if (key == "enabled" || key == "quantum_mode") {
+                known = true;
+                ok = parseFlag(value, key == "enabled" ? f.feedback_enabled : f.quantum_mode);
+            } else {
+                ok = assignNumber({{"gain", &f.feedback_gain}, {"quantum_threshold", &f.quantum_threshold}},
+                                  key, value, known);
+            }
+        } else {
+            size_t index = 0;
+            while (section != std::string("preset.") + kPresetNames[index]) ++index;
+            AdaptationParameters& p = parsed.adaptive.presets[index];
+            ok = assignNumber({{"volume", &p.volume_multiplier}, {"tempo", &p.tempo_multiplier},
+                               {"bass", &p.bass_boost}, {"treble", &p.treble_boost},
+                               {"reverb", &p.reverb_amount}, {"echo", &p.echo_delay}},
+                              key, value, known);
+        }
+        if (!known) return fail("unknown key '" + key + "' in [" + section + "]");
+        if (!ok) return fail("bad value '" + value + "' for " + key);
+    }
+
+    parsed.version = config.version;
+    config = parsed;
+    return true;
+}
+
+LiveConfigStore::LiveConfigStore()
+    : current_(std::make_shared<const LiveConfig>()), next_version_(0), file_seen_(false),
+      file_size_(0), stop_watching_(false) {
+}
+
+LiveConfigStore::~LiveConfigStore() {
+    stopWatching();
+}
+
+std::shared_ptr<const LiveConfig> LiveConfigStore::current() const {
+    return std::atomic_load(&current_);
+}
+
+uint64_t LiveConfigStore::publish(const LiveConfig& config) {
+    ANANTASOUND_LOCK_GUARD(lock, publish_mutex_, "LiveConfigStore::publish_mutex_");
+    return publishLocked(config);
+}
+
+uint64_t LiveConfigStore::publishLocked(const LiveConfig& config) {
+    auto snapshot = std::make_shared<LiveConfig>(config);
+    snapshot->version = ++next_version_;
+    std::atomic_store(&current_, std::shared_ptr<const LiveConfig>(snapshot));
+
+    // Targets only take their control locks, never a processing lock
+    for (AdaptiveAudioProcessor* processor : adaptive_targets_) {
+        processor->applySettings(snapshot->adaptive);
+    }
+    for (BreathingAnalyzer* analyzer : breathing_targets_) {
+        analyzer->setThresholds(snapshot->breathing);
+    }
+    for (QuantumFeedbackSystem* feedback : feedback_targets_) {
+        feedback->applySettings(snapshot->feedback);
+    }
+    return snapshot->version;
+}
+
+bool LiveConfigStore::loadFile(const std::string& path) {
+    ANANTASOUND_LOCK_GUARD(lock, publish_mutex_, "LiveConfigStore::publish_mutex_");
+    path_ = path;
+    return loadLocked(path);
+}
+
+bool LiveConfigStore::loadLocked(const std::string& path) {
+    // Stamp before reading: a write racing the read shows up on the next poll
+    file_seen_ = fileStamp(path, file_time_, file_size_);
+
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Error: Cannot open live config: " << path << std::endl;
+        return false;
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+
+    LiveConfig config;
+    std::string error;
+    if (!parseLiveConfig(text.str(), config, &error)) {
+        std::cerr << "Error: Live config " << path << " rejected (" << error
+                  << "); keeping version " << current()->version << std::endl;
+        return false;
+    }
+    publishLocked(config);
+    return true;
+}
+
+bool LiveConfigStore::poll() {
+    ANANTASOUND_LOCK_GUARD(lock, publish_mutex_, "LiveConfigStore::publish_mutex_");
+    if (path_.empty()) return false;
+
+    fs::file_time_type time;
+    uintmax_t size = 0;
+    if (!fileStamp(path_, time, size)) {
+        file_seen_ = false;                 // Reload once the file reappears
+        return false;
+    }
+    if (file_seen_ && time == file_time_ && size == file_size_) return false;
+    return loadLocked(path_);
+}
+
+void LiveConfigStore::startWatching(std::chrono::milliseconds interval) {
+    stopWatching();
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        stop_watching_ = false;
+    }
+    watcher_ = std::thread([this, interval]() {
+        std::unique_lock<std::mutex> lock(watch_mutex_);
+        while (!watch_condition_.wait_for(lock, interval, [this]() { return stop_watching_; })) {
+            lock.unlock();
+            poll();
+            lock.lock();
+        }
+    });
+}
+
+void LiveConfigStore::stopWatching() {
+    if (!watcher_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        stop_watching_ = true;
+    }
+    watch_condition_.notify_all();
+    watcher_.join();
+}
+
+void LiveConfigStore::attach(AdaptiveAudioProcessor& processor) {
+    ANANTASOUND_LOCK_GUARD(lock, publish_mutex_, "LiveConfigStore::publish_mutex_");
+    if (std::find(adaptive_targets_.begin(), adaptive_targets_.end(), &processor) == adaptive_targets_.end()) {
+        adaptive_targets_.push_back(&processor);
+    }
+    processor.applySettings(current()->adaptive);
+}
+
+void LiveConfigStore::attach(BreathingAnalyzer& analyzer) {
+    ANANTASOUND_LOCK_GUARD(lock, publish_mutex_, "LiveConfigStore::publish_mutex_");
+    if (std::find(breathing_targets_.begin(), breathing_targets_.end(), &analyzer) == breathing_targets_.end()) {
+        breathing_targets_.push_back(&analyzer);
+    }
+    analyzer.setThresholds(current()->breathing);
+}
+
+void LiveConfigStore::attach(QuantumFeedbackSystem& feedback) {
+    ANANTASOUND_LOCK_GUARD(lock, publish_mutex_, "LiveConfigStore::publish_mutex_");
+    if (std::find(feedback_targets_.begin(), feedback_targets_.end(), &feedback) == feedback_targets_.end()) {
+        feedback_targets_.push_back(&feedback);
+    }
+    feedback.applySettings(current()->feedback);
+}
+
+void LiveConfigStore::detach(AdaptiveAudioProcessor& processor) {
+    ANANTASOUND_LOCK_GUARD(lock, publish_mutex_, "LiveConfigStore::publish_mutex_");
+    adaptive_targets_.erase(std::remove(adaptive_targets_.begin(), adaptive_targets_.end(), &processor),
+                            adaptive_targets_.end());
+}
+
+void LiveConfigStore::detach(BreathingAnalyzer& analyzer) {
+    ANANTASOUND_LOCK_GUARD(lock, publish_mutex_, "LiveConfigStore::publish_mutex_");
+    breathing_targets_.erase(std::remove(breathing_targets_.begin(), breathing_targets_.end(), &analyzer),
+                             breathing_targets_.end());
+}
+
+void LiveConfigStore::detach(QuantumFeedbackSystem& feedback) {
+    ANANTASOUND_LOCK_GUARD(lock, publish_mutex_, "LiveConfigStore::publish_mutex_");
+    feedback_targets_.erase(std::remove(feedback_targets_.begin(), feedback_targets_.end(), &feedback),
+                            feedback_targets_.end());
+}
+
+} // namespace AnantaSound
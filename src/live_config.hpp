@@ -0,0 +1,112 @@
+#pragma once
+
+#include "adaptive_audio_processor.hpp"
+#include "breathing_analyzer.hpp"
+#include "quantum_feedback_system.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AnantaSound {
+
+// One immutable, versioned snapshot of every live-tunable setting. Readers
+// hold a shared_ptr to it; a reload builds a new object and swaps the
+// pointer, so a snapshot never changes under a reader.
+struct LiveConfig {
+    uint64_t version = 0;           // 0 = library defaults, then +1 per publish
+    AdaptiveSettings adaptive;
+    BreathingThresholds breathing;
+    FeedbackSettings feedback;
+};
+
+// Parse an INI-style config. Missing keys keep library defaults; '#' and
+// ';' start comments. Sections and keys:
+//
+//   [adaptive]        sensitivity
+//   [preset.<state>]  volume tempo bass treble reverb echo
+//                     (<state>: calm excited stressed focused relaxed unknown)
+//   [breathing]       rate_min rate_max deep shallow rapid irregularity
+//   [feedback]        gain quantum_threshold enabled quantum_mode
+//
+// Returns false and fills error (with the line number) on an unknown
+// section or key or an unparsable value; config is left untouched then.
+bool parseLiveConfig(const std::string& text, LiveConfig& config, std::string* error = nullptr);
+
+// Holder of the current LiveConfig. publish() and loadFile() swap the
+// snapshot atomically and push it to attached processors, whose setters
+// only take their own control locks; processing picks the values up at
+// its next block boundary without waiting. A file that fails to parse is
+// reported and the previous config stays live. Editors that save in place
+// can expose a half-written file to a poll; writing a temporary file and
+// renaming it over the config avoids that.
+//
+// Attached targets must outlive the store or be detached first.
+class LiveConfigStore {
+private:
+    std::shared_ptr<const LiveConfig> current_;         // std::atomic_load / atomic_store
+
+    // Publishing, targets and the watched file
+    mutable std::mutex publish_mutex_;
+    uint64_t next_version_;
+    std::vector<AdaptiveAudioProcessor*> adaptive_targets_;
+    std::vector<BreathingAnalyzer*> breathing_targets_;
+    std::vector<QuantumFeedbackSystem*> feedback_targets_;
+    std::string path_;
+    bool file_seen_;
+    std::filesystem::file_time_type file_time_;
+    uintmax_t file_size_;
+
+    // Watcher thread
+    std::mutex watch_mutex_;
+    std::condition_variable watch_condition_;
+    std::thread watcher_;
+    bool stop_watching_;
+
+public:
+    LiveConfigStore();
+    ~LiveConfigStore();
+
+    LiveConfigStore(const LiveConfigStore&) = delete;
+    LiveConfigStore& operator=(const LiveConfigStore&) = delete;
+
+    // Current snapshot (never null; lock-free)
+    std::shared_ptr<const LiveConfig> current() const;
+    uint64_t getVersion() const { return current()->version; }
+
+    // Publish a new snapshot; its version is assigned here. Returns it.
+    uint64_t publish(const LiveConfig& config);
+
+    // Parse path and publish it; remembers path for poll()
+    bool loadFile(const std::string& path);
+
+    // Reload the remembered file if its modification time or size changed;
+    // true if a new config was published
+    bool poll();
+
+    // Poll on a background thread every interval until stopWatching()
+    void startWatching(std::chrono::milliseconds interval = std::chrono::milliseconds(250));
+    void stopWatching();
+    bool isWatching() const { return watcher_.joinable(); }
+
+    // Targets receive the current snapshot immediately and every later one
+    void attach(AdaptiveAudioProcessor& processor);
+    void attach(BreathingAnalyzer& analyzer);
+    void attach(QuantumFeedbackSystem& feedback);
+    void detach(AdaptiveAudioProcessor& processor);
+    void detach(BreathingAnalyzer& analyzer);
+    void detach(QuantumFeedbackSystem& feedback);
+
+private:
+    // Swap in config and push it to targets (under publish_mutex_)
+    uint64_t publishLocked(const LiveConfig& config);
+    bool loadLocked(const std::string& path);
+};
+
+} // namespace AnantaSound
@@ -1,13 +1,38 @@
 #include "mechanical_devices.hpp"
+#include "instrumentation.hpp"
+#include "thread_pool.hpp"
+#include "harmonic_bank.hpp"
 #include <cmath>
 #include <random>
 #include <algorithm>
 
 namespace AnantaSound {
 
+namespace {
+
+// Chakra frequencies of the mercy fields, Hz
+constexpr size_t kChakraCount = 7;
+constexpr double kChakraFrequencies[kChakraCount] = {396, 417, 528, 639, 741, 852, 963};
+
+// Harmonics emitted by a resonance device
+constexpr size_t kHarmonicCount = 8;
+
+// Dirty devices rebuilt per parallel chunk
+constexpr size_t kRefreshGrain = 16;
+
+constexpr double kTwoPi = 2.0 * M_PI;
+
+// Phase advance 2π·f·t of a field locked to the sample clock, wrapped to [-π, π]
+double clockPhase(double frequency, const ClockTick& tick) {
+    return std::remainder(kTwoPi * frequency * tick.seconds, kTwoPi);
+}
+
+} // namespace
+
 // MechanicalDevice implementation
 MechanicalDevice::MechanicalDevice(DeviceType type, const SphericalCoord& position)
-    : device_type_(type), position_(position), is_active_(true), vibration_enabled_(true) {
+    : device_type_(type), position_(position), is_active_(true), vibration_enabled_(true),
+      fields_dirty_(true), clock_tick_(SampleClock::shared().current()) {
 }
 
 DeviceType MechanicalDevice::getDeviceType() const {
@@ -20,6 +45,7 @@ const SphericalCoord& MechanicalDevice::getPosition() const {
 
 void MechanicalDevice::setPosition(const SphericalCoord& position) {
     position_ = position;
+    markFieldsDirty();
 }
 
 bool MechanicalDevice::isActive() const {
@@ -28,6 +54,7 @@ bool MechanicalDevice::isActive() const {
 
 void MechanicalDevice::setActive(bool active) {
     is_active_ = active;
+    markFieldsDirty();
 }
 
 bool MechanicalDevice::isVibrationEnabled() const {
@@ -38,6 +65,36 @@ void MechanicalDevice::setVibrationEnabled(bool enabled) {
     vibration_enabled_ = enabled;
 }
 
+void MechanicalDevice::refreshFields() const {
+    if (!fields_dirty_) {
+        return;
+    }
+    cached_fields_.resize(getFieldCount());
+    cached_fields_.resize(writeFields(cached_fields_.data()));
+    fields_dirty_ = false;
+}
+
+const std::vector<QuantumSoundField>& MechanicalDevice::getCachedFields() const {
+    refreshFields();
+    return cached_fields_;
+}
+
+FieldVector MechanicalDevice::copyCachedFields(FieldArena& arena) const {
+    const std::vector<QuantumSoundField>& fields = getCachedFields();
+    return FieldVector(fields.begin(), fields.end(), &arena);
+}
+
+void MechanicalDevice::alignToClock(const ClockTick& tick) {
+    if (!fields_dirty_) {
+        // Shift the cached phases from the old tick to the new one
+        for (auto& field : cached_fields_) {
+            field.phase += clockPhase(field.frequency, tick) - clockPhase(field.frequency, clock_tick_);
+            field.timestamp = tick.timestamp;
+        }
+    }
+    clock_tick_ = tick;
+}
+
 // KarmicCluster implementation
 KarmicCluster::KarmicCluster(const SphericalCoord& position, size_t cluster_size)
     : MechanicalDevice(DeviceType::KARMIC_CLUSTER, position), cluster_size_(cluster_size),
@@ -66,6 +123,7 @@ double KarmicCluster::getKarmicResonance() const {
 
 void KarmicCluster::setKarmicResonance(double resonance) {
     karmic_resonance_ = std::clamp(resonance, 0.0, 10.0);
+    markFieldsDirty();
 }
 
 bool KarmicCluster::isHealingEnabled() const {
@@ -74,50 +132,68 @@ bool KarmicCluster::isHealingEnabled() const {
 
 void KarmicCluster::setHealingEnabled(bool enabled) {
     healing_enabled_ = enabled;
+    markFieldsDirty();
 }
 
 std::vector<QuantumSoundField> KarmicCluster::generateKarmicFields() const {
+    return getCachedFields();
+}
+
+FieldVector KarmicCluster::generateKarmicFields(FieldArena& arena) const {
+    return copyCachedFields(arena);
+}
+
+size_t KarmicCluster::getFieldCount() const {
     if (!isActive() || !healing_enabled_) {
-        return {};
+        return 0;
+    }
+    return static_cast<size_t>(std::count_if(cluster_elements_.begin(), cluster_elements_.end(),
+                                             [](const ClusterElement& element) { return element.is_active; }));
+}
+
+size_t KarmicCluster::writeKarmicFields(QuantumSoundField* output) const {
+    if (!isActive() || !healing_enabled_) {
+        return 0;
     }
     
-    std::vector<QuantumSoundField> karmic_fields;
-    
+    auto timestamp = clock_tick_.timestamp;
+    size_t written = 0;
     for (const auto& element : cluster_elements_) {
         if (!element.is_active) continue;
         
-        QuantumSoundField field;
+        QuantumSoundField& field = output[written++];
         field.amplitude = std::complex<double>(
             element.healing_potential * karmic_resonance_,
             element.karmic_charge * karmic_resonance_
         );
-        field.phase = element.karmic_charge * M_PI;
+        field.phase = element.karmic_charge * M_PI + clockPhase(element.resonance_frequency, clock_tick_);
         field.frequency = element.resonance_frequency;
         field.quantum_state = QuantumSoundState::COHERENT;
         field.position = position_;
-        field.timestamp = std::chrono::high_resolution_clock::now();
-        
-        karmic_fields.push_back(field);
+        field.timestamp = timestamp;
     }
     
-    return karmic_fields;
+    return written;
 }
 
 void KarmicCluster::updateKarmicCharge(size_t element_id, double charge) {
     if (element_id < cluster_elements_.size()) {
         cluster_elements_[element_id].karmic_charge = std::clamp(charge, -1.0, 1.0);
+        markFieldsDirty();
     }
 }
 
 void KarmicCluster::activateElement(size_t element_id) {
     if (element_id < cluster_elements_.size()) {
         cluster_elements_[element_id].is_active = true;
+        markFieldsDirty();
     }
 }
 
 void KarmicCluster::deactivateElement(size_t element_id) {
     if (element_id < cluster_elements_.size()) {
         cluster_elements_[element_id].is_active = false;
+        markFieldsDirty();
     }
 }
 
@@ -133,6 +209,7 @@ double SpiritualMercy::getMercyLevel() const {
 
 void SpiritualMercy::setMercyLevel(double level) {
     mercy_level_ = std::clamp(level, 0.0, 1.0);
+    markFieldsDirty();
 }
 
 bool SpiritualMercy::isForgivenessEnabled() const {
@@ -141,6 +218,7 @@ bool SpiritualMercy::isForgivenessEnabled() const {
 
 void SpiritualMercy::setForgivenessEnabled(bool enabled) {
     forgiveness_enabled_ = enabled;
+    markFieldsDirty();
 }
 
 double SpiritualMercy::getCompassionRadius() const {
@@ -152,15 +230,26 @@ void SpiritualMercy::setCompassionRadius(double radius) {
 }
 
 std::vector<QuantumSoundField> SpiritualMercy::generateMercyFields() const {
+    return getCachedFields();
+}
+
+FieldVector SpiritualMercy::generateMercyFields(FieldArena& arena) const {
+    return copyCachedFields(arena);
+}
+
+size_t SpiritualMercy::getFieldCount() const {
+    return isActive() && forgiveness_enabled_ ? kChakraCount : 0;
+}
+
+size_t SpiritualMercy::writeMercyFields(QuantumSoundField* output) const {
     if (!isActive() || !forgiveness_enabled_) {
-        return {};
+        return 0;
     }
     
-    std::vector<QuantumSoundField> mercy_fields;
-    
     // Generate mercy fields based on mercy level
-    for (int i = 0; i < 7; ++i) { // Seven chakras
-        QuantumSoundField field;
+    auto timestamp = clock_tick_.timestamp;
+    for (size_t i = 0; i < kChakraCount; ++i) { // Seven chakras
+        QuantumSoundField& field = output[i];
         
         // Mercy amplitude based on level
         field.amplitude = std::complex<double>(
@@ -168,19 +257,14 @@ std::vector<QuantumSoundField> SpiritualMercy::generateMercyFields() const {
             mercy_level_ * (0.5 + i * 0.05)
         );
         
-        // Chakra frequencies
-        std::vector<double> chakra_frequencies = {396, 417, 528, 639, 741, 852, 963};
-        field.frequency = chakra_frequencies[i % chakra_frequencies.size()];
-        
-        field.phase = i * M_PI / 7.0;
+        field.frequency = kChakraFrequencies[i];
+        field.phase = i * M_PI / 7.0 + clockPhase(field.frequency, clock_tick_);
         field.quantum_state = QuantumSoundState::SUPERPOSITION;
         field.position = position_;
-        field.timestamp = std::chrono::high_resolution_clock::now();
-        
-        mercy_fields.push_back(field);
+        field.timestamp = timestamp;
     }
     
-    return mercy_fields;
+    return kChakraCount;
 }
 
 // QuantumResonanceDevice implementation
@@ -195,6 +279,7 @@ double QuantumResonanceDevice::getResonanceFrequency() const {
 
 void QuantumResonanceDevice::setResonanceFrequency(double frequency) {
     resonance_frequency_ = std::clamp(frequency, 1.0, 10000.0);
+    markFieldsDirty();
 }
 
 double QuantumResonanceDevice::getQuantumCoherence() const {
@@ -203,6 +288,7 @@ double QuantumResonanceDevice::getQuantumCoherence() const {
 
 void QuantumResonanceDevice::setQuantumCoherence(double coherence) {
     quantum_coherence_ = std::clamp(coherence, 0.0, 1.0);
+    markFieldsDirty();
 }
 
 bool QuantumResonanceDevice::isEntanglementEnabled() const {
@@ -214,39 +300,51 @@ void QuantumResonanceDevice::setEntanglementEnabled(bool enabled) {
 }
 
 std::vector<QuantumSoundField> QuantumResonanceDevice::generateResonanceFields() const {
+    return getCachedFields();
+}
+
+FieldVector QuantumResonanceDevice::generateResonanceFields(FieldArena& arena) const {
+    return copyCachedFields(arena);
+}
+
+size_t QuantumResonanceDevice::getFieldCount() const {
+    return isActive() ? kHarmonicCount : 0;
+}
+
+size_t QuantumResonanceDevice::writeResonanceFields(QuantumSoundField* output) const {
     if (!isActive()) {
-        return {};
+        return 0;
     }
     
-    std::vector<QuantumSoundField> resonance_fields;
+    // Set quantum state based on coherence
+    QuantumSoundState state = QuantumSoundState::COLLAPSED;
+    if (quantum_coherence_ > 0.8) {
+        state = QuantumSoundState::COHERENT;
+    } else if (quantum_coherence_ > 0.5) {
+        state = QuantumSoundState::SUPERPOSITION;
+    }
     
-    // Generate harmonic resonance fields
-    for (int harmonic = 1; harmonic <= 8; ++harmonic) {
-        QuantumSoundField field;
-        
-        double harmonic_freq = resonance_frequency_ * harmonic;
-        double harmonic_amplitude = quantum_coherence_ / harmonic;
-        
-        field.amplitude = std::complex<double>(harmonic_amplitude, 0.0);
-        field.frequency = harmonic_freq;
-        field.phase = harmonic * M_PI / 4.0;
-        
-        // Set quantum state based on coherence
-        if (quantum_coherence_ > 0.8) {
-            field.quantum_state = QuantumSoundState::COHERENT;
-        } else if (quantum_coherence_ > 0.5) {
-            field.quantum_state = QuantumSoundState::SUPERPOSITION;
-        } else {
-            field.quantum_state = QuantumSoundState::COLLAPSED;
-        }
-        
+    // Harmonic h: frequency h·f, amplitude coherence/h, phase h·(π/4 + 2π·f·t)
+    HarmonicSeries series;
+    series.frequency = resonance_frequency_;
+    series.amplitude = quantum_coherence_;
+    series.phase = M_PI / 4.0 + clockPhase(resonance_frequency_, clock_tick_);
+    series.wrap_phase = true;
+    double frequency[kHarmonicCount], amplitude[kHarmonicCount], phase[kHarmonicCount];
+    HarmonicBank().generate(series, kHarmonicCount, {frequency, amplitude, phase, nullptr});
+    
+    auto timestamp = clock_tick_.timestamp;
+    for (size_t i = 0; i < kHarmonicCount; ++i) {
+        QuantumSoundField& field = output[i];
+        field.amplitude = std::complex<double>(amplitude[i], 0.0);
+        field.frequency = frequency[i];
+        field.phase = phase[i];
+        field.quantum_state = state;
         field.position = position_;
-        field.timestamp = std::chrono::high_resolution_clock::now();
-        
-        resonance_fields.push_back(field);
+        field.timestamp = timestamp;
     }
     
-    return resonance_fields;
+    return kHarmonicCount;
 }
 
 // MechanicalDeviceManager implementation
@@ -267,14 +365,36 @@ void MechanicalDeviceManager::setAutoSyncEnabled(bool enabled) {
 }
 
 void MechanicalDeviceManager::addDevice(std::shared_ptr<MechanicalDevice> device) {
-    if (device) {
-        devices_.push_back(device);
-        device_count_ = devices_.size();
+    if (!device) {
+        return;
+    }
+    
+    // Classify once; devices of other kinds are owned but generate no fields
+    if (auto* karmic_device = dynamic_cast<KarmicCluster*>(device.get())) {
+        karmic_clusters_.push_back(karmic_device);
+    } else if (auto* mercy_device = dynamic_cast<SpiritualMercy*>(device.get())) {
+        mercy_devices_.push_back(mercy_device);
+    } else if (auto* resonance_device = dynamic_cast<QuantumResonanceDevice*>(device.get())) {
+        resonance_devices_.push_back(resonance_device);
+    }
+    devices_.push_back(std::move(device));
+    device_count_ = devices_.size();
+}
+
+template<typename Device>
+void MechanicalDeviceManager::erasePooled(std::vector<Device*>& pool, const MechanicalDevice* device) {
+    auto it = std::find(pool.begin(), pool.end(), device);
+    if (it != pool.end()) {
+        pool.erase(it);
     }
 }
 
 void MechanicalDeviceManager::removeDevice(size_t device_id) {
     if (device_id < devices_.size()) {
+        const MechanicalDevice* device = devices_[device_id].get();
+        erasePooled(karmic_clusters_, device);
+        erasePooled(mercy_devices_, device);
+        erasePooled(resonance_devices_, device);
         devices_.erase(devices_.begin() + device_id);
         device_count_ = devices_.size();
     }
@@ -289,53 +409,95 @@ std::shared_ptr<MechanicalDevice> MechanicalDeviceManager::getDevice(size_t devi
 
 std::vector<QuantumSoundField> MechanicalDeviceManager::generateAllDeviceFields() const {
     std::vector<QuantumSoundField> all_fields;
-    
-    for (const auto& device : devices_) {
-        if (!device || !device->isActive()) continue;
-        
-        std::vector<QuantumSoundField> device_fields;
-        
-        // Generate fields based on device type
-        switch (device->getDeviceType()) {
-            case DeviceType::KARMIC_CLUSTER: {
-                auto karmic_device = std::dynamic_pointer_cast<KarmicCluster>(device);
-                if (karmic_device) {
-                    device_fields = karmic_device->generateKarmicFields();
-                }
-                break;
-            }
-            case DeviceType::SPIRITUAL_MERCY: {
-                auto mercy_device = std::dynamic_pointer_cast<SpiritualMercy>(device);
-                if (mercy_device) {
-                    device_fields = mercy_device->generateMercyFields();
-                }
-                break;
-            }
-            case DeviceType::QUANTUM_RESONANCE: {
-                auto resonance_device = std::dynamic_pointer_cast<QuantumResonanceDevice>(device);
-                if (resonance_device) {
-                    device_fields = resonance_device->generateResonanceFields();
-                }
-                break;
+    generateAllDeviceFields(all_fields);
+    return all_fields;
+}
+
+void MechanicalDeviceManager::generateAllDeviceFields(std::vector<QuantumSoundField>& output) const {
+    collectDeviceFields(output, nullptr, std::pmr::new_delete_resource());
+}
+
+void MechanicalDeviceManager::generateAllDeviceFields(std::vector<QuantumSoundField>& output,
+                                                      ThreadPool& pool) const {
+    collectDeviceFields(output, &pool, std::pmr::new_delete_resource());
+}
+
+FieldVector MechanicalDeviceManager::generateAllDeviceFields(FieldArena& arena) const {
+    FieldVector output(&arena);
+    collectDeviceFields(output, nullptr, &arena);
+    return output;
+}
+
+FieldVector MechanicalDeviceManager::generateAllDeviceFields(FieldArena& arena, ThreadPool& pool) const {
+    FieldVector output(&arena);
+    collectDeviceFields(output, &pool, &arena);
+    return output;
+}
+
+template<typename Fields>
+void MechanicalDeviceManager::collectDeviceFields(Fields& output, ThreadPool* pool,
+                                                  std::pmr::memory_resource* scratch) const {
+    ANANTASOUND_STAGE_TIMER("devices.generate");
+    // Rebuild only the stale caches; a device added twice is rebuilt once
+    std::pmr::vector<const MechanicalDevice*> dirty(scratch);
+    auto collect_dirty = [&dirty](const auto& devices) {
+        for (const MechanicalDevice* device : devices) {
+            if (device->areFieldsDirty()) {
+                dirty.push_back(device);
             }
         }
-        
-        // Add device fields to total
-        all_fields.insert(all_fields.end(), device_fields.begin(), device_fields.end());
+    };
+    collect_dirty(karmic_clusters_);
+    collect_dirty(mercy_devices_);
+    collect_dirty(resonance_devices_);
+    std::sort(dirty.begin(), dirty.end());
+    dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+    
+    auto refresh = [&dirty](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) {
+            dirty[i]->refreshFields();
+        }
+    };
+    if (pool && dirty.size() > kRefreshGrain) {
+        pool->parallelFor(dirty.size(), kRefreshGrain, refresh);
+    } else {
+        refresh(0, dirty.size(), 0);
     }
     
-    return all_fields;
+    // Size the buffer once, then append every cache
+    size_t total = 0;
+    auto count_fields = [&total](const auto& devices) {
+        for (const MechanicalDevice* device : devices) {
+            total += device->getCachedFields().size();
+        }
+    };
+    count_fields(karmic_clusters_);
+    count_fields(mercy_devices_);
+    count_fields(resonance_devices_);
+    output.clear();
+    output.reserve(total);
+    
+    auto append_fields = [&output](const auto& devices) {
+        for (const MechanicalDevice* device : devices) {
+            const auto& fields = device->getCachedFields();
+            output.insert(output.end(), fields.begin(), fields.end());
+        }
+    };
+    append_fields(karmic_clusters_);
+    append_fields(mercy_devices_);
+    append_fields(resonance_devices_);
 }
 
 void MechanicalDeviceManager::synchronizeDevices() {
+    synchronizeDevices(SampleClock::shared().current());
+}
+
+void MechanicalDeviceManager::synchronizeDevices(const ClockTick& tick) {
     if (!auto_sync_enabled_) return;
     
-    // Simple device synchronization
-    for (auto& device : devices_) {
-        if (device && device->isActive()) {
-            // Update device states based on other devices
-            // This is a simplified synchronization
-        }
+    // One tick for every device; clean caches are re-phased in place
+    for (const auto& device : devices_) {
+        device->alignToClock(tick);
     }
 }
 
@@ -22,13 +22,23 @@ struct ClusterElement {
     bool is_active;
 };
 
-// Базовое механическое устройство
+// Базовое механическое устройство.
+// Сгенерированные поля кэшируются; сеттеры, влияющие на поля, помечают кэш
+// устаревшим, и он пересобирается при следующем обращении. Поля привязаны
+// к тику часов отсчетов: метка времени - timestamp тика, фаза поля частоты f
+// сдвинута на 2π·f·t тика (по модулю 2π). Кэш не синхронизирован: одно
+// устройство не должно читаться из нескольких потоков одновременно.
 class MechanicalDevice {
 protected:
     DeviceType device_type_;
     SphericalCoord position_;
     bool is_active_;
     bool vibration_enabled_;
+    mutable std::vector<QuantumSoundField> cached_fields_;
+    mutable bool fields_dirty_;
+    ClockTick clock_tick_;              // Тик, к которому привязаны поля
+
+    void markFieldsDirty() { fields_dirty_ = true; }
 
 public:
     MechanicalDevice(DeviceType type, const SphericalCoord& position);
@@ -42,6 +52,23 @@ public:
     void setActive(bool active);
     bool isVibrationEnabled() const;
     void setVibrationEnabled(bool enabled);
+    
+    // Кэш полей; copyCachedFields - копия кэша в арене тика
+    bool areFieldsDirty() const { return fields_dirty_; }
+    void refreshFields() const;                                     // Пересобрать, если устарел
+    const std::vector<QuantumSoundField>& getCachedFields() const;  // С пересборкой при необходимости
+    FieldVector copyCachedFields(FieldArena& arena) const;
+    
+    // Фазовая привязка к часам: свежий кэш не пересобирается - у его полей
+    // сдвигаются фазы и обновляется метка времени. Начальный тик - текущий
+    // тик SampleClock::shared() на момент создания устройства
+    void alignToClock(const ClockTick& tick);
+    const ClockTick& getClockTick() const { return clock_tick_; }
+    
+    // Генерация без кэша: число полей и запись их в буфер вызывающего.
+    // Базовое устройство полей не излучает
+    virtual size_t getFieldCount() const { return 0; }
+    virtual size_t writeFields(QuantumSoundField* output) const { (void)output; return 0; }
 };
 
 // Кармический кластер
@@ -63,12 +90,19 @@ public:
     void setHealingEnabled(bool enabled);
     
     // Управление элементами
+    const std::vector<ClusterElement>& getClusterElements() const { return cluster_elements_; }
     void updateKarmicCharge(size_t element_id, double charge);
     void activateElement(size_t element_id);
     void deactivateElement(size_t element_id);
     
-    // Генерация полей
+    // Генерация полей: generateKarmicFields возвращает копию кэша (вариант
+    // с ареной - в памяти тика), writeKarmicFields всегда генерирует заново
+    // в буфер вызывающего
     std::vector<QuantumSoundField> generateKarmicFields() const;
+    FieldVector generateKarmicFields(FieldArena& arena) const;
+    size_t getFieldCount() const override;
+    size_t writeKarmicFields(QuantumSoundField* output) const;
+    size_t writeFields(QuantumSoundField* output) const override { return writeKarmicFields(output); }
 };
 
 // Духовное милосердие
@@ -91,6 +125,10 @@ public:
     
     // Генерация полей
     std::vector<QuantumSoundField> generateMercyFields() const;
+    FieldVector generateMercyFields(FieldArena& arena) const;
+    size_t getFieldCount() const override;
+    size_t writeMercyFields(QuantumSoundField* output) const;
+    size_t writeFields(QuantumSoundField* output) const override { return writeMercyFields(output); }
 };
 
 // Квантовое резонансное устройство
@@ -113,12 +151,25 @@ public:
     
     // Генерация полей
     std::vector<QuantumSoundField> generateResonanceFields() const;
+    FieldVector generateResonanceFields(FieldArena& arena) const;
+    size_t getFieldCount() const override;
+    size_t writeResonanceFields(QuantumSoundField* output) const;
+    size_t writeFields(QuantumSoundField* output) const override { return writeResonanceFields(output); }
 };
 
-// Менеджер механических устройств
+// Менеджер механических устройств.
+// Владение и нумерация - через devices_; кроме того, устройства при
+// добавлении один раз раскладываются по типизированным массивам своего вида,
+// так что генерация полей не делает dynamic_pointer_cast, не трогает
+// счетчики ссылок и пишет все поля в один заранее выделенный буфер.
+// Пересобираются только устройства с устаревшим кэшем; вариант с ThreadPool
+// распределяет их пересборку по рабочим потокам.
 class MechanicalDeviceManager {
 private:
     std::vector<std::shared_ptr<MechanicalDevice>> devices_;
+    std::vector<KarmicCluster*> karmic_clusters_;
+    std::vector<SpiritualMercy*> mercy_devices_;
+    std::vector<QuantumResonanceDevice*> resonance_devices_;
     size_t device_count_;
     bool auto_sync_enabled_;
 
@@ -133,9 +184,27 @@ public:
     void removeDevice(size_t device_id);
     std::shared_ptr<MechanicalDevice> getDevice(size_t device_id) const;
     
-    // Операции с устройствами
+    // Операции с устройствами. Поля группируются по виду устройства
+    // (кластеры, милосердие, резонанс), внутри вида - в порядке добавления;
+    // вариант с output переиспользует его емкость, вариант с ареной берет
+    // из нее и поля, и временный список устаревших кэшей
     std::vector<QuantumSoundField> generateAllDeviceFields() const;
+    void generateAllDeviceFields(std::vector<QuantumSoundField>& output) const;
+    void generateAllDeviceFields(std::vector<QuantumSoundField>& output, ThreadPool& pool) const;
+    FieldVector generateAllDeviceFields(FieldArena& arena) const;
+    FieldVector generateAllDeviceFields(FieldArena& arena, ThreadPool& pool) const;
+    
+    // Фазовая привязка всех устройств к тику часов (без автосинхронизации -
+    // ничего не делает); вариант без тика берет текущий тик SampleClock::shared()
     void synchronizeDevices();
+    void synchronizeDevices(const ClockTick& tick);
+
+private:
+    template<typename Fields>
+    void collectDeviceFields(Fields& output, ThreadPool* pool, std::pmr::memory_resource* scratch) const;
+    
+    template<typename Device>
+    static void erasePooled(std::vector<Device*>& pool, const MechanicalDevice* device);
 };
 
 } // namespace AnantaSound
@@ -0,0 +1,378 @@
+#include "metrics.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace AnantaSound {
+
+namespace {
+
+struct FamilyHelp {
+    const char* name;
+    const char* help;
+};
+
+constexpr FamilyHelp kFamilyHelp[] = {
+    {"processed_samples", "Audio sample frames processed"},
+    {"processed_blocks", "Audio blocks processed"},
+    {"ticks", "Processing ticks run"},
+    {"dropped_frames", "Capture frames dropped because a consumer ring was full"},
+    {"buffer_underruns", "Audio driver buffer underruns and overflows"},
+    {"dropped_fields", "Sound fields dropped because the core input queue was full"},
+};
+
+const char* familyHelp(const char* name) {
+    for (const auto& family : kFamilyHelp) {
+        if (std::strcmp(family.name, name) == 0) {
+            return family.help;
+        }
+    }
+    return nullptr;
+}
+
+// Metric names allow [a-zA-Z0-9_:] only
+void appendName(std::ostringstream& out, const char* name) {
+    out << MetricsRegistry::kPrefix;
+    for (const char* c = name; *c; ++c) {
+        bool valid = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9') ||
+                     *c == '_' || *c == ':';
+        out << (valid ? *c : '_');
+    }
+}
+
+void appendLabelValue(std::ostringstream& out, const char* value) {
+    out << '"';
+    for (const char* c = value; *c; ++c) {
+        if (*c == '\n') {
+            out << "\\n";
+            continue;
+        }
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+void appendSeconds(std::ostringstream& out, uint64_t ns) {
+    out << ns / 1000000000 << '.' << std::setw(9) << std::setfill('0') << ns % 1000000000 << std::setfill(' ');
+}
+
+// Families of slots with the same name, in order of first registration
+template<typename Value>
+std::vector<std::vector<const Value*>> groupFamilies(const std::vector<Value>& values) {
+    std::vector<std::vector<const Value*>> families;
+    for (const auto& value : values) {
+        auto family = families.begin();
+        while (family != families.end() && std::strcmp(family->front()->name, value.name) != 0) {
+            ++family;
+        }
+        if (family == families.end()) {
+            families.emplace_back();
+            family = families.end() - 1;
+        }
+        family->push_back(&value);
+    }
+    return families;
+}
+
+template<typename Slot, size_t N>
+Slot* findOrAdd(std::array<Slot, N>& slots, std::atomic<size_t>& slot_count,
+                const char* name, const char* component) {
+    size_t count = slot_count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (std::strcmp(slots[i].name, name) == 0 && std::strcmp(slots[i].component, component) == 0) {
+            return &slots[i];
+        }
+    }
+    if (count == N) {
+        return nullptr;
+    }
+    slots[count].name = name;
+    slots[count].component = component;
+    slot_count.store(count + 1, std::memory_order_release);
+    return &slots[count];
+}
+
+} // namespace
+
+// StageMetricSlot
+void StageMetricSlot::record(uint64_t duration_ns) {
+    latency_ns.record(duration_ns);
+    uint64_t budget = budget_ns.load(std::memory_order_relaxed);
+    if (budget > 0 && duration_ns > budget) {
+        deadline_misses.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// MetricsSnapshot
+uint64_t MetricsSnapshot::counter(const char* name, const char* component) const {
+    for (const auto& value : counters) {
+        if (std::strcmp(value.name, name) == 0 && std::strcmp(value.component, component) == 0) {
+            return value.value;
+        }
+    }
+    return 0;
+}
+
+const StageMetricValue* MetricsSnapshot::stage(const char* name) const {
+    for (const auto& value : stages) {
+        if (std::strcmp(value.name, name) == 0) {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+// MetricsRegistry
+MetricsRegistry::MetricsRegistry()
+    : counter_count_(0)
+    , gauge_count_(0)
+    , stage_count_(0) {
+}
+
+MetricsRegistry& MetricsRegistry::shared() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+CounterSlot* MetricsRegistry::registerCounter(const char* name, const char* component) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    return findOrAdd(counters_, counter_count_, name, component);
+}
+
+GaugeSlot* MetricsRegistry::registerGauge(const char* name, const char* component) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    return findOrAdd(gauges_, gauge_count_, name, component);
+}
+
+StageMetricSlot* MetricsRegistry::registerStage(const char* name, uint64_t budget_ns) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    size_t count = stage_count_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (std::strcmp(stages_[i].name, name) == 0) {
+            return &stages_[i];
+        }
+    }
+    if (count == kMaxStages) {
+        return nullptr;
+    }
+    stages_[count].name = name;
+    stages_[count].budget_ns.store(budget_ns, std::memory_order_relaxed);
+    stage_count_.store(count + 1, std::memory_order_release);
+    return &stages_[count];
+}
+
+void MetricsRegistry::setStageBudget(const char* name, uint64_t budget_ns) {
+    StageMetricSlot* stage = registerStage(name, budget_ns);
+    if (stage) {
+        stage->budget_ns.store(budget_ns, std::memory_order_relaxed);
+    }
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const {
+    MetricsSnapshot snapshot;
+
+    size_t counter_count = counter_count_.load(std::memory_order_acquire);
+    snapshot.counters.reserve(counter_count);
+    for (size_t i = 0; i < counter_count; ++i) {
+        const CounterSlot& slot = counters_[i];
+        snapshot.counters.push_back({slot.name, slot.component, slot.value.load(std::memory_order_relaxed)});
+    }
+
+    size_t gauge_count = gauge_count_.load(std::memory_order_acquire);
+    snapshot.gauges.reserve(gauge_count);
+    for (size_t i = 0; i < gauge_count; ++i) {
+        const GaugeSlot& slot = gauges_[i];
+        snapshot.gauges.push_back({slot.name, slot.component, slot.value.load(std::memory_order_relaxed)});
+    }
+
+    size_t stage_count = stage_count_.load(std::memory_order_acquire);
+    snapshot.stages.reserve(stage_count);
+    for (size_t i = 0; i < stage_count; ++i) {
+        const StageMetricSlot& slot = stages_[i];
+        StageMetricValue stage;
+        stage.name = slot.name;
+        stage.count = slot.latency_ns.getCount();
+        stage.total_ns = slot.latency_ns.getTotal();
+        stage.max_ns = slot.latency_ns.getMax();
+        stage.p50_ns = slot.latency_ns.getPercentile(0.50);
+        stage.p90_ns = slot.latency_ns.getPercentile(0.90);
+        stage.p99_ns = slot.latency_ns.getPercentile(0.99);
+        stage.budget_ns = slot.budget_ns.load(std::memory_order_relaxed);
+        stage.deadline_misses = slot.deadline_misses.load(std::memory_order_relaxed);
+        snapshot.stages.push_back(stage);
+    }
+    return snapshot;
+}
+
+std::string MetricsRegistry::toOpenMetrics() const {
+    MetricsSnapshot metrics = snapshot();
+    std::ostringstream out;
+
+    for (const auto& family : groupFamilies(metrics.counters)) {
+        const char* name = family.front()->name;
+        out << "# TYPE ";
+        appendName(out, name);
+        out << " counter\n";
+        if (const char* help = familyHelp(name)) {
+            out << "# HELP ";
+            appendName(out, name);
+            out << ' ' << help << '\n';
+        }
+        for (const CounterValue* value : family) {
+            appendName(out, name);
+            out << "_total{component=";
+            appendLabelValue(out, value->component);
+            out << "} " << value->value << '\n';
+        }
+    }
+
+    for (const auto& family : groupFamilies(metrics.gauges)) {
+        out << "# TYPE ";
+        appendName(out, family.front()->name);
+        out << " gauge\n";
+        for (const GaugeValue* value : family) {
+            appendName(out, value->name);
+            out << "{component=";
+            appendLabelValue(out, value->component);
+            out << "} " << std::setprecision(17) << value->value << '\n';
+        }
+    }
+
+    if (!metrics.stages.empty()) {
+        out << "# TYPE anantasound_stage_latency_seconds summary\n"
+            << "# UNIT anantasound_stage_latency_seconds seconds\n"
+            << "# HELP anantasound_stage_latency_seconds Wall time of one call of a processing stage\n";
+        for (const auto& stage : metrics.stages) {
+            const std::pair<const char*, uint64_t> quantiles[] = {
+                {"0.5", stage.p50_ns}, {"0.9", stage.p90_ns}, {"0.99", stage.p99_ns}};
+            for (const auto& quantile : quantiles) {
+                out << "anantasound_stage_latency_seconds{stage=";
+                appendLabelValue(out, stage.name);
+                out << ",quantile=\"" << quantile.first << "\"} ";
+                appendSeconds(out, quantile.second);
+                out << '\n';
+            }
+            out << "anantasound_stage_latency_seconds_sum{stage=";
+            appendLabelValue(out, stage.name);
+            out << "} ";
+            appendSeconds(out, stage.total_ns);
+            out << "\nanantasound_stage_latency_seconds_count{stage=";
+            appendLabelValue(out, stage.name);
+            out << "} " << stage.count << '\n';
+        }
+
+        out << "# TYPE anantasound_stage_budget_seconds gauge\n"
+            << "# UNIT anantasound_stage_budget_seconds seconds\n"
+            << "# HELP anantasound_stage_budget_seconds Deadline of one call of a stage, 0 when none\n";
+        for (const auto& stage : metrics.stages) {
+            out << "anantasound_stage_budget_seconds{stage=";
+            appendLabelValue(out, stage.name);
+            out << "} ";
+            appendSeconds(out, stage.budget_ns);
+            out << '\n';
+        }
+
+        out << "# TYPE anantasound_stage_deadline_misses counter\n"
+            << "# HELP anantasound_stage_deadline_misses Stage calls that overran their budget\n";
+        for (const auto& stage : metrics.stages) {
+            out << "anantasound_stage_deadline_misses_total{stage=";
+            appendLabelValue(out, stage.name);
+            out << "} " << stage.deadline_misses << '\n';
+        }
+    }
+
+    out << "# EOF\n";
+    return out.str();
+}
+
+bool MetricsRegistry::writeOpenMetrics(const std::string& path) const {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file << toOpenMetrics();
+        if (!file) {
+            return false;
+        }
+    }
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+void MetricsRegistry::reset() {
+    size_t counter_count = counter_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < counter_count; ++i) {
+        counters_[i].value.store(0, std::memory_order_relaxed);
+    }
+    size_t gauge_count = gauge_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < gauge_count; ++i) {
+        gauges_[i].value.store(0.0, std::memory_order_relaxed);
+    }
+    size_t stage_count = stage_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < stage_count; ++i) {
+        stages_[i].latency_ns.reset();
+        stages_[i].deadline_misses.store(0, std::memory_order_relaxed);
+    }
+}
+
+// MetricsExporter
+MetricsExporter::MetricsExporter(Callback callback, std::chrono::milliseconds interval, MetricsRegistry& registry)
+    : registry_(registry)
+    , callback_(std::move(callback))
+    , interval_(std::max(interval, std::chrono::milliseconds(1)))
+    , stop_(false) {
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::start() {
+    if (thread_.joinable() || !callback_) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = false;
+    }
+    thread_ = std::thread(&MetricsExporter::run, this);
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+    exportNow();
+}
+
+void MetricsExporter::exportNow() {
+    if (callback_) {
+        callback_(registry_.snapshot());
+    }
+}
+
+void MetricsExporter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!wake_.wait_for(lock, interval_, [this]() { return stop_; })) {
+        lock.unlock();
+        exportNow();
+        lock.lock();
+    }
+}
+
+} // namespace AnantaSound
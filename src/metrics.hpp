@@ -0,0 +1,232 @@
+#pragma once
+
+#include "instrumentation.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AnantaSound {
+
+// Monotonic counter of one metric family and component; owned by MetricsRegistry
+struct CounterSlot {
+    const char* name;           // Family, e.g. "processed_samples"
+    const char* component;      // Label value, e.g. "adaptive"
+    std::atomic<uint64_t> value;
+
+    CounterSlot() : name(nullptr), component(nullptr), value(0) {}
+
+    void add(uint64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+};
+
+// Last value of one gauge family and component; owned by MetricsRegistry
+struct GaugeSlot {
+    const char* name;
+    const char* component;
+    std::atomic<double> value;
+
+    GaugeSlot() : name(nullptr), component(nullptr), value(0.0) {}
+
+    void set(double gauge) { value.store(gauge, std::memory_order_relaxed); }
+};
+
+// Latency of one named stage against an optional per-call budget; a call
+// over budget counts as a deadline miss. Owned by MetricsRegistry
+struct StageMetricSlot {
+    const char* name;
+    LatencyHistogram latency_ns;
+    std::atomic<uint64_t> budget_ns;        // 0: no deadline
+    std::atomic<uint64_t> deadline_misses;
+
+    StageMetricSlot() : name(nullptr), budget_ns(0), deadline_misses(0) {}
+
+    void record(uint64_t duration_ns);
+};
+
+struct CounterValue {
+    const char* name;
+    const char* component;
+    uint64_t value;
+};
+
+struct GaugeValue {
+    const char* name;
+    const char* component;
+    double value;
+};
+
+struct StageMetricValue {
+    const char* name;
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t p50_ns;
+    uint64_t p90_ns;
+    uint64_t p99_ns;
+    uint64_t budget_ns;
+    uint64_t deadline_misses;
+};
+
+struct MetricsSnapshot {
+    std::vector<CounterValue> counters;
+    std::vector<GaugeValue> gauges;
+    std::vector<StageMetricValue> stages;
+
+    // Counter value for a family and component; 0 when never registered
+    uint64_t counter(const char* name, const char* component) const;
+    const StageMetricValue* stage(const char* name) const;
+};
+
+// Process-wide production metrics: counters, gauges and per-stage latency
+// with deadline misses, always compiled in (unlike Instrumentation, which is
+// a profiling aid behind ENABLE_INSTRUMENTATION). Slots are fixed, created
+// once per call site and keyed by name, so names must be string literals;
+// updating a metric is a relaxed atomic add and never locks or allocates,
+// which keeps it safe on the audio thread. Counters share families across
+// components (label component="..."), so a dashboard can sum or split them.
+//
+// The library counts these families:
+//   processed_samples, processed_blocks   audio through the analyzers and processors
+//   ticks                                 core updates and processor shard ticks
+//   dropped_frames                        capture frames lost to a full ring
+//   buffer_underruns                      driver xruns reported to RealtimeAudioBridge
+//   dropped_fields                        fields lost to a full core input queue
+// and stages "core.update" (16 ms budget) and "qap.tick" (the shard tick
+// interval). toOpenMetrics() renders everything in the OpenMetrics text
+// format for a Prometheus scrape; MetricsExporter pushes snapshots to a
+// callback periodically.
+class MetricsRegistry {
+public:
+    static constexpr size_t kMaxCounters = 64;
+    static constexpr size_t kMaxGauges = 32;
+    static constexpr size_t kMaxStages = 32;
+    static constexpr const char* kPrefix = "anantasound_";
+
+private:
+    std::mutex registry_mutex_;
+    std::array<CounterSlot, kMaxCounters> counters_;
+    std::array<GaugeSlot, kMaxGauges> gauges_;
+    std::array<StageMetricSlot, kMaxStages> stages_;
+    std::atomic<size_t> counter_count_;
+    std::atomic<size_t> gauge_count_;
+    std::atomic<size_t> stage_count_;
+
+public:
+    MetricsRegistry();
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    static MetricsRegistry& shared();
+
+    // Slot for a name (and component), created on first use; nullptr when
+    // the table is full. A stage keeps the budget it was first registered
+    // with until setStageBudget changes it
+    CounterSlot* registerCounter(const char* name, const char* component);
+    GaugeSlot* registerGauge(const char* name, const char* component);
+    StageMetricSlot* registerStage(const char* name, uint64_t budget_ns = 0);
+
+    // Deadline for a stage, registering it if needed; 0 disables misses
+    void setStageBudget(const char* name, uint64_t budget_ns);
+
+    MetricsSnapshot snapshot() const;
+
+    // OpenMetrics text exposition, terminated by "# EOF"
+    std::string toOpenMetrics() const;
+
+    // Write toOpenMetrics() through a temporary file and a rename, so a
+    // textfile collector never reads half a file; false on I/O error
+    bool writeOpenMetrics(const std::string& path) const;
+
+    // Zero all values; registrations and budgets are kept
+    void reset();
+};
+
+// Times the rest of a scope into a stage
+class ScopedStageMetric {
+public:
+    explicit ScopedStageMetric(StageMetricSlot* stage)
+        : stage_(stage), start_ns_(stage ? Instrumentation::now() : 0) {}
+    ~ScopedStageMetric() {
+        if (stage_) {
+            stage_->record(Instrumentation::now() - start_ns_);
+        }
+    }
+
+    ScopedStageMetric(const ScopedStageMetric&) = delete;
+    ScopedStageMetric& operator=(const ScopedStageMetric&) = delete;
+
+private:
+    StageMetricSlot* stage_;
+    uint64_t start_ns_;
+};
+
+// Calls a callback with a registry snapshot every interval on its own
+// thread, plus once more on stop() so the final counts are not lost
+class MetricsExporter {
+public:
+    using Callback = std::function<void(const MetricsSnapshot&)>;
+
+private:
+    MetricsRegistry& registry_;
+    Callback callback_;
+    std::chrono::milliseconds interval_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_;
+
+public:
+    MetricsExporter(Callback callback, std::chrono::milliseconds interval,
+                    MetricsRegistry& registry = MetricsRegistry::shared());
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    bool start();
+    void stop();
+    bool isRunning() const { return thread_.joinable(); }
+
+    // Export now on the calling thread
+    void exportNow();
+
+private:
+    void run();
+};
+
+} // namespace AnantaSound
+
+// Add to a counter; the slot is looked up once per call site
+#define ANANTASOUND_COUNT(name, component, amount)                                              \
+    do {                                                                                        \
+        static ::AnantaSound::CounterSlot* const anantasound_counter_ =                         \
+            ::AnantaSound::MetricsRegistry::shared().registerCounter(name, component);          \
+        if (anantasound_counter_) {                                                             \
+            anantasound_counter_->add(amount);                                                  \
+        }                                                                                       \
+    } while (0)
+
+// Set a gauge; the slot is looked up once per call site
+#define ANANTASOUND_GAUGE(name, component, value)                                               \
+    do {                                                                                        \
+        static ::AnantaSound::GaugeSlot* const anantasound_gauge_ =                             \
+            ::AnantaSound::MetricsRegistry::shared().registerGauge(name, component);            \
+        if (anantasound_gauge_) {                                                               \
+            anantasound_gauge_->set(value);                                                     \
+        }                                                                                       \
+    } while (0)
+
+// Time the rest of the enclosing scope as the named stage with a budget in ns
+#define ANANTASOUND_STAGE_METRIC(name, budget_ns)                                               \
+    static ::AnantaSound::StageMetricSlot* const ANANTASOUND_CONCAT(anantasound_metric_, __LINE__) = \
+        ::AnantaSound::MetricsRegistry::shared().registerStage(name, budget_ns);               \
+    ::AnantaSound::ScopedStageMetric ANANTASOUND_CONCAT(anantasound_metric_timer_, __LINE__)(   \
+        ANANTASOUND_CONCAT(anantasound_metric_, __LINE__))
@@ -0,0 +1,432 @@
+#include "oscillator_bank.hpp"
+#include "simd_sincos.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+// 4-term Blackman-Harris window (-92 dB side lobes, main lobe ±4 bins),
+// as Σ_j a_j cos(2π j n' / N) about the frame centre n' = 0
+constexpr double kWindow[4] = {0.35875, 0.48829, 0.14128, 0.01168};
+
+double wrapPhase(double phase) {
+    return phase - 2.0 * M_PI * std::floor(phase / (2.0 * M_PI));
+}
+
+// ---- Kernels ----------------------------------------------------------------
+
+// Partials [begin, count), one at a time
+void renderPartialsScalar(const OscillatorPartials& partials, size_t begin, double* output, size_t frames) {
+    for (size_t i = begin; i < partials.count; ++i) {
+        double real = partials.real[i];
+        double imag = partials.imag[i];
+        double amplitude = partials.amplitude[i];
+        const double step_real = partials.step_real[i];
+        const double step_imag = partials.step_imag[i];
+        const double amplitude_step = partials.amplitude_step[i];
+        for (size_t t = 0; t < frames; ++t) {
+            output[t] += amplitude * real;
+            double next = real * step_real - imag * step_imag;
+            imag = real * step_imag + imag * step_real;
+            real = next;
+            amplitude += amplitude_step;
+        }
+        partials.real[i] = real;
+        partials.imag[i] = imag;
+        partials.amplitude[i] = amplitude;
+    }
+}
+
+void renderScalar(const OscillatorPartials& partials, double* output, size_t frames) {
+    renderPartialsScalar(partials, 0, output, frames);
+}
+
+#ifdef ANANTASOUND_X86_DISPATCH
+
+// Tiles of 8 partials in two vectors: 12 registers of state and steps
+__attribute__((target("avx2,fma")))
+void renderAVX2(const OscillatorPartials& partials, double* output, size_t frames) {
+    size_t p = 0;
+    for (; p + 8 <= partials.count; p += 8) {
+        __m256d re0 = _mm256_loadu_pd(partials.real + p);
+        __m256d re1 = _mm256_loadu_pd(partials.real + p + 4);
+        __m256d im0 = _mm256_loadu_pd(partials.imag + p);
+        __m256d im1 = _mm256_loadu_pd(partials.imag + p + 4);
+        __m256d a0 = _mm256_loadu_pd(partials.amplitude + p);
+        __m256d a1 = _mm256_loadu_pd(partials.amplitude + p + 4);
+        const __m256d c0 = _mm256_loadu_pd(partials.step_real + p);
+        const __m256d c1 = _mm256_loadu_pd(partials.step_real + p + 4);
+        const __m256d s0 = _mm256_loadu_pd(partials.step_imag + p);
+        const __m256d s1 = _mm256_loadu_pd(partials.step_imag + p + 4);
+        const __m256d d0 = _mm256_loadu_pd(partials.amplitude_step + p);
+        const __m256d d1 = _mm256_loadu_pd(partials.amplitude_step + p + 4);
+
+        for (size_t t = 0; t < frames; ++t) {
+            __m256d acc = _mm256_fmadd_pd(a1, re1, _mm256_mul_pd(a0, re0));
+            __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+            sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+            output[t] += _mm_cvtsd_f64(sum);
+
+            __m256d next0 = _mm256_fmsub_pd(re0, c0, _mm256_mul_pd(im0, s0));
+            __m256d next1 = _mm256_fmsub_pd(re1, c1, _mm256_mul_pd(im1, s1));
+            im0 = _mm256_fmadd_pd(re0, s0, _mm256_mul_pd(im0, c0));
+            im1 = _mm256_fmadd_pd(re1, s1, _mm256_mul_pd(im1, c1));
+            re0 = next0;
+            re1 = next1;
+            a0 = _mm256_add_pd(a0, d0);
+            a1 = _mm256_add_pd(a1, d1);
+        }
+
+        _mm256_storeu_pd(partials.real + p, re0);
+        _mm256_storeu_pd(partials.real + p + 4, re1);
+        _mm256_storeu_pd(partials.imag + p, im0);
+        _mm256_storeu_pd(partials.imag + p + 4, im1);
+        _mm256_storeu_pd(partials.amplitude + p, a0);
+        _mm256_storeu_pd(partials.amplitude + p + 4, a1);
+    }
+    renderPartialsScalar(partials, p, output, frames);
+}
+
+ANANTASOUND_AVX512_DIAGNOSTICS_PUSH
+
+__attribute__((target("avx512f")))
+void renderAVX512(const OscillatorPartials& partials, double* output, size_t frames) {
+    size_t p = 0;
+    for (; p + 16 <= partials.count; p += 16) {
+        __m512d re0 = _mm512_loadu_pd(partials.real + p);
+        __m512d re1 = _mm512_loadu_pd(partials.real + p + 8);
+        __m512d im0 = _mm512_loadu_pd(partials.imag + p);
+        __m512d im1 = _mm512_loadu_pd(partials.imag + p + 8);
+        __m512d a0 = _mm512_loadu_pd(partials.amplitude + p);
+        __m512d a1 = _mm512_loadu_pd(partials.amplitude + p + 8);
+        const __m512d c0 = _mm512_loadu_pd(partials.step_real + p);
+        const __m512d c1 = _mm512_loadu_pd(partials.step_real + p + 8);
+        const __m512d s0 = _mm512_loadu_pd(partials.step_imag + p);
+        const __m512d s1 = _mm512_loadu_pd(partials.step_imag + p + 8);
+        const __m512d d0 = _mm512_loadu_pd(partials.amplitude_step + p);
+        const __m512d d1 = _mm512_loadu_pd(partials.amplitude_step + p + 8);
+
+        for (size_t t = 0; t < frames; ++t) {
+            __m512d acc = _mm512_fmadd_pd(a1, re1, _mm512_mul_pd(a0, re0));
+            output[t] += _mm512_reduce_add_pd(acc);
+
+            __m512d next0 = _mm512_fmsub_pd(re0, c0, _mm512_mul_pd(im0, s0));
+            __m512d next1 = _mm512_fmsub_pd(re1, c1, _mm512_mul_pd(im1, s1));
+            im0 = _mm512_fmadd_pd(re0, s0, _mm512_mul_pd(im0, c0));
+            im1 = _mm512_fmadd_pd(re1, s1, _mm512_mul_pd(im1, c1));
+            re0 = next0;
+            re1 = next1;
+            a0 = _mm512_add_pd(a0, d0);
+            a1 = _mm512_add_pd(a1, d1);
+        }
+
+        _mm512_storeu_pd(partials.real + p, re0);
+        _mm512_storeu_pd(partials.real + p + 8, re1);
+        _mm512_storeu_pd(partials.imag + p, im0);
+        _mm512_storeu_pd(partials.imag + p + 8, im1);
+        _mm512_storeu_pd(partials.amplitude + p, a0);
+        _mm512_storeu_pd(partials.amplitude + p + 8, a1);
+    }
+    renderPartialsScalar(partials, p, output, frames);
+}
+
+ANANTASOUND_AVX512_DIAGNOSTICS_POP
+
+#endif // ANANTASOUND_X86_DISPATCH
+
+const OscillatorKernelTable kScalarKernels = {SIMDLevel::SCALAR, "scalar", renderScalar};
+
+#ifdef ANANTASOUND_X86_DISPATCH
+const OscillatorKernelTable kAVX2Kernels = {SIMDLevel::AVX2, "avx2", renderAVX2};
+const OscillatorKernelTable kAVX512Kernels = {SIMDLevel::AVX512, "avx512", renderAVX512};
+#endif
+
+// Tables compiled into this build, indexed by SIMDLevel
+const OscillatorKernelTable* const kTables[4] = {
+    &kScalarKernels,
+#ifdef ANANTASOUND_X86_DISPATCH
+    &kAVX2Kernels, &kAVX512Kernels,
+#else
+    nullptr, nullptr,
+#endif
+    nullptr
+};
+
+const OscillatorKernelTable& selectBestKernels() {
+    for (SIMDLevel level : {SIMDLevel::AVX512, SIMDLevel::AVX2}) {
+        const OscillatorKernelTable* table = kTables[static_cast<size_t>(level)];
+        if (table && isSIMDLevelSupported(level)) {
+            return *table;
+        }
+    }
+    return kScalarKernels;
+}
+
+} // namespace
+
+const OscillatorKernelTable& getOscillatorKernels(SIMDLevel level) {
+    const OscillatorKernelTable* table = nullptr;
+    if (isSIMDLevelSupported(level)) {
+        table = kTables[static_cast<size_t>(level)];
+    }
+    return table ? *table : kScalarKernels;
+}
+
+const OscillatorKernelTable& getOscillatorKernels() {
+    static const OscillatorKernelTable& best = selectBestKernels();
+    return best;
+}
+
+// OscillatorBank
+OscillatorBank::OscillatorBank(size_t sample_rate, const OscillatorBankOptions& options)
+    : sample_rate_(std::max<size_t>(1, sample_rate))
+    , options_(options)
+    , kernels_(&getOscillatorKernels())
+    , position_(0)
+    , active_(0)
+    , hop_(0)
+    , next_centre_(0)
+    , consumed_(0) {
+
+    if (options_.mode != OscillatorBankMode::INVERSE_FFT) {
+        return;
+    }
+
+    size_t fft_size = 64;
+    while (fft_size < options.fft_size) {
+        fft_size *= 2;
+    }
+    options_.fft_size = fft_size;
+    plan_ = sharedFFTPlan<double>(fft_size);
+    hop_ = fft_size / 4;
+    next_centre_ = hop_;
+    consumed_ = hop_;
+    spectrum_.assign(fft_size, std::complex<double>());
+    overlap_.assign(2 * hop_, 0.0);
+
+    // Transform of the window about the frame centre: each cosine term
+    // shifts the Dirichlet kernel D(u) = e^{iπu/N} sin(πu) / sin(πu/N)
+    const double n = static_cast<double>(fft_size);
+    auto dirichlet = [n](double u) {
+        if (std::abs(u) < 1e-12) {
+            return std::complex<double>(n, 0.0);
+        }
+        return std::polar(std::sin(M_PI * u) / std::sin(M_PI * u / n), M_PI * u / n);
+    };
+    const double reach = static_cast<double>(kLobeHalfWidth + 1);
+    lobe_.resize(2 * (kLobeHalfWidth + 1) * kLobeOversampling + 1);
+    for (size_t i = 0; i < lobe_.size(); ++i) {
+        double offset = -reach + static_cast<double>(i) / kLobeOversampling;
+        std::complex<double> value = kWindow[0] * dirichlet(offset);
+        for (size_t j = 1; j < 4; ++j) {
+            value += 0.5 * kWindow[j] * (dirichlet(offset - j) + dirichlet(offset + j));
+        }
+        lobe_[i] = value;
+    }
+
+    // Triangles overlapping by one hop sum to one; dividing by the analysis
+    // window undoes it over the central half of the frame, where it is large
+    synthesis_window_.resize(2 * hop_);
+    for (size_t m = 0; m < 2 * hop_; ++m) {
+        double centred = static_cast<double>(m) - static_cast<double>(hop_);
+        double window = 0.0;
+        for (size_t j = 0; j < 4; ++j) {
+            window += kWindow[j] * std::cos(2.0 * M_PI * j * centred / n);
+        }
+        double triangle = 1.0 - std::abs(centred) / static_cast<double>(hop_);
+        synthesis_window_[m] = triangle / window;
+    }
+}
+
+void OscillatorBank::resizeSlots(size_t count) {
+    frequency_.resize(count, 0.0);
+    target_amplitude_.resize(count, 0.0);
+    amplitude_.resize(count, 0.0);
+    amplitude_step_.resize(count, 0.0);
+    real_.resize(count, 1.0);
+    imag_.resize(count, 0.0);
+    step_real_.resize(count, 1.0);
+    step_imag_.resize(count, 0.0);
+    phase_.resize(count, 0.0);
+}
+
+void OscillatorBank::setPartials(const double* frequencies, const double* amplitudes, const double* phases,
+                                 size_t count) {
+    if (count > frequency_.size()) {
+        resizeSlots(count);
+    }
+
+    const double rate = static_cast<double>(sample_rate_);
+    const double lead = static_cast<double>(next_centre_) - static_cast<double>(position_);
+    for (size_t i = 0; i < count; ++i) {
+        double omega = 2.0 * M_PI * frequencies[i] / rate;
+        frequency_[i] = frequencies[i];
+        target_amplitude_[i] = amplitudes[i];
+        step_real_[i] = std::cos(omega);
+        step_imag_[i] = std::sin(omega);
+
+        // Only a silent partial takes a new phase; a sounding one keeps its own
+        if (amplitude_[i] == 0.0) {
+            double phase = phases ? phases[i] : 0.0;
+            real_[i] = std::cos(phase);
+            imag_[i] = std::sin(phase);
+            phase_[i] = wrapPhase(phase + omega * lead);
+        }
+    }
+    for (size_t i = count; i < frequency_.size(); ++i) {
+        target_amplitude_[i] = 0.0;
+    }
+    active_ = count;
+}
+
+void OscillatorBank::setFields(const std::vector<QuantumSoundField>& fields) {
+    staged_frequency_.resize(fields.size());
+    staged_amplitude_.resize(fields.size());
+    staged_phase_.resize(fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+        staged_frequency_[i] = fields[i].frequency;
+        staged_amplitude_[i] = std::abs(fields[i].amplitude);
+        staged_phase_[i] = fields[i].phase + std::arg(fields[i].amplitude);
+    }
+    setPartials(staged_frequency_.data(), staged_amplitude_.data(), staged_phase_.data(), fields.size());
+}
+
+void OscillatorBank::setFields(const FieldBuffer& fields) {
+    const double* real = fields.amplitudeReal();
+    const double* imag = fields.amplitudeImag();
+    const double* phases = fields.phases();
+    staged_amplitude_.resize(fields.size());
+    staged_phase_.resize(fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+        staged_amplitude_[i] = std::hypot(real[i], imag[i]);
+        staged_phase_[i] = phases[i] + std::atan2(imag[i], real[i]);
+    }
+    setPartials(fields.frequencies(), staged_amplitude_.data(), staged_phase_.data(), fields.size());
+}
+
+void OscillatorBank::render(double* output, size_t frames) {
+    if (frames == 0) {
+        return;
+    }
+    if (options_.mode == OscillatorBankMode::INVERSE_FFT) {
+        renderInverseFFT(output, frames);
+    } else {
+        renderRecursive(output, frames);
+    }
+    position_ += frames;
+}
+
+void OscillatorBank::render(float* output, size_t frames) {
+    if (scratch_.size() < frames) {
+        scratch_.resize(frames);
+    }
+    render(scratch_.data(), frames);
+    std::transform(scratch_.begin(), scratch_.begin() + frames, output,
+                   [](double sample) { return static_cast<float>(sample); });
+}
+
+void OscillatorBank::renderRecursive(double* output, size_t frames) {
+    std::fill(output, output + frames, 0.0);
+
+    const size_t count = frequency_.size();
+    const double inverse_frames = 1.0 / static_cast<double>(frames);
+    for (size_t i = 0; i < count; ++i) {
+        amplitude_step_[i] = (target_amplitude_[i] - amplitude_[i]) * inverse_frames;
+    }
+
+    OscillatorPartials partials = {real_.data(), imag_.data(), step_real_.data(), step_imag_.data(),
+                                   amplitude_.data(), amplitude_step_.data(), count};
+    kernels_->render(partials, output, frames);
+
+    // Land exactly on the targets and pull the phasors back to unit length
+    // (one Newton step; the drift per block is far below its reach)
+    for (size_t i = 0; i < count; ++i) {
+        amplitude_[i] = target_amplitude_[i];
+        double correction = 1.5 - 0.5 * (real_[i] * real_[i] + imag_[i] * imag_[i]);
+        real_[i] *= correction;
+        imag_[i] *= correction;
+    }
+    resizeSlots(active_);
+}
+
+void OscillatorBank::renderInverseFFT(double* output, size_t frames) {
+    size_t written = 0;
+    while (written < frames) {
+        if (consumed_ == hop_) {
+            synthesizeFrame();
+        }
+        size_t count = std::min(hop_ - consumed_, frames - written);
+        std::copy(overlap_.begin() + consumed_, overlap_.begin() + consumed_ + count, output + written);
+        consumed_ += count;
+        written += count;
+    }
+}
+
+std::complex<double> OscillatorBank::lobe(double offset) const {
+    double position = (offset + static_cast<double>(kLobeHalfWidth + 1)) * kLobeOversampling;
+    size_t index = std::min(static_cast<size_t>(std::max(0.0, position)), lobe_.size() - 2);
+    double fraction = position - static_cast<double>(index);
+    return lobe_[index] + fraction * (lobe_[index + 1] - lobe_[index]);
+}
+
+void OscillatorBank::synthesizeFrame() {
+    const size_t n = options_.fft_size;
+    const long long size = static_cast<long long>(n);
+    const double rate = static_cast<double>(sample_rate_);
+
+    // The older half of the previous frame is final; keep the newer half
+    std::copy(overlap_.begin() + hop_, overlap_.end(), overlap_.begin());
+    std::fill(overlap_.begin() + hop_, overlap_.end(), 0.0);
+    std::fill(spectrum_.begin(), spectrum_.end(), std::complex<double>());
+
+    // Positive-frequency lobe of A cos(ω n' + φ) under the window is
+    // (A / 2) e^{iφ} (-1)^k W(k - bin); the negative-frequency lobe is its
+    // conjugate mirror, which also folds lobes that cross DC or Nyquist
+    const size_t count = frequency_.size();
+    for (size_t i = 0; i < count; ++i) {
+        const double amplitude = target_amplitude_[i];
+        amplitude_[i] = amplitude;
+        const double omega = 2.0 * M_PI * frequency_[i] / rate;
+        if (amplitude != 0.0) {
+            const double bin = frequency_[i] * static_cast<double>(n) / rate;
+            const long long centre = std::llround(bin);
+            const std::complex<double> base = std::polar(0.5 * amplitude, phase_[i]);
+            for (long long k = centre - static_cast<long long>(kLobeHalfWidth);
+                 k <= centre + static_cast<long long>(kLobeHalfWidth); ++k) {
+                std::complex<double> value = base * lobe(static_cast<double>(k) - bin);
+                if (k & 1) {
+                    value = -value;
+                }
+                size_t index = static_cast<size_t>(((k % size) + size) % size);
+                spectrum_[index] += value;
+                spectrum_[(n - index) % n] += std::conj(value);
+            }
+        }
+        phase_[i] = wrapPhase(phase_[i] + omega * static_cast<double>(hop_));
+    }
+
+    plan_->inverse(spectrum_.data());
+
+    const size_t start = n / 2 - hop_;
+    for (size_t m = 0; m < 2 * hop_; ++m) {
+        overlap_[m] += spectrum_[start + m].real() * synthesis_window_[m];
+    }
+    next_centre_ += hop_;
+    consumed_ = 0;
+    resizeSlots(active_);
+}
+
+void OscillatorBank::reset() {
+    active_ = 0;
+    resizeSlots(0);
+    position_ = 0;
+    if (options_.mode == OscillatorBankMode::INVERSE_FFT) {
+        next_centre_ = hop_;
+        consumed_ = hop_;
+        std::fill(overlap_.begin(), overlap_.end(), 0.0);
+    }
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include "fft_engine.hpp"
+#include "spectral_kernels.hpp"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace AnantaSound {
+
+// Sinusoidal partials in structure-of-arrays form. Phasors are unit complex
+// numbers advanced by one complex multiply per sample; amplitudes move by
+// amplitude_step per sample.
+struct OscillatorPartials {
+    double* real;
+    double* imag;
+    const double* step_real;        // cos ω
+    const double* step_imag;        // sin ω
+    double* amplitude;
+    const double* amplitude_step;
+    size_t count;
+};
+
+// Dispatch table of oscillator kernels for one instruction set
+struct OscillatorKernelTable {
+    SIMDLevel level;
+    const char* name;
+
+    // output[t] += Σ_p amplitude_p · real_p for t < frames, advancing every
+    // phasor and amplitude one sample per t. Vector kernels keep a tile of
+    // partials in registers for the whole block, so state is loaded and
+    // stored once per block rather than once per sample.
+    void (*render)(const OscillatorPartials& partials, double* output, size_t frames);
+};
+
+// Best kernel table for the running CPU (detected once, thread-safe)
+const OscillatorKernelTable& getOscillatorKernels();
+
+// Kernel table for a specific level; falls back to SCALAR when unsupported
+const OscillatorKernelTable& getOscillatorKernels(SIMDLevel level);
+
+enum class OscillatorBankMode {
+    RECURSIVE,      // Complex-recurrence oscillators, sample-exact
+    INVERSE_FFT     // Additive synthesis by inverse FFT, for very large partial counts
+};
+
+struct OscillatorBankOptions {
+    OscillatorBankMode mode = OscillatorBankMode::RECURSIVE;
+    size_t fft_size = 512;          // INVERSE_FFT frame (power of two, >= 64); hop = fft_size / 4
+};
+
+// Oscillator bank: renders sinusoidal partials (or QuantumSoundFields) to PCM.
+//
+// Partial i keeps its slot across setPartials calls, and with it its phase:
+// the phase passed in is used only when a partial starts from silence.
+// Frequency changes take effect at a block boundary with the phase
+// carried over, and amplitudes ramp linearly across the next block, so
+// parameter updates are click-free. Partials beyond a shorter update fade
+// out over one block and are then dropped.
+//
+// RECURSIVE costs a few multiply-adds per partial per sample, vectorized
+// across partials. INVERSE_FFT (Rodet & Depalle) writes each partial as
+// the 2 · kLobeHalfWidth + 1 main-lobe bins of a Blackman-Harris window
+// into one spectrum per hop, and overlap-adds inverse transforms under a
+// triangular window. That costs about 11 complex adds per partial per hop
+// instead of one oscillator step per sample. Error is about -80 dB.
+// Parameter changes take effect within one hop, and a new partial fades
+// in over one hop.
+//
+// Not thread-safe: one bank per output stream.
+class OscillatorBank {
+public:
+    static constexpr size_t kLobeHalfWidth = 5;                 // Bins either side of a partial (INVERSE_FFT)
+
+private:
+    static constexpr size_t kLobeOversampling = 512;            // Window transform samples per bin
+
+    size_t sample_rate_;
+    OscillatorBankOptions options_;
+    const OscillatorKernelTable* kernels_;
+    uint64_t position_;                                         // Samples rendered so far
+
+    // Partial slots; [active_, size) fade out during the next block
+    size_t active_;
+    std::vector<double> frequency_;
+    std::vector<double> target_amplitude_;
+    std::vector<double> amplitude_;
+    std::vector<double> amplitude_step_;
+    std::vector<double> real_;                                  // RECURSIVE phasors
+    std::vector<double> imag_;
+    std::vector<double> step_real_;
+    std::vector<double> step_imag_;
+    std::vector<double> phase_;                                 // INVERSE_FFT: phase at the next frame centre
+
+    // INVERSE_FFT
+    std::shared_ptr<const FFTPlan> plan_;
+    size_t hop_;
+    uint64_t next_centre_;                                      // Stream time of the next frame's centre
+    size_t consumed_;                                           // Final samples of overlap_ already emitted
+    std::vector<std::complex<double>> lobe_;                    // Window transform at offsets -K-1 .. K+1 bins
+    std::vector<std::complex<double>> spectrum_;
+    std::vector<double> synthesis_window_;                      // Triangle / analysis window, 2 · hop_
+    std::vector<double> overlap_;                               // 2 · hop_ pending output
+
+    // Staging for setFields and float output
+    std::vector<double> staged_frequency_;
+    std::vector<double> staged_amplitude_;
+    std::vector<double> staged_phase_;
+    std::vector<double> scratch_;
+
+public:
+    explicit OscillatorBank(size_t sample_rate = 44100, const OscillatorBankOptions& options = OscillatorBankOptions());
+
+    // Replace the partial set; null phases start new partials at phase 0
+    void setPartials(const double* frequencies, const double* amplitudes, const double* phases, size_t count);
+
+    // Partials from fields: |amplitude| at the field frequency, starting at
+    // phase + arg(amplitude) (the output of getOutputFields or
+    // generateAllDeviceFields)
+    void setFields(const std::vector<QuantumSoundField>& fields);
+    void setFields(const FieldBuffer& fields);
+
+    // Render the next frames samples (overwrites output)
+    void render(double* output, size_t frames);
+    void render(float* output, size_t frames);
+
+    // Drop all partials and restart the clock
+    void reset();
+
+    size_t getPartialCount() const { return active_; }
+    size_t getSampleRate() const { return sample_rate_; }
+    const OscillatorBankOptions& getOptions() const { return options_; }
+    uint64_t getPosition() const { return position_; }
+
+private:
+    void resizeSlots(size_t count);
+    void renderRecursive(double* output, size_t frames);
+    void renderInverseFFT(double* output, size_t frames);
+    void synthesizeFrame();
+
+    // Window transform at a fractional bin offset (linear interpolation)
+    std::complex<double> lobe(double offset) const;
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,105 @@
+#include "packed_field.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+constexpr double kTwoPi = 2.0 * M_PI;
+constexpr double kMaxCode = 65535.0;
+constexpr double kTurnCodes = 65536.0;      // Codes per full turn for wrapped angles
+
+uint16_t quantizeRange(double value, double scale) {
+    double code = std::round(value * scale);
+    return static_cast<uint16_t>(std::clamp(std::isfinite(code) ? code : 0.0, 0.0, kMaxCode));
+}
+
+uint16_t quantizeTurn(double angle) {
+    if (!std::isfinite(angle)) {
+        return 0;
+    }
+    double wrapped = angle - kTwoPi * std::floor(angle / kTwoPi);
+    // A value just below 2*pi rounds to 65536, which is angle 0 again
+    return static_cast<uint16_t>(static_cast<uint32_t>(std::round(wrapped * (kTurnCodes / kTwoPi))) & 0xFFFF);
+}
+
+double dequantizeTurn(uint16_t code) {
+    return code * (kTwoPi / kTurnCodes);
+}
+
+// Nearest clock sample of timestamp, counted from base_sample
+double sampleOffset(const SampleClock& clock, uint64_t base_sample, SampleClock::TimePoint timestamp) {
+    double seconds = std::chrono::duration<double>(timestamp - clock.getOrigin()).count();
+    return std::round(seconds * clock.getSampleRate()) - static_cast<double>(base_sample);
+}
+
+} // namespace
+
+PackedFieldCodec::PackedFieldCodec(double max_radius, const SampleClock& clock, uint64_t base_sample)
+    : max_radius_(max_radius > 0.0 ? max_radius : 1.0)
+    , clock_(&clock)
+    , base_sample_(base_sample) {
+}
+
+PackedSoundField PackedFieldCodec::pack(const QuantumSoundField& field) const {
+    PackedSoundField packed;
+    packed.amplitude_real = static_cast<float>(field.amplitude.real());
+    packed.amplitude_imag = static_cast<float>(field.amplitude.imag());
+    packed.frequency = static_cast<float>(field.frequency);
+    packed.r = quantizeRange(field.position.r, kMaxCode / max_radius_);
+    packed.theta = quantizeRange(field.position.theta, kMaxCode / M_PI);
+    packed.phi = quantizeTurn(field.position.phi);
+    packed.phase = quantizeTurn(field.phase);
+
+    double sample = sampleOffset(*clock_, base_sample_, field.timestamp);
+    uint32_t tick = static_cast<uint32_t>(std::clamp(std::isfinite(sample) ? sample : 0.0, 0.0,
+                                                     static_cast<double>(kMaxTick)));
+    packed.state_tick = (static_cast<uint32_t>(field.quantum_state) << kTickBits) | tick;
+    return packed;
+}
+
+QuantumSoundField PackedFieldCodec::unpack(const PackedSoundField& packed) const {
+    QuantumSoundField field;
+    field.amplitude = std::complex<double>(packed.amplitude_real, packed.amplitude_imag);
+    field.frequency = packed.frequency;
+    field.phase = dequantizeTurn(packed.phase);
+    field.quantum_state = static_cast<QuantumSoundState>(packed.state_tick >> kTickBits);
+    field.position = SphericalCoord(packed.r * (max_radius_ / kMaxCode), packed.theta * (M_PI / kMaxCode),
+                                    dequantizeTurn(packed.phi));
+    field.timestamp = clock_->tickAt(base_sample_ + (packed.state_tick & kMaxTick)).timestamp;
+    return field;
+}
+
+void PackedFieldCodec::pack(const std::vector<QuantumSoundField>& fields,
+                            std::vector<PackedSoundField>& output) const {
+    output.resize(fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+        output[i] = pack(fields[i]);
+    }
+}
+
+void PackedFieldCodec::unpack(const std::vector<PackedSoundField>& packed,
+                              std::vector<QuantumSoundField>& output) const {
+    output.resize(packed.size());
+    for (size_t i = 0; i < packed.size(); ++i) {
+        output[i] = unpack(packed[i]);
+    }
+}
+
+bool PackedFieldCodec::isRepresentable(const QuantumSoundField& field) const {
+    double sample = sampleOffset(*clock_, base_sample_, field.timestamp);
+    return field.position.r >= 0.0 && field.position.r <= max_radius_ && field.position.theta >= 0.0 &&
+           field.position.theta <= M_PI && field.position.t == 0.0 && field.position.height == 0.0 &&
+           sample >= 0.0 && sample <= static_cast<double>(kMaxTick);
+}
+
+double PackedFieldCodec::getRadiusStep() const {
+    return max_radius_ / kMaxCode;
+}
+
+double PackedFieldCodec::getAngleStep() {
+    return kTwoPi / kTurnCodes;
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include "sample_clock.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace AnantaSound {
+
+// QuantumSoundField in 24 bytes instead of 88, for large field sets kept in
+// memory, written to disk or sent over the wire.
+//   amplitude, frequency   float32 (relative error <= 2^-24)
+//   r                      uint16 over [0, max_radius] of the codec
+//   theta                  uint16 over [0, pi]
+//   phi, phase             uint16 over [0, 2*pi), stored modulo 2*pi
+//   state | tick           top 3 bits: QuantumSoundState; low 29 bits:
+//                          samples since the codec's base tick
+// phase is kept next to the amplitude: fields carry a unit amplitude and
+// their own phase, so it is not arg(amplitude). position.t and height are
+// not stored and unpack as 0.
+//
+// State and clock-aligned timestamps survive a round trip exactly; the
+// other members are rounded to the steps above. Unpacking and packing again
+// reproduces the packed bytes, so repeated conversions never drift.
+struct PackedSoundField {
+    float amplitude_real;
+    float amplitude_imag;
+    float frequency;
+    uint16_t r;
+    uint16_t theta;
+    uint16_t phi;
+    uint16_t phase;
+    uint32_t state_tick;
+};
+
+static_assert(sizeof(PackedSoundField) == 24, "packed field layout is part of the transport format");
+
+// Converts fields to and from PackedSoundField for one radius range and one
+// sample clock. Timestamps are stored as whole samples after base_sample
+// (about three hours at 48 kHz); earlier or later timestamps are clamped to
+// that window. The clock must outlive the codec.
+class PackedFieldCodec {
+public:
+    static constexpr uint32_t kTickBits = 29;
+    static constexpr uint32_t kMaxTick = (1u << kTickBits) - 1;
+
+private:
+    double max_radius_;
+    const SampleClock* clock_;
+    uint64_t base_sample_;
+
+public:
+    PackedFieldCodec(double max_radius, const SampleClock& clock, uint64_t base_sample = 0);
+
+    PackedSoundField pack(const QuantumSoundField& field) const;
+    QuantumSoundField unpack(const PackedSoundField& packed) const;
+
+    // Whole-set conversions; output is resized to match input
+    void pack(const std::vector<QuantumSoundField>& fields, std::vector<PackedSoundField>& output) const;
+    void unpack(const std::vector<PackedSoundField>& packed, std::vector<QuantumSoundField>& output) const;
+
+    // True when pack keeps everything but rounding: radius in range, no t or
+    // height, timestamp inside the tick window
+    bool isRepresentable(const QuantumSoundField& field) const;
+
+    // Quantization steps; rounding moves a member by at most half a step.
+    // getAngleStep is the step of phi and phase (theta's is about half of it)
+    double getRadiusStep() const;
+    static double getAngleStep();
+
+    double getMaxRadius() const { return max_radius_; }
+    uint64_t getBaseSample() const { return base_sample_; }
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+namespace AnantaSound {
+
+// Lock-free latest-value mailbox (triple buffer) from a control thread to a
+// real-time thread.
+// The writer fills its private slot and swaps it with the shared middle slot;
+// the reader swaps the middle slot with its own only when a newer value was
+// published. Neither side ever waits or allocates, intermediate values may be
+// skipped, and the reader always sees a complete value. One writer at a time
+// (callers serialize publish) and one reader thread.
+template<typename T>
+class ParameterMailbox {
+    static_assert(std::is_trivially_copyable<T>::value, "ParameterMailbox holds trivially copyable values");
+
+private:
+    static constexpr unsigned kIndexMask = 0x3;
+    static constexpr unsigned kFresh = 0x4;     // Middle slot holds an unread value
+
+    T slots_[3];
+    std::atomic<unsigned> middle_;
+    unsigned back_;                             // Writer's slot
+    unsigned front_;                            // Reader's slot
+
+public:
+    explicit ParameterMailbox(const T& initial = T())
+        : slots_{initial, initial, initial}, middle_(1), back_(2), front_(0) {
+    }
+
+    ParameterMailbox(const ParameterMailbox&) = delete;
+    ParameterMailbox& operator=(const ParameterMailbox&) = delete;
+
+    // Writer: make value the latest one
+    void publish(const T& value) {
+        slots_[back_] = value;
+        back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    // Reader: the latest published value; stays valid until the next read()
+    const T& read() {
+        if (middle_.load(std::memory_order_relaxed) & kFresh) {
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+        }
+        return slots_[front_];
+    }
+};
+
+} // namespace AnantaSound
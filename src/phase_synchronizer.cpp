@@ -0,0 +1,268 @@
+#include "phase_synchronizer.hpp"
+#include "simd_sincos.hpp"
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+using namespace detail;
+
+constexpr double kTwoPi = 6.28318530717958647693;
+constexpr double kInverseTwoPi = 0.15915494309189533577;
+
+// Couple phases [start, count) with the libm sincos
+std::complex<double> coupleTail(double* phases, size_t start, size_t count,
+                                double sin_mean, double cos_mean, double gain) {
+    double re = 0.0, im = 0.0;
+    for (size_t i = start; i < count; ++i) {
+        double phase = phases[i];
+        phase += gain * (sin_mean * std::cos(phase) - cos_mean * std::sin(phase));
+        phase -= kTwoPi * std::nearbyint(phase * kInverseTwoPi);
+        phases[i] = phase;
+        re += std::cos(phase);
+        im += std::sin(phase);
+    }
+    return std::complex<double>(re, im);
+}
+
+std::complex<double> orderSumTail(const double* phases, size_t start, size_t count) {
+    double re = 0.0, im = 0.0;
+    for (size_t i = start; i < count; ++i) {
+        re += std::cos(phases[i]);
+        im += std::sin(phases[i]);
+    }
+    return std::complex<double>(re, im);
+}
+
+// ---- Scalar reference -------------------------------------------------------
+
+std::complex<double> coupleScalar(double* phases, size_t count,
+                                  double sin_mean, double cos_mean, double gain) {
+    return coupleTail(phases, 0, count, sin_mean, cos_mean, gain);
+}
+
+std::complex<double> orderSumScalar(const double* phases, size_t count) {
+    return orderSumTail(phases, 0, count);
+}
+
+#ifdef ANANTASOUND_X86_DISPATCH
+
+// ---- AVX2 -------------------------------------------------------------------
+
+__attribute__((target("avx2,fma")))
+inline std::complex<double> reduceAVX2(__m256d re, __m256d im) {
+    alignas(32) double lane_re[4], lane_im[4];
+    _mm256_store_pd(lane_re, re);
+    _mm256_store_pd(lane_im, im);
+    return std::complex<double>(lane_re[0] + lane_re[1] + lane_re[2] + lane_re[3],
+                                lane_im[0] + lane_im[1] + lane_im[2] + lane_im[3]);
+}
+
+__attribute__((target("avx2,fma")))
+std::complex<double> coupleAVX2(double* phases, size_t count,
+                                double sin_mean, double cos_mean, double gain) {
+    const __m256d sin_psi = _mm256_set1_pd(sin_mean);
+    const __m256d cos_psi = _mm256_set1_pd(cos_mean);
+    const __m256d k = _mm256_set1_pd(gain);
+    const __m256d two_pi = _mm256_set1_pd(kTwoPi);
+    const __m256d inverse_two_pi = _mm256_set1_pd(kInverseTwoPi);
+    __m256d re = _mm256_setzero_pd();
+    __m256d im = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d phase = _mm256_loadu_pd(phases + i);
+        __m256d sn, c;
+        sincosAVX2(phase, sn, c);
+        phase = _mm256_fmadd_pd(k, _mm256_fmsub_pd(sin_psi, c, _mm256_mul_pd(cos_psi, sn)), phase);
+
+        __m256d turns = _mm256_round_pd(_mm256_mul_pd(phase, inverse_two_pi),
+                                        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        phase = _mm256_fnmadd_pd(turns, two_pi, phase);
+        _mm256_storeu_pd(phases + i, phase);
+
+        sincosAVX2(phase, sn, c);
+        re = _mm256_add_pd(re, c);
+        im = _mm256_add_pd(im, sn);
+    }
+
+    return reduceAVX2(re, im) + coupleTail(phases, i, count, sin_mean, cos_mean, gain);
+}
+
+__attribute__((target("avx2,fma")))
+std::complex<double> orderSumAVX2(const double* phases, size_t count) {
+    __m256d re = _mm256_setzero_pd();
+    __m256d im = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d sn, c;
+        sincosAVX2(_mm256_loadu_pd(phases + i), sn, c);
+        re = _mm256_add_pd(re, c);
+        im = _mm256_add_pd(im, sn);
+    }
+
+    return reduceAVX2(re, im) + orderSumTail(phases, i, count);
+}
+
+// ---- AVX-512 ----------------------------------------------------------------
+
+ANANTASOUND_AVX512_DIAGNOSTICS_PUSH
+
+__attribute__((target("avx512f")))
+std::complex<double> coupleAVX512(double* phases, size_t count,
+                                  double sin_mean, double cos_mean, double gain) {
+    const __m512d sin_psi = _mm512_set1_pd(sin_mean);
+    const __m512d cos_psi = _mm512_set1_pd(cos_mean);
+    const __m512d k = _mm512_set1_pd(gain);
+    const __m512d two_pi = _mm512_set1_pd(kTwoPi);
+    const __m512d inverse_two_pi = _mm512_set1_pd(kInverseTwoPi);
+    __m512d re = _mm512_setzero_pd();
+    __m512d im = _mm512_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d phase = _mm512_loadu_pd(phases + i);
+        __m512d sn, c;
+        sincosAVX512(phase, sn, c);
+        phase = _mm512_fmadd_pd(k, _mm512_fmsub_pd(sin_psi, c, _mm512_mul_pd(cos_psi, sn)), phase);
+
+        __m512d turns = _mm512_roundscale_pd(_mm512_mul_pd(phase, inverse_two_pi),
+                                             _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        phase = _mm512_fnmadd_pd(turns, two_pi, phase);
+        _mm512_storeu_pd(phases + i, phase);
+
+        sincosAVX512(phase, sn, c);
+        re = _mm512_add_pd(re, c);
+        im = _mm512_add_pd(im, sn);
+    }
+
+    std::complex<double> total(_mm512_reduce_add_pd(re), _mm512_reduce_add_pd(im));
+    return total + coupleTail(phases, i, count, sin_mean, cos_mean, gain);
+}
+
+__attribute__((target("avx512f")))
+std::complex<double> orderSumAVX512(const double* phases, size_t count) {
+    __m512d re = _mm512_setzero_pd();
+    __m512d im = _mm512_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d sn, c;
+        sincosAVX512(_mm512_loadu_pd(phases + i), sn, c);
+        re = _mm512_add_pd(re, c);
+        im = _mm512_add_pd(im, sn);
+    }
+
+    std::complex<double> total(_mm512_reduce_add_pd(re), _mm512_reduce_add_pd(im));
+    return total + orderSumTail(phases, i, count);
+}
+
+ANANTASOUND_AVX512_DIAGNOSTICS_POP
+
+#endif // ANANTASOUND_X86_DISPATCH
+
+const PhaseKernelTable kScalarKernels = {
+    SIMDLevel::SCALAR, "scalar", coupleScalar, orderSumScalar
+};
+
+#ifdef ANANTASOUND_X86_DISPATCH
+const PhaseKernelTable kAVX2Kernels = {
+    SIMDLevel::AVX2, "avx2", coupleAVX2, orderSumAVX2
+};
+
+const PhaseKernelTable kAVX512Kernels = {
+    SIMDLevel::AVX512, "avx512", coupleAVX512, orderSumAVX512
+};
+#endif
+
+// Tables compiled into this build, indexed by SIMDLevel; NEON uses the scalar path
+const PhaseKernelTable* const kTables[4] = {
+    &kScalarKernels,
+#ifdef ANANTASOUND_X86_DISPATCH
+    &kAVX2Kernels, &kAVX512Kernels,
+#else
+    nullptr, nullptr,
+#endif
+    nullptr
+};
+
+const PhaseKernelTable& selectBestKernels() {
+    for (SIMDLevel level : {SIMDLevel::AVX512, SIMDLevel::AVX2}) {
+        if (isSIMDLevelSupported(level) && kTables[static_cast<size_t>(level)]) {
+            return *kTables[static_cast<size_t>(level)];
+        }
+    }
+    return kScalarKernels;
+}
+
+} // namespace
+
+const PhaseKernelTable& getPhaseKernels(SIMDLevel level) {
+    const PhaseKernelTable* table = nullptr;
+    if (isSIMDLevelSupported(level)) {
+        table = kTables[static_cast<size_t>(level)];
+    }
+    return table ? *table : kScalarKernels;
+}
+
+const PhaseKernelTable& getPhaseKernels() {
+    static const PhaseKernelTable& best = selectBestKernels();
+    return best;
+}
+
+// KuramotoSynchronizer implementation
+KuramotoSynchronizer::KuramotoSynchronizer(double coupling)
+    : coupling_(coupling), order_sum_(0.0, 0.0), count_(0) {
+}
+
+void KuramotoSynchronizer::reset(const double* phases, size_t count) {
+    order_sum_ = getPhaseKernels().orderSum(phases, count);
+    count_ = count;
+}
+
+void KuramotoSynchronizer::addPhase(double phase) {
+    order_sum_ += std::complex<double>(std::cos(phase), std::sin(phase));
+    ++count_;
+}
+
+void KuramotoSynchronizer::removePhase(double phase) {
+    if (count_ == 0) {
+        return;
+    }
+    if (--count_ == 0) {
+        order_sum_ = 0.0;       // Drop accumulated rounding with the last phase
+    } else {
+        order_sum_ -= std::complex<double>(std::cos(phase), std::sin(phase));
+    }
+}
+
+void KuramotoSynchronizer::updatePhase(double old_phase, double new_phase) {
+    order_sum_ += std::complex<double>(std::cos(new_phase) - std::cos(old_phase),
+                                       std::sin(new_phase) - std::sin(old_phase));
+}
+
+std::complex<double> KuramotoSynchronizer::getOrderParameter() const {
+    return count_ > 0 ? order_sum_ / static_cast<double>(count_) : std::complex<double>(0.0, 0.0);
+}
+
+void KuramotoSynchronizer::step(double* phases, size_t count, double dt) {
+    if (count != count_) {
+        reset(phases, count);
+    }
+    order_sum_ = step(phases, count, order_sum_, dt);
+}
+
+std::complex<double> KuramotoSynchronizer::step(double* phases, size_t count,
+                                                std::complex<double> order_sum, double dt) const {
+    if (count == 0 || coupling_ == 0.0 || dt <= 0.0) {
+        return order_sum;
+    }
+
+    // K · r · sin(ψ - φ) = (K / N) · (Im Z · cos φ - Re Z · sin φ)
+    double gain = coupling_ * dt / static_cast<double>(count);
+    return getPhaseKernels().couple(phases, count, order_sum.imag(), order_sum.real(), gain);
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "spectral_kernels.hpp"
+#include <complex>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Dispatch table of phase coupling kernels for one instruction set
+struct PhaseKernelTable {
+    SIMDLevel level;
+    const char* name;
+
+    // φ_i += gain · sin(ψ - φ_i), expanded as gain · (sin ψ cos φ_i - cos ψ sin φ_i),
+    // then wrapped to [-π, π]. Returns Σ exp(i φ_i) of the updated phases.
+    std::complex<double> (*couple)(double* phases, size_t count,
+                                   double sin_mean, double cos_mean, double gain);
+
+    // Σ exp(i φ_i)
+    std::complex<double> (*orderSum)(const double* phases, size_t count);
+};
+
+// Best kernel table for the running CPU (detected once, thread-safe)
+const PhaseKernelTable& getPhaseKernels();
+
+// Kernel table for a specific level; falls back to SCALAR when unsupported
+const PhaseKernelTable& getPhaseKernels(SIMDLevel level);
+
+// Kuramoto mean-field phase synchronizer.
+// Keeps the running order sum Z = Σ exp(i φ) of the tracked phases; field
+// changes update it in O(1), so the order parameter r·exp(i ψ) = Z / N is
+// always available. step() integrates dφ_i/dt = K · r · sin(ψ - φ_i) over a
+// phase array in place, in one vectorized pass that also produces the new
+// order sum. Not synchronized; one owner per instance.
+class KuramotoSynchronizer {
+private:
+    double coupling_;
+    std::complex<double> order_sum_;
+    size_t count_;
+
+public:
+    explicit KuramotoSynchronizer(double coupling = 1.0);
+
+    void setCoupling(double coupling) { coupling_ = coupling; }
+    double getCoupling() const { return coupling_; }
+
+    // Incremental tracking of the phase set
+    void reset(const double* phases, size_t count);
+    void addPhase(double phase);
+    void removePhase(double phase);
+    void updatePhase(double old_phase, double new_phase);
+
+    // r · exp(i ψ); zero for an empty set
+    std::complex<double> getOrderParameter() const;
+    double getCoherence() const { return std::abs(getOrderParameter()); }       // r
+    double getMeanPhase() const { return std::arg(order_sum_); }               // ψ
+    size_t getPhaseCount() const { return count_; }
+
+    // One Euler step over the tracked phases; a count that differs from the
+    // tracked set re-tracks the array first
+    void step(double* phases, size_t count, double dt);
+
+    // One Euler step with a caller-maintained order sum; returns the new sum
+    std::complex<double> step(double* phases, size_t count,
+                              std::complex<double> order_sum, double dt) const;
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,271 @@
+#include "processing_graph.hpp"
+#include "consciousness_integration.hpp"
+#include "instrumentation.hpp"
+#include "mechanical_devices.hpp"
+#include "qrd_integration.hpp"
+#include "quantum_feedback_system.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace AnantaSound {
+
+ProcessingGraph::ProcessingGraph()
+    : compiled_(true)
+    , scheduler_(nullptr) {
+}
+
+ProcessingGraph::BufferId ProcessingGraph::addBuffer(const std::string& name) {
+    BufferId existing = findBuffer(name);
+    if (existing != npos) {
+        return existing;
+    }
+    Buffer buffer;
+    buffer.name = name;
+    buffers_.push_back(std::move(buffer));
+    compiled_ = false;
+    return buffers_.size() - 1;
+}
+
+ProcessingGraph::BufferId ProcessingGraph::findBuffer(const std::string& name) const {
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+        if (buffers_[i].name == name) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+ProcessingGraph::StageId ProcessingGraph::addStage(const std::string& name, const std::vector<BufferId>& inputs,
+                                                   const std::vector<BufferId>& outputs, StageFunction function) {
+    for (BufferId buffer : inputs) {
+        if (buffer >= buffers_.size()) {
+            std::cerr << "ProcessingGraph: stage '" << name << "' reads unknown buffer " << buffer << std::endl;
+            return npos;
+        }
+    }
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        BufferId buffer = outputs[i];
+        if (buffer >= buffers_.size()) {
+            std::cerr << "ProcessingGraph: stage '" << name << "' writes unknown buffer " << buffer << std::endl;
+            return npos;
+        }
+        if (buffers_[buffer].writer != npos ||
+            std::find(outputs.begin(), outputs.begin() + i, buffer) != outputs.begin() + i) {
+            std::cerr << "ProcessingGraph: buffer '" << buffers_[buffer].name
+                      << "' already has a writer" << std::endl;
+            return npos;
+        }
+        if (std::find(inputs.begin(), inputs.end(), buffer) != inputs.end()) {
+            std::cerr << "ProcessingGraph: stage '" << name << "' reads its own output '"
+                      << buffers_[buffer].name << "'" << std::endl;
+            return npos;
+        }
+    }
+
+    StageId id = stages_.size();
+    for (BufferId buffer : outputs) {
+        buffers_[buffer].writer = id;
+    }
+    Stage stage;
+    stage.name = name;
+    stage.inputs = inputs;
+    stage.outputs = outputs;
+    stage.function = std::move(function);
+    if (scheduler_) {
+        registerStage(stage);
+    }
+    stages_.push_back(std::move(stage));
+    compiled_ = false;
+    return id;
+}
+
+void ProcessingGraph::setStageWork(StageId stage, OptionalWork work) {
+    if (stage >= stages_.size()) {
+        return;
+    }
+    stages_[stage].work = work;
+    if (scheduler_) {
+        scheduler_->setStageWork(stages_[stage].scheduler_stage, work);
+    }
+}
+
+void ProcessingGraph::setDeadlineScheduler(DeadlineScheduler* scheduler) {
+    if (scheduler == scheduler_) {
+        return;
+    }
+    scheduler_ = scheduler;
+    for (Stage& stage : stages_) {
+        stage.scheduler_stage = DeadlineScheduler::npos;
+        if (scheduler_) {
+            registerStage(stage);
+        }
+    }
+}
+
+void ProcessingGraph::registerStage(Stage& stage) {
+    stage.scheduler_stage = scheduler_->addStage(stage.name, stage.work);
+}
+
+bool ProcessingGraph::compile() {
+    levels_.clear();
+
+    // Kahn's algorithm; a stage's level is one past the deepest writer it reads
+    std::vector<size_t> pending(stages_.size(), 0);
+    std::vector<std::vector<StageId>> readers(stages_.size());
+    for (StageId stage = 0; stage < stages_.size(); ++stage) {
+        for (BufferId buffer : stages_[stage].inputs) {
+            StageId writer = buffers_[buffer].writer;
+            if (writer != npos) {
+                readers[writer].push_back(stage);
+                ++pending[stage];
+            }
+        }
+    }
+
+    std::vector<StageId> ready;
+    for (StageId stage = 0; stage < stages_.size(); ++stage) {
+        if (pending[stage] == 0) {
+            ready.push_back(stage);
+        }
+    }
+    size_t ordered = 0;
+    while (!ready.empty()) {
+        std::vector<StageId> next;
+        for (StageId stage : ready) {
+            for (StageId reader : readers[stage]) {
+                if (--pending[reader] == 0) {
+                    next.push_back(reader);
+                }
+            }
+        }
+        ordered += ready.size();
+        levels_.push_back(std::move(ready));
+        ready = std::move(next);
+    }
+
+    if (ordered != stages_.size()) {
+        std::cerr << "ProcessingGraph: dependency cycle among " << stages_.size() - ordered
+                  << " stage(s)" << std::endl;
+        levels_.clear();
+        return false;
+    }
+
+    // Resolve the buffer views once; buffers_ does not change until the next compile
+    for (Stage& stage : stages_) {
+        stage.input_views.clear();
+        stage.output_views.clear();
+        for (BufferId buffer : stage.inputs) {
+            stage.input_views.push_back(&buffers_[buffer].fields);
+        }
+        for (BufferId buffer : stage.outputs) {
+            stage.output_views.push_back(&buffers_[buffer].fields);
+        }
+    }
+    compiled_ = true;
+    return true;
+}
+
+size_t ProcessingGraph::getStageLevel(StageId stage) const {
+    for (size_t level = 0; level < levels_.size(); ++level) {
+        if (std::find(levels_[level].begin(), levels_[level].end(), stage) != levels_[level].end()) {
+            return level;
+        }
+    }
+    return npos;
+}
+
+bool ProcessingGraph::tick(double dt) {
+    return run(dt, nullptr);
+}
+
+bool ProcessingGraph::tick(double dt, ThreadPool& pool) {
+    return run(dt, &pool);
+}
+
+bool ProcessingGraph::run(double dt, ThreadPool* pool) {
+    ANANTASOUND_STAGE_TIMER("graph.run");
+    if (!compiled_ && !compile()) {
+        return false;
+    }
+    if (scheduler_) {
+        scheduler_->beginTick();
+    }
+
+    for (const auto& level : levels_) {
+        auto run_stages = [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i) {
+                Stage& stage = stages_[level[i]];
+                StageIO io(stage.input_views, stage.output_views, dt, pool);
+                if (scheduler_) {
+                    scheduler_->runStage(stage.scheduler_stage, [&]() { stage.function(io); });
+                } else {
+                    stage.function(io);
+                }
+            }
+        };
+        if (pool && level.size() > 1) {
+            pool->parallelFor(level.size(), 1, run_stages);
+        } else {
+            run_stages(0, level.size(), 0);
+        }
+    }
+
+    if (scheduler_) {
+        scheduler_->endTick();
+    }
+    return true;
+}
+
+// Stage adapters
+ProcessingGraph::StageFunction makeCoreStage(AnantaSoundCore& core) {
+    return [&core](ProcessingGraph::StageIO& io) {
+        for (size_t i = 0; i < io.inputCount(); ++i) {
+            if (!io.input(i).empty()) {
+                core.processSoundFields(io.input(i));
+            }
+        }
+        if (io.pool()) {
+            core.update(io.dt(), *io.pool());
+        } else {
+            core.update(io.dt());
+        }
+        if (io.outputCount() > 0) {
+            core.getOutputFields(io.output(0));
+        }
+    };
+}
+
+ProcessingGraph::StageFunction makeDeviceStage(MechanicalDeviceManager& manager) {
+    return [&manager](ProcessingGraph::StageIO& io) {
+        if (io.pool()) {
+            manager.generateAllDeviceFields(io.output(0), *io.pool());
+        } else {
+            manager.generateAllDeviceFields(io.output(0));
+        }
+    };
+}
+
+ProcessingGraph::StageFunction makeFeedbackStage(const QuantumFeedbackSystem& feedback) {
+    return [&feedback](ProcessingGraph::StageIO& io) {
+        if (io.pool()) {
+            feedback.processFeedback(io.input(0), io.input(1), io.output(0), *io.pool());
+        } else {
+            feedback.processFeedback(io.input(0), io.input(1), io.output(0));
+        }
+    };
+}
+
+ProcessingGraph::StageFunction makeQRDStage(QRDIntegration& qrd) {
+    return [&qrd](ProcessingGraph::StageIO& io) {
+        qrd.updateQRDResonance(io.input(0));
+    };
+}
+
+ProcessingGraph::StageFunction makeConsciousnessStage(ConsciousnessIntegration& consciousness) {
+    return [&consciousness](ProcessingGraph::StageIO& io) {
+        consciousness.ingest(io.input(0));
+    };
+}
+
+} // namespace AnantaSound
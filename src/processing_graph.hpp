@@ -0,0 +1,153 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include "deadline_scheduler.hpp"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace AnantaSound {
+
+class ThreadPool;
+class QuantumFeedbackSystem;
+class QRDIntegration;
+class MechanicalDeviceManager;
+class ConsciousnessIntegration;
+
+// Per-tick processing graph over shared field buffers.
+// The graph owns named buffers; every stage declares the buffers it reads
+// and the ones it writes, and each buffer has at most one writer. Buffers
+// nobody writes are external inputs, filled by the caller between ticks.
+// Stages are ordered into levels by their data dependencies: a stage runs
+// after the writers of all of its inputs, and the stages of one level are
+// independent, so tick(dt, pool) runs each level in parallel. Buffers live
+// across ticks and are handed to stages by reference, so a steady-state
+// tick reuses their capacity instead of copying fields between hops.
+// Stages of one level must not share mutable state other than their own
+// outputs; tick is not reentrant.
+//
+// With a DeadlineScheduler attached, every tick is timed against its budget
+// and stages marked optional (setStageWork) are shed while the scheduler's
+// degradation level covers them or their estimated cost no longer fits the
+// tick. A shed stage leaves its outputs as the previous tick wrote them.
+class ProcessingGraph {
+public:
+    using BufferId = size_t;
+    using StageId = size_t;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // A stage's view of the graph during one tick
+    class StageIO {
+    private:
+        const std::vector<const std::vector<QuantumSoundField>*>& inputs_;
+        const std::vector<std::vector<QuantumSoundField>*>& outputs_;
+        double dt_;
+        ThreadPool* pool_;
+
+    public:
+        StageIO(const std::vector<const std::vector<QuantumSoundField>*>& inputs,
+                const std::vector<std::vector<QuantumSoundField>*>& outputs,
+                double dt, ThreadPool* pool)
+            : inputs_(inputs), outputs_(outputs), dt_(dt), pool_(pool) {}
+
+        size_t inputCount() const { return inputs_.size(); }
+        size_t outputCount() const { return outputs_.size(); }
+        const std::vector<QuantumSoundField>& input(size_t index) const { return *inputs_[index]; }
+        std::vector<QuantumSoundField>& output(size_t index) const { return *outputs_[index]; }
+        double dt() const { return dt_; }
+        ThreadPool* pool() const { return pool_; }      // nullptr in a serial tick
+    };
+
+    using StageFunction = std::function<void(StageIO& io)>;
+
+private:
+    struct Buffer {
+        std::string name;
+        std::vector<QuantumSoundField> fields;
+        StageId writer = npos;
+    };
+
+    struct Stage {
+        std::string name;
+        std::vector<BufferId> inputs;
+        std::vector<BufferId> outputs;
+        StageFunction function;
+        OptionalWork work = OptionalWork::MANDATORY;
+        DeadlineScheduler::StageId scheduler_stage = DeadlineScheduler::npos;
+        std::vector<const std::vector<QuantumSoundField>*> input_views;
+        std::vector<std::vector<QuantumSoundField>*> output_views;
+    };
+
+    std::vector<Buffer> buffers_;
+    std::vector<Stage> stages_;
+    std::vector<std::vector<StageId>> levels_;
+    bool compiled_;
+    DeadlineScheduler* scheduler_;
+
+public:
+    ProcessingGraph();
+
+    ProcessingGraph(const ProcessingGraph&) = delete;
+    ProcessingGraph& operator=(const ProcessingGraph&) = delete;
+
+    // Buffer names are unique; an existing name returns its id. Adding a
+    // buffer may invalidate references returned by getBuffer
+    BufferId addBuffer(const std::string& name);
+    BufferId findBuffer(const std::string& name) const;     // npos if absent
+    size_t getBufferCount() const { return buffers_.size(); }
+    std::vector<QuantumSoundField>& getBuffer(BufferId buffer) { return buffers_[buffer].fields; }
+    const std::vector<QuantumSoundField>& getBuffer(BufferId buffer) const { return buffers_[buffer].fields; }
+
+    // npos (with a message) for an unknown buffer, a buffer that already has
+    // a writer, or a stage reading its own output
+    StageId addStage(const std::string& name, const std::vector<BufferId>& inputs,
+                     const std::vector<BufferId>& outputs, StageFunction function);
+    size_t getStageCount() const { return stages_.size(); }
+    const std::string& getStageName(StageId stage) const { return stages_[stage].name; }
+
+    // Mark a stage as work the scheduler may shed; stages are mandatory by default
+    void setStageWork(StageId stage, OptionalWork work);
+    OptionalWork getStageWork(StageId stage) const { return stages_[stage].work; }
+
+    // Time ticks and shed optional stages (nullptr detaches). The scheduler
+    // must outlive the graph or be detached first; the graph registers its
+    // stages with it
+    void setDeadlineScheduler(DeadlineScheduler* scheduler);
+    DeadlineScheduler* getDeadlineScheduler() const { return scheduler_; }
+
+    // Order the stages into levels; false (with a message) for a dependency
+    // cycle. tick compiles on demand after the graph changed.
+    bool compile();
+    size_t getLevelCount() const { return levels_.size(); }
+    size_t getStageLevel(StageId stage) const;      // npos before a successful compile
+
+    // Run every stage once, level by level; false if the graph does not compile
+    bool tick(double dt);
+    bool tick(double dt, ThreadPool& pool);
+
+private:
+    bool run(double dt, ThreadPool* pool);
+    void registerStage(Stage& stage);
+};
+
+// Stage adapters for the library's components. Every adapter keeps a
+// reference to its component, which must outlive the graph.
+
+// Inputs (any number) are submitted as new sound fields, the core is updated
+// by dt, and output 0 (if declared) receives the core's output fields
+ProcessingGraph::StageFunction makeCoreStage(AnantaSoundCore& core);
+
+// Output 0 receives the fields of all devices
+ProcessingGraph::StageFunction makeDeviceStage(MechanicalDeviceManager& manager);
+
+// Output 0 = input 0 (fields) processed against input 1 (feedback fields)
+ProcessingGraph::StageFunction makeFeedbackStage(const QuantumFeedbackSystem& feedback);
+
+// Sinks: update the QRD resonance / ingest into consciousness from input 0.
+// Under a DeadlineScheduler these are typically marked
+// OptionalWork::RESONANCE_DETECTION and OptionalWork::CONSCIOUSNESS
+ProcessingGraph::StageFunction makeQRDStage(QRDIntegration& qrd);
+ProcessingGraph::StageFunction makeConsciousnessStage(ConsciousnessIntegration& consciousness);
+
+} // namespace AnantaSound
@@ -1,15 +1,29 @@
 #include "qrd_integration.hpp"
+#include "feedback_kernels.hpp"
+#include "harmonic_bank.hpp"
 #include <algorithm>
 #include <cmath>
+#include <iostream>
 #include <random>
 
 namespace AnantaSound {
 
+namespace {
+
+// Frequency difference at which the frequency resonance halves, Hz
+constexpr double kResonanceBandwidth = 50.0;
+
+} // namespace
+
 QRDIntegration::QRDIntegration()
     : qrd_active_(false)
     , resonance_frequency_(432.0)
     , resonance_amplitude_(1.0)
     , quantum_entanglement_enabled_(true)
+    , entangled_capacity_(kDefaultEntangledCapacity)
+    , entangled_oldest_(0)
+    , entangled_count_(0)
+    , entanglement_window_(0)
     , last_resonance_update_(std::chrono::high_resolution_clock::now()) {
     
     // Initialize QRD field
@@ -60,30 +74,50 @@ void QRDIntegration::updateQRDResonance(const std::vector<QuantumSoundField>& so
     last_resonance_update_ = now;
 }
 
+void QRDIntegration::updateQRDResonance(const FieldBuffer& sound_fields) {
+    if (!qrd_active_) {
+        return;
+    }
+    
+    auto now = std::chrono::high_resolution_clock::now();
+    auto dt = std::chrono::duration<double>(now - last_resonance_update_).count();
+    updateQRDField(calculateResonanceStrength(sound_fields), dt);
+    last_resonance_update_ = now;
+}
+
 double QRDIntegration::calculateResonanceStrength(const std::vector<QuantumSoundField>& sound_fields) const {
     if (sound_fields.empty()) {
         return 0.0;
     }
     
-    double total_resonance = 0.0;
+    // Gather the three factors' inputs into reusable contiguous arrays
+    thread_local std::vector<double> frequency, phase, amplitude;
+    const size_t count = sound_fields.size();
+    frequency.resize(count);
+    phase.resize(count);
+    amplitude.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        frequency[i] = sound_fields[i].frequency;
+        phase[i] = sound_fields[i].phase;
+        amplitude[i] = sound_fields[i].amplitude.real();
+    }
     
-    for (const auto& field : sound_fields) {
-        // Calculate frequency resonance
-        double freq_diff = std::abs(field.frequency - resonance_frequency_);
-        double freq_resonance = 1.0 / (1.0 + freq_diff / 50.0); // 50 Hz bandwidth
-        
-        // Calculate phase resonance
-        double phase_diff = std::abs(field.phase - qrd_field_.phase);
-        double phase_resonance = std::cos(phase_diff);
-        
-        // Calculate amplitude resonance
-        double amp_resonance = std::min(field.amplitude.real() / resonance_amplitude_, 1.0);
-        
-        // Combine resonance factors
-        double field_resonance = (freq_resonance + phase_resonance + amp_resonance) / 3.0;
-        total_resonance += field_resonance;
+    double total_resonance = getFeedbackKernels().resonanceSum(
+        frequency.data(), phase.data(), amplitude.data(), count,
+        resonance_frequency_, qrd_field_.phase, resonance_amplitude_, kResonanceBandwidth);
+    return total_resonance / count;
+}
+
+double QRDIntegration::calculateResonanceStrength(const FieldBuffer& sound_fields) const {
+    if (sound_fields.empty()) {
+        return 0.0;
     }
     
+    // Per field: mean of frequency (50 Hz bandwidth), phase and amplitude resonance
+    double total_resonance = getFeedbackKernels().resonanceSum(
+        sound_fields.frequencies(), sound_fields.phases(), sound_fields.amplitudeReal(),
+        sound_fields.size(), resonance_frequency_, qrd_field_.phase, resonance_amplitude_,
+        kResonanceBandwidth);
     return total_resonance / sound_fields.size();
 }
 
@@ -123,33 +157,45 @@ std::vector<QuantumSoundField> QRDIntegration::generateResonanceFields(const Sph
         return {};
     }
     
-    std::vector<QuantumSoundField> resonance_fields;
-    resonance_fields.reserve(count);
+    std::vector<QuantumSoundField> resonance_fields(count);
+    writeResonanceFields(position, count, resonance_fields.data());
+    return resonance_fields;
+}
+
+FieldVector QRDIntegration::generateResonanceFields(const SphericalCoord& position, size_t count,
+                                                    FieldArena& arena) const {
+    FieldVector resonance_fields(&arena);
+    if (qrd_active_) {
+        resonance_fields.resize(count);
+        writeResonanceFields(position, count, resonance_fields.data());
+    }
+    return resonance_fields;
+}
+
+void QRDIntegration::writeResonanceFields(const SphericalCoord& position, size_t count,
+                                          QuantumSoundField* output) const {
+    // Harmonic h: frequency h·f, amplitude A/h, phase h·φ of the QRD field
+    HarmonicSeries series;
+    series.frequency = resonance_frequency_;
+    series.amplitude = resonance_amplitude_;
+    series.phase = qrd_field_.phase;
+    thread_local std::vector<double> frequency, amplitude, phase;
+    frequency.resize(count);
+    amplitude.resize(count);
+    phase.resize(count);
+    HarmonicBank().generate(series, count, {frequency.data(), amplitude.data(), phase.data(), nullptr});
     
-    // Generate harmonically related resonance fields
+    // All harmonics are stamped with one tick
+    auto timestamp = SampleClock::shared().now();
     for (size_t i = 0; i < count; ++i) {
-        QuantumSoundField field;
-        
-        // Harmonic frequency
-        double harmonic_freq = resonance_frequency_ * (i + 1);
-        
-        // Harmonic amplitude (decreasing with harmonic number)
-        double harmonic_amp = resonance_amplitude_ / (i + 1);
-        
-        // Harmonic phase
-        double harmonic_phase = qrd_field_.phase * (i + 1);
-        
-        field.amplitude = std::complex<double>(harmonic_amp, 0.0);
-        field.phase = harmonic_phase;
-        field.frequency = harmonic_freq;
+        QuantumSoundField& field = output[i];
+        field.amplitude = std::complex<double>(amplitude[i], 0.0);
+        field.phase = phase[i];
+        field.frequency = frequency[i];
         field.quantum_state = qrd_field_.quantum_state;
         field.position = position;
-        field.timestamp = std::chrono::high_resolution_clock::now();
-        
-        resonance_fields.push_back(field);
+        field.timestamp = timestamp;
     }
-    
-    return resonance_fields;
 }
 
 void QRDIntegration::createQuantumEntanglement(const std::vector<QuantumSoundField>& fields) {
@@ -157,21 +203,114 @@ void QRDIntegration::createQuantumEntanglement(const std::vector<QuantumSoundFie
         return;
     }
     
-    // Create entanglement between QRD field and sound fields
+    auto now = SampleClock::shared().now();
+    expireEntangledFields(now);
     for (const auto& field : fields) {
-        // Calculate entanglement strength based on resonance
-        double freq_diff = std::abs(field.frequency - resonance_frequency_);
-        double entanglement_strength = 1.0 / (1.0 + freq_diff / 100.0);
-        
-        if (entanglement_strength > 0.7) {
-            // Mark fields as entangled
-            entangled_fields_.push_back(field);
-        }
+        entangle(field, InterferenceField::SourceHandle(), now);
+    }
+}
+
+void QRDIntegration::createQuantumEntanglement(const std::vector<QuantumSoundField>& fields,
+                                               const std::vector<InterferenceField::SourceHandle>& sources) {
+    if (sources.size() != fields.size()) {
+        std::cerr << "QRDIntegration: " << sources.size() << " source handles for " << fields.size() << " fields" << std::endl;
+        return;
+    }
+    if (!quantum_entanglement_enabled_ || fields.size() < 2) {
+        return;
+    }
+    
+    auto now = SampleClock::shared().now();
+    expireEntangledFields(now);
+    for (size_t i = 0; i < fields.size(); ++i) {
+        entangle(fields[i], sources[i], now);
     }
 }
 
-std::vector<QuantumSoundField> QRDIntegration::getEntangledFields() const {
-    return entangled_fields_;
+void QRDIntegration::entangle(const QuantumSoundField& field, InterferenceField::SourceHandle source,
+                              SampleClock::TimePoint now) {
+    // Calculate entanglement strength based on resonance
+    double freq_diff = std::abs(field.frequency - resonance_frequency_);
+    double entanglement_strength = 1.0 / (1.0 + freq_diff / 100.0);
+    if (entanglement_strength <= 0.7) {
+        return;
+    }
+    
+    // Append to the ring; once it holds the capacity, the oldest record is replaced
+    EntangledField record{source, now, field.frequency, static_cast<float>(entanglement_strength)};
+    size_t storage = entangled_fields_.size();
+    if (entangled_count_ < storage) {
+        entangled_fields_[(entangled_oldest_ + entangled_count_) % storage] = record;
+        ++entangled_count_;
+    } else if (storage < entangled_capacity_) {
+        linearizeEntangledFields();
+        entangled_fields_.push_back(record);
+        ++entangled_count_;
+    } else {
+        entangled_fields_[entangled_oldest_] = record;
+        entangled_oldest_ = (entangled_oldest_ + 1) % storage;
+    }
+}
+
+EntangledFieldView QRDIntegration::getEntangledFields() const {
+    return EntangledFieldView(entangled_fields_.data(), entangled_fields_.size(), entangled_oldest_, entangled_count_);
+}
+
+void QRDIntegration::linearizeEntangledFields() {
+    if (entangled_oldest_ == 0 && entangled_count_ == entangled_fields_.size()) {
+        return;
+    }
+    std::rotate(entangled_fields_.begin(), entangled_fields_.begin() + entangled_oldest_, entangled_fields_.end());
+    entangled_fields_.resize(entangled_count_);
+    entangled_oldest_ = 0;
+}
+
+void QRDIntegration::setEntangledCapacity(size_t capacity) {
+    capacity = std::max<size_t>(capacity, 1);
+    linearizeEntangledFields();
+    if (entangled_count_ > capacity) {
+        entangled_fields_.erase(entangled_fields_.begin(), entangled_fields_.end() - capacity);
+        entangled_count_ = capacity;
+    }
+    entangled_fields_.shrink_to_fit();
+    entangled_capacity_ = capacity;
+}
+
+void QRDIntegration::setEntanglementWindow(std::chrono::nanoseconds window) {
+    entanglement_window_ = std::max(window, std::chrono::nanoseconds(0));
+}
+
+size_t QRDIntegration::expireEntangledFields() {
+    return expireEntangledFields(SampleClock::shared().now());
+}
+
+size_t QRDIntegration::expireEntangledFields(SampleClock::TimePoint now) {
+    if (entanglement_window_.count() == 0) {
+        return 0;
+    }
+    
+    // Records are in creation order, so the expired ones are the oldest
+    size_t expired = 0;
+    while (entangled_count_ > 0 && now - entangled_fields_[entangled_oldest_].created > entanglement_window_) {
+        entangled_oldest_ = (entangled_oldest_ + 1) % entangled_fields_.size();
+        --entangled_count_;
+        ++expired;
+    }
+    if (entangled_count_ == 0) {
+        entangled_oldest_ = 0;
+    }
+    return expired;
+}
+
+size_t QRDIntegration::pruneEntangledFields(const InterferenceField& field) {
+    linearizeEntangledFields();
+    auto stale = std::remove_if(entangled_fields_.begin(), entangled_fields_.end(), [&](const EntangledField& record) {
+        return record.hasSource() && !field.containsSource(record.source);
+    });
+    size_t pruned = static_cast<size_t>(entangled_fields_.end() - stale);
+    entangled_fields_.erase(stale, entangled_fields_.end());
+    entangled_count_ = entangled_fields_.size();
+    return pruned;
 }
 
 const QuantumSoundField& QRDIntegration::getQRDField() const {
@@ -204,25 +343,26 @@ void QRDIntegration::setQuantumEntanglementEnabled(bool enabled) {
     quantum_entanglement_enabled_ = enabled;
     if (!enabled) {
         entangled_fields_.clear();
+        entangled_fields_.shrink_to_fit();
+        entangled_oldest_ = 0;
+        entangled_count_ = 0;
     }
 }
 
 std::vector<double> QRDIntegration::getResonanceSpectrum() const {
-    std::vector<double> spectrum;
-    
     if (!qrd_active_) {
-        return spectrum;
+        return {};
     }
     
-    // Generate resonance spectrum with harmonics
-    for (int i = 1; i <= 10; ++i) {
-        double harmonic_freq = resonance_frequency_ * i;
-        double harmonic_amp = resonance_amplitude_ / i;
-        
-        // Apply resonance envelope
-        double envelope = std::exp(-std::pow((harmonic_freq - resonance_frequency_) / 100.0, 2));
-        spectrum.push_back(harmonic_amp * envelope);
-    }
+    // Ten harmonics A/h under a Gaussian resonance envelope 100 Hz wide
+    HarmonicSeries series;
+    series.frequency = resonance_frequency_;
+    series.amplitude = resonance_amplitude_;
+    series.envelope_width = 100.0;
+    std::vector<double> spectrum(10);
+    HarmonicBuffers output;
+    output.amplitude = spectrum.data();
+    HarmonicBank().generate(series, spectrum.size(), output);
     
     return spectrum;
 }
@@ -6,15 +6,52 @@
 
 namespace AnantaSound {
 
+// Compact record of a field entangled with the QRD: a handle into the
+// InterferenceField that owns the source (an invalid handle for fields
+// entangled without one) plus what the QRD needs of it
+struct EntangledField {
+    InterferenceField::SourceHandle source;
+    SampleClock::TimePoint created;     // SampleClock time of the entanglement
+    double frequency;
+    float strength;                     // Entanglement strength, (0.7, 1]
+
+    bool hasSource() const { return source.slot != UINT32_MAX; }
+};
+
+// Read-only view of the entangled fields, oldest first. Valid until the
+// next call that changes the entangled set
+class EntangledFieldView {
+private:
+    const EntangledField* ring_;
+    size_t ring_size_;
+    size_t oldest_;
+    size_t count_;
+
+public:
+    EntangledFieldView(const EntangledField* ring, size_t ring_size, size_t oldest, size_t count)
+        : ring_(ring), ring_size_(ring_size), oldest_(oldest), count_(count) {}
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    const EntangledField& operator[](size_t index) const { return ring_[(oldest_ + index) % ring_size_]; }
+};
+
 // QRD Integration System
 class QRDIntegration {
+public:
+    static constexpr size_t kDefaultEntangledCapacity = 1024;
+
 private:
     bool qrd_active_;
     double resonance_frequency_;
     double resonance_amplitude_;
     bool quantum_entanglement_enabled_;
     QuantumSoundField qrd_field_;
-    std::vector<QuantumSoundField> entangled_fields_;
+    std::vector<EntangledField> entangled_fields_;      // Ring of the most recent entangled fields
+    size_t entangled_capacity_;
+    size_t entangled_oldest_;
+    size_t entangled_count_;
+    std::chrono::nanoseconds entanglement_window_;      // Zero: no expiry
     std::chrono::high_resolution_clock::time_point last_resonance_update_;
 
 public:
@@ -26,16 +63,42 @@ public:
     bool isQRDActive() const;
     
     // Resonance Management
+    // Resonance strength is one SIMD pass over contiguous frequency, phase and
+    // amplitude arrays; the FieldBuffer overloads stream its arrays without a copy
     void updateQRDResonance(const std::vector<QuantumSoundField>& sound_fields);
+    void updateQRDResonance(const FieldBuffer& sound_fields);
     double calculateResonanceStrength(const std::vector<QuantumSoundField>& sound_fields) const;
+    double calculateResonanceStrength(const FieldBuffer& sound_fields) const;
     void updateQRDField(double resonance_strength, double dt);
     
     // Field Generation
     std::vector<QuantumSoundField> generateResonanceFields(const SphericalCoord& position, size_t count) const;
+    FieldVector generateResonanceFields(const SphericalCoord& position, size_t count, FieldArena& arena) const;
     
-    // Quantum Entanglement
+    // Quantum Entanglement. Entangled fields are kept as compact records
+    // (EntangledField), not copies: with the sources' handles the records
+    // refer to the fields in their InterferenceField. Only the most recent
+    // getEntangledCapacity() records are kept, the oldest being overwritten,
+    // and with an entanglement window records older than the window expire
+    // on the next entanglement or expireEntangledFields call, so the set
+    // stays bounded over long runs. Shrinking the capacity keeps the newest.
     void createQuantumEntanglement(const std::vector<QuantumSoundField>& fields);
-    std::vector<QuantumSoundField> getEntangledFields() const;
+    void createQuantumEntanglement(const std::vector<QuantumSoundField>& fields,
+                                   const std::vector<InterferenceField::SourceHandle>& sources);  // Parallel to fields
+    EntangledFieldView getEntangledFields() const;
+    size_t getEntangledFieldCount() const { return entangled_count_; }
+    void setEntangledCapacity(size_t capacity);     // At least 1
+    size_t getEntangledCapacity() const { return entangled_capacity_; }
+    void setEntanglementWindow(std::chrono::nanoseconds window);
+    std::chrono::nanoseconds getEntanglementWindow() const { return entanglement_window_; }
+    
+    // Drop records older than the window at `now`; returns how many expired
+    size_t expireEntangledFields();
+    size_t expireEntangledFields(SampleClock::TimePoint now);
+    
+    // Drop records whose source has been removed from `field`; records
+    // without a source are kept. Returns how many were dropped
+    size_t pruneEntangledFields(const InterferenceField& field);
     
     // Getters
     const QuantumSoundField& getQRDField() const;
@@ -49,6 +112,12 @@ public:
     
     // Analysis
     std::vector<double> getResonanceSpectrum() const;
+
+private:
+    // Write `count` harmonics of the QRD field into the caller's buffer
+    void writeResonanceFields(const SphericalCoord& position, size_t count, QuantumSoundField* output) const;
+    void entangle(const QuantumSoundField& field, InterferenceField::SourceHandle source, SampleClock::TimePoint now);
+    void linearizeEntangledFields();    // Oldest record first at index 0, storage trimmed to the count
 };
 
 } // namespace AnantaSound
@@ -1,10 +1,77 @@
 #include "quantum_feedback_system.hpp"
+#include "feedback_kernels.hpp"
+#include "instrumentation.hpp"
+#include "quantum_noise.hpp"
+#include "thread_pool.hpp"
 #include <cmath>
-#include <random>
 #include <algorithm>
 
 namespace AnantaSound {
 
+namespace {
+
+// State correlation lookup: identical states correlate fully, all other pairs weakly
+struct StateCorrelationTable {
+    double values[kQuantumStateCount][kQuantumStateCount];
+
+    constexpr StateCorrelationTable() : values() {
+        for (size_t a = 0; a < kQuantumStateCount; ++a) {
+            for (size_t b = 0; b < kQuantumStateCount; ++b) {
+                values[a][b] = a == b ? 1.0 : 0.3;
+            }
+        }
+    }
+};
+constexpr StateCorrelationTable kStateCorrelation;
+
+double stateCorrelation(QuantumSoundState a, QuantumSoundState b) {
+    return kStateCorrelation.values[static_cast<size_t>(a)][static_cast<size_t>(b)];
+}
+
+// Feedback fields of one batch in structure-of-arrays form, plus one row of
+// state correlations per input state (kQuantumStateCount x count)
+struct FeedbackBatch {
+    std::vector<double> cos_phase;
+    std::vector<double> sin_phase;
+    std::vector<double> frequency;
+    std::vector<double> phasor_real;
+    std::vector<double> phasor_imag;
+    std::vector<double> state_rows;
+
+    void prepare(const std::vector<QuantumSoundField>& fields) {
+        size_t count = fields.size();
+        cos_phase.resize(count);
+        sin_phase.resize(count);
+        frequency.resize(count);
+        phasor_real.resize(count);
+        phasor_imag.resize(count);
+        state_rows.resize(kQuantumStateCount * count);
+        for (size_t j = 0; j < count; ++j) {
+            const auto& field = fields[j];
+            std::complex<double> rotation = std::exp(std::complex<double>(0.0, field.phase));
+            std::complex<double> phasor = field.amplitude * rotation;
+            cos_phase[j] = rotation.real();
+            sin_phase[j] = rotation.imag();
+            frequency[j] = field.frequency;
+            phasor_real[j] = phasor.real();
+            phasor_imag[j] = phasor.imag();
+            for (size_t state = 0; state < kQuantumStateCount; ++state) {
+                state_rows[state * count + j] = kStateCorrelation.values[state][static_cast<size_t>(field.quantum_state)];
+            }
+        }
+    }
+
+    FeedbackSources sources() const {
+        return {cos_phase.data(), sin_phase.data(), frequency.data(),
+                phasor_real.data(), phasor_imag.data(), cos_phase.size()};
+    }
+};
+
+// Inputs per parallel chunk
+constexpr size_t kFeedbackGrain = 64;
+
+} // namespace
+
 // QuantumFeedbackSystem implementation
 QuantumFeedbackSystem::QuantumFeedbackSystem(double feedback_gain, double quantum_threshold)
     : feedback_gain_(feedback_gain), quantum_threshold_(quantum_threshold), 
@@ -12,38 +79,57 @@ QuantumFeedbackSystem::QuantumFeedbackSystem(double feedback_gain, double quantu
 }
 
 void QuantumFeedbackSystem::setFeedbackGain(double gain) {
-    feedback_gain_ = std::clamp(gain, 0.0, 10.0);
+    feedback_gain_.store(std::clamp(gain, 0.0, 10.0), std::memory_order_relaxed);
 }
 
 double QuantumFeedbackSystem::getFeedbackGain() const {
-    return feedback_gain_;
+    return feedback_gain_.load(std::memory_order_relaxed);
 }
 
 void QuantumFeedbackSystem::setQuantumThreshold(double threshold) {
-    quantum_threshold_ = std::clamp(threshold, 0.0, 1.0);
+    quantum_threshold_.store(std::clamp(threshold, 0.0, 1.0), std::memory_order_relaxed);
 }
 
 double QuantumFeedbackSystem::getQuantumThreshold() const {
-    return quantum_threshold_;
+    return quantum_threshold_.load(std::memory_order_relaxed);
 }
 
 void QuantumFeedbackSystem::setFeedbackEnabled(bool enabled) {
-    feedback_enabled_ = enabled;
+    feedback_enabled_.store(enabled, std::memory_order_relaxed);
 }
 
 void QuantumFeedbackSystem::setQuantumMode(bool enabled) {
-    quantum_mode_ = enabled;
+    quantum_mode_.store(enabled, std::memory_order_relaxed);
+}
+
+void QuantumFeedbackSystem::applySettings(const FeedbackSettings& settings) {
+    setFeedbackGain(settings.feedback_gain);
+    setQuantumThreshold(settings.quantum_threshold);
+    setFeedbackEnabled(settings.feedback_enabled);
+    setQuantumMode(settings.quantum_mode);
+}
+
+FeedbackSettings QuantumFeedbackSystem::getSettings() const {
+    FeedbackSettings settings;
+    settings.feedback_gain = getFeedbackGain();
+    settings.quantum_threshold = getQuantumThreshold();
+    settings.feedback_enabled = feedback_enabled_.load(std::memory_order_relaxed);
+    settings.quantum_mode = quantum_mode_.load(std::memory_order_relaxed);
+    return settings;
 }
 
 QuantumSoundField QuantumFeedbackSystem::processFeedback(const QuantumSoundField& input_field, 
                                                        const std::vector<QuantumSoundField>& feedback_fields) {
-    if (!feedback_enabled_) {
+    const FeedbackSettings settings = getSettings();
+    if (!settings.feedback_enabled) {
         return input_field;
     }
     
     QuantumSoundField output_field = input_field;
+    const double feedback_gain = settings.feedback_gain;
+    const double quantum_threshold = settings.quantum_threshold;
     
-    if (quantum_mode_ && !feedback_fields.empty()) {
+    if (settings.quantum_mode && !feedback_fields.empty()) {
         // Quantum feedback processing
         std::complex<double> quantum_feedback(0.0, 0.0);
         
@@ -51,7 +137,7 @@ QuantumSoundField QuantumFeedbackSystem::processFeedback(const QuantumSoundField
             // Calculate quantum correlation
             double correlation = calculateQuantumCorrelation(input_field, fb_field);
             
-            if (correlation > quantum_threshold_) {
+            if (correlation > quantum_threshold) {
                 // Apply quantum feedback
                 std::complex<double> feedback_contribution = fb_field.amplitude * 
                     std::exp(std::complex<double>(0.0, fb_field.phase));
@@ -61,10 +147,10 @@ QuantumSoundField QuantumFeedbackSystem::processFeedback(const QuantumSoundField
         }
         
         // Apply quantum feedback with gain
-        output_field.amplitude += quantum_feedback * feedback_gain_;
+        output_field.amplitude += quantum_feedback * feedback_gain;
         
         // Update quantum state based on feedback
-        if (std::abs(quantum_feedback.real()) > quantum_threshold_) {
+        if (std::abs(quantum_feedback.real()) > quantum_threshold) {
             output_field.quantum_state = QuantumSoundState::ENTANGLED;
         }
     } else {
@@ -77,12 +163,82 @@ QuantumSoundField QuantumFeedbackSystem::processFeedback(const QuantumSoundField
         }
         
         // Apply classical feedback
-        output_field.amplitude += classical_feedback * feedback_gain_;
+        output_field.amplitude += classical_feedback * feedback_gain;
     }
     
     return output_field;
 }
 
+void QuantumFeedbackSystem::processFeedback(const std::vector<QuantumSoundField>& input_fields,
+                                            const std::vector<QuantumSoundField>& feedback_fields,
+                                            std::vector<QuantumSoundField>& output_fields) const {
+    processFeedbackBatch(input_fields, feedback_fields, output_fields, nullptr);
+}
+
+void QuantumFeedbackSystem::processFeedback(const std::vector<QuantumSoundField>& input_fields,
+                                            const std::vector<QuantumSoundField>& feedback_fields,
+                                            std::vector<QuantumSoundField>& output_fields,
+                                            ThreadPool& pool) const {
+    processFeedbackBatch(input_fields, feedback_fields, output_fields, &pool);
+}
+
+void QuantumFeedbackSystem::processFeedbackBatch(const std::vector<QuantumSoundField>& input_fields,
+                                                 const std::vector<QuantumSoundField>& feedback_fields,
+                                                 std::vector<QuantumSoundField>& output_fields,
+                                                 ThreadPool* pool) const {
+    output_fields = input_fields;
+    const FeedbackSettings settings = getSettings();
+    if (!settings.feedback_enabled) {
+        return;
+    }
+    const double feedback_gain = settings.feedback_gain;
+    const double quantum_threshold = settings.quantum_threshold;
+    
+    if (!settings.quantum_mode || feedback_fields.empty()) {
+        // Classical feedback is the same sum for every input
+        std::complex<double> classical_feedback(0.0, 0.0);
+        for (const auto& fb_field : feedback_fields) {
+            classical_feedback += fb_field.amplitude * 
+                std::exp(std::complex<double>(0.0, fb_field.phase));
+        }
+        for (auto& output_field : output_fields) {
+            output_field.amplitude += classical_feedback * feedback_gain;
+        }
+        return;
+    }
+    
+    // Feedback phasors and state rows once per batch, reused by every input.
+    // Workers must see this thread's scratch: naming the thread_local inside
+    // the body would resolve to each worker's own (empty) instance.
+    thread_local FeedbackBatch scratch;
+    FeedbackBatch& batch = scratch;
+    batch.prepare(feedback_fields);
+    const FeedbackSources sources = batch.sources();
+    const FeedbackKernelTable& kernels = getFeedbackKernels();
+    
+    auto body = [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) {
+            QuantumSoundField& output_field = output_fields[i];
+            const double* state_row = batch.state_rows.data() +
+                static_cast<size_t>(output_field.quantum_state) * sources.count;
+            std::complex<double> quantum_feedback = kernels.accumulate(
+                sources, state_row, std::cos(output_field.phase), std::sin(output_field.phase),
+                output_field.frequency, quantum_threshold);
+            
+            output_field.amplitude += quantum_feedback * feedback_gain;
+            if (std::abs(quantum_feedback.real()) > quantum_threshold) {
+                output_field.quantum_state = QuantumSoundState::ENTANGLED;
+            }
+        }
+    };
+    
+    if (pool) {
+        pool->parallelFor(output_fields.size(), kFeedbackGrain, body);
+    } else {
+        body(0, output_fields.size(), 0);
+    }
+}
+
 double QuantumFeedbackSystem::calculateQuantumCorrelation(const QuantumSoundField& field1, 
                                                         const QuantumSoundField& field2) const {
     // Calculate quantum correlation based on state similarity
@@ -97,17 +253,7 @@ double QuantumFeedbackSystem::calculateQuantumCorrelation(const QuantumSoundFiel
     double freq_corr = 1.0 / (1.0 + freq_diff / 1000.0); // Normalize to reasonable range
     
     // Quantum state correlation
-    double state_corr = 0.0;
-    if (field1.quantum_state == field2.quantum_state) {
-        state_corr = 1.0;
-    } else if ((field1.quantum_state == QuantumSoundState::ENTANGLED && 
-                field2.quantum_state == QuantumSoundState::ENTANGLED) ||
-               (field1.quantum_state == QuantumSoundState::SUPERPOSITION && 
-                field2.quantum_state == QuantumSoundState::SUPERPOSITION)) {
-        state_corr = 0.7;
-    } else {
-        state_corr = 0.3;
-    }
+    double state_corr = stateCorrelation(field1.quantum_state, field2.quantum_state);
     
     // Combine correlations
     correlation = (phase_corr + freq_corr + state_corr) / 3.0;
@@ -119,41 +265,61 @@ std::vector<QuantumSoundField> QuantumFeedbackSystem::generateQuantumFeedback(co
                                                                              size_t feedback_count) {
     std::vector<QuantumSoundField> feedback_fields;
     
-    if (!quantum_mode_) {
+    if (!quantum_mode_.load(std::memory_order_relaxed)) {
+        return feedback_fields;
+    }
+    
+    feedback_fields.resize(feedback_count);
+    writeQuantumFeedback(input_field, feedback_count, feedback_fields.data());
+    return feedback_fields;
+}
+
+FieldVector QuantumFeedbackSystem::generateQuantumFeedback(const QuantumSoundField& input_field,
+                                                           size_t feedback_count, FieldArena& arena) {
+    FieldVector feedback_fields(&arena);
+    
+    if (!quantum_mode_.load(std::memory_order_relaxed)) {
         return feedback_fields;
     }
     
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::normal_distribution<double> noise(0.0, 0.1);
+    feedback_fields.resize(feedback_count);
+    writeQuantumFeedback(input_field, feedback_count, feedback_fields.data());
+    return feedback_fields;
+}
+
+void QuantumFeedbackSystem::writeQuantumFeedback(const QuantumSoundField& input_field, size_t feedback_count,
+                                                 QuantumSoundField* output) const {
+    ANANTASOUND_STAGE_TIMER("feedback.generate");
+    // Five N(0, 0.1) draws per feedback field, generated in one batch
+    thread_local std::vector<double> noise_buffer;
+    noise_buffer.resize(5 * feedback_count);
+    QuantumNoiseSource::threadLocal().fillGaussian(noise_buffer.data(), noise_buffer.size(), 0.0, 0.1);
     
     for (size_t i = 0; i < feedback_count; ++i) {
-        QuantumSoundField feedback_field = input_field;
+        QuantumSoundField& feedback_field = output[i];
+        feedback_field = input_field;
+        const double* noise = noise_buffer.data() + 5 * i;
         
         // Add quantum noise
-        feedback_field.amplitude += std::complex<double>(noise(gen), noise(gen));
+        feedback_field.amplitude += std::complex<double>(noise[0], noise[1]);
         
         // Slight frequency variation
-        feedback_field.frequency += noise(gen) * 10.0;
+        feedback_field.frequency += noise[2] * 10.0;
         
         // Phase shift
-        feedback_field.phase += noise(gen) * M_PI / 8.0;
+        feedback_field.phase += noise[3] * M_PI / 8.0;
         
         // Quantum state variation
-        if (noise(gen) > 0.5) {
+        if (noise[4] > 0.5) {
             feedback_field.quantum_state = QuantumSoundState::SUPERPOSITION;
         }
-        
-        feedback_fields.push_back(feedback_field);
     }
-    
-    return feedback_fields;
 }
 
 void QuantumFeedbackSystem::resetFeedback() {
     // Reset feedback state
-    feedback_gain_ = 1.0;
-    quantum_threshold_ = 0.5;
+    setFeedbackGain(1.0);
+    setQuantumThreshold(0.5);
 }
 
 // QuantumResonanceDetector implementation
@@ -214,6 +380,128 @@ std::vector<double> QuantumResonanceDetector::findResonantFrequencies(const std:
     return resonant_frequencies;
 }
 
+// ResonanceTracker implementation
+ResonanceTracker::ResonanceTracker(double resonance_threshold, double tolerance)
+    : detector_(resonance_threshold)
+    , tolerance_(std::max(tolerance, 1e-9))
+    , resonant_count_(0)
+    , resonances_stale_(false) {
+}
+
+int64_t ResonanceTracker::bucketKey(double frequency) const {
+    return static_cast<int64_t>(std::floor(frequency / tolerance_));
+}
+
+void ResonanceTracker::track(double frequency) {
+    Bucket& bucket = buckets_[bucketKey(frequency)];
+    ++bucket.count;
+    bucket.frequency_sum += frequency;
+    ++resonant_count_;
+    resonances_stale_ = true;
+}
+
+void ResonanceTracker::untrack(double frequency) {
+    auto it = buckets_.find(bucketKey(frequency));
+    if (--it->second.count == 0) {
+        // Dropping empty buckets also discards accumulated rounding in the sum
+        buckets_.erase(it);
+    } else {
+        it->second.frequency_sum -= frequency;
+    }
+    --resonant_count_;
+    resonances_stale_ = true;
+}
+
+ResonanceTracker::FieldHandle ResonanceTracker::addField(const QuantumSoundField& field) {
+    FieldHandle handle = slots_.insert();
+    bool resonant = detector_.detectResonance(field);
+    frequencies_.push_back(field.frequency);
+    resonant_.push_back(resonant);
+    if (resonant) {
+        track(field.frequency);
+    }
+    return handle;
+}
+
+bool ResonanceTracker::updateField(FieldHandle handle, const QuantumSoundField& field) {
+    size_t index = slots_.find(handle);
+    if (index == SlotIndex::npos) {
+        return false;
+    }
+    
+    bool resonant = detector_.detectResonance(field);
+    if (resonant_[index] && resonant && bucketKey(frequencies_[index]) == bucketKey(field.frequency)) {
+        // Same bucket: adjust the sum in place
+        buckets_[bucketKey(field.frequency)].frequency_sum += field.frequency - frequencies_[index];
+        resonances_stale_ |= field.frequency != frequencies_[index];
+    } else {
+        if (resonant_[index]) {
+            untrack(frequencies_[index]);
+        }
+        if (resonant) {
+            track(field.frequency);
+        }
+    }
+    frequencies_[index] = field.frequency;
+    resonant_[index] = resonant;
+    return true;
+}
+
+bool ResonanceTracker::removeField(FieldHandle handle) {
+    size_t moved_from = 0;
+    size_t index = slots_.erase(handle, moved_from);
+    if (index == SlotIndex::npos) {
+        return false;
+    }
+    
+    if (resonant_[index]) {
+        untrack(frequencies_[index]);
+    }
+    frequencies_[index] = frequencies_[moved_from];
+    resonant_[index] = resonant_[moved_from];
+    frequencies_.pop_back();
+    resonant_.pop_back();
+    return true;
+}
+
+void ResonanceTracker::clear() {
+    slots_.clear();
+    frequencies_.clear();
+    resonant_.clear();
+    buckets_.clear();
+    resonant_count_ = 0;
+    resonances_.clear();
+    resonances_stale_ = false;
+}
+
+const std::vector<double>& ResonanceTracker::getResonantFrequencies() {
+    if (!resonances_stale_) {
+        return resonances_;
+    }
+    
+    // Walk the ordered buckets once, merging runs of adjacent ones
+    resonances_.clear();
+    size_t cluster_count = 0;
+    double cluster_sum = 0.0;
+    int64_t previous_key = 0;
+    for (const auto& [key, bucket] : buckets_) {
+        if (cluster_count > 0 && key != previous_key + 1) {
+            resonances_.push_back(cluster_sum / cluster_count);
+            cluster_count = 0;
+            cluster_sum = 0.0;
+        }
+        cluster_count += bucket.count;
+        cluster_sum += bucket.frequency_sum;
+        previous_key = key;
+    }
+    if (cluster_count > 0) {
+        resonances_.push_back(cluster_sum / cluster_count);
+    }
+    
+    resonances_stale_ = false;
+    return resonances_;
+}
+
 // QuantumPhaseSynchronizer implementation
 QuantumPhaseSynchronizer::QuantumPhaseSynchronizer(double sync_tolerance)
     : sync_tolerance_(sync_tolerance), sync_enabled_(true) {
@@ -232,37 +520,49 @@ void QuantumPhaseSynchronizer::setSyncEnabled(bool enabled) {
 }
 
 std::vector<QuantumSoundField> QuantumPhaseSynchronizer::synchronizePhases(const std::vector<QuantumSoundField>& fields) const {
-    if (!sync_enabled_ || fields.empty()) {
-        return fields;
-    }
-    
     std::vector<QuantumSoundField> synchronized_fields = fields;
+    synchronizePhasesInPlace(synchronized_fields);
+    return synchronized_fields;
+}
+
+FieldVector QuantumPhaseSynchronizer::synchronizePhases(const std::vector<QuantumSoundField>& fields,
+                                                        FieldArena& arena) const {
+    FieldVector synchronized_fields(fields.begin(), fields.end(), &arena);
+    synchronizePhasesInPlace(synchronized_fields.data(), synchronized_fields.size());
+    return synchronized_fields;
+}
+
+void QuantumPhaseSynchronizer::synchronizePhasesInPlace(std::vector<QuantumSoundField>& fields) const {
+    synchronizePhasesInPlace(fields.data(), fields.size());
+}
+
+void QuantumPhaseSynchronizer::synchronizePhasesInPlace(QuantumSoundField* fields, size_t count) const {
+    if (!sync_enabled_ || count == 0) {
+        return;
+    }
     
-    // Find reference phase (average of coherent fields)
-    double reference_phase = 0.0;
+    // Find reference phase (circular mean of coherent fields)
+    std::complex<double> order_sum(0.0, 0.0);
     int coherent_count = 0;
     
-    for (const auto& field : fields) {
+    for (size_t i = 0; i < count; ++i) {
+        const QuantumSoundField& field = fields[i];
         if (field.quantum_state == QuantumSoundState::COHERENT) {
-            reference_phase += field.phase;
+            order_sum += std::complex<double>(std::cos(field.phase), std::sin(field.phase));
             coherent_count++;
         }
     }
     
-    if (coherent_count > 0) {
-        reference_phase /= coherent_count;
-    } else {
-        // Use first field as reference if no coherent fields
-        reference_phase = fields[0].phase;
-    }
+    // Use first field as reference if no coherent fields (or their phases cancel)
+    double reference_phase = coherent_count > 0 && std::abs(order_sum) > 0.0
+        ? std::arg(order_sum)
+        : fields[0].phase;
     
     // Synchronize all fields to reference phase
-    for (auto& field : synchronized_fields) {
-        double phase_diff = field.phase - reference_phase;
-        
-        // Normalize phase difference to [-π, π]
-        while (phase_diff > M_PI) phase_diff -= 2.0 * M_PI;
-        while (phase_diff < -M_PI) phase_diff += 2.0 * M_PI;
+    for (size_t i = 0; i < count; ++i) {
+        QuantumSoundField& field = fields[i];
+        // Phase difference normalized to [-π, π]
+        double phase_diff = std::remainder(field.phase - reference_phase, 2.0 * M_PI);
         
         // Apply phase correction if within tolerance
         if (std::abs(phase_diff) > sync_tolerance_) {
@@ -274,8 +574,6 @@ std::vector<QuantumSoundField> QuantumPhaseSynchronizer::synchronizePhases(const
             }
         }
     }
-    
-    return synchronized_fields;
 }
 
 } // namespace AnantaSound
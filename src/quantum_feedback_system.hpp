@@ -1,18 +1,36 @@
 #pragma once
 
 #include "anantasound_core.hpp"
+#include <atomic>
 #include <vector>
+#include <map>
 #include <memory>
 
 namespace AnantaSound {
 
-// Квантовая система обратной связи
+class ThreadPool;
+
+// Параметры обратной связи, меняемые на лету
+struct FeedbackSettings {
+    double feedback_gain;           // 0.0 - 10.0
+    double quantum_threshold;       // 0.0 - 1.0
+    bool feedback_enabled;
+    bool quantum_mode;
+    
+    FeedbackSettings() : feedback_gain(1.0), quantum_threshold(0.5),
+                         feedback_enabled(true), quantum_mode(true) {}
+};
+
+// Квантовая система обратной связи.
+// Параметры - атомарные значения: установщики не ждут идущей обработки,
+// а каждый вызов обработки читает их один раз в начале, так что блок
+// целиком идет с одними и теми же значениями.
 class QuantumFeedbackSystem {
 private:
-    double feedback_gain_;
-    double quantum_threshold_;
-    bool feedback_enabled_;
-    bool quantum_mode_;
+    std::atomic<double> feedback_gain_;
+    std::atomic<double> quantum_threshold_;
+    std::atomic<bool> feedback_enabled_;
+    std::atomic<bool> quantum_mode_;
 
 public:
     explicit QuantumFeedbackSystem(double feedback_gain = 1.0, double quantum_threshold = 0.5);
@@ -25,21 +43,48 @@ public:
     void setFeedbackEnabled(bool enabled);
     void setQuantumMode(bool enabled);
     
+    // Все параметры сразу (например, из LiveConfig)
+    void applySettings(const FeedbackSettings& settings);
+    FeedbackSettings getSettings() const;
+    
     // Обработка обратной связи
     QuantumSoundField processFeedback(const QuantumSoundField& input_field, 
                                     const std::vector<QuantumSoundField>& feedback_fields);
     
+    // Пакетная обработка: output_fields[i] = processFeedback(input_fields[i], feedback_fields).
+    // Фазоры и строки таблицы корреляции состояний обратной связи считаются
+    // один раз на пакет, матрица корреляций M x N вычисляется SIMD-ядрами;
+    // вариант с пулом распределяет входные поля по потокам.
+    void processFeedback(const std::vector<QuantumSoundField>& input_fields,
+                         const std::vector<QuantumSoundField>& feedback_fields,
+                         std::vector<QuantumSoundField>& output_fields) const;
+    void processFeedback(const std::vector<QuantumSoundField>& input_fields,
+                         const std::vector<QuantumSoundField>& feedback_fields,
+                         std::vector<QuantumSoundField>& output_fields,
+                         ThreadPool& pool) const;
+    
     // Генерация квантовой обратной связи
     std::vector<QuantumSoundField> generateQuantumFeedback(const QuantumSoundField& input_field, 
                                                           size_t feedback_count = 3);
+    FieldVector generateQuantumFeedback(const QuantumSoundField& input_field, size_t feedback_count,
+                                        FieldArena& arena);                 // Память - из арены тика
     
     // Сброс состояния
     void resetFeedback();
 
 private:
+    // Запись feedback_count полей обратной связи в буфер вызывающего
+    void writeQuantumFeedback(const QuantumSoundField& input_field, size_t feedback_count,
+                              QuantumSoundField* output) const;
+    
     // Расчет квантовой корреляции между полями
     double calculateQuantumCorrelation(const QuantumSoundField& field1, 
                                      const QuantumSoundField& field2) const;
+    
+    void processFeedbackBatch(const std::vector<QuantumSoundField>& input_fields,
+                              const std::vector<QuantumSoundField>& feedback_fields,
+                              std::vector<QuantumSoundField>& output_fields,
+                              ThreadPool* pool) const;
 };
 
 // Детектор квантового резонанса
@@ -61,6 +106,56 @@ public:
     std::vector<double> findResonantFrequencies(const std::vector<QuantumSoundField>& fields) const;
 };
 
+// Инкрементальный трекер резонансов.
+// Поля добавляются и удаляются по дескрипторам; резонансные поля (по
+// QuantumResonanceDetector) ведутся в упорядоченной гистограмме с шириной
+// корзины tolerance. Соседние непустые корзины сливаются в один резонанс,
+// частота которого - среднее по полям, так что частоты ближе tolerance
+// всегда дают один резонанс. Список резонансов пересобирается по корзинам
+// только после изменений, без перебора полей и сортировки.
+class ResonanceTracker {
+public:
+    using FieldHandle = SlotHandle;
+    
+private:
+    struct Bucket {
+        size_t count = 0;
+        double frequency_sum = 0.0;
+    };
+    
+    QuantumResonanceDetector detector_;
+    double tolerance_;
+    SlotIndex slots_;
+    std::vector<double> frequencies_;           // Плотные массивы по индексу SlotIndex
+    std::vector<char> resonant_;
+    std::map<int64_t, Bucket> buckets_;
+    size_t resonant_count_;
+    std::vector<double> resonances_;
+    bool resonances_stale_;
+
+public:
+    explicit ResonanceTracker(double resonance_threshold = 0.7, double tolerance = 1.0);
+    
+    FieldHandle addField(const QuantumSoundField& field);
+    bool updateField(FieldHandle handle, const QuantumSoundField& field);
+    bool removeField(FieldHandle handle);
+    bool containsField(FieldHandle handle) const { return slots_.contains(handle); }
+    void clear();
+    
+    // Текущие резонансные частоты по возрастанию
+    const std::vector<double>& getResonantFrequencies();
+    
+    size_t getFieldCount() const { return slots_.size(); }
+    size_t getResonantFieldCount() const { return resonant_count_; }
+    double getTolerance() const { return tolerance_; }
+    const QuantumResonanceDetector& getDetector() const { return detector_; }
+
+private:
+    int64_t bucketKey(double frequency) const;
+    void track(double frequency);
+    void untrack(double frequency);
+};
+
 // Квантовый синхронизатор фаз
 class QuantumPhaseSynchronizer {
 private:
@@ -75,8 +170,15 @@ public:
     double getSyncTolerance() const;
     void setSyncEnabled(bool enabled);
     
-    // Синхронизация фаз
+    // Синхронизация фаз. Опорная фаза - круговое среднее когерентных полей
+    // (или фаза первого поля); поля, отстоящие от нее дальше допуска,
+    // переводятся на опорную фазу
     std::vector<QuantumSoundField> synchronizePhases(const std::vector<QuantumSoundField>& fields) const;
+    void synchronizePhasesInPlace(std::vector<QuantumSoundField>& fields) const;
+    void synchronizePhasesInPlace(QuantumSoundField* fields, size_t count) const;
+    
+    // Синхронизированная копия в арене тика
+    FieldVector synchronizePhases(const std::vector<QuantumSoundField>& fields, FieldArena& arena) const;
 };
 
 } // namespace AnantaSound
@@ -0,0 +1,118 @@
+#include "quantum_noise.hpp"
+#include <cmath>
+#include <random>
+
+namespace AnantaSound {
+
+namespace {
+
+uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Marsaglia-Tsang ziggurat for the standard normal, 128 layers of equal area
+constexpr size_t kLayers = 128;
+constexpr double kTailStart = 3.442619855899;           // R: right edge of the base layer
+constexpr double kLayerArea = 9.91256303526217e-3;      // V
+
+struct ZigguratTables {
+    double x[kLayers + 1];      // Layer edges, x[0] widened so the base layer holds the tail area
+    double ratio[kLayers];      // x[i + 1] / x[i]: fraction of layer i under the curve everywhere
+
+    ZigguratTables() {
+        double f = std::exp(-0.5 * kTailStart * kTailStart);
+        x[0] = kLayerArea / f;
+        x[1] = kTailStart;
+        x[kLayers] = 0.0;
+        for (size_t i = 2; i < kLayers; ++i) {
+            x[i] = std::sqrt(-2.0 * std::log(kLayerArea / x[i - 1] + f));
+            f = std::exp(-0.5 * x[i] * x[i]);
+        }
+        for (size_t i = 0; i < kLayers; ++i) {
+            ratio[i] = x[i + 1] / x[i];
+        }
+    }
+};
+
+const ZigguratTables& zigguratTables() {
+    static const ZigguratTables tables;
+    return tables;
+}
+
+} // namespace
+
+QuantumNoiseSource::QuantumNoiseSource(uint64_t seed, uint64_t stream) {
+    this->seed(seed, stream);
+}
+
+void QuantumNoiseSource::seed(uint64_t seed, uint64_t stream) {
+    // Mix the stream into the seed so neighbouring streams start far apart
+    uint64_t mixer = seed;
+    uint64_t stream_mixer = stream;
+    mixer ^= splitmix64(stream_mixer);
+    for (uint64_t& word : state_) {
+        word = splitmix64(mixer);
+    }
+}
+
+double QuantumNoiseSource::gaussian() {
+    const ZigguratTables& tables = zigguratTables();
+    while (true) {
+        uint64_t bits = next();
+        size_t layer = bits & (kLayers - 1);
+        double u = 2.0 * (static_cast<double>(bits >> 11) * 0x1.0p-53) - 1.0;     // [-1, 1)
+
+        // Inside the layer's rectangle that lies entirely under the curve
+        if (std::abs(u) < tables.ratio[layer]) {
+            return u * tables.x[layer];
+        }
+        if (layer == 0) {
+            return gaussianTail(u < 0.0);
+        }
+
+        // Wedge between the rectangle and the curve
+        double x = u * tables.x[layer];
+        double f0 = std::exp(-0.5 * (tables.x[layer] * tables.x[layer] - x * x));
+        double f1 = std::exp(-0.5 * (tables.x[layer + 1] * tables.x[layer + 1] - x * x));
+        if (f1 + uniform() * (f0 - f1) < 1.0) {
+            return x;
+        }
+    }
+}
+
+double QuantumNoiseSource::gaussianTail(bool negative) {
+    // Marsaglia's tail method for |x| > R; uniforms are shifted into (0, 1)
+    double x, y;
+    do {
+        x = std::log(uniform() + 0x1.0p-54) / kTailStart;
+        y = std::log(uniform() + 0x1.0p-54);
+    } while (-2.0 * y < x * x);
+    return negative ? x - kTailStart : kTailStart - x;
+}
+
+void QuantumNoiseSource::fillUniform(double* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = uniform();
+    }
+}
+
+void QuantumNoiseSource::fillGaussian(double* output, size_t count, double mean, double stddev) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = mean + stddev * gaussian();
+    }
+}
+
+QuantumNoiseSource& QuantumNoiseSource::threadLocal() {
+    thread_local QuantumNoiseSource source(
+        (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}());
+    return source;
+}
+
+void QuantumNoiseSource::seedThreadLocal(uint64_t seed, uint64_t stream) {
+    threadLocal().seed(seed, stream);
+}
+
+} // namespace AnantaSound
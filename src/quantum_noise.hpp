@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace AnantaSound {
+
+// Seedable noise for the quantum uncertainty and decoherence paths.
+// xoshiro256** streams seeded through splitmix64: the same (seed, stream)
+// pair always replays the same sequence, and different streams of one seed
+// are independent. Gaussian samples use the 128-layer ziggurat, which needs
+// one 64-bit draw and a table lookup for ~99% of samples. A source is not
+// synchronized; give each thread or worker its own (see threadLocal()).
+class QuantumNoiseSource {
+private:
+    uint64_t state_[4];
+
+public:
+    explicit QuantumNoiseSource(uint64_t seed = 0, uint64_t stream = 0);
+
+    void seed(uint64_t seed, uint64_t stream = 0);
+
+    // Raw 64-bit output
+    uint64_t next() {
+        const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, 1) with 53 random bits
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    // Standard normal sample
+    double gaussian();
+
+    // Batched generation into caller-owned buffers
+    void fillUniform(double* output, size_t count);
+    void fillGaussian(double* output, size_t count, double mean = 0.0, double stddev = 1.0);
+
+    // Stateless draw in [0, 1) keyed by (seed, counter, index): the same key
+    // always gives the same value, independent of evaluation order or thread,
+    // and loops over index vectorize
+    static double counterUniform(uint64_t seed, uint64_t counter, uint64_t index) {
+        uint64_t z = seed ^ (counter * 0x9E3779B97F4A7C15ULL) ^ (index * 0xC2B2AE3D27D4EB4FULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        return static_cast<double>(z >> 11) * 0x1.0p-53;
+    }
+
+    // Per-thread source. Threads start from distinct random seeds; seeding
+    // the calling thread's source makes its sequence reproducible.
+    static QuantumNoiseSource& threadLocal();
+    static void seedThreadLocal(uint64_t seed, uint64_t stream = 0);
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    double gaussianTail(bool negative);
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,150 @@
+#include "realtime_audio_bridge.hpp"
+#include "metrics.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace AnantaSound {
+
+RealtimeAudioBridge::RealtimeAudioBridge(size_t channels, size_t max_frames_per_callback,
+                                         size_t ring_capacity, std::chrono::microseconds poll_interval)
+    : channels_(std::max<size_t>(channels, 1))
+    , max_frames_(std::max<size_t>(max_frames_per_callback, 1))
+    , ring_capacity_(ring_capacity)
+    , poll_interval_(poll_interval)
+    , mono_(max_frames_)
+    , running_(false)
+    , underruns_(0) {
+}
+
+RealtimeAudioBridge::~RealtimeAudioBridge() {
+    stop();
+}
+
+size_t RealtimeAudioBridge::addConsumer(size_t block_size, BlockCallback callback) {
+    if (isRunning()) {
+        std::cerr << "RealtimeAudioBridge: consumers must be added before start()" << std::endl;
+        return npos;
+    }
+    block_size = std::max<size_t>(block_size, 1);
+    size_t capacity = std::max(ring_capacity_, 2 * block_size);
+    consumers_.push_back(std::make_unique<Consumer>(capacity, block_size, std::move(callback)));
+    return consumers_.size() - 1;
+}
+
+size_t RealtimeAudioBridge::addAdaptiveProcessor(AdaptiveAudioProcessor& processor, size_t block_size,
+                                                 std::function<void(const AdaptationResultF&)> on_result) {
+    // The worker reuses one block vector; results allocate off the audio thread
+    auto input = std::make_shared<std::vector<float>>(block_size);
+    return addConsumer(block_size, [&processor, input, on_result](const float* samples, size_t count) {
+        input->assign(samples, samples + count);
+        AdaptationResultF result = processor.processAudio(*input);
+        if (on_result) {
+            on_result(result);
+        }
+    });
+}
+
+size_t RealtimeAudioBridge::addBreathingAnalyzer(BreathingAnalyzer& analyzer, size_t block_size,
+                                                 std::function<void(const BreathingAnalysisResult&)> on_result) {
+    return addConsumer(block_size, [&analyzer, on_result](const float* samples, size_t count) {
+        BreathingAnalysisResult result = analyzer.analyzeBreathing(samples, count);
+        if (on_result) {
+            on_result(result);
+        }
+    });
+}
+
+bool RealtimeAudioBridge::start() {
+    if (isRunning()) {
+        return false;
+    }
+    running_.store(true, std::memory_order_release);
+    for (auto& consumer : consumers_) {
+        Consumer* target = consumer.get();
+        consumer->worker = std::thread([this, target]() { consumerLoop(*target); });
+    }
+    return true;
+}
+
+void RealtimeAudioBridge::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    for (auto& consumer : consumers_) {
+        if (consumer->worker.joinable()) {
+            consumer->worker.join();
+        }
+    }
+}
+
+void RealtimeAudioBridge::process(const float* interleaved, size_t frame_count) {
+    while (frame_count > 0) {
+        size_t frames = std::min(frame_count, max_frames_);
+
+        // Downmix to mono (a single channel is passed straight through)
+        const float* mono = interleaved;
+        if (channels_ > 1) {
+            const float scale = 1.0f / static_cast<float>(channels_);
+            for (size_t frame = 0; frame < frames; ++frame) {
+                const float* samples = interleaved + frame * channels_;
+                float sum = 0.0f;
+                for (size_t channel = 0; channel < channels_; ++channel) {
+                    sum += samples[channel];
+                }
+                mono_[frame] = sum * scale;
+            }
+            mono = mono_.data();
+        }
+
+        for (auto& consumer : consumers_) {
+            size_t written = consumer->ring.write(mono, frames);
+            if (written < frames) {
+                consumer->dropped_samples.fetch_add(frames - written, std::memory_order_relaxed);
+                ANANTASOUND_COUNT("dropped_frames", "bridge", frames - written);
+            }
+        }
+
+        interleaved += frames * channels_;
+        frame_count -= frames;
+    }
+}
+
+void RealtimeAudioBridge::reportUnderrun() {
+    underruns_.fetch_add(1, std::memory_order_relaxed);
+    ANANTASOUND_COUNT("buffer_underruns", "bridge", 1);
+}
+
+uint64_t RealtimeAudioBridge::getBlocksDelivered(size_t consumer) const {
+    return consumer < consumers_.size() ? consumers_[consumer]->blocks.load(std::memory_order_acquire) : 0;
+}
+
+uint64_t RealtimeAudioBridge::getDroppedSamples(size_t consumer) const {
+    return consumer < consumers_.size() ? consumers_[consumer]->dropped_samples.load(std::memory_order_relaxed) : 0;
+}
+
+bool RealtimeAudioBridge::deliverBlock(Consumer& consumer) {
+    if (consumer.ring.readAvailable() < consumer.block.size()) {
+        return false;
+    }
+    consumer.ring.read(consumer.block.data(), consumer.block.size());
+    if (consumer.callback) {
+        consumer.callback(consumer.block.data(), consumer.block.size());
+    }
+    consumer.blocks.fetch_add(1, std::memory_order_release);
+    ANANTASOUND_COUNT("processed_blocks", "bridge", 1);
+    return true;
+}
+
+void RealtimeAudioBridge::consumerLoop(Consumer& consumer) {
+    while (running_.load(std::memory_order_acquire)) {
+        if (!deliverBlock(consumer)) {
+            std::this_thread::sleep_for(poll_interval_);
+        }
+    }
+
+    // Flush the complete blocks that arrived before stop()
+    while (deliverBlock(consumer)) {
+    }
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "spsc_ring_buffer.hpp"
+#include "adaptive_audio_processor.hpp"
+#include "breathing_analyzer.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace AnantaSound {
+
+// Real-time capture handoff between an audio callback and analysis threads.
+// The audio callback (PortAudio or any other driver) calls process() with
+// its interleaved input. process() downmixes to mono into a preallocated
+// scratch block and writes it into one SPSC ring per consumer: no locks,
+// no allocations, no waiting, so it is safe at block sizes down to 64
+// frames. A ring that is full drops the block's overflow and counts it.
+// Every consumer runs on its own worker thread and receives consecutive
+// mono blocks of its own size; it polls its ring and sleeps for
+// poll_interval when a block is not ready yet, so the callback never has to
+// signal anything. Consumers are registered before start().
+class RealtimeAudioBridge {
+public:
+    using BlockCallback = std::function<void(const float* samples, size_t sample_count)>;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+private:
+    struct Consumer {
+        SPSCRingBuffer<float> ring;
+        std::vector<float> block;
+        BlockCallback callback;
+        std::thread worker;
+        std::atomic<uint64_t> blocks;
+        std::atomic<uint64_t> dropped_samples;
+
+        Consumer(size_t capacity, size_t block_size, BlockCallback block_callback)
+            : ring(capacity), block(block_size), callback(std::move(block_callback)),
+              blocks(0), dropped_samples(0) {}
+    };
+
+    size_t channels_;
+    size_t max_frames_;
+    size_t ring_capacity_;
+    std::chrono::microseconds poll_interval_;
+    std::vector<float> mono_;                   // Callback scratch, max_frames_ samples
+    std::vector<std::unique_ptr<Consumer>> consumers_;
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> underruns_;
+
+public:
+    // max_frames_per_callback sizes the scratch block (larger callbacks are
+    // split); ring_capacity is per consumer, in samples (at least two blocks)
+    RealtimeAudioBridge(size_t channels = 1, size_t max_frames_per_callback = 4096,
+                        size_t ring_capacity = 1 << 16,
+                        std::chrono::microseconds poll_interval = std::chrono::microseconds(500));
+    ~RealtimeAudioBridge();
+
+    RealtimeAudioBridge(const RealtimeAudioBridge&) = delete;
+    RealtimeAudioBridge& operator=(const RealtimeAudioBridge&) = delete;
+
+    // Register a consumer of block_size-sample mono blocks; npos while running
+    size_t addConsumer(size_t block_size, BlockCallback callback);
+
+    // Consumers that feed the analyzers one block at a time on their worker
+    size_t addAdaptiveProcessor(AdaptiveAudioProcessor& processor, size_t block_size,
+                                std::function<void(const AdaptationResultF&)> on_result);
+    size_t addBreathingAnalyzer(BreathingAnalyzer& analyzer, size_t block_size,
+                                std::function<void(const BreathingAnalysisResult&)> on_result);
+
+    // Start / stop the consumer threads; stop delivers the complete blocks
+    // still buffered before it returns
+    bool start();
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    // Audio callback entry point: interleaved frames of getChannels() samples
+    void process(const float* interleaved, size_t frame_count);
+
+    // Count a buffer underrun or overflow the driver reported for a callback
+    // (e.g. PortAudio's paInputOverflow / paOutputUnderflow status flags);
+    // lock-free, for the audio callback
+    void reportUnderrun();
+    uint64_t getUnderruns() const { return underruns_.load(std::memory_order_relaxed); }
+
+    size_t getChannels() const { return channels_; }
+    size_t getConsumerCount() const { return consumers_.size(); }
+    uint64_t getBlocksDelivered(size_t consumer) const;
+    uint64_t getDroppedSamples(size_t consumer) const;
+
+private:
+    void consumerLoop(Consumer& consumer);
+    bool deliverBlock(Consumer& consumer);
+};
+
+} // namespace AnantaSound
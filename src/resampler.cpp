@@ -0,0 +1,234 @@
+#include "resampler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace AnantaSound {
+
+namespace {
+
+// Passband edge as a fraction of the lower Nyquist frequency
+constexpr double kRolloff = 0.92;
+
+// Kaiser window shape; about 80 dB stopband attenuation
+constexpr double kKaiserBeta = 8.0;
+
+template<typename Sample>
+const BasicSpectralKernelTable<Sample>& bestKernels();
+
+template<>
+const SpectralKernelTable& bestKernels<double>() {
+    return getSpectralKernels();
+}
+
+template<>
+const SpectralKernelTableF& bestKernels<float>() {
+    return getSpectralKernelsF();
+}
+
+// Modified Bessel function of the first kind, order 0 (power series)
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double quarter_x2 = 0.25 * x * x;
+    for (int k = 1; k < 64 && term > 1e-12 * sum; ++k) {
+        term *= quarter_x2 / (static_cast<double>(k) * static_cast<double>(k));
+        sum += term;
+    }
+    return sum;
+}
+
+double sinc(double x) {
+    if (std::abs(x) < 1e-12) {
+        return 1.0;
+    }
+    return std::sin(M_PI * x) / (M_PI * x);
+}
+
+// Closest fraction L/M to ratio with L <= max_numerator (continued fraction convergents)
+void approximateRatio(double ratio, size_t max_numerator, size_t& numerator, size_t& denominator) {
+    size_t h_prev = 1, h_prev2 = 0;
+    size_t k_prev = 0, k_prev2 = 1;
+    numerator = 0;
+    denominator = 1;
+
+    double x = ratio;
+    for (int term = 0; term < 32; ++term) {
+        double whole = std::floor(x);
+        size_t a = static_cast<size_t>(whole);
+        size_t h = a * h_prev + h_prev2;
+        size_t k = a * k_prev + k_prev2;
+        if (h > max_numerator) {
+            break;
+        }
+        numerator = h;
+        denominator = k;
+
+        double fraction = x - whole;
+        if (fraction < 1e-9) {
+            break;
+        }
+        x = 1.0 / fraction;
+        h_prev2 = h_prev;
+        h_prev = h;
+        k_prev2 = k_prev;
+        k_prev = k;
+    }
+
+    if (numerator == 0) {
+        numerator = 1;
+        denominator = std::max<size_t>(1, static_cast<size_t>(std::lround(1.0 / ratio)));
+    }
+}
+
+} // namespace
+
+template<typename Sample>
+BasicPolyphaseResampler<Sample>::BasicPolyphaseResampler(double ratio)
+    : ratio_(0.0)
+    , interpolation_(1)
+    , decimation_(1)
+    , taps_(0)
+    , window_start_(0)
+    , phase_(0)
+    , kernels_(&bestKernels<Sample>()) {
+    setRatio(ratio > 0.0 ? ratio : 1.0);
+}
+
+template<typename Sample>
+BasicPolyphaseResampler<Sample>::BasicPolyphaseResampler(size_t input_rate, size_t output_rate)
+    : BasicPolyphaseResampler(1.0) {
+    setRates(input_rate, output_rate);
+}
+
+template<typename Sample>
+void BasicPolyphaseResampler<Sample>::setRatio(double ratio) {
+    if (!(ratio > 0.0) || ratio == ratio_) {
+        return;
+    }
+
+    size_t interpolation, decimation;
+    approximateRatio(ratio, kMaxPhases, interpolation, decimation);
+    ratio_ = ratio;
+
+    if (taps_ != 0 && interpolation == interpolation_ && decimation == decimation_) {
+        return;
+    }
+
+    const size_t old_taps = taps_;
+    const size_t old_interpolation = interpolation_;
+    interpolation_ = interpolation;
+    decimation_ = decimation;
+
+    // Widen the kernel when decimating so the transition band stays the same
+    double cutoff = std::min(1.0, static_cast<double>(interpolation_) / static_cast<double>(decimation_));
+    taps_ = static_cast<size_t>(std::ceil(kBaseTaps / cutoff));
+    taps_ += taps_ % 2;
+    buildBank();
+
+    if (old_taps == 0) {
+        // Silence before the first sample: output 0 is centred on input 0
+        history_.assign(taps_ / 2 - 1, Sample(0));
+        window_start_ = 0;
+        phase_ = 0;
+        return;
+    }
+
+    // Keep the next output's centre on the same input sample
+    phase_ = std::min(interpolation_ - 1, phase_ * interpolation_ / old_interpolation);
+    size_t centre = window_start_ + old_taps / 2 - 1;
+    if (centre + 1 < taps_ / 2) {
+        history_.insert(history_.begin(), taps_ / 2 - 1 - centre, Sample(0));
+        centre = taps_ / 2 - 1;
+    }
+    window_start_ = centre + 1 - taps_ / 2;
+}
+
+template<typename Sample>
+void BasicPolyphaseResampler<Sample>::setRates(size_t input_rate, size_t output_rate) {
+    if (input_rate == 0 || output_rate == 0) {
+        return;
+    }
+    size_t divisor = std::gcd(input_rate, output_rate);
+    setRatio(static_cast<double>(output_rate / divisor) / static_cast<double>(input_rate / divisor));
+}
+
+template<typename Sample>
+size_t BasicPolyphaseResampler<Sample>::maxOutputSize(size_t input_count) const {
+    size_t available = history_.size() - window_start_ + input_count;
+    if (available < taps_) {
+        return 0;
+    }
+    return ((available - taps_ + 1) * interpolation_) / decimation_ + 1;
+}
+
+template<typename Sample>
+size_t BasicPolyphaseResampler<Sample>::process(const Sample* input, size_t count,
+                                                std::vector<Sample>& output) {
+    history_.insert(history_.end(), input, input + count);
+
+    const size_t start = output.size();
+    const Sample* bank = bank_.data();
+    while (window_start_ + taps_ <= history_.size()) {
+        output.push_back(kernels_->dot_product(history_.data() + window_start_,
+                                               bank + phase_ * taps_, taps_));
+        phase_ += decimation_;
+        window_start_ += phase_ / interpolation_;
+        phase_ %= interpolation_;
+    }
+
+    // Drop consumed input; the buffer keeps its capacity for the next block
+    history_.erase(history_.begin(), history_.begin() + window_start_);
+    window_start_ = 0;
+    return output.size() - start;
+}
+
+template<typename Sample>
+size_t BasicPolyphaseResampler<Sample>::flush(std::vector<Sample>& output) {
+    const std::vector<Sample> silence(taps_ / 2, Sample(0));
+    size_t produced = process(silence.data(), silence.size(), output);
+    reset();
+    return produced;
+}
+
+template<typename Sample>
+void BasicPolyphaseResampler<Sample>::reset() {
+    history_.assign(taps_ / 2 - 1, Sample(0));
+    window_start_ = 0;
+    phase_ = 0;
+}
+
+template<typename Sample>
+void BasicPolyphaseResampler<Sample>::buildBank() {
+    const double cutoff = kRolloff * std::min(1.0, static_cast<double>(interpolation_) /
+                                                   static_cast<double>(decimation_));
+    const double half = static_cast<double>(taps_) / 2.0;
+    const double window_norm = besselI0(kKaiserBeta);
+
+    bank_.assign(interpolation_ * taps_, Sample(0));
+    std::vector<double> row(taps_);
+    for (size_t phase = 0; phase < interpolation_; ++phase) {
+        // Tap k reads input n - taps/2 + 1 + k for an output at n + phase / L
+        double offset = static_cast<double>(phase) / static_cast<double>(interpolation_);
+        double sum = 0.0;
+        for (size_t k = 0; k < taps_; ++k) {
+            double t = offset + half - 1.0 - static_cast<double>(k);
+            double r = t / half;
+            double window = std::abs(r) < 1.0
+                ? besselI0(kKaiserBeta * std::sqrt(1.0 - r * r)) / window_norm : 0.0;
+            row[k] = cutoff * sinc(cutoff * t) * window;
+            sum += row[k];
+        }
+
+        // Unity DC gain for every phase
+        for (size_t k = 0; k < taps_; ++k) {
+            bank_[phase * taps_ + k] = static_cast<Sample>(row[k] / sum);
+        }
+    }
+}
+
+// Sample types used by the effects chain and the offline converters
+template class BasicPolyphaseResampler<double>;
+template class BasicPolyphaseResampler<float>;
+
+} // namespace AnantaSound
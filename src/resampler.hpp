@@ -0,0 +1,78 @@
+#pragma once
+
+#include "spectral_kernels.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace AnantaSound {
+
+// Streaming polyphase resampler with a Kaiser-windowed sinc filter bank.
+// The output/input rate ratio is held as the fraction L/M (L phases, step M);
+// rates such as 44100 -> 48000 (160/147) are exact, other ratios use the
+// closest fraction with at most kMaxPhases phases. The bank is built once
+// per ratio and every output sample is one SIMD inner product of a phase
+// row with the input history. History and phase carry across blocks, so a
+// stream can be resampled in blocks of any size; output is time-aligned with
+// the input and trails it by getLatency() input samples until flush().
+template<typename Sample>
+class BasicPolyphaseResampler {
+public:
+    static constexpr size_t kMaxPhases = 256;
+    static constexpr size_t kBaseTaps = 32;     // Taps per phase without decimation
+
+private:
+    double ratio_;                  // Requested output/input rate ratio
+    size_t interpolation_;          // L
+    size_t decimation_;             // M
+    size_t taps_;                   // Taps per phase (even)
+    std::vector<Sample> bank_;      // interpolation_ rows of taps_ coefficients
+
+    // Input history: taps_ - 1 samples before the next window plus unread input
+    std::vector<Sample> history_;
+    size_t window_start_;           // history_ index of the next output's first tap
+    size_t phase_;                  // Next output's phase in [0, L)
+    const BasicSpectralKernelTable<Sample>* kernels_;
+
+public:
+    // ratio = output rate / input rate (e.g. 1 / tempo multiplier)
+    explicit BasicPolyphaseResampler(double ratio = 1.0);
+    BasicPolyphaseResampler(size_t input_rate, size_t output_rate);
+
+    // Rebuild the bank for a new ratio; history is kept so the stream continues
+    void setRatio(double ratio);
+    void setRates(size_t input_rate, size_t output_rate);
+
+    double getRatio() const { return ratio_; }
+    size_t getInterpolation() const { return interpolation_; }
+    size_t getDecimation() const { return decimation_; }
+    size_t getTapsPerPhase() const { return taps_; }
+
+    // Input samples an output sample waits for before it can be produced
+    size_t getLatency() const { return taps_ / 2; }
+
+    // Upper bound of the output produced by the next process(count) call
+    size_t maxOutputSize(size_t input_count) const;
+
+    // Resample a block, appending to `output` (its capacity is reused).
+    // Returns the number of samples appended.
+    size_t process(const Sample* input, size_t count, std::vector<Sample>& output);
+
+    // End of stream: feed silence through the filter to emit the samples
+    // still held back, then reset for the next stream
+    size_t flush(std::vector<Sample>& output);
+
+    // Clear history and phase (e.g. after a seek)
+    void reset();
+
+private:
+    void buildBank();
+};
+
+// Instantiated in resampler.cpp
+extern template class BasicPolyphaseResampler<double>;
+extern template class BasicPolyphaseResampler<float>;
+
+using PolyphaseResampler = BasicPolyphaseResampler<double>;
+using PolyphaseResamplerF = BasicPolyphaseResampler<float>;
+
+} // namespace AnantaSound
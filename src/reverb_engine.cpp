@@ -0,0 +1,221 @@
+#include "reverb_engine.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+// Delay line lengths (ms); spread over 30-75 ms for a dense, colourless tail
+constexpr double kLineLengthsMs[BasicFDNReverb<double>::kLineCount] = {
+    29.7, 37.1, 41.1, 43.7, 53.3, 59.9, 67.3, 73.1
+};
+
+// Gain of the first echo tap at level 1.0; later taps halve
+constexpr double kTapDecay = 0.5;
+
+bool isPrime(size_t n) {
+    if (n < 2) {
+        return false;
+    }
+    for (size_t d = 2; d * d <= n; ++d) {
+        if (n % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t nextPrime(size_t n) {
+    while (!isPrime(n)) {
+        ++n;
+    }
+    return n;
+}
+
+} // namespace
+
+template<typename Sample>
+BasicFDNReverb<Sample>::BasicFDNReverb(size_t sample_rate, double decay_time, size_t channels)
+    : sample_rate_(std::max<size_t>(1, sample_rate))
+    , decay_time_(decay_time)
+    , channels_(std::max<size_t>(1, channels)) {
+
+    allocateLines();
+    updateGains();
+}
+
+template<typename Sample>
+void BasicFDNReverb<Sample>::allocateLines() {
+    // Distinct primes, increasing with the nominal lengths
+    size_t previous = 0;
+    for (size_t i = 0; i < kLineCount; ++i) {
+        size_t length = static_cast<size_t>(std::lround(kLineLengthsMs[i] * 1e-3 * sample_rate_));
+        length = nextPrime(std::max(length, previous + 1));
+        lines_[i].buffer.assign(length * channels_, Sample(0));
+        lines_[i].position = 0;
+        previous = length;
+    }
+    taps_.assign(kLineCount * channels_, Sample(0));
+}
+
+template<typename Sample>
+void BasicFDNReverb<Sample>::setChannelCount(size_t channels) {
+    channels_ = std::max<size_t>(1, channels);
+    allocateLines();
+}
+
+template<typename Sample>
+void BasicFDNReverb<Sample>::processFrame(const Sample* input, Sample* wet) {
+    const size_t channels = channels_;
+    Sample* taps = taps_.data();
+
+    // Same recursion as processSample, with the channel loop innermost
+    std::fill(wet, wet + channels, Sample(0));
+    for (size_t i = 0; i < kLineCount; ++i) {
+        const Line& line = lines_[i];
+        const Sample* tap = line.buffer.data() + line.position;
+        Sample* lane = taps + i * channels;
+        for (size_t c = 0; c < channels; ++c) {
+            lane[c] = tap[c] * line.gain;
+            wet[c] += tap[c];
+        }
+    }
+
+    for (size_t half = 1; half < kLineCount; half <<= 1) {
+        for (size_t i = 0; i < kLineCount; i += 2 * half) {
+            for (size_t j = i; j < i + half; ++j) {
+                Sample* a = taps + j * channels;
+                Sample* b = taps + (j + half) * channels;
+                for (size_t c = 0; c < channels; ++c) {
+                    Sample sum = a[c] + b[c];
+                    b[c] = a[c] - b[c];
+                    a[c] = sum;
+                }
+            }
+        }
+    }
+
+    const Sample matrix_scale = Sample(0.35355339059327373);   // 1 / sqrt(8)
+    for (size_t i = 0; i < kLineCount; ++i) {
+        Line& line = lines_[i];
+        Sample* slot = line.buffer.data() + line.position;
+        const Sample* lane = taps + i * channels;
+        for (size_t c = 0; c < channels; ++c) {
+            slot[c] = input[c] + matrix_scale * lane[c];
+        }
+        line.position += channels;
+        if (line.position == line.buffer.size()) {
+            line.position = 0;
+        }
+    }
+
+    for (size_t c = 0; c < channels; ++c) {
+        wet[c] *= matrix_scale;
+    }
+}
+
+template<typename Sample>
+void BasicFDNReverb<Sample>::setDecayTime(double decay_time) {
+    decay_time_ = decay_time;
+    updateGains();
+}
+
+template<typename Sample>
+void BasicFDNReverb<Sample>::reset() {
+    for (Line& line : lines_) {
+        std::fill(line.buffer.begin(), line.buffer.end(), Sample(0));
+        line.position = 0;
+    }
+}
+
+template<typename Sample>
+void BasicFDNReverb<Sample>::updateGains() {
+    // A non-positive decay time silences the feedback path
+    for (Line& line : lines_) {
+        if (decay_time_ <= 0.0) {
+            line.gain = Sample(0);
+            continue;
+        }
+        double seconds = static_cast<double>(line.buffer.size() / channels_) / static_cast<double>(sample_rate_);
+        line.gain = static_cast<Sample>(std::pow(10.0, -3.0 * seconds / decay_time_));
+    }
+}
+
+template<typename Sample>
+BasicMultiTapEcho<Sample>::BasicMultiTapEcho(size_t max_delay, size_t channels)
+    : buffer_((kTapCount * max_delay + 1) * std::max<size_t>(1, channels), Sample(0))
+    , channels_(std::max<size_t>(1, channels))
+    , write_position_(0)
+    , delay_(0) {
+    setLevel(0.3);
+}
+
+template<typename Sample>
+void BasicMultiTapEcho<Sample>::setChannelCount(size_t channels) {
+    const size_t frames = buffer_.size() / channels_;
+    channels_ = std::max<size_t>(1, channels);
+    buffer_.assign(frames * channels_, Sample(0));
+    write_position_ = 0;
+}
+
+template<typename Sample>
+void BasicMultiTapEcho<Sample>::setDelay(size_t delay) {
+    const size_t span = kTapCount * delay;
+    if (span >= buffer_.size() / channels_) {
+        // Unroll the ring so the history stays in order, then grow
+        std::rotate(buffer_.begin(), buffer_.begin() + write_position_, buffer_.end());
+        write_position_ = buffer_.size();
+        buffer_.resize((span + 1) * channels_, Sample(0));
+        write_position_ %= buffer_.size();
+    }
+    delay_ = delay;
+}
+
+template<typename Sample>
+void BasicMultiTapEcho<Sample>::processFrame(const Sample* input, Sample* wet) {
+    const size_t channels = channels_;
+    const size_t size = buffer_.size();
+    std::copy(input, input + channels, buffer_.data() + write_position_);
+
+    std::fill(wet, wet + channels, Sample(0));
+    size_t offset = 0;
+    for (size_t tap = 0; tap < kTapCount; ++tap) {
+        offset += delay_ * channels;
+        size_t read = write_position_ >= offset ? write_position_ - offset
+                                                : write_position_ + size - offset;
+        const Sample* source = buffer_.data() + read;
+        const Sample gain = gains_[tap];
+        for (size_t c = 0; c < channels; ++c) {
+            wet[c] += gain * source[c];
+        }
+    }
+
+    write_position_ += channels;
+    if (write_position_ == size) {
+        write_position_ = 0;
+    }
+}
+
+template<typename Sample>
+void BasicMultiTapEcho<Sample>::setLevel(double level) {
+    double gain = level;
+    for (size_t tap = 0; tap < kTapCount; ++tap) {
+        gains_[tap] = static_cast<Sample>(gain);
+        gain *= kTapDecay;
+    }
+}
+
+template<typename Sample>
+void BasicMultiTapEcho<Sample>::reset() {
+    std::fill(buffer_.begin(), buffer_.end(), Sample(0));
+    write_position_ = 0;
+}
+
+// Sample types used by the effects chain
+template class BasicFDNReverb<double>;
+template class BasicFDNReverb<float>;
+template class BasicMultiTapEcho<double>;
+template class BasicMultiTapEcho<float>;
+
+} // namespace AnantaSound
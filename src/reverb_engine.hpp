@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace AnantaSound {
+
+// Eight-line feedback delay network reverb.
+// Line lengths are fixed, scaled to the sample rate and rounded to distinct
+// primes so the echoes never line up; the lines are allocated once in the constructor and recirculate through a
+// normalized Hadamard matrix, so the per-sample cost is constant. Each line
+// is attenuated by 10^(-3 d / (fs * T60)), giving a 60 dB decay after T60
+// seconds regardless of block size.
+// Several channels share the line lengths and run as independent lanes:
+// each line stores its channels interleaved, so processFrame() moves one
+// contiguous run per line and the matrix acts on all channels at once.
+template<typename Sample>
+class BasicFDNReverb {
+public:
+    static constexpr size_t kLineCount = 8;
+
+private:
+    struct Line {
+        std::vector<Sample> buffer;     // Length x channels, frame-major
+        size_t position;            // Read and write position (oldest frame, in samples)
+        Sample gain;                // Per-pass attenuation for the decay time
+
+        Line() : position(0), gain(0) {}
+    };
+
+    size_t sample_rate_;
+    double decay_time_;             // T60 (s)
+    size_t channels_;
+    Line lines_[kLineCount];
+    std::vector<Sample> taps_;      // kLineCount x channels work area of processFrame
+
+public:
+    explicit BasicFDNReverb(size_t sample_rate = 44100, double decay_time = 1.5, size_t channels = 1);
+
+    // Resizes the lines and clears the tail
+    void setChannelCount(size_t channels);
+    size_t getChannelCount() const { return channels_; }
+
+    // T60 in seconds; recomputes the line gains only
+    void setDecayTime(double decay_time);
+    double getDecayTime() const { return decay_time_; }
+
+    // Delay of line `index` in samples
+    size_t getLineLength(size_t index) const { return lines_[index].buffer.size() / channels_; }
+
+    // Wet output for one input sample (single-channel reverb)
+    Sample processSample(Sample input) {
+        Sample taps[kLineCount];
+        Sample wet = Sample(0);
+        for (size_t i = 0; i < kLineCount; ++i) {
+            const Line& line = lines_[i];
+            Sample tap = line.buffer[line.position];
+            taps[i] = tap * line.gain;
+            wet += tap;
+        }
+
+        // Fast Walsh-Hadamard transform: orthogonal after the 1/sqrt(8) scale
+        for (size_t half = 1; half < kLineCount; half <<= 1) {
+            for (size_t i = 0; i < kLineCount; i += 2 * half) {
+                for (size_t j = i; j < i + half; ++j) {
+                    Sample a = taps[j];
+                    Sample b = taps[j + half];
+                    taps[j] = a + b;
+                    taps[j + half] = a - b;
+                }
+            }
+        }
+
+        const Sample matrix_scale = Sample(0.35355339059327373);   // 1 / sqrt(8)
+        for (size_t i = 0; i < kLineCount; ++i) {
+            Line& line = lines_[i];
+            line.buffer[line.position] = input + matrix_scale * taps[i];
+            if (++line.position == line.buffer.size()) {
+                line.position = 0;
+            }
+        }
+
+        return wet * matrix_scale;
+    }
+
+    // Wet output of one frame of getChannelCount() samples
+    void processFrame(const Sample* input, Sample* wet);
+
+    void reset();
+
+private:
+    void allocateLines();
+    void updateGains();
+};
+
+// Echo with several equally spaced taps read from one circular buffer.
+// Tap k (1-based) sits at k * delay with gain level * 0.5^(k-1). The buffer
+// covers kTapCount times the longest expected delay and is allocated once.
+// With several channels the buffer holds interleaved frames, one lane each.
+template<typename Sample>
+class BasicMultiTapEcho {
+public:
+    static constexpr size_t kTapCount = 3;
+
+private:
+    std::vector<Sample> buffer_;    // Frames x channels, frame-major
+    size_t channels_;
+    size_t write_position_;         // In samples; a multiple of channels_
+    size_t delay_;                  // Spacing between taps (frames)
+    Sample gains_[kTapCount];
+
+public:
+    explicit BasicMultiTapEcho(size_t max_delay = 44100, size_t channels = 1);
+
+    // Resizes the buffer and clears the history
+    void setChannelCount(size_t channels);
+    size_t getChannelCount() const { return channels_; }
+
+    // Tap spacing in samples; grows the buffer only past max_delay
+    void setDelay(size_t delay);
+    size_t getDelay() const { return delay_; }
+
+    // Gain of the first tap; later taps halve
+    void setLevel(double level);
+
+    // Wet output (sum of the taps) for one input sample (single channel)
+    Sample processSample(Sample input) {
+        const size_t size = buffer_.size();
+        buffer_[write_position_] = input;
+
+        Sample wet = Sample(0);
+        size_t offset = 0;
+        for (size_t tap = 0; tap < kTapCount; ++tap) {
+            offset += delay_;
+            size_t read = write_position_ >= offset ? write_position_ - offset
+                                                    : write_position_ + size - offset;
+            wet += gains_[tap] * buffer_[read];
+        }
+
+        if (++write_position_ == size) {
+            write_position_ = 0;
+        }
+        return wet;
+    }
+
+    // Wet output of one frame of getChannelCount() samples
+    void processFrame(const Sample* input, Sample* wet);
+
+    void reset();
+};
+
+// Instantiated in reverb_engine.cpp
+extern template class BasicFDNReverb<double>;
+extern template class BasicFDNReverb<float>;
+extern template class BasicMultiTapEcho<double>;
+extern template class BasicMultiTapEcho<float>;
+
+using FDNReverb = BasicFDNReverb<double>;
+using FDNReverbF = BasicFDNReverb<float>;
+using MultiTapEcho = BasicMultiTapEcho<double>;
+using MultiTapEchoF = BasicMultiTapEcho<float>;
+
+} // namespace AnantaSound
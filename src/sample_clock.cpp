@@ -0,0 +1,36 @@
+#include "sample_clock.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+SampleClock::SampleClock(double sample_rate)
+    : sample_rate_(sample_rate > 0.0 ? sample_rate : 48000.0)
+    , origin_(std::chrono::high_resolution_clock::now())
+    , sample_(0) {
+}
+
+SampleClock& SampleClock::shared() {
+    static SampleClock clock;
+    return clock;
+}
+
+ClockTick SampleClock::advance(uint64_t sample_count) {
+    uint64_t sample = sample_.fetch_add(sample_count, std::memory_order_acq_rel) + sample_count;
+    return tickAt(sample);
+}
+
+ClockTick SampleClock::advanceSeconds(double dt) {
+    return advance(static_cast<uint64_t>(std::llround(std::max(dt, 0.0) * sample_rate_)));
+}
+
+ClockTick SampleClock::tickAt(uint64_t sample) const {
+    ClockTick tick;
+    tick.sample = sample;
+    tick.seconds = static_cast<double>(sample) / sample_rate_;
+    tick.timestamp = origin_ + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+        std::chrono::duration<double>(tick.seconds));
+    return tick;
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace AnantaSound {
+
+// One tick of a SampleClock. Every field generated during a tick carries the
+// same timestamp, so fields of different generators compare and phase-align
+// exactly.
+struct ClockTick {
+    uint64_t sample = 0;        // Samples since the clock started
+    double seconds = 0.0;       // sample / sample_rate
+    std::chrono::high_resolution_clock::time_point timestamp;  // origin + seconds
+};
+
+// Monotonic sample clock shared by field generators.
+// The wall clock is read once, at construction; afterwards time only moves
+// when the owner advances the clock by whole samples, and timestamps are
+// derived arithmetically from the sample count. Reading the current tick is
+// a single atomic load, cheap enough to do once per generator call instead
+// of once per field. advance() and current() may be called from any thread.
+class SampleClock {
+public:
+    using TimePoint = std::chrono::high_resolution_clock::time_point;
+
+private:
+    double sample_rate_;
+    TimePoint origin_;
+    std::atomic<uint64_t> sample_;
+
+public:
+    explicit SampleClock(double sample_rate = 48000.0);
+
+    SampleClock(const SampleClock&) = delete;
+    SampleClock& operator=(const SampleClock&) = delete;
+
+    // Library-wide default clock; the application advances it
+    static SampleClock& shared();
+
+    // Move forward by sample_count samples and return the new tick
+    ClockTick advance(uint64_t sample_count);
+
+    // Move forward by dt seconds, rounded to whole samples (negative dt is ignored)
+    ClockTick advanceSeconds(double dt);
+
+    ClockTick current() const { return tickAt(sample_.load(std::memory_order_acquire)); }
+    TimePoint now() const { return current().timestamp; }
+    ClockTick tickAt(uint64_t sample) const;
+
+    double getSampleRate() const { return sample_rate_; }
+    TimePoint getOrigin() const { return origin_; }
+};
+
+} // namespace AnantaSound
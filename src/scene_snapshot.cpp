@@ -0,0 +1,478 @@
+#include "scene_snapshot.hpp"
+#include "mechanical_devices.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AnantaSound {
+
+namespace {
+
+constexpr size_t kSectionAlignment = 64;
+
+static_assert(sizeof(SceneHeader) == 64, "SceneHeader is part of the file format");
+static_assert(sizeof(SceneSection) == 24, "SceneSection is part of the file format");
+static_assert(sizeof(SceneInterferenceRecord) == 88, "SceneInterferenceRecord is part of the file format");
+static_assert(sizeof(SceneDeviceRecord) == 80, "SceneDeviceRecord is part of the file format");
+static_assert(sizeof(SceneClusterElementRecord) == 16, "SceneClusterElementRecord is part of the file format");
+
+size_t alignSection(size_t offset) {
+    return (offset + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+}
+
+// Sections are assembled in memory and laid out by finish()
+class SceneWriter {
+private:
+    struct Pending {
+        uint32_t tag;
+        uint32_t record_size;
+        uint64_t count;
+        std::vector<uint8_t> bytes;
+    };
+    std::vector<Pending> sections_;
+
+public:
+    template<typename Record>
+    void add(uint32_t tag, const std::vector<Record>& records) {
+        Pending section{tag, static_cast<uint32_t>(sizeof(Record)), records.size(), {}};
+        section.bytes.resize(records.size() * sizeof(Record));
+        if (!records.empty()) {
+            std::memcpy(section.bytes.data(), records.data(), section.bytes.size());
+        }
+        sections_.push_back(std::move(section));
+    }
+
+    void addFields(uint32_t base, const std::vector<QuantumSoundField>& fields) {
+        std::vector<double> components[kSceneFieldComponentCount];
+        std::vector<uint8_t> states;
+        for (auto& component : components) {
+            component.reserve(fields.size());
+        }
+        states.reserve(fields.size());
+        for (const auto& field : fields) {
+            components[kSceneAmplitudeReal].push_back(field.amplitude.real());
+            components[kSceneAmplitudeImag].push_back(field.amplitude.imag());
+            components[kScenePhase].push_back(field.phase);
+            components[kSceneFrequency].push_back(field.frequency);
+            states.push_back(static_cast<uint8_t>(field.quantum_state));
+            components[kSceneRadius].push_back(field.position.r);
+            components[kScenePolar].push_back(field.position.theta);
+            components[kSceneAzimuth].push_back(field.position.phi);
+            components[kSceneTime].push_back(field.position.t);
+            components[kSceneHeight].push_back(field.position.height);
+        }
+        for (uint32_t component = 0; component < kSceneFieldComponentCount; ++component) {
+            if (component == kSceneState) {
+                add(base + component, states);
+            } else {
+                add(base + component, components[component]);
+            }
+        }
+    }
+
+    bool finish(const std::string& path, SceneHeader header) const {
+        size_t offset = alignSection(sizeof(SceneHeader) + sections_.size() * sizeof(SceneSection));
+        std::vector<SceneSection> table;
+        for (const auto& section : sections_) {
+            table.push_back({section.tag, section.record_size, offset, section.count});
+            offset = alignSection(offset + section.bytes.size());
+        }
+        header.file_size = offset;
+        header.section_count = static_cast<uint32_t>(table.size());
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to create scene file: " << path << std::endl;
+            return false;
+        }
+        std::vector<uint8_t> image(offset, 0);
+        std::memcpy(image.data(), &header, sizeof(header));
+        std::memcpy(image.data() + sizeof(header), table.data(), table.size() * sizeof(SceneSection));
+        for (size_t i = 0; i < sections_.size(); ++i) {
+            if (!sections_[i].bytes.empty()) {
+                std::memcpy(image.data() + table[i].offset, sections_[i].bytes.data(), sections_[i].bytes.size());
+            }
+        }
+        out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+        if (!out) {
+            std::cerr << "Failed to write scene file: " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+};
+
+void storePosition(const SphericalCoord& position, double* out) {
+    out[0] = position.r;
+    out[1] = position.theta;
+    out[2] = position.phi;
+    out[3] = position.t;
+    out[4] = position.height;
+}
+
+SphericalCoord loadPosition(const double* in) {
+    return SphericalCoord(in[0], in[1], in[2], in[3], in[4]);
+}
+
+SceneDeviceRecord describeDevice(const MechanicalDevice& device) {
+    SceneDeviceRecord record{};
+    record.type = static_cast<uint32_t>(device.getDeviceType());
+    record.active = device.isActive() ? 1 : 0;
+    record.vibration = device.isVibrationEnabled() ? 1 : 0;
+    storePosition(device.getPosition(), record.position);
+    return record;
+}
+
+} // namespace
+
+// SceneFieldArrays
+QuantumSoundField SceneFieldArrays::get(size_t index) const {
+    QuantumSoundField field;
+    field.amplitude = std::complex<double>(amplitude_real[index], amplitude_imag[index]);
+    field.phase = phase[index];
+    field.frequency = frequency[index];
+    field.quantum_state = static_cast<QuantumSoundState>(state[index]);
+    field.position = SphericalCoord(r[index], theta[index], phi[index], t[index], height[index]);
+    return field;
+}
+
+bool saveScene(const std::string& path, const AnantaSoundCore& core, const MechanicalDeviceManager* devices) {
+    SceneWriter writer;
+    writer.addFields(kSceneSoundFields, core.getOutputFields());
+
+    std::vector<QuantumSoundField> sources;
+    std::vector<SceneInterferenceRecord> fields;
+    std::vector<SceneEntanglementRecord> pairs;
+    for (size_t i = 0; i < core.getInterferenceFieldCount(); ++i) {
+        const InterferenceField* field = core.getInterferenceField(core.getInterferenceFieldHandle(i));
+        if (!field) {
+            continue;
+        }
+        SceneInterferenceRecord record{};
+        record.type = static_cast<uint32_t>(field->getType());
+        storePosition(field->getCenter(), record.center);
+        record.radius = field->getFieldRadius();
+
+        std::vector<QuantumSoundField> field_sources = field->getSourceFields();
+        record.source_begin = sources.size();
+        record.source_count = field_sources.size();
+        sources.insert(sources.end(), field_sources.begin(), field_sources.end());
+
+        record.pair_begin = pairs.size();
+        for (const auto& pair : field->getEntangledPairs()) {
+            pairs.push_back({static_cast<uint32_t>(pair.first), static_cast<uint32_t>(pair.second)});
+        }
+        record.pair_count = pairs.size() - record.pair_begin;
+        fields.push_back(record);
+    }
+    writer.addFields(kSceneSources, sources);
+    writer.add(kSceneInterferenceFields, fields);
+    writer.add(kSceneEntanglement, pairs);
+
+    // Only the field-emitting device kinds carry state worth restoring
+    std::vector<SceneDeviceRecord> device_records;
+    std::vector<SceneClusterElementRecord> elements;
+    for (size_t i = 0; devices && i < devices->getDeviceCount(); ++i) {
+        std::shared_ptr<MechanicalDevice> device = devices->getDevice(i);
+        if (auto* karmic = dynamic_cast<const KarmicCluster*>(device.get())) {
+            SceneDeviceRecord record = describeDevice(*karmic);
+            record.enabled = karmic->isHealingEnabled() ? 1 : 0;
+            record.primary = karmic->getKarmicResonance();
+            record.element_begin = elements.size();
+            for (const auto& element : karmic->getClusterElements()) {
+                SceneClusterElementRecord stored{};
+                stored.karmic_charge = element.karmic_charge;
+                stored.active = element.is_active ? 1 : 0;
+                elements.push_back(stored);
+            }
+            record.element_count = elements.size() - record.element_begin;
+            device_records.push_back(record);
+        } else if (auto* mercy = dynamic_cast<const SpiritualMercy*>(device.get())) {
+            SceneDeviceRecord record = describeDevice(*mercy);
+            record.enabled = mercy->isForgivenessEnabled() ? 1 : 0;
+            record.primary = mercy->getMercyLevel();
+            record.secondary = mercy->getCompassionRadius();
+            device_records.push_back(record);
+        } else if (auto* resonance = dynamic_cast<const QuantumResonanceDevice*>(device.get())) {
+            SceneDeviceRecord record = describeDevice(*resonance);
+            record.enabled = resonance->isEntanglementEnabled() ? 1 : 0;
+            record.primary = resonance->getResonanceFrequency();
+            record.secondary = resonance->getQuantumCoherence();
+            device_records.push_back(record);
+        }
+    }
+    writer.add(kSceneDevices, device_records);
+    writer.add(kSceneClusterElements, elements);
+
+    SceneHeader header{};
+    std::memcpy(header.magic, kSceneMagic, sizeof(kSceneMagic));
+    header.version = kSceneFormatVersion;
+    header.byte_order = kSceneByteOrderMark;
+    header.dome_radius = core.getDomeRadius();
+    header.dome_height = core.getDomeHeight();
+    header.phase_coupling = core.getPhaseCoupling();
+    return writer.finish(path, header);
+}
+
+// SceneImage
+SceneImage::SceneImage()
+    : mapping_(nullptr)
+    , mapping_size_(0)
+    , header_(nullptr)
+    , sections_(nullptr) {
+}
+
+SceneImage::~SceneImage() {
+    close();
+}
+
+bool SceneImage::open(const std::string& path) {
+    close();
+#if defined(_WIN32)
+    std::cerr << "Memory-mapped scene loading is not available on this platform" << std::endl;
+    return false;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open scene file: " << path << std::endl;
+        return false;
+    }
+
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(SceneHeader)) {
+        ::close(fd);
+        std::cerr << "Failed to stat scene file: " << path << std::endl;
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(file_stat.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        std::cerr << "Failed to map scene file: " << path << std::endl;
+        return false;
+    }
+
+    mapping_ = static_cast<const uint8_t*>(address);
+    mapping_size_ = size;
+    header_ = reinterpret_cast<const SceneHeader*>(mapping_);
+    sections_ = reinterpret_cast<const SceneSection*>(mapping_ + sizeof(SceneHeader));
+    if (!validate()) {
+        std::cerr << "Invalid or unsupported scene file: " << path << std::endl;
+        close();
+        return false;
+    }
+    return true;
+#endif
+}
+
+void SceneImage::close() {
+#if !defined(_WIN32)
+    if (mapping_ != nullptr) {
+        ::munmap(const_cast<uint8_t*>(mapping_), mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    header_ = nullptr;
+    sections_ = nullptr;
+}
+
+bool SceneImage::validate() const {
+    if (std::memcmp(header_->magic, kSceneMagic, sizeof(kSceneMagic)) != 0 ||
+        header_->version != kSceneFormatVersion || header_->byte_order != kSceneByteOrderMark ||
+        header_->file_size != mapping_size_) {
+        return false;
+    }
+    if (header_->section_count > (mapping_size_ - sizeof(SceneHeader)) / sizeof(SceneSection)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header_->section_count; ++i) {
+        const SceneSection& section = sections_[i];
+        if (section.record_size == 0 || section.offset % kSectionAlignment != 0 || section.offset > mapping_size_ ||
+            section.count > (mapping_size_ - section.offset) / section.record_size) {
+            return false;
+        }
+    }
+
+    // Cross-references between sections
+    SceneFieldArrays sound = soundFields();
+    SceneFieldArrays stored_sources = sources();
+    size_t field_count = 0, pair_count = 0, device_count = 0, element_count = 0;
+    const SceneInterferenceRecord* fields = interferenceFields(field_count);
+    const SceneEntanglementRecord* pairs = entanglement(pair_count);
+    const SceneDeviceRecord* device_records = devices(device_count);
+    clusterElements(element_count);
+    if (!sound.amplitude_real || !stored_sources.amplitude_real || !fields || !pairs || !device_records) {
+        return false;
+    }
+    for (size_t i = 0; i < field_count; ++i) {
+        const SceneInterferenceRecord& field = fields[i];
+        if (field.type > static_cast<uint32_t>(InterferenceFieldType::QUANTUM_ENTANGLED) ||
+            field.source_begin > stored_sources.count ||
+            field.source_count > stored_sources.count - field.source_begin ||
+            field.pair_begin > pair_count || field.pair_count > pair_count - field.pair_begin) {
+            return false;
+        }
+        for (size_t p = field.pair_begin; p < field.pair_begin + field.pair_count; ++p) {
+            if (pairs[p].first >= field.source_count || pairs[p].second >= field.source_count) {
+                return false;
+            }
+        }
+    }
+    for (size_t i = 0; i < device_count; ++i) {
+        const SceneDeviceRecord& device = device_records[i];
+        if (device.type > static_cast<uint32_t>(DeviceType::QUANTUM_RESONANCE) ||
+            device.element_begin > element_count || device.element_count > element_count - device.element_begin) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const SceneSection* SceneImage::findSection(uint32_t tag) const {
+    for (uint32_t i = 0; i < header_->section_count; ++i) {
+        if (sections_[i].tag == tag) {
+            return &sections_[i];
+        }
+    }
+    return nullptr;
+}
+
+template<typename Record>
+const Record* SceneImage::records(uint32_t tag, size_t& count) const {
+    count = 0;
+    const SceneSection* section = findSection(tag);
+    if (!section || section->record_size != sizeof(Record)) {
+        return nullptr;
+    }
+    count = static_cast<size_t>(section->count);
+    return reinterpret_cast<const Record*>(mapping_ + section->offset);
+}
+
+SceneFieldArrays SceneImage::fieldArrays(uint32_t base) const {
+    SceneFieldArrays arrays{};
+    const double** components[kSceneFieldComponentCount] = {
+        &arrays.amplitude_real, &arrays.amplitude_imag, &arrays.phase, &arrays.frequency, nullptr,
+        &arrays.r, &arrays.theta, &arrays.phi, &arrays.t, &arrays.height
+    };
+    size_t count = 0;
+    arrays.state = records<uint8_t>(base + kSceneState, count);
+    arrays.count = count;
+    for (uint32_t component = 0; component < kSceneFieldComponentCount; ++component) {
+        if (component == kSceneState) {
+            continue;
+        }
+        *components[component] = records<double>(base + component, count);
+        if (!*components[component] || count != arrays.count || !arrays.state) {
+            return SceneFieldArrays{};
+        }
+    }
+    return arrays;
+}
+
+const SceneInterferenceRecord* SceneImage::interferenceFields(size_t& count) const {
+    return records<SceneInterferenceRecord>(kSceneInterferenceFields, count);
+}
+
+const SceneEntanglementRecord* SceneImage::entanglement(size_t& count) const {
+    return records<SceneEntanglementRecord>(kSceneEntanglement, count);
+}
+
+const SceneDeviceRecord* SceneImage::devices(size_t& count) const {
+    return records<SceneDeviceRecord>(kSceneDevices, count);
+}
+
+const SceneClusterElementRecord* SceneImage::clusterElements(size_t& count) const {
+    return records<SceneClusterElementRecord>(kSceneClusterElements, count);
+}
+
+bool SceneImage::restore(AnantaSoundCore& core, MechanicalDeviceManager* devices) const {
+    if (!isOpen() || !core.isInitialized()) {
+        return false;
+    }
+
+    SceneFieldArrays sound = soundFields();
+    std::vector<QuantumSoundField> fields(sound.count);
+    for (size_t i = 0; i < sound.count; ++i) {
+        fields[i] = sound.get(i);
+    }
+    core.restoreSoundFields(fields);
+    core.setPhaseCoupling(header_->phase_coupling);
+
+    // One snapshot publication per interference field
+    SceneFieldArrays stored_sources = sources();
+    size_t field_count = 0, pair_count = 0;
+    const SceneInterferenceRecord* records = interferenceFields(field_count);
+    const SceneEntanglementRecord* pairs = entanglement(pair_count);
+    for (size_t i = 0; i < field_count; ++i) {
+        const SceneInterferenceRecord& record = records[i];
+        auto field = std::make_unique<InterferenceField>(static_cast<InterferenceFieldType>(record.type),
+                                                         loadPosition(record.center), record.radius);
+        std::vector<QuantumSoundField> field_sources(record.source_count);
+        for (size_t s = 0; s < record.source_count; ++s) {
+            field_sources[s] = stored_sources.get(record.source_begin + s);
+        }
+        std::vector<InterferenceField::SourceHandle> handles = field->addSourceFields(field_sources);
+        for (size_t p = record.pair_begin; p < record.pair_begin + record.pair_count; ++p) {
+            field->createQuantumEntanglement(handles[pairs[p].first], handles[pairs[p].second]);
+        }
+        core.addInterferenceField(std::move(field));
+    }
+
+    if (devices) {
+        size_t device_count = 0, element_count = 0;
+        const SceneDeviceRecord* device_records = this->devices(device_count);
+        const SceneClusterElementRecord* elements = clusterElements(element_count);
+        for (size_t i = 0; i < device_count; ++i) {
+            const SceneDeviceRecord& record = device_records[i];
+            SphericalCoord position = loadPosition(record.position);
+            std::shared_ptr<MechanicalDevice> device;
+            switch (static_cast<DeviceType>(record.type)) {
+                case DeviceType::KARMIC_CLUSTER: {
+                    auto karmic = std::make_shared<KarmicCluster>(position, record.element_count);
+                    karmic->setKarmicResonance(record.primary);
+                    karmic->setHealingEnabled(record.enabled != 0);
+                    for (size_t e = 0; e < record.element_count; ++e) {
+                        const SceneClusterElementRecord& element = elements[record.element_begin + e];
+                        karmic->updateKarmicCharge(e, element.karmic_charge);
+                        if (!element.active) {
+                            karmic->deactivateElement(e);
+                        }
+                    }
+                    device = karmic;
+                    break;
+                }
+                case DeviceType::SPIRITUAL_MERCY: {
+                    auto mercy = std::make_shared<SpiritualMercy>(position, record.primary);
+                    mercy->setForgivenessEnabled(record.enabled != 0);
+                    mercy->setCompassionRadius(record.secondary);
+                    device = mercy;
+                    break;
+                }
+                case DeviceType::QUANTUM_RESONANCE: {
+                    auto resonance = std::make_shared<QuantumResonanceDevice>(position, record.primary);
+                    resonance->setQuantumCoherence(record.secondary);
+                    resonance->setEntanglementEnabled(record.enabled != 0);
+                    device = resonance;
+                    break;
+                }
+            }
+            device->setActive(record.active != 0);
+            device->setVibrationEnabled(record.vibration != 0);
+            devices->addDevice(device);
+        }
+    }
+    return true;
+}
+
+} // namespace AnantaSound
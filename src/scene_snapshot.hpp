@@ -0,0 +1,165 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace AnantaSound {
+
+class MechanicalDeviceManager;
+
+// Binary scene snapshot: everything needed to bring a show back after a
+// restart or failover without replaying addInterferenceField /
+// addSourceField / addDevice calls.
+//
+// Layout (native byte order, checked on open):
+//   SceneHeader | SceneSection table | sections, each 64-byte aligned
+// Sections are flat arrays of fixed-size records, so the file is used in
+// place through a read-only mapping: SceneImage::open validates the header
+// and the section bounds once and then hands out pointers into the mapping.
+// Sound fields and interference sources are stored structure-of-arrays
+// (one section per component). Timestamps and device clock ticks are not
+// stored; the restored scene is stamped by the running clock.
+constexpr char kSceneMagic[8] = {'A', 'N', 'S', 'C', 'E', 'N', 'E', '\0'};
+constexpr uint32_t kSceneFormatVersion = 1;
+constexpr uint32_t kSceneByteOrderMark = 0x01020304;
+
+struct SceneHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t file_size;
+    uint32_t section_count;
+    uint32_t reserved;
+    double dome_radius;
+    double dome_height;
+    double phase_coupling;
+    uint64_t reserved_tail;
+};
+
+struct SceneSection {
+    uint32_t tag;
+    uint32_t record_size;       // sizeof one element, checked on open
+    uint64_t offset;            // From the start of the file
+    uint64_t count;
+};
+
+// Component arrays of a field set; tags are base + component
+enum SceneFieldComponent : uint32_t {
+    kSceneAmplitudeReal, kSceneAmplitudeImag, kScenePhase, kSceneFrequency, kSceneState,
+    kSceneRadius, kScenePolar, kSceneAzimuth, kSceneTime, kSceneHeight,
+    kSceneFieldComponentCount
+};
+
+enum SceneSectionTag : uint32_t {
+    kSceneSoundFields = 0x100,          // + SceneFieldComponent
+    kSceneSources = 0x200,              // + SceneFieldComponent, all fields back to back
+    kSceneInterferenceFields = 0x300,   // SceneInterferenceRecord
+    kSceneEntanglement = 0x301,         // SceneEntanglementRecord
+    kSceneDevices = 0x400,              // SceneDeviceRecord
+    kSceneClusterElements = 0x401       // SceneClusterElementRecord
+};
+
+struct SceneInterferenceRecord {
+    uint32_t type;              // InterferenceFieldType
+    uint32_t reserved;
+    double center[5];           // r, theta, phi, t, height
+    double radius;
+    uint64_t source_begin;      // Into the source arrays
+    uint64_t source_count;
+    uint64_t pair_begin;        // Into kSceneEntanglement
+    uint64_t pair_count;
+};
+
+struct SceneEntanglementRecord {
+    uint32_t first;             // Source positions within the field
+    uint32_t second;
+};
+
+struct SceneDeviceRecord {
+    uint32_t type;              // DeviceType
+    uint8_t active;
+    uint8_t vibration;
+    uint8_t enabled;            // Healing / forgiveness / entanglement by type
+    uint8_t reserved;
+    double position[5];
+    double primary;             // Karmic resonance / mercy level / resonance frequency
+    double secondary;           // - / compassion radius / quantum coherence
+    uint64_t element_begin;     // Karmic clusters: into kSceneClusterElements
+    uint64_t element_count;
+};
+
+struct SceneClusterElementRecord {
+    double karmic_charge;
+    uint8_t active;
+    uint8_t reserved[7];
+};
+
+// Pointers into one SoA field set of an open image
+struct SceneFieldArrays {
+    const double* amplitude_real;
+    const double* amplitude_imag;
+    const double* phase;
+    const double* frequency;
+    const uint8_t* state;
+    const double* r;
+    const double* theta;
+    const double* phi;
+    const double* t;
+    const double* height;
+    size_t count;
+
+    QuantumSoundField get(size_t index) const;
+};
+
+// Write the scene of a core (and optionally its devices); false on I/O error
+bool saveScene(const std::string& path, const AnantaSoundCore& core,
+               const MechanicalDeviceManager* devices = nullptr);
+
+// Read-only memory-mapped scene file
+class SceneImage {
+private:
+    const uint8_t* mapping_;
+    size_t mapping_size_;
+    const SceneHeader* header_;
+    const SceneSection* sections_;
+
+    const SceneSection* findSection(uint32_t tag) const;
+    bool validate() const;
+
+    template<typename Record>
+    const Record* records(uint32_t tag, size_t& count) const;
+
+    SceneFieldArrays fieldArrays(uint32_t base) const;
+
+public:
+    SceneImage();
+    ~SceneImage();
+
+    SceneImage(const SceneImage&) = delete;
+    SceneImage& operator=(const SceneImage&) = delete;
+
+    // Map and validate a file; false (and closed) when it is not a scene of
+    // this format version
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapping_ != nullptr; }
+
+    double getDomeRadius() const { return header_->dome_radius; }
+    double getDomeHeight() const { return header_->dome_height; }
+    double getPhaseCoupling() const { return header_->phase_coupling; }
+
+    SceneFieldArrays soundFields() const { return fieldArrays(kSceneSoundFields); }
+    SceneFieldArrays sources() const { return fieldArrays(kSceneSources); }
+    const SceneInterferenceRecord* interferenceFields(size_t& count) const;
+    const SceneEntanglementRecord* entanglement(size_t& count) const;
+    const SceneDeviceRecord* devices(size_t& count) const;
+    const SceneClusterElementRecord* clusterElements(size_t& count) const;
+
+    // Rebuild the scene: the core's sound fields are replaced, interference
+    // fields and devices are appended. The core must be initialized.
+    bool restore(AnantaSoundCore& core, MechanicalDeviceManager* devices = nullptr) const;
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,265 @@
+#include "session_pool.hpp"
+#include "anantasound_core.hpp"
+#include "instrumentation.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace AnantaSound {
+
+namespace {
+
+// Same weight of the previous block as AdaptiveAudioProcessor's smoothing
+constexpr double kSmoothingFactor = 0.3;
+
+double blend(double next, double previous) {
+    return (1.0 - kSmoothingFactor) * next + kSmoothingFactor * previous;
+}
+
+AdaptationParameters smoothParameters(const AdaptationParameters& next, const AdaptationParameters& previous) {
+    AdaptationParameters smoothed;
+    smoothed.volume_multiplier = blend(next.volume_multiplier, previous.volume_multiplier);
+    smoothed.tempo_multiplier = blend(next.tempo_multiplier, previous.tempo_multiplier);
+    smoothed.bass_boost = blend(next.bass_boost, previous.bass_boost);
+    smoothed.treble_boost = blend(next.treble_boost, previous.treble_boost);
+    smoothed.reverb_amount = blend(next.reverb_amount, previous.reverb_amount);
+    smoothed.echo_delay = blend(next.echo_delay, previous.echo_delay);
+    return smoothed;
+}
+
+} // namespace
+
+// Session
+template<typename Sample>
+BasicSessionPool<Sample>::Session::Session(size_t fft_size, size_t sample_rate, double reverb_time,
+                                           std::shared_ptr<const FFTPlan> tempo_plan)
+    : breathing(fft_size, sample_rate)
+    , chain(sample_rate)
+    , tempo(fft_size, sample_rate, fft_size, TempoTrackerOptions(), std::move(tempo_plan))
+    , has_previous(false)
+    , history_next(0)
+    , history_count(0)
+    , focused(true) {
+    chain.setReverbTime(reverb_time);
+    emotion_counts.fill(0);
+}
+
+template<typename Sample>
+void BasicSessionPool<Sample>::Session::recordEmotion(EmotionalState emotion) {
+    if (history_count == kHistorySize) {
+        emotion_counts[static_cast<size_t>(emotions[history_next])]--;
+    } else {
+        history_count++;
+    }
+    emotions[history_next] = emotion;
+    emotion_counts[static_cast<size_t>(emotion)]++;
+    history_next = (history_next + 1) % kHistorySize;
+}
+
+// BasicSessionPool
+template<typename Sample>
+BasicSessionPool<Sample>::BasicSessionPool(size_t fft_size, size_t sample_rate, size_t max_sessions)
+    : fft_size_(fft_size)
+    , sample_rate_(sample_rate)
+    , classifier_(fft_size, sample_rate)
+    , reverb_time_(BasicEffectsChain<Sample>(sample_rate).getReverbTime())
+    , tempo_plan_(sharedFFTPlan<double>(TempoTracker::getTransformSize(sample_rate, fft_size)))
+    , slots_(max_sessions)
+    , active_count_(0)
+    , analyze_unfocused_(true) {
+    for (size_t i = 0; i < kEmotionalStateCount; ++i) {
+        presets_[i] = classifier_.getAdaptationParameters(static_cast<EmotionalState>(i));
+    }
+
+    // Lowest ids are handed out first
+    free_slots_.reserve(max_sessions);
+    for (size_t i = max_sessions; i > 0; --i) {
+        free_slots_.push_back(i - 1);
+    }
+}
+
+template<typename Sample>
+bool BasicSessionPool<Sample>::initialize() {
+    if (!classifier_.initialize()) {
+        return false;
+    }
+    scratch_.clear();
+    scratch_.push_back(makeScratch());
+    return true;
+}
+
+template<typename Sample>
+size_t BasicSessionPool<Sample>::addSession() {
+    if (free_slots_.empty()) {
+        std::cerr << "SessionPool: all " << slots_.size() << " sessions are in use" << std::endl;
+        return npos;
+    }
+    size_t session = free_slots_.back();
+    free_slots_.pop_back();
+    slots_[session].emplace(fft_size_, sample_rate_, reverb_time_, tempo_plan_);
+    active_count_++;
+    return session;
+}
+
+template<typename Sample>
+bool BasicSessionPool<Sample>::removeSession(size_t session) {
+    if (!hasSession(session)) {
+        return false;
+    }
+    slots_[session].reset();
+    free_slots_.push_back(session);
+    active_count_--;
+    return true;
+}
+
+template<typename Sample>
+bool BasicSessionPool<Sample>::hasSession(size_t session) const {
+    return session < slots_.size() && slots_[session].has_value();
+}
+
+template<typename Sample>
+void BasicSessionPool<Sample>::process(const std::vector<BasicSessionBlock<Sample>>& blocks,
+                                       std::vector<SessionResult>& results) {
+    results.resize(blocks.size());
+    if (scratch_.empty()) {
+        scratch_.push_back(makeScratch());
+    }
+    processRange(blocks, results, 0, blocks.size(), scratch_[0]);
+}
+
+template<typename Sample>
+void BasicSessionPool<Sample>::process(const std::vector<BasicSessionBlock<Sample>>& blocks,
+                                       std::vector<SessionResult>& results, ThreadPool& pool) {
+    results.resize(blocks.size());
+    while (scratch_.size() < pool.getConcurrency()) {
+        scratch_.push_back(makeScratch());
+    }
+
+    // Several sessions per chunk keep the shared tables hot on each thread
+    size_t grain = std::max<size_t>(1, blocks.size() / (pool.getConcurrency() * 4));
+    std::vector<Scratch>& scratch = scratch_;
+    pool.parallelFor(blocks.size(), grain, [&](size_t begin, size_t end, size_t slot) {
+        processRange(blocks, results, begin, end, scratch[slot]);
+    });
+}
+
+template<typename Sample>
+void BasicSessionPool<Sample>::processRange(const std::vector<BasicSessionBlock<Sample>>& blocks,
+                                            std::vector<SessionResult>& results,
+                                            size_t begin, size_t end, Scratch& scratch) {
+    ANANTASOUND_STAGE_TIMER("sessions.process");
+    for (size_t i = begin; i < end; ++i) {
+        processBlock(blocks[i], results[i], scratch);
+    }
+}
+
+template<typename Sample>
+void BasicSessionPool<Sample>::processBlock(const BasicSessionBlock<Sample>& block, SessionResult& result,
+                                            Scratch& scratch) {
+    result = SessionResult();
+    if (!hasSession(block.session) || block.input == nullptr) {
+        return;
+    }
+    Session& session = *slots_[block.session];
+    result.processed = true;
+
+    // Shed analysis: the effects keep running with the last parameters
+    if (!session.focused && !analyze_unfocused_) {
+        if (block.output != nullptr && block.count > 0) {
+            if (block.output != block.input) {
+                std::copy(block.input, block.input + block.count, block.output);
+            }
+            if (session.has_previous) {
+                result.adaptation.applied_parameters = session.previous;
+                session.chain.setParameters(session.previous);
+            }
+            session.chain.processInPlace(block.output, block.count);
+        }
+        return;
+    }
+
+    result.analyzed = true;
+    result.breathing = session.breathing.analyzeBreathing(block.input, block.count);
+    if (block.count == 0) {
+        return;
+    }
+
+    // Analysis reads the input before the effects may overwrite it in place
+    classifier_.getAudioAnalyzer().analyzeAudio(block.input, block.count, scratch.analysis, scratch.frame);
+    session.tempo.setHopSize(block.count);
+    scratch.analysis.tempo = session.tempo.pushSpectrum(scratch.analysis.magnitude_spectrum.data(),
+                                                        scratch.analysis.magnitude_spectrum.size());
+    RealtimeAdaptation& adaptation = result.adaptation;
+    adaptation.detected_emotion = classifier_.detectEmotionalState(scratch.analysis);
+    adaptation.confidence = classifier_.calculateConfidence(scratch.analysis, adaptation.detected_emotion);
+
+    const AdaptationParameters& preset = presets_[static_cast<size_t>(adaptation.detected_emotion)];
+    adaptation.applied_parameters = session.has_previous ? smoothParameters(preset, session.previous) : preset;
+    adaptation.applied_parameters.tempo_multiplier = 1.0;
+    session.previous = adaptation.applied_parameters;
+    session.has_previous = true;
+    session.recordEmotion(adaptation.detected_emotion);
+
+    if (block.output != nullptr) {
+        if (block.output != block.input) {
+            std::copy(block.input, block.input + block.count, block.output);
+        }
+        session.chain.setParameters(adaptation.applied_parameters);
+        session.chain.processInPlace(block.output, block.count);
+    }
+}
+
+template<typename Sample>
+bool BasicSessionPool<Sample>::setSessionFocus(size_t session, bool focused) {
+    if (!hasSession(session)) {
+        return false;
+    }
+    slots_[session]->focused = focused;
+    return true;
+}
+
+template<typename Sample>
+bool BasicSessionPool<Sample>::isSessionFocused(size_t session) const {
+    return hasSession(session) && slots_[session]->focused;
+}
+
+template<typename Sample>
+void BasicSessionPool<Sample>::setEmotionPreset(EmotionalState emotion, const AdaptationParameters& parameters) {
+    classifier_.setEmotionPreset(emotion, parameters);
+    presets_[static_cast<size_t>(emotion)] = classifier_.getAdaptationParameters(emotion);
+}
+
+template<typename Sample>
+void BasicSessionPool<Sample>::setDomeAcoustics(const DomeAcousticResonator& dome, double frequency) {
+    reverb_time_ = dome.calculateReverbTime(frequency);
+    for (std::optional<Session>& slot : slots_) {
+        if (slot) {
+            slot->chain.setReverbTime(reverb_time_);
+        }
+    }
+}
+
+template<typename Sample>
+EmotionalState BasicSessionPool<Sample>::getMostCommonEmotion(size_t session) const {
+    if (!hasSession(session) || slots_[session]->history_count == 0) {
+        return EmotionalState::UNKNOWN;
+    }
+    const auto& counts = slots_[session]->emotion_counts;
+    return static_cast<EmotionalState>(std::max_element(counts.begin(), counts.end()) - counts.begin());
+}
+
+template<typename Sample>
+const BreathingAnalyzer* BasicSessionPool<Sample>::getBreathingAnalyzer(size_t session) const {
+    return hasSession(session) ? &slots_[session]->breathing : nullptr;
+}
+
+template<typename Sample>
+typename BasicSessionPool<Sample>::Scratch BasicSessionPool<Sample>::makeScratch() const {
+    Scratch scratch;
+    scratch.frame = classifier_.getAudioAnalyzer().template makeFrameScratch<Sample>();
+    return scratch;
+}
+
+template class BasicSessionPool<double>;
+template class BasicSessionPool<float>;
+
+} // namespace AnantaSound
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "adaptive_audio_processor.hpp"
+#include "breathing_analyzer.hpp"
+#include "effects_chain.hpp"
+#include "tempo_tracker.hpp"
+#include "thread_pool.hpp"
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace AnantaSound {
+
+class DomeAcousticResonator;
+
+// One listener's block for BasicSessionPool::process
+template<typename Sample>
+struct BasicSessionBlock {
+    size_t session;
+    const Sample* input;
+    Sample* output;             // May equal input; nullptr analyzes without effects
+    size_t count;
+};
+
+// Per-block outcome for one session
+struct SessionResult {
+    bool processed;             // false for an id that is not an active session
+    bool analyzed;              // false when analysis was shed (see setUnfocusedAnalysis)
+    BreathingAnalysisResult breathing;
+    RealtimeAdaptation adaptation;
+
+    SessionResult() : processed(false), analyzed(false) {}
+};
+
+// Breathing and adaptive processing for many concurrent listeners.
+// Everything immutable is held once for the whole pool: the FFT plan,
+// window and frequency axis (one shared AudioAnalyzer), the emotion
+// classifier and its presets, and the static half-band and resampler
+// tables. A session owns only its streaming state (envelope front end and
+// history, tempo tracker, effects chain, smoothing history), kept in a slot arena sized at
+// construction; ids are slot indices and are reused after removeSession.
+// process() runs a batch of blocks back to back through the shared plan,
+// with spectrum scratch owned per worker thread rather than per session, so
+// it does not allocate once the result vector has grown. As in
+// AdaptiveAudioProcessor::processRealtime, the tempo stays at 1.0 so every
+// block keeps its length. Session management and the setters must not run
+// concurrently with process().
+//
+// Sessions are in focus by default. When the analysis of unfocused sessions
+// is turned off (e.g. while a DeadlineScheduler sheds
+// OptionalWork::UNFOCUSED_SESSIONS), their blocks skip breathing and emotion
+// analysis but still go through their effects chain with the last applied
+// parameters, so their audio output never stops.
+template<typename Sample>
+class BasicSessionPool {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static constexpr size_t kHistorySize = 10;  // Emotions kept per session
+
+private:
+    struct Session {
+        BreathingAnalyzer breathing;
+        BasicEffectsChain<Sample> chain;
+        TempoTracker tempo;                     // Blocks of a session are consecutive: hop = block length
+        AdaptationParameters previous;          // Last applied parameters, for smoothing
+        bool has_previous;
+        std::array<EmotionalState, kHistorySize> emotions;
+        std::array<size_t, kEmotionalStateCount> emotion_counts;
+        size_t history_next;
+        size_t history_count;
+        bool focused;
+
+        Session(size_t fft_size, size_t sample_rate, double reverb_time,
+                std::shared_ptr<const FFTPlan> tempo_plan);
+        void recordEmotion(EmotionalState emotion);
+    };
+
+    // Frame work buffers; one per thread processing concurrently
+    struct Scratch {
+        AudioAnalyzer::BasicFrameScratch<Sample> frame;
+        BasicAudioAnalysisResult<Sample> analysis;
+    };
+
+    size_t fft_size_;
+    size_t sample_rate_;
+    AdaptiveAudioProcessor classifier_;        // Shared analyzer, presets and emotion rules
+    std::array<AdaptationParameters, kEmotionalStateCount> presets_;
+    double reverb_time_;
+    std::shared_ptr<const FFTPlan> tempo_plan_; // Autocorrelation plan shared by every session's tracker
+
+    std::vector<std::optional<Session>> slots_;
+    std::vector<size_t> free_slots_;            // Stack of unused slot indices
+    size_t active_count_;
+    bool analyze_unfocused_;
+    std::vector<Scratch> scratch_;
+
+public:
+    BasicSessionPool(size_t fft_size = 1024, size_t sample_rate = 44100, size_t max_sessions = 128);
+
+    // Plan the shared FFT; false when fft_size is not a valid plan size
+    bool initialize();
+
+    // Open a session with fresh state; npos when all slots are in use
+    size_t addSession();
+    bool removeSession(size_t session);
+    bool hasSession(size_t session) const;
+
+    size_t getSessionCount() const { return active_count_; }
+    size_t getCapacity() const { return slots_.size(); }
+
+    // Process one block per entry; results[i] belongs to blocks[i]. A session
+    // appears at most once per batch. The pool overload splits the batch
+    // across threads.
+    void process(const std::vector<BasicSessionBlock<Sample>>& blocks, std::vector<SessionResult>& results);
+    void process(const std::vector<BasicSessionBlock<Sample>>& blocks, std::vector<SessionResult>& results,
+                 ThreadPool& pool);
+
+    // Focus of a session (false for an inactive id) and whether unfocused
+    // sessions are analyzed
+    bool setSessionFocus(size_t session, bool focused);
+    bool isSessionFocused(size_t session) const;
+    void setUnfocusedAnalysis(bool enabled) { analyze_unfocused_ = enabled; }
+    bool isUnfocusedAnalysisEnabled() const { return analyze_unfocused_; }
+
+    // Shared settings, applied to every session
+    void setEmotionPreset(EmotionalState emotion, const AdaptationParameters& parameters);
+    void setDomeAcoustics(const DomeAcousticResonator& dome, double frequency = 1000.0);
+
+    // Per-session queries; UNKNOWN / nullptr for an inactive id
+    EmotionalState getMostCommonEmotion(size_t session) const;
+    const BreathingAnalyzer* getBreathingAnalyzer(size_t session) const;
+
+private:
+    void processRange(const std::vector<BasicSessionBlock<Sample>>& blocks, std::vector<SessionResult>& results,
+                      size_t begin, size_t end, Scratch& scratch);
+    void processBlock(const BasicSessionBlock<Sample>& block, SessionResult& result, Scratch& scratch);
+    Scratch makeScratch() const;
+};
+
+// Instantiated in session_pool.cpp
+extern template class BasicSessionPool<double>;
+extern template class BasicSessionPool<float>;
+
+using SessionPool = BasicSessionPool<double>;
+using SessionPoolF = BasicSessionPool<float>;
+
+using SessionBlock = BasicSessionBlock<double>;
+using SessionBlockF = BasicSessionBlock<float>;
+
+} // namespace AnantaSound
@@ -0,0 +1,358 @@
+#include "session_recorder.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+namespace AnantaSound {
+
+static_assert(std::is_trivially_copyable<SessionLogHeader>::value, "session header is written as raw bytes");
+static_assert(sizeof(SessionLogHeader) == 96, "session header layout is part of the file format");
+static_assert(sizeof(SessionEvent) == 104, "session event layout is part of the file format");
+
+namespace {
+
+constexpr size_t kWriteChunk = 4096;        // Events per file write / read
+constexpr size_t kAppendChunk = 32;         // Events staged on the producer's stack
+
+SessionEvent encodeField(const QuantumSoundField& field) {
+    SessionEvent event{};
+    event.type = kSessionField;
+    event.word = static_cast<uint64_t>(field.timestamp.time_since_epoch().count());
+    event.amplitude_real = field.amplitude.real();
+    event.amplitude_imag = field.amplitude.imag();
+    event.phase = field.phase;
+    event.frequency = field.frequency;
+    event.position[0] = field.position.r;
+    event.position[1] = field.position.theta;
+    event.position[2] = field.position.phi;
+    event.position[3] = field.position.t;
+    event.position[4] = field.position.height;
+    event.state = static_cast<uint32_t>(field.quantum_state);
+    return event;
+}
+
+QuantumSoundField decodeField(const SessionEvent& event) {
+    QuantumSoundField field;
+    field.amplitude = std::complex<double>(event.amplitude_real, event.amplitude_imag);
+    field.phase = event.phase;
+    field.frequency = event.frequency;
+    field.quantum_state = static_cast<QuantumSoundState>(event.state);
+    field.position = SphericalCoord(event.position[0], event.position[1], event.position[2], event.position[3],
+                                    event.position[4]);
+    field.timestamp = std::chrono::high_resolution_clock::time_point(
+        std::chrono::high_resolution_clock::duration(static_cast<int64_t>(event.word)));
+    return field;
+}
+
+} // namespace
+
+// SessionRecorder
+SessionRecorder::SessionRecorder(size_t capacity, std::chrono::microseconds poll_interval)
+    : ring_(capacity)
+    , poll_interval_(poll_interval)
+    , running_(false)
+    , core_(nullptr)
+    , header_{}
+    , recorded_(0)
+    , dropped_(0) {
+}
+
+SessionRecorder::~SessionRecorder() {
+    stop();
+}
+
+bool SessionRecorder::start(AnantaSoundCore& core, const std::string& path) {
+    if (isRecording()) {
+        return false;
+    }
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_) {
+        std::cerr << "Failed to create session log: " << path << std::endl;
+        return false;
+    }
+
+    ring_.reset();
+    recorded_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    header_ = SessionLogHeader{};
+    std::memcpy(header_.magic, kSessionMagic, sizeof(kSessionMagic));
+    header_.version = kSessionFormatVersion;
+    header_.byte_order = kSessionByteOrderMark;
+    header_.event_size = sizeof(SessionEvent);
+    header_.dome_radius = core.getDomeRadius();
+    header_.dome_height = core.getDomeHeight();
+
+    // beginSession fills the run state before the first event can arrive
+    core_ = &core;
+    core.attachRecorder(this);
+    writeHeader();
+    running_.store(true, std::memory_order_release);
+    writer_ = std::thread([this]() { writerLoop(); });
+    return true;
+}
+
+void SessionRecorder::stop() {
+    if (!running_.load(std::memory_order_acquire)) {
+        return;
+    }
+    core_->attachRecorder(nullptr);
+    core_ = nullptr;
+    running_.store(false, std::memory_order_release);
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+
+    header_.complete = 1;
+    header_.event_count = recorded_.load(std::memory_order_relaxed);
+    header_.dropped_events = dropped_.load(std::memory_order_relaxed);
+    writeHeader();
+    file_.close();
+}
+
+void SessionRecorder::writeHeader() {
+    file_.seekp(0);
+    file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    file_.seekp(0, std::ios::end);
+    file_.flush();
+}
+
+size_t SessionRecorder::drain(std::vector<SessionEvent>& scratch) {
+    size_t count = ring_.read(scratch.data(), scratch.size());
+    if (count > 0) {
+        file_.write(reinterpret_cast<const char*>(scratch.data()),
+                    static_cast<std::streamsize>(count * sizeof(SessionEvent)));
+    }
+    return count;
+}
+
+void SessionRecorder::writerLoop() {
+    std::vector<SessionEvent> scratch(kWriteChunk);
+    while (running_.load(std::memory_order_acquire)) {
+        if (drain(scratch) == 0) {
+            file_.flush();
+            std::this_thread::sleep_for(poll_interval_);
+        }
+    }
+
+    // The core is detached: everything it appended is in the ring
+    while (drain(scratch) > 0) {
+    }
+}
+
+bool SessionRecorder::reserve(size_t count) {
+    // Single producer: free space only grows until this append is done
+    if (ring_.writeAvailable() < count) {
+        dropped_.fetch_add(count, std::memory_order_relaxed);
+        return false;
+    }
+    recorded_.fetch_add(count, std::memory_order_relaxed);
+    return true;
+}
+
+void SessionRecorder::beginSession(const AnantaSoundCore::RunState& state) {
+    header_.run_state = state;
+}
+
+void SessionRecorder::recordField(const QuantumSoundField& field) {
+    if (reserve(1)) {
+        SessionEvent event = encodeField(field);
+        ring_.write(&event, 1);
+    }
+}
+
+void SessionRecorder::appendFields(const std::vector<QuantumSoundField>& fields) {
+    SessionEvent staged[kAppendChunk];
+    for (size_t begin = 0; begin < fields.size(); begin += kAppendChunk) {
+        size_t count = std::min(kAppendChunk, fields.size() - begin);
+        for (size_t i = 0; i < count; ++i) {
+            staged[i] = encodeField(fields[begin + i]);
+        }
+        ring_.write(staged, count);
+    }
+}
+
+void SessionRecorder::recordFields(const std::vector<QuantumSoundField>& fields) {
+    if (reserve(fields.size() + 1)) {
+        SessionEvent event{};
+        event.type = kSessionFieldBatch;
+        event.count = static_cast<uint32_t>(fields.size());
+        ring_.write(&event, 1);
+        appendFields(fields);
+    }
+}
+
+void SessionRecorder::recordRestore(const std::vector<QuantumSoundField>& fields) {
+    if (reserve(fields.size() + 1)) {
+        SessionEvent event{};
+        event.type = kSessionRestoreBatch;
+        event.count = static_cast<uint32_t>(fields.size());
+        ring_.write(&event, 1);
+        appendFields(fields);
+    }
+}
+
+void SessionRecorder::recordUpdate(double dt, bool pooled) {
+    if (reserve(1)) {
+        SessionEvent event{};
+        event.type = kSessionUpdate;
+        event.count = pooled ? 1 : 0;
+        event.value = dt;
+        ring_.write(&event, 1);
+    }
+}
+
+void SessionRecorder::recordPhaseCoupling(double coupling) {
+    if (reserve(1)) {
+        SessionEvent event{};
+        event.type = kSessionPhaseCoupling;
+        event.value = coupling;
+        ring_.write(&event, 1);
+    }
+}
+
+void SessionRecorder::recordNoiseSeed(uint64_t seed) {
+    if (reserve(1)) {
+        SessionEvent event{};
+        event.type = kSessionNoiseSeed;
+        event.word = seed;
+        ring_.write(&event, 1);
+    }
+}
+
+// SessionReplay
+SessionReplay::SessionReplay() : header_{}, event_count_(0), open_(false) {
+}
+
+bool SessionReplay::open(const std::string& path) {
+    open_ = false;
+    calls_.clear();
+    batches_.clear();
+    event_count_ = 0;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open session log: " << path << std::endl;
+        return false;
+    }
+    if (!file.read(reinterpret_cast<char*>(&header_), sizeof(header_)) ||
+        std::memcmp(header_.magic, kSessionMagic, sizeof(kSessionMagic)) != 0 ||
+        header_.version != kSessionFormatVersion || header_.byte_order != kSessionByteOrderMark ||
+        header_.event_size != sizeof(SessionEvent)) {
+        std::cerr << "Invalid or unsupported session log: " << path << std::endl;
+        return false;
+    }
+
+    // Group the events into calls; a batch cut off by the end of an
+    // unfinished log is dropped
+    std::vector<SessionEvent> chunk(kWriteChunk);
+    size_t pending = 0;         // Fields still owed to the open batch
+    bool valid = true;
+    while (valid && file) {
+        file.read(reinterpret_cast<char*>(chunk.data()),
+                  static_cast<std::streamsize>(chunk.size() * sizeof(SessionEvent)));
+        size_t count = static_cast<size_t>(file.gcount()) / sizeof(SessionEvent);
+        for (size_t i = 0; i < count && valid; ++i) {
+            const SessionEvent& event = chunk[i];
+            ++event_count_;
+            if (pending > 0) {
+                if (event.type != kSessionField) {
+                    valid = false;
+                    break;
+                }
+                batches_.back().push_back(decodeField(event));
+                --pending;
+                continue;
+            }
+            switch (event.type) {
+                case kSessionField:
+                    calls_.push_back({kSessionField, false, 0.0, 0, batches_.size()});
+                    batches_.emplace_back(1, decodeField(event));
+                    break;
+                case kSessionFieldBatch:
+                case kSessionRestoreBatch:
+                    calls_.push_back({event.type, false, 0.0, 0, batches_.size()});
+                    batches_.emplace_back();
+                    batches_.back().reserve(event.count);
+                    pending = event.count;
+                    break;
+                case kSessionUpdate:
+                case kSessionPhaseCoupling:
+                case kSessionNoiseSeed:
+                    calls_.push_back({event.type, event.count != 0, event.value, event.word, 0});
+                    break;
+                default:
+                    valid = false;
+                    break;
+            }
+        }
+    }
+    if (valid && pending > 0) {
+        if (header_.complete) {
+            valid = false;
+        } else {
+            calls_.pop_back();
+            batches_.pop_back();
+        }
+    }
+    if (!valid || (header_.complete && event_count_ != header_.event_count)) {
+        std::cerr << "Corrupt session log: " << path << std::endl;
+        calls_.clear();
+        batches_.clear();
+        return false;
+    }
+
+    open_ = true;
+    return true;
+}
+
+bool SessionReplay::run(AnantaSoundCore& core, ThreadPool* pool, SessionReplayStatistics* statistics) const {
+    if (!open_ || !core.isInitialized()) {
+        return false;
+    }
+
+    core.setRunState(header_.run_state);
+    SessionReplayStatistics totals{};
+    auto started = std::chrono::steady_clock::now();
+    for (const Call& call : calls_) {
+        switch (call.type) {
+            case kSessionField:
+                core.processSoundField(batches_[call.batch].front());
+                totals.fields += 1;
+                break;
+            case kSessionFieldBatch:
+                core.processSoundFields(batches_[call.batch]);
+                totals.fields += batches_[call.batch].size();
+                break;
+            case kSessionRestoreBatch:
+                core.restoreSoundFields(batches_[call.batch]);
+                totals.fields += batches_[call.batch].size();
+                break;
+            case kSessionUpdate:
+                if (call.pooled && pool) {
+                    core.update(call.value, *pool);
+                } else {
+                    core.update(call.value);
+                }
+                totals.updates += 1;
+                totals.simulated_seconds += call.value;
+                break;
+            case kSessionPhaseCoupling:
+                core.setPhaseCoupling(call.value);
+                break;
+            case kSessionNoiseSeed:
+                core.setNoiseSeed(call.word);
+                break;
+        }
+        ++totals.calls;
+    }
+    totals.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    if (statistics) {
+        *statistics = totals;
+    }
+    return true;
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include "spsc_ring_buffer.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AnantaSound {
+
+class ThreadPool;
+
+// Session log: every input an AnantaSoundCore receives while a recorder is
+// attached, in call order, so a show can be re-run offline for profiling
+// and regression benchmarks.
+//
+// Layout (native byte order, checked on open):
+//   SessionLogHeader | SessionEvent...
+// The header carries the core's run state at attach time (noise seed,
+// decoherence phase, clock position); with the same starting scene (see
+// saveScene) replaying the events reproduces the recorded output exactly.
+// A log whose recorder never stopped (e.g. a crash) is still readable up to
+// the last event that reached the file.
+constexpr char kSessionMagic[8] = {'A', 'N', 'S', 'E', 'S', 'S', '\0', '\0'};
+constexpr uint32_t kSessionFormatVersion = 1;
+constexpr uint32_t kSessionByteOrderMark = 0x01020304;
+
+struct SessionLogHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t event_size;        // sizeof(SessionEvent), checked on open
+    uint32_t complete;          // Set by SessionRecorder::stop
+    uint64_t event_count;       // Valid when complete
+    uint64_t dropped_events;    // Lost to a full ring; such a log replays approximately
+    double dome_radius;
+    double dome_height;
+    AnantaSoundCore::RunState run_state;
+};
+
+enum SessionEventType : uint32_t {
+    kSessionField = 1,          // processSoundField, or one field of a batch
+    kSessionFieldBatch,         // processSoundFields: count kSessionField events follow
+    kSessionRestoreBatch,       // restoreSoundFields: count kSessionField events follow
+    kSessionUpdate,             // update(value); count 1 when a pool was used
+    kSessionPhaseCoupling,      // setPhaseCoupling(value)
+    kSessionNoiseSeed           // setNoiseSeed(word)
+};
+
+struct SessionEvent {
+    uint32_t type;
+    uint32_t count;
+    double value;
+    uint64_t word;              // Seed, or the field timestamp (time_since_epoch count)
+    double amplitude_real;
+    double amplitude_imag;
+    double phase;
+    double frequency;
+    double position[5];         // r, theta, phi, t, height
+    uint32_t state;
+    uint32_t reserved;
+};
+
+// Captures the inputs of one core into a session log.
+// The core appends events while it holds its own mutex, which makes it the
+// only producer of an SPSC ring: an append is a few stores, no locks and no
+// allocations, so recording is safe on the audio path. A writer thread
+// drains the ring to the file and sleeps for poll_interval when it is
+// empty. A batch that does not fit in the ring is dropped whole and
+// counted. Structural edits (interference fields, devices) are not
+// recorded; save the scene before start() to capture them.
+class SessionRecorder {
+public:
+    static constexpr size_t kDefaultCapacity = 1 << 16;     // Events
+
+private:
+    SPSCRingBuffer<SessionEvent> ring_;
+    std::chrono::microseconds poll_interval_;
+    std::ofstream file_;
+    std::thread writer_;
+    std::atomic<bool> running_;
+    AnantaSoundCore* core_;
+    SessionLogHeader header_;
+    std::atomic<uint64_t> recorded_;
+    std::atomic<uint64_t> dropped_;
+
+    void writerLoop();
+    size_t drain(std::vector<SessionEvent>& scratch);
+    void writeHeader();
+    bool reserve(size_t count);
+    void appendFields(const std::vector<QuantumSoundField>& fields);
+
+public:
+    explicit SessionRecorder(size_t capacity = kDefaultCapacity,
+                             std::chrono::microseconds poll_interval = std::chrono::microseconds(1000));
+    ~SessionRecorder();
+
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    // Attach to core and start writing path; false on I/O error or when
+    // already recording. The core must outlive the recording.
+    bool start(AnantaSoundCore& core, const std::string& path);
+    // Detach, flush the events still buffered and finalize the header
+    void stop();
+    bool isRecording() const { return running_.load(std::memory_order_acquire); }
+
+    uint64_t getRecordedEvents() const { return recorded_.load(std::memory_order_relaxed); }
+    uint64_t getDroppedEvents() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // Producer side, called by the core under its mutex
+    void beginSession(const AnantaSoundCore::RunState& state);
+    void recordField(const QuantumSoundField& field);
+    void recordFields(const std::vector<QuantumSoundField>& fields);
+    void recordRestore(const std::vector<QuantumSoundField>& fields);
+    void recordUpdate(double dt, bool pooled);
+    void recordPhaseCoupling(double coupling);
+    void recordNoiseSeed(uint64_t seed);
+};
+
+struct SessionReplayStatistics {
+    uint64_t calls;             // Core calls issued
+    uint64_t fields;            // Fields passed to the core
+    uint64_t updates;
+    double simulated_seconds;   // Σ dt
+    double elapsed_seconds;     // Wall time of the replay loop
+};
+
+// A session log decoded into ready-to-issue core calls.
+// open() reads and groups the whole log up front, so run() does nothing
+// but call the core and measures the processing cost alone.
+class SessionReplay {
+private:
+    struct Call {
+        uint32_t type;
+        bool pooled;
+        double value;
+        uint64_t word;
+        size_t batch;           // Into batches_ (field calls)
+    };
+
+    SessionLogHeader header_;
+    std::vector<Call> calls_;
+    std::vector<std::vector<QuantumSoundField>> batches_;
+    uint64_t event_count_;
+    bool open_;
+
+public:
+    SessionReplay();
+
+    // Read and decode a log; false when it is not a session of this format
+    bool open(const std::string& path);
+    bool isOpen() const { return open_; }
+
+    // Set the core's run state and issue every recorded call in order; the
+    // core must be initialized and hold the recorded starting scene. pool
+    // (optional) serves the updates that were pooled when recorded.
+    bool run(AnantaSoundCore& core, ThreadPool* pool = nullptr,
+             SessionReplayStatistics* statistics = nullptr) const;
+
+    const SessionLogHeader& getHeader() const { return header_; }
+    uint64_t getEventCount() const { return event_count_; }
+    size_t getCallCount() const { return calls_.size(); }
+    bool isComplete() const { return header_.complete != 0; }
+};
+
+} // namespace AnantaSound
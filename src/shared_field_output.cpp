@@ -0,0 +1,326 @@
+#include "shared_field_output.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AnantaSound {
+
+namespace {
+
+constexpr size_t kAlignment = 64;
+constexpr size_t kDoubleArrays = 8;         // amplitude_real ... height
+constexpr int kReadAttempts = 8;            // readFields retries before giving up
+
+size_t alignUp(size_t bytes) {
+    return (bytes + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+size_t slotSize(size_t capacity) {
+    return alignUp(sizeof(SharedFieldSlotHeader)) + kDoubleArrays * alignUp(capacity * sizeof(double)) +
+           alignUp(capacity);
+}
+
+// Array i (0..7 doubles, 8 states) of a slot
+size_t arrayOffset(size_t capacity, size_t index) {
+    return alignUp(sizeof(SharedFieldSlotHeader)) + index * alignUp(capacity * sizeof(double));
+}
+
+} // namespace
+
+// SharedFieldOutput
+SharedFieldOutput::SharedFieldOutput() : mapping_(nullptr), mapping_size_(0), capacity_(0), frame_(0) {
+}
+
+SharedFieldOutput::~SharedFieldOutput() {
+    close();
+}
+
+size_t SharedFieldOutput::regionSize(size_t capacity) {
+    return alignUp(sizeof(SharedFieldHeader)) + kSharedFieldSlotCount * slotSize(capacity);
+}
+
+bool SharedFieldOutput::open(const std::string& path, size_t capacity) {
+    close();
+#if defined(_WIN32)
+    (void)path;
+    (void)capacity;
+    std::cerr << "Shared field output is not available on this platform" << std::endl;
+    return false;
+#else
+    if (capacity == 0 || capacity > UINT32_MAX) {
+        return false;
+    }
+    size_t size = regionSize(capacity);
+
+    // The region is built in a new file next to path and renamed over it
+    // once initialized: truncating a file that readers still map would
+    // fault them (SIGBUS), while a rename leaves them the old file
+    std::string temporary = path + ".XXXXXX";
+    int fd = ::mkstemp(&temporary[0]);
+    if (fd < 0) {
+        std::cerr << "Failed to create shared field output: " << path << std::endl;
+        return false;
+    }
+    if (::fchmod(fd, 0644) != 0 || ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        ::unlink(temporary.c_str());
+        std::cerr << "Failed to size shared field output: " << path << std::endl;
+        return false;
+    }
+    void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        ::unlink(temporary.c_str());
+        std::cerr << "Failed to map shared field output: " << path << std::endl;
+        return false;
+    }
+
+    mapping_ = static_cast<uint8_t*>(address);
+    mapping_size_ = size;
+    capacity_ = static_cast<uint32_t>(capacity);
+    frame_ = 0;
+
+    // The file starts zeroed; the magic goes in last so a reader never
+    // accepts a half-initialized header
+    SharedFieldHeader* shared = new (mapping_) SharedFieldHeader;
+    shared->version = kSharedFieldFormatVersion;
+    shared->byte_order = kSharedFieldByteOrderMark;
+    shared->capacity = capacity_;
+    shared->slot_count = kSharedFieldSlotCount;
+    shared->slot_size = slotSize(capacity);
+    shared->region_size = size;
+    shared->latest.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < kSharedFieldSlotCount; ++i) {
+        uint8_t* base = mapping_ + alignUp(sizeof(SharedFieldHeader)) + i * shared->slot_size;
+        new (base) SharedFieldSlotHeader{};
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(shared->magic, kSharedFieldMagic, sizeof(kSharedFieldMagic));
+
+    if (::rename(temporary.c_str(), path.c_str()) != 0) {
+        ::unlink(temporary.c_str());
+        close();
+        std::cerr << "Failed to publish shared field output: " << path << std::endl;
+        return false;
+    }
+    return true;
+#endif
+}
+
+void SharedFieldOutput::close() {
+#if !defined(_WIN32)
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    capacity_ = 0;
+}
+
+void SharedFieldOutput::publish(const FieldBuffer& fields, const AnantaSoundCore::SystemStatistics& statistics,
+                                const ClockTick& tick) {
+    if (!mapping_) {
+        return;
+    }
+    SharedFieldHeader* shared = header();
+    uint64_t frame = ++frame_;
+    uint8_t* base = mapping_ + alignUp(sizeof(SharedFieldHeader)) + (frame % kSharedFieldSlotCount) * shared->slot_size;
+    auto* slot = reinterpret_cast<SharedFieldSlotHeader*>(base);
+
+    slot->frame.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    size_t count = std::min<size_t>(fields.size(), capacity_);
+    slot->count = count;
+    slot->total_count = fields.size();
+    slot->clock_sample = tick.sample;
+    slot->clock_seconds = tick.seconds;
+    slot->entangled_pairs = statistics.entangled_pairs;
+    slot->coherence_ratio = statistics.coherence_ratio;
+    slot->energy_efficiency = statistics.energy_efficiency;
+    slot->phase_coherence = statistics.phase_coherence;
+
+    const double* sources[kDoubleArrays] = {fields.amplitudeReal(), fields.amplitudeImag(), fields.phases(),
+                                            fields.frequencies(), fields.radii(), fields.polarAngles(),
+                                            fields.azimuthAngles(), fields.heights()};
+    for (size_t i = 0; i < kDoubleArrays; ++i) {
+        if (count > 0) {
+            std::memcpy(base + arrayOffset(capacity_, i), sources[i], count * sizeof(double));
+        }
+    }
+    uint8_t* states = base + arrayOffset(capacity_, kDoubleArrays);
+    const QuantumSoundState* source_states = fields.states();
+    for (size_t i = 0; i < count; ++i) {
+        states[i] = static_cast<uint8_t>(source_states[i]);
+    }
+
+    slot->frame.store(frame, std::memory_order_release);
+    shared->latest.store(frame, std::memory_order_release);
+}
+
+// SharedFieldReader
+SharedFieldReader::SharedFieldReader()
+    : mapping_(nullptr), mapping_size_(0), capacity_(0), slot_size_(0), reopen_required_(false) {
+}
+
+SharedFieldReader::~SharedFieldReader() {
+    close();
+}
+
+bool SharedFieldReader::open(const std::string& path) {
+    close();
+#if defined(_WIN32)
+    (void)path;
+    std::cerr << "Shared field output is not available on this platform" << std::endl;
+    return false;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(SharedFieldHeader)) {
+        ::close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(file_stat.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+    mapping_ = static_cast<const uint8_t*>(address);
+    mapping_size_ = size;
+
+    const SharedFieldHeader* shared = header();
+    bool valid = std::memcmp(shared->magic, kSharedFieldMagic, sizeof(kSharedFieldMagic)) == 0;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    valid = valid && shared->version == kSharedFieldFormatVersion &&
+            shared->byte_order == kSharedFieldByteOrderMark && shared->slot_count == kSharedFieldSlotCount &&
+            shared->capacity > 0 && shared->slot_size == slotSize(shared->capacity) &&
+            shared->region_size == size && size == SharedFieldOutput::regionSize(shared->capacity);
+    if (!valid) {
+        std::cerr << "Invalid or unsupported shared field output: " << path << std::endl;
+        close();
+        return false;
+    }
+    capacity_ = shared->capacity;
+    slot_size_ = shared->slot_size;
+    return true;
+#endif
+}
+
+void SharedFieldReader::close() {
+#if !defined(_WIN32)
+    if (mapping_ != nullptr) {
+        ::munmap(const_cast<uint8_t*>(mapping_), mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    capacity_ = 0;
+    slot_size_ = 0;
+    reopen_required_.store(false, std::memory_order_relaxed);
+}
+
+const SharedFieldSlotHeader* SharedFieldReader::slot(uint64_t frame) const {
+    // Only the layout validated at open indexes the mapping; the live
+    // header is another process's memory and may not be trusted
+    return reinterpret_cast<const SharedFieldSlotHeader*>(mapping_ + alignUp(sizeof(SharedFieldHeader)) +
+                                                          (frame % kSharedFieldSlotCount) * slot_size_);
+}
+
+uint64_t SharedFieldReader::getLatestFrame() const {
+    return mapping_ ? header()->latest.load(std::memory_order_acquire) : 0;
+}
+
+bool SharedFieldReader::acquire(SharedFieldFrame& frame) const {
+    if (!mapping_) {
+        return false;
+    }
+    const SharedFieldHeader* shared = header();
+    if (shared->capacity != capacity_ || shared->slot_size != slot_size_) {
+        reopen_required_.store(true, std::memory_order_relaxed);
+        return false;
+    }
+    uint64_t latest = getLatestFrame();
+    if (latest == 0) {
+        return false;
+    }
+    const SharedFieldSlotHeader* current = slot(latest);
+    if (current->frame.load(std::memory_order_acquire) != latest) {
+        return false;
+    }
+
+    size_t capacity = capacity_;
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(current);
+    frame.frame = latest;
+    frame.count = std::min<size_t>(current->count, capacity);
+    frame.total_count = current->total_count;
+    frame.clock_sample = current->clock_sample;
+    frame.clock_seconds = current->clock_seconds;
+    frame.entangled_pairs = current->entangled_pairs;
+    frame.coherence_ratio = current->coherence_ratio;
+    frame.energy_efficiency = current->energy_efficiency;
+    frame.phase_coherence = current->phase_coherence;
+    const double* arrays[kDoubleArrays];
+    for (size_t i = 0; i < kDoubleArrays; ++i) {
+        arrays[i] = reinterpret_cast<const double*>(base + arrayOffset(capacity, i));
+    }
+    frame.amplitude_real = arrays[0];
+    frame.amplitude_imag = arrays[1];
+    frame.phase = arrays[2];
+    frame.frequency = arrays[3];
+    frame.r = arrays[4];
+    frame.theta = arrays[5];
+    frame.phi = arrays[6];
+    frame.height = arrays[7];
+    frame.state = base + arrayOffset(capacity, kDoubleArrays);
+    return validate(frame);
+}
+
+bool SharedFieldReader::validate(const SharedFieldFrame& frame) const {
+    if (!mapping_ || frame.frame == 0) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot(frame.frame)->frame.load(std::memory_order_relaxed) == frame.frame;
+}
+
+uint64_t SharedFieldReader::readFields(std::vector<QuantumSoundField>& fields) const {
+    SharedFieldFrame frame;
+    for (int attempt = 0; attempt < kReadAttempts; ++attempt) {
+        if (!acquire(frame)) {
+            if (getLatestFrame() == 0 || reopenRequired()) {
+                break;
+            }
+            continue;
+        }
+        fields.resize(frame.count);
+        for (size_t i = 0; i < frame.count; ++i) {
+            QuantumSoundField& field = fields[i];
+            field.amplitude = std::complex<double>(frame.amplitude_real[i], frame.amplitude_imag[i]);
+            field.phase = frame.phase[i];
+            field.frequency = frame.frequency[i];
+            field.quantum_state = static_cast<QuantumSoundState>(frame.state[i]);
+            field.position = SphericalCoord(frame.r[i], frame.theta[i], frame.phi[i], 0.0, frame.height[i]);
+            field.timestamp = {};
+        }
+        if (validate(frame)) {
+            return frame.frame;
+        }
+    }
+    fields.clear();
+    return 0;
+}
+
+} // namespace AnantaSound
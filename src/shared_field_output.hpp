@@ -0,0 +1,160 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include "sample_clock.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AnantaSound {
+
+// Output fields of a core in a memory-mapped file that other processes
+// (visualizers) map read-only, e.g. under /dev/shm.
+//
+// Layout (native byte order, checked on open):
+//   SharedFieldHeader | slot 0 | slot 1 | slot 2
+//   slot: SharedFieldSlotHeader | amplitude_real | amplitude_imag | phase |
+//         frequency | r | theta | phi | height (double[capacity] each) |
+//         state (uint8_t[capacity]), every array 64-byte aligned
+// The writer fills frame n into slot n % 3 and then stores n in latest, so
+// the latest frame is never the one being written. Each slot is a seqlock:
+// its frame number is 0 while it is written. Readers take the latest frame
+// in place and re-check the slot's frame number once they are done; a
+// reader is only disturbed when it is two frames behind. Neither side ever
+// locks or waits for the other, and any number of readers may attach.
+constexpr char kSharedFieldMagic[8] = {'A', 'N', 'S', 'H', 'F', 'L', 'D', '\0'};
+constexpr uint32_t kSharedFieldFormatVersion = 1;
+constexpr uint32_t kSharedFieldByteOrderMark = 0x01020304;
+constexpr uint32_t kSharedFieldSlotCount = 3;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared output needs address-free 64-bit atomics");
+
+struct alignas(64) SharedFieldHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t capacity;                  // Fields per slot
+    uint32_t slot_count;
+    uint64_t slot_size;                 // Bytes
+    uint64_t region_size;               // Bytes, header included
+    std::atomic<uint64_t> latest;       // Last complete frame; 0 before the first
+};
+
+struct alignas(64) SharedFieldSlotHeader {
+    std::atomic<uint64_t> frame;        // 0 while the slot is being written
+    uint64_t count;                     // Fields stored (at most capacity)
+    uint64_t total_count;               // Fields the core held; more than count when truncated
+    uint64_t clock_sample;              // Core clock at publication
+    double clock_seconds;
+    uint64_t entangled_pairs;
+    double coherence_ratio;
+    double energy_efficiency;
+    double phase_coherence;
+};
+
+// One frame read in place. The pointers refer to the mapping and the data
+// is only known to be intact when SharedFieldReader::validate passes after
+// the reader is done with it.
+struct SharedFieldFrame {
+    uint64_t frame = 0;
+    size_t count = 0;
+    size_t total_count = 0;
+    uint64_t clock_sample = 0;
+    double clock_seconds = 0.0;
+    uint64_t entangled_pairs = 0;
+    double coherence_ratio = 0.0;
+    double energy_efficiency = 0.0;
+    double phase_coherence = 0.0;
+    const double* amplitude_real = nullptr;
+    const double* amplitude_imag = nullptr;
+    const double* phase = nullptr;
+    const double* frequency = nullptr;
+    const double* r = nullptr;
+    const double* theta = nullptr;
+    const double* phi = nullptr;
+    const double* height = nullptr;
+    const uint8_t* state = nullptr;     // QuantumSoundState values
+};
+
+// Writer side, owned by the application and attached to a core with
+// AnantaSoundCore::attachSharedOutput. Fields beyond capacity are left out
+// of a frame and counted in total_count.
+class SharedFieldOutput {
+private:
+    uint8_t* mapping_;
+    size_t mapping_size_;
+    uint32_t capacity_;
+    uint64_t frame_;
+
+    SharedFieldHeader* header() const { return reinterpret_cast<SharedFieldHeader*>(mapping_); }
+
+public:
+    SharedFieldOutput();
+    ~SharedFieldOutput();
+
+    SharedFieldOutput(const SharedFieldOutput&) = delete;
+    SharedFieldOutput& operator=(const SharedFieldOutput&) = delete;
+
+    // Create (or replace) the file at path sized for capacity fields per frame.
+    // A replaced file is swapped out whole: readers still attached keep
+    // the old region and open path again to follow the new one
+    bool open(const std::string& path, size_t capacity);
+    // Unmap; the file stays for readers still attached
+    void close();
+    bool isOpen() const { return mapping_ != nullptr; }
+
+    // Write one frame; called by the core at the end of each update
+    void publish(const FieldBuffer& fields, const AnantaSoundCore::SystemStatistics& statistics,
+                 const ClockTick& tick);
+
+    size_t getCapacity() const { return capacity_; }
+    uint64_t getFrame() const { return frame_; }
+
+    // Bytes of a region for capacity fields
+    static size_t regionSize(size_t capacity);
+};
+
+// Reader side for other processes: maps the file read-only
+class SharedFieldReader {
+private:
+    const uint8_t* mapping_;
+    size_t mapping_size_;
+    size_t capacity_;                   // Layout validated against mapping_size_ at open
+    size_t slot_size_;
+    mutable std::atomic<bool> reopen_required_;
+
+    const SharedFieldHeader* header() const { return reinterpret_cast<const SharedFieldHeader*>(mapping_); }
+    const SharedFieldSlotHeader* slot(uint64_t frame) const;
+
+public:
+    SharedFieldReader();
+    ~SharedFieldReader();
+
+    SharedFieldReader(const SharedFieldReader&) = delete;
+    SharedFieldReader& operator=(const SharedFieldReader&) = delete;
+
+    // false when the file is missing or not a shared output of this format
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapping_ != nullptr; }
+
+    // Latest complete frame number (0 before the first)
+    uint64_t getLatestFrame() const;
+
+    // Point frame at the latest frame in place; false before the first
+    // frame or when the writer overtook the reader meanwhile (retry)
+    bool acquire(SharedFieldFrame& frame) const;
+    // true once the header no longer matches the layout checked at open;
+    // the mapping is then never indexed again and the reader must reopen
+    bool reopenRequired() const { return reopen_required_.load(std::memory_order_relaxed); }
+    // true when the data acquired in frame was not overwritten since
+    bool validate(const SharedFieldFrame& frame) const;
+
+    // Copy the latest frame into fields (retrying past the writer);
+    // timestamps are left unset. Returns the frame number, 0 if none
+    uint64_t readFields(std::vector<QuantumSoundField>& fields) const;
+};
+
+} // namespace AnantaSound
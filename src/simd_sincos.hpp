@@ -0,0 +1,141 @@
+#pragma once
+
+// Vector sincos shared by the SIMD kernels (internal header).
+// Phases are reduced by n·π/2 with a three-part Cody-Waite split and
+// evaluated with the Cephes minimax polynomials: a few ulp for |phase| up
+// to ~1e5 rad, either sign.
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ANANTASOUND_X86_DISPATCH 1
+#include <immintrin.h>
+
+// GCC flags the _mm512_undefined_pd() pass-through operands inside its own
+// intrinsic headers as uninitialized; the values are never read. Every
+// AVX-512 section is wrapped in this pair to silence exactly that
+#if defined(__GNUC__) && !defined(__clang__)
+#define ANANTASOUND_AVX512_DIAGNOSTICS_PUSH                     \
+    _Pragma("GCC diagnostic push")                              \
+    _Pragma("GCC diagnostic ignored \"-Wuninitialized\"")       \
+    _Pragma("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+#define ANANTASOUND_AVX512_DIAGNOSTICS_POP _Pragma("GCC diagnostic pop")
+#else
+#define ANANTASOUND_AVX512_DIAGNOSTICS_PUSH
+#define ANANTASOUND_AVX512_DIAGNOSTICS_POP
+#endif
+#endif
+
+namespace AnantaSound {
+namespace detail {
+
+// π/2 split in three parts for Cody-Waite argument reduction (fdlibm);
+// n · kPiOver2High is exact for quadrant counts below 2^20
+constexpr double kTwoOverPi = 0.63661977236758134308;
+constexpr double kPiOver2High = 1.57079632673412561417e+00;
+constexpr double kPiOver2Mid = 6.07710050630396597660e-11;
+constexpr double kPiOver2Low = 2.02226624871116645580e-21;
+
+// Minimax polynomials on [-π/4, π/4] (Cephes sin/cos)
+constexpr double kSin0 = 1.58962301576546568060e-10;
+constexpr double kSin1 = -2.50507477628578072866e-8;
+constexpr double kSin2 = 2.75573136213857245213e-6;
+constexpr double kSin3 = -1.98412698295895385996e-4;
+constexpr double kSin4 = 8.33333333332211858878e-3;
+constexpr double kSin5 = -1.66666666666666307295e-1;
+
+constexpr double kCos0 = -1.13585365213876817300e-11;
+constexpr double kCos1 = 2.08757008419747316778e-9;
+constexpr double kCos2 = -2.75573141792967388112e-7;
+constexpr double kCos3 = 2.48015872888517045348e-5;
+constexpr double kCos4 = -1.38888888888730564116e-3;
+constexpr double kCos5 = 4.16666666666665929218e-2;
+
+#ifdef ANANTASOUND_X86_DISPATCH
+
+__attribute__((target("avx2,fma")))
+inline __m256d polynomialAVX2(__m256d x, double c0, double c1, double c2,
+                              double c3, double c4, double c5) {
+    __m256d p = _mm256_set1_pd(c0);
+    p = _mm256_fmadd_pd(p, x, _mm256_set1_pd(c1));
+    p = _mm256_fmadd_pd(p, x, _mm256_set1_pd(c2));
+    p = _mm256_fmadd_pd(p, x, _mm256_set1_pd(c3));
+    p = _mm256_fmadd_pd(p, x, _mm256_set1_pd(c4));
+    return _mm256_fmadd_pd(p, x, _mm256_set1_pd(c5));
+}
+
+// sin and cos of four phases
+__attribute__((target("avx2,fma")))
+inline void sincosAVX2(__m256d phase, __m256d& sin_out, __m256d& cos_out) {
+    __m256d n = _mm256_round_pd(_mm256_mul_pd(phase, _mm256_set1_pd(kTwoOverPi)),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(kPiOver2High), phase);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(kPiOver2Mid), r);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(kPiOver2Low), r);
+
+    __m256d r2 = _mm256_mul_pd(r, r);
+    __m256d s = _mm256_fmadd_pd(_mm256_mul_pd(r, r2),
+                                polynomialAVX2(r2, kSin0, kSin1, kSin2, kSin3, kSin4, kSin5), r);
+    __m256d c = _mm256_fmadd_pd(_mm256_mul_pd(r2, r2),
+                                polynomialAVX2(r2, kCos0, kCos1, kCos2, kCos3, kCos4, kCos5),
+                                _mm256_fnmadd_pd(_mm256_set1_pd(0.5), r2, _mm256_set1_pd(1.0)));
+
+    // Quadrant q: odd quadrants swap sin/cos; sin negates for q = 2, 3, cos for q = 1, 2
+    __m256i q = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n));
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i two = _mm256_set1_epi64x(2);
+    __m256d swap = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(q, one), one));
+    __m256d sin_negative = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(q, two), 62));
+    __m256d cos_negative = _mm256_castsi256_pd(
+        _mm256_slli_epi64(_mm256_and_si256(_mm256_add_epi64(q, one), two), 62));
+
+    sin_out = _mm256_xor_pd(_mm256_blendv_pd(s, c, swap), sin_negative);
+    cos_out = _mm256_xor_pd(_mm256_blendv_pd(c, s, swap), cos_negative);
+}
+
+ANANTASOUND_AVX512_DIAGNOSTICS_PUSH
+
+__attribute__((target("avx512f")))
+inline __m512d polynomialAVX512(__m512d x, double c0, double c1, double c2,
+                                double c3, double c4, double c5) {
+    __m512d p = _mm512_set1_pd(c0);
+    p = _mm512_fmadd_pd(p, x, _mm512_set1_pd(c1));
+    p = _mm512_fmadd_pd(p, x, _mm512_set1_pd(c2));
+    p = _mm512_fmadd_pd(p, x, _mm512_set1_pd(c3));
+    p = _mm512_fmadd_pd(p, x, _mm512_set1_pd(c4));
+    return _mm512_fmadd_pd(p, x, _mm512_set1_pd(c5));
+}
+
+__attribute__((target("avx512f")))
+inline void sincosAVX512(__m512d phase, __m512d& sin_out, __m512d& cos_out) {
+    __m512d n = _mm512_roundscale_pd(_mm512_mul_pd(phase, _mm512_set1_pd(kTwoOverPi)),
+                                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512d r = _mm512_fnmadd_pd(n, _mm512_set1_pd(kPiOver2High), phase);
+    r = _mm512_fnmadd_pd(n, _mm512_set1_pd(kPiOver2Mid), r);
+    r = _mm512_fnmadd_pd(n, _mm512_set1_pd(kPiOver2Low), r);
+
+    __m512d r2 = _mm512_mul_pd(r, r);
+    __m512d s = _mm512_fmadd_pd(_mm512_mul_pd(r, r2),
+                                polynomialAVX512(r2, kSin0, kSin1, kSin2, kSin3, kSin4, kSin5), r);
+    __m512d c = _mm512_fmadd_pd(_mm512_mul_pd(r2, r2),
+                                polynomialAVX512(r2, kCos0, kCos1, kCos2, kCos3, kCos4, kCos5),
+                                _mm512_fnmadd_pd(_mm512_set1_pd(0.5), r2, _mm512_set1_pd(1.0)));
+
+    __m512i q = _mm512_cvtepi32_epi64(_mm512_cvtpd_epi32(n));
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i two = _mm512_set1_epi64(2);
+    __mmask8 swap = _mm512_test_epi64_mask(q, one);
+    __mmask8 sin_negative = _mm512_test_epi64_mask(q, two);
+    __mmask8 cos_negative = _mm512_test_epi64_mask(_mm512_add_epi64(q, one), two);
+
+    __m512d sin_value = _mm512_mask_blend_pd(swap, s, c);
+    __m512d cos_value = _mm512_mask_blend_pd(swap, c, s);
+    const __m512d zero = _mm512_setzero_pd();
+    sin_out = _mm512_mask_sub_pd(sin_value, sin_negative, zero, sin_value);
+    cos_out = _mm512_mask_sub_pd(cos_value, cos_negative, zero, cos_value);
+}
+
+ANANTASOUND_AVX512_DIAGNOSTICS_POP
+
+#endif // ANANTASOUND_X86_DISPATCH
+
+} // namespace detail
+} // namespace AnantaSound
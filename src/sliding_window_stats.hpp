@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace AnantaSound {
+
+// Mean and variance over the last `capacity` values in O(1) per push.
+// Values live in a ring allocated once; the moments follow Welford's update
+// while the window fills and its sliding form (the evicted value is replaced
+// by the new one) afterwards, which stays stable over arbitrarily long
+// streams. Variance is the population variance of the window.
+class SlidingWindowStats {
+private:
+    std::vector<double> values_;
+    size_t next_;
+    size_t count_;
+    double mean_;
+    double m2_;                 // Sum of squared deviations from the mean
+
+public:
+    explicit SlidingWindowStats(size_t capacity)
+        : values_(std::max<size_t>(capacity, 1), 0.0), next_(0), count_(0), mean_(0.0), m2_(0.0) {
+    }
+
+    void push(double value) {
+        if (count_ < values_.size()) {
+            ++count_;
+            double delta = value - mean_;
+            mean_ += delta / static_cast<double>(count_);
+            m2_ += delta * (value - mean_);
+        } else {
+            double evicted = values_[next_];
+            double old_mean = mean_;
+            mean_ += (value - evicted) / static_cast<double>(count_);
+            m2_ += (value - evicted) * (value - mean_ + evicted - old_mean);
+            m2_ = std::max(0.0, m2_);
+        }
+        values_[next_] = value;
+        next_ = (next_ + 1) % values_.size();
+    }
+
+    void clear() {
+        next_ = 0;
+        count_ = 0;
+        mean_ = 0.0;
+        m2_ = 0.0;
+    }
+
+    size_t size() const { return count_; }
+    size_t capacity() const { return values_.size(); }
+    bool empty() const { return count_ == 0; }
+
+    // Newest value; the window must not be empty
+    double back() const { return values_[(next_ + values_.size() - 1) % values_.size()]; }
+
+    double mean() const { return mean_; }
+    double variance() const { return count_ > 0 ? m2_ / static_cast<double>(count_) : 0.0; }
+    double standardDeviation() const { return std::sqrt(variance()); }
+};
+
+} // namespace AnantaSound
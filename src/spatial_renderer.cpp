@@ -0,0 +1,508 @@
+#include "spatial_renderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace AnantaSound {
+
+namespace {
+
+// Below this |z| a layout counts as lacking speakers under (over) the
+// listener, so an imaginary nadir (zenith) speaker closes the hull
+constexpr double kImaginarySpeakerThreshold = 0.342;   // sin 20°
+
+// Virtual layout of the AllRAD decoder; dense enough to sample order 3
+// without spatial aliasing
+constexpr size_t kVirtualSpeakerCount = 240;
+
+// Weights may dip this far below zero on a triangle edge
+constexpr double kEdgeTolerance = 1e-9;
+
+// Lanes of the oscillator recurrence (independent phasors per field)
+constexpr size_t kOscillatorLanes = 8;
+
+SpatialDirection cross(const SpatialDirection& a, const SpatialDirection& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+double dot(const SpatialDirection& a, const SpatialDirection& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// Quasi-uniform points on the sphere (Fibonacci lattice)
+SpatialDirection fibonacciPoint(size_t index, size_t count) {
+    const double golden_angle = M_PI * (3.0 - std::sqrt(5.0));
+    double z = 1.0 - (2.0 * static_cast<double>(index) + 1.0) / static_cast<double>(count);
+    double planar = std::sqrt(std::max(0.0, 1.0 - z * z));
+    double azimuth = golden_angle * static_cast<double>(index);
+    return {planar * std::cos(azimuth), planar * std::sin(azimuth), z};
+}
+
+// max-rE weight of each order (Zotter & Frank): P_n(cos(137.9° / (N + 1.51)))
+void maxReWeights(size_t order, double* weights) {
+    const double re = std::cos(2.4068 / (static_cast<double>(order) + 1.51));
+    double previous = 1.0;
+    double current = re;
+    weights[0] = 1.0;
+    if (order >= 1) {
+        weights[1] = re;
+    }
+    for (size_t n = 2; n <= order; ++n) {
+        double next = ((2.0 * n - 1.0) * re * current - (n - 1.0) * previous) / static_cast<double>(n);
+        previous = current;
+        current = next;
+        weights[n] = next;
+    }
+}
+
+} // namespace
+
+SpatialDirection SpatialDirection::fromSpherical(double theta, double phi) {
+    double planar = std::sin(theta);
+    return {planar * std::cos(phi), planar * std::sin(phi), std::cos(theta)};
+}
+
+// SpeakerLayout
+SpeakerLayout::SpeakerLayout(const std::vector<SphericalCoord>& positions) {
+    directions_.reserve(positions.size());
+    for (const SphericalCoord& position : positions) {
+        directions_.push_back(SpatialDirection::fromSpherical(position));
+    }
+}
+
+SpeakerLayout SpeakerLayout::dome(const std::vector<size_t>& ring_sizes, bool zenith) {
+    std::vector<SphericalCoord> positions;
+    const double rings = static_cast<double>(std::max<size_t>(1, ring_sizes.size()));
+    for (size_t ring = 0; ring < ring_sizes.size(); ++ring) {
+        double elevation = 0.5 * M_PI * static_cast<double>(ring) / rings;
+        double offset = (ring % 2) ? 0.5 : 0.0;
+        for (size_t speaker = 0; speaker < ring_sizes[ring]; ++speaker) {
+            double azimuth = 2.0 * M_PI * (static_cast<double>(speaker) + offset) / static_cast<double>(ring_sizes[ring]);
+            positions.emplace_back(1.0, 0.5 * M_PI - elevation, azimuth);
+        }
+    }
+    if (zenith) {
+        positions.emplace_back(1.0, 0.0, 0.0);
+    }
+    return SpeakerLayout(positions);
+}
+
+// SpatialRenderer
+SpatialRenderer::SpatialRenderer(const SpeakerLayout& layout, size_t sample_rate,
+                                 const SpatialRendererOptions& options)
+    : layout_(layout)
+    , sample_rate_(std::max<size_t>(1, sample_rate))
+    , options_(options)
+    , kernels_(&getSpectralKernels())
+    , position_(0)
+    , ambisonic_channels_(0) {
+
+    options_.ambisonic_order = std::clamp<size_t>(options.ambisonic_order, 1, kMaxAmbisonicOrder);
+    speaker_gains_.assign(layout_.size(), 0.0);
+
+    buildTriangulation();
+    if (options_.method == SpatialMethod::AMBISONICS) {
+        buildDecoder();
+    }
+}
+
+void SpatialRenderer::buildTriangulation() {
+    hull_directions_ = layout_.getDirections();
+    double lowest = 1.0;
+    double highest = -1.0;
+    for (const SpatialDirection& direction : hull_directions_) {
+        lowest = std::min(lowest, direction.z);
+        highest = std::max(highest, direction.z);
+    }
+    if (!hull_directions_.empty() && lowest > -kImaginarySpeakerThreshold) {
+        hull_directions_.push_back({0.0, 0.0, -1.0});
+    }
+    if (!hull_directions_.empty() && highest < kImaginarySpeakerThreshold) {
+        hull_directions_.push_back({0.0, 0.0, 1.0});
+    }
+
+    // Convex hull faces: planes with every direction on the listener's side.
+    // Speaker counts are small, so a direct O(n^4) search is cheap and, unlike
+    // incremental hulls, indifferent to coplanar rings.
+    const size_t count = hull_directions_.size();
+    triangles_.clear();
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = i + 1; j < count; ++j) {
+            for (size_t k = j + 1; k < count; ++k) {
+                const SpatialDirection& a = hull_directions_[i];
+                const SpatialDirection& b = hull_directions_[j];
+                const SpatialDirection& c = hull_directions_[k];
+                SpatialDirection normal = cross({b.x - a.x, b.y - a.y, b.z - a.z}, {c.x - a.x, c.y - a.y, c.z - a.z});
+                double length = std::sqrt(dot(normal, normal));
+                if (length < 1e-9) {
+                    continue;
+                }
+                double offset = dot(normal, a) / length;
+                if (std::abs(offset) < 1e-9) {
+                    continue;       // Plane through the listener: no panning triangle
+                }
+                double side = offset > 0.0 ? 1.0 : -1.0;
+
+                bool face = true;
+                for (size_t m = 0; m < count && face; ++m) {
+                    if (m != i && m != j && m != k) {
+                        face = side * dot(normal, hull_directions_[m]) / length <= side * offset + 1e-9;
+                    }
+                }
+                if (!face) {
+                    continue;
+                }
+
+                // Rows of [a b c]^-1 are (b x c, c x a, a x b) / det
+                double determinant = dot(a, cross(b, c));
+                if (std::abs(determinant) < 1e-12) {
+                    continue;
+                }
+                Triangle triangle;
+                triangle.speakers[0] = static_cast<uint32_t>(i);
+                triangle.speakers[1] = static_cast<uint32_t>(j);
+                triangle.speakers[2] = static_cast<uint32_t>(k);
+                const SpatialDirection rows[3] = {cross(b, c), cross(c, a), cross(a, b)};
+                for (size_t row = 0; row < 3; ++row) {
+                    triangle.inverse[3 * row] = rows[row].x / determinant;
+                    triangle.inverse[3 * row + 1] = rows[row].y / determinant;
+                    triangle.inverse[3 * row + 2] = rows[row].z / determinant;
+                }
+                triangles_.push_back(triangle);
+            }
+        }
+    }
+
+    // Real neighbours of each imaginary speaker inherit its gain
+    const size_t real = layout_.size();
+    imaginary_neighbours_.assign(count - real, {});
+    for (const Triangle& triangle : triangles_) {
+        for (uint32_t corner : triangle.speakers) {
+            if (corner < real) {
+                continue;
+            }
+            std::vector<uint32_t>& neighbours = imaginary_neighbours_[corner - real];
+            for (uint32_t other : triangle.speakers) {
+                if (other < real && std::find(neighbours.begin(), neighbours.end(), other) == neighbours.end()) {
+                    neighbours.push_back(other);
+                }
+            }
+        }
+    }
+
+    // Lookup grid: the most central triangle around each cell centre
+    triangle_lookup_.assign(kLookupRows * kLookupColumns, 0);
+    if (triangles_.empty()) {
+        return;
+    }
+    double weights[3];
+    for (size_t row = 0; row < kLookupRows; ++row) {
+        double theta = M_PI * (static_cast<double>(row) + 0.5) / kLookupRows;
+        for (size_t column = 0; column < kLookupColumns; ++column) {
+            double phi = 2.0 * M_PI * (static_cast<double>(column) + 0.5) / kLookupColumns;
+            SpatialDirection centre = SpatialDirection::fromSpherical(theta, phi);
+            double best = -std::numeric_limits<double>::infinity();
+            for (size_t t = 0; t < triangles_.size(); ++t) {
+                triangleGains(triangles_[t], centre, weights);
+                double smallest = std::min({weights[0], weights[1], weights[2]});
+                if (smallest > best) {
+                    best = smallest;
+                    triangle_lookup_[row * kLookupColumns + column] = static_cast<uint32_t>(t);
+                }
+            }
+        }
+    }
+}
+
+void SpatialRenderer::buildDecoder() {
+    const size_t order = options_.ambisonic_order;
+    const size_t channels = (order + 1) * (order + 1);
+    const size_t speakers = layout_.size();
+    ambisonic_channels_ = channels;
+    decoder_.assign(speakers * channels, 0.0);
+
+    double weights[kMaxAmbisonicOrder + 1] = {1.0, 1.0, 1.0, 1.0};
+    if (options_.max_re) {
+        maxReWeights(order, weights);
+    }
+
+    // AllRAD: D = G · diag(w) · Y_virtual^T / V
+    std::vector<double> encoded(channels);
+    std::vector<double> gains(speakers);
+    for (size_t v = 0; v < kVirtualSpeakerCount; ++v) {
+        SpatialDirection direction = fibonacciPoint(v, kVirtualSpeakerCount);
+        encodeDirection(direction, order, encoded.data());
+        vbapGains(direction, gains.data());
+        for (size_t l = 0; l < speakers; ++l) {
+            if (gains[l] == 0.0) {
+                continue;
+            }
+            double* row = decoder_.data() + l * channels;
+            for (size_t n = 0, k = 0; n <= order; ++n) {
+                for (size_t m = 0; m < 2 * n + 1; ++m, ++k) {
+                    row[k] += gains[l] * weights[n] * encoded[k];
+                }
+            }
+        }
+    }
+
+    // Unit mean energy over the sphere
+    double energy = 0.0;
+    for (size_t v = 0; v < kVirtualSpeakerCount; ++v) {
+        encodeDirection(fibonacciPoint(v, kVirtualSpeakerCount), order, encoded.data());
+        for (size_t l = 0; l < speakers; ++l) {
+            double gain = 0.0;
+            for (size_t k = 0; k < channels; ++k) {
+                gain += decoder_[l * channels + k] * encoded[k];
+            }
+            energy += gain * gain;
+        }
+    }
+    energy /= static_cast<double>(kVirtualSpeakerCount);
+    if (energy > 0.0) {
+        double scale = 1.0 / std::sqrt(energy);
+        for (double& value : decoder_) {
+            value *= scale;
+        }
+    }
+}
+
+void SpatialRenderer::encodeDirection(const SpatialDirection& direction, size_t order, double* gains) {
+    const double x = direction.x;
+    const double y = direction.y;
+    const double z = direction.z;
+
+    gains[0] = 1.0;
+    if (order < 1) {
+        return;
+    }
+    const double sqrt3 = std::sqrt(3.0);
+    gains[1] = sqrt3 * y;
+    gains[2] = sqrt3 * z;
+    gains[3] = sqrt3 * x;
+    if (order < 2) {
+        return;
+    }
+    const double sqrt15 = std::sqrt(15.0);
+    gains[4] = sqrt15 * x * y;
+    gains[5] = sqrt15 * y * z;
+    gains[6] = 0.5 * std::sqrt(5.0) * (3.0 * z * z - 1.0);
+    gains[7] = sqrt15 * x * z;
+    gains[8] = 0.5 * sqrt15 * (x * x - y * y);
+    if (order < 3) {
+        return;
+    }
+    const double c35 = std::sqrt(35.0 / 8.0);
+    const double c21 = std::sqrt(21.0 / 8.0);
+    const double sqrt105 = std::sqrt(105.0);
+    gains[9] = c35 * y * (3.0 * x * x - y * y);
+    gains[10] = sqrt105 * x * y * z;
+    gains[11] = c21 * y * (5.0 * z * z - 1.0);
+    gains[12] = 0.5 * std::sqrt(7.0) * z * (5.0 * z * z - 3.0);
+    gains[13] = c21 * x * (5.0 * z * z - 1.0);
+    gains[14] = 0.5 * sqrt105 * z * (x * x - y * y);
+    gains[15] = c35 * x * (x * x - 3.0 * y * y);
+}
+
+bool SpatialRenderer::triangleGains(const Triangle& triangle, const SpatialDirection& direction,
+                                    double* weights) const {
+    const double* inverse = triangle.inverse;
+    for (size_t row = 0; row < 3; ++row) {
+        weights[row] = inverse[3 * row] * direction.x + inverse[3 * row + 1] * direction.y +
+                       inverse[3 * row + 2] * direction.z;
+    }
+    return weights[0] >= -kEdgeTolerance && weights[1] >= -kEdgeTolerance && weights[2] >= -kEdgeTolerance;
+}
+
+size_t SpatialRenderer::lookupCell(const SpatialDirection& direction) const {
+    double theta = std::acos(std::clamp(direction.z, -1.0, 1.0));
+    double phi = std::atan2(direction.y, direction.x);
+    if (phi < 0.0) {
+        phi += 2.0 * M_PI;
+    }
+    size_t row = std::min(kLookupRows - 1, static_cast<size_t>(theta / M_PI * kLookupRows));
+    size_t column = static_cast<size_t>(phi / (2.0 * M_PI) * kLookupColumns) % kLookupColumns;
+    return row * kLookupColumns + column;
+}
+
+void SpatialRenderer::vbapGains(const SpatialDirection& direction, double* gains) const {
+    const size_t speakers = layout_.size();
+    std::fill(gains, gains + speakers, 0.0);
+    if (speakers == 0) {
+        return;
+    }
+    if (triangles_.empty()) {
+        std::fill(gains, gains + speakers, 1.0 / std::sqrt(static_cast<double>(speakers)));
+        return;
+    }
+
+    // The cached triangle covers the cell centre; near its edges the
+    // direction may belong to a neighbour, found by a full scan
+    double weights[3];
+    const Triangle* triangle = &triangles_[triangle_lookup_[lookupCell(direction)]];
+    if (!triangleGains(*triangle, direction, weights)) {
+        double best = -std::numeric_limits<double>::infinity();
+        double candidate[3];
+        for (const Triangle& other : triangles_) {
+            triangleGains(other, direction, candidate);
+            double smallest = std::min({candidate[0], candidate[1], candidate[2]});
+            if (smallest > best) {
+                best = smallest;
+                triangle = &other;
+                std::copy(candidate, candidate + 3, weights);
+            }
+        }
+    }
+
+    for (size_t corner = 0; corner < 3; ++corner) {
+        double weight = std::max(0.0, weights[corner]);
+        uint32_t speaker = triangle->speakers[corner];
+        if (speaker < speakers) {
+            gains[speaker] += weight;
+            continue;
+        }
+        const std::vector<uint32_t>& neighbours = imaginary_neighbours_[speaker - speakers];
+        for (uint32_t neighbour : neighbours) {
+            gains[neighbour] += weight / static_cast<double>(neighbours.size());
+        }
+    }
+
+    double energy = 0.0;
+    for (size_t l = 0; l < speakers; ++l) {
+        energy += gains[l] * gains[l];
+    }
+    double scale = energy > 0.0 ? 1.0 / std::sqrt(energy) : 0.0;
+    for (size_t l = 0; l < speakers; ++l) {
+        gains[l] *= scale;
+    }
+}
+
+void SpatialRenderer::panningGains(const SpatialDirection& direction, double* gains) const {
+    if (options_.method == SpatialMethod::VBAP) {
+        vbapGains(direction, gains);
+        return;
+    }
+
+    double encoded[(kMaxAmbisonicOrder + 1) * (kMaxAmbisonicOrder + 1)];
+    encodeDirection(direction, options_.ambisonic_order, encoded);
+    for (size_t l = 0; l < layout_.size(); ++l) {
+        const double* row = decoder_.data() + l * ambisonic_channels_;
+        double gain = 0.0;
+        for (size_t k = 0; k < ambisonic_channels_; ++k) {
+            gain += row[k] * encoded[k];
+        }
+        gains[l] = gain;
+    }
+}
+
+void SpatialRenderer::synthesizeFields(const FieldBuffer& fields, size_t first, size_t count, size_t frame_count) {
+    const double* amplitude_real = fields.amplitudeReal();
+    const double* amplitude_imag = fields.amplitudeImag();
+    const double* phases = fields.phases();
+    const double* frequencies = fields.frequencies();
+    const double rate = static_cast<double>(sample_rate_);
+
+    double lane_real[kOscillatorLanes];
+    double lane_imag[kOscillatorLanes];
+    for (size_t j = 0; j < count; ++j) {
+        const size_t field = first + j;
+        double* signal = field_signals_.data() + j * frame_count;
+
+        // Phase at the block start, reduced in cycles before scaling by 2π
+        double cycles = frequencies[field] * static_cast<double>(position_) / rate;
+        double start = phases[field] + 2.0 * M_PI * (cycles - std::floor(cycles));
+        double omega = 2.0 * M_PI * frequencies[field] / rate;
+
+        // Lane i holds the phasor of sample t + i and all lanes advance by
+        // kOscillatorLanes samples per step, so the loop vectorizes across lanes
+        double real = amplitude_real[field] * std::cos(start) - amplitude_imag[field] * std::sin(start);
+        double imag = amplitude_real[field] * std::sin(start) + amplitude_imag[field] * std::cos(start);
+        const double step_real = std::cos(omega);
+        const double step_imag = std::sin(omega);
+        for (size_t lane = 0; lane < kOscillatorLanes; ++lane) {
+            lane_real[lane] = real;
+            lane_imag[lane] = imag;
+            double next = real * step_real - imag * step_imag;
+            imag = real * step_imag + imag * step_real;
+            real = next;
+        }
+        const double stride_real = std::cos(kOscillatorLanes * omega);
+        const double stride_imag = std::sin(kOscillatorLanes * omega);
+
+        size_t t = 0;
+        for (; t + kOscillatorLanes <= frame_count; t += kOscillatorLanes) {
+            for (size_t lane = 0; lane < kOscillatorLanes; ++lane) {
+                signal[t + lane] = lane_real[lane];
+                double next = lane_real[lane] * stride_real - lane_imag[lane] * stride_imag;
+                lane_imag[lane] = lane_real[lane] * stride_imag + lane_imag[lane] * stride_real;
+                lane_real[lane] = next;
+            }
+        }
+        for (size_t lane = 0; t < frame_count; ++t, ++lane) {
+            signal[t] = lane_real[lane];
+        }
+    }
+}
+
+void SpatialRenderer::render(const FieldBuffer& fields, size_t frame_count, AudioBuffer& output) {
+    const size_t speakers = layout_.size();
+    if (output.getLayout() != ChannelLayout::PLANAR) {
+        output = AudioBuffer(speakers, frame_count, ChannelLayout::PLANAR);
+    } else {
+        output.resize(speakers, frame_count);
+    }
+    if (frame_count == 0 || speakers == 0) {
+        return;
+    }
+
+    const bool ambisonics = options_.method == SpatialMethod::AMBISONICS;
+    const size_t channels = ambisonic_channels_;
+    if (field_signals_.size() < kFieldChunk * frame_count) {
+        field_signals_.resize(kFieldChunk * frame_count);
+    }
+    if (ambisonics) {
+        encoder_.resize(channels * kFieldChunk);
+        ambisonic_block_.assign(channels * frame_count, 0.0);
+    }
+
+    const double* polar = fields.polarAngles();
+    const double* azimuth = fields.azimuthAngles();
+    double encoded[(kMaxAmbisonicOrder + 1) * (kMaxAmbisonicOrder + 1)];
+    for (size_t first = 0; first < fields.size(); first += kFieldChunk) {
+        const size_t count = std::min(kFieldChunk, fields.size() - first);
+        synthesizeFields(fields, first, count, frame_count);
+
+        if (ambisonics) {
+            // encoder_ is channels x count: ambisonic_block_ += E · signals
+            for (size_t j = 0; j < count; ++j) {
+                encodeDirection(SpatialDirection::fromSpherical(polar[first + j], azimuth[first + j]),
+                                options_.ambisonic_order, encoded);
+                for (size_t k = 0; k < channels; ++k) {
+                    encoder_[k * count + j] = encoded[k];
+                }
+            }
+            kernels_->mix_matrix(encoder_.data(), channels, count, field_signals_.data(), frame_count,
+                                 ambisonic_block_.data(), frame_count, frame_count);
+            continue;
+        }
+
+        // VBAP touches at most a few speakers per field
+        for (size_t j = 0; j < count; ++j) {
+            vbapGains(SpatialDirection::fromSpherical(polar[first + j], azimuth[first + j]), speaker_gains_.data());
+            const double* signal = field_signals_.data() + j * frame_count;
+            for (size_t l = 0; l < speakers; ++l) {
+                if (speaker_gains_[l] != 0.0) {
+                    kernels_->mix_matrix(&speaker_gains_[l], 1, 1, signal, 0, output.channel(l), 0, frame_count);
+                }
+            }
+        }
+    }
+
+    if (ambisonics && !fields.empty()) {
+        kernels_->mix_matrix(decoder_.data(), speakers, channels, ambisonic_block_.data(), frame_count,
+                             output.data(), frame_count, frame_count);
+    }
+    position_ += frame_count;
+}
+
+} // namespace AnantaSound
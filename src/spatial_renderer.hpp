@@ -0,0 +1,151 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include "audio_buffer.hpp"
+#include "spectral_kernels.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AnantaSound {
+
+// Unit direction of a dome position: theta is the polar angle from the
+// zenith, phi the azimuth; radius, time and height are ignored
+struct SpatialDirection {
+    double x, y, z;
+
+    static SpatialDirection fromSpherical(double theta, double phi);
+    static SpatialDirection fromSpherical(const SphericalCoord& position) {
+        return fromSpherical(position.theta, position.phi);
+    }
+};
+
+// Loudspeaker directions of a dome installation, in output channel order
+class SpeakerLayout {
+private:
+    std::vector<SpatialDirection> directions_;
+
+public:
+    SpeakerLayout() = default;
+    explicit SpeakerLayout(const std::vector<SphericalCoord>& positions);
+
+    // Horizontal rings of evenly spaced speakers, ring 0 on the horizon and
+    // later rings at evenly stepped elevations, optionally capped by one
+    // speaker at the zenith; rings are rotated half a speaker against each
+    // other
+    static SpeakerLayout dome(const std::vector<size_t>& ring_sizes, bool zenith = true);
+
+    size_t size() const { return directions_.size(); }
+    bool empty() const { return directions_.empty(); }
+    const SpatialDirection& operator[](size_t speaker) const { return directions_[speaker]; }
+    const std::vector<SpatialDirection>& getDirections() const { return directions_; }
+};
+
+enum class SpatialMethod {
+    AMBISONICS,     // Higher-order ambisonics with an AllRAD decoder
+    VBAP            // Vector-base amplitude panning over the speaker triangles
+};
+
+struct SpatialRendererOptions {
+    SpatialMethod method = SpatialMethod::AMBISONICS;
+    size_t ambisonic_order = 3;         // 1..SpatialRenderer::kMaxAmbisonicOrder
+    bool max_re = true;                 // max-rE order weights: narrower spread, weaker side lobes
+};
+
+// Renders sound fields to loudspeaker feeds.
+// Every field is a sinusoid Re(amplitude · exp(i(phase + 2π f t))) placed at
+// its dome direction; t runs on the renderer's own sample clock, so
+// consecutive blocks join without phase jumps. Gains are held for a block.
+//
+// VBAP: the convex hull of the speaker directions is triangulated once and
+// a direction grid remembers the triangle around each cell centre, so
+// panning a field is one 3x3 multiply in the common case. Layouts without
+// speakers far below (or above) the horizon get an imaginary speaker at the
+// nadir (zenith) whose gain is shared among its hull neighbours.
+//
+// Ambisonics: fields are encoded into (order + 1)^2 channels (ACN order,
+// N3D normalization) and decoded by a precomputed AllRAD matrix: the
+// ambisonic sphere is sampled at a dense uniform virtual layout and each
+// virtual speaker is VBAP-panned onto the real ones, which suits the
+// irregular hemispherical layouts of domes where a direct pseudo-inverse
+// decoder is ill-conditioned. Encoding and decoding are planar matrix
+// products on the SIMD mix_matrix kernel; field signals are generated in
+// chunks, so scratch memory does not grow with the field count.
+//
+// Not thread-safe: one renderer per output stream.
+class SpatialRenderer {
+public:
+    static constexpr size_t kMaxAmbisonicOrder = 3;
+    static constexpr size_t kFieldChunk = 64;           // Fields synthesized per matrix product
+
+private:
+    struct Triangle {
+        uint32_t speakers[3];
+        double inverse[9];                              // Row-major inverse of [l1 l2 l3]
+    };
+
+    SpeakerLayout layout_;
+    size_t sample_rate_;
+    SpatialRendererOptions options_;
+    const SpectralKernelTable* kernels_;
+    uint64_t position_;                                 // Samples rendered so far
+
+    // VBAP: hull over the real speakers followed by any imaginary ones
+    std::vector<SpatialDirection> hull_directions_;
+    std::vector<Triangle> triangles_;
+    std::vector<uint32_t> triangle_lookup_;             // kLookupRows x kLookupColumns cells
+    std::vector<std::vector<uint32_t>> imaginary_neighbours_;
+
+    // Ambisonics
+    size_t ambisonic_channels_;
+    std::vector<double> decoder_;                       // speakers x channels, row-major
+
+    // Block scratch (grows to the largest block, then reused)
+    std::vector<double> field_signals_;                 // kFieldChunk x frames
+    std::vector<double> encoder_;                       // channels x kFieldChunk
+    std::vector<double> ambisonic_block_;               // channels x frames
+    std::vector<double> speaker_gains_;                 // One field's panning gains
+
+public:
+    explicit SpatialRenderer(const SpeakerLayout& layout, size_t sample_rate = 44100,
+                             const SpatialRendererOptions& options = SpatialRendererOptions());
+
+    // Render frame_count samples of every field into one planar channel per
+    // speaker; output is resized (and made planar) as needed and overwritten
+    void render(const FieldBuffer& fields, size_t frame_count, AudioBuffer& output);
+
+    // Speaker gains of a source in this direction (getSpeakerCount() values)
+    void panningGains(const SpatialDirection& direction, double* gains) const;
+
+    // Ambisonic encoding gains of a direction ((order + 1)^2 values, ACN / N3D)
+    static void encodeDirection(const SpatialDirection& direction, size_t order, double* gains);
+
+    // Restart the sample clock (e.g. after a seek)
+    void reset() { position_ = 0; }
+
+    size_t getSpeakerCount() const { return layout_.size(); }
+    size_t getAmbisonicChannelCount() const { return ambisonic_channels_; }
+    size_t getTriangleCount() const { return triangles_.size(); }
+    size_t getImaginarySpeakerCount() const { return hull_directions_.size() - layout_.size(); }
+    const std::vector<double>& getDecoder() const { return decoder_; }
+    const SpeakerLayout& getLayout() const { return layout_; }
+    const SpatialRendererOptions& getOptions() const { return options_; }
+    uint64_t getPosition() const { return position_; }
+
+private:
+    static constexpr size_t kLookupRows = 36;           // 5° polar cells
+    static constexpr size_t kLookupColumns = 72;        // 5° azimuth cells
+
+    void buildTriangulation();
+    void buildDecoder();
+
+    // VBAP gains over the real speakers (energy-normalized)
+    void vbapGains(const SpatialDirection& direction, double* gains) const;
+    bool triangleGains(const Triangle& triangle, const SpatialDirection& direction, double* weights) const;
+    size_t lookupCell(const SpatialDirection& direction) const;
+
+    // Signals of fields [first, first + count) for this block
+    void synthesizeFields(const FieldBuffer& fields, size_t first, size_t count, size_t frame_count);
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,1091 @@
+#include "spectral_kernels.hpp"
+#include "simd_sincos.hpp"
+#include <cmath>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define ANANTASOUND_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace AnantaSound {
+
+namespace {
+
+// Combine per-lane partial results of a vector kernel into the moments.
+// Ties resolve to the lowest bin index, matching std::max_element.
+template<typename Real>
+void reduceLanes(const Real* sums, const Real* weighted, const Real* best,
+                 const Real* best_index, size_t lanes, SpectralMoments& moments) {
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        moments.magnitude_sum += sums[lane];
+        moments.weighted_sum += weighted[lane];
+
+        if (best[lane] < Real(0)) {
+            continue;
+        }
+        size_t index = static_cast<size_t>(best_index[lane]);
+        double peak = best[lane];
+        if (peak > moments.peak_magnitude ||
+            (peak == moments.peak_magnitude && index < moments.peak_bin)) {
+            moments.peak_magnitude = peak;
+            moments.peak_bin = index;
+        }
+    }
+}
+
+// Scalar tail shared by all kernels; starts at bin `start`
+template<typename Real>
+void magnitudeMomentsTail(const std::complex<Real>* bins, size_t start, size_t count,
+                          Real* magnitude, SpectralMoments& moments, bool have_peak) {
+    for (size_t k = start; k < count; ++k) {
+        Real re = bins[k].real();
+        Real im = bins[k].imag();
+        Real mag = std::sqrt(re * re + im * im);
+        magnitude[k] = mag;
+        moments.magnitude_sum += mag;
+        moments.weighted_sum += static_cast<double>(k) * mag;
+
+        if (!have_peak || mag > moments.peak_magnitude) {
+            moments.peak_magnitude = mag;
+            moments.peak_bin = k;
+            have_peak = true;
+        }
+    }
+}
+
+// ---- Scalar reference -------------------------------------------------------
+
+template<typename Real>
+void magnitudeMomentsScalar(const std::complex<Real>* bins, size_t count,
+                            Real* magnitude, SpectralMoments& moments) {
+    moments = SpectralMoments();
+    magnitudeMomentsTail(bins, 0, count, magnitude, moments, false);
+}
+
+// Squares are accumulated in double for both precisions
+template<typename Real>
+double sumOfSquaresScalar(const Real* samples, size_t count) {
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double x = samples[i];
+        sum += x * x;
+    }
+    return sum;
+}
+
+template<typename Real>
+size_t zeroCrossingsScalar(const Real* samples, size_t count) {
+    size_t crossings = 0;
+    for (size_t i = 1; i < count; ++i) {
+        if ((samples[i] >= Real(0)) != (samples[i - 1] >= Real(0))) {
+            crossings++;
+        }
+    }
+    return crossings;
+}
+
+template<typename Real>
+Real dotProductScalar(const Real* a, const Real* b, size_t count) {
+    Real sum = Real(0);
+    for (size_t i = 0; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+// Frames [start, frames) of every output row, one input channel at a time
+template<typename Real>
+void mixMatrixTail(const Real* gains, size_t rows, size_t inputs, const Real* input, size_t input_stride,
+                   Real* output, size_t output_stride, size_t start, size_t frames) {
+    for (size_t r = 0; r < rows; ++r) {
+        Real* row = output + r * output_stride;
+        const Real* row_gains = gains + r * inputs;
+        for (size_t k = 0; k < inputs; ++k) {
+            const Real gain = row_gains[k];
+            const Real* channel = input + k * input_stride;
+            for (size_t t = start; t < frames; ++t) {
+                row[t] += gain * channel[t];
+            }
+        }
+    }
+}
+
+template<typename Real>
+void mixMatrixScalar(const Real* gains, size_t rows, size_t inputs, const Real* input, size_t input_stride,
+                     Real* output, size_t output_stride, size_t frames) {
+    mixMatrixTail(gains, rows, inputs, input, input_stride, output, output_stride, 0, frames);
+}
+
+// ---- AVX2 -------------------------------------------------------------------
+
+#ifdef ANANTASOUND_X86_DISPATCH
+
+__attribute__((target("avx2,fma")))
+void magnitudeMomentsAVX2(const std::complex<double>* bins, size_t count,
+                          double* magnitude, SpectralMoments& moments) {
+    moments = SpectralMoments();
+    const double* data = reinterpret_cast<const double*>(bins);
+
+    __m256d sum = _mm256_setzero_pd();
+    __m256d weighted = _mm256_setzero_pd();
+    __m256d best = _mm256_set1_pd(-1.0);
+    __m256d best_index = _mm256_setzero_pd();
+    __m256d index = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+    const __m256d step = _mm256_set1_pd(4.0);
+
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m256d a = _mm256_loadu_pd(data + 2 * k);        // r0 i0 r1 i1
+        __m256d b = _mm256_loadu_pd(data + 2 * k + 4);    // r2 i2 r3 i3
+        __m256d re = _mm256_unpacklo_pd(a, b);            // r0 r2 r1 r3
+        __m256d im = _mm256_unpackhi_pd(a, b);            // i0 i2 i1 i3
+        __m256d power = _mm256_fmadd_pd(im, im, _mm256_mul_pd(re, re));
+        __m256d mag = _mm256_permute4x64_pd(_mm256_sqrt_pd(power), _MM_SHUFFLE(3, 1, 2, 0));
+
+        _mm256_storeu_pd(magnitude + k, mag);
+        sum = _mm256_add_pd(sum, mag);
+        weighted = _mm256_fmadd_pd(mag, index, weighted);
+
+        __m256d greater = _mm256_cmp_pd(mag, best, _CMP_GT_OQ);
+        best = _mm256_blendv_pd(best, mag, greater);
+        best_index = _mm256_blendv_pd(best_index, index, greater);
+        index = _mm256_add_pd(index, step);
+    }
+
+    alignas(32) double lane_sum[4], lane_weighted[4], lane_best[4], lane_index[4];
+    _mm256_store_pd(lane_sum, sum);
+    _mm256_store_pd(lane_weighted, weighted);
+    _mm256_store_pd(lane_best, best);
+    _mm256_store_pd(lane_index, best_index);
+    reduceLanes(lane_sum, lane_weighted, lane_best, lane_index, 4, moments);
+
+    magnitudeMomentsTail(bins, k, count, magnitude, moments, k > 0);
+}
+
+__attribute__((target("avx2,fma")))
+double sumOfSquaresAVX2(const double* samples, size_t count) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256d x0 = _mm256_loadu_pd(samples + i);
+        __m256d x1 = _mm256_loadu_pd(samples + i + 4);
+        acc0 = _mm256_fmadd_pd(x0, x0, acc0);
+        acc1 = _mm256_fmadd_pd(x1, x1, acc1);
+    }
+
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+    double sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+    for (; i < count; ++i) {
+        sum += samples[i] * samples[i];
+    }
+    return sum;
+}
+
+__attribute__((target("avx2,popcnt")))
+size_t zeroCrossingsAVX2(const double* samples, size_t count) {
+    if (count < 2) {
+        return 0;
+    }
+
+    const __m256d zero = _mm256_setzero_pd();
+    size_t crossings = 0;
+
+    size_t i = 1;
+    for (; i + 4 <= count; i += 4) {
+        __m256d current = _mm256_cmp_pd(_mm256_loadu_pd(samples + i), zero, _CMP_GE_OQ);
+        __m256d previous = _mm256_cmp_pd(_mm256_loadu_pd(samples + i - 1), zero, _CMP_GE_OQ);
+        int changed = _mm256_movemask_pd(_mm256_xor_pd(current, previous));
+        crossings += static_cast<size_t>(__builtin_popcount(changed));
+    }
+
+    for (; i < count; ++i) {
+        if ((samples[i] >= 0.0) != (samples[i - 1] >= 0.0)) {
+            crossings++;
+        }
+    }
+    return crossings;
+}
+
+__attribute__((target("avx2,fma")))
+double dotProductAVX2(const double* a, const double* b, size_t count) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), acc1);
+    }
+
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+    double sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+// Each output tile stays in registers while every input channel is added
+// into it, so a row is loaded and stored once per tile
+__attribute__((target("avx2,fma")))
+void mixMatrixAVX2(const double* gains, size_t rows, size_t inputs, const double* input, size_t input_stride,
+                   double* output, size_t output_stride, size_t frames) {
+    size_t t = 0;
+    for (; t + 8 <= frames; t += 8) {
+        for (size_t r = 0; r < rows; ++r) {
+            double* row = output + r * output_stride + t;
+            const double* row_gains = gains + r * inputs;
+            __m256d acc0 = _mm256_loadu_pd(row);
+            __m256d acc1 = _mm256_loadu_pd(row + 4);
+            for (size_t k = 0; k < inputs; ++k) {
+                const double* channel = input + k * input_stride + t;
+                __m256d gain = _mm256_set1_pd(row_gains[k]);
+                acc0 = _mm256_fmadd_pd(gain, _mm256_loadu_pd(channel), acc0);
+                acc1 = _mm256_fmadd_pd(gain, _mm256_loadu_pd(channel + 4), acc1);
+            }
+            _mm256_storeu_pd(row, acc0);
+            _mm256_storeu_pd(row + 4, acc1);
+        }
+    }
+    mixMatrixTail(gains, rows, inputs, input, input_stride, output, output_stride, t, frames);
+}
+
+// Float kernels: 8 bins / samples per vector. Squares are widened to double
+// before accumulation so long frames keep double-precision energy.
+
+__attribute__((target("avx2,fma")))
+void magnitudeMomentsAVX2F(const std::complex<float>* bins, size_t count,
+                           float* magnitude, SpectralMoments& moments) {
+    moments = SpectralMoments();
+    const float* data = reinterpret_cast<const float*>(bins);
+
+    __m256 sum = _mm256_setzero_ps();
+    __m256 weighted = _mm256_setzero_ps();
+    __m256 best = _mm256_set1_ps(-1.0f);
+    __m256 best_index = _mm256_setzero_ps();
+    __m256 index = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+    const __m256 step = _mm256_set1_ps(8.0f);
+
+    size_t k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256 a = _mm256_loadu_ps(data + 2 * k);                    // r0 i0 r1 i1 | r2 i2 r3 i3
+        __m256 b = _mm256_loadu_ps(data + 2 * k + 8);                // r4 i4 r5 i5 | r6 i6 r7 i7
+        __m256 re = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)); // r0 r1 r4 r5 | r2 r3 r6 r7
+        __m256 im = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)); // i0 i1 i4 i5 | i2 i3 i6 i7
+        __m256 power = _mm256_fmadd_ps(im, im, _mm256_mul_ps(re, re));
+        __m256 mag = _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(_mm256_sqrt_ps(power)), _MM_SHUFFLE(3, 1, 2, 0)));
+
+        _mm256_storeu_ps(magnitude + k, mag);
+        sum = _mm256_add_ps(sum, mag);
+        weighted = _mm256_fmadd_ps(mag, index, weighted);
+
+        __m256 greater = _mm256_cmp_ps(mag, best, _CMP_GT_OQ);
+        best = _mm256_blendv_ps(best, mag, greater);
+        best_index = _mm256_blendv_ps(best_index, index, greater);
+        index = _mm256_add_ps(index, step);
+    }
+
+    alignas(32) float lane_sum[8], lane_weighted[8], lane_best[8], lane_index[8];
+    _mm256_store_ps(lane_sum, sum);
+    _mm256_store_ps(lane_weighted, weighted);
+    _mm256_store_ps(lane_best, best);
+    _mm256_store_ps(lane_index, best_index);
+    reduceLanes(lane_sum, lane_weighted, lane_best, lane_index, 8, moments);
+
+    magnitudeMomentsTail(bins, k, count, magnitude, moments, k > 0);
+}
+
+__attribute__((target("avx2,fma")))
+double sumOfSquaresAVX2F(const float* samples, size_t count) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256d x0 = _mm256_cvtps_pd(_mm_loadu_ps(samples + i));
+        __m256d x1 = _mm256_cvtps_pd(_mm_loadu_ps(samples + i + 4));
+        acc0 = _mm256_fmadd_pd(x0, x0, acc0);
+        acc1 = _mm256_fmadd_pd(x1, x1, acc1);
+    }
+
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+    double sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+    for (; i < count; ++i) {
+        double x = samples[i];
+        sum += x * x;
+    }
+    return sum;
+}
+
+__attribute__((target("avx2,popcnt")))
+size_t zeroCrossingsAVX2F(const float* samples, size_t count) {
+    if (count < 2) {
+        return 0;
+    }
+
+    const __m256 zero = _mm256_setzero_ps();
+    size_t crossings = 0;
+
+    size_t i = 1;
+    for (; i + 8 <= count; i += 8) {
+        __m256 current = _mm256_cmp_ps(_mm256_loadu_ps(samples + i), zero, _CMP_GE_OQ);
+        __m256 previous = _mm256_cmp_ps(_mm256_loadu_ps(samples + i - 1), zero, _CMP_GE_OQ);
+        int changed = _mm256_movemask_ps(_mm256_xor_ps(current, previous));
+        crossings += static_cast<size_t>(__builtin_popcount(changed));
+    }
+
+    for (; i < count; ++i) {
+        if ((samples[i] >= 0.0f) != (samples[i - 1] >= 0.0f)) {
+            crossings++;
+        }
+    }
+    return crossings;
+}
+
+__attribute__((target("avx2,fma")))
+float dotProductAVX2F(const float* a, const float* b, size_t count) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, _mm256_add_ps(acc0, acc1));
+    float sum = 0.0f;
+    for (float lane : lanes) {
+        sum += lane;
+    }
+
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+__attribute__((target("avx2,fma")))
+void mixMatrixAVX2F(const float* gains, size_t rows, size_t inputs, const float* input, size_t input_stride,
+                    float* output, size_t output_stride, size_t frames) {
+    size_t t = 0;
+    for (; t + 16 <= frames; t += 16) {
+        for (size_t r = 0; r < rows; ++r) {
+            float* row = output + r * output_stride + t;
+            const float* row_gains = gains + r * inputs;
+            __m256 acc0 = _mm256_loadu_ps(row);
+            __m256 acc1 = _mm256_loadu_ps(row + 8);
+            for (size_t k = 0; k < inputs; ++k) {
+                const float* channel = input + k * input_stride + t;
+                __m256 gain = _mm256_set1_ps(row_gains[k]);
+                acc0 = _mm256_fmadd_ps(gain, _mm256_loadu_ps(channel), acc0);
+                acc1 = _mm256_fmadd_ps(gain, _mm256_loadu_ps(channel + 8), acc1);
+            }
+            _mm256_storeu_ps(row, acc0);
+            _mm256_storeu_ps(row + 8, acc1);
+        }
+    }
+    mixMatrixTail(gains, rows, inputs, input, input_stride, output, output_stride, t, frames);
+}
+
+// ---- AVX-512 ----------------------------------------------------------------
+
+ANANTASOUND_AVX512_DIAGNOSTICS_PUSH
+
+__attribute__((target("avx512f")))
+void magnitudeMomentsAVX512(const std::complex<double>* bins, size_t count,
+                            double* magnitude, SpectralMoments& moments) {
+    moments = SpectralMoments();
+    const double* data = reinterpret_cast<const double*>(bins);
+
+    const __m512i even = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+    const __m512i odd = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+
+    __m512d sum = _mm512_setzero_pd();
+    __m512d weighted = _mm512_setzero_pd();
+    __m512d best = _mm512_set1_pd(-1.0);
+    __m512d best_index = _mm512_setzero_pd();
+    __m512d index = _mm512_set_pd(7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0, 0.0);
+    const __m512d step = _mm512_set1_pd(8.0);
+
+    size_t k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m512d a = _mm512_loadu_pd(data + 2 * k);
+        __m512d b = _mm512_loadu_pd(data + 2 * k + 8);
+        __m512d re = _mm512_permutex2var_pd(a, even, b);
+        __m512d im = _mm512_permutex2var_pd(a, odd, b);
+        __m512d mag = _mm512_sqrt_pd(_mm512_fmadd_pd(im, im, _mm512_mul_pd(re, re)));
+
+        _mm512_storeu_pd(magnitude + k, mag);
+        sum = _mm512_add_pd(sum, mag);
+        weighted = _mm512_fmadd_pd(mag, index, weighted);
+
+        __mmask8 greater = _mm512_cmp_pd_mask(mag, best, _CMP_GT_OQ);
+        best = _mm512_mask_blend_pd(greater, best, mag);
+        best_index = _mm512_mask_blend_pd(greater, best_index, index);
+        index = _mm512_add_pd(index, step);
+    }
+
+    alignas(64) double lane_sum[8], lane_weighted[8], lane_best[8], lane_index[8];
+    _mm512_store_pd(lane_sum, sum);
+    _mm512_store_pd(lane_weighted, weighted);
+    _mm512_store_pd(lane_best, best);
+    _mm512_store_pd(lane_index, best_index);
+    reduceLanes(lane_sum, lane_weighted, lane_best, lane_index, 8, moments);
+
+    magnitudeMomentsTail(bins, k, count, magnitude, moments, k > 0);
+}
+
+__attribute__((target("avx512f")))
+double sumOfSquaresAVX512(const double* samples, size_t count) {
+    __m512d acc = _mm512_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d x = _mm512_loadu_pd(samples + i);
+        acc = _mm512_fmadd_pd(x, x, acc);
+    }
+
+    double sum = _mm512_reduce_add_pd(acc);
+    for (; i < count; ++i) {
+        sum += samples[i] * samples[i];
+    }
+    return sum;
+}
+
+__attribute__((target("avx512f,popcnt")))
+size_t zeroCrossingsAVX512(const double* samples, size_t count) {
+    if (count < 2) {
+        return 0;
+    }
+
+    const __m512d zero = _mm512_setzero_pd();
+    size_t crossings = 0;
+
+    size_t i = 1;
+    for (; i + 8 <= count; i += 8) {
+        __mmask8 current = _mm512_cmp_pd_mask(_mm512_loadu_pd(samples + i), zero, _CMP_GE_OQ);
+        __mmask8 previous = _mm512_cmp_pd_mask(_mm512_loadu_pd(samples + i - 1), zero, _CMP_GE_OQ);
+        crossings += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(current ^ previous)));
+    }
+
+    for (; i < count; ++i) {
+        if ((samples[i] >= 0.0) != (samples[i - 1] >= 0.0)) {
+            crossings++;
+        }
+    }
+    return crossings;
+}
+
+__attribute__((target("avx512f")))
+double dotProductAVX512(const double* a, const double* b, size_t count) {
+    __m512d acc = _mm512_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        acc = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), acc);
+    }
+
+    double sum = _mm512_reduce_add_pd(acc);
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+__attribute__((target("avx512f")))
+void mixMatrixAVX512(const double* gains, size_t rows, size_t inputs, const double* input, size_t input_stride,
+                     double* output, size_t output_stride, size_t frames) {
+    size_t t = 0;
+    for (; t + 16 <= frames; t += 16) {
+        for (size_t r = 0; r < rows; ++r) {
+            double* row = output + r * output_stride + t;
+            const double* row_gains = gains + r * inputs;
+            __m512d acc0 = _mm512_loadu_pd(row);
+            __m512d acc1 = _mm512_loadu_pd(row + 8);
+            for (size_t k = 0; k < inputs; ++k) {
+                const double* channel = input + k * input_stride + t;
+                __m512d gain = _mm512_set1_pd(row_gains[k]);
+                acc0 = _mm512_fmadd_pd(gain, _mm512_loadu_pd(channel), acc0);
+                acc1 = _mm512_fmadd_pd(gain, _mm512_loadu_pd(channel + 8), acc1);
+            }
+            _mm512_storeu_pd(row, acc0);
+            _mm512_storeu_pd(row + 8, acc1);
+        }
+    }
+    mixMatrixTail(gains, rows, inputs, input, input_stride, output, output_stride, t, frames);
+}
+
+__attribute__((target("avx512f")))
+void magnitudeMomentsAVX512F(const std::complex<float>* bins, size_t count,
+                             float* magnitude, SpectralMoments& moments) {
+    moments = SpectralMoments();
+    const float* data = reinterpret_cast<const float*>(bins);
+
+    const __m512i even = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0);
+    const __m512i odd = _mm512_set_epi32(31, 29, 27, 25, 23, 21, 19, 17, 15, 13, 11, 9, 7, 5, 3, 1);
+
+    __m512 sum = _mm512_setzero_ps();
+    __m512 weighted = _mm512_setzero_ps();
+    __m512 best = _mm512_set1_ps(-1.0f);
+    __m512 best_index = _mm512_setzero_ps();
+    __m512 index = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f,
+                                 7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+    const __m512 step = _mm512_set1_ps(16.0f);
+
+    size_t k = 0;
+    for (; k + 16 <= count; k += 16) {
+        __m512 a = _mm512_loadu_ps(data + 2 * k);
+        __m512 b = _mm512_loadu_ps(data + 2 * k + 16);
+        __m512 re = _mm512_permutex2var_ps(a, even, b);
+        __m512 im = _mm512_permutex2var_ps(a, odd, b);
+        __m512 mag = _mm512_sqrt_ps(_mm512_fmadd_ps(im, im, _mm512_mul_ps(re, re)));
+
+        _mm512_storeu_ps(magnitude + k, mag);
+        sum = _mm512_add_ps(sum, mag);
+        weighted = _mm512_fmadd_ps(mag, index, weighted);
+
+        __mmask16 greater = _mm512_cmp_ps_mask(mag, best, _CMP_GT_OQ);
+        best = _mm512_mask_blend_ps(greater, best, mag);
+        best_index = _mm512_mask_blend_ps(greater, best_index, index);
+        index = _mm512_add_ps(index, step);
+    }
+
+    alignas(64) float lane_sum[16], lane_weighted[16], lane_best[16], lane_index[16];
+    _mm512_store_ps(lane_sum, sum);
+    _mm512_store_ps(lane_weighted, weighted);
+    _mm512_store_ps(lane_best, best);
+    _mm512_store_ps(lane_index, best_index);
+    reduceLanes(lane_sum, lane_weighted, lane_best, lane_index, 16, moments);
+
+    magnitudeMomentsTail(bins, k, count, magnitude, moments, k > 0);
+}
+
+__attribute__((target("avx512f")))
+double sumOfSquaresAVX512F(const float* samples, size_t count) {
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512d x0 = _mm512_cvtps_pd(_mm256_loadu_ps(samples + i));
+        __m512d x1 = _mm512_cvtps_pd(_mm256_loadu_ps(samples + i + 8));
+        acc0 = _mm512_fmadd_pd(x0, x0, acc0);
+        acc1 = _mm512_fmadd_pd(x1, x1, acc1);
+    }
+
+    double sum = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+    for (; i < count; ++i) {
+        double x = samples[i];
+        sum += x * x;
+    }
+    return sum;
+}
+
+__attribute__((target("avx512f,popcnt")))
+size_t zeroCrossingsAVX512F(const float* samples, size_t count) {
+    if (count < 2) {
+        return 0;
+    }
+
+    const __m512 zero = _mm512_setzero_ps();
+    size_t crossings = 0;
+
+    size_t i = 1;
+    for (; i + 16 <= count; i += 16) {
+        __mmask16 current = _mm512_cmp_ps_mask(_mm512_loadu_ps(samples + i), zero, _CMP_GE_OQ);
+        __mmask16 previous = _mm512_cmp_ps_mask(_mm512_loadu_ps(samples + i - 1), zero, _CMP_GE_OQ);
+        crossings += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(current ^ previous)));
+    }
+
+    for (; i < count; ++i) {
+        if ((samples[i] >= 0.0f) != (samples[i - 1] >= 0.0f)) {
+            crossings++;
+        }
+    }
+    return crossings;
+}
+
+__attribute__((target("avx512f")))
+float dotProductAVX512F(const float* a, const float* b, size_t count) {
+    __m512 acc = _mm512_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        acc = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc);
+    }
+
+    float sum = _mm512_reduce_add_ps(acc);
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+__attribute__((target("avx512f")))
+void mixMatrixAVX512F(const float* gains, size_t rows, size_t inputs, const float* input, size_t input_stride,
+                      float* output, size_t output_stride, size_t frames) {
+    size_t t = 0;
+    for (; t + 32 <= frames; t += 32) {
+        for (size_t r = 0; r < rows; ++r) {
+            float* row = output + r * output_stride + t;
+            const float* row_gains = gains + r * inputs;
+            __m512 acc0 = _mm512_loadu_ps(row);
+            __m512 acc1 = _mm512_loadu_ps(row + 16);
+            for (size_t k = 0; k < inputs; ++k) {
+                const float* channel = input + k * input_stride + t;
+                __m512 gain = _mm512_set1_ps(row_gains[k]);
+                acc0 = _mm512_fmadd_ps(gain, _mm512_loadu_ps(channel), acc0);
+                acc1 = _mm512_fmadd_ps(gain, _mm512_loadu_ps(channel + 16), acc1);
+            }
+            _mm512_storeu_ps(row, acc0);
+            _mm512_storeu_ps(row + 16, acc1);
+        }
+    }
+    mixMatrixTail(gains, rows, inputs, input, input_stride, output, output_stride, t, frames);
+}
+
+ANANTASOUND_AVX512_DIAGNOSTICS_POP
+
+#endif // ANANTASOUND_X86_DISPATCH
+
+// ---- NEON -------------------------------------------------------------------
+
+#ifdef ANANTASOUND_NEON
+
+void magnitudeMomentsNEON(const std::complex<double>* bins, size_t count,
+                          double* magnitude, SpectralMoments& moments) {
+    moments = SpectralMoments();
+    const double* data = reinterpret_cast<const double*>(bins);
+
+    float64x2_t sum = vdupq_n_f64(0.0);
+    float64x2_t weighted = vdupq_n_f64(0.0);
+    float64x2_t best = vdupq_n_f64(-1.0);
+    float64x2_t best_index = vdupq_n_f64(0.0);
+    const double initial_index[2] = {0.0, 1.0};
+    float64x2_t index = vld1q_f64(initial_index);
+    const float64x2_t step = vdupq_n_f64(2.0);
+
+    size_t k = 0;
+    for (; k + 2 <= count; k += 2) {
+        float64x2x2_t v = vld2q_f64(data + 2 * k);    // de-interleaves re / im
+        float64x2_t power = vfmaq_f64(vmulq_f64(v.val[0], v.val[0]), v.val[1], v.val[1]);
+        float64x2_t mag = vsqrtq_f64(power);
+
+        vst1q_f64(magnitude + k, mag);
+        sum = vaddq_f64(sum, mag);
+        weighted = vfmaq_f64(weighted, mag, index);
+
+        uint64x2_t greater = vcgtq_f64(mag, best);
+        best = vbslq_f64(greater, mag, best);
+        best_index = vbslq_f64(greater, index, best_index);
+        index = vaddq_f64(index, step);
+    }
+
+    double lane_sum[2], lane_weighted[2], lane_best[2], lane_index[2];
+    vst1q_f64(lane_sum, sum);
+    vst1q_f64(lane_weighted, weighted);
+    vst1q_f64(lane_best, best);
+    vst1q_f64(lane_index, best_index);
+    reduceLanes(lane_sum, lane_weighted, lane_best, lane_index, 2, moments);
+
+    magnitudeMomentsTail(bins, k, count, magnitude, moments, k > 0);
+}
+
+double sumOfSquaresNEON(const double* samples, size_t count) {
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float64x2_t x0 = vld1q_f64(samples + i);
+        float64x2_t x1 = vld1q_f64(samples + i + 2);
+        acc0 = vfmaq_f64(acc0, x0, x0);
+        acc1 = vfmaq_f64(acc1, x1, x1);
+    }
+
+    double sum = vaddvq_f64(vaddq_f64(acc0, acc1));
+    for (; i < count; ++i) {
+        sum += samples[i] * samples[i];
+    }
+    return sum;
+}
+
+size_t zeroCrossingsNEON(const double* samples, size_t count) {
+    if (count < 2) {
+        return 0;
+    }
+
+    uint64x2_t total = vdupq_n_u64(0);
+
+    size_t i = 1;
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t current = vcgezq_f64(vld1q_f64(samples + i));
+        uint64x2_t previous = vcgezq_f64(vld1q_f64(samples + i - 1));
+        total = vaddq_u64(total, vshrq_n_u64(veorq_u64(current, previous), 63));
+    }
+
+    size_t crossings = static_cast<size_t>(vaddvq_u64(total));
+    for (; i < count; ++i) {
+        if ((samples[i] >= 0.0) != (samples[i - 1] >= 0.0)) {
+            crossings++;
+        }
+    }
+    return crossings;
+}
+
+double dotProductNEON(const double* a, const double* b, size_t count) {
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        acc0 = vfmaq_f64(acc0, vld1q_f64(a + i), vld1q_f64(b + i));
+        acc1 = vfmaq_f64(acc1, vld1q_f64(a + i + 2), vld1q_f64(b + i + 2));
+    }
+
+    double sum = vaddvq_f64(vaddq_f64(acc0, acc1));
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void mixMatrixNEON(const double* gains, size_t rows, size_t inputs, const double* input, size_t input_stride,
+                   double* output, size_t output_stride, size_t frames) {
+    size_t t = 0;
+    for (; t + 4 <= frames; t += 4) {
+        for (size_t r = 0; r < rows; ++r) {
+            double* row = output + r * output_stride + t;
+            const double* row_gains = gains + r * inputs;
+            float64x2_t acc0 = vld1q_f64(row);
+            float64x2_t acc1 = vld1q_f64(row + 2);
+            for (size_t k = 0; k < inputs; ++k) {
+                const double* channel = input + k * input_stride + t;
+                acc0 = vfmaq_n_f64(acc0, vld1q_f64(channel), row_gains[k]);
+                acc1 = vfmaq_n_f64(acc1, vld1q_f64(channel + 2), row_gains[k]);
+            }
+            vst1q_f64(row, acc0);
+            vst1q_f64(row + 2, acc1);
+        }
+    }
+    mixMatrixTail(gains, rows, inputs, input, input_stride, output, output_stride, t, frames);
+}
+
+void magnitudeMomentsNEONF(const std::complex<float>* bins, size_t count,
+                           float* magnitude, SpectralMoments& moments) {
+    moments = SpectralMoments();
+    const float* data = reinterpret_cast<const float*>(bins);
+
+    float32x4_t sum = vdupq_n_f32(0.0f);
+    float32x4_t weighted = vdupq_n_f32(0.0f);
+    float32x4_t best = vdupq_n_f32(-1.0f);
+    float32x4_t best_index = vdupq_n_f32(0.0f);
+    const float initial_index[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    float32x4_t index = vld1q_f32(initial_index);
+    const float32x4_t step = vdupq_n_f32(4.0f);
+
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        float32x4x2_t v = vld2q_f32(data + 2 * k);    // de-interleaves re / im
+        float32x4_t power = vfmaq_f32(vmulq_f32(v.val[0], v.val[0]), v.val[1], v.val[1]);
+        float32x4_t mag = vsqrtq_f32(power);
+
+        vst1q_f32(magnitude + k, mag);
+        sum = vaddq_f32(sum, mag);
+        weighted = vfmaq_f32(weighted, mag, index);
+
+        uint32x4_t greater = vcgtq_f32(mag, best);
+        best = vbslq_f32(greater, mag, best);
+        best_index = vbslq_f32(greater, index, best_index);
+        index = vaddq_f32(index, step);
+    }
+
+    float lane_sum[4], lane_weighted[4], lane_best[4], lane_index[4];
+    vst1q_f32(lane_sum, sum);
+    vst1q_f32(lane_weighted, weighted);
+    vst1q_f32(lane_best, best);
+    vst1q_f32(lane_index, best_index);
+    reduceLanes(lane_sum, lane_weighted, lane_best, lane_index, 4, moments);
+
+    magnitudeMomentsTail(bins, k, count, magnitude, moments, k > 0);
+}
+
+double sumOfSquaresNEONF(const float* samples, size_t count) {
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t x = vld1q_f32(samples + i);
+        float64x2_t x0 = vcvt_f64_f32(vget_low_f32(x));
+        float64x2_t x1 = vcvt_high_f64_f32(x);
+        acc0 = vfmaq_f64(acc0, x0, x0);
+        acc1 = vfmaq_f64(acc1, x1, x1);
+    }
+
+    double sum = vaddvq_f64(vaddq_f64(acc0, acc1));
+    for (; i < count; ++i) {
+        double x = samples[i];
+        sum += x * x;
+    }
+    return sum;
+}
+
+size_t zeroCrossingsNEONF(const float* samples, size_t count) {
+    if (count < 2) {
+        return 0;
+    }
+
+    uint64x2_t total = vdupq_n_u64(0);
+
+    size_t i = 1;
+    for (; i + 4 <= count; i += 4) {
+        uint32x4_t current = vcgezq_f32(vld1q_f32(samples + i));
+        uint32x4_t previous = vcgezq_f32(vld1q_f32(samples + i - 1));
+        total = vpadalq_u32(total, vshrq_n_u32(veorq_u32(current, previous), 31));
+    }
+
+    size_t crossings = static_cast<size_t>(vaddvq_u64(total));
+    for (; i < count; ++i) {
+        if ((samples[i] >= 0.0f) != (samples[i - 1] >= 0.0f)) {
+            crossings++;
+        }
+    }
+    return crossings;
+}
+
+float dotProductNEONF(const float* a, const float* b, size_t count) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+
+    float sum = vaddvq_f32(vaddq_f32(acc0, acc1));
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void mixMatrixNEONF(const float* gains, size_t rows, size_t inputs, const float* input, size_t input_stride,
+                    float* output, size_t output_stride, size_t frames) {
+    size_t t = 0;
+    for (; t + 8 <= frames; t += 8) {
+        for (size_t r = 0; r < rows; ++r) {
+            float* row = output + r * output_stride + t;
+            const float* row_gains = gains + r * inputs;
+            float32x4_t acc0 = vld1q_f32(row);
+            float32x4_t acc1 = vld1q_f32(row + 4);
+            for (size_t k = 0; k < inputs; ++k) {
+                const float* channel = input + k * input_stride + t;
+                acc0 = vfmaq_n_f32(acc0, vld1q_f32(channel), row_gains[k]);
+                acc1 = vfmaq_n_f32(acc1, vld1q_f32(channel + 4), row_gains[k]);
+            }
+            vst1q_f32(row, acc0);
+            vst1q_f32(row + 4, acc1);
+        }
+    }
+    mixMatrixTail(gains, rows, inputs, input, input_stride, output, output_stride, t, frames);
+}
+
+#endif // ANANTASOUND_NEON
+
+const SpectralKernelTable kScalarKernels = {
+    SIMDLevel::SCALAR, "scalar",
+    magnitudeMomentsScalar<double>, sumOfSquaresScalar<double>, zeroCrossingsScalar<double>,
+    dotProductScalar<double>, mixMatrixScalar<double>
+};
+
+const SpectralKernelTableF kScalarKernelsF = {
+    SIMDLevel::SCALAR, "scalar",
+    magnitudeMomentsScalar<float>, sumOfSquaresScalar<float>, zeroCrossingsScalar<float>,
+    dotProductScalar<float>, mixMatrixScalar<float>
+};
+
+#ifdef ANANTASOUND_X86_DISPATCH
+const SpectralKernelTable kAVX2Kernels = {
+    SIMDLevel::AVX2, "avx2",
+    magnitudeMomentsAVX2, sumOfSquaresAVX2, zeroCrossingsAVX2, dotProductAVX2,
+    mixMatrixAVX2
+};
+
+const SpectralKernelTableF kAVX2KernelsF = {
+    SIMDLevel::AVX2, "avx2",
+    magnitudeMomentsAVX2F, sumOfSquaresAVX2F, zeroCrossingsAVX2F, dotProductAVX2F,
+    mixMatrixAVX2F
+};
+
+const SpectralKernelTable kAVX512Kernels = {
+    SIMDLevel::AVX512, "avx512",
+    magnitudeMomentsAVX512, sumOfSquaresAVX512, zeroCrossingsAVX512, dotProductAVX512,
+    mixMatrixAVX512
+};
+
+const SpectralKernelTableF kAVX512KernelsF = {
+    SIMDLevel::AVX512, "avx512",
+    magnitudeMomentsAVX512F, sumOfSquaresAVX512F, zeroCrossingsAVX512F, dotProductAVX512F,
+    mixMatrixAVX512F
+};
+#endif
+
+#ifdef ANANTASOUND_NEON
+const SpectralKernelTable kNEONKernels = {
+    SIMDLevel::NEON, "neon",
+    magnitudeMomentsNEON, sumOfSquaresNEON, zeroCrossingsNEON, dotProductNEON,
+    mixMatrixNEON
+};
+
+const SpectralKernelTableF kNEONKernelsF = {
+    SIMDLevel::NEON, "neon",
+    magnitudeMomentsNEONF, sumOfSquaresNEONF, zeroCrossingsNEONF, dotProductNEONF,
+    mixMatrixNEONF
+};
+#endif
+
+// Tables compiled into this build, indexed by SIMDLevel
+template<typename Real>
+using KernelTableSet = const BasicSpectralKernelTable<Real>* [4];
+
+const KernelTableSet<double> kDoubleTables = {
+    &kScalarKernels,
+#ifdef ANANTASOUND_X86_DISPATCH
+    &kAVX2Kernels, &kAVX512Kernels,
+#else
+    nullptr, nullptr,
+#endif
+#ifdef ANANTASOUND_NEON
+    &kNEONKernels
+#else
+    nullptr
+#endif
+};
+
+const KernelTableSet<float> kFloatTables = {
+    &kScalarKernelsF,
+#ifdef ANANTASOUND_X86_DISPATCH
+    &kAVX2KernelsF, &kAVX512KernelsF,
+#else
+    nullptr, nullptr,
+#endif
+#ifdef ANANTASOUND_NEON
+    &kNEONKernelsF
+#else
+    nullptr
+#endif
+};
+
+template<typename Real>
+const BasicSpectralKernelTable<Real>& lookupKernels(const KernelTableSet<Real>& tables, SIMDLevel level) {
+    const BasicSpectralKernelTable<Real>* table = nullptr;
+    if (isSIMDLevelSupported(level)) {
+        table = tables[static_cast<size_t>(level)];
+    }
+    return table ? *table : *tables[static_cast<size_t>(SIMDLevel::SCALAR)];
+}
+
+template<typename Real>
+const BasicSpectralKernelTable<Real>& selectBestKernels(const KernelTableSet<Real>& tables) {
+    for (SIMDLevel level : {SIMDLevel::AVX512, SIMDLevel::AVX2, SIMDLevel::NEON}) {
+        if (isSIMDLevelSupported(level)) {
+            return lookupKernels(tables, level);
+        }
+    }
+    return lookupKernels(tables, SIMDLevel::SCALAR);
+}
+
+template<typename Real>
+size_t rolloffBin(const Real* magnitude, size_t count, double total, double threshold) {
+    if (count == 0) {
+        return 0;
+    }
+
+    double target = total * threshold;
+    double cumulative = 0.0;
+    for (size_t k = 0; k < count; ++k) {
+        cumulative += magnitude[k];
+        if (cumulative >= target) {
+            return k;
+        }
+    }
+    return count - 1;
+}
+
+template<typename Real>
+void phases(const std::complex<Real>* bins, size_t count, Real* phase) {
+    for (size_t k = 0; k < count; ++k) {
+        phase[k] = std::atan2(bins[k].imag(), bins[k].real());
+    }
+}
+
+} // namespace
+
+bool isSIMDLevelSupported(SIMDLevel level) {
+    switch (level) {
+        case SIMDLevel::SCALAR:
+            return true;
+#ifdef ANANTASOUND_X86_DISPATCH
+        case SIMDLevel::AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") &&
+                   __builtin_cpu_supports("popcnt");
+        case SIMDLevel::AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("popcnt");
+#endif
+#ifdef ANANTASOUND_NEON
+        case SIMDLevel::NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+const SpectralKernelTable& getSpectralKernels(SIMDLevel level) {
+    return lookupKernels(kDoubleTables, level);
+}
+
+const SpectralKernelTableF& getSpectralKernelsF(SIMDLevel level) {
+    return lookupKernels(kFloatTables, level);
+}
+
+const SpectralKernelTable& getSpectralKernels() {
+    static const SpectralKernelTable& best = selectBestKernels(kDoubleTables);
+    return best;
+}
+
+const SpectralKernelTableF& getSpectralKernelsF() {
+    static const SpectralKernelTableF& best = selectBestKernels(kFloatTables);
+    return best;
+}
+
+size_t findRolloffBin(const double* magnitude, size_t count, double total, double threshold) {
+    return rolloffBin(magnitude, count, total, threshold);
+}
+
+size_t findRolloffBin(const float* magnitude, size_t count, double total, double threshold) {
+    return rolloffBin(magnitude, count, total, threshold);
+}
+
+void computePhases(const std::complex<double>* bins, size_t count, double* phase) {
+    phases(bins, count, phase);
+}
+
+void computePhases(const std::complex<float>* bins, size_t count, float* phase) {
+    phases(bins, count, phase);
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Instruction set used by the spectral kernels
+enum class SIMDLevel {
+    SCALAR,     // Portable reference implementation
+    AVX2,       // x86-64 AVX2 + FMA
+    AVX512,     // x86-64 AVX-512F
+    NEON        // AArch64 Advanced SIMD
+};
+
+// Reductions gathered by the fused magnitude pass
+struct SpectralMoments {
+    double magnitude_sum;       // Σ |X[k]|
+    double weighted_sum;        // Σ k · |X[k]| (bin-index weighted)
+    double peak_magnitude;      // max |X[k]|
+    size_t peak_bin;            // First bin holding peak_magnitude
+
+    SpectralMoments() : magnitude_sum(0.0), weighted_sum(0.0),
+                        peak_magnitude(0.0), peak_bin(0) {}
+};
+
+// Dispatch table of spectral kernels for one instruction set and sample type.
+// Float tables process twice as many lanes per vector; their reductions
+// (sum of squares, moments) are still returned in double.
+template<typename Real>
+struct BasicSpectralKernelTable {
+    SIMDLevel level;
+    const char* name;
+
+    // One pass over the bins: writes |X[k]| and fills the moments
+    void (*magnitude_moments)(const std::complex<Real>* bins, size_t count,
+                              Real* magnitude, SpectralMoments& moments);
+
+    // Σ x[i]^2
+    double (*sum_of_squares)(const Real* samples, size_t count);
+
+    // Number of i in [1, count) where sign(x[i]) != sign(x[i-1])
+    size_t (*zero_crossings)(const Real* samples, size_t count);
+
+    // Σ a[i] · b[i], accumulated in Real (FIR and resampler inner products)
+    Real (*dot_product)(const Real* a, const Real* b, size_t count);
+
+    // output[r][t] += Σ_k gains[r · inputs + k] · input[k][t] for t < frames,
+    // where channel c of input / output starts at c · input_stride /
+    // c · output_stride (planar blocks; panning and ambisonic matrices)
+    void (*mix_matrix)(const Real* gains, size_t rows, size_t inputs, const Real* input, size_t input_stride,
+                       Real* output, size_t output_stride, size_t frames);
+};
+
+using SpectralKernelTable = BasicSpectralKernelTable<double>;
+using SpectralKernelTableF = BasicSpectralKernelTable<float>;
+
+// Best kernel table for the running CPU (detected once, thread-safe)
+const SpectralKernelTable& getSpectralKernels();
+const SpectralKernelTableF& getSpectralKernelsF();
+
+// Kernel table for a specific level; falls back to SCALAR when unsupported
+const SpectralKernelTable& getSpectralKernels(SIMDLevel level);
+const SpectralKernelTableF& getSpectralKernelsF(SIMDLevel level);
+
+// Whether the running CPU supports the given level
+bool isSIMDLevelSupported(SIMDLevel level);
+
+// First bin at which the running magnitude sum reaches threshold * total.
+// Early-exits, so only the low part of the spectrum is revisited.
+size_t findRolloffBin(const double* magnitude, size_t count, double total, double threshold);
+size_t findRolloffBin(const float* magnitude, size_t count, double total, double threshold);
+
+// arg(X[k]) for every bin (atan2 has no vector form; kept scalar)
+void computePhases(const std::complex<double>* bins, size_t count, double* phase);
+void computePhases(const std::complex<float>* bins, size_t count, float* phase);
+
+} // namespace AnantaSound
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace AnantaSound {
+
+// Wait-free single-producer single-consumer ring buffer.
+// Capacity is rounded up to a power of two; storage is allocated once, in
+// the constructor. write() and read() each touch only their own index plus
+// an acquire load of the other side's, never lock and never allocate, so
+// the producer may be a real-time audio callback. Each side also caches the
+// last index it saw from the other one and reloads it only when the cached
+// value says the buffer is full (or empty). Exactly one thread may write and
+// one thread may read at a time.
+template<typename T>
+class SPSCRingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "SPSCRingBuffer holds trivially copyable samples");
+
+private:
+    // Keep the two sides' indices on separate cache lines
+    static constexpr size_t kCacheLine = 64;
+
+    std::vector<T> buffer_;
+    size_t mask_;
+
+    alignas(kCacheLine) std::atomic<size_t> head_;      // Items ever written (producer)
+    size_t cached_tail_;                                // Producer's view of tail_
+    alignas(kCacheLine) std::atomic<size_t> tail_;      // Items ever read (consumer)
+    size_t cached_head_;                                // Consumer's view of head_
+
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+public:
+    explicit SPSCRingBuffer(size_t capacity)
+        : buffer_(roundUpToPowerOfTwo(std::max<size_t>(capacity, 1)))
+        , mask_(buffer_.size() - 1)
+        , head_(0)
+        , cached_tail_(0)
+        , tail_(0)
+        , cached_head_(0) {
+    }
+
+    SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+    SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+    size_t capacity() const { return buffer_.size(); }
+
+    // Producer: append up to count items; returns how many fit
+    size_t write(const T* data, size_t count) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (buffer_.size() - (head - cached_tail_) < count) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+        count = std::min(count, buffer_.size() - (head - cached_tail_));
+
+        const size_t start = head & mask_;
+        const size_t first = std::min(count, buffer_.size() - start);
+        std::copy(data, data + first, buffer_.data() + start);
+        std::copy(data + first, data + count, buffer_.data());
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Consumer: remove up to count items into output; returns how many were read
+    size_t read(T* output, size_t count) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (cached_head_ - tail < count) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+        }
+        count = std::min(count, cached_head_ - tail);
+
+        const size_t start = tail & mask_;
+        const size_t first = std::min(count, buffer_.size() - start);
+        std::copy(buffer_.data() + start, buffer_.data() + start + first, output);
+        std::copy(buffer_.data(), buffer_.data() + (count - first), output + first);
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Approximate from the other side's thread, exact from the owning side
+    size_t readAvailable() const {
+        // tail first: head only grows, so it cannot fall behind the tail read before it
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        return head_.load(std::memory_order_acquire) - tail;
+    }
+    size_t writeAvailable() const { return buffer_.size() - readAvailable(); }
+
+    // Drop all items; neither side may be active
+    void reset() {
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        cached_tail_ = 0;
+        cached_head_ = 0;
+    }
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,87 @@
+#include "streaming_analyzer.hpp"
+#include <algorithm>
+
+namespace AnantaSound {
+
+StreamingAnalyzer::StreamingAnalyzer(size_t fft_size, size_t sample_rate, size_t hop_size)
+    : analyzer_(fft_size, sample_rate)
+    , frame_size_(fft_size)
+    , hop_size_(hop_size == 0 ? std::max<size_t>(1, fft_size / 4) : std::min(fft_size, hop_size))
+    , ring_(2 * fft_size, 0.0)
+    , write_position_(0)
+    , samples_until_frame_(fft_size)
+    , frames_emitted_(0)
+    , samples_pushed_(0)
+    , tempo_tracker_(fft_size, sample_rate, hop_size_) {
+
+    analyzer_.setHopSize(hop_size_);
+}
+
+bool StreamingAnalyzer::initialize() {
+    return frame_size_ > 0 && analyzer_.initialize();
+}
+
+void StreamingAnalyzer::setFrameCallback(FrameCallback callback) {
+    frame_callback_ = std::move(callback);
+}
+
+size_t StreamingAnalyzer::pushSamples(const double* samples, size_t sample_count) {
+    if (samples == nullptr || frame_size_ == 0) {
+        return 0;
+    }
+
+    size_t frames = 0;
+    size_t consumed = 0;
+
+    while (consumed < sample_count) {
+        // Write up to the next frame boundary
+        size_t chunk = std::min(sample_count - consumed, samples_until_frame_);
+
+        for (size_t i = 0; i < chunk; ++i) {
+            double sample = samples[consumed + i];
+            ring_[write_position_] = sample;
+            ring_[write_position_ + frame_size_] = sample;
+            if (++write_position_ == frame_size_) {
+                write_position_ = 0;
+            }
+        }
+
+        consumed += chunk;
+        samples_until_frame_ -= chunk;
+
+        if (samples_until_frame_ == 0) {
+            emitFrame();
+            samples_until_frame_ = hop_size_;
+            frames++;
+        }
+    }
+
+    samples_pushed_ += sample_count;
+    return frames;
+}
+
+size_t StreamingAnalyzer::pushSamples(const std::vector<double>& samples) {
+    return pushSamples(samples.data(), samples.size());
+}
+
+void StreamingAnalyzer::reset() {
+    std::fill(ring_.begin(), ring_.end(), 0.0);
+    write_position_ = 0;
+    samples_until_frame_ = frame_size_;
+    frames_emitted_ = 0;
+    samples_pushed_ = 0;
+    tempo_tracker_.reset();
+}
+
+void StreamingAnalyzer::emitFrame() {
+    analyzer_.analyzeAudio(getCurrentWindow(), frame_size_, frame_result_);
+    frame_result_.tempo = tempo_tracker_.pushSpectrum(frame_result_.magnitude_spectrum.data(),
+                                                      frame_result_.magnitude_spectrum.size());
+    frames_emitted_++;
+
+    if (frame_callback_) {
+        frame_callback_(frame_result_);
+    }
+}
+
+} // namespace AnantaSound
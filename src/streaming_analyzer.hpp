@@ -0,0 +1,73 @@
+#pragma once
+
+#include "audio_analyzer.hpp"
+#include "tempo_tracker.hpp"
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace AnantaSound {
+
+// Push-based STFT front end for live input.
+// Samples arrive in chunks of any size; a frame result is produced every
+// hop_size samples once the first full window is buffered. The ring buffer
+// is written twice (at i and i + frame_size), so the newest window is always
+// contiguous and is analyzed in place without a per-hop copy.
+// Each frame's tempo comes from a TempoTracker fed with the frame spectra.
+// One instance serves one input stream and is not meant to be shared
+// between producer threads.
+class StreamingAnalyzer {
+public:
+    using FrameCallback = std::function<void(const AudioAnalysisResult&)>;
+
+private:
+    AudioAnalyzer analyzer_;
+    size_t frame_size_;
+    size_t hop_size_;
+
+    std::vector<double> ring_;           // 2 * frame_size_, mirrored halves
+    size_t write_position_;              // Next write index in [0, frame_size_)
+    size_t samples_until_frame_;         // Samples left before the next frame is due
+    uint64_t frames_emitted_;
+    uint64_t samples_pushed_;
+
+    AudioAnalysisResult frame_result_;   // Reused for every frame
+    TempoTracker tempo_tracker_;
+    FrameCallback frame_callback_;
+
+public:
+    StreamingAnalyzer(size_t fft_size = 1024, size_t sample_rate = 44100, size_t hop_size = 0);
+
+    // Initialize the underlying analyzer
+    bool initialize();
+
+    // Called with each frame as soon as its last sample arrives
+    void setFrameCallback(FrameCallback callback);
+
+    // Push a chunk of samples; returns the number of frames emitted
+    size_t pushSamples(const double* samples, size_t sample_count);
+    size_t pushSamples(const std::vector<double>& samples);
+
+    // Drop buffered samples and start a new stream
+    void reset();
+
+    // Most recent frame (valid once getFramesEmitted() > 0)
+    const AudioAnalysisResult& getLastResult() const { return frame_result_; }
+
+    // Current window as a contiguous view of the last frame_size samples
+    const double* getCurrentWindow() const { return ring_.data() + write_position_; }
+
+    // Get current parameters
+    size_t getFrameSize() const { return frame_size_; }
+    size_t getHopSize() const { return hop_size_; }
+    size_t getLatencySamples() const { return frame_size_; }
+    uint64_t getFramesEmitted() const { return frames_emitted_; }
+    uint64_t getSamplesPushed() const { return samples_pushed_; }
+    AudioAnalyzer& getAnalyzer() { return analyzer_; }
+    const TempoTracker& getTempoTracker() const { return tempo_tracker_; }
+
+private:
+    void emitFrame();
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,227 @@
+#include "tempo_tracker.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+// Magnitudes are compressed as log(1 + C·|X|) before differencing, so quiet
+// and loud onsets both register
+constexpr double kCompression = 100.0;
+constexpr size_t kMinHistory = 64;
+constexpr size_t kCombHarmonics = 3;
+constexpr double kPriorBpm = 120.0;
+constexpr double kPriorOctaves = 1.0;
+constexpr double kHalfPeriodRatio = 0.9;
+
+size_t historyLength(size_t sample_rate, size_t hop_size, const TempoTrackerOptions& options) {
+    double frames = options.window_seconds * static_cast<double>(sample_rate) / static_cast<double>(hop_size);
+    size_t length = kMinHistory;
+    while (static_cast<double>(length) < frames) {
+        length *= 2;
+    }
+    return length;
+}
+
+} // namespace
+
+TempoTracker::TempoTracker(size_t fft_size, size_t sample_rate, size_t hop_size,
+                           const TempoTrackerOptions& options, std::shared_ptr<const FFTPlan> plan)
+    : options_(options)
+    , sample_rate_(std::max<size_t>(1, sample_rate))
+    , hop_size_(std::max<size_t>(1, hop_size))
+    , previous_(fft_size / 2 + 1, 0.0)
+    , history_length_(historyLength(sample_rate_, hop_size_, options))
+    , position_(0)
+    , frames_(0)
+    , plan_(std::move(plan))
+    , min_lag_(1)
+    , max_lag_(1)
+    , update_interval_(1)
+    , frames_until_update_(1)
+    , tempo_(0.0)
+    , confidence_(0.0)
+    , onset_strength_(0.0) {
+
+    if (!plan_ || plan_->getSize() != 2 * history_length_) {
+        plan_ = sharedFFTPlan<double>(2 * history_length_);
+    }
+    envelope_.assign(history_length_, 0.0);
+    padded_.assign(2 * history_length_, 0.0);
+    spectrum_.assign(history_length_ + 1, std::complex<double>());
+    autocorrelation_.assign(history_length_, 0.0);
+    configureLags();
+}
+
+size_t TempoTracker::getTransformSize(size_t sample_rate, size_t hop_size, const TempoTrackerOptions& options) {
+    return 2 * historyLength(std::max<size_t>(1, sample_rate), std::max<size_t>(1, hop_size), options);
+}
+
+void TempoTracker::configureLags() {
+    double frame_rate = static_cast<double>(sample_rate_) / static_cast<double>(hop_size_);
+
+    // Periods beyond half the history cannot be confirmed by a second beat
+    min_lag_ = std::max<size_t>(1, static_cast<size_t>(std::floor(60.0 * frame_rate / options_.max_bpm)));
+    max_lag_ = static_cast<size_t>(std::ceil(60.0 * frame_rate / options_.min_bpm));
+    max_lag_ = std::max(min_lag_ + 1, std::min(max_lag_, history_length_ / 2 - 1));
+
+    update_interval_ = std::max<size_t>(1, static_cast<size_t>(frame_rate / options_.estimates_per_second));
+    frames_until_update_ = update_interval_;
+}
+
+void TempoTracker::setHopSize(size_t hop_size) {
+    hop_size = std::max<size_t>(1, hop_size);
+    if (hop_size == hop_size_) {
+        return;
+    }
+    hop_size_ = hop_size;
+    reset();
+}
+
+void TempoTracker::reset() {
+    std::fill(previous_.begin(), previous_.end(), 0.0);
+    std::fill(envelope_.begin(), envelope_.end(), 0.0);
+    position_ = 0;
+    frames_ = 0;
+    tempo_ = 0.0;
+    confidence_ = 0.0;
+    onset_strength_ = 0.0;
+    configureLags();
+}
+
+template<typename Real>
+double TempoTracker::pushSpectrum(const Real* magnitude, size_t bin_count) {
+    size_t bins = magnitude != nullptr ? std::min(bin_count, previous_.size()) : 0;
+
+    // Half-wave rectified log-magnitude difference; DC is left out
+    double flux = 0.0;
+    for (size_t k = 1; k < bins; ++k) {
+        double compressed = std::log1p(kCompression * static_cast<double>(magnitude[k]));
+        double rise = compressed - previous_[k];
+        flux += rise > 0.0 ? rise : 0.0;
+        previous_[k] = compressed;
+    }
+    onset_strength_ = frames_ > 0 && bins > 1 ? flux / static_cast<double>(bins - 1) : 0.0;
+
+    envelope_[position_] = onset_strength_;
+    position_ = (position_ + 1) & (history_length_ - 1);
+    frames_++;
+
+    if (--frames_until_update_ == 0) {
+        frames_until_update_ = update_interval_;
+        estimate();
+    }
+    return tempo_;
+}
+
+void TempoTracker::estimate() {
+    size_t valid = static_cast<size_t>(std::min<uint64_t>(frames_, history_length_));
+    if (valid < 2 * max_lag_) {
+        tempo_ = 0.0;
+        confidence_ = 0.0;
+        return;
+    }
+
+    // Mean-removed envelope in time order, zero-padded to twice its length
+    // so the circular autocorrelation does not wrap
+    size_t start = (position_ + history_length_ - valid) & (history_length_ - 1);
+    double mean = 0.0;
+    for (size_t i = 0; i < valid; ++i) {
+        mean += envelope_[(start + i) & (history_length_ - 1)];
+    }
+    mean /= static_cast<double>(valid);
+    // [1 2 1] / 4 smoothing widens the autocorrelation peaks, so periods
+    // that fall between two lags are not split across them
+    for (size_t i = 0; i < valid; ++i) {
+        double before = envelope_[(start + (i > 0 ? i - 1 : i)) & (history_length_ - 1)];
+        double after = envelope_[(start + (i + 1 < valid ? i + 1 : i)) & (history_length_ - 1)];
+        double current = envelope_[(start + i) & (history_length_ - 1)];
+        padded_[i] = 0.25 * (before + 2.0 * current + after) - mean;
+    }
+    std::fill(padded_.begin() + valid, padded_.end(), 0.0);
+
+    // Wiener–Khinchin: the power spectrum is real and even, so a second
+    // forward real transform of it yields the autocorrelation
+    size_t transform = 2 * history_length_;
+    plan_->forwardReal(padded_.data(), spectrum_.data());
+    for (size_t k = 0; k <= history_length_; ++k) {
+        double power = std::norm(spectrum_[k]);
+        padded_[k] = power;
+        if (k > 0 && k < history_length_) {
+            padded_[transform - k] = power;
+        }
+    }
+    plan_->forwardReal(padded_.data(), spectrum_.data());
+
+    // Unbiased: lag l overlaps valid - l samples
+    for (size_t lag = 0; lag < valid; ++lag) {
+        autocorrelation_[lag] = spectrum_[lag].real() * static_cast<double>(valid) / static_cast<double>(valid - lag);
+    }
+    const double energy = autocorrelation_[0];
+    if (!(energy > 0.0)) {
+        tempo_ = 0.0;
+        confidence_ = 0.0;
+        return;
+    }
+
+    const double frame_rate = static_cast<double>(sample_rate_) / static_cast<double>(hop_size_);
+    size_t best_lag = 0;
+    double best_score = 0.0;
+    for (size_t lag = min_lag_; lag <= max_lag_; ++lag) {
+        // Multiples of an integer lag drift from those of the true period by
+        // up to h / 2 frames; each tooth takes the peak within h - 1 frames
+        double comb = 0.0;
+        for (size_t h = 1; h <= kCombHarmonics && h * lag + h - 1 < valid; ++h) {
+            double tooth = autocorrelation_[h * lag];
+            for (size_t offset = 1; offset < h; ++offset) {
+                tooth = std::max({tooth, autocorrelation_[h * lag - offset], autocorrelation_[h * lag + offset]});
+            }
+            comb += tooth / static_cast<double>(h);
+        }
+        double octaves = std::log2(60.0 * frame_rate / static_cast<double>(lag) / kPriorBpm) / kPriorOctaves;
+        double score = comb * std::exp(-0.5 * octaves * octaves);
+        if (score > best_score) {
+            best_score = score;
+            best_lag = lag;
+        }
+    }
+    if (best_lag == 0) {
+        tempo_ = 0.0;
+        confidence_ = 0.0;
+        return;
+    }
+
+    // The prior can pull a fast pulse down an octave; take the half period
+    // when the envelope repeats there almost as strongly
+    size_t half = best_lag / 2;
+    if (half >= min_lag_ + 1) {
+        size_t peak = half;
+        for (size_t candidate = half - 1; candidate <= half + 1; ++candidate) {
+            if (autocorrelation_[candidate] > autocorrelation_[peak]) {
+                peak = candidate;
+            }
+        }
+        if (autocorrelation_[peak] >= kHalfPeriodRatio * autocorrelation_[best_lag]) {
+            best_lag = peak;
+        }
+    }
+
+    // Sub-frame period from the autocorrelation peak
+    double lag = static_cast<double>(best_lag);
+    double left = autocorrelation_[best_lag - 1];
+    double centre = autocorrelation_[best_lag];
+    double right = autocorrelation_[best_lag + 1];
+    double curvature = left - 2.0 * centre + right;
+    if (curvature < 0.0) {
+        lag += std::clamp(0.5 * (left - right) / curvature, -0.5, 0.5);
+    }
+
+    tempo_ = 60.0 * frame_rate / lag;
+    confidence_ = std::clamp(centre / energy, 0.0, 1.0);
+}
+
+template double TempoTracker::pushSpectrum<double>(const double*, size_t);
+template double TempoTracker::pushSpectrum<float>(const float*, size_t);
+
+} // namespace AnantaSound
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "fft_engine.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace AnantaSound {
+
+struct TempoTrackerOptions {
+    double min_bpm = 60.0;
+    double max_bpm = 200.0;
+    double window_seconds = 8.0;            // Onset envelope history
+    double estimates_per_second = 4.0;      // Autocorrelation updates
+};
+
+// Streaming tempo estimate from consecutive STFT magnitude spectra.
+// Each pushed spectrum adds one onset-envelope sample, the spectral flux
+// (sum of positive log-magnitude rises against the previous frame), at a
+// cost of O(bins). A few times per second the envelope history is
+// autocorrelated through a zero-padded real FFT; every candidate period is
+// scored by a comb over its first three multiples, weighted by a
+// log-Gaussian prior around 120 BPM to settle octave ambiguity (the half
+// period still wins when it repeats nearly as strongly), and the winning
+// lag is refined by parabolic interpolation.
+// The tracker reuses the spectra an analyzer already produces, so it runs
+// beside a StreamingAnalyzer, an overlapped analysis or a real-time block
+// stream without a second pass over the audio. Nothing is allocated after
+// construction.
+class TempoTracker {
+private:
+    TempoTrackerOptions options_;
+    size_t sample_rate_;
+    size_t hop_size_;
+
+    std::vector<double> previous_;          // Log-compressed magnitudes of the last frame
+    std::vector<double> envelope_;          // Onset envelope ring, history_length_ samples
+    size_t history_length_;                 // Power of two
+    size_t position_;                       // Next envelope write index
+    uint64_t frames_;
+
+    std::shared_ptr<const FFTPlan> plan_;   // 2 * history_length_
+    std::vector<double> padded_;
+    std::vector<std::complex<double>> spectrum_;
+    std::vector<double> autocorrelation_;
+
+    size_t min_lag_;
+    size_t max_lag_;
+    size_t update_interval_;                // Frames between estimates
+    size_t frames_until_update_;
+
+    double tempo_;
+    double confidence_;
+    double onset_strength_;
+
+    void configureLags();
+    void estimate();
+
+public:
+    // plan is used when it has getTransformSize(); trackers of many streams
+    // can share one
+    TempoTracker(size_t fft_size = 1024, size_t sample_rate = 44100, size_t hop_size = 256,
+                 const TempoTrackerOptions& options = TempoTrackerOptions(),
+                 std::shared_ptr<const FFTPlan> plan = nullptr);
+
+    // FFT length used for the autocorrelation at this frame rate
+    static size_t getTransformSize(size_t sample_rate, size_t hop_size,
+                                   const TempoTrackerOptions& options = TempoTrackerOptions());
+
+    // Add the magnitude spectrum of the next frame (hop_size samples after
+    // the previous one); returns the current tempo estimate
+    template<typename Real>
+    double pushSpectrum(const Real* magnitude, size_t bin_count);
+
+    // Spacing of the pushed frames; a change clears the history
+    void setHopSize(size_t hop_size);
+
+    void reset();
+
+    // BPM, or 0 until the history spans two periods of the slowest tempo
+    double getTempo() const { return tempo_; }
+    // Normalized autocorrelation at the chosen period (0..1)
+    double getConfidence() const { return confidence_; }
+    // Spectral flux of the last pushed frame
+    double getOnsetStrength() const { return onset_strength_; }
+
+    size_t getHopSize() const { return hop_size_; }
+    uint64_t getFramesPushed() const { return frames_; }
+    size_t getHistoryLength() const { return history_length_; }
+    const std::shared_ptr<const FFTPlan>& getPlan() const { return plan_; }
+};
+
+extern template double TempoTracker::pushSpectrum<double>(const double*, size_t);
+extern template double TempoTracker::pushSpectrum<float>(const float*, size_t);
+
+} // namespace AnantaSound
@@ -0,0 +1,520 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace AnantaSound {
+
+namespace {
+
+// Identifies the pool worker running on this thread, if any, and the lane
+// of the task it is running
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+thread_local TaskPriority current_priority = TaskPriority::NORMAL;
+
+// Options for ThreadPool::shared(), fixed when it is first created
+std::mutex shared_options_mutex;
+ThreadPoolOptions shared_options;
+bool shared_created = false;
+
+ThreadPoolOptions claimSharedOptions() {
+    std::lock_guard<std::mutex> lock(shared_options_mutex);
+    shared_created = true;
+    return shared_options;
+}
+
+#if defined(__linux__)
+// "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream stream(text);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        int first = 0, last = 0;
+        size_t dash = range.find('-');
+        try {
+            first = std::stoi(range.substr(0, dash));
+            last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        } catch (const std::exception&) {
+            continue;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+#endif
+
+} // namespace
+
+struct ThreadPool::ParallelJob {
+    size_t count;
+    size_t grain;
+    size_t chunk_count;
+    const RangeBody* body;
+
+    std::atomic<size_t> next_chunk{0};
+    std::atomic<size_t> finished_chunks{0};
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+};
+
+ThreadPool::ThreadPool(size_t worker_count) {
+    options_.worker_count = worker_count;
+    start();
+}
+
+ThreadPool::ThreadPool(const ThreadPoolOptions& options)
+    : options_(options) {
+    start();
+}
+
+void ThreadPool::start() {
+    for (auto& pending : pending_tasks_) {
+        pending.store(0, std::memory_order_relaxed);
+    }
+    running_background_.store(0, std::memory_order_relaxed);
+    next_queue_.store(0, std::memory_order_relaxed);
+    stopping_ = false;
+    timer_sequence_ = 0;
+    timer_stopping_ = false;
+
+    size_t worker_count = options_.worker_count;
+    if (worker_count == 0) {
+        size_t hardware = std::thread::hardware_concurrency();
+        worker_count = hardware > 1 ? hardware - 1 : 0;
+    }
+    background_limit_ = options_.background_worker_limit != 0
+        ? std::min(options_.background_worker_limit, std::max<size_t>(worker_count, 1))
+        : std::max<size_t>(worker_count, 2) - 1;
+
+    // Placement: explicit CPUs win; otherwise NUMA-aware pools deal workers
+    // round-robin over the nodes and pin each to its node's CPUs
+    std::vector<std::vector<int>> nodes = options_.numa_aware ? getNumaTopology() : std::vector<std::vector<int>>();
+    std::vector<std::vector<int>> worker_cpus(worker_count);
+    worker_nodes_.assign(worker_count, 0);
+    for (size_t i = 0; i < worker_count; ++i) {
+        if (!nodes.empty()) {
+            worker_nodes_[i] = i % nodes.size();
+            worker_cpus[i] = nodes[worker_nodes_[i]];
+        }
+        if (!options_.cpu_affinity.empty()) {
+            worker_cpus[i] = {options_.cpu_affinity[i % options_.cpu_affinity.size()]};
+        }
+    }
+
+    // Victims on the thief's own node come first, nearest index first
+    steal_order_.resize(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        for (size_t pass = 0; pass < 2; ++pass) {
+            for (size_t offset = 1; offset < worker_count; ++offset) {
+                size_t victim = (i + offset) % worker_count;
+                if ((worker_nodes_[victim] == worker_nodes_[i]) == (pass == 0)) {
+                    steal_order_[i].push_back(victim);
+                }
+            }
+        }
+    }
+
+    queues_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back([this, i, cpus = std::move(worker_cpus[i])]() {
+            if (!cpus.empty() && !setCurrentThreadAffinity(cpus)) {
+                std::cerr << "ThreadPool: cannot pin worker " << i << " to its CPUs" << std::endl;
+            }
+            if (options_.worker_priority != ThreadPriority::NORMAL &&
+                !setCurrentThreadPriority(options_.worker_priority)) {
+                std::cerr << "ThreadPool: cannot change priority of worker " << i << std::endl;
+            }
+            workerLoop(i);
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(timer_mutex_);
+        timer_stopping_ = true;
+    }
+    timer_condition_.notify_all();
+    if (timer_thread_.joinable()) {
+        timer_thread_.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_condition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(claimSharedOptions());
+    return pool;
+}
+
+bool ThreadPool::configureShared(const ThreadPoolOptions& options) {
+    std::lock_guard<std::mutex> lock(shared_options_mutex);
+    if (shared_created) {
+        std::cerr << "ThreadPool: shared pool already running; options ignored" << std::endl;
+        return false;
+    }
+    shared_options = options;
+    return true;
+}
+
+void ThreadPool::submit(Task task, TaskPriority priority) {
+    if (workers_.empty()) {
+        task();
+        return;
+    }
+
+    // Workers keep their own follow-up work local; other threads spread it
+    size_t queue_index = current_pool == this
+        ? current_worker
+        : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    size_t lane = static_cast<size_t>(priority);
+
+    {
+        std::lock_guard<std::mutex> lock(queues_[queue_index]->mutex);
+        queues_[queue_index]->tasks[lane].push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        pending_tasks_[lane].fetch_add(1, std::memory_order_relaxed);
+    }
+    wake_condition_.notify_one();
+}
+
+void ThreadPool::submitAt(std::chrono::steady_clock::time_point due, Task task, TaskPriority priority) {
+    auto later = [](const TimedTask& a, const TimedTask& b) {
+        return a.due != b.due ? a.due > b.due : a.sequence > b.sequence;
+    };
+    {
+        std::lock_guard<std::mutex> lock(timer_mutex_);
+        if (timer_stopping_) {
+            return;
+        }
+        timers_.push_back({due, timer_sequence_++, priority, std::move(task)});
+        std::push_heap(timers_.begin(), timers_.end(), later);
+        if (!timer_thread_.joinable()) {
+            timer_thread_ = std::thread(&ThreadPool::timerLoop, this);
+        }
+    }
+    timer_condition_.notify_one();
+}
+
+void ThreadPool::submitAfter(std::chrono::steady_clock::duration delay, Task task, TaskPriority priority) {
+    submitAt(std::chrono::steady_clock::now() + delay, std::move(task), priority);
+}
+
+void ThreadPool::timerLoop() {
+    auto later = [](const TimedTask& a, const TimedTask& b) {
+        return a.due != b.due ? a.due > b.due : a.sequence > b.sequence;
+    };
+    std::unique_lock<std::mutex> lock(timer_mutex_);
+    while (!timer_stopping_) {
+        if (timers_.empty()) {
+            timer_condition_.wait(lock);
+            continue;
+        }
+        if (std::chrono::steady_clock::now() < timers_.front().due) {
+            timer_condition_.wait_until(lock, timers_.front().due);
+            continue;
+        }
+        std::pop_heap(timers_.begin(), timers_.end(), later);
+        TimedTask due = std::move(timers_.back());
+        timers_.pop_back();
+
+        lock.unlock();
+        submit(std::move(due.task), due.priority);
+        lock.lock();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const RangeBody& body) {
+    if (count == 0) {
+        return;
+    }
+
+    grain = std::max<size_t>(1, grain);
+    size_t chunk_count = (count + grain - 1) / grain;
+    size_t slot = currentSlot();
+
+    if (workers_.empty() || chunk_count == 1) {
+        body(0, count, slot);
+        return;
+    }
+
+    auto job = std::make_shared<ParallelJob>();
+    job->count = count;
+    job->grain = grain;
+    job->chunk_count = chunk_count;
+    job->body = &body;
+
+    // Helpers that start after all chunks are claimed exit without touching body
+    TaskPriority priority = current_pool == this ? current_priority : TaskPriority::NORMAL;
+    size_t helpers = std::min(workers_.size(), chunk_count - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        submit([job]() {
+            runChunks(*job, current_worker);
+        }, priority);
+    }
+
+    runChunks(*job, slot);
+
+    {
+        std::unique_lock<std::mutex> lock(job->mutex);
+        job->finished.wait(lock, [&job]() {
+            return job->finished_chunks.load(std::memory_order_acquire) == job->chunk_count;
+        });
+    }
+
+    if (job->error) {
+        std::rethrow_exception(job->error);
+    }
+}
+
+void ThreadPool::runChunks(ParallelJob& job, size_t slot) {
+    while (true) {
+        size_t chunk = job.next_chunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= job.chunk_count) {
+            return;
+        }
+
+        size_t begin = chunk * job.grain;
+        size_t end = std::min(job.count, begin + job.grain);
+
+        try {
+            (*job.body)(begin, end, slot);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+        }
+
+        if (job.finished_chunks.fetch_add(1, std::memory_order_acq_rel) + 1 == job.chunk_count) {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            job.finished.notify_all();
+        }
+    }
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    current_pool = this;
+    current_worker = index;
+
+    while (true) {
+        if (tryRunTask(index)) {
+            continue;
+        }
+
+        // Background tasks over the limit do not count as work: idle workers
+        // sleep until a running one finishes
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_condition_.wait(lock, [this]() {
+            return (stopping_ && totalPending() == 0) || hasRunnableWork();
+        });
+
+        if (stopping_ && totalPending() == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::hasRunnableWork() const {
+    const size_t background = static_cast<size_t>(TaskPriority::BACKGROUND);
+    for (size_t lane = 0; lane < background; ++lane) {
+        if (pending_tasks_[lane].load(std::memory_order_relaxed) > 0) {
+            return true;
+        }
+    }
+    return pending_tasks_[background].load(std::memory_order_relaxed) > 0 &&
+           running_background_.load(std::memory_order_relaxed) < background_limit_;
+}
+
+size_t ThreadPool::totalPending() const {
+    size_t total = 0;
+    for (const auto& pending : pending_tasks_) {
+        total += pending.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+bool ThreadPool::takeTask(size_t index, size_t lane, Task& task) {
+    // Own queue first (most recent task, cache-warm), then steal the oldest
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        auto& own = queues_[index]->tasks[lane];
+        if (!own.empty()) {
+            task = std::move(own.back());
+            own.pop_back();
+            return true;
+        }
+    }
+
+    for (size_t victim_index : steal_order_[index]) {
+        WorkerQueue& victim = *queues_[victim_index];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks[lane].empty()) {
+            task = std::move(victim.tasks[lane].front());
+            victim.tasks[lane].pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::tryRunTask(size_t index) {
+    Task task;
+    size_t lane = 0;
+    const size_t background = static_cast<size_t>(TaskPriority::BACKGROUND);
+    for (; lane < background; ++lane) {
+        if (pending_tasks_[lane].load(std::memory_order_relaxed) > 0 && takeTask(index, lane, task)) {
+            break;
+        }
+    }
+
+    // A background task needs one of the background slots
+    if (!task && pending_tasks_[background].load(std::memory_order_relaxed) > 0) {
+        size_t running = running_background_.load(std::memory_order_relaxed);
+        while (running < background_limit_ &&
+               !running_background_.compare_exchange_weak(running, running + 1, std::memory_order_acq_rel)) {
+        }
+        if (running < background_limit_) {
+            if (!takeTask(index, background, task)) {
+                std::lock_guard<std::mutex> lock(wake_mutex_);
+                running_background_.fetch_sub(1, std::memory_order_acq_rel);
+                wake_condition_.notify_all();
+                return false;
+            }
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+
+    pending_tasks_[lane].fetch_sub(1, std::memory_order_relaxed);
+    current_priority = static_cast<TaskPriority>(lane);
+
+    try {
+        task();
+    } catch (const std::exception& e) {
+        std::cerr << "ThreadPool task failed: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "ThreadPool task failed with unknown exception" << std::endl;
+    }
+    task = nullptr;                 // Release captures before the slot is given back
+    current_priority = TaskPriority::NORMAL;
+
+    if (lane == background) {
+        // Idle workers may be waiting for this slot
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        running_background_.fetch_sub(1, std::memory_order_acq_rel);
+        wake_condition_.notify_all();
+    }
+    return true;
+}
+
+size_t ThreadPool::currentSlot() const {
+    return current_pool == this ? current_worker : workers_.size();
+}
+
+std::vector<std::vector<int>> ThreadPool::getNumaTopology() {
+    std::vector<std::vector<int>> nodes;
+#if defined(__linux__)
+    for (int node = 0;; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file) {
+            break;
+        }
+        std::string text;
+        std::getline(file, text);
+        std::vector<int> cpus = parseCpuList(text);
+        if (!cpus.empty()) {
+            nodes.push_back(std::move(cpus));
+        }
+    }
+#endif
+    if (nodes.empty()) {
+        std::vector<int> cpus(std::max(1u, std::thread::hardware_concurrency()));
+        for (size_t i = 0; i < cpus.size(); ++i) {
+            cpus[i] = static_cast<int>(i);
+        }
+        nodes.push_back(std::move(cpus));
+    }
+    return nodes;
+}
+
+bool ThreadPool::setCurrentThreadAffinity(const std::vector<int>& cpus) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return CPU_COUNT(&set) > 0 && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+bool ThreadPool::setCurrentThreadPriority(ThreadPriority priority) {
+#if defined(__linux__)
+    sched_param param{};
+    switch (priority) {
+        case ThreadPriority::REALTIME:
+            param.sched_priority = sched_get_priority_min(SCHED_FIFO) + 10;
+            return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+        case ThreadPriority::NORMAL:
+            if (pthread_setschedparam(pthread_self(), SCHED_OTHER, &param) != 0) {
+                return false;
+            }
+            return setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 0) == 0;
+        case ThreadPriority::BACKGROUND:
+            // Linux applies nice values per thread
+            return setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10) == 0;
+    }
+    return false;
+#else
+    (void)priority;
+    return false;
+#endif
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace AnantaSound {
+
+// Task lanes, served in this order by every worker. BACKGROUND tasks run
+// on at most background_worker_limit workers at a time, so long analyses
+// always leave a worker free for HIGH and NORMAL work.
+enum class TaskPriority {
+    HIGH,           // Latency-sensitive work feeding the audio path
+    NORMAL,
+    BACKGROUND      // Long analyses, scans, file work
+};
+
+constexpr size_t kTaskPriorityCount = static_cast<size_t>(TaskPriority::BACKGROUND) + 1;
+
+// OS scheduling class of a thread
+enum class ThreadPriority {
+    REALTIME,       // SCHED_FIFO where permitted (the audio thread)
+    NORMAL,
+    BACKGROUND      // Lowered priority (nice 10)
+};
+
+struct ThreadPoolOptions {
+    size_t worker_count = 0;                // 0: hardware_concurrency() - 1
+    std::vector<int> cpu_affinity;          // Worker i pinned to cpu_affinity[i % size]; empty: unpinned
+    bool numa_aware = false;                // Workers spread over NUMA nodes, pinned to their node and stealing there first
+    ThreadPriority worker_priority = ThreadPriority::NORMAL;
+    size_t background_worker_limit = 0;     // 0: all workers but one (at least one)
+};
+
+// Work-stealing thread pool.
+// Every worker owns a task deque per lane: it pops its own work LIFO and
+// steals from the front of the other deques when idle, workers on its own
+// NUMA node first. parallelFor splits an index range into chunks that are
+// claimed dynamically, and the calling thread works on its own job while it
+// waits, so nested calls cannot deadlock. Helper tasks of a parallelFor
+// inherit the lane of the task that called it.
+//
+// The library submits its parallel work to shared() instead of starting
+// threads; configureShared() sets worker count, affinity and lanes before
+// first use. Threads that block on I/O or a pipeline queue for their whole
+// life (file writers, network receivers, watcher loops) stay dedicated.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // body(begin, end, slot): slot is unique among threads running the same
+    // job and lies in [0, getConcurrency()), so it can index per-thread scratch
+    using RangeBody = std::function<void(size_t begin, size_t end, size_t slot)>;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks[kTaskPriorityCount];
+    };
+
+    struct TimedTask {
+        std::chrono::steady_clock::time_point due;
+        uint64_t sequence;                  // FIFO among equal deadlines
+        TaskPriority priority;
+        Task task;
+    };
+
+    struct ParallelJob;
+
+    ThreadPoolOptions options_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::vector<size_t> worker_nodes_;      // NUMA node of each worker
+    std::vector<std::vector<size_t>> steal_order_;
+    size_t background_limit_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_condition_;
+    std::atomic<size_t> pending_tasks_[kTaskPriorityCount];
+    std::atomic<size_t> running_background_;
+    std::atomic<size_t> next_queue_;
+    bool stopping_;
+
+    // Delayed tasks: a min-heap served by one timer thread, started on first use
+    std::mutex timer_mutex_;
+    std::condition_variable timer_condition_;
+    std::vector<TimedTask> timers_;
+    std::thread timer_thread_;
+    uint64_t timer_sequence_;
+    bool timer_stopping_;
+
+public:
+    // worker_count == 0 picks hardware_concurrency() - 1 (the caller is the
+    // remaining thread); with no workers every call runs inline
+    explicit ThreadPool(size_t worker_count = 0);
+    explicit ThreadPool(const ThreadPoolOptions& options);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Library-wide default pool
+    static ThreadPool& shared();
+
+    // Options for shared(); false (and no effect) once it has been created
+    static bool configureShared(const ThreadPoolOptions& options);
+
+    // Fire-and-forget task
+    void submit(Task task, TaskPriority priority = TaskPriority::NORMAL);
+
+    // Task queued at due (or after delay). Tasks still waiting when the pool
+    // is destroyed are dropped.
+    void submitAt(std::chrono::steady_clock::time_point due, Task task,
+                  TaskPriority priority = TaskPriority::NORMAL);
+    void submitAfter(std::chrono::steady_clock::duration delay, Task task,
+                     TaskPriority priority = TaskPriority::NORMAL);
+
+    // Run body over [0, count) in chunks of at most grain indices; returns
+    // once every chunk has finished. The first exception thrown by body is
+    // rethrown here.
+    void parallelFor(size_t count, size_t grain, const RangeBody& body);
+
+    size_t getWorkerCount() const { return workers_.size(); }
+    size_t getConcurrency() const { return workers_.size() + 1; }
+    size_t getBackgroundWorkerLimit() const { return background_limit_; }
+    size_t getWorkerNode(size_t worker) const { return worker_nodes_[worker]; }
+    const ThreadPoolOptions& getOptions() const { return options_; }
+
+    // Queued (not yet started) tasks in a lane
+    size_t getPendingTasks(TaskPriority priority) const {
+        return pending_tasks_[static_cast<size_t>(priority)].load(std::memory_order_relaxed);
+    }
+
+    // CPUs of each NUMA node (one node with every CPU where the topology is unknown)
+    static std::vector<std::vector<int>> getNumaTopology();
+
+    // Pin / prioritize the calling thread (for example the audio callback
+    // thread); false where the OS refuses or does not support it
+    static bool setCurrentThreadAffinity(const std::vector<int>& cpus);
+    static bool setCurrentThreadPriority(ThreadPriority priority);
+
+private:
+    void start();
+    void workerLoop(size_t index);
+    void timerLoop();
+    bool tryRunTask(size_t index);
+    bool takeTask(size_t index, size_t lane, Task& task);
+    bool hasRunnableWork() const;
+    size_t totalPending() const;
+    size_t currentSlot() const;
+    static void runChunks(ParallelJob& job, size_t slot);
+};
+
+} // namespace AnantaSound
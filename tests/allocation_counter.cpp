@@ -0,0 +1,80 @@
+#include "allocation_counter.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions so tests can assert that hot
+// paths stay allocation-free. Counting is per thread, so background
+// threads started by other tests do not disturb a measurement.
+
+namespace {
+
+thread_local size_t allocation_count = 0;
+thread_local bool allocation_trapped = false;
+
+void checkTrap() {
+    if (allocation_trapped) {
+        std::fputs("allocation inside a TestSupport::AllocationTrap scope\n", stderr);
+        std::abort();
+    }
+}
+
+void* countedAllocate(std::size_t size) {
+    checkTrap();
+    allocation_count++;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* countedAllocateAligned(std::size_t size, std::align_val_t alignment) {
+    checkTrap();
+    allocation_count++;
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+    void* ptr = std::aligned_alloc(align, rounded);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+} // namespace
+
+namespace TestSupport {
+
+size_t allocationCount() {
+    return allocation_count;
+}
+
+AllocationTrap::AllocationTrap() : previous_(allocation_trapped) {
+    allocation_trapped = true;
+}
+
+AllocationTrap::~AllocationTrap() {
+    allocation_trapped = previous_;
+}
+
+} // namespace TestSupport
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t size, std::align_val_t alignment) { return countedAllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return countedAllocateAligned(size, alignment); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
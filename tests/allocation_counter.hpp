@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+namespace TestSupport {
+
+// Number of global operator new calls made so far by the calling thread
+size_t allocationCount();
+
+// While an AllocationTrap is alive, any allocation on the constructing thread
+// aborts with a message, so the offending call shows up in a debugger
+class AllocationTrap {
+public:
+    AllocationTrap();
+    ~AllocationTrap();
+
+    AllocationTrap(const AllocationTrap&) = delete;
+    AllocationTrap& operator=(const AllocationTrap&) = delete;
+
+private:
+    bool previous_;
+};
+
+} // namespace TestSupport
@@ -1,7 +1,20 @@
 #include "anantasound_core.hpp"
+#include "allocation_counter.hpp"
+#include "interference_kernels.hpp"
+#include "interference_backend.hpp"
+#include "interference_cluster_tree.hpp"
+#include "feedback_kernels.hpp"
+#include "qrd_integration.hpp"
+#include "harmonic_bank.hpp"
+#include "consciousness_integration.hpp"
+#include "thread_pool.hpp"
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <algorithm>
+#include <vector>
+#include <atomic>
+#include <thread>
 
 using namespace AnantaSound;
 
@@ -48,6 +61,500 @@ void test_interference_field() {
     std::cout << "✓ InterferenceField test passed" << std::endl;
 }
 
+void test_interference_batch() {
+    std::cout << "Testing InterferenceField batch evaluation..." << std::endl;
+    
+    // Vector kernels agree with the scalar reference, including the scalar tail
+    std::vector<double> x(37), y(37), z(37), k(37), wr(37), wi(37);
+    for (size_t s = 0; s < x.size(); ++s) {
+        x[s] = std::sin(0.37 * s) * 4.0;
+        y[s] = std::cos(0.53 * s) * 4.0;
+        z[s] = 0.1 * s;
+        k[s] = 2.0 * M_PI * (100.0 + 97.0 * s) / 343.0;
+        wr[s] = std::cos(0.2 * s);
+        wi[s] = std::sin(0.3 * s);
+    }
+    InterferenceSources sources{x.data(), y.data(), z.data(), k.data(), wr.data(), wi.data(), x.size()};
+    std::complex<double> expected = getInterferenceKernels(SIMDLevel::SCALAR).accumulate(sources, 0.3, -1.2, 2.5);
+    for (SIMDLevel level : {SIMDLevel::SCALAR, SIMDLevel::AVX2, SIMDLevel::AVX512, SIMDLevel::NEON}) {
+        std::complex<double> value = getInterferenceKernels(level).accumulate(sources, 0.3, -1.2, 2.5);
+        assert(std::abs(value - expected) < 1e-9);
+    }
+    
+    // Batch evaluation matches per-point queries and the direct formula
+    SphericalCoord center{1.0, M_PI/4, M_PI/4, 1.0};
+    InterferenceField field(InterferenceFieldType::PHASE_MODULATED, center, 5.0);
+    std::vector<QuantumSoundField> sources_fields;
+    for (int s = 0; s < 11; ++s) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(1.0 + 0.1 * s, 0.05 * s);
+        source.phase = 0.0;
+        source.frequency = 200.0 + 40.0 * s;
+        source.quantum_state = (s % 2) ? QuantumSoundState::SUPERPOSITION : QuantumSoundState::COHERENT;
+        source.position = {1.0 + 0.2 * s, 0.1 * s, 0.3 * s, 0.5};
+        sources_fields.push_back(source);
+        field.addSourceField(source);
+    }
+    
+    std::vector<SphericalCoord> grid;
+    for (int i = 0; i < 25; ++i) {
+        grid.push_back({0.5 + 0.2 * i, 0.05 * i, 0.25 * i, 1.0 + 0.1 * i});
+    }
+    auto batch = field.calculateInterference(grid, 0.0);
+    assert(batch.size() == grid.size());
+    
+    for (size_t i = 0; i < grid.size(); ++i) {
+        assert(batch[i] == field.calculateInterference(grid[i], 0.0));
+        
+        CartesianPosition p = CartesianPosition::fromSpherical(grid[i]);
+        std::complex<double> direct(0.0, 0.0);
+        for (const auto& source : sources_fields) {
+            CartesianPosition q = CartesianPosition::fromSpherical(source.position);
+            double distance = std::sqrt((p.x - q.x) * (p.x - q.x) + (p.y - q.y) * (p.y - q.y) +
+                                        (p.z - q.z) * (p.z - q.z));
+            std::complex<double> factor = source.quantum_state == QuantumSoundState::SUPERPOSITION
+                ? std::complex<double>(0.707, 0.707) : std::complex<double>(1.0, 0.0);
+            direct += source.amplitude * factor *
+                std::exp(std::complex<double>(0.0, -2.0 * M_PI * source.frequency * distance / 343.0));
+        }
+        direct *= std::exp(std::complex<double>(0.0, M_PI / 4.0));
+        assert(std::abs(batch[i] - direct) < 1e-9);
+    }
+    
+    // Entanglement refreshes the cached source weights
+    SphericalCoord point = grid[3];
+    auto before = field.calculateInterference(point, 0.0);
+    field.createQuantumEntanglement(0, 2);
+    auto after = field.calculateInterference(point, 0.0);
+    assert(std::abs(after - before) > 1e-6);
+    
+    sources_fields[0].quantum_state = QuantumSoundState::ENTANGLED;
+    sources_fields[2].quantum_state = QuantumSoundState::ENTANGLED;
+    InterferenceField rebuilt(InterferenceFieldType::PHASE_MODULATED, center, 5.0);
+    for (const auto& source : sources_fields) {
+        rebuilt.addSourceField(source);
+    }
+    assert(std::abs(rebuilt.calculateInterference(point, 0.0) - after) < 1e-12);
+
+    // Each field type scales the same source sum by its own factor
+    const double time = 0.013;
+    const std::pair<InterferenceFieldType, std::complex<double>> types[] = {
+        {InterferenceFieldType::CONSTRUCTIVE, 1.0},
+        {InterferenceFieldType::DESTRUCTIVE, -1.0},
+        {InterferenceFieldType::PHASE_MODULATED, std::exp(std::complex<double>(0.0, M_PI / 4.0))},
+        {InterferenceFieldType::AMPLITUDE_MODULATED, 1.0 + 0.5 * std::sin(2.0 * M_PI * 10.0 * time)},
+        {InterferenceFieldType::QUANTUM_ENTANGLED, std::exp(std::complex<double>(0.0, M_PI / 6.0))},
+    };
+    auto raw = rebuilt.calculateInterference(grid, 0.0);
+    for (const auto& [type, factor] : types) {
+        InterferenceField typed(type, center, 5.0);
+        typed.addSourceFields(sources_fields);
+        auto values = typed.calculateInterference(grid, time);
+        for (size_t i = 0; i < grid.size(); ++i) {
+            std::complex<double> expected = raw[i] * std::exp(std::complex<double>(0.0, -M_PI / 4.0)) * factor;
+            assert(std::abs(values[i] - expected) < 1e-9);
+        }
+    }
+
+    std::cout << "✓ InterferenceField batch evaluation test passed" << std::endl;
+}
+
+void test_interference_map_backend() {
+    std::cout << "Testing InterferenceField map backend..." << std::endl;
+    
+    SphericalCoord center{1.0, M_PI/4, M_PI/4, 1.0};
+    std::vector<QuantumSoundField> sources;
+    for (int s = 0; s < 37; ++s) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.5 + 0.05 * s, -0.02 * s);
+        source.phase = 0.0;
+        source.frequency = 150.0 + 25.0 * s;
+        source.quantum_state = (s % 3) ? QuantumSoundState::COHERENT : QuantumSoundState::SUPERPOSITION;
+        source.position = {1.0 + 0.1 * s, 0.07 * s, 0.2 * s, 0.3};
+        sources.push_back(source);
+    }
+    std::vector<SphericalCoord> points;
+    for (int i = 0; i < 500; ++i) {
+        points.push_back({0.5 + 0.01 * i, 0.003 * i, 0.013 * i, 1.0 + 0.002 * i});
+    }
+    InterferencePointGrid grid(points);
+    assert(grid.size() == points.size());
+    
+    // The map matches point queries for every field type, serial and threaded
+    ThreadPool pool(4);
+    CPUInterferenceBackend serial;
+    CPUInterferenceBackend threaded(&pool);
+    std::vector<std::complex<double>> map(grid.size());
+    for (InterferenceFieldType type : {InterferenceFieldType::CONSTRUCTIVE, InterferenceFieldType::DESTRUCTIVE,
+                                       InterferenceFieldType::MIXED, InterferenceFieldType::PHASE_MODULATED,
+                                       InterferenceFieldType::AMPLITUDE_MODULATED,
+                                       InterferenceFieldType::QUANTUM_ENTANGLED}) {
+        InterferenceField field(type, center, 5.0);
+        field.addSourceFields(sources);
+        auto expected = field.calculateInterference(points, 0.021);
+        for (CPUInterferenceBackend* backend : {&serial, &threaded}) {
+            std::fill(map.begin(), map.end(), std::complex<double>(0.0, 0.0));
+            assert(field.calculateInterferenceMap(grid, 0.021, map.data(), *backend));
+            for (size_t i = 0; i < grid.size(); ++i) {
+                assert(std::abs(map[i] - expected[i]) < 1e-12);
+            }
+        }
+    }
+    
+    // Sources are uploaded once per snapshot, not once per map
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, center, 5.0);
+    CPUInterferenceBackend backend(&pool);
+    assert(field.calculateInterferenceMap(grid, 0.0, map.data(), backend));
+    assert(backend.getUploadCount() == 1 && map[0] == std::complex<double>(0.0, 0.0));
+    auto handles = field.addSourceFields(sources);
+    for (int tick = 0; tick < 5; ++tick) {
+        assert(field.calculateInterferenceMap(grid, 0.01 * tick, map.data(), backend));
+    }
+    assert(backend.getUploadCount() == 2);
+    assert(map[7] == field.calculateInterference(points[7], 0.0));
+    field.removeSourceField(handles[3]);
+    assert(field.calculateInterferenceMap(grid, 0.0, map.data(), backend));
+    assert(backend.getUploadCount() == 3);
+    assert(map[7] == field.calculateInterference(points[7], 0.0));
+    
+    // Reassigning the grid stamps a new version
+    uint64_t version = grid.getVersion();
+    grid.assign(points.data(), 10);
+    assert(grid.size() == 10 && grid.getVersion() != version);
+    
+    std::cout << "✓ InterferenceField map backend test passed" << std::endl;
+}
+
+void test_baked_interference() {
+    std::cout << "Testing InterferenceField baked layout..." << std::endl;
+    
+    SphericalCoord center{1.0, M_PI/4, M_PI/4, 1.0};
+    std::vector<QuantumSoundField> sources;
+    for (int s = 0; s < 29; ++s) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.4 + 0.03 * s, 0.01 * s);
+        source.phase = 0.0;
+        source.frequency = 200.0 + 31.0 * s;
+        source.quantum_state = (s % 4) ? QuantumSoundState::COHERENT : QuantumSoundState::SUPERPOSITION;
+        source.position = {1.0 + 0.08 * s, 0.05 * s, 0.17 * s, 0.4};
+        sources.push_back(source);
+    }
+    std::vector<SphericalCoord> seats;
+    for (int i = 0; i < 300; ++i) {
+        seats.push_back({0.6 + 0.01 * i, 0.004 * i, 0.011 * i, 1.2});
+    }
+    InterferencePointGrid grid(seats);
+    
+    auto matches = [&](const std::vector<std::complex<double>>& baked,
+                       const std::vector<std::complex<double>>& expected) {
+        for (size_t i = 0; i < baked.size(); ++i) {
+            if (std::abs(baked[i] - expected[i]) > 1e-9 * (1.0 + std::abs(expected[i]))) {
+                return false;
+            }
+        }
+        return true;
+    };
+    
+    // Baked rows reproduce direct evaluation for every field type
+    ThreadPool pool(4);
+    std::vector<std::complex<double>> output(grid.size());
+    for (InterferenceFieldType type : {InterferenceFieldType::CONSTRUCTIVE, InterferenceFieldType::DESTRUCTIVE,
+                                       InterferenceFieldType::PHASE_MODULATED,
+                                       InterferenceFieldType::QUANTUM_ENTANGLED}) {
+        InterferenceField field(type, center, 5.0);
+        field.addSourceFields(sources);
+        BakedInterferenceLayout layout;
+        field.bakeLayout(grid, layout, &pool);
+        assert(layout.isBaked() && layout.getListenerCount() == grid.size());
+        assert(layout.getSourceCount() == sources.size());
+        assert(layout.getMemoryBytes() == grid.size() * sources.size() * 2 * sizeof(double));
+        for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            assert(field.calculateBakedInterference(layout, 0.013, output.data(), threads));
+            assert(matches(output, field.calculateInterference(seats, 0.013)));
+        }
+    }
+    
+    // Amplitude and phase changes keep the layout; adding or removing sources stales it
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, center, 5.0);
+    auto handles = field.addSourceFields(sources);
+    BakedInterferenceLayout layout;
+    field.bakeLayout(grid, layout);
+    assert(field.setSourceAmplitude(handles[2], std::polar(1.5, 0.7)));
+    std::vector<std::complex<double>> amplitudes(handles.size(), std::complex<double>(0.0, 0.9));
+    assert(field.setSourceAmplitudes(handles.data() + 5, amplitudes.data(), 10));
+    assert(field.calculateBakedInterference(layout, 0.0, output.data()));
+    assert(matches(output, field.calculateInterference(seats, 0.0)));
+    auto before_set = field.calculateInterference(seats[0], 0.0);
+    field.removeSourceField(handles[0]);
+    assert(!field.setSourceAmplitude(handles[0], 1.0));
+    assert(!field.calculateBakedInterference(layout, 0.0, output.data()));
+    field.bakeLayout(grid, layout);
+    assert(field.calculateBakedInterference(layout, 0.0, output.data()));
+    assert(matches(output, field.calculateInterference(seats, 0.0)));
+    assert(output[0] != before_set);
+    field.addSourceField(sources[0]);
+    assert(!field.calculateBakedInterference(layout, 0.0, output.data()));
+    
+    std::cout << "✓ InterferenceField baked layout test passed" << std::endl;
+}
+
+void test_incremental_interference() {
+    std::cout << "Testing InterferenceField incremental map..." << std::endl;
+    
+    SphericalCoord center{1.0, M_PI/4, M_PI/4, 1.0};
+    std::vector<QuantumSoundField> sources;
+    for (int s = 0; s < 40; ++s) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.3 + 0.02 * s, -0.01 * s);
+        source.phase = 0.0;
+        source.frequency = 180.0 + 23.0 * s;
+        source.quantum_state = (s % 5) ? QuantumSoundState::COHERENT : QuantumSoundState::SUPERPOSITION;
+        source.position = {1.0 + 0.06 * s, 0.04 * s, 0.15 * s, 0.5};
+        sources.push_back(source);
+    }
+    std::vector<SphericalCoord> points;
+    for (int i = 0; i < 400; ++i) {
+        points.push_back({0.7 + 0.01 * i, 0.005 * i, 0.012 * i, 1.1});
+    }
+    InterferencePointGrid grid(points);
+    std::vector<std::complex<double>> output(grid.size());
+    
+    InterferenceField field(InterferenceFieldType::PHASE_MODULATED, center, 5.0);
+    auto matches = [&](double time) {
+        auto expected = field.calculateInterference(points, time);
+        for (size_t i = 0; i < output.size(); ++i) {
+            if (std::abs(output[i] - expected[i]) > 1e-9 * (1.0 + std::abs(expected[i]))) {
+                return false;
+            }
+        }
+        return true;
+    };
+    
+    ThreadPool pool(4);
+    IncrementalInterferenceMap map(grid, &pool, 8);
+    assert(map.size() == grid.size());
+    field.calculateIncrementalInterference(map, 0.0, output.data());
+    assert(map.getRebaseCount() == 1 && output[0] == std::complex<double>(0.0, 0.0));
+    
+    // Adding from empty has nothing to reuse; later edits touch only their slots
+    auto handles = field.addSourceFields(sources);
+    field.calculateIncrementalInterference(map, 0.01, output.data());
+    assert(map.getRebaseCount() == 2 && matches(0.01));
+    field.setSourceAmplitude(handles[7], std::polar(2.0, 1.1));
+    field.calculateIncrementalInterference(map, 0.02, output.data());
+    assert(map.getRebaseCount() == 2 && map.getLastChangedCount() == 1 && matches(0.02));
+    field.calculateIncrementalInterference(map, 0.03, output.data());
+    assert(map.getRebaseCount() == 2 && matches(0.03));
+    field.removeSourceField(handles[3]);
+    field.calculateIncrementalInterference(map, 0.04, output.data());
+    assert(map.getRebaseCount() == 2 && map.getLastChangedCount() == 2 && matches(0.04));
+    field.addSourceField(sources[3]);
+    field.calculateIncrementalInterference(map, 0.05, output.data());
+    assert(map.getRebaseCount() == 2 && map.getLastChangedCount() == 1 && matches(0.05));
+    
+    // Drift is bounded by periodic rebases
+    for (int tick = 0; tick < 8; ++tick) {
+        field.setSourceAmplitude(handles[10 + tick], std::polar(1.0, 0.3 * tick));
+        field.calculateIncrementalInterference(map, 0.001 * tick, output.data());
+        assert(matches(0.001 * tick));
+    }
+    assert(map.getRebaseCount() == 3);
+    
+    // Changing most sources at once falls back to a full recompute
+    std::vector<std::complex<double>> amplitudes(handles.size(), std::complex<double>(0.7, 0.2));
+    assert(field.setSourceAmplitudes(handles.data() + 4, amplitudes.data(), 36));
+    field.calculateIncrementalInterference(map, 0.0, output.data());
+    assert(map.getRebaseCount() == 4 && matches(0.0));
+    
+    map.invalidate();
+    field.calculateIncrementalInterference(map, 0.0, output.data());
+    assert(map.getRebaseCount() == 5 && matches(0.0));
+    
+    std::cout << "✓ InterferenceField incremental map test passed" << std::endl;
+}
+
+void test_interference_cluster_tree() {
+    std::cout << "Testing InterferenceClusterTree..." << std::endl;
+    
+    // 64 tight packs of sub-wavelength sources on four frequencies
+    SphericalCoord center{1.0, M_PI/4, M_PI/4, 1.0};
+    std::vector<QuantumSoundField> sources;
+    const double frequencies[] = {110.0, 220.0, 330.0, 440.0};
+    for (int pack = 0; pack < 64; ++pack) {
+        for (int s = 0; s < 64; ++s) {
+            QuantumSoundField source;
+            source.amplitude = std::polar(0.5 + 0.01 * s, 0.1 * pack);
+            source.phase = 0.0;
+            source.frequency = frequencies[pack % 4];
+            source.quantum_state = QuantumSoundState::COHERENT;
+            source.position = {8.0 + 0.0001 * s, 0.045 * pack, 0.098 * pack + 0.00001 * s, 0.1};
+            sources.push_back(source);
+        }
+    }
+    std::vector<SphericalCoord> points;
+    for (int i = 0; i < 64; ++i) {
+        points.push_back({1.0 + 0.01 * i, 0.02 * i, 0.05 * i, 1.0});
+    }
+    
+    InterferenceField field(InterferenceFieldType::MIXED, center, 5.0);
+    field.addSourceFields(sources);
+    auto expected = field.calculateInterference(points, 0.02);
+    
+    for (double tolerance : {1e-2, 1e-4}) {
+        InterferenceClusterTree tree(tolerance);
+        field.buildClusterTree(tree);
+        assert(tree.getSourceCount() == sources.size() && tree.getBandCount() == 4);
+        assert(tree.getNodeCount() > tree.getBandCount());
+        
+        // Error stays within the bound and the queries skip most sources
+        std::vector<std::complex<double>> output(points.size());
+        assert(field.calculateClusteredInterference(tree, points.data(), points.size(), 0.02, output.data()));
+        for (size_t i = 0; i < points.size(); ++i) {
+            assert(std::abs(output[i] - expected[i]) <= tolerance * tree.getTotalMagnitude() + 1e-9);
+        }
+        size_t visited = 0;
+        CartesianPosition point = CartesianPosition::fromSpherical(points[5]);
+        tree.evaluate(point.x, point.y, point.z, &visited);
+        assert(visited < sources.size() / 4);
+    }
+    
+    // Zero tolerance opens every node down to exact leaf sums
+    InterferenceClusterTree exact(0.0);
+    field.buildClusterTree(exact);
+    std::vector<std::complex<double>> output(points.size());
+    assert(field.calculateClusteredInterference(exact, points.data(), points.size(), 0.02, output.data()));
+    for (size_t i = 0; i < points.size(); ++i) {
+        assert(std::abs(output[i] - expected[i]) < 1e-9);
+    }
+    
+    // A resolution of half an octave merges the bands
+    InterferenceClusterTree merged(1e-3, 0.5);
+    field.buildClusterTree(merged);
+    assert(merged.getBandCount() == 3);
+    
+    // Any source change stales the tree
+    field.addSourceField(sources[0]);
+    assert(!field.calculateClusteredInterference(exact, points.data(), points.size(), 0.02, output.data()));
+    
+    std::cout << "✓ InterferenceClusterTree test passed" << std::endl;
+}
+
+void test_interference_ladders() {
+    std::cout << "Testing InterferenceField frequency ladders..." << std::endl;
+    
+    // Device-like layout: harmonic series and evenly spaced tones sharing a
+    // position, an irregular tone set, repeated frequencies and lone sources
+    SphericalCoord center{1.0, M_PI/4, M_PI/4, 1.0};
+    std::vector<QuantumSoundField> sources;
+    auto add = [&](double frequency, const SphericalCoord& position, double amplitude) {
+        QuantumSoundField source;
+        source.amplitude = std::polar(amplitude, 0.3 * sources.size());
+        source.phase = 0.0;
+        source.frequency = frequency;
+        source.quantum_state = sources.size() % 3 ? QuantumSoundState::COHERENT : QuantumSoundState::SUPERPOSITION;
+        source.position = position;
+        sources.push_back(source);
+    };
+    for (int device = 0; device < 6; ++device) {
+        SphericalCoord position{2.0 + 0.3 * device, 0.2 * device, 0.5 * device, 1.5};
+        for (int h = 1; h <= 8; ++h) {
+            add((110.0 + 20.0 * device) * h, position, 1.0 / h);
+        }
+        for (int element = 0; element < 5; ++element) {
+            add(432.0 + element * 111.0, {1.5, 0.1 * device, 0.4 * device, 0.5}, 0.8);
+        }
+        for (double tone : {396.0, 417.0, 528.0, 639.0, 741.0, 852.0, 963.0}) {
+            add(tone, {3.0, 0.3 * device, 0.2 * device, 1.0}, 0.6);
+        }
+        add(528.0, {3.0, 0.3 * device, 0.2 * device, 1.0}, 0.4);
+        add(250.0 + 17.0 * device, {4.0 + device, 1.0, 2.0, 0.0}, 0.9);
+    }
+    std::vector<SphericalCoord> points;
+    for (int i = 0; i < 203; ++i) {
+        points.push_back({0.5 + 0.02 * i, 0.01 * i, 0.03 * i, 1.0 + 0.01 * i});
+    }
+    
+    // Grouped batches match the per-point kernel for every field type
+    for (InterferenceFieldType type : {InterferenceFieldType::CONSTRUCTIVE, InterferenceFieldType::DESTRUCTIVE,
+                                       InterferenceFieldType::AMPLITUDE_MODULATED,
+                                       InterferenceFieldType::QUANTUM_ENTANGLED}) {
+        InterferenceField field(type, center, 5.0);
+        auto handles = field.addSourceFields(sources);
+        for (int round = 0; round < 2; ++round) {
+            auto grouped = field.calculateInterference(points, 0.017);
+            for (size_t i = 0; i < points.size(); ++i) {
+                std::complex<double> expected = field.calculateInterference(points[i], 0.017);
+                assert(std::abs(grouped[i] - expected) < 1e-10 * (1.0 + std::abs(expected)));
+            }
+            // Weight changes and removals keep the grouping consistent
+            field.setSourceAmplitude(handles[3], std::polar(2.0, 0.5));
+            field.removeSourceField(handles[10]);
+            field.removeSourceField(handles[0]);
+        }
+    }
+    
+    // Sources added one at a time, read in between and removed from the
+    // middle of their ladders are regrouped incrementally to the same result
+    {
+        InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, center, 5.0);
+        std::vector<InterferenceField::SourceHandle> handles;
+        for (size_t i = 0; i < sources.size(); ++i) {
+            handles.push_back(field.addSourceField(sources[i]));
+            if (i % 9 == 0) {
+                field.calculateInterference(points, 0.0);
+            }
+        }
+        for (size_t i = 2; i < handles.size(); i += 7) {
+            field.removeSourceField(handles[i]);
+        }
+        field.addSourceField(sources[2]);
+        auto grouped = field.calculateInterference(points, 0.0);
+        for (size_t i = 0; i < points.size(); ++i) {
+            std::complex<double> expected = field.calculateInterference(points[i], 0.0);
+            assert(std::abs(grouped[i] - expected) < 1e-10 * (1.0 + std::abs(expected)));
+        }
+    }
+    
+    // Every kernel table agrees with the scalar ladders and the plain sum
+    std::vector<double> lx = {0.5, -1.0, 2.0}, ly = {0.0, 0.7, -0.4}, lz = {1.0, 0.2, 0.3};
+    std::vector<double> k0 = {2.0, 5.5, 9.0}, step = {2.0, 0.0, 3.5};
+    std::vector<uint32_t> begin = {0, 6, 7, 10}, members = {4, 1, 7, 0, 9, 2, 3, 8, 5, 6};
+    std::vector<double> wr(10), wi(10), sx(10), sy(10), sz(10), sk(10);
+    for (size_t l = 0; l < 3; ++l) {
+        for (uint32_t m = begin[l]; m < begin[l + 1]; ++m) {
+            uint32_t s = members[m];
+            sx[s] = lx[l];
+            sy[s] = ly[l];
+            sz[s] = lz[l];
+            sk[s] = k0[l] + step[l] * (m - begin[l]);
+            wr[s] = 0.1 * (s + 1);
+            wi[s] = -0.05 * s;
+        }
+    }
+    InterferenceLadders ladders{lx.data(), ly.data(), lz.data(), k0.data(), step.data(), begin.data(),
+                                members.data(), 3};
+    InterferenceSources plain{sx.data(), sy.data(), sz.data(), sk.data(), wr.data(), wi.data(), 10};
+    std::vector<double> px, py, pz;
+    for (int i = 0; i < 21; ++i) {
+        px.push_back(0.3 * i - 2.0);
+        py.push_back(1.0 - 0.1 * i);
+        pz.push_back(0.05 * i * i);
+    }
+    for (SIMDLevel level : {SIMDLevel::SCALAR, SIMDLevel::AVX2, SIMDLevel::AVX512}) {
+        const InterferenceKernelTable& kernels = getInterferenceKernels(level);
+        std::vector<std::complex<double>> output(px.size());
+        kernels.accumulateLadders(ladders, wr.data(), wi.data(), px.data(), py.data(), pz.data(), px.size(),
+                                  output.data());
+        for (size_t i = 0; i < px.size(); ++i) {
+            std::complex<double> expected = getInterferenceKernels(SIMDLevel::SCALAR).accumulate(plain, px[i],
+                                                                                             py[i], pz[i]);
+            assert(std::abs(output[i] - expected) < 1e-12);
+        }
+    }
+    
+    std::cout << "✓ InterferenceField frequency ladders test passed" << std::endl;
+}
+
 void test_dome_acoustic_resonator() {
     std::cout << "Testing DomeAcousticResonator..." << std::endl;
     
@@ -59,9 +566,74 @@ void test_dome_acoustic_resonator() {
     double reverb_time = resonator.calculateReverbTime(440.0);
     assert(reverb_time > 0.0);
     
+    // Modal table: sorted, every (n, m) zero present, lowest mode is (1, 1, 0)
+    const auto& modes = resonator.getModes();
+    assert(modes.size() == frequencies.size() && modes.size() >= 40);
+    assert(std::is_sorted(frequencies.begin(), frequencies.end()));
+    assert(modes[0].n == 1 && modes[0].m == 1 && modes[0].q == 0);
+    assert(std::abs(modes[0].frequency - 343.0 * 1.8412 / (2.0 * M_PI * 3.0)) < 1e-9);
+    
+    // Reverb and absorption interpolate between material points off the band grid
+    resonator.setMaterialProperties({{250.0, 1.0}, {1000.0, 0.5}});
+    double base = resonator.calculateReverbTime(20.0);
+    assert(std::abs(resonator.calculateReverbTime(250.0) - base) < 1e-9);
+    assert(std::abs(resonator.calculateReverbTime(1000.0) - 0.5 * base) < 1e-9);
+    assert(std::abs(resonator.calculateReverbTime(500.0) - 0.75 * base) < 1e-9);
+    double between = resonator.calculateReverbTime(437.3);
+    assert(between < base && between > 0.75 * base);
+    assert(resonator.calculateReverbTime(15000.0) == resonator.calculateReverbTime(30000.0));
+    assert(std::abs(resonator.getAbsorption(1000.0) - 0.2) < 1e-9);
+    assert(std::abs(resonator.getAbsorption(250.0) - 0.1) < 1e-9);
+    assert(std::abs(DomeAcousticResonator::bandCenterFrequency(17) - 1000.0) < 1e-9);
+    
     std::cout << "✓ DomeAcousticResonator test passed" << std::endl;
 }
 
+void test_dome_geometry_optimization() {
+    std::cout << "Testing dome geometry optimization..." << std::endl;
+    
+    // Modal tables are memoized by geometry and shared between resonators
+    DomeAcousticResonator first(3.0, 2.0), second(3.0, 2.0);
+    assert(&first.getModes() == &second.getModes());
+    assert(DomeAcousticResonator::modalTable(3.0, 2.0).get() == &first.getModes());
+    assert(DomeAcousticResonator::modalTable(3.0, 2.5).get() != &first.getModes());
+    
+    // Targets taken from a known geometry score zero there; order is preserved
+    const auto& reference = DomeAcousticResonator::modalTable(4.0, 3.0);
+    std::vector<double> targets{(*reference)[0].frequency, (*reference)[3].frequency, (*reference)[7].frequency};
+    ThreadPool pool(3);
+    auto scores = DomeAcousticResonator::evaluateGeometries({{4.0, 3.0}, {2.0, 5.0}, {-1.0, 3.0}}, targets, pool);
+    assert(scores.size() == 3);
+    assert(scores[0].geometry.radius == 4.0 && scores[0].error < 1e-9);
+    assert(scores[1].error > 0.0 && std::isfinite(scores[1].error));
+    assert(std::isinf(scores[2].error));
+    
+    // The optimizer moves the dome toward the targets and applies the result
+    DomeAcousticResonator dome(3.0, 2.5);
+    double reverb_before = dome.calculateReverbTime(1000.0);
+    double error_before = DomeAcousticResonator::evaluateGeometries({{3.0, 2.5}}, targets, pool)[0].error;
+    DomeGeometryScore best = dome.optimizeFrequencyResponse(targets, pool);
+    assert(best.error < error_before && best.error < 0.5);
+    assert(dome.getRadius() == best.geometry.radius && dome.getHeight() == best.geometry.height);
+    assert(&dome.getModes() == DomeAcousticResonator::modalTable(best.geometry.radius, best.geometry.height).get());
+    assert(dome.calculateReverbTime(1000.0) != reverb_before);
+    
+    // A large design-space sweep
+    std::vector<DomeGeometry> sweep;
+    for (int i = 0; i < 100; ++i) {
+        for (int j = 0; j < 100; ++j) {
+            sweep.push_back({2.0 + 0.05 * i, 1.0 + 0.05 * j});
+        }
+    }
+    auto sweep_scores = DomeAcousticResonator::evaluateGeometries(sweep, targets);
+    assert(sweep_scores.size() == sweep.size());
+    auto best_sweep = std::min_element(sweep_scores.begin(), sweep_scores.end(),
+                                       [](const DomeGeometryScore& a, const DomeGeometryScore& b) { return a.error < b.error; });
+    assert(best_sweep->error < scores[1].error);
+    
+    std::cout << "✓ Dome geometry optimization test passed" << std::endl;
+}
+
 void test_anantasound_core() {
     std::cout << "Testing AnantaSoundCore..." << std::endl;
     
@@ -85,3 +657,706 @@ void test_anantasound_core() {
 }
 
 
+
+void test_spatial_field_index() {
+    std::cout << "Testing SpatialFieldIndex..." << std::endl;
+    
+    SpatialFieldIndex index(0.5);
+    std::vector<SphericalCoord> positions;
+    for (int i = 0; i < 400; ++i) {
+        SphericalCoord position(0.5 + 0.01 * i, 0.1 + 0.007 * i, 0.013 * i, 0.0, 0.005 * (i % 50));
+        positions.push_back(position);
+        
+        QuantumSoundField field;
+        field.frequency = 100.0 + i;
+        field.position = position;
+        index.insertOrAssign(field);
+    }
+    assert(index.size() == 400);
+    
+    // Same position replaces in place
+    QuantumSoundField replacement;
+    replacement.frequency = 999.0;
+    replacement.position = positions[7];
+    index.insertOrAssign(replacement);
+    assert(index.size() == 400);
+    assert(index.find(positions[7]) != SpatialFieldIndex::npos);
+    assert(index.get(index.find(positions[7])).frequency == 999.0);
+    
+    // Radius queries match a brute-force scan, before and after removals
+    auto check_radius = [&](const SphericalCoord& center, double radius) {
+        std::vector<size_t> found;
+        index.queryRadius(center, radius, found);
+        std::sort(found.begin(), found.end());
+        
+        CartesianPosition c = CartesianPosition::fromSpherical(center);
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < index.size(); ++i) {
+            CartesianPosition p = CartesianPosition::fromSpherical(index.get(i).position);
+            double d2 = (p.x - c.x) * (p.x - c.x) + (p.y - c.y) * (p.y - c.y) + (p.z - c.z) * (p.z - c.z);
+            if (d2 <= radius * radius) {
+                expected.push_back(i);
+            }
+        }
+        assert(found == expected);
+        return found.size();
+    };
+    
+    SphericalCoord center(2.0, 1.0, 1.5, 0.0, 0.1);
+    assert(check_radius(center, 0.6) > 0);
+    assert(check_radius(center, 100.0) == index.size());
+    
+    for (int i = 0; i < 400; i += 3) {
+        assert(index.erase(positions[i]));
+    }
+    assert(!index.erase(positions[0]));
+    assert(index.size() == 400 - 134);
+    assert(index.find(positions[1]) != SpatialFieldIndex::npos);
+    assert(index.find(positions[3]) == SpatialFieldIndex::npos);
+    for (size_t i = 0; i < index.size(); ++i) {
+        assert(index.find(index.get(i).position) == i);
+    }
+    check_radius(center, 0.6);
+    check_radius(center, 3.0);
+    
+    // The core stores one field per position and answers radius queries
+    AnantaSoundCore core(3.0, 2.0);
+    assert(core.initialize());
+    for (int i = 0; i < 10; ++i) {
+        core.processSoundField(core.createQuantumSoundField(432.0, positions[i], QuantumSoundState::COHERENT));
+    }
+    core.processSoundField(core.createQuantumSoundField(440.0, positions[0], QuantumSoundState::COHERENT));
+    assert(core.getOutputFields().size() == 10);
+    assert(core.getStatistics().active_fields == 10);
+    assert(core.getFieldsInRadius(positions[0], 1e-9).size() == 1);
+    assert(core.getFieldsInRadius(positions[0], 100.0).size() == 10);
+    
+    std::cout << "✓ SpatialFieldIndex test passed" << std::endl;
+}
+
+void test_field_buffer() {
+    std::cout << "Testing FieldBuffer..." << std::endl;
+    
+    std::vector<QuantumSoundField> fields(37);
+    const QuantumSoundState states[] = {QuantumSoundState::GROUND, QuantumSoundState::COHERENT,
+                                        QuantumSoundState::SUPERPOSITION, QuantumSoundState::ENTANGLED};
+    for (size_t i = 0; i < fields.size(); ++i) {
+        fields[i].amplitude = std::complex<double>(0.1 * i, -0.05 * i);
+        fields[i].phase = 0.3 * i;
+        fields[i].frequency = 400.0 + 2.0 * i;
+        fields[i].quantum_state = states[i % 4];
+        fields[i].position = SphericalCoord(1.0 + i, 0.1 * i, 0.2 * i, 0.5, 0.01 * i);
+    }
+    
+    // Lossless round trip through the SoA layout
+    FieldBuffer buffer(fields);
+    assert(buffer.size() == fields.size());
+    std::vector<QuantumSoundField> restored = buffer.toFields();
+    for (size_t i = 0; i < fields.size(); ++i) {
+        assert(restored[i].amplitude == fields[i].amplitude);
+        assert(restored[i].phase == fields[i].phase && restored[i].frequency == fields[i].frequency);
+        assert(restored[i].quantum_state == fields[i].quantum_state);
+        assert(restored[i].position.r == fields[i].position.r &&
+               restored[i].position.height == fields[i].position.height);
+        assert(restored[i].timestamp == fields[i].timestamp);
+    }
+    
+    // Reductions agree with the per-field loops
+    double magnitude_sum = 0.0;
+    size_t coherent = 0;
+    for (const auto& field : fields) {
+        magnitude_sum += std::abs(field.amplitude);
+        coherent += field.quantum_state == QuantumSoundState::COHERENT ||
+                    field.quantum_state == QuantumSoundState::SUPERPOSITION;
+    }
+    assert(std::abs(buffer.amplitudeMagnitudeSum() - magnitude_sum) < 1e-12);
+    assert(buffer.countStates({QuantumSoundState::COHERENT, QuantumSoundState::SUPERPOSITION}) == coherent);
+    assert(buffer.countStates({}) == 0);
+    
+    QRDIntegration qrd;
+    assert(std::abs(qrd.calculateResonanceStrength(buffer) - qrd.calculateResonanceStrength(fields)) < 1e-12);
+    ConsciousnessIntegration consciousness;
+    assert(std::abs(consciousness.calculateConsciousnessCoherence(buffer) -
+                    consciousness.calculateConsciousnessCoherence(fields)) < 1e-12);
+    
+    // Swap-remove keeps the arrays parallel
+    buffer.swapRemove(3);
+    assert(buffer.size() == fields.size() - 1);
+    assert(buffer.get(3).frequency == fields.back().frequency);
+    assert(buffer.get(3).position.r == fields.back().position.r);
+    
+    std::cout << "✓ FieldBuffer test passed" << std::endl;
+}
+
+void test_qrd_integration() {
+    std::cout << "Testing QRD resonance kernel and entanglement ring..." << std::endl;
+    
+    // Every compiled kernel matches the per-field formula, tails included
+    std::vector<double> frequency, phase, amplitude;
+    double reference = 0.0;
+    for (int i = 0; i < 203; ++i) {
+        frequency.push_back(300.0 + 1.7 * i);
+        phase.push_back(std::sin(0.37 * i) * 40.0);
+        amplitude.push_back(0.02 * (i % 70) - 0.3);
+        reference += (1.0 / (1.0 + std::abs(frequency.back() - 432.0) / 50.0) +
+                      std::cos(std::abs(phase.back() - 1.1)) +
+                      std::min(amplitude.back() / 0.8, 1.0)) / 3.0;
+    }
+    for (SIMDLevel level : {SIMDLevel::SCALAR, SIMDLevel::AVX2, SIMDLevel::AVX512}) {
+        double sum = getFeedbackKernels(level).resonanceSum(frequency.data(), phase.data(), amplitude.data(),
+                                                            frequency.size(), 432.0, 1.1, 0.8, 50.0);
+        assert(std::abs(sum - reference) < 1e-9);
+    }
+    
+    // Entangled fields stay bounded; the newest ones survive, oldest first
+    QRDIntegration qrd;
+    qrd.activateQRD(432.0, 1.0);
+    assert(qrd.getEntangledCapacity() == QRDIntegration::kDefaultEntangledCapacity);
+    qrd.setEntangledCapacity(5);
+    std::vector<QuantumSoundField> batch(2);
+    for (int round = 0; round < 10; ++round) {
+        batch[0].frequency = 400.0 + round;
+        batch[1].frequency = 5000.0;    // Too far from the resonance to entangle
+        qrd.createQuantumEntanglement(batch);
+    }
+    assert(qrd.getEntangledFieldCount() == 5);
+    auto entangled = qrd.getEntangledFields();
+    for (int i = 0; i < 5; ++i) {
+        assert(entangled[i].frequency == 405.0 + i);
+    }
+    qrd.setEntangledCapacity(2);
+    entangled = qrd.getEntangledFields();
+    assert(entangled.size() == 2 && entangled[0].frequency == 408.0 && entangled[1].frequency == 409.0);
+    assert(!entangled[0].hasSource() && entangled[1].strength > 0.7f);
+    
+    // Records refer to their sources by handle, expire with the window and
+    // are pruned once their source is gone
+    InterferenceField source_field(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord(0.0, 0.0, 0.0, 0.0), 5.0);
+    std::vector<QuantumSoundField> sources(3);
+    sources[0].frequency = 430.0;
+    sources[1].frequency = 440.0;
+    sources[2].frequency = 5000.0;
+    auto handles = source_field.addSourceFields(sources);
+    qrd.setEntangledCapacity(8);
+    qrd.createQuantumEntanglement(sources, handles);
+    entangled = qrd.getEntangledFields();
+    assert(entangled.size() == 4 && entangled[2].source == handles[0] && entangled[3].source == handles[1]);
+    assert(source_field.removeSourceField(handles[0]));
+    assert(qrd.pruneEntangledFields(source_field) == 1);
+    entangled = qrd.getEntangledFields();
+    assert(entangled.size() == 3 && entangled[2].source == handles[1] && entangled[0].frequency == 408.0);
+    qrd.createQuantumEntanglement(sources, {handles[1]});
+    assert(qrd.getEntangledFieldCount() == 3);
+    
+    qrd.setEntanglementWindow(std::chrono::seconds(10));
+    auto created = entangled[2].created;
+    assert(qrd.expireEntangledFields(created + std::chrono::seconds(5)) == 0);
+    assert(qrd.expireEntangledFields(created + std::chrono::seconds(11)) == 3);
+    assert(qrd.getEntangledFieldCount() == 0 && qrd.getEntangledFields().empty());
+    
+    // A long run stays within the capacity
+    qrd.setEntangledCapacity(4);
+    for (int round = 0; round < 1000; ++round) {
+        batch[0].frequency = 400.0 + round % 50;
+        qrd.createQuantumEntanglement(batch);
+    }
+    entangled = qrd.getEntangledFields();
+    assert(entangled.size() == 4 && entangled[3].frequency == 449.0);
+    qrd.setQuantumEntanglementEnabled(false);
+    assert(qrd.getEntangledFieldCount() == 0);
+    
+    // The FieldBuffer update path matches the vector one
+    FieldBuffer buffer;
+    std::vector<QuantumSoundField> fields(3);
+    for (size_t i = 0; i < fields.size(); ++i) {
+        fields[i].frequency = 430.0 + i;
+        fields[i].amplitude = std::complex<double>(0.5, 0.0);
+        buffer.push_back(fields[i]);
+    }
+    assert(std::abs(qrd.calculateResonanceStrength(buffer) - qrd.calculateResonanceStrength(fields)) < 1e-12);
+    qrd.updateQRDResonance(buffer);
+    assert(qrd.getQRDField().quantum_state == QuantumSoundState::ENTANGLED);
+    
+    std::cout << "✓ QRD resonance kernel and entanglement ring test passed" << std::endl;
+}
+
+void test_harmonic_bank() {
+    std::cout << "Testing HarmonicBank recurrences..." << std::endl;
+    
+    // Recurrences agree with the direct per-harmonic formulas
+    HarmonicSeries series;
+    series.frequency = 97.0;
+    series.amplitude = 0.8;
+    series.phase = 2.3;
+    series.phase_offset = -0.4;
+    series.envelope_width = 400.0;
+    const size_t count = 300;
+    std::vector<double> frequency(count), amplitude(count), phase(count);
+    std::vector<std::complex<double>> phasor(count);
+    HarmonicBank bank;
+    bank.generate(series, count, {frequency.data(), amplitude.data(), phase.data(), phasor.data()});
+    for (size_t i = 0; i < count; ++i) {
+        double h = static_cast<double>(i + 1);
+        double envelope = std::exp(-std::pow((h - 1.0) * series.frequency / series.envelope_width, 2));
+        assert(frequency[i] == h * series.frequency);
+        assert(std::abs(amplitude[i] - series.amplitude / h * envelope) < 1e-15);
+        assert(std::abs(phase[i] - (h * series.phase + series.phase_offset)) < 1e-12);
+        assert(std::abs(phasor[i] - std::polar(1.0, h * series.phase + series.phase_offset)) < 1e-12);
+    }
+    
+    // Wrapped phases stay in [-π, π] and match modulo 2π; renormalisation keeps |z| = 1
+    series.wrap_phase = true;
+    series.envelope_width = 0.0;
+    const size_t long_count = 100000;
+    std::vector<double> wrapped(long_count), flat(long_count);
+    std::vector<std::complex<double>> renormalized(long_count), drifting(long_count);
+    bank.generate(series, long_count, {nullptr, flat.data(), wrapped.data(), renormalized.data()});
+    HarmonicBank(0).generate(series, long_count, {nullptr, nullptr, nullptr, drifting.data()});
+    for (size_t i = 0; i < long_count; i += 997) {
+        double h = static_cast<double>(i + 1);
+        assert(std::abs(wrapped[i]) <= M_PI);
+        assert(std::abs(std::remainder(wrapped[i] - (h * series.phase + series.phase_offset), 2.0 * M_PI)) < 1e-9);
+        assert(flat[i] == series.amplitude / h);
+        assert(std::abs(std::abs(renormalized[i]) - 1.0) < 1e-14);
+    }
+    assert(std::abs(std::abs(drifting.back()) - 1.0) >= std::abs(std::abs(renormalized.back()) - 1.0));
+    
+    // QRD and consciousness spectra come from the bank
+    QRDIntegration qrd;
+    qrd.activateQRD(200.0, 2.0);
+    auto spectrum = qrd.getResonanceSpectrum();
+    assert(spectrum.size() == 10 && spectrum[0] == 2.0);
+    assert(std::abs(spectrum[1] - 1.0 * std::exp(-4.0)) < 1e-15);
+    auto fields = qrd.generateResonanceFields(SphericalCoord(1.0, 0.0, 0.0, 0.0), 5);
+    assert(fields.size() == 5 && fields[4].frequency == 1000.0 && fields[4].amplitude.real() == 0.4);
+    
+    std::cout << "✓ HarmonicBank recurrences test passed" << std::endl;
+}
+
+void test_snapshot_reads() {
+    std::cout << "Testing snapshot reads under concurrent writers..." << std::endl;
+    
+    // Readers always see a complete prefix of the sources added so far:
+    // with unit COHERENT sources at the listener, the field is the source count
+    SphericalCoord center{0.0, 0.0, 0.0, 0.0};
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, center, 5.0);
+    QuantumSoundField source;
+    source.amplitude = std::complex<double>(1.0, 0.0);
+    source.phase = 0.0;
+    source.frequency = 440.0;
+    source.quantum_state = QuantumSoundState::COHERENT;
+    source.position = center;
+    source.timestamp = std::chrono::high_resolution_clock::now();
+    
+    constexpr int kSources = 200;
+    std::atomic<bool> done{false};
+    std::atomic<bool> consistent{true};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            double previous = 0.0;
+            while (!done.load()) {
+                std::complex<double> value = field.calculateInterference(center, 0.0);
+                double count = value.real();
+                if (std::abs(value.imag()) > 1e-9 || std::abs(count - std::round(count)) > 1e-9 ||
+                    count < previous) {
+                    consistent = false;
+                }
+                previous = count;
+            }
+        });
+    }
+    for (int s = 0; s < kSources; ++s) {
+        field.addSourceField(source);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    assert(consistent.load());
+    assert(std::abs(field.calculateInterference(center, 0.0).real() - kSources) < 1e-9);
+    
+    // Core statistics and output fields come from the published snapshot;
+    // a batch is published at once, so readers never see it half-applied
+    AnantaSoundCore core(10.0, 5.0);
+    assert(core.initialize());
+    std::vector<QuantumSoundField> batch;
+    for (int i = 0; i < 50; ++i) {
+        batch.push_back(core.createQuantumSoundField(432.0, {1.0 + 0.1 * i, 0.3, 0.2, 1.0},
+                                                     QuantumSoundState::COHERENT));
+    }
+    
+    done = false;
+    std::thread stats_reader([&]() {
+        while (!done.load()) {
+            size_t active = core.getStatistics().active_fields;
+            size_t output = core.getOutputFields().size();
+            if ((active != 0 && active != 50) || (output != 0 && output != 50)) {
+                consistent = false;
+            }
+        }
+    });
+    core.processSoundFields(batch);
+    for (int step = 0; step < 20; ++step) {
+        core.update(0.02);
+    }
+    done = true;
+    stats_reader.join();
+    assert(consistent.load());
+    assert(core.getStatistics().active_fields == 50);
+    assert(core.getOutputFields().size() == 50);
+    
+    // Writers only mark the snapshot stale; the next reader sees the write
+    QuantumSoundField extra = core.createQuantumSoundField(500.0, {9.0, 0.1, 0.1, 1.0}, QuantumSoundState::COHERENT);
+    core.processSoundField(extra);
+    assert(core.getStatistics().active_fields == 51 && core.getOutputFields().size() == 51);
+    
+    // Steady state: ticks publish into pooled snapshots, and re-storing a
+    // resident field does not copy the field buffer
+    std::vector<QuantumSoundField> output;
+    for (int tick = 0; tick < 4; ++tick) {
+        core.update(0.016);
+        core.processSoundField(extra);
+        core.getOutputFields(output);
+        assert(core.getStatistics().active_fields == 51);
+    }
+    size_t before = TestSupport::allocationCount();
+    for (int tick = 0; tick < 16; ++tick) {
+        core.update(0.016);
+        core.processSoundField(extra);
+        core.getOutputFields(output);
+        assert(core.getStatistics().active_fields == 51);
+    }
+    assert(TestSupport::allocationCount() == before);
+    assert(output.size() == 51);
+    
+    // Interference writes are published once per tick into pooled snapshots:
+    // amplitude updates between ticks do not allocate either
+    auto handle = field.addSourceField(source);
+    for (int tick = 0; tick < 4; ++tick) {
+        field.setSourceAmplitude(handle, std::complex<double>(1.0, 0.0));
+        field.updateQuantumState(0.016);
+        field.calculateInterference(center, 0.0);
+    }
+    before = TestSupport::allocationCount();
+    for (int tick = 0; tick < 16; ++tick) {
+        field.setSourceAmplitude(handle, std::complex<double>(0.5 * tick, 0.0));
+        field.setSourceAmplitude(handle, std::complex<double>(1.0 * tick, 0.0));
+        field.updateQuantumState(0.016);
+        assert(std::abs(field.calculateInterference(center, 0.0).real() - (kSources + tick)) < 1e-9);
+    }
+    assert(TestSupport::allocationCount() == before);
+    
+    std::cout << "✓ Snapshot reads test passed" << std::endl;
+}
+
+void test_quantum_acoustic_processor() {
+    std::cout << "Testing QuantumAcousticProcessor worker..." << std::endl;
+    
+    auto waitFor = [](auto condition) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!condition() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        return condition();
+    };
+    
+    // A long tick does not delay publication of new submissions
+    QuantumAcousticProcessor processor(16, std::chrono::seconds(10), 1);
+    assert(processor.getTickInterval() == std::chrono::seconds(10));
+    assert(processor.getWorkerCount() == 1);
+    assert(processor.getProcessedSnapshots().front()->empty());
+    
+    QuantumSoundField field;
+    field.amplitude = std::complex<double>(1.0, 0.0);
+    field.phase = 0.3;
+    field.frequency = 432.0;
+    field.quantum_state = QuantumSoundState::COHERENT;
+    field.position = {1.0, 0.0, 0.0, 0.0};
+    field.timestamp = std::chrono::high_resolution_clock::now();
+    
+    auto start = std::chrono::steady_clock::now();
+    processor.addFields({field, field, field});
+    assert(waitFor([&]() { return processor.getProcessedSnapshots().front()->size() == 3; }));
+    assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+    
+    // Untouched until the tick: amplitude has not been rotated yet
+    auto snapshot = processor.getProcessedSnapshots().front();
+    assert(std::abs((*snapshot)[0].amplitude - std::complex<double>(1.0, 0.0)) < 1e-12);
+    
+    // A short tick rotates the amplitude by the phase every frame; a snapshot
+    // held by the reader stays intact while newer frames are published
+    processor.setTickInterval(std::chrono::milliseconds(1));
+    processor.addField(field);
+    assert(waitFor([&]() {
+        auto latest = processor.getProcessedSnapshots().front();
+        return latest->size() == 4 && std::abs(latest->front().amplitude - std::complex<double>(1.0, 0.0)) > 1e-6;
+    }));
+    assert(snapshot->size() == 3);
+    assert(std::abs((*snapshot)[0].amplitude - std::complex<double>(1.0, 0.0)) < 1e-12);
+    
+    // Paused processing still publishes submissions, without processing them
+    processor.setProcessingEnabled(false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    processor.addField(field);
+    assert(waitFor([&]() { return processor.getProcessedFields().size() == 5; }));
+    auto paused = processor.getProcessedFields();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto later = processor.getProcessedFields();
+    for (size_t i = 0; i < paused.size(); ++i) {
+        assert(paused[i].amplitude == later[i].amplitude);
+    }
+    assert(std::abs(later.back().amplitude - std::complex<double>(1.0, 0.0)) < 1e-12);
+    
+    std::cout << "✓ QuantumAcousticProcessor worker test passed" << std::endl;
+}
+
+void test_quantum_acoustic_processor_shards() {
+    std::cout << "Testing sharded QuantumAcousticProcessor..." << std::endl;
+    
+    auto waitForCount = [](const QuantumAcousticProcessor& processor, size_t count) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (processor.getProcessedFields().size() != count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        return processor.getProcessedFields().size() == count;
+    };
+    
+    QuantumSoundField field;
+    field.amplitude = std::complex<double>(1.0, 0.0);
+    field.phase = 0.0;
+    field.frequency = 432.0;
+    field.quantum_state = QuantumSoundState::COHERENT;
+    field.position = {1.0, 0.0, 0.0, 0.0};
+    field.timestamp = std::chrono::high_resolution_clock::now();
+    
+    // max_fields is split over the workers and enforced on submission
+    QuantumAcousticProcessor rejecting(10, std::chrono::milliseconds(1), 3);
+    assert(rejecting.getWorkerCount() == 3 && rejecting.getMaxFields() == 10);
+    std::vector<QuantumSoundField> batch(14, field);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i].frequency = 100.0 + i;
+    }
+    assert(rejecting.addFields(batch) == 10);
+    assert(!rejecting.addField(field));
+    assert(rejecting.getDroppedFieldsCount() == 5);
+    assert(waitForCount(rejecting, 10));
+    
+    // Every shard holds its own slice, and none exceeds the even split
+    auto snapshots = rejecting.getProcessedSnapshots();
+    assert(snapshots.size() == 3);
+    for (const auto& snapshot : snapshots) {
+        assert(snapshot->size() == 3 || snapshot->size() == 4);
+    }
+    std::vector<double> frequencies;
+    for (const auto& stored : rejecting.getProcessedFields()) {
+        frequencies.push_back(stored.frequency);
+    }
+    std::sort(frequencies.begin(), frequencies.end());
+    for (size_t i = 0; i < frequencies.size(); ++i) {
+        assert(frequencies[i] == 100.0 + i);
+    }
+    
+    // REPLACE_OLDEST keeps the store full with the newest fields
+    QuantumAcousticProcessor replacing(4, std::chrono::milliseconds(1), 2, FieldOverflowPolicy::REPLACE_OLDEST);
+    assert(replacing.getOverflowPolicy() == FieldOverflowPolicy::REPLACE_OLDEST);
+    for (size_t i = 0; i < 10; ++i) {
+        QuantumSoundField numbered = field;
+        numbered.frequency = 1000.0 + i;
+        assert(replacing.addField(numbered));
+    }
+    assert(replacing.getDroppedFieldsCount() == 6);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto stored = replacing.getProcessedFields();
+        if (stored.size() == 4 && std::all_of(stored.begin(), stored.end(),
+                [](const QuantumSoundField& f) { return f.frequency >= 1006.0; })) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    auto newest = replacing.getProcessedFields();
+    assert(newest.size() == 4);
+    for (const auto& stored : newest) {
+        assert(stored.frequency >= 1006.0);
+    }
+    
+    // Concurrent producers never overfill the store
+    QuantumAcousticProcessor shared(64, std::chrono::milliseconds(1), 4);
+    std::atomic<size_t> accepted{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&]() {
+            for (int i = 0; i < 50; ++i) {
+                if (shared.addField(field)) {
+                    ++accepted;
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    assert(accepted.load() == 64);
+    assert(shared.getDroppedFieldsCount() == 200 - 64);
+    assert(waitForCount(shared, 64));
+    
+    // Shards are tasks on the given pool: more shards than workers still
+    // all publish and tick
+    ThreadPool pool(1);
+    {
+        QuantumAcousticProcessor pooled(8, std::chrono::milliseconds(1), 4, FieldOverflowPolicy::REJECT_NEW, &pool);
+        QuantumSoundField rotating = field;
+        rotating.phase = 0.5;
+        assert(pooled.addFields(std::vector<QuantumSoundField>(8, rotating)) == 8);
+        auto ticked = [&]() {
+            for (const auto& snapshot : pooled.getProcessedSnapshots()) {
+                if (snapshot->size() != 2 || std::abs(snapshot->front().amplitude - field.amplitude) < 1e-6) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        auto tick_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!ticked() && std::chrono::steady_clock::now() < tick_deadline) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        assert(ticked());
+    }
+    
+    std::cout << "✓ Sharded QuantumAcousticProcessor test passed" << std::endl;
+}
+
+void test_core_update_time_base() {
+    std::cout << "Testing AnantaSoundCore update time base..." << std::endl;
+    
+    auto makeCore = []() {
+        auto core = std::make_unique<AnantaSoundCore>(10.0, 5.0);
+        assert(core->initialize());
+        core->setNoiseSeed(5);
+        std::vector<QuantumSoundField> fields;
+        for (int i = 0; i < 3000; ++i) {
+            fields.push_back(core->createQuantumSoundField(
+                432.0, {1.0 + 0.001 * i, 0.4, 0.3, 1.0}, QuantumSoundState::SUPERPOSITION));
+        }
+        core->processSoundFields(fields);
+        return core;
+    };
+    auto states = [](const AnantaSoundCore& core) {
+        std::vector<QuantumSoundState> result;
+        for (const auto& field : core.getOutputFields()) {
+            result.push_back(field.quantum_state);
+        }
+        return result;
+    };
+    
+    // One long update replays the same ticks as many short ones
+    auto stepped = makeCore();
+    for (int i = 0; i < 20; ++i) {
+        stepped->update(0.008);
+    }
+    auto catch_up = makeCore();
+    catch_up->update(0.16);
+    auto expected = states(*stepped);
+    assert(states(*catch_up) == expected);
+    
+    // About 1 - 0.95^10 of the superposed fields have decohered
+    size_t decohered = std::count(expected.begin(), expected.end(), QuantumSoundState::GROUND);
+    double fraction = static_cast<double>(decohered) / expected.size();
+    assert(std::abs(fraction - (1.0 - std::pow(0.95, 10))) < 0.05);
+    
+    // Sub-tick updates carry their remainder instead of dropping it
+    auto partial = makeCore();
+    partial->update(0.01);
+    assert(states(*partial) == states(*makeCore()));
+    partial->update(0.01);
+    assert(states(*partial) != states(*makeCore()));
+    
+    // The pooled update partitions the fields without changing the result
+    ThreadPool pool(3);
+    auto pooled = makeCore();
+    for (int i = 0; i < 4; ++i) {
+        pooled->update(0.04, pool);
+    }
+    assert(states(*pooled) == expected);
+    
+    std::cout << "✓ AnantaSoundCore update time base test passed" << std::endl;
+}
+
+void test_incremental_statistics() {
+    std::cout << "Testing incremental field statistics..." << std::endl;
+    
+    // Counters follow every kind of write and match a full rescan
+    auto rescan = [](const FieldBuffer& buffer, QuantumSoundState state, double& magnitude) {
+        size_t count = 0;
+        magnitude = 0.0;
+        for (const auto& field : buffer.toFields()) {
+            count += field.quantum_state == state;
+            magnitude += std::abs(field.amplitude);
+        }
+        return count;
+    };
+    
+    FieldBuffer buffer;
+    for (int i = 0; i < 20; ++i) {
+        QuantumSoundField field;
+        field.amplitude = std::complex<double>(0.1 * i, 0.2);
+        field.quantum_state = (i % 3 == 0) ? QuantumSoundState::SUPERPOSITION : QuantumSoundState::COHERENT;
+        buffer.push_back(field);
+    }
+    QuantumSoundField replacement;
+    replacement.amplitude = std::complex<double>(3.0, 4.0);
+    replacement.quantum_state = QuantumSoundState::EXCITED;
+    buffer.set(4, replacement);
+    buffer.setAmplitude(7, std::complex<double>(-1.0, 0.5));
+    buffer.setState(8, QuantumSoundState::ENTANGLED);
+    buffer.swapRemove(2);
+    buffer.swapRemove(buffer.size() - 1);
+    buffer.states()[0] = QuantumSoundState::GROUND;             // Was SUPERPOSITION
+    buffer.recordStateTransitions(QuantumSoundState::SUPERPOSITION, QuantumSoundState::GROUND, 1);
+    
+    for (size_t state = 0; state < kQuantumStateCount; ++state) {
+        double magnitude = 0.0;
+        size_t count = rescan(buffer, static_cast<QuantumSoundState>(state), magnitude);
+        assert(buffer.countState(static_cast<QuantumSoundState>(state)) == count);
+        assert(std::abs(buffer.amplitudeMagnitudeSum() - magnitude) < 1e-12);
+    }
+    assert(buffer.countStates({QuantumSoundState::COHERENT, QuantumSoundState::COHERENT}) ==
+           buffer.countState(QuantumSoundState::COHERENT));
+    
+    while (!buffer.empty()) {
+        buffer.swapRemove(0);
+    }
+    assert(buffer.amplitudeMagnitudeSum() == 0.0);
+    assert(buffer.countStates({QuantumSoundState::COHERENT, QuantumSoundState::SUPERPOSITION,
+                               QuantumSoundState::GROUND}) == 0);
+    
+    // Core statistics stay consistent with the fields through noise, replacement and decoherence
+    AnantaSoundCore core(10.0, 5.0);
+    assert(core.initialize());
+    core.setNoiseSeed(3);
+    for (int i = 0; i < 200; ++i) {
+        core.processSoundField(core.createQuantumSoundField(
+            432.0, {1.0 + 0.01 * (i % 150), 0.2, 0.1, 1.0},
+            i % 2 ? QuantumSoundState::SUPERPOSITION : QuantumSoundState::EXCITED));
+    }
+    core.update(0.5);
+    
+    auto fields = core.getOutputFields();
+    auto stats = core.getStatistics();
+    size_t coherent = 0, active = 0;
+    double energy = 0.0;
+    for (const auto& field : fields) {
+        coherent += field.quantum_state == QuantumSoundState::COHERENT ||
+                    field.quantum_state == QuantumSoundState::SUPERPOSITION;
+        active += field.quantum_state == QuantumSoundState::EXCITED ||
+                  field.quantum_state == QuantumSoundState::ENTANGLED;
+        energy += std::abs(field.amplitude);
+    }
+    assert(stats.active_fields == 150);
+    assert(std::abs(stats.coherence_ratio - static_cast<double>(coherent) / fields.size()) < 1e-12);
+    assert(std::abs(stats.energy_efficiency - energy / fields.size()) < 1e-9);
+    assert(stats.mechanical_devices_active == active);
+    
+    std::cout << "✓ Incremental field statistics test passed" << std::endl;
+}
@@ -0,0 +1,171 @@
+#include "async_task.hpp"
+#include "audio_analyzer.hpp"
+#include "anantasound_core.hpp"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_async_operations() {
+    std::cout << "Testing async operations..." << std::endl;
+
+    ThreadPool pool(3);
+    AsyncOptions options;
+    options.pool = &pool;
+
+    // A job's value, its progress and the callback's strictly rising fractions
+    std::mutex progress_mutex;
+    std::vector<double> fractions;
+    AsyncOptions tracked = options;
+    tracked.on_progress = [&](double fraction) {
+        std::lock_guard<std::mutex> lock(progress_mutex);
+        fractions.push_back(fraction);
+    };
+    auto sum = runAsync<int>([](AsyncControl& control) {
+        control.setTotal(4);
+        int total = 0;
+        for (int i = 1; i <= 4; ++i) {
+            total += i;
+            control.advance();
+        }
+        return total;
+    }, tracked);
+    assert(sum.get() == 10 && sum.getProgress() == 1.0);
+    assert((fractions == std::vector<double>{0.25, 0.5, 0.75, 1.0}));
+
+    // Cancellation stops a job at its next check; get() throws
+    std::atomic<bool> started{false};
+    auto endless = runAsync<int>([&](AsyncControl& control) {
+        started = true;
+        while (true) {
+            control.throwIfCancelled();
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        return 0;
+    }, options);
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+    assert(!endless.isReady());
+    endless.cancel();
+    assert(endless.waitFor(std::chrono::seconds(5)) && endless.isCancelled());
+    bool cancelled = false;
+    try {
+        endless.get();
+    } catch (const OperationCancelled&) {
+        cancelled = true;
+    }
+    assert(cancelled);
+
+    // Overlapped analysis: same frames as the blocking call
+    AudioAnalyzer analyzer(1024, 44100);
+    assert(analyzer.initialize());
+    analyzer.setHopSize(256);
+    std::vector<double> signal(44100 * 2);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        double t = static_cast<double>(i) / 44100.0;
+        signal[i] = 0.5 * std::sin(2.0 * M_PI * (200.0 + 900.0 * t) * t);
+    }
+    auto blocking = analyzer.analyzeAudioWithOverlap(signal, pool);
+    fractions.clear();
+    auto analysis = analyzer.analyzeAudioWithOverlapAsync(signal, tracked);
+    auto frames = analysis.get();
+    assert(frames.size() == blocking.size());
+    for (size_t f = 0; f < frames.size(); ++f) {
+        assert(frames[f].magnitude_spectrum == blocking[f].magnitude_spectrum);
+        assert(frames[f].tempo == blocking[f].tempo);
+    }
+    assert(fractions.size() > 2 && fractions.back() == 1.0);
+    for (size_t i = 1; i < fractions.size(); ++i) {
+        assert(fractions[i] > fractions[i - 1]);
+    }
+    std::vector<float> signal_f(signal.begin(), signal.end());
+    assert(analyzer.analyzeAudioWithOverlapAsync(signal_f, options).get().size() == blocking.size());
+
+    // A cancelled analysis stops before analyzing every frame
+    std::vector<double> long_signal(44100 * 60, 0.1);
+    AsyncOptions cancelling = options;
+    std::atomic<bool> halfway{false};
+    cancelling.on_progress = [&](double fraction) {
+        if (fraction > 0.05) {
+            halfway = true;
+        }
+    };
+    auto long_analysis = analyzer.analyzeAudioWithOverlapAsync(std::move(long_signal), cancelling);
+    while (!halfway.load() && !long_analysis.isReady()) {
+        std::this_thread::yield();
+    }
+    long_analysis.cancel();
+    cancelled = false;
+    try {
+        long_analysis.get();
+    } catch (const OperationCancelled&) {
+        cancelled = true;
+    }
+    assert(cancelled && long_analysis.getProgress() < 1.0);
+
+    // Dome optimization: same answer as the blocking search, geometry untouched
+    const auto& reference = DomeAcousticResonator::modalTable(4.0, 3.0);
+    std::vector<double> targets{(*reference)[0].frequency, (*reference)[3].frequency, (*reference)[7].frequency};
+    DomeAcousticResonator dome(3.0, 2.5), blocking_dome(3.0, 2.5);
+    auto optimization = dome.optimizeFrequencyResponseAsync(targets, options);
+    DomeGeometryScore expected = blocking_dome.optimizeFrequencyResponse(targets, pool);
+    DomeGeometryScore found = optimization.get();
+    assert(found.geometry.radius == expected.geometry.radius && found.geometry.height == expected.geometry.height);
+    assert(found.error == expected.error);
+    assert(dome.getRadius() == 3.0 && dome.getHeight() == 2.5);
+    dome.setGeometry(found.geometry.radius, found.geometry.height);
+
+    // Interference sweep over a dense dome grid matches the blocking map
+    SphericalCoord center{1.0, M_PI / 4, M_PI / 4, 1.0};
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, center, 5.0);
+    std::vector<QuantumSoundField> sources(24);
+    for (size_t s = 0; s < sources.size(); ++s) {
+        sources[s].amplitude = std::complex<double>(0.3 + 0.02 * s, 0.01 * s);
+        sources[s].frequency = 110.0 * (1 + s % 6);
+        sources[s].quantum_state = QuantumSoundState::COHERENT;
+        sources[s].position = {1.0 + 0.1 * s, 0.07 * s, 0.13 * s, 0.0};
+    }
+    field.addSourceFields(sources);
+    std::vector<SphericalCoord> grid;
+    for (int i = 0; i < 80; ++i) {
+        for (int j = 0; j < 60; ++j) {
+            grid.push_back({5.0, M_PI / 2 * i / 80.0, 2.0 * M_PI * j / 60.0, 0.0});
+        }
+    }
+    auto sweep = field.calculateInterferenceAsync(grid, 0.25, options);
+    auto expected_map = field.calculateInterference(grid, 0.25);
+    auto map = sweep.get();
+    assert(map.size() == expected_map.size());
+    for (size_t i = 0; i < map.size(); ++i) {
+        assert(std::abs(map[i] - expected_map[i]) < 1e-12);
+    }
+
+    // Background jobs leave a worker for latency-sensitive tasks
+    std::atomic<bool> release{false};
+    std::vector<AsyncResult<int>> blockers;
+    for (int i = 0; i < 4; ++i) {
+        blockers.push_back(runAsync<int>([&](AsyncControl&) {
+            while (!release.load()) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            return 1;
+        }, options));
+    }
+    AsyncOptions urgent = options;
+    urgent.priority = TaskPriority::HIGH;
+    assert(runAsync<int>([](AsyncControl&) { return 7; }, urgent).get() == 7);
+    release = true;
+    for (auto& blocker : blockers) {
+        assert(blocker.get() == 1);
+    }
+
+    std::cout << "✓ Async operations test passed (" << frames.size() << " frames, "
+              << map.size() << " sweep points)" << std::endl;
+}
@@ -0,0 +1,363 @@
+#include "audio_analyzer.hpp"
+#include "breathing_analyzer.hpp"
+#include "adaptive_audio_processor.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_audio_analyzer_spectrum() {
+    std::cout << "Testing AudioAnalyzer spectrum..." << std::endl;
+    
+    AudioAnalyzer analyzer(1024, 44100);
+    assert(analyzer.initialize());
+    
+    // 1 kHz tone centred on a bin
+    double bin_width = 44100.0 / 1024.0;
+    double tone = 23.0 * bin_width;
+    std::vector<double> signal(1024);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 0.5 * std::sin(2.0 * M_PI * tone * i / 44100.0);
+    }
+    
+    auto result = analyzer.analyzeAudio(signal);
+    assert(result.magnitude_spectrum.size() == 513);
+    assert(result.phase_spectrum.size() == 513);
+    assert(result.frequency_spectrum.size() == 513);
+    assert(std::abs(result.fundamental_frequency - tone) < 0.01);
+    assert(std::abs(result.frequency_spectrum[23] - tone) < 1e-6);
+    assert(result.volume_level > 0.3 && result.volume_level < 0.4);
+    
+    AudioAnalyzer invalid(1000, 44100);
+    assert(!invalid.initialize());
+    assert(invalid.analyzeAudio(signal).magnitude_spectrum.empty());
+    
+    std::cout << "✓ AudioAnalyzer spectrum test passed" << std::endl;
+}
+
+void test_audio_analyzer_pitch() {
+    std::cout << "Testing AudioAnalyzer pitch detection..." << std::endl;
+    
+    AudioAnalyzer analyzer(1024, 44100);
+    assert(analyzer.initialize());
+    AudioAnalysisResult result;
+    AudioAnalysisResultF result_f;
+    std::vector<double> signal(1024);
+    std::vector<float> signal_f(1024);
+    
+    // Off-bin tones (bins are 43 Hz wide) and a tone whose second and third
+    // harmonics are louder than the fundamental
+    for (double pitch : {100.0, 123.4, 220.7, 440.0, 990.5}) {
+        for (bool harmonics : {false, true}) {
+            for (size_t i = 0; i < signal.size(); ++i) {
+                double phase = 2.0 * M_PI * pitch * i / 44100.0;
+                signal[i] = harmonics ? 0.2 * std::sin(phase) + 0.5 * std::sin(2.0 * phase) + 0.4 * std::sin(3.0 * phase)
+                                      : 0.5 * std::sin(phase);
+                signal_f[i] = static_cast<float>(signal[i]);
+            }
+            analyzer.analyzeAudio(signal.data(), signal.size(), result);
+            analyzer.analyzeAudio(signal_f.data(), signal_f.size(), result_f);
+            assert(std::abs(result.fundamental_frequency - pitch) < 0.05);
+            assert(std::abs(result_f.fundamental_frequency - pitch) < 0.05);
+        }
+    }
+    
+    // Noise is not periodic: the spectral peak is reported instead
+    uint32_t state = 12345;
+    for (double& sample : signal) {
+        state = state * 1664525u + 1013904223u;
+        sample = static_cast<double>(state >> 8) / static_cast<double>(1u << 24) - 0.5;
+    }
+    analyzer.analyzeAudio(signal.data(), signal.size(), result);
+    double bin_width = 44100.0 / 1024.0;
+    double bins = result.fundamental_frequency / bin_width;
+    assert(std::abs(bins - std::round(bins)) < 1e-9);
+    
+    std::cout << "✓ AudioAnalyzer pitch detection test passed" << std::endl;
+}
+
+void test_spectral_kernels_dispatch() {
+    std::cout << "Testing spectral kernel dispatch..." << std::endl;
+    
+    const auto& scalar = getSpectralKernels(SIMDLevel::SCALAR);
+    
+    // Odd sizes exercise the vector tails; bin 37 and 90 share the peak
+    for (size_t count : {0u, 1u, 3u, 7u, 16u, 129u, 513u}) {
+        std::vector<std::complex<double>> bins(count);
+        std::vector<double> samples(count);
+        for (size_t k = 0; k < count; ++k) {
+            bins[k] = std::complex<double>(std::sin(0.1 * k), std::cos(0.7 * k));
+            samples[k] = std::sin(0.9 * k) - 0.1;
+        }
+        if (count > 90) {
+            bins[37] = bins[90] = std::complex<double>(3.0, 4.0);
+        }
+        
+        std::vector<double> expected(count);
+        SpectralMoments expected_moments;
+        scalar.magnitude_moments(bins.data(), count, expected.data(), expected_moments);
+        double expected_squares = scalar.sum_of_squares(samples.data(), count);
+        size_t expected_crossings = scalar.zero_crossings(samples.data(), count);
+        
+        for (SIMDLevel level : {SIMDLevel::AVX2, SIMDLevel::AVX512, SIMDLevel::NEON}) {
+            const auto& kernels = getSpectralKernels(level);
+            assert(kernels.level == level || !isSIMDLevelSupported(level));
+            
+            std::vector<double> magnitude(count);
+            SpectralMoments moments;
+            kernels.magnitude_moments(bins.data(), count, magnitude.data(), moments);
+            for (size_t k = 0; k < count; ++k) {
+                assert(std::abs(magnitude[k] - expected[k]) < 1e-12);
+            }
+            assert(std::abs(moments.magnitude_sum - expected_moments.magnitude_sum) < 1e-9);
+            assert(std::abs(moments.weighted_sum - expected_moments.weighted_sum) < 1e-7);
+            assert(moments.peak_bin == expected_moments.peak_bin);
+            assert(std::abs(kernels.sum_of_squares(samples.data(), count) - expected_squares) < 1e-9);
+            assert(kernels.zero_crossings(samples.data(), count) == expected_crossings);
+        }
+        if (count > 90) {
+            assert(expected_moments.peak_bin == 37);
+        }
+    }
+    
+    std::cout << "✓ Spectral kernel dispatch test passed (" << getSpectralKernels().name << ")" << std::endl;
+}
+
+void test_audio_analyzer_zero_allocation() {
+    std::cout << "Testing AudioAnalyzer zero-allocation overload..." << std::endl;
+    
+    AudioAnalyzer analyzer(1024, 44100);
+    assert(analyzer.initialize());
+    
+    std::vector<double> signal(1024);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 0.4 * std::sin(2.0 * M_PI * 440.0 * i / 44100.0);
+    }
+    
+    // The first call sizes the result buffers
+    AudioAnalysisResult reuse;
+    analyzer.analyzeAudio(signal.data(), signal.size(), reuse);
+    AudioAnalysisResult reference = analyzer.analyzeAudio(signal);
+    
+    size_t before = TestSupport::allocationCount();
+    for (int frame = 0; frame < 100; ++frame) {
+        analyzer.analyzeAudio(signal.data(), signal.size(), reuse);
+    }
+    size_t allocations = TestSupport::allocationCount() - before;
+    assert(allocations == 0);
+    
+    assert(reuse.magnitude_spectrum == reference.magnitude_spectrum);
+    assert(reuse.frequency_spectrum == reference.frequency_spectrum);
+    assert(reuse.fundamental_frequency == reference.fundamental_frequency);
+    assert(reuse.volume_level == reference.volume_level);
+    
+    // Shorter frames are zero padded and keep the same bin layout
+    analyzer.analyzeAudio(signal.data(), 300, reuse);
+    assert(reuse.magnitude_spectrum.size() == 513);
+    
+    std::cout << "✓ AudioAnalyzer zero-allocation test passed" << std::endl;
+}
+
+void test_audio_analyzer_parallel_overlap() {
+    std::cout << "Testing AudioAnalyzer parallel overlap..." << std::endl;
+    
+    AudioAnalyzer analyzer(1024, 44100);
+    assert(analyzer.initialize());
+    analyzer.setHopSize(256);
+    
+    std::vector<double> signal(44100);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        double t = static_cast<double>(i) / 44100.0;
+        // Sweep so every frame has a different spectrum
+        signal[i] = 0.5 * std::sin(2.0 * M_PI * (200.0 + 1800.0 * t) * t);
+    }
+    
+    auto serial = analyzer.analyzeAudioWithOverlap(signal);
+    
+    ThreadPool pool(4);
+    auto parallel = analyzer.analyzeAudioWithOverlap(signal, pool);
+    
+    assert(parallel.size() == serial.size());
+    assert(serial.size() == (signal.size() - 1024) / 256 + 1);
+    for (size_t f = 0; f < serial.size(); ++f) {
+        assert(parallel[f].magnitude_spectrum == serial[f].magnitude_spectrum);
+        assert(parallel[f].phase_spectrum == serial[f].phase_spectrum);
+        assert(parallel[f].fundamental_frequency == serial[f].fundamental_frequency);
+        assert(parallel[f].spectral_centroid == serial[f].spectral_centroid);
+        assert(parallel[f].volume_level == serial[f].volume_level);
+    }
+    
+    // Short input falls back to a single zero-padded frame
+    std::vector<double> short_signal(signal.begin(), signal.begin() + 300);
+    assert(analyzer.analyzeAudioWithOverlap(short_signal, pool).size() == 1);
+    
+    std::cout << "✓ AudioAnalyzer parallel overlap test passed" << std::endl;
+}
+
+void test_audio_analyzer_feature_mask() {
+    std::cout << "Testing AudioAnalyzer feature mask..." << std::endl;
+    
+    AudioAnalyzer analyzer(1024, 44100);
+    assert(analyzer.initialize());
+    assert(analyzer.getFeatures() == AnalysisFeature::ALL);
+    
+    std::vector<double> signal(4096);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 0.5 * std::sin(2.0 * M_PI * 440.0 * i / 44100.0) + 0.1 * std::sin(0.37 * i);
+    }
+    AudioAnalysisResult full = analyzer.analyzeAudio(signal);
+    
+    // Volume and centroid only: no phases, axis or pitch, same values
+    analyzer.setFeatures(AnalysisFeature::VOLUME | AnalysisFeature::SPECTRAL_SHAPE);
+    AudioAnalysisResult reduced = analyzer.analyzeAudio(signal);
+    assert(reduced.phase_spectrum.empty() && reduced.frequency_spectrum.empty());
+    assert(reduced.magnitude_spectrum == full.magnitude_spectrum);
+    assert(reduced.volume_level == full.volume_level);
+    assert(reduced.spectral_centroid == full.spectral_centroid);
+    assert(reduced.zero_crossing_rate == 0.0);
+    
+    // Time-domain features alone skip the FFT entirely
+    analyzer.setFeatures(AnalysisFeature::VOLUME | AnalysisFeature::ZERO_CROSSINGS);
+    reduced = analyzer.analyzeAudio(signal);
+    assert(reduced.magnitude_spectrum.empty() && reduced.spectral_centroid == 0.0);
+    assert(reduced.zero_crossing_rate == full.zero_crossing_rate);
+    
+    // Pitch without the spectrum still finds the YIN fundamental
+    analyzer.setFeatures(AnalysisFeature::PITCH);
+    reduced = analyzer.analyzeAudio(signal);
+    assert(reduced.fundamental_frequency == full.fundamental_frequency);
+    
+    // Overlap analysis tracks tempo only when asked; SCALAR keeps it
+    analyzer.setFeatures(AnalysisFeature::SCALAR);
+    auto frames = analyzer.analyzeAudioWithOverlap(signal);
+    analyzer.setFeatures(AnalysisFeature::ALL);
+    auto full_frames = analyzer.analyzeAudioWithOverlap(signal);
+    assert(frames.size() == full_frames.size());
+    for (size_t f = 0; f < frames.size(); ++f) {
+        assert(frames[f].tempo == full_frames[f].tempo && frames[f].phase_spectrum.empty());
+    }
+    analyzer.setFeatures(AnalysisFeature::VOLUME);
+    frames = analyzer.analyzeAudioWithOverlap(signal);
+    assert(frames.back().tempo == 0.0 && frames.back().magnitude_spectrum.empty());
+    
+    std::cout << "✓ AudioAnalyzer feature mask test passed" << std::endl;
+}
+
+void test_spectral_kernels_float() {
+    std::cout << "Testing float spectral kernels..." << std::endl;
+    
+    const auto& scalar = getSpectralKernelsF(SIMDLevel::SCALAR);
+    
+    // Sizes around the 4 / 8 / 16 lane widths of the float kernels
+    for (size_t count : {0u, 1u, 5u, 15u, 17u, 33u, 513u}) {
+        std::vector<std::complex<float>> bins(count);
+        std::vector<float> samples(count);
+        for (size_t k = 0; k < count; ++k) {
+            bins[k] = std::complex<float>(std::sin(0.1f * k), std::cos(0.7f * k));
+            samples[k] = std::sin(0.9f * k) - 0.1f;
+        }
+        if (count > 90) {
+            bins[37] = bins[90] = std::complex<float>(3.0f, 4.0f);
+        }
+        
+        std::vector<float> expected(count);
+        SpectralMoments expected_moments;
+        scalar.magnitude_moments(bins.data(), count, expected.data(), expected_moments);
+        double expected_squares = scalar.sum_of_squares(samples.data(), count);
+        size_t expected_crossings = scalar.zero_crossings(samples.data(), count);
+        
+        for (SIMDLevel level : {SIMDLevel::AVX2, SIMDLevel::AVX512, SIMDLevel::NEON}) {
+            const auto& kernels = getSpectralKernelsF(level);
+            assert(kernels.level == level || !isSIMDLevelSupported(level));
+            
+            std::vector<float> magnitude(count);
+            SpectralMoments moments;
+            kernels.magnitude_moments(bins.data(), count, magnitude.data(), moments);
+            for (size_t k = 0; k < count; ++k) {
+                assert(std::abs(magnitude[k] - expected[k]) < 1e-6f);
+            }
+            assert(std::abs(moments.magnitude_sum - expected_moments.magnitude_sum) < 1e-3);
+            assert(std::abs(moments.weighted_sum - expected_moments.weighted_sum) < 1.0);
+            assert(moments.peak_bin == expected_moments.peak_bin);
+            assert(std::abs(kernels.sum_of_squares(samples.data(), count) - expected_squares) < 1e-9);
+            assert(kernels.zero_crossings(samples.data(), count) == expected_crossings);
+        }
+        if (count > 90) {
+            assert(expected_moments.peak_bin == 37);
+        }
+    }
+    
+    std::cout << "✓ Float spectral kernels test passed (" << getSpectralKernelsF().name << ")" << std::endl;
+}
+
+void test_audio_analyzer_float_path() {
+    std::cout << "Testing AudioAnalyzer float path..." << std::endl;
+    
+    AudioAnalyzer analyzer(1024, 44100);
+    assert(analyzer.initialize());
+    analyzer.setHopSize(256);
+    
+    std::vector<double> signal(8192);
+    std::vector<float> signal_f(signal.size());
+    for (size_t i = 0; i < signal.size(); ++i) {
+        double t = static_cast<double>(i) / 44100.0;
+        signal[i] = 0.4 * std::sin(2.0 * M_PI * 440.0 * t) + 0.2 * std::sin(2.0 * M_PI * 3100.0 * t);
+        signal_f[i] = static_cast<float>(signal[i]);
+    }
+    
+    // Single precision tracks the double reference closely
+    AudioAnalysisResult reference = analyzer.analyzeAudio(signal);
+    AudioAnalysisResultF result = analyzer.analyzeAudio(signal_f);
+    assert(result.magnitude_spectrum.size() == reference.magnitude_spectrum.size());
+    for (size_t k = 0; k < reference.magnitude_spectrum.size(); ++k) {
+        assert(std::abs(result.magnitude_spectrum[k] - reference.magnitude_spectrum[k]) < 1e-3);
+    }
+    assert(std::abs(result.fundamental_frequency - reference.fundamental_frequency) < 0.01);
+    assert(std::abs(result.spectral_centroid - reference.spectral_centroid) < 0.5);
+    assert(std::abs(result.volume_level - reference.volume_level) < 1e-6);
+    assert(result.zero_crossing_rate == reference.zero_crossing_rate);
+    
+    // Float overlap: serial and pooled runs agree exactly
+    ThreadPool pool(2);
+    auto serial = analyzer.analyzeAudioWithOverlap(signal_f);
+    auto parallel = analyzer.analyzeAudioWithOverlap(signal_f, pool);
+    assert(serial.size() == (signal.size() - 1024) / 256 + 1);
+    assert(parallel.size() == serial.size());
+    for (size_t f = 0; f < serial.size(); ++f) {
+        assert(parallel[f].magnitude_spectrum == serial[f].magnitude_spectrum);
+    }
+    
+    // The reusable float overload does not allocate once sized
+    AudioAnalysisResultF reuse;
+    analyzer.analyzeAudio(signal_f.data(), 1024, reuse);
+    size_t before = TestSupport::allocationCount();
+    analyzer.analyzeAudio(signal_f.data() + 512, 1024, reuse);
+    assert(TestSupport::allocationCount() == before);
+    
+    // Breathing and adaptive processing classify float input like double
+    BreathingAnalyzer breathing(1024, 44100);
+    BreathingAnalyzer breathing_f(1024, 44100);
+    assert(breathing.initialize() && breathing_f.initialize());
+    BreathingAnalysisResult breath = breathing.analyzeBreathing(signal);
+    BreathingAnalysisResult breath_f = breathing_f.analyzeBreathing(signal_f);
+    assert(breath_f.current_state == breath.current_state);
+    assert(std::abs(breath_f.breathing_rate - breath.breathing_rate) < 1e-6);
+    assert(std::abs(breath_f.breathing_depth - breath.breathing_depth) < 1e-5);
+    
+    AdaptiveAudioProcessor processor(1024, 44100);
+    AdaptiveAudioProcessor processor_f(1024, 44100);
+    assert(processor.initialize() && processor_f.initialize());
+    AdaptationResult adapted = processor.processAudio(signal);
+    AdaptationResultF adapted_f = processor_f.processAudio(signal_f);
+    assert(adapted_f.detected_emotion == adapted.detected_emotion);
+    assert(adapted_f.processed_audio.size() == adapted.processed_audio.size());
+    // The recursive shelf filters accumulate float rounding
+    for (size_t i = 0; i < adapted.processed_audio.size(); ++i) {
+        assert(std::abs(adapted_f.processed_audio[i] - adapted.processed_audio[i]) < 1e-4);
+    }
+    
+    std::cout << "✓ AudioAnalyzer float path test passed" << std::endl;
+}
@@ -0,0 +1,193 @@
+#include "audio_buffer.hpp"
+#include "audio_analyzer.hpp"
+#include "effects_chain.hpp"
+#include "envelope_decimator.hpp"
+#include "breathing_analyzer.hpp"
+#include "adaptive_audio_processor.hpp"
+#include "thread_pool.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+std::vector<double> toneSignal(size_t count, double frequency, double amplitude) {
+    std::vector<double> signal(count);
+    for (size_t i = 0; i < count; ++i) {
+        signal[i] = amplitude * std::sin(2.0 * M_PI * frequency * i / 44100.0);
+    }
+    return signal;
+}
+
+// Two independent channels packed into a buffer of the given layout
+AudioBuffer stereoBuffer(const std::vector<double>& left, const std::vector<double>& right, ChannelLayout layout) {
+    AudioBuffer buffer(2, left.size(), layout);
+    for (size_t frame = 0; frame < left.size(); ++frame) {
+        buffer.at(frame, 0) = left[frame];
+        buffer.at(frame, 1) = right[frame];
+    }
+    return buffer;
+}
+
+double maxChannelError(const AudioBuffer& buffer, size_t channel, const std::vector<double>& expected) {
+    double error = 0.0;
+    for (size_t frame = 0; frame < expected.size(); ++frame) {
+        error = std::max(error, std::abs(buffer.at(frame, channel) - expected[frame]));
+    }
+    return error;
+}
+
+AdaptationParameters stereoParameters() {
+    AdaptationParameters parameters;
+    parameters.volume_multiplier = 1.5;
+    parameters.tempo_multiplier = 1.25;
+    parameters.bass_boost = 0.4;
+    parameters.treble_boost = 0.3;
+    parameters.reverb_amount = 0.5;
+    parameters.echo_delay = 0.01;
+    return parameters;
+}
+
+} // namespace
+
+void test_multichannel_processing() {
+    std::cout << "Testing multichannel buffers and processing..." << std::endl;
+
+    const size_t frames = 4096;
+    std::vector<double> left = toneSignal(frames, 440.0, 0.5);
+    std::vector<double> right = toneSignal(frames, 2500.0, 0.3);
+
+    // Layout conversion round-trips and keeps (frame, channel) addressing
+    AudioBuffer interleaved = stereoBuffer(left, right, ChannelLayout::INTERLEAVED);
+    AudioBuffer planar = interleaved;
+    planar.setLayout(ChannelLayout::PLANAR);
+    assert(!planar.isInterleaved() && planar.getChannelStride() == frames);
+    assert(planar.data()[frames] == right[0] && planar.data()[1] == left[1]);
+    for (size_t frame = 0; frame < frames; frame += 97) {
+        assert(planar.at(frame, 0) == left[frame] && planar.at(frame, 1) == right[frame]);
+    }
+    planar.setLayout(ChannelLayout::INTERLEAVED);
+    assert(planar.samples() == interleaved.samples());
+    planar.setLayout(ChannelLayout::PLANAR);
+
+    std::vector<double> mono;
+    interleaved.mixdown(mono);
+    assert(mono.size() == frames);
+    assert(std::abs(mono[123] - 0.5 * (left[123] + right[123])) < 1e-15);
+
+    // Each lane of a stereo chain matches a mono chain fed that channel alone,
+    // in either layout (the tempo stage changes the frame count)
+    EffectsChain left_chain(44100);
+    EffectsChain right_chain(44100);
+    left_chain.setParameters(stereoParameters());
+    right_chain.setParameters(stereoParameters());
+    std::vector<double> left_out;
+    std::vector<double> right_out;
+    left_chain.process(left.data(), left.size(), left_out);
+    right_chain.process(right.data(), right.size(), right_out);
+
+    EffectsChain stereo_chain(44100, 2);
+    stereo_chain.setParameters(stereoParameters());
+    AudioBuffer stereo_out;
+    stereo_chain.process(interleaved, stereo_out);
+    assert(stereo_out.getChannelCount() == 2 && stereo_out.isInterleaved());
+    assert(stereo_out.getFrameCount() == left_out.size());
+    assert(maxChannelError(stereo_out, 0, left_out) < 1e-12);
+    assert(maxChannelError(stereo_out, 1, right_out) < 1e-12);
+
+    EffectsChain planar_chain(44100);
+    planar_chain.setParameters(stereoParameters());
+    AudioBuffer planar_out;
+    planar_chain.process(planar, planar_out);
+    assert(planar_chain.getChannelCount() == 2 && !planar_out.isInterleaved());
+    assert(planar_out.getFrameCount() == left_out.size());
+    assert(maxChannelError(planar_out, 0, left_out) < 1e-12);
+    assert(maxChannelError(planar_out, 1, right_out) < 1e-12);
+
+    // Per-channel analysis matches mono analysis; mid/side of identical
+    // channels leaves a silent side
+    AudioAnalyzer analyzer(1024, 44100);
+    assert(analyzer.initialize());
+    AudioAnalysisResult expected_left;
+    AudioAnalysisResult expected_right;
+    analyzer.analyzeAudio(left.data(), 1024, expected_left);
+    analyzer.analyzeAudio(right.data(), 1024, expected_right);
+
+    std::vector<AudioAnalysisResult> results;
+    analyzer.analyzeChannels(planar, results);
+    assert(results.size() == 2);
+    assert(results[0].magnitude_spectrum == expected_left.magnitude_spectrum);
+    assert(results[1].magnitude_spectrum == expected_right.magnitude_spectrum);
+    assert(results[0].spectral_centroid == expected_left.spectral_centroid);
+
+    ThreadPool pool(2);
+    std::vector<AudioAnalysisResult> pooled;
+    analyzer.analyzeChannels(interleaved, pooled, pool);
+    assert(pooled.size() == 2);
+    assert(pooled[1].magnitude_spectrum == expected_right.magnitude_spectrum);
+
+    AudioBuffer doubled = stereoBuffer(left, left, ChannelLayout::INTERLEAVED);
+    analyzer.analyzeChannels(doubled, results, ChannelAnalysis::MID_SIDE);
+    assert(results.size() == 2);
+    assert(results[0].magnitude_spectrum == expected_left.magnitude_spectrum);
+    assert(results[1].volume_level == 0.0);
+
+    // Envelope and breathing of identical channels equal those of one channel
+    EnvelopeDecimator mono_envelope(44100, 25.0);
+    EnvelopeDecimator stereo_envelope(44100, 25.0);
+    std::vector<double> expected_envelope;
+    std::vector<double> envelope;
+    mono_envelope.process(left.data(), left.size(), expected_envelope);
+    stereo_envelope.process(doubled, envelope);
+    assert(envelope.size() == expected_envelope.size() && !envelope.empty());
+    for (size_t i = 0; i < envelope.size(); ++i) {
+        assert(std::abs(envelope[i] - expected_envelope[i]) < 1e-12);
+    }
+
+    BreathingAnalyzer mono_breathing(1024, 44100);
+    BreathingAnalyzer stereo_breathing(1024, 44100);
+    assert(mono_breathing.initialize() && stereo_breathing.initialize());
+    BreathingAnalysisResult expected_breath = mono_breathing.analyzeBreathing(left);
+    BreathingAnalysisResult breath = stereo_breathing.analyzeBreathing(doubled);
+    assert(std::abs(breath.breathing_depth - expected_breath.breathing_depth) < 1e-9);
+    assert(breath.current_state == expected_breath.current_state);
+
+    // The adaptive processor classifies the mixdown and returns every channel
+    AdaptiveAudioProcessor processor(1024, 44100);
+    assert(processor.initialize());
+    AudioBuffer adapted;
+    AdaptationResult adaptation = processor.processAudio(planar, adapted);
+    assert(adaptation.detected_emotion != EmotionalState::UNKNOWN);
+    assert(adaptation.processed_audio.empty());
+    assert(adapted.getChannelCount() == 2 && !adapted.isInterleaved() && adapted.getFrameCount() > 0);
+
+    // Interleaved real-time blocks neither allocate nor mismatch the prepared width
+    std::vector<float> block(256 * 2);
+    for (size_t frame = 0; frame < 256; ++frame) {
+        block[2 * frame] = static_cast<float>(left[frame]);
+        block[2 * frame + 1] = static_cast<float>(right[frame]);
+    }
+    std::vector<float> output(block.size());
+    assert(processor.prepareRealtime(2));
+    size_t before = TestSupport::allocationCount();
+    {
+        TestSupport::AllocationTrap trap;
+        for (int i = 0; i < 16; ++i) {
+            RealtimeAdaptation result = processor.processRealtime(block.data(), output.data(), 256, 2);
+            assert(result.detected_emotion != EmotionalState::UNKNOWN);
+        }
+    }
+    assert(TestSupport::allocationCount() == before);
+
+    RealtimeAdaptation skipped = processor.processRealtime(block.data(), output.data(), 128, 4);
+    assert(skipped.detected_emotion == EmotionalState::UNKNOWN);
+    assert(std::equal(output.begin(), output.end(), block.begin()));
+
+    std::cout << "✓ Multichannel processing test passed" << std::endl;
+}
@@ -0,0 +1,568 @@
+#include "audio_file_reader.hpp"
+#include "audio_analyzer.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("anantasound_" + name)).string();
+}
+
+void writeFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Minimal MSB-first bit writer for building FLAC streams
+class BitWriter {
+public:
+    std::vector<uint8_t> bytes;
+
+    void write(uint64_t value, unsigned count) {
+        for (unsigned i = count; i > 0; --i) {
+            pushBit((value >> (i - 1)) & 1);
+        }
+    }
+
+    void writeSigned(int64_t value, unsigned count) {
+        write(static_cast<uint64_t>(value) & ((count == 64) ? ~0ULL : ((1ULL << count) - 1)), count);
+    }
+
+    void writeRice(int64_t value, unsigned k) {
+        uint64_t folded = value >= 0 ? static_cast<uint64_t>(value) << 1
+                                     : (static_cast<uint64_t>(-value) << 1) - 1;
+        for (uint64_t q = folded >> k; q > 0; --q) {
+            pushBit(0);
+        }
+        pushBit(1);
+        write(folded & ((1ULL << k) - 1), k);
+    }
+
+    void align() {
+        while (bit_count_ != 0) {
+            pushBit(0);
+        }
+    }
+
+    size_t size() const { return bytes.size(); }
+
+private:
+    uint8_t current_ = 0;
+    unsigned bit_count_ = 0;
+
+    void pushBit(uint64_t bit) {
+        current_ = static_cast<uint8_t>((current_ << 1) | (bit & 1));
+        if (++bit_count_ == 8) {
+            bytes.push_back(current_);
+            current_ = 0;
+            bit_count_ = 0;
+        }
+    }
+};
+
+uint8_t referenceCRC8(const uint8_t* data, size_t count) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < count; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = static_cast<uint8_t>((crc & 0x80) ? ((crc << 1) ^ 0x07) : (crc << 1));
+        }
+    }
+    return crc;
+}
+
+uint16_t referenceCRC16(const uint8_t* data, size_t count) {
+    uint16_t crc = 0;
+    for (size_t i = 0; i < count; ++i) {
+        crc ^= static_cast<uint16_t>(data[i] << 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = static_cast<uint16_t>((crc & 0x8000) ? ((crc << 1) ^ 0x8005) : (crc << 1));
+        }
+    }
+    return crc;
+}
+
+enum class SubframeKind { CONSTANT, VERBATIM, FIXED2, LPC2, FIXED1_ESCAPED, WASTED_VERBATIM };
+
+void writeSubframe(BitWriter& w, const std::vector<int64_t>& s, unsigned bps, SubframeKind kind) {
+    const size_t n = s.size();
+    w.write(0, 1);
+
+    switch (kind) {
+        case SubframeKind::CONSTANT:
+            w.write(0, 6);
+            w.write(0, 1);
+            w.writeSigned(s[0], bps);
+            break;
+
+        case SubframeKind::VERBATIM:
+            w.write(1, 6);
+            w.write(0, 1);
+            for (int64_t v : s) {
+                w.writeSigned(v, bps);
+            }
+            break;
+
+        case SubframeKind::WASTED_VERBATIM:
+            // Two wasted bits: flag, then unary (wasted - 1)
+            w.write(1, 6);
+            w.write(1, 1);
+            w.write(0, 1);
+            w.write(1, 1);
+            for (int64_t v : s) {
+                w.writeSigned(v >> 2, bps - 2);
+            }
+            break;
+
+        case SubframeKind::FIXED2:
+            w.write(8 + 2, 6);
+            w.write(0, 1);
+            w.writeSigned(s[0], bps);
+            w.writeSigned(s[1], bps);
+            w.write(0, 2);          // Rice, 4-bit parameters
+            w.write(0, 4);          // Partition order 0
+            w.write(5, 4);
+            for (size_t i = 2; i < n; ++i) {
+                w.writeRice(s[i] - 2 * s[i - 1] + s[i - 2], 5);
+            }
+            break;
+
+        case SubframeKind::LPC2: {
+            // Coefficients {3, -1} with shift 1: prediction floors (3a - b) / 2
+            w.write(32 + 1, 6);
+            w.write(0, 1);
+            w.writeSigned(s[0], bps);
+            w.writeSigned(s[1], bps);
+            w.write(4 - 1, 4);      // Coefficient precision
+            w.writeSigned(1, 5);    // Shift
+            w.writeSigned(3, 4);
+            w.writeSigned(-1, 4);
+            w.write(1, 2);          // Rice2, 5-bit parameters
+            w.write(2, 4);          // Partition order 2
+            size_t partition_size = n >> 2;
+            size_t i = 2;
+            for (size_t p = 0; p < 4; ++p) {
+                w.write(7, 5);
+                size_t end = (p + 1) * partition_size;
+                for (; i < end; ++i) {
+                    int64_t prediction = (3 * s[i - 1] - s[i - 2]) >> 1;
+                    w.writeRice(s[i] - prediction, 7);
+                }
+            }
+            break;
+        }
+
+        case SubframeKind::FIXED1_ESCAPED: {
+            // Partition 0 escaped to raw samples, partition 1 Rice coded
+            w.write(8 + 1, 6);
+            w.write(0, 1);
+            w.writeSigned(s[0], bps);
+            w.write(0, 2);
+            w.write(1, 4);
+            size_t half = n / 2;
+            w.write(15, 4);
+            w.write(bps + 2, 5);
+            for (size_t i = 1; i < half; ++i) {
+                w.writeSigned(s[i] - s[i - 1], bps + 2);
+            }
+            w.write(6, 4);
+            for (size_t i = half; i < n; ++i) {
+                w.writeRice(s[i] - s[i - 1], 6);
+            }
+            break;
+        }
+    }
+}
+
+struct TestFrame {
+    unsigned channel_code;
+    SubframeKind first;
+    SubframeKind second;
+    std::vector<int64_t> left;
+    std::vector<int64_t> right;
+};
+
+void writeFrame(std::vector<uint8_t>& out, const TestFrame& frame, unsigned frame_number) {
+    BitWriter w;
+    const unsigned bps = 16;
+    const size_t n = frame.left.size();
+
+    w.write(0x3FFE, 14);
+    w.write(0, 1);
+    w.write(0, 1);                  // Fixed block size stream
+    w.write(7, 4);                  // 16-bit block size at end of header
+    w.write(0, 4);                  // Sample rate from STREAMINFO
+    w.write(frame.channel_code, 4);
+    w.write(4, 3);                  // 16 bits per sample
+    w.write(0, 1);
+    w.write(frame_number, 8);       // UTF-8 frame number (< 128)
+    w.write(n - 1, 16);
+    w.write(referenceCRC8(w.bytes.data(), w.size()), 8);
+
+    std::vector<int64_t> first = frame.left;
+    std::vector<int64_t> second = frame.right;
+    unsigned first_bps = bps;
+    unsigned second_bps = bps;
+
+    for (size_t i = 0; i < n; ++i) {
+        int64_t l = frame.left[i];
+        int64_t r = frame.right[i];
+        if (frame.channel_code == 8) {
+            second[i] = l - r;
+        } else if (frame.channel_code == 9) {
+            first[i] = l - r;
+        } else if (frame.channel_code == 10) {
+            first[i] = (l + r) >> 1;
+            second[i] = l - r;
+        }
+    }
+    if (frame.channel_code == 8 || frame.channel_code == 10) second_bps++;
+    if (frame.channel_code == 9) first_bps++;
+
+    writeSubframe(w, first, first_bps, frame.first);
+    writeSubframe(w, second, second_bps, frame.second);
+    w.align();
+    w.write(referenceCRC16(w.bytes.data(), w.size()), 16);
+
+    out.insert(out.end(), w.bytes.begin(), w.bytes.end());
+}
+
+void appendLE32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void appendLE16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+// Builds a stereo 16-bit FLAC stream covering every subframe type and
+// channel decorrelation mode; frame_offsets receives each frame's position
+std::vector<uint8_t> buildTestFLAC(std::vector<TestFrame>& frames, std::vector<size_t>& frame_offsets) {
+    uint32_t seed = 12345;
+    auto noise = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<int64_t>((seed >> 16) % 200) - 100;
+    };
+
+    auto tone = [&](size_t start, size_t n, double freq, double amplitude) {
+        std::vector<int64_t> s(n);
+        for (size_t i = 0; i < n; ++i) {
+            s[i] = static_cast<int64_t>(std::lround(amplitude * std::sin(2.0 * M_PI * freq * (start + i) / 44100.0))) + noise();
+        }
+        return s;
+    };
+
+    const size_t block = 1024;
+    frames = {
+        {1, SubframeKind::FIXED2, SubframeKind::LPC2, tone(0, block, 440.0, 12000.0), tone(0, block, 660.0, 9000.0)},
+        {8, SubframeKind::VERBATIM, SubframeKind::FIXED1_ESCAPED, tone(block, block, 440.0, 12000.0), tone(block, block, 660.0, 9000.0)},
+        {10, SubframeKind::FIXED2, SubframeKind::LPC2, tone(2 * block, block, 440.0, 32000.0), tone(2 * block, block, 445.0, -32000.0)},
+        {1, SubframeKind::CONSTANT, SubframeKind::WASTED_VERBATIM, std::vector<int64_t>(block, -1234), {}},
+        {9, SubframeKind::FIXED2, SubframeKind::FIXED2, tone(4 * block, 1000, 440.0, 12000.0), tone(4 * block, 1000, 660.0, 9000.0)},
+    };
+    frames[3].right = tone(3 * block, block, 880.0, 6000.0);
+    for (auto& v : frames[3].right) {
+        v *= 4;
+    }
+
+    std::vector<uint8_t> out = {'f', 'L', 'a', 'C'};
+
+    // STREAMINFO
+    BitWriter info;
+    info.write(0, 1);
+    info.write(0, 7);
+    info.write(34, 24);
+    info.write(1000, 16);
+    info.write(block, 16);
+    info.write(0, 24);
+    info.write(0, 24);
+    info.write(44100, 20);
+    info.write(2 - 1, 3);
+    info.write(16 - 1, 5);
+    info.write(4 * block + 1000, 36);
+    for (int i = 0; i < 16; ++i) {
+        info.write(0, 8);
+    }
+    out.insert(out.end(), info.bytes.begin(), info.bytes.end());
+
+    // VORBIS_COMMENT, last metadata block
+    std::vector<uint8_t> comment;
+    const std::string vendor = "anantasound test";
+    const std::vector<std::string> entries = {"TITLE=Dome Test", "artist=Ananta", "DATE=2024", "TRACKNUMBER=7"};
+    appendLE32(comment, static_cast<uint32_t>(vendor.size()));
+    comment.insert(comment.end(), vendor.begin(), vendor.end());
+    appendLE32(comment, static_cast<uint32_t>(entries.size()));
+    for (const auto& entry : entries) {
+        appendLE32(comment, static_cast<uint32_t>(entry.size()));
+        comment.insert(comment.end(), entry.begin(), entry.end());
+    }
+    out.push_back(0x80 | 4);
+    out.push_back(static_cast<uint8_t>(comment.size() >> 16));
+    out.push_back(static_cast<uint8_t>(comment.size() >> 8));
+    out.push_back(static_cast<uint8_t>(comment.size()));
+    out.insert(out.end(), comment.begin(), comment.end());
+
+    frame_offsets.clear();
+    for (size_t f = 0; f < frames.size(); ++f) {
+        frame_offsets.push_back(out.size());
+        writeFrame(out, frames[f], static_cast<unsigned>(f));
+    }
+    return out;
+}
+
+std::vector<uint8_t> buildWAV(uint16_t format_tag, uint16_t channels, uint32_t rate, uint16_t bits,
+                              const std::vector<uint8_t>& samples, const std::string& title) {
+    std::vector<uint8_t> out = {'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E'};
+
+    out.insert(out.end(), {'f', 'm', 't', ' '});
+    appendLE32(out, 16);
+    appendLE16(out, format_tag);
+    appendLE16(out, channels);
+    appendLE32(out, rate);
+    appendLE32(out, rate * channels * (bits / 8));
+    appendLE16(out, static_cast<uint16_t>(channels * (bits / 8)));
+    appendLE16(out, bits);
+
+    if (!title.empty()) {
+        std::vector<uint8_t> list = {'I', 'N', 'F', 'O', 'I', 'N', 'A', 'M'};
+        uint32_t length = static_cast<uint32_t>(title.size() + 1);
+        appendLE32(list, length);
+        list.insert(list.end(), title.begin(), title.end());
+        list.push_back(0);
+        if (length & 1) list.push_back(0);
+        out.insert(out.end(), {'L', 'I', 'S', 'T'});
+        appendLE32(out, static_cast<uint32_t>(list.size()));
+        out.insert(out.end(), list.begin(), list.end());
+    }
+
+    out.insert(out.end(), {'d', 'a', 't', 'a'});
+    appendLE32(out, static_cast<uint32_t>(samples.size()));
+    out.insert(out.end(), samples.begin(), samples.end());
+
+    uint32_t riff_size = static_cast<uint32_t>(out.size() - 8);
+    std::memcpy(out.data() + 4, &riff_size, 4);
+    return out;
+}
+
+} // namespace
+
+void test_flac_decoder() {
+    std::cout << "Testing FLAC decoder..." << std::endl;
+
+    std::vector<TestFrame> frames;
+    std::vector<size_t> offsets;
+    std::vector<uint8_t> stream = buildTestFLAC(frames, offsets);
+    std::string path = tempPath("decoder_test.flac");
+    writeFile(path, stream);
+
+    AudioFileReader reader;
+    assert(reader.open(path));
+    assert(reader.getFormat() == AudioFileFormat::FLAC);
+    assert(reader.getInfo().sample_rate == 44100);
+    assert(reader.getInfo().channels == 2);
+    assert(reader.getInfo().bits_per_sample == 16);
+    assert(reader.getInfo().total_samples == 4 * 1024 + 1000);
+    assert(reader.getMetadata().title == "Dome Test");
+    assert(reader.getMetadata().artist == "Ananta");
+    assert(reader.getMetadata().year == 2024);
+    assert(reader.getMetadata().track_number == 7);
+
+    std::vector<double> expected;
+    for (const auto& frame : frames) {
+        for (size_t i = 0; i < frame.left.size(); ++i) {
+            expected.push_back(frame.left[i] / 32768.0);
+            expected.push_back(frame.right[i] / 32768.0);
+        }
+    }
+
+    // Odd read size so reads straddle frame boundaries
+    std::vector<double> decoded;
+    std::vector<double> block(333 * 2);
+    size_t count = 0;
+    while ((count = reader.readInterleaved(block.data(), 333)) > 0) {
+        decoded.insert(decoded.end(), block.begin(), block.begin() + count * 2);
+    }
+    assert(decoded == expected);
+    assert(reader.getDecodeErrors() == 0);
+    assert(AudioUtils::validateFLACQuality(path));
+
+    // Mono downmix after rewind
+    assert(reader.rewind());
+    std::vector<double> mono(5000);
+    assert(reader.readMono(mono.data(), mono.size()) == 5000);
+    assert(std::abs(mono[4500] - 0.5 * (expected[9000] + expected[9001])) < 1e-15);
+
+    // A damaged frame is dropped and decoding resumes at the next one
+    std::vector<uint8_t> damaged = stream;
+    damaged[offsets[1] + 200] ^= 0x5A;
+    std::string damaged_path = tempPath("decoder_damaged.flac");
+    writeFile(damaged_path, damaged);
+
+    AudioFileReader damaged_reader;
+    assert(damaged_reader.open(damaged_path));
+    size_t total = 0;
+    while ((count = damaged_reader.readInterleaved(block.data(), 333)) > 0) {
+        total += count;
+    }
+    assert(total == 3 * 1024 + 1000);
+    assert(damaged_reader.getDecodeErrors() >= 1);
+    assert(!AudioUtils::validateFLACQuality(damaged_path));
+
+    std::remove(path.c_str());
+    std::remove(damaged_path.c_str());
+
+    std::cout << "✓ FLAC decoder test passed" << std::endl;
+}
+
+void test_wav_reader() {
+    std::cout << "Testing WAV reader..." << std::endl;
+
+    // 24-bit stereo PCM with an INFO title
+    std::vector<int32_t> reference;
+    std::vector<uint8_t> pcm;
+    for (int i = 0; i < 3000; ++i) {
+        for (int channel = 0; channel < 2; ++channel) {
+            int32_t v = static_cast<int32_t>(std::lround(8000000.0 * std::sin(0.01 * i + channel)));
+            reference.push_back(v);
+            pcm.push_back(static_cast<uint8_t>(v));
+            pcm.push_back(static_cast<uint8_t>(v >> 8));
+            pcm.push_back(static_cast<uint8_t>(v >> 16));
+        }
+    }
+    std::string path = tempPath("reader_test.wav");
+    writeFile(path, buildWAV(1, 2, 48000, 24, pcm, "Hanuman"));
+
+    AudioFileReader reader;
+    assert(reader.open(path));
+    assert(reader.getFormat() == AudioFileFormat::WAV);
+    assert(reader.getInfo().sample_rate == 48000);
+    assert(reader.getInfo().bits_per_sample == 24);
+    assert(reader.getInfo().total_samples == 3000);
+    assert(reader.getMetadata().title == "Hanuman");
+
+    std::vector<double> block(700 * 2);
+    size_t position = 0;
+    size_t count = 0;
+    while ((count = reader.readInterleaved(block.data(), 700)) > 0) {
+        for (size_t i = 0; i < count * 2; ++i) {
+            assert(block[i] == reference[position + i] / 8388608.0);
+        }
+        position += count * 2;
+    }
+    assert(position == reference.size());
+    assert(reader.getFramePosition() == 3000);
+
+    // 32-bit float mono
+    std::vector<uint8_t> floats;
+    for (int i = 0; i < 100; ++i) {
+        float v = 0.25f * static_cast<float>(i % 5) - 0.5f;
+        uint8_t bytes[4];
+        std::memcpy(bytes, &v, 4);
+        floats.insert(floats.end(), bytes, bytes + 4);
+    }
+    std::string float_path = tempPath("reader_float.wav");
+    writeFile(float_path, buildWAV(3, 1, 44100, 32, floats, ""));
+
+    AudioFileReader float_reader;
+    assert(float_reader.open(float_path));
+    assert(float_reader.getInfo().codec == "IEEE float");
+    std::vector<double> mono(128);
+    assert(float_reader.readMono(mono.data(), mono.size()) == 100);
+    assert(mono[3] == 0.25);
+
+    std::remove(path.c_str());
+    std::remove(float_path.c_str());
+
+    std::cout << "✓ WAV reader test passed" << std::endl;
+}
+
+void test_audio_analyzer_load_file() {
+    std::cout << "Testing AudioAnalyzer file loading..." << std::endl;
+
+    // Two seconds of a bin-centred tone at 48 kHz, 16-bit stereo
+    const double bin_width = 48000.0 / 1024.0;
+    const double tone = 40.0 * bin_width;
+    std::vector<uint8_t> pcm;
+    for (int i = 0; i < 96000; ++i) {
+        int16_t v = static_cast<int16_t>(std::lround(16000.0 * std::sin(2.0 * M_PI * tone * i / 48000.0)));
+        for (int channel = 0; channel < 2; ++channel) {
+            pcm.push_back(static_cast<uint8_t>(v));
+            pcm.push_back(static_cast<uint8_t>(v >> 8));
+        }
+    }
+    std::string path = tempPath("analyzer_load.wav");
+    writeFile(path, buildWAV(1, 2, 48000, 16, pcm, "Tone"));
+
+    AudioAnalyzer analyzer(1024, 44100);
+    assert(analyzer.initialize());
+    assert(analyzer.loadAudioFile(path));
+
+    const AudioInfo& info = analyzer.getAudioInfo();
+    assert(info.format == "WAV");
+    assert(info.sample_rate == 48000);
+    assert(std::abs(info.duration_seconds - 2.0) < 1e-9);
+    assert(analyzer.getMetadata().title == "Tone");
+
+    const SpectralData& spectral = analyzer.getSpectralData();
+    assert(spectral.frame_count == (96000 - 1024) / 256 + 1);
+    assert(spectral.magnitudes.size() == 513);
+    assert(std::abs(spectral.dominant_frequency - tone) < 1e-6);
+    assert(spectral.spectral_centroid > 0.0);
+    assert(spectral.spectral_bandwidth > 0.0);
+
+    std::string report_path = tempPath("analyzer_report.txt");
+    assert(analyzer.exportAnalysisReport(report_path));
+    std::ifstream report(report_path);
+    std::stringstream content;
+    content << report.rdbuf();
+    assert(content.str().find("Dominant Frequency") != std::string::npos);
+
+    assert(!analyzer.loadAudioFile(tempPath("missing_file.wav")));
+
+    // A file shorter than one window gives the frame analyzeAudio gives for its samples
+    std::vector<uint8_t> short_pcm;
+    for (int i = 0; i < 300; ++i) {
+        int16_t v = static_cast<int16_t>(std::lround(16000.0 * std::sin(2.0 * M_PI * tone * i / 48000.0)));
+        short_pcm.push_back(static_cast<uint8_t>(v));
+        short_pcm.push_back(static_cast<uint8_t>(v >> 8));
+    }
+    std::string short_path = tempPath("analyzer_short.wav");
+    writeFile(short_path, buildWAV(1, 1, 48000, 16, short_pcm, ""));
+    assert(analyzer.loadAudioFile(short_path));
+    const SpectralData& short_spectral = analyzer.getSpectralData();
+    assert(short_spectral.frame_count == 1);
+
+    AudioFileReader short_reader;
+    assert(short_reader.open(short_path));
+    std::vector<double> short_samples(1024);
+    short_samples.resize(short_reader.readMono(short_samples.data(), short_samples.size()));
+    assert(short_samples.size() == 300);
+    AudioAnalyzer reference(1024, 48000);
+    assert(reference.initialize());
+    AudioAnalysisResult expected = reference.analyzeAudio(short_samples);
+    assert(short_spectral.magnitudes.size() == expected.magnitude_spectrum.size());
+    for (size_t k = 0; k < expected.magnitude_spectrum.size(); ++k) {
+        assert(std::abs(short_spectral.magnitudes[k] - expected.magnitude_spectrum[k]) < 1e-9);
+    }
+
+    std::remove(path.c_str());
+    std::remove(short_path.c_str());
+    std::remove(report_path.c_str());
+
+    std::cout << "✓ AudioAnalyzer file loading test passed" << std::endl;
+}
@@ -0,0 +1,113 @@
+#include "batch_analyzer.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+std::vector<double> sine(double frequency, int sample_rate, size_t frames, double amplitude) {
+    std::vector<double> samples(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        samples[i] = amplitude * std::sin(2.0 * M_PI * frequency * i / sample_rate);
+    }
+    return samples;
+}
+
+size_t countLines(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    size_t lines = 0;
+    while (std::getline(in, line)) {
+        ++lines;
+    }
+    return lines;
+}
+
+} // namespace
+
+void test_batch_analyzer() {
+    std::cout << "Testing pipelined batch analysis..." << std::endl;
+
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "anantasound_batch";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "nested");
+
+    // Tones of known pitch, one in a subdirectory, plus files to skip or reject
+    const std::map<std::string, double> tones = {
+        {"a.wav", 440.0}, {"b.WAV", 1000.0}, {"c.wav", 2500.0}, {"nested/d.wav", 3000.0}};
+    for (const auto& [name, frequency] : tones) {
+        assert(AudioUtils::writeWAV((root / name).string(), sine(frequency, 48000, 48000, 0.5), 1, 48000));
+    }
+    std::ofstream((root / "broken.wav").string()) << "not audio";
+    std::ofstream((root / "notes.txt").string()) << "skip me";
+
+    BatchAnalysisOptions options;
+    options.decoder_threads = 2;
+    options.analyzer_threads = 3;
+    options.chunk_frames = 5000;        // Rounded to whole 1024-sample frames
+    options.chunks_in_flight = 3;       // Fewer buffers than files in flight: decoders must wait
+    options.fft_size = 1024;
+    BatchAnalyzer batch(options);
+    assert(batch.getOptions().chunk_frames == 4096);
+
+    std::map<std::string, BatchFileReport> reports;
+    BatchAnalysisSummary summary = batch.run(root.string(), [&](const BatchFileReport& report) {
+        reports[std::filesystem::relative(report.path, root).generic_string()] = report;
+    });
+    assert(summary.files == 5 && summary.succeeded == 4 && summary.failed == 1);
+    assert(std::abs(summary.audio_seconds - 4.0) < 1e-9);
+    assert(!reports["broken.wav"].ok && !reports["broken.wav"].error.empty());
+    for (const auto& [name, frequency] : tones) {
+        const BatchFileReport& report = reports[name];
+        assert(report.ok && report.info.sample_rate == 48000);
+        assert(report.frames_analyzed == 48000 / 1024);
+        assert(std::abs(report.dominant_frequency - frequency) <= 48000.0 / 1024);
+        assert(std::abs(report.rms - 0.5 / std::sqrt(2.0)) < 1e-3);
+        assert(std::abs(report.peak - 0.5) < 1e-3);
+    }
+
+    // Same features with a single decoder and analyzer
+    options.decoder_threads = 1;
+    options.analyzer_threads = 1;
+    options.recursive = false;
+    std::map<std::string, BatchFileReport> serial;
+    BatchAnalysisSummary flat = BatchAnalyzer(options).run(root.string(), [&](const BatchFileReport& report) {
+        serial[std::filesystem::relative(report.path, root).generic_string()] = report;
+    });
+    assert(flat.files == 4 && serial.count("nested/d.wav") == 0);
+    for (const auto& [name, report] : serial) {
+        if (report.ok) {
+            assert(report.dominant_frequency == reports[name].dominant_frequency);
+            assert(std::abs(report.spectral_centroid - reports[name].spectral_centroid) < 1e-9);
+            assert(std::abs(report.rms - reports[name].rms) < 1e-12);
+        }
+    }
+
+    // Consolidated reports: header plus one row per file, or a JSON array
+    std::string csv_path = (root / "report.csv").string();
+    std::string json_path = (root / "report.json").string();
+    BatchReportWriter csv, json;
+    assert(csv.open(csv_path) && json.open(json_path));
+    for (const auto& entry : reports) {
+        csv.write(entry.second);
+        json.write(entry.second);
+    }
+    csv.close();
+    json.close();
+    assert(csv.getRowCount() == 5 && countLines(csv_path) == 6);
+    assert(countLines(json_path) == 7);
+    std::ifstream json_in(json_path);
+    std::string document((std::istreambuf_iterator<char>(json_in)), std::istreambuf_iterator<char>());
+    assert(document.front() == '[' && document.find("\"dominant_frequency\"") != std::string::npos);
+
+    std::filesystem::remove_all(root);
+
+    std::cout << "✓ Pipelined batch analysis test passed" << std::endl;
+}
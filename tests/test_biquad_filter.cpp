@@ -0,0 +1,96 @@
+#include "biquad_filter.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_biquad_shelf_response() {
+    std::cout << "Testing biquad shelf response..." << std::endl;
+
+    const double rate = 48000.0;
+    const double gain = std::pow(10.0, 9.0 / 20.0);
+
+    // +9 dB shelves: full gain on the boosted side, unity on the other
+    BiquadCoefficients low = BiquadCoefficients::lowShelf(rate, 200.0, 9.0);
+    assert(std::abs(low.magnitudeAt(rate, 0.0) - gain) < 1e-9);
+    assert(std::abs(low.magnitudeAt(rate, 20000.0) - 1.0) < 1e-2);
+    assert(std::abs(low.magnitudeAt(rate, 200.0) - std::sqrt(gain)) < 1e-9);
+
+    BiquadCoefficients high = BiquadCoefficients::highShelf(rate, 4000.0, 9.0);
+    assert(std::abs(high.magnitudeAt(rate, rate / 2.0) - gain) < 1e-9);
+    assert(std::abs(high.magnitudeAt(rate, 0.0) - 1.0) < 1e-9);
+
+    // 0 dB designs collapse to the identity filter
+    BiquadCoefficients flat = BiquadCoefficients::lowShelf(rate, 200.0, 0.0);
+    assert(std::abs(flat.b0 - 1.0) < 1e-12 && std::abs(flat.b1 - flat.a1) < 1e-12);
+
+    // A steady tone well inside the shelf settles at the designed gain
+    BiquadFilter filter;
+    filter.setCoefficients(low);
+    std::vector<double> tone(48000);
+    for (size_t i = 0; i < tone.size(); ++i) {
+        tone[i] = 0.1 * std::sin(2.0 * M_PI * 30.0 * i / rate);
+    }
+    filter.processBlock(tone.data(), tone.size());
+    double peak = 0.0;
+    for (size_t i = tone.size() / 2; i < tone.size(); ++i) {
+        peak = std::max(peak, std::abs(tone[i]));
+    }
+    assert(std::abs(peak - 0.1 * low.magnitudeAt(rate, 30.0)) < 1e-3);
+
+    std::cout << "✓ Biquad shelf response test passed" << std::endl;
+}
+
+void test_biquad_block_state() {
+    std::cout << "Testing biquad block state..." << std::endl;
+
+    const size_t channels = 4;
+    const size_t frames = 1000;
+    BiquadCoefficients coefficients = BiquadCoefficients::highShelf(44100.0, 3000.0, 6.0);
+
+    std::vector<std::vector<double>> mono(channels, std::vector<double>(frames));
+    std::vector<double> interleaved(channels * frames);
+    for (size_t c = 0; c < channels; ++c) {
+        for (size_t i = 0; i < frames; ++i) {
+            double x = std::sin(0.05 * (c + 1) * i) * (c % 2 ? 0.5 : -0.3);
+            mono[c][i] = x;
+            interleaved[i * channels + c] = x;
+        }
+    }
+
+    // Reference: each channel filtered alone in one block
+    for (size_t c = 0; c < channels; ++c) {
+        BiquadFilter filter;
+        filter.setCoefficients(coefficients);
+        filter.processBlock(mono[c].data(), frames);
+    }
+
+    // Interleaved, in blocks of 64 frames: state carries across the boundaries
+    BiquadFilter bank(channels);
+    bank.setCoefficients(coefficients);
+    for (size_t start = 0; start < frames; start += 64) {
+        size_t count = std::min<size_t>(64, frames - start);
+        bank.processInterleaved(interleaved.data() + start * channels, count);
+    }
+    for (size_t c = 0; c < channels; ++c) {
+        for (size_t i = 0; i < frames; ++i) {
+            assert(std::abs(interleaved[i * channels + c] - mono[c][i]) < 1e-12);
+        }
+    }
+
+    // Float filter tracks the double reference
+    BiquadFilterF filter_f;
+    filter_f.setCoefficients(coefficients);
+    std::vector<float> signal_f(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        signal_f[i] = static_cast<float>(std::sin(0.05 * i) * -0.3);
+    }
+    filter_f.processBlock(signal_f.data(), frames);
+    for (size_t i = 0; i < frames; ++i) {
+        assert(std::abs(signal_f[i] - mono[0][i]) < 1e-5);
+    }
+
+    std::cout << "✓ Biquad block state test passed" << std::endl;
+}
@@ -0,0 +1,253 @@
+#include "breathing_analyzer.hpp"
+#include "envelope_decimator.hpp"
+#include "sliding_window_stats.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+// Broadband noise whose amplitude rises and falls once per breath
+std::vector<double> breathingNoise(double breaths_per_minute, double seconds, size_t sample_rate) {
+    std::vector<double> signal(static_cast<size_t>(seconds * sample_rate));
+    uint32_t state = 12345;
+    double frequency = breaths_per_minute / 60.0;
+    for (size_t i = 0; i < signal.size(); ++i) {
+        state = state * 1664525u + 1013904223u;
+        double noise = static_cast<double>(state >> 8) / 8388608.0 - 1.0;
+        double t = static_cast<double>(i) / sample_rate;
+        double amplitude = breaths_per_minute > 0.0
+            ? 0.1 + 0.4 * (0.5 - 0.5 * std::cos(2.0 * M_PI * frequency * t)) : 0.3;
+        signal[i] = amplitude * noise;
+    }
+    return signal;
+}
+
+template<typename Sample>
+BreathingAnalysisResult streamInBlocks(BreathingAnalyzer& analyzer, const std::vector<Sample>& signal, size_t block) {
+    BreathingAnalysisResult result;
+    for (size_t start = 0; start < signal.size(); start += block) {
+        size_t count = std::min(block, signal.size() - start);
+        result = analyzer.analyzeBreathing(signal.data() + start, count);
+    }
+    return result;
+}
+
+} // namespace
+
+void test_envelope_decimator() {
+    std::cout << "Testing EnvelopeDecimator..." << std::endl;
+
+    // CIC: unity DC gain in fixed point, factor clamped to at least 1
+    CICDecimator cic(100);
+    assert(CICDecimator(0).getFactor() == 1);
+    double value = 0.0;
+    size_t outputs = 0;
+    for (int i = 0; i < 1000; ++i) {
+        if (cic.push(0.5, value)) {
+            ++outputs;
+        }
+    }
+    assert(outputs == 10);
+    assert(std::abs(value - 0.5) < 1e-6);
+
+    // Half-band: symmetric, zero at even offsets, unity DC gain
+    const auto& taps = HalfBandDecimator::coefficients();
+    double sum = 0.0;
+    for (size_t k = 0; k < HalfBandDecimator::kTaps; ++k) {
+        sum += taps[k];
+        assert(std::abs(taps[k] - taps[HalfBandDecimator::kTaps - 1 - k]) < 1e-15);
+        int offset = static_cast<int>(k) - static_cast<int>(HalfBandDecimator::kTaps / 2);
+        if (offset != 0 && offset % 2 == 0) {
+            assert(taps[k] == 0.0);
+        }
+    }
+    assert(std::abs(sum - 1.0) < 1e-12);
+
+    // 44.1 kHz down to 25 Hz; a steady sine settles on its RMS
+    EnvelopeDecimator front_end(44100);
+    assert(front_end.getDecimation() == 1764);
+    assert(front_end.getOutputRate() >= 10.0 && front_end.getOutputRate() <= 50.0);
+    std::vector<double> sine(441000);
+    for (size_t i = 0; i < sine.size(); ++i) {
+        sine[i] = 0.5 * std::sin(2.0 * M_PI * 1000.0 * i / 44100.0);
+    }
+    std::vector<double> envelope;
+    size_t produced = 0;
+    for (size_t start = 0; start < sine.size(); start += 1000) {
+        produced += front_end.process(sine.data() + start, std::min<size_t>(1000, sine.size() - start), envelope);
+    }
+    assert(produced == envelope.size() && produced == sine.size() / 1764);
+    assert(std::abs(envelope.back() - 0.5 / std::sqrt(2.0)) < 1e-3);
+
+    std::cout << "✓ EnvelopeDecimator test passed" << std::endl;
+}
+
+void test_breathing_rate_estimation() {
+    std::cout << "Testing BreathingAnalyzer breath rate estimation..." << std::endl;
+
+    const size_t rate = 44100;
+
+    // Nothing to classify during the first seconds of a stream
+    BreathingAnalyzer analyzer(1024, rate);
+    assert(analyzer.initialize());
+    assert(std::abs(analyzer.getEnvelopeRate() - 25.0) < 1e-9);
+    std::vector<double> calm = breathingNoise(15.0, 40.0, rate);
+    std::vector<double> first_second(calm.begin(), calm.begin() + rate);
+    BreathingAnalysisResult early = streamInBlocks(analyzer, first_second, 1024);
+    assert(early.current_state == BreathingState::UNKNOWN && early.breathing_rate == 0.0);
+
+    // 15 breaths per minute are resolved from the envelope
+    std::vector<double> rest(calm.begin() + rate, calm.end());
+    BreathingAnalysisResult result = streamInBlocks(analyzer, rest, 1024);
+    assert(std::abs(result.breathing_rate - 15.0) < 0.5);
+    assert(result.breathing_depth > 0.0 && result.breathing_depth <= 1.0);
+    assert(result.breathing_cycle.size() == 100);        // One 4 s period at 25 Hz
+
+    // The cycle is a view into the envelope history, copied only on request
+    std::vector<double> cycle;
+    assert(analyzer.copyBreathingCycle(result.breathing_cycle, cycle));
+    assert(cycle.size() == 100);
+    double peak = *std::max_element(cycle.begin(), cycle.end());
+    assert(std::abs(std::min(1.0, 2.0 * peak) - result.breathing_depth) < 1e-12);
+    BreathingCycleView stale(result.breathing_cycle.offset - 2000, 100);
+    assert(!analyzer.copyBreathingCycle(stale, cycle) && cycle.empty());
+    assert(std::abs(analyzer.getAverageBreathingRate() - 15.0) < 0.5);
+    assert(analyzer.getStatistics().total_analyses > 0);
+
+    // Faster breathing, float input and a different block size
+    std::vector<double> rapid = breathingNoise(40.0, 30.0, rate);
+    std::vector<float> rapid_f(rapid.begin(), rapid.end());
+    BreathingAnalyzer analyzer_f(1024, rate);
+    BreathingAnalysisResult rapid_result = streamInBlocks(analyzer_f, rapid_f, 700);
+    assert(std::abs(rapid_result.breathing_rate - 40.0) < 1.0);
+    assert(rapid_result.current_state == BreathingState::RAPID);
+
+    // resetStream forgets the envelope; steady noise has no breathing period
+    BreathingCycleView before_reset = rapid_result.breathing_cycle;
+    std::vector<double> copied;
+    assert(analyzer_f.copyBreathingCycle(before_reset, copied));
+    assert(copied.size() >= 37 && copied.size() <= 38);             // 1.5 s at 25 Hz
+    analyzer_f.resetStream();
+    assert(!analyzer_f.copyBreathingCycle(before_reset, copied));
+    std::vector<double> steady = breathingNoise(0.0, 30.0, rate);
+    BreathingAnalysisResult holding = streamInBlocks(analyzer_f, steady, 1024);
+    assert(holding.breathing_rate == 0.0);
+    assert(holding.breathing_cycle.empty());
+    assert(holding.current_state == BreathingState::HOLDING);
+
+    // Overlapped analysis streams each sample once and keeps the window count
+    BreathingAnalyzer overlapped(1024, rate);
+    std::vector<double> ten_seconds(calm.begin(), calm.begin() + 10 * rate);
+    auto results = overlapped.analyzeBreathingWithOverlap(ten_seconds);
+    assert(results.size() == (ten_seconds.size() - 1024) / 256 + 1);
+
+    std::cout << "✓ BreathingAnalyzer breath rate estimation test passed" << std::endl;
+}
+
+void test_sliding_window_stats() {
+    std::cout << "Testing SlidingWindowStats..." << std::endl;
+
+    // Running moments match a direct recomputation over the window
+    SlidingWindowStats stats(20);
+    assert(stats.empty() && stats.mean() == 0.0 && stats.variance() == 0.0);
+    std::vector<double> values;
+    uint32_t state = 7;
+    for (int i = 0; i < 5000; ++i) {
+        state = state * 1664525u + 1013904223u;
+        double value = 15.0 + 10.0 * (static_cast<double>(state >> 8) / 16777216.0) + (i > 2500 ? 30.0 : 0.0);
+        stats.push(value);
+        values.push_back(value);
+
+        size_t count = std::min<size_t>(values.size(), 20);
+        double mean = 0.0;
+        for (size_t k = values.size() - count; k < values.size(); ++k) {
+            mean += values[k];
+        }
+        mean /= count;
+        double variance = 0.0;
+        for (size_t k = values.size() - count; k < values.size(); ++k) {
+            variance += (values[k] - mean) * (values[k] - mean);
+        }
+        variance /= count;
+        assert(stats.size() == count && stats.back() == value);
+        assert(std::abs(stats.mean() - mean) < 1e-9);
+        assert(std::abs(stats.variance() - variance) < 1e-7);
+    }
+    stats.clear();
+    assert(stats.empty() && stats.capacity() == 20);
+
+    // Analyzer queries read the accumulators without allocating
+    BreathingAnalyzer analyzer(1024, 44100);
+    assert(analyzer.getStatistics().most_common_state == BreathingState::UNKNOWN);
+    streamInBlocks(analyzer, breathingNoise(20.0, 20.0, 44100), 4096);
+    size_t before = TestSupport::allocationCount();
+    auto summary = analyzer.getStatistics();
+    double average = analyzer.getAverageBreathingRate();
+    BreathingState current = analyzer.getCurrentBreathingState();
+    assert(TestSupport::allocationCount() == before);
+    assert(summary.total_analyses == 20);
+    assert(std::abs(average - 20.0) < 1.0 && summary.average_breathing_rate == average);
+    assert(current != BreathingState::UNKNOWN && summary.most_common_state == current);
+
+    std::cout << "✓ SlidingWindowStats test passed" << std::endl;
+}
+
+void test_breathing_state_classification() {
+    std::cout << "Testing BreathingAnalyzer state classification table..." << std::endl;
+
+    // Reference cascade over the default thresholds
+    auto cascade = [](double rate, double depth, double regularity) {
+        if (rate < 8.0) {
+            return depth > 0.7 ? BreathingState::DEEP : BreathingState::HOLDING;
+        }
+        if (rate > 25.0) {
+            return BreathingState::RAPID;
+        }
+        if (rate > 20.0) {
+            return depth < 0.3 ? BreathingState::SHALLOW : BreathingState::RAPID;
+        }
+        if (regularity < 0.7) {
+            return BreathingState::IRREGULAR;
+        }
+        if (depth > 0.7) {
+            return BreathingState::DEEP;
+        }
+        return depth < 0.3 ? BreathingState::SHALLOW : BreathingState::NORMAL;
+    };
+
+    std::vector<double> rates, depths, regularities;
+    for (double rate : {4.0, 8.0, 12.0, 20.0, 22.0, 25.0, 30.0}) {
+        for (double depth : {0.1, 0.3, 0.5, 0.7, 0.9}) {
+            for (double regularity : {0.5, 0.7, 0.9}) {
+                rates.push_back(rate);
+                depths.push_back(depth);
+                regularities.push_back(regularity);
+            }
+        }
+    }
+    BreathingAnalyzer analyzer(1024, 44100);
+    std::vector<BreathingState> states(rates.size());
+    size_t before = TestSupport::allocationCount();
+    analyzer.classifyBreathingStates(rates.data(), depths.data(), regularities.data(), rates.size(), states.data());
+    assert(TestSupport::allocationCount() == before);
+    for (size_t i = 0; i < states.size(); ++i) {
+        assert(states[i] == cascade(rates[i], depths[i], regularities[i]));
+    }
+
+    // Thresholds stay configurable at run time
+    analyzer.setBreathingRateThresholds(4.0, 30.0);
+    analyzer.setRapidBreathingThreshold(40.0);
+    double rate = 6.0, depth = 0.5, regularity = 0.9;
+    BreathingState state;
+    analyzer.classifyBreathingStates(&rate, &depth, &regularity, 1, &state);
+    assert(state == BreathingState::NORMAL && cascade(rate, depth, regularity) == BreathingState::HOLDING);
+
+    std::cout << "✓ BreathingAnalyzer state classification table test passed" << std::endl;
+}
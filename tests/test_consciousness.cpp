@@ -1,7 +1,9 @@
 #include "consciousness_integration.hpp"
+#include "allocation_counter.hpp"
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <vector>
 
 using namespace AnantaSound;
 
@@ -98,3 +100,50 @@ void test_consciousness_state_transitions() {
 }
 
 
+
+void test_consciousness_ingest() {
+    std::cout << "Testing fused consciousness ingest..." << std::endl;
+    
+    std::vector<QuantumSoundField> fields(64);
+    for (size_t i = 0; i < fields.size(); ++i) {
+        fields[i].amplitude = std::complex<double>(0.5 + 0.01 * i, 0.1);
+        fields[i].frequency = 400.0 + i;
+        fields[i].phase = 0.3 + 0.02 * std::sin(static_cast<double>(i));
+    }
+    
+    // One pass gives the separate coherence and field updates
+    ConsciousnessIntegration fused, separate;
+    fused.ingest(fields);
+    double coherence = separate.calculateConsciousnessCoherence(fields);
+    separate.updateConsciousnessField(fields, 0.0);
+    assert(std::abs(fused.getLastCoherence() - coherence) < 1e-12);
+    assert(fused.getConsciousnessState() == ConsciousnessState::COHERENT);
+    assert(std::abs(fused.getConsciousnessField().frequency - separate.getConsciousnessField().frequency) < 1e-9);
+    assert(std::abs(fused.getConsciousnessField().amplitude - separate.getConsciousnessField().amplitude) < 1e-12);
+    double energy = 0.0;
+    for (const auto& field : fields) {
+        energy += std::norm(field.amplitude);
+    }
+    assert(std::abs(fused.getLastEnergy() - energy / fields.size()) < 1e-12);
+    
+    // Steady-state ticks and spectrum reads allocate nothing
+    std::vector<double> spectrum;
+    fused.getConsciousnessSpectrum(spectrum);
+    size_t before = TestSupport::allocationCount();
+    for (int tick = 0; tick < 10; ++tick) {
+        fused.ingest(fields.data(), fields.size());
+        fused.getConsciousnessSpectrum(spectrum);
+    }
+    assert(TestSupport::allocationCount() == before);
+    assert(spectrum.size() == 5);
+    
+    // The cache follows depth and state changes; an empty batch dissociates
+    fused.setIntegrationDepth(8);
+    assert(fused.getConsciousnessSpectrum().size() == 8);
+    double coherent_peak = fused.getConsciousnessSpectrum()[0];
+    fused.ingest(nullptr, 0);
+    assert(fused.getConsciousnessState() == ConsciousnessState::DISSOCIATED);
+    assert(std::abs(fused.getConsciousnessSpectrum()[0] - coherent_peak / 3.0) < 1e-12);
+    
+    std::cout << "✓ Fused consciousness ingest test passed" << std::endl;
+}
@@ -0,0 +1,97 @@
+#include "constant_q.hpp"
+#include "audio_analyzer.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+std::vector<double> tones(const std::vector<std::pair<double, double>>& partials, size_t sample_rate, double seconds) {
+    std::vector<double> samples(static_cast<size_t>(seconds * sample_rate), 0.0);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        for (const auto& partial : partials) {
+            samples[i] += partial.second * std::sin(2.0 * M_PI * partial.first * i / sample_rate);
+        }
+    }
+    return samples;
+}
+
+size_t peakBin(const ConstantQSpectrum& spectrum, size_t first, size_t last) {
+    size_t peak = first;
+    for (size_t bin = first; bin <= last; ++bin) {
+        if (spectrum.magnitudes[bin] > spectrum.magnitudes[peak]) {
+            peak = bin;
+        }
+    }
+    return peak;
+}
+
+} // namespace
+
+void test_constant_q() {
+    std::cout << "Testing constant-Q analysis..." << std::endl;
+
+    const size_t sample_rate = 44100;
+
+    // Geometry: semitone bins from 27.5 Hz, one small FFT for all octaves
+    ConstantQKernel kernel(sample_rate);
+    assert(kernel.getBinsPerOctave() == 12 && kernel.getOctaveCount() == 9 && kernel.getBinCount() == 108);
+    assert(kernel.getLeadingStages() == 0 && kernel.getFFTSize() <= 256);
+    assert(kernel.getKernelEntries() < 12 * 16);
+    assert(std::abs(kernel.getFrequency(0) - 27.5) < 1e-9);
+    assert(std::abs(kernel.getFrequency(48) - 440.0) < 1e-9 && kernel.getBin(440.0) == 48);
+    assert(kernel.getFrequency(kernel.getBinCount() - 1) < ConstantQKernel::kMaxRelativeFrequency * sample_rate);
+
+    // A low dome mode and a high partial together, each resolved to its bin
+    double low = kernel.getFrequency(7);        // ~41 Hz
+    double neighbour = kernel.getFrequency(9);  // Two semitones up
+    double high = kernel.getFrequency(100);     // ~8.9 kHz
+    AudioAnalyzer analyzer(1024, sample_rate);
+    assert(analyzer.initialize());
+    ConstantQSpectrum spectrum = analyzer.analyzeConstantQ(
+        tones({{low, 0.5}, {neighbour, 0.25}, {high, 0.3}}, sample_rate, 3.0));
+    assert(spectrum.frequencies == kernel.getFrequencies());
+    assert(peakBin(spectrum, 0, 8) == 7 && peakBin(spectrum, 9, 20) == 9);
+    assert(peakBin(spectrum, 60, kernel.getBinCount() - 1) == 100);
+    assert(std::abs(spectrum.magnitudes[7] - 0.5) < 0.05);
+    assert(std::abs(spectrum.magnitudes[9] - 0.25) < 0.03);
+    assert(std::abs(spectrum.magnitudes[100] - 0.3) < 0.03);
+    assert(spectrum.magnitudes[48] < 0.01);
+
+    // A low upper limit decimates before the top octave instead of growing the FFT
+    ConstantQOptions narrow;
+    narrow.min_frequency = 20.0;
+    narrow.max_frequency = 400.0;
+    ConstantQKernel low_kernel(sample_rate, narrow);
+    assert(low_kernel.getLeadingStages() == 5 && low_kernel.getFFTSize() <= 256);
+    ConstantQSpectrum narrow_spectrum = analyzer.analyzeConstantQ(tones({{100.0, 0.4}}, sample_rate, 3.0), narrow);
+    size_t hundred = low_kernel.getBin(100.0);
+    assert(peakBin(narrow_spectrum, 0, low_kernel.getBinCount() - 1) == hundred);
+    assert(std::abs(narrow_spectrum.magnitudes[hundred] - 0.4) < 0.04);
+
+    // Streaming: a frame per hop whatever the chunking, no allocation once built
+    std::vector<double> signal = tones({{low, 0.5}, {high, 0.3}}, sample_rate, 2.0);
+    ConstantQAnalyzer whole(sample_rate);
+    ConstantQAnalyzer chunked(whole.getSharedKernel());
+    size_t frames = 0;
+    chunked.setFrameCallback([&frames](const ConstantQSpectrum&) { frames++; });
+    assert(whole.pushSamples(signal) == signal.size() / 512);
+    size_t before = TestSupport::allocationCount();
+    for (size_t offset = 0; offset < signal.size(); offset += 700) {
+        chunked.pushSamples(signal.data() + offset, std::min<size_t>(700, signal.size() - offset));
+    }
+    assert(TestSupport::allocationCount() == before);
+    assert(frames == whole.getFramesEmitted() && chunked.getSamplesPushed() == signal.size());
+    assert(chunked.getSpectrum().magnitudes == whole.getSpectrum().magnitudes);
+    assert(peakBin(whole.getSpectrum(), 0, 20) == 7);
+    assert(whole.getLatencySamples() == kernel.getFFTSize() << 8);
+
+    whole.reset();
+    assert(whole.getFramesEmitted() == 0 && whole.getSpectrum().magnitudes[7] == 0.0);
+
+    std::cout << "✓ Constant-Q analysis test passed" << std::endl;
+}
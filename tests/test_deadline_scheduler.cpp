@@ -0,0 +1,197 @@
+#include "deadline_scheduler.hpp"
+#include "metrics.hpp"
+#include "processing_graph.hpp"
+#include "session_pool.hpp"
+#include "interference_cluster_tree.hpp"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+void busyFor(std::chrono::microseconds duration) {
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+} // namespace
+
+void test_deadline_scheduler() {
+    std::cout << "Testing DeadlineScheduler..." << std::endl;
+
+    // Fast attack: every tick over 85% of the budget sheds one more level
+    DeadlineOptions options;
+    options.budget_ns = 1000000;
+    options.recovery_ticks = 3;
+    options.metrics_component = "deadline_test";
+    DeadlineScheduler scheduler(options);
+    assert(scheduler.getLevel() == 0 && scheduler.allows(OptionalWork::CONSCIOUSNESS));
+    scheduler.recordTick(900000);
+    assert(scheduler.getLevel() == 1);
+    assert(!scheduler.allows(OptionalWork::CONSCIOUSNESS) && scheduler.allows(OptionalWork::RESONANCE_DETECTION));
+    for (int i = 0; i < 6; ++i) {
+        scheduler.recordTick(1500000);
+    }
+    assert(scheduler.getLevel() == kMaxDegradationLevel);
+    assert(!scheduler.allows(OptionalWork::UNFOCUSED_SESSIONS) && scheduler.allows(OptionalWork::MANDATORY));
+
+    // Slow release: one level per run of calm ticks; a busy tick restarts the run
+    scheduler.recordTick(300000);
+    scheduler.recordTick(300000);
+    scheduler.recordTick(700000);
+    scheduler.recordTick(300000);
+    scheduler.recordTick(300000);
+    assert(scheduler.getLevel() == kMaxDegradationLevel);
+    scheduler.recordTick(300000);
+    assert(scheduler.getLevel() == kMaxDegradationLevel - 1);
+    for (int i = 0; i < 3 * kMaxDegradationLevel; ++i) {
+        scheduler.recordTick(100000);
+    }
+    assert(scheduler.getLevel() == 0);
+
+    DeadlineStatistics statistics = scheduler.getStatistics();
+    assert(statistics.ticks == 25 && statistics.deadline_misses == 6);
+    assert(statistics.level_changes == 2 * kMaxDegradationLevel);
+    assert(statistics.last_tick_ns == 100000 && statistics.budget_ns == 1000000);
+    std::string metrics = MetricsRegistry::shared().toOpenMetrics();
+    assert(metrics.find("anantasound_degradation_level{component=\"deadline_test\"} 0\n") != std::string::npos);
+    assert(metrics.find("anantasound_deadline_misses_total{component=\"deadline_test\"} 6\n") != std::string::npos);
+
+    // Optional stages are shed by level and when their estimate no longer fits
+    auto mandatory = scheduler.addStage("audio");
+    auto optional = scheduler.addStage("spectrum", OptionalWork::CONSCIOUSNESS);
+    scheduler.beginTick();
+    assert(scheduler.shouldRun(mandatory) && scheduler.shouldRun(optional));
+    scheduler.recordStage(optional, 400000);
+    scheduler.recordStage(optional, 5000000);
+    assert(scheduler.getStageCosts()[optional].estimate_ns > 1000000);
+    assert(!scheduler.shouldRun(optional) && scheduler.shouldRun(mandatory));
+    scheduler.setStageWork(optional, OptionalWork::MANDATORY);
+    assert(scheduler.shouldRun(optional));
+    auto costs = scheduler.getStageCosts();
+    assert(costs.size() == 2 && costs[1].name == "spectrum" && costs[1].runs == 2 && costs[1].shed == 1);
+    assert(scheduler.getStatistics().shed_stages == 1);
+
+    // One slow outlier does not shed the stage for good once the load is gone
+    scheduler.setStageWork(optional, OptionalWork::CONSCIOUSNESS);
+    int probes = 0;
+    bool ran = false;
+    while (!ran && probes < 20) {
+        scheduler.beginTick();
+        ran = scheduler.shouldRun(optional);
+        ++probes;
+    }
+    assert(ran && probes > 1 && scheduler.getLevel() == 0);
+    assert(scheduler.getStageCosts()[optional].estimate_ns <= 1000000);
+
+    std::cout << "✓ DeadlineScheduler test passed" << std::endl;
+}
+
+void test_graph_degradation() {
+    std::cout << "Testing ProcessingGraph degradation..." << std::endl;
+
+    // Overloaded ticks shed the optional sink while the mandatory stage runs
+    // every tick; quality comes back once the load is gone
+    DeadlineOptions options;
+    options.budget_ns = 20000000;
+    options.recovery_ticks = 4;
+    DeadlineScheduler scheduler(options);
+
+    ProcessingGraph graph;
+    auto input = graph.addBuffer("input");
+    auto output = graph.addBuffer("output");
+    std::chrono::microseconds load(0);
+    int audio_runs = 0, spectrum_runs = 0;
+    graph.addStage("audio", {input}, {output}, [&](ProcessingGraph::StageIO& io) {
+        busyFor(load);
+        io.output(0) = io.input(0);
+        ++audio_runs;
+    });
+    auto spectrum = graph.addStage("spectrum", {output}, {}, [&](ProcessingGraph::StageIO&) { ++spectrum_runs; });
+    graph.setDeadlineScheduler(&scheduler);
+    graph.setStageWork(spectrum, OptionalWork::CONSCIOUSNESS);
+    assert(scheduler.getStageCount() == 2 && graph.getStageWork(spectrum) == OptionalWork::CONSCIOUSNESS);
+    graph.getBuffer(input).resize(4);
+
+    for (int i = 0; i < 3; ++i) {
+        assert(graph.tick(0.016));
+    }
+    assert(audio_runs == 3 && spectrum_runs == 3 && scheduler.getLevel() == 0);
+
+    load = std::chrono::microseconds(25000);
+    for (int i = 0; i < 3; ++i) {
+        assert(graph.tick(0.016));
+    }
+    assert(audio_runs == 6 && spectrum_runs == 3 && graph.getBuffer(output).size() == 4);
+    assert(scheduler.getLevel() == 3 && scheduler.getStatistics().deadline_misses == 3);
+
+    load = std::chrono::microseconds(0);
+    int ticks = 0;
+    while (scheduler.getLevel() > 0 && ticks < 100) {
+        assert(graph.tick(0.016));
+        ++ticks;
+    }
+    assert(scheduler.getLevel() == 0 && ticks == 3 * 4);
+    assert(spectrum_runs == 3);
+    assert(graph.tick(0.016) && spectrum_runs == 4 && audio_runs == 6 + ticks + 1);
+
+    // Unfocused listeners keep their audio when their analysis is shed
+    const size_t block = 1024;
+    SessionPoolF sessions(1024, 44100, 2);
+    assert(sessions.initialize());
+    size_t focused = sessions.addSession(), unfocused = sessions.addSession();
+    assert(sessions.setSessionFocus(unfocused, false) && !sessions.isSessionFocused(unfocused));
+    assert(sessions.isSessionFocused(focused) && !sessions.setSessionFocus(7, false));
+    std::vector<float> in(block), out_focused(block), out_unfocused(block);
+    for (size_t i = 0; i < block; ++i) {
+        in[i] = static_cast<float>(0.3 * std::sin(2.0 * M_PI * 330.0 * i / 44100.0));
+    }
+    std::vector<SessionBlockF> blocks{{focused, in.data(), out_focused.data(), block},
+                                      {unfocused, in.data(), out_unfocused.data(), block}};
+    std::vector<SessionResult> results;
+    sessions.process(blocks, results);
+    assert(results[0].analyzed && results[1].analyzed);
+    scheduler.recordTick(options.budget_ns * 2);
+    scheduler.recordTick(options.budget_ns * 2);
+    scheduler.recordTick(options.budget_ns * 2);
+    scheduler.recordTick(options.budget_ns * 2);
+    sessions.setUnfocusedAnalysis(scheduler.allows(OptionalWork::UNFOCUSED_SESSIONS));
+    assert(!sessions.isUnfocusedAnalysisEnabled());
+    std::fill(out_unfocused.begin(), out_unfocused.end(), 0.0f);
+    sessions.process(blocks, results);
+    assert(results[0].analyzed && results[0].processed);
+    assert(!results[1].analyzed && results[1].processed);
+    double energy = 0.0;
+    for (float sample : out_unfocused) {
+        energy += static_cast<double>(sample) * sample;
+    }
+    assert(energy > 0.0);
+
+    // Far-field detail: a coarser tolerance visits fewer nodes, no rebuild
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord{1.0, 0.5, 0.5, 1.0}, 5.0);
+    std::vector<QuantumSoundField> sources(512);
+    for (size_t s = 0; s < sources.size(); ++s) {
+        sources[s].amplitude = std::complex<double>(0.5, 0.0);
+        sources[s].frequency = 110.0;
+        sources[s].quantum_state = QuantumSoundState::COHERENT;
+        sources[s].position = {8.0 + 0.001 * (s % 8), 0.002 * (s / 64), 0.001 * (s % 64), 0.1};
+    }
+    field.addSourceFields(sources);
+    InterferenceClusterTree tree(1e-6);
+    field.buildClusterTree(tree);
+    size_t fine = 0, coarse = 0;
+    tree.evaluate(0.5, 0.2, 1.0, &fine);
+    tree.setTolerance(1e-1);
+    assert(tree.getTolerance() == 1e-1);
+    tree.evaluate(0.5, 0.2, 1.0, &coarse);
+    assert(coarse < fine);
+
+    std::cout << "✓ ProcessingGraph degradation test passed" << std::endl;
+}
@@ -0,0 +1,253 @@
+#include "effects_chain.hpp"
+#include "adaptive_audio_processor.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+AdaptationParameters allStagesParameters() {
+    AdaptationParameters parameters;
+    parameters.volume_multiplier = 1.5;
+    parameters.tempo_multiplier = 1.25;     // Exact in binary, so block splits round identically
+    parameters.bass_boost = 0.4;
+    parameters.treble_boost = 0.3;
+    parameters.reverb_amount = 0.5;
+    parameters.echo_delay = 0.01;
+    return parameters;
+}
+
+std::vector<double> chainTestSignal(size_t count) {
+    std::vector<double> signal(count);
+    for (size_t i = 0; i < count; ++i) {
+        signal[i] = 0.6 * std::sin(2.0 * M_PI * 300.0 * i / 44100.0) +
+                    0.3 * std::sin(2.0 * M_PI * 2500.0 * i / 44100.0);
+    }
+    return signal;
+}
+
+} // namespace
+
+void test_effects_chain_block_continuity() {
+    std::cout << "Testing EffectsChain block continuity..." << std::endl;
+
+    std::vector<double> signal = chainTestSignal(8192);
+
+    EffectsChain whole(44100);
+    whole.setParameters(allStagesParameters());
+    std::vector<double> expected;
+    whole.process(signal.data(), signal.size(), expected);
+    // The tempo resampler holds back the tail of its filter window
+    size_t nominal = static_cast<size_t>(std::ceil(signal.size() / 1.25));
+    assert(expected.size() <= nominal && expected.size() + 64 >= nominal);
+
+    // Uneven small blocks, shorter than both delay lines, give the same stream
+    EffectsChain blocked(44100);
+    blocked.setParameters(allStagesParameters());
+    std::vector<double> streamed;
+    std::vector<double> block;
+    size_t offset = 0;
+    for (size_t step = 0; offset < signal.size(); ++step) {
+        size_t length = std::min<size_t>(64 + 37 * (step % 5), signal.size() - offset);
+        blocked.process(signal.data() + offset, length, block);
+        streamed.insert(streamed.end(), block.begin(), block.end());
+        offset += length;
+    }
+    assert(streamed == expected);
+
+    // Clipping is applied once, at the end of the chain
+    for (double sample : expected) {
+        assert(sample >= -1.0 && sample <= 1.0);
+    }
+
+    // reset() returns to the initial state
+    whole.reset();
+    std::vector<double> again;
+    whole.process(signal.data(), signal.size(), again);
+    assert(again == expected);
+
+    std::cout << "✓ EffectsChain block continuity test passed" << std::endl;
+}
+
+void test_effects_chain_bypass_and_allocation() {
+    std::cout << "Testing EffectsChain bypass and allocation..." << std::endl;
+
+    std::vector<double> signal = chainTestSignal(1024);
+
+    EffectsChain chain(44100);
+    chain.setParameters(allStagesParameters());
+    for (EffectStage stage : {EffectStage::TEMPO, EffectStage::VOLUME, EffectStage::BASS_BOOST,
+                              EffectStage::TREBLE_BOOST, EffectStage::REVERB, EffectStage::ECHO}) {
+        assert(chain.isActive(stage));
+        chain.setBypass(stage, true);
+        assert(chain.isBypassed(stage) && !chain.isActive(stage));
+    }
+
+    // Everything bypassed: the block passes through unchanged
+    std::vector<double> output;
+    chain.process(signal.data(), signal.size(), output);
+    assert(output == signal);
+
+    // Steady state: processing into a sized buffer does not allocate
+    chain.setBypass(EffectStage::REVERB, false);
+    chain.setBypass(EffectStage::BASS_BOOST, false);
+    chain.process(signal.data(), signal.size(), output);
+    std::vector<float> in_place(signal.begin(), signal.end());
+    EffectsChainF chain_f(44100);
+    chain_f.setParameters(allStagesParameters());
+
+    size_t before = TestSupport::allocationCount();
+    for (int block = 0; block < 50; ++block) {
+        chain.process(signal.data(), signal.size(), output);
+        chain_f.processInPlace(in_place.data(), in_place.size());
+    }
+    assert(TestSupport::allocationCount() == before);
+
+    // Neutral parameters through the processor leave the audio untouched
+    AdaptiveAudioProcessor processor(1024, 44100);
+    assert(processor.initialize());
+    assert(processor.processAudioWithParameters(signal, AdaptationParameters()) == signal);
+
+    std::cout << "✓ EffectsChain bypass and allocation test passed" << std::endl;
+}
+
+void test_adaptive_processor_realtime() {
+    std::cout << "Testing AdaptiveAudioProcessor real-time mode..." << std::endl;
+
+    const size_t block = 256;
+    std::vector<double> reference = chainTestSignal(block * 64);
+    std::vector<float> signal(reference.begin(), reference.end());
+    std::vector<float> output(block);
+
+    // Before prepareRealtime the block passes through unchanged
+    AdaptiveAudioProcessor processor(1024, 44100);
+    assert(processor.initialize());
+    assert(!processor.isRealtimePrepared());
+    processor.processRealtime(signal.data(), output.data(), block);
+    assert(std::equal(output.begin(), output.end(), signal.begin()));
+    assert(processor.prepareRealtime() && processor.isRealtimePrepared());
+
+    // Control calls from another thread reach the audio thread through the mailbox
+    std::atomic<bool> running{true};
+    std::thread control([&processor, &running]() {
+        AdaptationParameters parameters;
+        int step = 0;
+        while (running.load()) {
+            parameters.reverb_amount = 0.1 * (step % 5);
+            processor.setEmotionPreset(EmotionalState::FOCUSED, parameters);
+            if (step % 7 == 0) {
+                processor.resetEffects();
+            }
+            processor.getStatistics();
+            ++step;
+            std::this_thread::yield();
+        }
+    });
+
+    // Neither the first nor any later block allocates, in place or out of place
+    size_t before = TestSupport::allocationCount();
+    {
+        TestSupport::AllocationTrap trap;
+        for (size_t offset = 0; offset + block <= signal.size(); offset += block) {
+            RealtimeAdaptation result = processor.processRealtime(signal.data() + offset, output.data(), block);
+            assert(result.detected_emotion != EmotionalState::UNKNOWN);
+            assert(result.applied_parameters.tempo_multiplier == 1.0);
+            assert(result.confidence > 0.0 && result.confidence <= 1.0);
+        }
+        std::vector<float>::iterator last = signal.end() - block;
+        processor.processRealtime(&*last, &*last, block);
+    }
+    assert(TestSupport::allocationCount() == before);
+    running.store(false);
+    control.join();
+    assert(processor.getStatistics().most_common_emotion != EmotionalState::UNKNOWN);
+
+    // A muting preset for every state takes over once smoothing settles
+    AdaptationParameters silent;
+    silent.volume_multiplier = 0.0;
+    for (size_t i = 0; i < kEmotionalStateCount; ++i) {
+        processor.setEmotionPreset(static_cast<EmotionalState>(i), silent);
+    }
+    processor.resetEffects();
+    double peak = 0.0;
+    for (int repeat = 0; repeat < 40; ++repeat) {
+        processor.processRealtime(signal.data(), output.data(), block);
+        peak = 0.0;
+        for (float sample : output) {
+            peak = std::max(peak, std::abs(static_cast<double>(sample)));
+        }
+    }
+    assert(peak < 1e-6);
+
+    std::cout << "✓ AdaptiveAudioProcessor real-time mode test passed" << std::endl;
+}
+
+void test_emotion_classification() {
+    std::cout << "Testing emotion classification tables..." << std::endl;
+
+    // Reference: the three per-detector rule cascades and a first-wins vote
+    auto cascade = [](const AudioFeatures& f) {
+        std::array<EmotionalState, 3> votes;
+        votes[0] = f.fundamental_frequency < 0.5 ? EmotionalState::RELAXED
+                 : f.fundamental_frequency > 2.0 ? EmotionalState::EXCITED
+                 : f.volume_level > 0.7 ? EmotionalState::STRESSED : EmotionalState::CALM;
+        votes[1] = f.tempo > 120 ? EmotionalState::EXCITED
+                 : f.tempo < 80 && f.tempo > 0 ? EmotionalState::RELAXED
+                 : f.zero_crossing_rate > 0.3 ? EmotionalState::FOCUSED : EmotionalState::CALM;
+        votes[2] = f.spectral_centroid > 2000 ? EmotionalState::FOCUSED
+                 : f.spectral_centroid < 500 ? EmotionalState::RELAXED
+                 : f.spectral_rolloff > 4000 ? EmotionalState::EXCITED : EmotionalState::CALM;
+        return votes;
+    };
+
+    // Values on both sides of every threshold
+    const double fundamentals[] = {0.2, 1.0, 3.0};
+    const double volumes[] = {0.5, 0.9};
+    const double tempos[] = {0.0, 60.0, 100.0, 140.0};   // 0: not yet estimated
+    const double crossings[] = {0.1, 0.5};
+    const double centroids[] = {300.0, 1000.0, 3000.0};
+    const double rolloffs[] = {2000.0, 6000.0};
+    std::vector<AudioFeatures> frames;
+    for (double f0 : fundamentals) for (double volume : volumes) for (double tempo : tempos)
+    for (double zcr : crossings) for (double centroid : centroids) for (double rolloff : rolloffs) {
+        AudioFeatures features;
+        features.fundamental_frequency = f0;
+        features.volume_level = volume;
+        features.tempo = tempo;
+        features.zero_crossing_rate = zcr;
+        features.spectral_centroid = centroid;
+        features.spectral_rolloff = rolloff;
+        frames.push_back(features);
+    }
+
+    AdaptiveAudioProcessor processor(1024, 44100);
+    std::vector<EmotionalState> emotions(frames.size());
+    std::vector<double> confidences(frames.size());
+    size_t before = TestSupport::allocationCount();
+    processor.classifyEmotions(frames.data(), frames.size(), emotions.data(), confidences.data());
+    assert(TestSupport::allocationCount() == before);
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        auto votes = cascade(frames[i]);
+        std::array<int, kEmotionalStateCount> counts{};
+        for (EmotionalState vote : votes) {
+            counts[static_cast<size_t>(vote)]++;
+        }
+        auto expected = static_cast<EmotionalState>(std::max_element(counts.begin(), counts.end()) - counts.begin());
+        assert(emotions[i] == expected);
+        assert(processor.detectEmotionalState(frames[i]) == expected);
+        assert(confidences[i] == counts[static_cast<size_t>(expected)] / 3.0);
+        assert(processor.calculateConfidence(frames[i], EmotionalState::RELAXED) ==
+               counts[static_cast<size_t>(EmotionalState::RELAXED)] / 3.0);
+    }
+
+    std::cout << "✓ Emotion classification tables test passed" << std::endl;
+}
@@ -0,0 +1,137 @@
+#include "entanglement_graph.hpp"
+#include "anantasound_core.hpp"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_slot_index_and_entanglement_graph() {
+    std::cout << "Testing SlotIndex and EntanglementGraph..." << std::endl;
+
+    // Swap-and-pop keeps handles valid; reused slots get a new generation
+    SlotIndex index;
+    SlotHandle a = index.insert(), b = index.insert(), c = index.insert();
+    assert(index.size() == 3 && index.find(c) == 2);
+    size_t moved_from = 0;
+    assert(index.erase(a, moved_from) == 0 && moved_from == 2);
+    assert(index.find(c) == 0 && index.find(b) == 1);
+    assert(!index.contains(a));
+    assert(index.erase(a, moved_from) == SlotIndex::npos);
+
+    SlotHandle d = index.insert();
+    assert(d.slot == a.slot && d.generation != a.generation);
+    assert(!index.contains(a) && index.find(d) == 2);
+    index.clear();
+    assert(index.empty() && !index.contains(b) && !index.contains(d));
+
+    // Duplicate and self pairs are rejected; partners and components follow edits
+    EntanglementGraph graph;
+    assert(graph.addEdge(0, 1));
+    assert(!graph.addEdge(1, 0));
+    assert(!graph.addEdge(2, 2));
+    assert(graph.addEdge(1, 2));
+    assert(graph.addEdge(5, 6));
+    assert(graph.edgeCount() == 3);
+    assert(graph.partners(1).size() == 2);
+    assert(graph.connected(0, 2) && !graph.connected(0, 5));
+
+    assert(graph.removeEdge(1, 2));
+    assert(!graph.removeEdge(1, 2));
+    assert(!graph.connected(0, 2));
+    assert(graph.addEdge(2, 5));
+    assert(graph.connected(2, 6) && !graph.connected(0, 6));
+
+    graph.removeNode(5);
+    assert(graph.edgeCount() == 1);
+    assert(graph.partners(5).empty() && graph.partners(6).empty());
+    assert(!graph.connected(2, 6));
+
+    // Thousands of pairs: a chain is one component, queries stay cheap
+    EntanglementGraph chain;
+    for (uint32_t node = 0; node + 1 < 20000; ++node) {
+        assert(chain.addEdge(node, node + 1));
+    }
+    assert(chain.connected(0, 19999));
+    chain.removeEdge(9999, 10000);
+    assert(!chain.connected(0, 19999) && chain.connected(0, 9999) && chain.connected(10000, 19999));
+
+    std::cout << "✓ SlotIndex and EntanglementGraph test passed" << std::endl;
+}
+
+void test_interference_field_handles() {
+    std::cout << "Testing InterferenceField source handles..." << std::endl;
+
+    SphericalCoord center{1.0, 0.5, 0.5, 0.0, 1.0};
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, center, 5.0);
+    std::vector<QuantumSoundField> sources(4);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        sources[i].amplitude = std::complex<double>(1.0, 0.0);
+        sources[i].frequency = 200.0 + 100.0 * i;
+        sources[i].quantum_state = QuantumSoundState::COHERENT;
+        sources[i].position = {1.0 + i, 0.3, 0.2 * i, 0.0, 1.0};
+    }
+    auto handles = field.addSourceFields(sources);
+    assert(handles.size() == 4 && field.getSourceCount() == 4);
+
+    // Pairs are deduplicated in either order
+    assert(field.createQuantumEntanglement(handles[0], handles[1]));
+    assert(!field.createQuantumEntanglement(handles[1], handles[0]));
+    assert(!field.createQuantumEntanglement(handles[2], handles[2]));
+    field.createQuantumEntanglement(0, 1);
+    assert(field.createQuantumEntanglement(handles[1], handles[3]));
+    assert(field.getEntangledPairsCount() == 2);
+    assert(field.areEntangled(handles[3], handles[1]));
+    assert(field.inSameEntanglementComponent(handles[0], handles[3]));
+    assert(!field.inSameEntanglementComponent(handles[0], handles[2]));
+
+    auto partners = field.getEntangledPartners(handles[1]);
+    assert(partners.size() == 2);
+    assert(std::find(partners.begin(), partners.end(), handles[0]) != partners.end());
+    assert(std::find(partners.begin(), partners.end(), handles[3]) != partners.end());
+
+    // Removing a source drops its pairs; the other handles keep working
+    assert(field.removeSourceField(handles[1]));
+    assert(!field.removeSourceField(handles[1]));
+    assert(field.getSourceCount() == 3 && !field.containsSource(handles[1]));
+    assert(field.getEntangledPairsCount() == 0);
+    assert(field.getEntangledPartners(handles[0]).empty());
+    assert(!field.inSameEntanglementComponent(handles[0], handles[3]));
+    assert(field.createQuantumEntanglement(handles[3], handles[2]));
+
+    // The remaining (all entangled) sources interfere as if added from scratch
+    InterferenceField rebuilt(InterferenceFieldType::CONSTRUCTIVE, center, 5.0);
+    for (size_t i = 0; i < field.getSourceCount(); ++i) {
+        SlotHandle handle = field.getSourceHandle(i);
+        size_t original = std::find(handles.begin(), handles.end(), handle) - handles.begin();
+        QuantumSoundField source = sources[original];
+        source.quantum_state = QuantumSoundState::ENTANGLED;
+        rebuilt.addSourceField(source);
+    }
+    SphericalCoord listener{2.0, 0.4, 0.3, 0.0, 1.2};
+    assert(std::abs(field.calculateInterference(listener, 0.0) - rebuilt.calculateInterference(listener, 0.0)) < 1e-12);
+
+    // Core interference fields: O(1) removal with stable handles
+    AnantaSoundCore core(10.0, 5.0);
+    assert(core.initialize());
+    std::vector<AnantaSoundCore::InterferenceFieldHandle> field_handles;
+    std::vector<InterferenceField*> raw;
+    for (int i = 0; i < 5; ++i) {
+        auto owned = std::make_unique<InterferenceField>(InterferenceFieldType::CONSTRUCTIVE, center, 1.0 + i);
+        raw.push_back(owned.get());
+        field_handles.push_back(core.addInterferenceField(std::move(owned)));
+    }
+    assert(core.removeInterferenceField(field_handles[1]));
+    assert(!core.removeInterferenceField(field_handles[1]));
+    assert(core.getInterferenceField(field_handles[1]) == nullptr);
+    core.removeInterferenceField(0);
+    assert(core.getInterferenceFieldCount() == 3);
+    assert(core.getInterferenceField(field_handles[0]) == nullptr);
+    for (int i : {2, 3, 4}) {
+        assert(core.getInterferenceField(field_handles[i]) == raw[i]);
+    }
+
+    std::cout << "✓ InterferenceField source handles test passed" << std::endl;
+}
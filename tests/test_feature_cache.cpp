@@ -0,0 +1,127 @@
+#include "feature_cache.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+std::vector<double> sweep(int sample_rate, size_t frames) {
+    std::vector<double> samples(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        double t = static_cast<double>(i) / sample_rate;
+        samples[i] = 0.4 * std::sin(2.0 * M_PI * (300.0 + 900.0 * t) * t) + 0.1 * std::sin(2.0 * M_PI * 5000.0 * t);
+    }
+    return samples;
+}
+
+size_t countEntries(const std::filesystem::path& directory) {
+    size_t entries = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        entries += entry.path().extension() == ".anfeat";
+    }
+    return entries;
+}
+
+} // namespace
+
+void test_feature_cache() {
+    std::cout << "Testing feature cache..." << std::endl;
+
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "anantasound_feature_cache";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    std::string audio = (root / "sweep.wav").string();
+    std::string copy = (root / "copy.wav").string();
+    assert(AudioUtils::writeWAV(audio, sweep(44100, 44100), 1, 44100));
+    std::filesystem::copy_file(audio, copy);
+
+    // Content hash: stable, independent of the path, sensitive to the data
+    uint64_t hash = 0, copy_hash = 0, missing = 0;
+    assert(FeatureCache::hashFile(audio, hash) && FeatureCache::hashFile(copy, copy_hash));
+    assert(hash == copy_hash && hash != 0);
+    assert(!FeatureCache::hashFile((root / "absent.wav").string(), missing));
+
+    FeatureCache cache((root / "cache").string());
+    AudioAnalyzer reference(1024, 44100);
+    AudioAnalyzer cached(1024, 44100);
+    cached.setFeatureCache(&cache);
+    assert(reference.loadAudioFile(audio));
+
+    // Miss: analyzed, stored, per-frame features kept in memory
+    assert(cached.loadAudioFile(audio));
+    assert(cache.getHits() == 0 && cache.getMisses() == 1 && countEntries(root / "cache") == 1);
+    std::shared_ptr<const FeatureTable> computed = cached.getFrameFeatures();
+    assert(computed && !computed->isMapped());
+    assert(computed->getFrameCount() == reference.getSpectralData().frame_count);
+    assert(computed->getBinCount() == 513 && computed->getSampleRate() == 44100);
+    assert(reference.getFrameFeatures() == nullptr);
+
+    // Hit, also through another path to the same content: mapped, identical results
+    for (const std::string& path : {audio, copy}) {
+        AudioAnalyzer repeat(1024, 44100);
+        repeat.setFeatureCache(&cache);
+        uint64_t hits = cache.getHits();
+        assert(repeat.loadAudioFile(path));
+        assert(cache.getHits() == hits + 1);
+        std::shared_ptr<const FeatureTable> mapped = repeat.getFrameFeatures();
+        assert(mapped && mapped->isMapped() && mapped->getKey() == computed->getKey());
+        assert(mapped->getFrameCount() == computed->getFrameCount());
+        for (uint32_t column = 0; column < kFeatureColumnCount; ++column) {
+            for (size_t frame = 0; frame < mapped->getFrameCount(); ++frame) {
+                assert(mapped->column(FeatureColumn(column))[frame] == computed->column(FeatureColumn(column))[frame]);
+            }
+        }
+        for (size_t band = 0; band < kFeatureBandCount; ++band) {
+            assert(mapped->bands(3)[band] == computed->bands(3)[band]);
+        }
+
+        const SpectralData& expected = reference.getSpectralData();
+        const SpectralData& actual = repeat.getSpectralData();
+        assert(actual.frame_count == expected.frame_count);
+        assert(actual.magnitudes == expected.magnitudes && actual.frequencies == expected.frequencies);
+        assert(actual.phases == expected.phases);
+        assert(actual.dominant_frequency == expected.dominant_frequency);
+        assert(actual.spectral_centroid == expected.spectral_centroid);
+        assert(actual.spectral_rolloff == expected.spectral_rolloff);
+        assert(actual.spectral_bandwidth == expected.spectral_bandwidth);
+        assert(repeat.getAudioInfo().sample_rate == 44100);
+    }
+
+    // The sweep rises: late frames have a higher centroid than early ones
+    const double* centroid = computed->column(kFeatureCentroid);
+    assert(centroid[computed->getFrameCount() - 2] > centroid[1]);
+
+    // A different hop size is a different entry; the first one stays valid
+    AudioAnalyzer hop(1024, 44100);
+    hop.setHopSize(512);
+    hop.setFeatureCache(&cache);
+    uint64_t misses = cache.getMisses();
+    assert(hop.loadAudioFile(audio));
+    assert(cache.getMisses() == misses + 1 && countEntries(root / "cache") == 2);
+    assert(hop.getFrameFeatures()->getFrameCount() < computed->getFrameCount());
+    assert(cache.load(computed->getKey()) != nullptr);
+
+    // Changed content misses
+    assert(AudioUtils::writeWAV(copy, sweep(44100, 22050), 1, 44100));
+    misses = cache.getMisses();
+    assert(cached.loadAudioFile(copy));
+    assert(cache.getMisses() == misses + 1 && !cached.getFrameFeatures()->isMapped());
+
+    // Truncated or foreign entries are rejected and recomputed
+    std::string entry = cache.getEntryPath(computed->getKey());
+    std::filesystem::resize_file(entry, std::filesystem::file_size(entry) - 8);
+    assert(cache.load(computed->getKey()) == nullptr);
+    std::ofstream(entry, std::ios::trunc) << "not a feature cache entry, just some text long enough to hold a header";
+    assert(cache.load(computed->getKey()) == nullptr);
+    assert(cached.loadAudioFile(audio) && !cached.getFrameFeatures()->isMapped());
+    assert(cache.load(computed->getKey()) != nullptr);
+
+    std::filesystem::remove_all(root);
+
+    std::cout << "✓ Feature cache test passed" << std::endl;
+}
@@ -0,0 +1,139 @@
+#include "fft_engine.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <complex>
+#include <stdexcept>
+#include <thread>
+
+using namespace AnantaSound;
+
+namespace {
+
+std::vector<std::complex<double>> referenceDFT(const std::vector<std::complex<double>>& input) {
+    size_t n = input.size();
+    std::vector<std::complex<double>> output(n);
+    for (size_t k = 0; k < n; ++k) {
+        std::complex<double> sum(0.0, 0.0);
+        for (size_t t = 0; t < n; ++t) {
+            double angle = -2.0 * M_PI * static_cast<double>(k * t) / static_cast<double>(n);
+            sum += input[t] * std::complex<double>(std::cos(angle), std::sin(angle));
+        }
+        output[k] = sum;
+    }
+    return output;
+}
+
+std::vector<double> testSignal(size_t n) {
+    std::vector<double> signal(n);
+    for (size_t i = 0; i < n; ++i) {
+        signal[i] = std::sin(0.37 * i) + 0.5 * std::cos(1.3 * i + 0.2) + 0.01 * static_cast<double>(i % 7);
+    }
+    return signal;
+}
+
+} // namespace
+
+void test_fft_complex_transform() {
+    std::cout << "Testing FFTPlan complex transform..." << std::endl;
+    
+    for (size_t n : {2u, 4u, 8u, 32u, 64u, 512u}) {
+        std::vector<double> signal = testSignal(n);
+        std::vector<std::complex<double>> input(n);
+        for (size_t i = 0; i < n; ++i) {
+            input[i] = std::complex<double>(signal[i], 0.3 * signal[(i + 1) % n]);
+        }
+        auto expected = referenceDFT(input);
+        
+        for (FFTAlgorithm algorithm : {FFTAlgorithm::RADIX2, FFTAlgorithm::RADIX4}) {
+            FFTPlan plan(n, algorithm);
+            auto data = input;
+            plan.forward(data.data());
+            for (size_t k = 0; k < n; ++k) {
+                assert(std::abs(data[k] - expected[k]) < 1e-9 * n);
+            }
+            
+            plan.inverse(data.data());
+            for (size_t i = 0; i < n; ++i) {
+                assert(std::abs(data[i] - input[i]) < 1e-12 * n);
+            }
+        }
+    }
+    
+    std::cout << "✓ FFTPlan complex transform test passed" << std::endl;
+}
+
+void test_fft_real_transform() {
+    std::cout << "Testing FFTPlan real transform..." << std::endl;
+    
+    for (size_t n : {2u, 4u, 16u, 128u, 1024u, 2048u}) {
+        std::vector<double> signal = testSignal(n);
+        std::vector<std::complex<double>> input(signal.begin(), signal.end());
+        auto expected = referenceDFT(input);
+        
+        FFTPlan plan(n);
+        assert(plan.getBinCount() == n / 2 + 1);
+        
+        std::vector<std::complex<double>> bins(plan.getBinCount());
+        plan.forwardReal(signal.data(), bins.data());
+        for (size_t k = 0; k < bins.size(); ++k) {
+            assert(std::abs(bins[k] - expected[k]) < 1e-9 * n);
+        }
+        
+        // Single-precision plan: same layout, float rounding error
+        std::vector<float> signal_f(signal.begin(), signal.end());
+        FFTPlanF plan_f(n);
+        std::vector<std::complex<float>> bins_f(plan_f.getBinCount());
+        plan_f.forwardReal(signal_f.data(), bins_f.data());
+        for (size_t k = 0; k < bins_f.size(); ++k) {
+            std::complex<double> bin(bins_f[k].real(), bins_f[k].imag());
+            assert(std::abs(bin - expected[k]) < 1e-5 * n);
+        }
+    }
+    
+    assert(!FFTPlan::isValidSize(0));
+    assert(!FFTPlan::isValidSize(1000));
+    assert(FFTPlan::isValidSize(4096));
+    
+    std::cout << "✓ FFTPlan real transform test passed" << std::endl;
+}
+
+void test_fft_shared_tables() {
+    std::cout << "Testing shared FFT plans and windows..." << std::endl;
+    
+    // One plan and one window per size, whoever asks first
+    auto plan = sharedFFTPlan<double>(1024);
+    assert(plan == sharedFFTPlan<double>(1024));
+    assert(plan != sharedFFTPlan<double>(2048));
+    assert(plan != sharedFFTPlan<double>(1024, FFTAlgorithm::RADIX2));
+    assert(plan->getSize() == 1024 && sharedFFTPlan<float>(1024)->getSize() == 1024);
+    
+    auto window = sharedHannWindow<double>(1024);
+    assert(window == sharedHannWindow<double>(1024) && window->size() == 1024);
+    assert((*window)[0] == 0.0 && std::abs((*window)[1023]) < 1e-15);
+    assert(std::abs((*sharedHannWindow<float>(1024))[300] - (*window)[300]) < 1e-7);
+    
+    bool threw = false;
+    try {
+        sharedFFTPlan<double>(1000);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Concurrent first requests agree on a single table
+    std::vector<std::shared_ptr<const FFTPlan>> plans(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < plans.size(); ++i) {
+        threads.emplace_back([&plans, i] { plans[i] = sharedFFTPlan<double>(1u << 15); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& shared : plans) {
+        assert(shared == plans[0]);
+    }
+    
+    std::cout << "✓ Shared FFT table test passed" << std::endl;
+}
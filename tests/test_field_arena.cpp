@@ -0,0 +1,124 @@
+#include "anantasound_core.hpp"
+#include "field_arena.hpp"
+#include "mechanical_devices.hpp"
+#include "quantum_feedback_system.hpp"
+#include "qrd_integration.hpp"
+#include "thread_pool.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_field_arena() {
+    std::cout << "Testing FieldArena..." << std::endl;
+
+    // Bump allocation: aligned, counted, rewound by reset without freeing
+    FieldArena arena(1024);
+    assert(arena.getBlockCount() == 0 && arena.getCapacity() == 0);
+    void* first = arena.allocate(10, 1);
+    void* aligned = arena.allocate(64, 64);
+    assert(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+    assert(arena.getBytesAllocated() == 74 && arena.getBlockCount() == 1);
+    void* large = arena.allocate(4000, 8);                     // Larger than a block
+    assert(arena.getBlockCount() == 2 && arena.getCapacity() >= 1024 + 4000);
+    size_t capacity = arena.getCapacity();
+    arena.reset();
+    assert(arena.getBytesAllocated() == 0);
+    assert(arena.allocate(10, 1) == first);
+    assert(arena.allocate(64, 64) == aligned);
+    assert(arena.allocate(4000, 8) == large);
+    assert(arena.getBlockCount() == 2 && arena.getCapacity() == capacity);
+    assert(arena.is_equal(arena) && !arena.is_equal(FieldArena::threadLocal()));
+
+    // Each thread has its own arena
+    FieldArena* worker_arena = nullptr;
+    std::thread worker([&worker_arena]() { worker_arena = &FieldArena::threadLocal(); });
+    worker.join();
+    assert(worker_arena != &FieldArena::threadLocal());
+
+    // One tick through every field producer
+    AnantaSoundCore core(10.0, 5.0);
+    assert(core.initialize());
+    std::vector<QuantumSoundField> input;
+    for (int i = 0; i < 32; ++i) {
+        input.push_back(core.createQuantumSoundField(200.0 + 10.0 * i, {1.0 + 0.1 * i, 0.5, 0.25, 1.0},
+                                                     i % 2 ? QuantumSoundState::COHERENT : QuantumSoundState::SUPERPOSITION));
+    }
+    core.processSoundFields(input);
+
+    SphericalCoord position{1.0, M_PI/4, M_PI/4, 1.0};
+    MechanicalDeviceManager manager;
+    auto cluster = std::make_shared<KarmicCluster>(position, 5);
+    auto mercy = std::make_shared<SpiritualMercy>(position, 0.3);
+    auto resonator = std::make_shared<QuantumResonanceDevice>(position, 300.0);
+    manager.addDevice(cluster);
+    manager.addDevice(mercy);
+    manager.addDevice(resonator);
+
+    QuantumFeedbackSystem feedback;
+    feedback.setQuantumMode(true);
+    QuantumPhaseSynchronizer sync;
+    QRDIntegration qrd;
+    qrd.activateQRD(432.0, 1.0);
+    ThreadPool pool(2);
+
+    FieldArena tick_arena;
+    size_t allocations = 0;
+    for (int tick = 0; tick < 8; ++tick) {
+        tick_arena.reset();
+        size_t before = TestSupport::allocationCount();
+
+        FieldVector output = core.getOutputFields(tick_arena);
+        FieldVector devices = manager.generateAllDeviceFields(tick_arena);
+        FieldVector devices_parallel = manager.generateAllDeviceFields(tick_arena, pool);
+        FieldVector karmic = cluster->generateKarmicFields(tick_arena);
+        FieldVector merciful = mercy->generateMercyFields(tick_arena);
+        FieldVector harmonics = resonator->generateResonanceFields(tick_arena);
+        FieldVector echoes = feedback.generateQuantumFeedback(output[0], 4, tick_arena);
+        FieldVector qrd_fields = qrd.generateResonanceFields(position, 6, tick_arena);
+        FieldVector synchronized = sync.synchronizePhases(input, tick_arena);
+        if (tick >= 2) {
+            allocations += TestSupport::allocationCount() - before;
+        }
+
+        assert(output.get_allocator().resource() == &tick_arena);
+        assert(echoes.size() == 4 && qrd_fields.size() == 6);
+
+        // Same contents as the std::vector overloads
+        auto reference_output = core.getOutputFields();
+        auto reference_devices = manager.generateAllDeviceFields();
+        auto reference_sync = sync.synchronizePhases(input);
+        auto reference_qrd = qrd.generateResonanceFields(position, 6);
+        assert(output.size() == reference_output.size() && devices.size() == reference_devices.size());
+        assert(devices_parallel.size() == devices.size());
+        assert(karmic.size() + merciful.size() + harmonics.size() == devices.size());
+        for (size_t i = 0; i < output.size(); ++i) {
+            assert(output[i].phase == reference_output[i].phase);
+        }
+        for (size_t i = 0; i < devices.size(); ++i) {
+            assert(devices[i].frequency == reference_devices[i].frequency);
+            assert(devices_parallel[i].phase == reference_devices[i].phase);
+        }
+        for (size_t i = 0; i < synchronized.size(); ++i) {
+            assert(synchronized[i].phase == reference_sync[i].phase);
+        }
+        for (size_t i = 0; i < qrd_fields.size(); ++i) {
+            assert(qrd_fields[i].frequency == reference_qrd[i].frequency);
+        }
+        core.update(0.01);
+    }
+    assert(allocations == 0);
+
+    // Inactive producers hand back empty vectors on the arena
+    qrd.deactivateQRD();
+    feedback.setQuantumMode(false);
+    assert(qrd.generateResonanceFields(position, 6, tick_arena).empty());
+    assert(feedback.generateQuantumFeedback(input[0], 4, tick_arena).empty());
+
+    std::cout << "✓ FieldArena test passed" << std::endl;
+}
@@ -0,0 +1,186 @@
+#include "field_distribution.hpp"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+// In-process transport that can lose datagrams on purpose
+class LoopbackTransport : public FieldTransport {
+private:
+    std::mutex mutex_;
+    std::deque<std::vector<uint8_t>> queue_;
+
+public:
+    size_t drop_next = 0;
+
+    bool send(const void* data, size_t size) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (drop_next > 0) {
+            --drop_next;
+            return true;
+        }
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        queue_.emplace_back(bytes, bytes + size);
+        return true;
+    }
+
+    size_t receive(void* buffer, size_t capacity, std::chrono::microseconds timeout) override {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        do {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!queue_.empty()) {
+                    size_t size = std::min(capacity, queue_.front().size());
+                    std::copy(queue_.front().begin(), queue_.front().begin() + size, static_cast<uint8_t*>(buffer));
+                    queue_.pop_front();
+                    return size;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        } while (std::chrono::steady_clock::now() < deadline);
+        return 0;
+    }
+};
+
+bool waitFor(const std::function<bool()>& predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+std::vector<QuantumSoundField> makeFields(AnantaSoundCore& core, size_t count) {
+    std::vector<QuantumSoundField> fields;
+    for (size_t i = 0; i < count; ++i) {
+        fields.push_back(core.createQuantumSoundField(100.0 + 7.0 * i, {1.0 + 0.05 * i, 0.02 * i, 0.03 * i},
+                                                      QuantumSoundState::COHERENT));
+    }
+    return fields;
+}
+
+} // namespace
+
+void test_field_distribution() {
+    std::cout << "Testing networked field distribution..." << std::endl;
+
+    AnantaSoundCore core(10.0, 5.0);
+    assert(core.initialize());
+    std::vector<QuantumSoundField> fields = makeFields(core, 100);
+
+    LoopbackTransport transport;
+    FieldPublisher publisher(transport, 1, core.getDomeRadius(), 4);
+    FieldSubscriber subscriber(transport, 2, core.getClock(), std::chrono::milliseconds(100),
+                               std::chrono::milliseconds(1));
+    assert(subscriber.start());
+
+    // Keyframe: the whole set, split over datagrams
+    assert(publisher.publish(fields));
+    assert(publisher.getDatagramsSent() == (100 + kMaxEntriesPerDatagram - 1) / kMaxEntriesPerDatagram);
+    assert(waitFor([&] { return subscriber.getRemoteFields()->fields.size() == 100; }));
+    auto remote = subscriber.getRemoteFields();
+    assert(remote->nodes.size() == 1 && remote->nodes[0] == 1);
+    for (size_t i = 0; i < fields.size(); ++i) {
+        assert(std::abs(remote->fields[i].frequency - fields[i].frequency) < 1e-3);
+        assert(std::abs(remote->fields[i].position.r - fields[i].position.r) < 1e-3);
+        assert(remote->fields[i].quantum_state == fields[i].quantum_state);
+    }
+
+    // Merged into a local field next to its own sources
+    InterferenceField local(InterferenceFieldType::CONSTRUCTIVE, {0.0, 0.0, 0.0}, 10.0);
+    local.addSourceField(fields[0]);
+    local.addSourceField(fields[1]);
+    RemoteFieldMerge merge(local);
+    assert(merge.update(subscriber) && merge.getMergedCount() == 100);
+    assert(local.getSourceCount() == 102);
+    assert(!merge.update(subscriber));
+
+    // Deltas: only changed fields travel, new timestamps alone do not count
+    core.update(0.01);
+    fields[3].amplitude = {0.5, 0.0};
+    fields[40].frequency = 880.0;
+    fields[99].timestamp = core.getClock().now();
+    uint64_t entries = publisher.getEntriesSent();
+    assert(publisher.publish(fields));
+    assert(publisher.getEntriesSent() - entries == 2);
+    assert(waitFor([&] { return std::abs(subscriber.getRemoteFields()->fields[40].frequency - 880.0) < 1e-3; }));
+    assert(std::abs(subscriber.getRemoteFields()->fields[3].amplitude.real() - 0.5) < 1e-6);
+
+    // A lost delta is repaired by the next keyframe (frame 4)
+    fields[7].frequency = 1234.0;
+    transport.drop_next = 1;
+    assert(publisher.publish(fields));
+    assert(publisher.publish(fields));
+    entries = publisher.getEntriesSent();
+    assert(publisher.publish(fields));
+    assert(publisher.getEntriesSent() - entries == 100);
+    assert(waitFor([&] { return std::abs(subscriber.getRemoteFields()->fields[7].frequency - 1234.0) < 1e-2; }));
+    assert(merge.update(subscriber) && local.getSourceCount() == 102);
+
+    // Own datagrams and garbage are ignored
+    FieldPublisher self(transport, 2, 10.0);
+    assert(self.publish(fields));
+    uint8_t garbage[40] = {};
+    transport.send(garbage, sizeof(garbage));
+    assert(waitFor([&] { return subscriber.getDatagramsRejected() == 1; }));
+    assert(subscriber.getRemoteFields()->nodes.size() == 1);
+
+    // A silent node expires and its sources leave the local field
+    assert(waitFor([&] { return subscriber.getRemoteFields()->fields.empty(); }));
+    assert(merge.update(subscriber) && merge.getMergedCount() == 0);
+    assert(local.getSourceCount() == 2);
+    subscriber.stop();
+
+    // A keyframe is applied only once all its datagrams are in: with one
+    // lost, the node stays out (no zeroed fields) until the next keyframe
+    LoopbackTransport lossy;
+    FieldSubscriber assembling(lossy, 2, core.getClock(), std::chrono::seconds(5), std::chrono::milliseconds(1));
+    assert(assembling.start());
+    FieldPublisher first(lossy, 1, core.getDomeRadius(), 2);
+    lossy.drop_next = 1;
+    assert(first.publish(fields));
+    assert(first.publish(fields));
+    assert(waitFor([&] { return assembling.getDatagramsReceived() == 2; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(assembling.getRemoteFields()->fields.empty());
+    assert(first.publish(fields));
+    assert(waitFor([&] { return assembling.getRemoteFields()->fields.size() == 100; }));
+
+    // A restarted publisher counts frames from 0 again in a new session;
+    // its first keyframe replaces the node's set right away
+    FieldPublisher restarted(lossy, 1, core.getDomeRadius(), 2);
+    assert(restarted.getSession() != first.getSession());
+    assert(restarted.publish(std::vector<QuantumSoundField>(fields.begin(), fields.begin() + 30)));
+    assert(waitFor([&] { return assembling.getRemoteFields()->fields.size() == 30; }));
+    assert(std::abs(assembling.getRemoteFields()->fields[7].frequency - fields[7].frequency) < 1e-2);
+    assembling.stop();
+
+    // The same exchange over UDP loopback
+    UdpFieldTransport sender;
+    UdpFieldTransport receiver;
+    if (sender.open() && receiver.open()) {
+        assert(sender.addPeer("127.0.0.1", receiver.getPort()));
+        assert(!sender.addPeer("not an address", 1));
+        FieldPublisher udp_publisher(sender, 7, core.getDomeRadius());
+        FieldSubscriber udp_subscriber(receiver, 8, core.getClock());
+        assert(udp_subscriber.start());
+        assert(udp_publisher.publish(fields));
+        assert(waitFor([&] { return udp_subscriber.getRemoteFields()->fields.size() == 100; }));
+        assert(udp_subscriber.getRemoteFields()->nodes[0] == 7);
+        udp_subscriber.stop();
+    }
+
+    std::cout << "✓ Networked field distribution test passed" << std::endl;
+}
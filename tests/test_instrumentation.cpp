@@ -0,0 +1,159 @@
+#include "instrumentation.hpp"
+#include "anantasound_core.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+const StageStatistics* findStage(const InstrumentationStatistics& statistics, const char* name) {
+    for (const auto& stage : statistics.stages) {
+        if (std::strcmp(stage.name, name) == 0) {
+            return &stage;
+        }
+    }
+    return nullptr;
+}
+
+const LockStatistics* findLock(const InstrumentationStatistics& statistics, const char* name) {
+    for (const auto& lock : statistics.locks) {
+        if (std::strcmp(lock.name, name) == 0) {
+            return &lock;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+void test_latency_histogram() {
+    std::cout << "Testing LatencyHistogram..." << std::endl;
+
+    // Small values are exact; every bucket bound lies within 12.5% above its values
+    for (uint64_t value = 0; value < 8; ++value) {
+        assert(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(value)) == value);
+    }
+    for (uint64_t value : {8ull, 9ull, 15ull, 16ull, 17ull, 1000ull, 123456789ull, ~0ull}) {
+        size_t index = LatencyHistogram::bucketIndex(value);
+        assert(index < LatencyHistogram::kBucketCount);
+        uint64_t bound = LatencyHistogram::bucketUpperBound(index);
+        assert(bound >= value);
+        assert(static_cast<double>(bound - value) <= 0.125 * static_cast<double>(value));
+        assert(index == 0 || LatencyHistogram::bucketUpperBound(index - 1) < value);
+    }
+
+    // 1..1000: percentiles land on the right values up to the bucket width
+    LatencyHistogram histogram;
+    assert(histogram.getCount() == 0 && histogram.getPercentile(0.5) == 0 && histogram.getMin() == 0);
+    for (uint64_t value = 1; value <= 1000; ++value) {
+        histogram.record(value);
+    }
+    assert(histogram.getCount() == 1000 && histogram.getTotal() == 500500);
+    assert(histogram.getMin() == 1 && histogram.getMax() == 1000);
+    uint64_t p50 = histogram.getPercentile(0.50);
+    uint64_t p99 = histogram.getPercentile(0.99);
+    assert(p50 >= 500 && p50 <= 500 * 9 / 8);
+    assert(p99 >= 990 && p99 <= 1000);
+    assert(histogram.getPercentile(1.0) == 1000);
+    histogram.reset();
+    assert(histogram.getCount() == 0 && histogram.getMax() == 0);
+
+    std::cout << "✓ LatencyHistogram test passed" << std::endl;
+}
+
+void test_instrumentation() {
+    std::cout << "Testing Instrumentation..." << std::endl;
+
+    Instrumentation& instrumentation = Instrumentation::shared();
+    instrumentation.reset();
+    instrumentation.setAllocationCounter(&TestSupport::allocationCount);
+
+    // Registration is keyed by name and shared between call sites
+    StageSlot* stage = instrumentation.registerStage("test.stage");
+    assert(stage != nullptr && instrumentation.registerStage("test.stage") == stage);
+    LockSlot* lock_slot = instrumentation.registerLock("test.mutex");
+    assert(lock_slot != nullptr && instrumentation.registerLock("test.mutex") == lock_slot);
+
+    // Stage timers record latency and the allocations made inside the scope
+    instrumentation.setTraceEnabled(true);
+    for (int i = 0; i < 10; ++i) {
+        ScopedStageTimer timer(stage);
+        std::vector<int> scratch(16, i);
+        assert(scratch.size() == 16);
+    }
+    instrumentation.setTraceEnabled(false);
+    {
+        ScopedStageTimer timer(stage);          // Counted, but not traced
+    }
+
+    // Uncontended and contended acquisitions
+    std::mutex mutex;
+    {
+        InstrumentedLockGuard<std::mutex> guard(mutex, lock_slot);
+    }
+    mutex.lock();
+    std::thread waiter([&] {
+        InstrumentedLockGuard<std::mutex> guard(mutex, lock_slot);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    mutex.unlock();
+    waiter.join();
+
+    InstrumentationStatistics statistics = instrumentation.getStatistics();
+    assert(statistics.enabled == Instrumentation::isEnabled());
+    const StageStatistics* timed = findStage(statistics, "test.stage");
+    assert(timed && timed->count == 11 && timed->allocations == 10);
+    assert(timed->min_ns <= timed->p50_ns && timed->p50_ns <= timed->p99_ns && timed->p99_ns <= timed->max_ns);
+    const LockStatistics* lock = findLock(statistics, "test.mutex");
+    assert(lock && lock->acquisitions == 2 && lock->contended == 1);
+    assert(lock->total_wait_ns > 0 && lock->max_wait_ns == lock->total_wait_ns);
+    assert(statistics.trace_events == 10 && statistics.dropped_trace_events == 0);
+
+    // Chrome trace: one complete event per traced scope
+    std::string path = (std::filesystem::temp_directory_path() / "anantasound_trace.json").string();
+    assert(instrumentation.exportChromeTrace(path));
+    std::ifstream file(path);
+    std::string trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    assert(trace.rfind("{\"traceEvents\":[", 0) == 0);
+    size_t events = 0;
+    for (size_t at = trace.find("\"ph\":\"X\""); at != std::string::npos; at = trace.find("\"ph\":\"X\"", at + 1)) {
+        ++events;
+    }
+    assert(events == 10 && trace.find("\"name\":\"test.stage\"") != std::string::npos);
+    std::remove(path.c_str());
+    assert(!instrumentation.exportChromeTrace("/nonexistent/dir/trace.json"));
+
+    // The library's own hot paths report only when built with instrumentation
+    instrumentation.reset();
+    AnantaSoundCore core(3.0, 2.0);
+    assert(core.initialize());
+    core.processSoundField(core.createQuantumSoundField(432.0, {1.0, 0.5, 0.5, 1.0}, QuantumSoundState::COHERENT));
+    core.update(0.01);
+    statistics = instrumentation.getStatistics();
+    const StageStatistics* update = findStage(statistics, "core.update");
+    const LockStatistics* core_lock = findLock(statistics, "AnantaSoundCore::core_mutex_");
+    if (Instrumentation::isEnabled()) {
+        assert(update && update->count == 1);
+        assert(core_lock && core_lock->acquisitions >= 2);
+    } else {
+        assert(!update && !core_lock);
+    }
+    core.shutdown();
+
+    instrumentation.reset();
+    instrumentation.setAllocationCounter(nullptr);
+    assert(instrumentation.getStatistics().trace_events == 0);
+
+    std::cout << "✓ Instrumentation test passed" << std::endl;
+}
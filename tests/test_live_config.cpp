@@ -0,0 +1,168 @@
+#include "live_config.hpp"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+// Replace the file atomically so the watcher never sees it half written
+void writeFile(const std::string& path, const std::string& text) {
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        file << text;
+    }
+    std::rename(temporary.c_str(), path.c_str());
+}
+
+} // namespace
+
+void test_live_config() {
+    std::cout << "Testing live configuration..." << std::endl;
+
+    // Parsing: listed keys override, missing keys keep library defaults
+    LiveConfig config;
+    std::string error;
+    bool parsed = parseLiveConfig(
+        "# show settings\n"
+        "[adaptive]\n"
+        "sensitivity = 0.4\n"
+        "[preset.calm]\n"
+        "volume = 0.6   ; quieter\n"
+        "reverb = 0.9\n"
+        "[breathing]\n"
+        "rate_min = 6\n"
+        "rapid = 30\n"
+        "[feedback]\n"
+        "gain = 2.5\n"
+        "quantum_mode = off\n",
+        config, &error);
+    assert(parsed);
+    const LiveConfig defaults;
+    assert(config.adaptive.adaptation_sensitivity == 0.4);
+    assert(config.adaptive.presets[0].volume_multiplier == 0.6);
+    assert(config.adaptive.presets[0].reverb_amount == 0.9);
+    assert(config.adaptive.presets[0].bass_boost == defaults.adaptive.presets[0].bass_boost);
+    assert(config.adaptive.presets[1].volume_multiplier == defaults.adaptive.presets[1].volume_multiplier);
+    assert(config.breathing.normal_rate_min == 6.0 && config.breathing.rapid_rate == 30.0);
+    assert(config.breathing.normal_rate_max == defaults.breathing.normal_rate_max);
+    assert(config.feedback.feedback_gain == 2.5 && !config.feedback.quantum_mode && config.feedback.feedback_enabled);
+
+    // Typos are rejected with a line number and leave the config untouched
+    LiveConfig untouched = config;
+    assert(!parseLiveConfig("[breathing]\nrate_mni = 4\n", config, &error));
+    assert(error.find("line 2") != std::string::npos);
+    assert(!parseLiveConfig("[feedback]\ngain = loud\n", config, &error));
+    assert(!parseLiveConfig("[preset.sleepy]\nvolume = 1\n", config, &error));
+    assert(config.breathing.normal_rate_min == untouched.breathing.normal_rate_min);
+
+    // Attached targets get the current snapshot at once and each new one
+    LiveConfigStore store;
+    assert(store.getVersion() == 0);
+    AdaptiveAudioProcessor processor(1024, 44100);
+    assert(processor.initialize());
+    BreathingAnalyzer breathing(1024, 44100);
+    assert(breathing.initialize());
+    QuantumFeedbackSystem feedback(4.0, 0.9);
+    store.attach(processor);
+    store.attach(breathing);
+    store.attach(feedback);
+    assert(feedback.getFeedbackGain() == 1.0 && feedback.getQuantumThreshold() == 0.5);
+
+    uint64_t version = store.publish(config);
+    assert(version == 1 && store.getVersion() == 1 && store.current()->version == 1);
+    assert(processor.getAdaptationSensitivity() == 0.4);
+    assert(processor.getAdaptationParameters(EmotionalState::CALM).volume_multiplier == 0.6);
+    assert(breathing.getThresholds().normal_rate_min == 6.0);
+    assert(feedback.getFeedbackGain() == 2.5 && !feedback.getSettings().quantum_mode);
+
+    // A held snapshot never changes under its reader
+    std::shared_ptr<const LiveConfig> held = store.current();
+    LiveConfig louder = config;
+    louder.feedback.feedback_gain = 3.0;
+    store.publish(louder);
+    assert(held->version == 1 && held->feedback.feedback_gain == 2.5);
+    assert(store.getVersion() == 2 && feedback.getFeedbackGain() == 3.0);
+
+    // File reload: poll() picks up a rewrite; a broken file keeps the old config
+    const std::string path = "/tmp/anantasound_live_config_test.ini";
+    writeFile(path, "[feedback]\ngain = 5\n");
+    assert(store.loadFile(path));
+    assert(store.getVersion() == 3 && feedback.getFeedbackGain() == 5.0);
+    assert(!store.poll());                                      // Unchanged
+    writeFile(path, "[feedback]\ngain = 7.25\n[breathing]\ndeep = 0.8\n");
+    assert(store.poll());
+    assert(store.getVersion() == 4 && feedback.getFeedbackGain() == 7.25);
+    assert(breathing.getThresholds().deep_depth == 0.8);
+    assert(processor.getAdaptationSensitivity() == defaults.adaptive.adaptation_sensitivity);
+    writeFile(path, "[feedback]\ngian = 1\n");
+    assert(!store.poll());
+    assert(store.getVersion() == 4 && feedback.getFeedbackGain() == 7.25);
+
+    // Watcher thread reloads on its own
+    store.startWatching(std::chrono::milliseconds(5));
+    assert(store.isWatching());
+    writeFile(path, "[feedback]\ngain = 0.5\nenabled = false\n");
+    for (int i = 0; i < 400 && store.getVersion() == 4; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    store.stopWatching();
+    assert(!store.isWatching());
+    assert(store.getVersion() == 5 && feedback.getFeedbackGain() == 0.5);
+    assert(!feedback.getSettings().feedback_enabled);
+    std::remove(path.c_str());
+
+    // Publishing while other threads process: every block runs to completion
+    // and the last published values are what the targets end up with
+    std::vector<double> audio(4096);
+    for (size_t i = 0; i < audio.size(); ++i) {
+        audio[i] = 0.3 * std::sin(2.0 * M_PI * 440.0 * i / 44100.0);
+    }
+    std::vector<QuantumSoundField> fields(16);
+    for (size_t i = 0; i < fields.size(); ++i) {
+        fields[i].frequency = 100.0 * (i + 1);
+        fields[i].amplitude = std::complex<double>(0.1, 0.05 * i);
+    }
+    std::atomic<bool> running(true);
+    std::atomic<size_t> blocks(0);
+    std::thread audio_thread([&]() {
+        while (running.load()) {
+            AdaptationResult result = processor.processAudio(audio);
+            assert(!result.processed_audio.empty());
+            breathing.analyzeBreathing(audio);
+            feedback.processFeedback(fields[0], fields);
+            blocks.fetch_add(1);
+        }
+    });
+    for (int i = 0; i < 50; ++i) {
+        LiveConfig next = config;
+        next.adaptive.adaptation_sensitivity = 0.01 * i;
+        next.breathing.rapid_rate = 25.0 + i;
+        next.feedback.feedback_gain = 0.1 * i;
+        store.publish(next);
+    }
+    while (blocks.load() < 2) {
+        std::this_thread::yield();
+    }
+    running = false;
+    audio_thread.join();
+    assert(processor.getAdaptationSensitivity() == 0.01 * 49);
+    assert(breathing.getThresholds().rapid_rate == 25.0 + 49);
+    assert(std::abs(feedback.getFeedbackGain() - 4.9) < 1e-12);
+
+    // Detached targets keep their last values
+    store.detach(feedback);
+    store.publish(defaults);
+    assert(std::abs(feedback.getFeedbackGain() - 4.9) < 1e-12);
+    assert(breathing.getThresholds().rapid_rate == defaults.breathing.rapid_rate);
+
+    std::cout << "✓ Live configuration test passed (version " << store.getVersion() << ")" << std::endl;
+}
@@ -5,17 +5,102 @@
 void test_consciousness_integration();
 void test_consciousness_configuration();
 void test_consciousness_state_transitions();
+void test_consciousness_ingest();
 void test_quantum_feedback_system();
+void test_batch_feedback();
 void test_quantum_resonance_detector();
+void test_resonance_tracker();
 void test_quantum_phase_synchronizer();
+void test_kuramoto_synchronizer();
+void test_quantum_noise_source();
+void test_quantum_noise_replay();
 void test_karmic_cluster();
 void test_spiritual_mercy();
 void test_quantum_resonance_device();
 void test_mechanical_device_manager();
+void test_device_field_generation();
+void test_device_field_cache();
+void test_device_clock_sync();
 void test_quantum_sound_field();
 void test_interference_field();
+void test_interference_batch();
+void test_interference_map_backend();
+void test_baked_interference();
+void test_incremental_interference();
+void test_interference_cluster_tree();
+void test_interference_ladders();
 void test_dome_acoustic_resonator();
+void test_dome_geometry_optimization();
 void test_anantasound_core();
+void test_spatial_field_index();
+void test_field_buffer();
+void test_qrd_integration();
+void test_harmonic_bank();
+void test_snapshot_reads();
+void test_quantum_acoustic_processor();
+void test_quantum_acoustic_processor_shards();
+void test_core_update_time_base();
+void test_incremental_statistics();
+void test_slot_index_and_entanglement_graph();
+void test_interference_field_handles();
+void test_field_arena();
+void test_latency_histogram();
+void test_instrumentation();
+void test_metrics_registry();
+void test_library_metrics();
+void test_thread_pool_parallel_for();
+void test_thread_pool_submit();
+void test_thread_pool_lanes();
+void test_async_operations();
+void test_processing_graph();
+void test_deadline_scheduler();
+void test_graph_degradation();
+void test_spsc_ring_buffer();
+void test_realtime_audio_bridge();
+void test_fft_complex_transform();
+void test_fft_real_transform();
+void test_fft_shared_tables();
+void test_audio_analyzer_spectrum();
+void test_audio_analyzer_pitch();
+void test_spectral_kernels_dispatch();
+void test_audio_analyzer_zero_allocation();
+void test_audio_analyzer_parallel_overlap();
+void test_audio_analyzer_feature_mask();
+void test_spectral_kernels_float();
+void test_audio_analyzer_float_path();
+void test_streaming_analyzer_frames();
+void test_streaming_analyzer_no_allocation();
+void test_tempo_tracker();
+void test_constant_q();
+void test_spatial_renderer();
+void test_oscillator_bank();
+void test_flac_decoder();
+void test_wav_reader();
+void test_audio_analyzer_load_file();
+void test_batch_analyzer();
+void test_feature_cache();
+void test_envelope_decimator();
+void test_breathing_rate_estimation();
+void test_sliding_window_stats();
+void test_breathing_state_classification();
+void test_session_pool();
+void test_scene_snapshot();
+void test_session_recorder();
+void test_packed_field_round_trip();
+void test_field_distribution();
+void test_shared_field_output();
+void test_biquad_shelf_response();
+void test_biquad_block_state();
+void test_reverb_impulse_decay();
+void test_multitap_echo_and_dome_reverb();
+void test_resampler_rate_conversion();
+void test_resampler_tempo_and_file_conversion();
+void test_effects_chain_block_continuity();
+void test_effects_chain_bypass_and_allocation();
+void test_multichannel_processing();
+void test_adaptive_processor_realtime();
+void test_emotion_classification();
+void test_live_config();
 
 int main() {
     std::cout << "Running anAntaSound Tests..." << std::endl;
@@ -27,12 +112,18 @@ int main() {
         test_consciousness_integration();
         test_consciousness_configuration();
         test_consciousness_state_transitions();
+        test_consciousness_ingest();
         
         // Quantum feedback tests
         std::cout << "\n--- Quantum Feedback Tests ---" << std::endl;
         test_quantum_feedback_system();
+        test_batch_feedback();
         test_quantum_resonance_detector();
+        test_resonance_tracker();
         test_quantum_phase_synchronizer();
+        test_kuramoto_synchronizer();
+        test_quantum_noise_source();
+        test_quantum_noise_replay();
         
         // Mechanical devices tests
         std::cout << "\n--- Mechanical Devices Tests ---" << std::endl;
@@ -40,13 +131,101 @@ int main() {
         test_spiritual_mercy();
         test_quantum_resonance_device();
         test_mechanical_device_manager();
+        test_device_field_generation();
+        test_device_field_cache();
+        test_device_clock_sync();
         
         // Core tests
         std::cout << "\n--- Core System Tests ---" << std::endl;
         test_quantum_sound_field();
         test_interference_field();
+        test_interference_batch();
+        test_interference_map_backend();
+        test_baked_interference();
+        test_incremental_interference();
+        test_interference_cluster_tree();
+        test_interference_ladders();
         test_dome_acoustic_resonator();
+        test_dome_geometry_optimization();
         test_anantasound_core();
+        test_spatial_field_index();
+        test_field_buffer();
+        test_qrd_integration();
+        test_harmonic_bank();
+        test_snapshot_reads();
+        test_quantum_acoustic_processor();
+        test_quantum_acoustic_processor_shards();
+        test_core_update_time_base();
+        test_incremental_statistics();
+        test_slot_index_and_entanglement_graph();
+        test_interference_field_handles();
+        test_field_arena();
+        test_latency_histogram();
+        test_instrumentation();
+        test_metrics_registry();
+        test_library_metrics();
+        
+        // Threading tests
+        std::cout << "\n--- Thread Pool Tests ---" << std::endl;
+        test_thread_pool_parallel_for();
+        test_thread_pool_submit();
+        test_thread_pool_lanes();
+        test_async_operations();
+        test_processing_graph();
+        test_deadline_scheduler();
+        test_graph_degradation();
+        test_spsc_ring_buffer();
+        test_realtime_audio_bridge();
+        
+        // Audio analysis tests
+        std::cout << "\n--- Audio Analysis Tests ---" << std::endl;
+        test_fft_complex_transform();
+        test_fft_real_transform();
+        test_fft_shared_tables();
+        test_audio_analyzer_spectrum();
+        test_audio_analyzer_pitch();
+        test_spectral_kernels_dispatch();
+        test_audio_analyzer_zero_allocation();
+        test_audio_analyzer_parallel_overlap();
+        test_audio_analyzer_feature_mask();
+        test_spectral_kernels_float();
+        test_audio_analyzer_float_path();
+        test_streaming_analyzer_frames();
+        test_streaming_analyzer_no_allocation();
+        test_tempo_tracker();
+        test_constant_q();
+        test_spatial_renderer();
+        test_oscillator_bank();
+        test_flac_decoder();
+        test_wav_reader();
+        test_audio_analyzer_load_file();
+        test_batch_analyzer();
+        test_feature_cache();
+        test_envelope_decimator();
+        test_breathing_rate_estimation();
+        test_sliding_window_stats();
+        test_breathing_state_classification();
+        test_session_pool();
+        test_scene_snapshot();
+        test_session_recorder();
+        test_packed_field_round_trip();
+        test_field_distribution();
+        test_shared_field_output();
+        
+        // Effects tests
+        std::cout << "\n--- Audio Effects Tests ---" << std::endl;
+        test_biquad_shelf_response();
+        test_biquad_block_state();
+        test_reverb_impulse_decay();
+        test_multitap_echo_and_dome_reverb();
+        test_resampler_rate_conversion();
+        test_resampler_tempo_and_file_conversion();
+        test_effects_chain_block_continuity();
+        test_effects_chain_bypass_and_allocation();
+        test_multichannel_processing();
+        test_adaptive_processor_realtime();
+        test_emotion_classification();
+        test_live_config();
         
         std::cout << "\n================================" << std::endl;
         std::cout << "✓ All tests passed successfully!" << std::endl;
@@ -1,8 +1,10 @@
 #include "mechanical_devices.hpp"
+#include "thread_pool.hpp"
 #include <iostream>
 #include <cassert>
 #include <cmath>
 #include <memory>
+#include <vector>
 
 using namespace AnantaSound;
 
@@ -93,4 +95,164 @@ void test_mechanical_device_manager() {
     std::cout << "✓ MechanicalDeviceManager test passed" << std::endl;
 }
 
+void test_device_field_generation() {
+    std::cout << "Testing pooled device field generation..." << std::endl;
+    
+    SphericalCoord position{1.0, M_PI/4, M_PI/4, 1.0};
+    MechanicalDeviceManager manager;
+    std::vector<std::shared_ptr<KarmicCluster>> clusters;
+    std::vector<std::shared_ptr<QuantumResonanceDevice>> resonators;
+    for (int i = 0; i < 100; ++i) {
+        clusters.push_back(std::make_shared<KarmicCluster>(position, 5));
+        resonators.push_back(std::make_shared<QuantumResonanceDevice>(position, 100.0 + i));
+        manager.addDevice(clusters.back());
+        manager.addDevice(std::make_shared<SpiritualMercy>(position, 0.01 * i));
+        manager.addDevice(resonators.back());
+    }
+    manager.addDevice(std::make_shared<MechanicalDevice>(DeviceType::KARMIC_CLUSTER, position));
+    assert(manager.getDeviceCount() == 301);
+    
+    // Counts match what the per-device generators produce
+    clusters[0]->deactivateElement(2);
+    clusters[1]->setActive(false);
+    resonators[3]->setQuantumCoherence(0.6);
+    assert(clusters[0]->getFieldCount() == clusters[0]->generateKarmicFields().size());
+    assert(clusters[1]->getFieldCount() == 0);
+    std::vector<QuantumSoundField> fields;
+    manager.generateAllDeviceFields(fields);
+    assert(fields.size() == 4 + 98 * 5 + 100 * 7 + 100 * 8);
+    
+    // Grouped by kind, in insertion order within a kind; state changes through
+    // the shared pointers are visible without re-adding
+    assert(fields[0].frequency == 432.0 && fields[2].frequency == 432.0 + 3 * 111.0);
+    assert(fields[4].quantum_state == QuantumSoundState::COHERENT);
+    size_t resonance_start = 4 + 98 * 5 + 100 * 7;
+    assert(fields[resonance_start].frequency == 100.0);
+    assert(fields[resonance_start + 3 * 8].quantum_state == QuantumSoundState::SUPERPOSITION);
+    auto allocated = manager.generateAllDeviceFields();
+    assert(allocated.size() == fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+        assert(allocated[i].frequency == fields[i].frequency && allocated[i].amplitude == fields[i].amplitude);
+    }
+    
+    // Removal drops the device from its pool; the buffer is reused
+    const QuantumSoundField* storage = fields.data();
+    manager.removeDevice(2);
+    manager.generateAllDeviceFields(fields);
+    assert(fields.size() == 4 + 98 * 5 + 100 * 7 + 99 * 8);
+    assert(fields.data() == storage);
+    assert(fields[resonance_start].frequency == 101.0);
+    
+    std::cout << "✓ Pooled device field generation test passed" << std::endl;
+}
 
+void test_device_field_cache() {
+    std::cout << "Testing cached device field generation..." << std::endl;
+    
+    SphericalCoord position{1.0, M_PI/4, M_PI/4, 1.0};
+    auto resonator = std::make_shared<QuantumResonanceDevice>(position, 200.0);
+    assert(resonator->areFieldsDirty());
+    auto first = resonator->generateResonanceFields();
+    assert(!resonator->areFieldsDirty());
+    
+    // Cache hits keep the generation timestamp; setters invalidate the cache
+    auto cached = resonator->generateResonanceFields();
+    assert(cached[0].timestamp == first[0].timestamp);
+    resonator->setResonanceFrequency(300.0);
+    assert(resonator->areFieldsDirty());
+    assert(resonator->generateResonanceFields()[1].frequency == 600.0);
+    resonator->setActive(false);
+    assert(resonator->getCachedFields().empty());
+    resonator->setActive(true);
+    
+    auto cluster = std::make_shared<KarmicCluster>(position, 3);
+    cluster->generateKarmicFields();
+    cluster->updateKarmicCharge(1, 0.5);
+    assert(cluster->areFieldsDirty());
+    assert(cluster->generateKarmicFields()[1].phase == 0.5 * M_PI);
+    
+    // The manager rebuilds only stale devices, serially or on a pool
+    MechanicalDeviceManager manager;
+    std::vector<std::shared_ptr<SpiritualMercy>> mercies;
+    for (int i = 0; i < 200; ++i) {
+        mercies.push_back(std::make_shared<SpiritualMercy>(position, 0.004 * i));
+        manager.addDevice(mercies.back());
+    }
+    manager.addDevice(resonator);
+    manager.addDevice(resonator);
+    ThreadPool pool(3);
+    std::vector<QuantumSoundField> parallel, serial;
+    manager.generateAllDeviceFields(parallel, pool);
+    assert(parallel.size() == 200 * 7 + 2 * 8);
+    for (const auto& mercy : mercies) {
+        assert(!mercy->areFieldsDirty());
+    }
+    
+    auto stamp = parallel[7 * 10].timestamp;
+    mercies[20]->setMercyLevel(1.0);
+    manager.generateAllDeviceFields(serial);
+    assert(serial[7 * 10].timestamp == stamp);
+    assert(serial[7 * 20].amplitude.real() == 1.0);
+    manager.generateAllDeviceFields(parallel, pool);
+    for (size_t i = 0; i < serial.size(); ++i) {
+        assert(parallel[i].amplitude == serial[i].amplitude && parallel[i].frequency == serial[i].frequency);
+    }
+    
+    std::cout << "✓ Cached device field generation test passed" << std::endl;
+}
+
+void test_device_clock_sync() {
+    std::cout << "Testing sample clock device synchronization..." << std::endl;
+    
+    // Ticks are whole samples; timestamps derive from the origin, not the wall clock
+    SampleClock clock(1000.0);
+    assert(clock.current().sample == 0 && clock.now() == clock.getOrigin());
+    ClockTick tick = clock.advanceSeconds(0.0125);
+    assert(tick.sample == 13 && std::abs(tick.seconds - 0.013) < 1e-12);
+    assert(clock.advance(7).sample == 20 && clock.current().sample == 20);
+    assert(clock.advanceSeconds(-1.0).sample == 20);
+    assert(clock.tickAt(20).timestamp == clock.now() && clock.now() > clock.getOrigin());
+    
+    SphericalCoord position{1.0, M_PI/4, M_PI/4, 1.0};
+    MechanicalDeviceManager manager;
+    auto cluster = std::make_shared<KarmicCluster>(position, 4);
+    auto mercy = std::make_shared<SpiritualMercy>(position, 0.5);
+    auto resonator = std::make_shared<QuantumResonanceDevice>(position, 441.3);
+    manager.addDevice(cluster);
+    manager.addDevice(mercy);
+    manager.addDevice(resonator);
+    
+    // Every field of a tick shares one timestamp; phases lock to 2π·f·t
+    ClockTick first = clock.advance(480);
+    manager.synchronizeDevices(first);
+    std::vector<QuantumSoundField> fields;
+    manager.generateAllDeviceFields(fields);
+    assert(fields.size() == 4 + 7 + 8);
+    for (const auto& field : fields) {
+        assert(field.timestamp == first.timestamp);
+    }
+    double expected = M_PI / 4.0 + std::remainder(2.0 * M_PI * 441.3 * first.seconds, 2.0 * M_PI);
+    assert(std::abs(std::remainder(fields[4 + 7].phase - expected, 2.0 * M_PI)) < 1e-9);
+    
+    // Re-phasing clean caches in place matches a full regeneration at the new tick
+    ClockTick second = clock.advance(1234567);
+    manager.synchronizeDevices(second);
+    assert(!resonator->areFieldsDirty());
+    std::vector<QuantumSoundField> aligned;
+    manager.generateAllDeviceFields(aligned);
+    std::vector<QuantumSoundField> fresh(resonator->getFieldCount());
+    resonator->writeResonanceFields(fresh.data());
+    for (size_t i = 0; i < fresh.size(); ++i) {
+        const auto& field = aligned[4 + 7 + i];
+        assert(field.timestamp == second.timestamp && fresh[i].timestamp == second.timestamp);
+        double delta = std::remainder(field.phase - fresh[i].phase, 2.0 * M_PI);
+        assert(std::abs(delta) < 1e-6);
+    }
+    
+    // Without auto-sync the devices keep their tick
+    manager.setAutoSyncEnabled(false);
+    manager.synchronizeDevices(clock.advance(10));
+    assert(mercy->getClockTick().sample == second.sample);
+    
+    std::cout << "✓ Sample clock device synchronization test passed" << std::endl;
+}
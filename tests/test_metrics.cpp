@@ -0,0 +1,148 @@
+#include "metrics.hpp"
+#include "adaptive_audio_processor.hpp"
+#include "anantasound_core.hpp"
+#include "realtime_audio_bridge.hpp"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_metrics_registry() {
+    std::cout << "Testing MetricsRegistry..." << std::endl;
+
+    // Slots are keyed by name and component
+    MetricsRegistry registry;
+    CounterSlot* samples = registry.registerCounter("processed_samples", "test");
+    assert(samples && registry.registerCounter("processed_samples", "test") == samples);
+    CounterSlot* other = registry.registerCounter("processed_samples", "other");
+    assert(other && other != samples);
+    samples->add(1024);
+    samples->add(512);
+    other->add();
+    registry.registerGauge("degradation_level", "test")->set(2.0);
+
+    // Calls over budget count as deadline misses
+    StageMetricSlot* stage = registry.registerStage("test.tick", 1000000);
+    assert(registry.registerStage("test.tick", 5) == stage && stage->budget_ns.load() == 1000000);
+    stage->record(200000);
+    stage->record(3000000);
+    stage->record(900000);
+    registry.setStageBudget("test.tick", 100000);
+    stage->record(200000);
+
+    MetricsSnapshot snapshot = registry.snapshot();
+    assert(snapshot.counter("processed_samples", "test") == 1536);
+    assert(snapshot.counter("processed_samples", "other") == 1);
+    assert(snapshot.counter("ticks", "test") == 0);
+    const StageMetricValue* tick = snapshot.stage("test.tick");
+    assert(tick && tick->count == 4 && tick->deadline_misses == 2 && tick->budget_ns == 100000);
+    assert(tick->max_ns == 3000000 && tick->total_ns == 4300000);
+
+    // OpenMetrics exposition: one family per name, seconds, terminated by # EOF
+    std::string text = registry.toOpenMetrics();
+    assert(text.find("# TYPE anantasound_processed_samples counter\n") != std::string::npos);
+    assert(text.find("anantasound_processed_samples_total{component=\"test\"} 1536\n") != std::string::npos);
+    assert(text.find("anantasound_processed_samples_total{component=\"other\"} 1\n") != std::string::npos);
+    assert(text.find("# TYPE anantasound_processed_samples counter") == text.rfind("# TYPE anantasound_processed_samples counter"));
+    assert(text.find("anantasound_degradation_level{component=\"test\"} 2\n") != std::string::npos);
+    assert(text.find("anantasound_stage_latency_seconds_count{stage=\"test.tick\"} 4\n") != std::string::npos);
+    assert(text.find("anantasound_stage_latency_seconds_sum{stage=\"test.tick\"} 0.004300000\n") != std::string::npos);
+    assert(text.find("anantasound_stage_budget_seconds{stage=\"test.tick\"} 0.000100000\n") != std::string::npos);
+    assert(text.find("anantasound_stage_deadline_misses_total{stage=\"test.tick\"} 2\n") != std::string::npos);
+    assert(text.size() >= 6 && text.compare(text.size() - 6, 6, "# EOF\n") == 0);
+
+    // Textfile export lands whole
+    auto path = (std::filesystem::temp_directory_path() / "anantasound_metrics_test.prom").string();
+    assert(registry.writeOpenMetrics(path));
+    std::ifstream file(path, std::ios::binary);
+    std::string written((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    assert(written == text);
+    std::remove(path.c_str());
+
+    registry.reset();
+    snapshot = registry.snapshot();
+    assert(snapshot.counter("processed_samples", "test") == 0);
+    assert(snapshot.stage("test.tick")->count == 0 && snapshot.stage("test.tick")->budget_ns == 100000);
+
+    std::cout << "✓ MetricsRegistry test passed" << std::endl;
+}
+
+void test_library_metrics() {
+    std::cout << "Testing library metrics..." << std::endl;
+
+    MetricsRegistry& metrics = MetricsRegistry::shared();
+    MetricsSnapshot before = metrics.snapshot();
+
+    // Adaptive processor: process-wide counters and its own statistics
+    AdaptiveAudioProcessor processor(1024, 44100);
+    assert(processor.initialize());
+    std::vector<double> block(2048);
+    for (size_t i = 0; i < block.size(); ++i) {
+        block[i] = 0.4 * std::sin(2.0 * M_PI * 440.0 * i / 44100.0);
+    }
+    processor.processAudio(block);
+    processor.processAudio(block);
+    auto stats = processor.getStatistics();
+    assert(stats.total_processed_samples == 4096 && stats.total_processed_blocks == 2);
+    assert(stats.average_confidence > 0.0 && stats.average_confidence <= 1.0);
+    assert(stats.average_volume_adjustment > 0.0 && stats.average_tempo_adjustment > 0.0);
+
+    // Core updates are ticks of the 16 ms core.update stage
+    AnantaSoundCore core(3.0, 2.0);
+    assert(core.initialize());
+    for (int i = 0; i < 5; ++i) {
+        core.update(0.016);
+    }
+
+    // Driver-reported underruns and capture frames lost to a full ring
+    RealtimeAudioBridge bridge(1, 256, 512);
+    bridge.addConsumer(256, nullptr);
+    std::vector<float> capture(256, 0.1f);
+    for (int i = 0; i < 4; ++i) {
+        bridge.process(capture.data(), capture.size());
+    }
+    bridge.reportUnderrun();
+    assert(bridge.getUnderruns() == 1 && bridge.getDroppedSamples(0) == 512);
+
+    MetricsSnapshot after = metrics.snapshot();
+    auto delta = [&](const char* name, const char* component) {
+        return after.counter(name, component) - before.counter(name, component);
+    };
+    assert(delta("processed_samples", "adaptive") == 4096);
+    assert(delta("processed_blocks", "adaptive") == 2);
+    assert(delta("ticks", "core") == 5);
+    assert(delta("dropped_frames", "bridge") == 512);
+    assert(delta("buffer_underruns", "bridge") == 1);
+    const StageMetricValue* update = after.stage("core.update");
+    assert(update && update->budget_ns == static_cast<uint64_t>(AnantaSoundCore::kDecoherenceTickNs));
+    assert(update->count >= 5);
+
+    // Periodic export to a callback, with a final snapshot on stop
+    std::atomic<int> exports{0};
+    std::atomic<uint64_t> exported_ticks{0};
+    MetricsExporter exporter([&](const MetricsSnapshot& snapshot) {
+        exported_ticks = snapshot.counter("ticks", "core");
+        exports.fetch_add(1);
+    }, std::chrono::milliseconds(2));
+    assert(exporter.start() && !exporter.start());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (exports.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(exports.load() >= 2);
+    core.update(0.016);
+    exporter.stop();
+    assert(!exporter.isRunning() && exported_ticks.load() == after.counter("ticks", "core") + 1);
+
+    std::cout << "✓ Library metrics test passed" << std::endl;
+}
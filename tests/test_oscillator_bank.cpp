@@ -0,0 +1,173 @@
+#include "oscillator_bank.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_oscillator_bank() {
+    std::cout << "Testing oscillator bank..." << std::endl;
+
+    const size_t rate = 48000;
+
+    // Every kernel level renders the same samples and leaves the same state,
+    // with partial counts that leave a tail after the vector tiles
+    const size_t partial_count = 37, frames = 64;
+    std::vector<double> reference(frames, 0.0);
+    std::vector<double> expected_real;
+    for (SIMDLevel level : {SIMDLevel::SCALAR, SIMDLevel::AVX2, SIMDLevel::AVX512, SIMDLevel::NEON}) {
+        std::vector<double> real(partial_count), imag(partial_count), step_real(partial_count),
+            step_imag(partial_count), amplitude(partial_count), amplitude_step(partial_count);
+        for (size_t p = 0; p < partial_count; ++p) {
+            double omega = 0.01 + 0.05 * p;
+            real[p] = std::cos(0.3 * p);
+            imag[p] = std::sin(0.3 * p);
+            step_real[p] = std::cos(omega);
+            step_imag[p] = std::sin(omega);
+            amplitude[p] = 0.1 + 0.01 * p;
+            amplitude_step[p] = 1e-4 * (p % 3);
+        }
+        OscillatorPartials partials = {real.data(), imag.data(), step_real.data(), step_imag.data(),
+                                       amplitude.data(), amplitude_step.data(), partial_count};
+        std::vector<double> output(frames, 0.25);
+        getOscillatorKernels(level).render(partials, output.data(), frames);
+        if (level == SIMDLevel::SCALAR) {
+            reference = output;
+            expected_real = real;
+            continue;
+        }
+        for (size_t t = 0; t < frames; ++t) {
+            assert(std::abs(output[t] - reference[t]) < 1e-12);
+        }
+        for (size_t p = 0; p < partial_count; ++p) {
+            assert(std::abs(real[p] - expected_real[p]) < 1e-12);
+        }
+    }
+
+    // One partial across many blocks of uneven size is the exact sinusoid
+    OscillatorBank bank(rate);
+    const double frequency = 997.0, amplitude = 0.5, phase = 0.4;
+    bank.setPartials(&frequency, &amplitude, &phase, 1);
+    std::vector<double> block(1024);
+    bank.render(block.data(), 1);               // Fade-in block from silence
+    uint64_t t0 = 1;
+    for (size_t size : {256, 77, 1000, 513, 1024}) {
+        bank.render(block.data(), size);
+        for (size_t t = 0; t < size; ++t) {
+            double expected = amplitude * std::cos(phase + 2.0 * M_PI * frequency * (t0 + t) / rate);
+            assert(std::abs(block[t] - expected) < 1e-9);
+        }
+        t0 += size;
+    }
+    assert(bank.getPosition() == t0);
+
+    // Changing amplitude and frequency between blocks is click-free: the
+    // waveform stays continuous, with no step larger than its own slope
+    const double frequency2 = 1500.0, amplitude2 = 0.9, phase2 = 2.0;
+    double last = block[1023];
+    bank.setPartials(&frequency2, &amplitude2, &phase2, 1);
+    bank.render(block.data(), 256);
+    double max_step = 2.0 * M_PI * frequency2 / rate * amplitude2 * 1.05;
+    assert(std::abs(block[0] - last) < max_step);
+    for (size_t t = 1; t < 256; ++t) {
+        assert(std::abs(block[t] - block[t - 1]) < max_step);
+    }
+
+    // A partial dropped from the set fades out over one block and is gone
+    bank.setPartials(nullptr, nullptr, nullptr, 0);
+    bank.render(block.data(), 256);
+    assert(std::abs(block[255]) < 0.01 && bank.getPartialCount() == 0);
+    bank.render(block.data(), 256);
+    assert(std::all_of(block.begin(), block.begin() + 256, [](double s) { return s == 0.0; }));
+
+    // Fields: |A| at the field frequency, starting at phase + arg(A)
+    std::vector<QuantumSoundField> fields(3);
+    for (size_t i = 0; i < fields.size(); ++i) {
+        fields[i].frequency = 220.0 * (i + 1);
+        fields[i].amplitude = std::polar(0.2, 0.5 * i);
+        fields[i].phase = 0.1 * i;
+    }
+    OscillatorBank field_bank(rate);
+    field_bank.setFields(fields);
+    OscillatorBank buffer_bank(rate);
+    buffer_bank.setFields(FieldBuffer(fields));
+    std::vector<double> from_fields(512), from_buffer(512);
+    field_bank.render(from_fields.data(), 512);
+    field_bank.render(from_fields.data(), 512);
+    buffer_bank.render(from_buffer.data(), 512);
+    buffer_bank.render(from_buffer.data(), 512);
+    for (size_t t = 0; t < 512; ++t) {
+        double expected = 0.0;
+        for (const QuantumSoundField& field : fields) {
+            expected += std::abs(field.amplitude) *
+                        std::cos(field.phase + std::arg(field.amplitude) + 2.0 * M_PI * field.frequency * (512 + t) / rate);
+        }
+        assert(std::abs(from_fields[t] - expected) < 1e-9);
+        assert(std::abs(from_buffer[t] - expected) < 1e-9);
+    }
+
+    // Float output matches double
+    std::vector<float> float_block(512);
+    OscillatorBank float_bank(rate);
+    float_bank.setFields(fields);
+    float_bank.render(float_block.data(), 512);
+    float_bank.render(float_block.data(), 512);
+    for (size_t t = 0; t < 512; ++t) {
+        assert(std::abs(float_block[t] - from_fields[t]) < 1e-6);
+    }
+
+    // Inverse-FFT synthesis of many partials agrees with the oscillators
+    // once the first hop has faded in, across uneven block sizes
+    const size_t many = 300;
+    std::vector<double> frequencies(many), amplitudes(many), phases(many);
+    for (size_t i = 0; i < many; ++i) {
+        frequencies[i] = 50.0 + 71.3 * i;
+        amplitudes[i] = 0.002 * (1 + i % 5);
+        phases[i] = 0.9 * i;
+    }
+    OscillatorBankOptions ifft_options;
+    ifft_options.mode = OscillatorBankMode::INVERSE_FFT;
+    ifft_options.fft_size = 512;
+    OscillatorBank ifft(rate, ifft_options);
+    OscillatorBank recursive(rate);
+    ifft.setPartials(frequencies.data(), amplitudes.data(), phases.data(), many);
+    recursive.setPartials(frequencies.data(), amplitudes.data(), phases.data(), many);
+    const size_t hop = ifft_options.fft_size / 4;
+    std::vector<double> ifft_out(4096), recursive_out(4096);
+    size_t offset = 0;
+    for (size_t size : {100, 333, 1, 1000, 2662}) {
+        ifft.render(ifft_out.data() + offset, size);
+        offset += size;
+    }
+    recursive.render(recursive_out.data(), 1);
+    recursive.render(recursive_out.data() + 1, 4095);
+    double peak = 0.0, error = 0.0;
+    for (size_t t = hop + 1; t < 4096; ++t) {
+        peak = std::max(peak, std::abs(recursive_out[t]));
+        error = std::max(error, std::abs(ifft_out[t] - recursive_out[t]));
+    }
+    assert(peak > 0.1 && error < 1e-3 * peak);
+
+    // Steady-state blocks render without allocating in both modes
+    std::vector<float> float_out(256);
+    field_bank.render(float_out.data(), 256);
+    size_t before = TestSupport::allocationCount();
+    {
+        TestSupport::AllocationTrap trap;
+        for (int b = 0; b < 8; ++b) {
+            ifft.setPartials(frequencies.data(), amplitudes.data(), phases.data(), many);
+            recursive.setPartials(frequencies.data(), amplitudes.data(), phases.data(), many - b);
+            ifft.render(ifft_out.data(), 256);
+            recursive.render(ifft_out.data(), 256);
+            field_bank.setFields(fields);
+            field_bank.render(float_out.data(), 256);
+        }
+    }
+    assert(TestSupport::allocationCount() == before);
+
+    std::cout << "✓ Oscillator bank test passed (" << getOscillatorKernels().name << " kernels, "
+              << "IFFT error " << error / peak << ")" << std::endl;
+}
@@ -0,0 +1,82 @@
+#include "packed_field.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_packed_field_round_trip() {
+    std::cout << "Testing packed field round trip..." << std::endl;
+
+    AnantaSoundCore core(10.0, 5.0);
+    assert(core.initialize());
+    core.update(0.25);
+    PackedFieldCodec codec(core.getDomeRadius(), core.getClock(), core.getClock().current().sample);
+    assert(sizeof(PackedSoundField) * 3 < sizeof(QuantumSoundField));
+
+    std::vector<QuantumSoundField> fields;
+    for (int i = 0; i < 64; ++i) {
+        QuantumSoundField field = core.createQuantumSoundField(
+            55.0 + 17.3 * i, {0.15 * i, 0.049 * i, 0.1 * i - 1.0},
+            static_cast<QuantumSoundState>(i % kQuantumStateCount));
+        field.amplitude = std::polar(0.5 + 0.01 * i, 0.3 * i);
+        field.phase = 0.7 * i - 5.0;
+        fields.push_back(field);
+        if (i % 8 == 7) {
+            core.update(0.01);
+        }
+    }
+
+    std::vector<PackedSoundField> packed;
+    std::vector<QuantumSoundField> unpacked;
+    codec.pack(fields, packed);
+    codec.unpack(packed, unpacked);
+    assert(packed.size() == fields.size() && unpacked.size() == fields.size());
+
+    double half_angle = codec.getAngleStep() / 2.0 + 1e-12;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        const QuantumSoundField& a = fields[i];
+        const QuantumSoundField& b = unpacked[i];
+        assert(codec.isRepresentable(a));
+
+        // Exact: state and clock-aligned timestamps
+        assert(b.quantum_state == a.quantum_state);
+        assert(b.timestamp == a.timestamp);
+
+        // Rounded within the documented steps
+        assert(std::abs(b.amplitude - a.amplitude) < 1e-6);
+        assert(std::abs(b.frequency - a.frequency) <= a.frequency * 1e-7);
+        assert(std::abs(b.position.r - a.position.r) <= codec.getRadiusStep() / 2.0 + 1e-12);
+        assert(std::abs(b.position.theta - a.position.theta) <= half_angle);
+        assert(std::abs(std::remainder(b.position.phi - a.position.phi, 2.0 * M_PI)) <= half_angle);
+        assert(std::abs(std::remainder(b.phase - a.phase, 2.0 * M_PI)) <= half_angle);
+        assert(b.phase >= 0.0 && b.phase < 2.0 * M_PI);
+
+        // Packing what was unpacked reproduces the same bytes
+        PackedSoundField again = codec.pack(b);
+        assert(std::memcmp(&again, &packed[i], sizeof(again)) == 0);
+    }
+
+    // Out-of-window members are clamped and reported
+    QuantumSoundField outside = fields[5];
+    outside.position.r = 25.0;
+    assert(!codec.isRepresentable(outside));
+    assert(std::abs(codec.unpack(codec.pack(outside)).position.r - codec.getMaxRadius()) < 1e-9);
+    outside = fields[5];
+    outside.position.height = 1.0;
+    assert(!codec.isRepresentable(outside));
+    outside = fields[5];
+    outside.timestamp = core.getClock().tickAt(0).timestamp;
+    assert(!codec.isRepresentable(outside));
+    assert(codec.unpack(codec.pack(outside)).timestamp == core.getClock().tickAt(codec.getBaseSample()).timestamp);
+    assert(codec.unpack(codec.pack(outside)).quantum_state == outside.quantum_state);
+
+    // An angle just below a full turn wraps to zero
+    outside = fields[5];
+    outside.phase = 2.0 * M_PI - 1e-9;
+    assert(codec.pack(outside).phase == 0);
+
+    std::cout << "✓ Packed field round trip test passed" << std::endl;
+}
@@ -0,0 +1,102 @@
+#include "processing_graph.hpp"
+#include "consciousness_integration.hpp"
+#include "mechanical_devices.hpp"
+#include "qrd_integration.hpp"
+#include "quantum_feedback_system.hpp"
+#include "thread_pool.hpp"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_processing_graph() {
+    std::cout << "Testing ProcessingGraph scheduling..." << std::endl;
+    
+    // Levels follow the data dependencies; one writer per buffer, no cycles
+    ProcessingGraph graph;
+    auto source = graph.addBuffer("source");
+    auto doubled = graph.addBuffer("doubled");
+    auto shifted = graph.addBuffer("shifted");
+    auto merged = graph.addBuffer("merged");
+    assert(graph.addBuffer("source") == source && graph.findBuffer("missing") == ProcessingGraph::npos);
+    
+    std::atomic<int> runs{0};
+    auto map_stage = [&runs](double scale, double offset) {
+        return [&runs, scale, offset](ProcessingGraph::StageIO& io) {
+            auto& out = io.output(0);
+            out = io.input(0);
+            for (auto& field : out) {
+                field.frequency = field.frequency * scale + offset;
+            }
+            ++runs;
+        };
+    };
+    auto merge = graph.addStage("merge", {doubled, shifted}, {merged}, [](ProcessingGraph::StageIO& io) {
+        auto& out = io.output(0);
+        out.assign(io.input(0).begin(), io.input(0).end());
+        out.insert(out.end(), io.input(1).begin(), io.input(1).end());
+    });
+    auto a = graph.addStage("double", {source}, {doubled}, map_stage(2.0, 0.0));
+    auto b = graph.addStage("shift", {source}, {shifted}, map_stage(1.0, 5.0));
+    assert(graph.addStage("second writer", {source}, {doubled}, map_stage(1.0, 0.0)) == ProcessingGraph::npos);
+    assert(graph.addStage("in place", {merged}, {merged}, map_stage(1.0, 0.0)) == ProcessingGraph::npos);
+    assert(graph.compile() && graph.getLevelCount() == 2);
+    assert(graph.getStageLevel(a) == 0 && graph.getStageLevel(b) == 0 && graph.getStageLevel(merge) == 1);
+    
+    // Serial and pooled ticks agree; buffers keep their storage between ticks
+    graph.getBuffer(source).resize(3);
+    for (size_t i = 0; i < 3; ++i) {
+        graph.getBuffer(source)[i].frequency = 100.0 * (i + 1);
+    }
+    assert(graph.tick(0.01));
+    const auto& result = graph.getBuffer(merged);
+    assert(result.size() == 6 && result[2].frequency == 600.0 && result[3].frequency == 105.0);
+    const QuantumSoundField* storage = result.data();
+    ThreadPool pool(3);
+    for (int tick = 0; tick < 20; ++tick) {
+        assert(graph.tick(0.01, pool));
+    }
+    assert(graph.getBuffer(merged).data() == storage && runs == 42);
+    
+    ProcessingGraph cyclic;
+    auto x = cyclic.addBuffer("x"), y = cyclic.addBuffer("y");
+    cyclic.addStage("x to y", {x}, {y}, map_stage(1.0, 0.0));
+    cyclic.addStage("y to x", {y}, {x}, map_stage(1.0, 0.0));
+    assert(!cyclic.compile() && !cyclic.tick(0.01));
+    
+    // Library components wired through shared buffers
+    AnantaSoundCore core(10.0, 5.0);
+    assert(core.initialize());
+    MechanicalDeviceManager devices;
+    SphericalCoord position{1.0, 0.3, 0.2, 0.0, 1.0};
+    devices.addDevice(std::make_shared<QuantumResonanceDevice>(position, 432.0));
+    devices.addDevice(std::make_shared<SpiritualMercy>(position, 0.5));
+    QuantumFeedbackSystem feedback(0.5, 0.5);
+    QRDIntegration qrd;
+    qrd.activateQRD(432.0, 1.0);
+    ConsciousnessIntegration consciousness;
+    
+    ProcessingGraph pipeline;
+    auto device_fields = pipeline.addBuffer("device fields");
+    auto core_fields = pipeline.addBuffer("core fields");
+    auto processed = pipeline.addBuffer("processed");
+    pipeline.addStage("devices", {}, {device_fields}, makeDeviceStage(devices));
+    pipeline.addStage("core", {device_fields}, {core_fields}, makeCoreStage(core));
+    pipeline.addStage("feedback", {core_fields, device_fields}, {processed}, makeFeedbackStage(feedback));
+    pipeline.addStage("qrd", {processed}, {}, makeQRDStage(qrd));
+    pipeline.addStage("consciousness", {processed}, {}, makeConsciousnessStage(consciousness));
+    assert(pipeline.compile() && pipeline.getLevelCount() == 4);
+    
+    assert(pipeline.tick(0.016, pool));
+    assert(pipeline.getBuffer(device_fields).size() == 8 + 7);
+    assert(pipeline.getBuffer(core_fields).size() == core.getOutputFields().size());
+    assert(pipeline.getBuffer(processed).size() == pipeline.getBuffer(core_fields).size());
+    assert(!pipeline.getBuffer(processed).empty());
+    assert(consciousness.getLastEnergy() > 0.0);
+    
+    std::cout << "✓ ProcessingGraph scheduling test passed" << std::endl;
+}
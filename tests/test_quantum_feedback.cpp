@@ -1,7 +1,12 @@
 #include "quantum_feedback_system.hpp"
+#include "feedback_kernels.hpp"
+#include "phase_synchronizer.hpp"
+#include "quantum_noise.hpp"
+#include "thread_pool.hpp"
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <vector>
 
 using namespace AnantaSound;
 
@@ -24,6 +29,74 @@ void test_quantum_feedback_system() {
     std::cout << "✓ QuantumFeedbackSystem test passed" << std::endl;
 }
 
+void test_batch_feedback() {
+    std::cout << "Testing batch feedback processing..." << std::endl;
+    
+    // Random inputs and feedback fields across all states
+    QuantumNoiseSource noise(314);
+    auto make_fields = [&](size_t count) {
+        std::vector<QuantumSoundField> fields(count);
+        for (auto& field : fields) {
+            field.amplitude = std::complex<double>(noise.uniform() - 0.5, noise.uniform() - 0.5);
+            field.phase = 2.0 * M_PI * noise.uniform() - M_PI;
+            field.frequency = 100.0 + 900.0 * noise.uniform();
+            field.quantum_state = static_cast<QuantumSoundState>(noise.next() % kQuantumStateCount);
+            field.position = {1.0, 0.0, 0.0, 0.0};
+        }
+        return fields;
+    };
+    auto inputs = make_fields(300);
+    auto feedback_fields = make_fields(37);      // Exercises the vector tails
+    
+    // Every batch path agrees with the per-field reference
+    QuantumFeedbackSystem feedback(0.8, 0.55);
+    ThreadPool pool(3);
+    std::vector<QuantumSoundField> serial, parallel;
+    feedback.processFeedback(inputs, feedback_fields, serial);
+    feedback.processFeedback(inputs, feedback_fields, parallel, pool);
+    assert(serial.size() == inputs.size() && parallel.size() == inputs.size());
+    size_t entangled = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        QuantumSoundField reference = feedback.processFeedback(inputs[i], feedback_fields);
+        assert(std::abs(serial[i].amplitude - reference.amplitude) < 1e-9);
+        assert(serial[i].quantum_state == reference.quantum_state);
+        assert(parallel[i].amplitude == serial[i].amplitude);
+        assert(parallel[i].quantum_state == serial[i].quantum_state);
+        entangled += serial[i].quantum_state == QuantumSoundState::ENTANGLED;
+    }
+    assert(entangled > 0);
+    
+    // Each compiled kernel matches the scalar one
+    std::vector<double> cos_phase, sin_phase, frequency, phasor_real, phasor_imag, states;
+    for (const auto& field : feedback_fields) {
+        cos_phase.push_back(std::cos(field.phase));
+        sin_phase.push_back(std::sin(field.phase));
+        frequency.push_back(field.frequency);
+        phasor_real.push_back(field.amplitude.real());
+        phasor_imag.push_back(field.amplitude.imag());
+        states.push_back(field.quantum_state == QuantumSoundState::COHERENT ? 1.0 : 0.3);
+    }
+    FeedbackSources sources{cos_phase.data(), sin_phase.data(), frequency.data(),
+                            phasor_real.data(), phasor_imag.data(), feedback_fields.size()};
+    auto scalar = getFeedbackKernels(SIMDLevel::SCALAR).accumulate(sources, states.data(), 0.6, 0.8, 400.0, 0.2);
+    for (SIMDLevel level : {SIMDLevel::AVX2, SIMDLevel::AVX512}) {
+        auto vector = getFeedbackKernels(level).accumulate(sources, states.data(), 0.6, 0.8, 400.0, 0.2);
+        assert(std::abs(vector - scalar) < 1e-12);
+    }
+    
+    // Classical mode adds the same phasor sum to every input; disabled passes through
+    feedback.setQuantumMode(false);
+    feedback.processFeedback(inputs, feedback_fields, serial, pool);
+    for (size_t i = 0; i < inputs.size(); i += 50) {
+        assert(std::abs(serial[i].amplitude - feedback.processFeedback(inputs[i], feedback_fields).amplitude) < 1e-12);
+    }
+    feedback.setFeedbackEnabled(false);
+    feedback.processFeedback(inputs, feedback_fields, serial);
+    assert(serial[0].amplitude == inputs[0].amplitude);
+    
+    std::cout << "✓ Batch feedback processing test passed" << std::endl;
+}
+
 void test_quantum_resonance_detector() {
     std::cout << "Testing QuantumResonanceDetector..." << std::endl;
     
@@ -41,6 +114,62 @@ void test_quantum_resonance_detector() {
     std::cout << "✓ QuantumResonanceDetector test passed" << std::endl;
 }
 
+void test_resonance_tracker() {
+    std::cout << "Testing ResonanceTracker..." << std::endl;
+    
+    auto make_field = [](double frequency, double amplitude) {
+        QuantumSoundField field;
+        field.amplitude = std::complex<double>(amplitude, 0.0);
+        field.frequency = frequency;
+        field.phase = 0.0;
+        field.quantum_state = QuantumSoundState::COHERENT;
+        return field;
+    };
+    
+    // Frequencies within the tolerance merge; weak fields are tracked but not resonant
+    ResonanceTracker tracker(0.7, 2.0);
+    auto a = tracker.addField(make_field(432.0, 1.0));
+    auto b = tracker.addField(make_field(433.0, 1.0));
+    auto c = tracker.addField(make_field(440.0, 1.0));
+    auto weak = tracker.addField(make_field(500.0, 0.1));
+    assert(tracker.getFieldCount() == 4 && tracker.getResonantFieldCount() == 3);
+    auto resonances = tracker.getResonantFrequencies();
+    assert(resonances.size() == 2);
+    assert(std::abs(resonances[0] - 432.5) < 1e-9 && std::abs(resonances[1] - 440.0) < 1e-9);
+    
+    // Updates and removals are reflected without a rescan
+    assert(tracker.updateField(weak, make_field(500.0, 0.9)));
+    assert(tracker.getResonantFrequencies().size() == 3);
+    assert(tracker.updateField(c, make_field(434.0, 1.0)));
+    resonances = tracker.getResonantFrequencies();
+    assert(resonances.size() == 2 && std::abs(resonances[0] - 433.0) < 1e-9);
+    assert(tracker.removeField(a));
+    assert(!tracker.removeField(a) && !tracker.containsField(a));
+    resonances = tracker.getResonantFrequencies();
+    assert(std::abs(resonances[0] - 433.5) < 1e-9 && std::abs(resonances[1] - 500.0) < 1e-9);
+    
+    // Matches the batch detector on distinct frequencies
+    QuantumResonanceDetector detector(0.7);
+    ResonanceTracker exact(0.7, 1e-6);
+    std::vector<QuantumSoundField> fields;
+    for (int i = 0; i < 200; ++i) {
+        fields.push_back(make_field(100.0 + 7.0 * (i % 50), i % 3 == 0 ? 0.2 : 1.0));
+        exact.addField(fields.back());
+    }
+    auto expected = detector.findResonantFrequencies(fields);
+    const auto& tracked = exact.getResonantFrequencies();
+    assert(tracked.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        assert(std::abs(tracked[i] - expected[i]) < 1e-9);
+    }
+    
+    tracker.clear();
+    assert(tracker.getFieldCount() == 0 && tracker.getResonantFrequencies().empty());
+    assert(!tracker.containsField(b));
+    
+    std::cout << "✓ ResonanceTracker test passed" << std::endl;
+}
+
 void test_quantum_phase_synchronizer() {
     std::cout << "Testing QuantumPhaseSynchronizer..." << std::endl;
     
@@ -59,7 +188,91 @@ void test_quantum_phase_synchronizer() {
     auto synchronized = sync.synchronizePhases(fields);
     assert(synchronized.size() == fields.size());
     
+    
+    // The reference is the circular mean: coherent phases around ±π average to π, not 0
+    std::vector<QuantumSoundField> wrapped(3, fields[0]);
+    wrapped[0].phase = 3.0;
+    wrapped[1].phase = -3.0;
+    wrapped[2].phase = 0.0;
+    wrapped[2].quantum_state = QuantumSoundState::SUPERPOSITION;
+    sync.synchronizePhasesInPlace(wrapped);
+    assert(wrapped[0].phase == 3.0 && wrapped[1].phase == -3.0);
+    assert(std::abs(std::abs(wrapped[2].phase) - M_PI) < 1e-12);
+    assert(wrapped[2].quantum_state == QuantumSoundState::COHERENT);
+    
     std::cout << "✓ QuantumPhaseSynchronizer test passed" << std::endl;
 }
 
+void test_kuramoto_synchronizer() {
+    std::cout << "Testing KuramotoSynchronizer..." << std::endl;
+    
+    QuantumNoiseSource noise(271);
+    std::vector<double> phases(203);
+    for (double& phase : phases) {
+        phase = 2.0 * M_PI * noise.uniform() - M_PI;
+    }
+    
+    // Every compiled kernel matches the scalar one, including the tails
+    auto reference = phases;
+    std::complex<double> scalar_sum = getPhaseKernels(SIMDLevel::SCALAR).couple(reference.data(), reference.size(), 0.3, -0.8, 0.05);
+    for (SIMDLevel level : {SIMDLevel::AVX2, SIMDLevel::AVX512}) {
+        const PhaseKernelTable& kernels = getPhaseKernels(level);
+        assert(std::abs(kernels.orderSum(phases.data(), phases.size()) -
+                        getPhaseKernels(SIMDLevel::SCALAR).orderSum(phases.data(), phases.size())) < 1e-12);
+        auto coupled = phases;
+        assert(std::abs(kernels.couple(coupled.data(), coupled.size(), 0.3, -0.8, 0.05) - scalar_sum) < 1e-12);
+        for (size_t i = 0; i < coupled.size(); ++i) {
+            assert(std::abs(coupled[i] - reference[i]) < 1e-12);
+            assert(coupled[i] >= -M_PI && coupled[i] <= M_PI);
+        }
+    }
+    
+    // Incremental tracking matches a fresh sum
+    KuramotoSynchronizer sync(4.0);
+    sync.reset(phases.data(), phases.size() - 1);
+    sync.addPhase(phases.back());
+    sync.updatePhase(phases[0], 1.0);
+    phases[0] = 1.0;
+    KuramotoSynchronizer fresh(4.0);
+    fresh.reset(phases.data(), phases.size());
+    assert(std::abs(sync.getOrderParameter() - fresh.getOrderParameter()) < 1e-12);
+    
+    // Coupling drives the population toward phase lock
+    double initial = sync.getCoherence();
+    for (int step = 0; step < 400; ++step) {
+        sync.step(phases.data(), phases.size(), 0.05);
+    }
+    fresh.reset(phases.data(), phases.size());
+    assert(std::abs(sync.getOrderParameter() - fresh.getOrderParameter()) < 1e-9);
+    assert(sync.getCoherence() > 0.99 && sync.getCoherence() > initial);
+    
+    // Per-tick stage of the core, on the incrementally maintained phase sums
+    AnantaSoundCore core(10.0, 5.0);
+    assert(core.initialize());
+    std::vector<QuantumSoundField> fields;
+    for (int i = 0; i < 64; ++i) {
+        auto field = core.createQuantumSoundField(432.0, {1.0 + 0.1 * i, 0.5, 0.25, 1.0}, QuantumSoundState::COHERENT);
+        field.phase = 2.0 * M_PI * noise.uniform() - M_PI;
+        fields.push_back(field);
+    }
+    core.processSoundFields(fields);
+    double core_initial = core.getStatistics().phase_coherence;
+    core.update(0.1);
+    assert(core.getStatistics().phase_coherence == core_initial);      // Coupling is off by default
+    core.setPhaseCoupling(5.0);
+    for (int step = 0; step < 100; ++step) {
+        core.update(0.05);
+    }
+    auto output = core.getOutputFields();
+    std::complex<double> direct(0.0, 0.0);
+    for (const auto& field : output) {
+        direct += std::exp(std::complex<double>(0.0, field.phase));
+    }
+    double core_final = core.getStatistics().phase_coherence;
+    assert(std::abs(core_final - std::abs(direct) / output.size()) < 1e-9);
+    assert(core_final > 0.99 && core_final > core_initial);
+    
+    std::cout << "✓ KuramotoSynchronizer test passed" << std::endl;
+}
+
 
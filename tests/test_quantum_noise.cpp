@@ -0,0 +1,127 @@
+#include "quantum_noise.hpp"
+#include "quantum_feedback_system.hpp"
+#include "anantasound_core.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_quantum_noise_source() {
+    std::cout << "Testing QuantumNoiseSource..." << std::endl;
+
+    // Same seed and stream replay the same sequence; other streams differ
+    QuantumNoiseSource a(42), b(42), c(42, 1);
+    bool streams_differ = false;
+    for (int i = 0; i < 64; ++i) {
+        uint64_t value = a.next();
+        assert(value == b.next());
+        streams_differ |= value != c.next();
+    }
+    assert(streams_differ);
+
+    // Uniform samples stay in [0, 1) with the right mean
+    QuantumNoiseSource source(7);
+    std::vector<double> uniform(100000);
+    source.fillUniform(uniform.data(), uniform.size());
+    double uniform_sum = 0.0;
+    for (double u : uniform) {
+        assert(u >= 0.0 && u < 1.0);
+        uniform_sum += u;
+    }
+    assert(std::abs(uniform_sum / uniform.size() - 0.5) < 0.01);
+
+    // Ziggurat Gaussians: moments and tail mass of N(0, 1)
+    std::vector<double> normal(400000);
+    source.fillGaussian(normal.data(), normal.size());
+    double sum = 0.0, sum_sq = 0.0;
+    size_t beyond_two = 0, beyond_tail = 0;
+    for (double x : normal) {
+        sum += x;
+        sum_sq += x * x;
+        beyond_two += std::abs(x) > 2.0;
+        beyond_tail += std::abs(x) > 3.5;
+    }
+    double mean = sum / normal.size();
+    double variance = sum_sq / normal.size() - mean * mean;
+    assert(std::abs(mean) < 0.01);
+    assert(std::abs(variance - 1.0) < 0.02);
+    assert(std::abs(static_cast<double>(beyond_two) / normal.size() - 0.0455) < 0.003);
+    assert(beyond_tail > 0);                 // The tail beyond R = 3.44 is reached
+
+    // Mean and deviation are applied to batches
+    std::vector<double> scaled(100000);
+    source.fillGaussian(scaled.data(), scaled.size(), 5.0, 0.1);
+    double scaled_sum = 0.0;
+    for (double x : scaled) {
+        scaled_sum += x;
+    }
+    assert(std::abs(scaled_sum / scaled.size() - 5.0) < 0.002);
+
+    // Thread-local sources of different threads are independent
+    QuantumNoiseSource::seedThreadLocal(99);
+    uint64_t main_value = QuantumNoiseSource::threadLocal().next();
+    uint64_t other_value = 0;
+    std::thread other([&]() { other_value = QuantumNoiseSource::threadLocal().next(); });
+    other.join();
+    assert(main_value != other_value);
+    QuantumNoiseSource::seedThreadLocal(99);
+    assert(QuantumNoiseSource::threadLocal().next() == main_value);
+
+    std::cout << "✓ QuantumNoiseSource test passed" << std::endl;
+}
+
+void test_quantum_noise_replay() {
+    std::cout << "Testing deterministic quantum noise replay..." << std::endl;
+
+    // Feedback generation replays with a seeded thread-local source
+    QuantumFeedbackSystem feedback;
+    QuantumSoundField input;
+    input.amplitude = std::complex<double>(1.0, 0.0);
+    input.phase = 0.0;
+    input.frequency = 432.0;
+    input.quantum_state = QuantumSoundState::COHERENT;
+    input.position = {1.0, 0.0, 0.0, 0.0};
+
+    QuantumNoiseSource::seedThreadLocal(2024);
+    auto first = feedback.generateQuantumFeedback(input, 8);
+    QuantumNoiseSource::seedThreadLocal(2024);
+    auto second = feedback.generateQuantumFeedback(input, 8);
+    assert(first.size() == 8 && second.size() == 8);
+    for (size_t i = 0; i < first.size(); ++i) {
+        assert(first[i].amplitude == second[i].amplitude);
+        assert(first[i].frequency == second[i].frequency);
+        assert(first[i].phase == second[i].phase);
+        assert(first[i].quantum_state == second[i].quantum_state);
+    }
+
+    // Core uncertainty noise and decoherence replay with a fixed seed
+    auto run = [](uint64_t seed) {
+        AnantaSoundCore core(10.0, 5.0);
+        assert(core.initialize());
+        core.setNoiseSeed(seed);
+        for (int i = 0; i < 20; ++i) {
+            core.processSoundField(core.createQuantumSoundField(
+                432.0, {1.0 + 0.1 * i, 0.5, 0.25, 1.0}, QuantumSoundState::SUPERPOSITION));
+        }
+        for (int step = 0; step < 10; ++step) {
+            core.update(0.02);
+        }
+        return core.getOutputFields();
+    };
+    auto replay_a = run(11);
+    auto replay_b = run(11);
+    auto replay_c = run(12);
+    assert(replay_a.size() == 20 && replay_b.size() == 20);
+    bool seeds_differ = false;
+    for (size_t i = 0; i < replay_a.size(); ++i) {
+        assert(replay_a[i].amplitude == replay_b[i].amplitude);
+        assert(replay_a[i].quantum_state == replay_b[i].quantum_state);
+        seeds_differ |= replay_a[i].amplitude != replay_c[i].amplitude;
+    }
+    assert(seeds_differ);
+
+    std::cout << "✓ Deterministic quantum noise replay test passed" << std::endl;
+}
@@ -0,0 +1,132 @@
+#include "realtime_audio_bridge.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_spsc_ring_buffer() {
+    std::cout << "Testing SPSCRingBuffer..." << std::endl;
+
+    // Capacity rounds up to a power of two; writes stop when full
+    SPSCRingBuffer<int> small(5);
+    assert(small.capacity() == 8);
+    int values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    assert(small.write(values, 10) == 8);
+    assert(small.readAvailable() == 8 && small.writeAvailable() == 0);
+    int out[10] = {};
+    assert(small.read(out, 3) == 3 && out[0] == 0 && out[2] == 2);
+
+    // Wrap-around keeps FIFO order
+    assert(small.write(values, 3) == 3);
+    assert(small.read(out, 10) == 8);
+    assert(out[0] == 3 && out[4] == 7 && out[5] == 0 && out[7] == 2);
+    assert(small.readAvailable() == 0 && small.read(out, 1) == 0);
+
+    // Concurrent producer and consumer see every item once, in order
+    SPSCRingBuffer<unsigned> ring(256);
+    const unsigned total = 200000;
+    std::thread producer([&ring, total]() {
+        unsigned next = 0;
+        unsigned chunk[37];
+        while (next < total) {
+            unsigned count = std::min<unsigned>(37, total - next);
+            for (unsigned i = 0; i < count; ++i) {
+                chunk[i] = next + i;
+            }
+            size_t written = ring.write(chunk, count);
+            next += static_cast<unsigned>(written);
+            if (written == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    unsigned expected = 0;
+    unsigned received[64];
+    while (expected < total) {
+        size_t count = ring.read(received, 64);
+        for (size_t i = 0; i < count; ++i) {
+            assert(received[i] == expected);
+            ++expected;
+        }
+        if (count == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    assert(ring.readAvailable() == 0);
+
+    std::cout << "✓ SPSCRingBuffer test passed" << std::endl;
+}
+
+void test_realtime_audio_bridge() {
+    std::cout << "Testing RealtimeAudioBridge..." << std::endl;
+
+    const size_t frames_per_callback = 64;
+    const size_t callbacks = 400;
+    RealtimeAudioBridge bridge(2, 256, 1 << 16);
+
+    // A raw consumer checks the downmix and ordering; blocks differ from the callback size
+    std::vector<float> collected;
+    collected.reserve(frames_per_callback * callbacks);
+    size_t raw = bridge.addConsumer(100, [&collected](const float* samples, size_t count) {
+        collected.insert(collected.end(), samples, samples + count);
+    });
+
+    BreathingAnalyzer analyzer(1024, 44100);
+    std::atomic<int> breathing_results{0};
+    size_t breathing = bridge.addBreathingAnalyzer(analyzer, 1024,
+        [&breathing_results](const BreathingAnalysisResult&) { ++breathing_results; });
+    assert(raw == 0 && breathing == 1 && bridge.getConsumerCount() == 2);
+
+    assert(bridge.start());
+    assert(!bridge.start());
+    assert(bridge.addConsumer(16, nullptr) == RealtimeAudioBridge::npos);
+
+    // Stand-in for the audio callback: stereo frame n is (0.5n, 1.5n), so its mono sample is n
+    size_t callback_allocations = 0;
+    std::thread audio([&bridge, &callback_allocations, frames_per_callback, callbacks]() {
+        std::vector<float> interleaved(frames_per_callback * 2);
+        for (size_t callback = 0; callback < callbacks; ++callback) {
+            for (size_t frame = 0; frame < frames_per_callback; ++frame) {
+                float n = static_cast<float>(callback * frames_per_callback + frame);
+                interleaved[frame * 2] = 0.5f * n;
+                interleaved[frame * 2 + 1] = 1.5f * n;
+            }
+            size_t before = TestSupport::allocationCount();
+            bridge.process(interleaved.data(), frames_per_callback);
+            callback_allocations += TestSupport::allocationCount() - before;
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+    audio.join();
+    bridge.stop();
+    assert(!bridge.isRunning());
+
+    // The callback never allocated, nothing was dropped and blocks arrived in order
+    assert(callback_allocations == 0);
+    const size_t total = frames_per_callback * callbacks;
+    assert(bridge.getDroppedSamples(raw) == 0 && bridge.getDroppedSamples(breathing) == 0);
+    assert(bridge.getBlocksDelivered(raw) == total / 100);
+    assert(collected.size() == (total / 100) * 100);
+    for (size_t i = 0; i < collected.size(); ++i) {
+        assert(collected[i] == static_cast<float>(i));
+    }
+    assert(bridge.getBlocksDelivered(breathing) == total / 1024);
+    assert(breathing_results.load() == static_cast<int>(total / 1024));
+
+    // A full ring drops the overflow and counts it instead of blocking the callback
+    RealtimeAudioBridge stalled(1, 64, 128);
+    stalled.addConsumer(64, nullptr);
+    std::vector<float> mono(64, 0.25f);
+    for (int i = 0; i < 4; ++i) {
+        stalled.process(mono.data(), mono.size());
+    }
+    assert(stalled.getDroppedSamples(0) == 128);
+
+    std::cout << "✓ RealtimeAudioBridge test passed" << std::endl;
+}
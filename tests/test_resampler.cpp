@@ -0,0 +1,147 @@
+#include "resampler.hpp"
+#include "audio_file_reader.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+std::vector<double> tone(double frequency, double rate, size_t count) {
+    std::vector<double> signal(count);
+    for (size_t i = 0; i < count; ++i) {
+        signal[i] = 0.5 * std::sin(2.0 * M_PI * frequency * i / rate);
+    }
+    return signal;
+}
+
+double peakAbs(const std::vector<double>& signal, size_t start, size_t end) {
+    double peak = 0.0;
+    for (size_t i = start; i < end; ++i) {
+        peak = std::max(peak, std::abs(signal[i]));
+    }
+    return peak;
+}
+
+} // namespace
+
+void test_resampler_rate_conversion() {
+    std::cout << "Testing polyphase resampler rate conversion..." << std::endl;
+
+    // SIMD inner products agree with the scalar kernel
+    std::vector<double> a(37), b(37);
+    std::vector<float> a_f(37), b_f(37);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = std::sin(0.3 * i);
+        b[i] = std::cos(0.7 * i);
+        a_f[i] = static_cast<float>(a[i]);
+        b_f[i] = static_cast<float>(b[i]);
+    }
+    double expected_dot = getSpectralKernels(SIMDLevel::SCALAR).dot_product(a.data(), b.data(), a.size());
+    for (SIMDLevel level : {SIMDLevel::SCALAR, SIMDLevel::AVX2, SIMDLevel::AVX512, SIMDLevel::NEON}) {
+        assert(std::abs(getSpectralKernels(level).dot_product(a.data(), b.data(), a.size()) - expected_dot) < 1e-12);
+        assert(std::abs(getSpectralKernelsF(level).dot_product(a_f.data(), b_f.data(), a.size()) - expected_dot) < 1e-5);
+    }
+
+    // 44.1 kHz -> 48 kHz is the exact fraction 160/147
+    PolyphaseResampler resampler(44100, 48000);
+    assert(resampler.getInterpolation() == 160 && resampler.getDecimation() == 147);
+
+    std::vector<double> input = tone(1000.0, 44100.0, 4410);
+    std::vector<double> output;
+    for (size_t offset = 0; offset < input.size(); offset += 100) {
+        size_t length = std::min<size_t>(100, input.size() - offset);
+        size_t bound = resampler.maxOutputSize(length);
+        assert(resampler.process(input.data() + offset, length, output) <= bound);
+    }
+    resampler.flush(output);
+    assert(output.size() == static_cast<size_t>(std::ceil(input.size() * 160.0 / 147.0)));
+
+    // Time-aligned with the ideal tone away from the stream edges
+    std::vector<double> ideal = tone(1000.0, 48000.0, output.size());
+    for (size_t i = 200; i + 200 < output.size(); ++i) {
+        assert(std::abs(output[i] - ideal[i]) < 1e-3);
+    }
+
+    // Block size does not change the result
+    PolyphaseResampler whole(44100, 48000);
+    std::vector<double> whole_output;
+    whole.process(input.data(), input.size(), whole_output);
+    whole.flush(whole_output);
+    assert(whole_output == output);
+
+    // Float path tracks the double one
+    PolyphaseResamplerF resampler_f(44100, 48000);
+    std::vector<float> input_f(input.begin(), input.end());
+    std::vector<float> output_f;
+    resampler_f.process(input_f.data(), input_f.size(), output_f);
+    resampler_f.flush(output_f);
+    assert(output_f.size() == output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        assert(std::abs(output_f[i] - output[i]) < 1e-4);
+    }
+
+    std::cout << "✓ Polyphase resampler rate conversion test passed" << std::endl;
+}
+
+void test_resampler_tempo_and_file_conversion() {
+    std::cout << "Testing polyphase resampler tempo and file conversion..." << std::endl;
+
+    // Tempo 2.0 halves the rate: tones above the new Nyquist are removed,
+    // tones below it pass at unity gain
+    PolyphaseResampler halving(0.5);
+    assert(halving.getInterpolation() == 1 && halving.getDecimation() == 2);
+    assert(halving.getTapsPerPhase() > PolyphaseResampler::kBaseTaps);
+
+    std::vector<double> passed;
+    std::vector<double> low = tone(2000.0, 44100.0, 8192);
+    halving.process(low.data(), low.size(), passed);
+    assert(std::abs(peakAbs(passed, 200, passed.size() - 200) - 0.5) < 5e-3);
+
+    halving.reset();
+    std::vector<double> rejected;
+    std::vector<double> high = tone(15000.0, 44100.0, 8192);
+    halving.process(high.data(), high.size(), rejected);
+    assert(peakAbs(rejected, 200, rejected.size() - 200) < 0.5 * 0.01);     // Below -40 dB
+
+    // Irrational-looking tempo ratios fall back to at most kMaxPhases phases
+    PolyphaseResampler tempo(1.0 / 1.1);
+    assert(tempo.getInterpolation() == 10 && tempo.getDecimation() == 11);
+    PolyphaseResampler golden(0.6180339887);
+    assert(golden.getInterpolation() <= PolyphaseResampler::kMaxPhases);
+    assert(std::abs(static_cast<double>(golden.getInterpolation()) / golden.getDecimation() - 0.6180339887) < 1e-4);
+
+    // Offline conversion of a stereo WAV file
+    const std::string source = (std::filesystem::temp_directory_path() / "anantasound_resample_in.wav").string();
+    const std::string target = (std::filesystem::temp_directory_path() / "anantasound_resample_out.wav").string();
+    std::vector<double> stereo(2 * 22050);
+    for (size_t i = 0; i < 22050; ++i) {
+        stereo[2 * i] = 0.5 * std::sin(2.0 * M_PI * 440.0 * i / 22050.0);
+        stereo[2 * i + 1] = -stereo[2 * i];
+    }
+    assert(AudioUtils::writeWAV(source, stereo, 2, 22050));
+    assert(AudioUtils::resampleAudio(source, target, 44100));
+
+    AudioFileReader reader;
+    assert(reader.open(target));
+    assert(reader.getInfo().sample_rate == 44100 && reader.getInfo().channels == 2);
+    assert(reader.getInfo().total_samples == 44100);
+
+    std::vector<double> converted(2 * 44100);
+    assert(reader.readInterleaved(converted.data(), 44100) == 44100);
+    for (size_t i = 1000; i < 43000; ++i) {
+        double expected = 0.5 * std::sin(2.0 * M_PI * 440.0 * i / 44100.0);
+        assert(std::abs(converted[2 * i] - expected) < 2e-3);
+        assert(std::abs(converted[2 * i + 1] + expected) < 2e-3);
+    }
+    reader.close();
+
+    std::remove(source.c_str());
+    std::remove(target.c_str());
+
+    std::cout << "✓ Polyphase resampler tempo and file conversion test passed" << std::endl;
+}
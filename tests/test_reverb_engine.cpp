@@ -0,0 +1,131 @@
+#include "reverb_engine.hpp"
+#include "effects_chain.hpp"
+#include "adaptive_audio_processor.hpp"
+#include "anantasound_core.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+double windowEnergy(const std::vector<double>& signal, size_t start, size_t length) {
+    double energy = 0.0;
+    for (size_t i = start; i < start + length; ++i) {
+        energy += signal[i] * signal[i];
+    }
+    return energy;
+}
+
+} // namespace
+
+void test_reverb_impulse_decay() {
+    std::cout << "Testing FDN reverb impulse decay..." << std::endl;
+
+    const size_t rate = 8000;
+    const double decay_time = 0.5;
+
+    FDNReverb reverb(rate, decay_time);
+    for (size_t i = 1; i < FDNReverb::kLineCount; ++i) {
+        assert(reverb.getLineLength(i) > reverb.getLineLength(i - 1));
+    }
+
+    std::vector<double> response(rate);
+    for (size_t i = 0; i < response.size(); ++i) {
+        response[i] = reverb.processSample(i == 0 ? 1.0 : 0.0);
+    }
+
+    // Nothing before the shortest line, a tail after it
+    for (size_t i = 0; i < reverb.getLineLength(0); ++i) {
+        assert(response[i] == 0.0);
+    }
+    assert(windowEnergy(response, rate / 10, rate / 25) > 0.0);
+
+    // Energy falls 60 dB per T60: 36 dB over 0.3 s
+    double early = windowEnergy(response, rate / 10, rate / 25);
+    double late = windowEnergy(response, rate * 4 / 10, rate / 25);
+    double drop_db = 10.0 * std::log10(early / late);
+    assert(std::abs(drop_db - 36.0) < 6.0);
+
+    // A longer decay time keeps more energy in the same window
+    FDNReverb longer(rate, 2.0 * decay_time);
+    double late_longer = 0.0;
+    for (size_t i = 0; i < rate / 2; ++i) {
+        double y = longer.processSample(i == 0 ? 1.0 : 0.0);
+        if (i >= rate * 4 / 10 && i < rate * 4 / 10 + rate / 25) {
+            late_longer += y * y;
+        }
+    }
+    assert(late_longer > late);
+
+    // reset() clears the tail
+    reverb.reset();
+    for (size_t i = 0; i < rate; ++i) {
+        assert(reverb.processSample(0.0) == 0.0);
+    }
+
+    std::cout << "✓ FDN reverb impulse decay test passed" << std::endl;
+}
+
+void test_multitap_echo_and_dome_reverb() {
+    std::cout << "Testing multi-tap echo and dome reverb time..." << std::endl;
+
+    // Taps at D, 2D, 3D with halving gains
+    MultiTapEcho echo(100);
+    echo.setDelay(100);
+    echo.setLevel(0.4);
+    std::vector<double> response(400);
+    for (size_t i = 0; i < response.size(); ++i) {
+        response[i] = echo.processSample(i == 0 ? 1.0 : 0.0);
+    }
+    for (size_t i = 0; i < response.size(); ++i) {
+        double expected = i == 100 ? 0.4 : i == 200 ? 0.2 : i == 300 ? 0.1 : 0.0;
+        assert(std::abs(response[i] - expected) < 1e-12);
+    }
+
+    // Growing past the preallocated span keeps the taps in place
+    echo.reset();
+    echo.setDelay(250);
+    assert(echo.processSample(1.0) == 0.0);
+    for (size_t i = 1; i < 750; ++i) {
+        double y = echo.processSample(0.0);
+        assert(y == 0.0 || i == 250 || i == 500);
+    }
+    assert(std::abs(echo.processSample(0.0) - 0.1) < 1e-12);
+
+    // The reverb tail outlives blocks far shorter than any delay line
+    AdaptationParameters parameters;
+    parameters.reverb_amount = 1.0;
+    EffectsChain chain(8000);
+    chain.setParameters(parameters);
+    chain.setReverbTime(1.0);
+    std::vector<double> block(32, 0.0);
+    block[0] = 0.5;
+    chain.processInPlace(block.data(), block.size());
+    double tail_energy = 0.0;
+    for (int b = 1; b < 50; ++b) {
+        std::fill(block.begin(), block.end(), 0.0);
+        chain.processInPlace(block.data(), block.size());
+        for (double y : block) {
+            tail_energy += y * y;
+        }
+    }
+    assert(tail_energy > 0.0);
+
+    // Decay time follows the dome, including material properties
+    DomeAcousticResonator dome(10.0, 8.0);
+    AdaptiveAudioProcessor processor(1024, 44100);
+    assert(processor.initialize());
+    processor.setDomeAcoustics(dome);
+    assert(processor.getEffectsChain().getReverbTime() == dome.calculateReverbTime(1000.0));
+    assert(processor.getEffectsChainF().getReverbTime() == dome.calculateReverbTime(1000.0));
+
+    double untreated = dome.calculateReverbTime(1000.0);
+    dome.setMaterialProperties({{500.0, 0.5}});
+    processor.setDomeAcoustics(dome, 500.0);
+    assert(std::abs(processor.getEffectsChain().getReverbTime() - 0.5 * untreated) < 1e-12);
+
+    std::cout << "✓ Multi-tap echo and dome reverb time test passed" << std::endl;
+}
@@ -0,0 +1,140 @@
+#include "scene_snapshot.hpp"
+#include "mechanical_devices.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+bool sameField(const QuantumSoundField& a, const QuantumSoundField& b) {
+    return a.amplitude == b.amplitude && a.phase == b.phase && a.frequency == b.frequency &&
+           a.quantum_state == b.quantum_state && a.position.r == b.position.r &&
+           a.position.theta == b.position.theta && a.position.phi == b.position.phi &&
+           a.position.t == b.position.t && a.position.height == b.position.height;
+}
+
+} // namespace
+
+void test_scene_snapshot() {
+    std::cout << "Testing scene snapshot..." << std::endl;
+
+    // A small show: sound fields, two interference fields with entangled
+    // sources and one device of each kind with non-default settings
+    AnantaSoundCore core(12.0, 7.0);
+    assert(core.initialize());
+    core.setPhaseCoupling(0.25);
+    std::vector<QuantumSoundField> fields;
+    for (int i = 0; i < 50; ++i) {
+        fields.push_back(core.createQuantumSoundField(200.0 + 7.0 * i, {1.0 + 0.1 * i, 0.02 * i, 0.05 * i, 0.0, 0.3},
+                                                      i % 2 ? QuantumSoundState::COHERENT
+                                                            : QuantumSoundState::SUPERPOSITION));
+    }
+    core.processSoundFields(fields);
+    for (int f = 0; f < 2; ++f) {
+        auto field = std::make_unique<InterferenceField>(
+            f ? InterferenceFieldType::PHASE_MODULATED : InterferenceFieldType::CONSTRUCTIVE,
+            SphericalCoord(1.0 + f, 0.5, 0.25, 0.0, 1.0), 4.0 + f);
+        std::vector<QuantumSoundField> sources(fields.begin() + 10 * f, fields.begin() + 10 * f + 20);
+        auto handles = field->addSourceFields(sources);
+        field->createQuantumEntanglement(handles[1], handles[4]);
+        field->createQuantumEntanglement(handles[4], handles[9]);
+        field->removeSourceField(handles[0]);
+        core.addInterferenceField(std::move(field));
+    }
+    MechanicalDeviceManager devices;
+    auto karmic = std::make_shared<KarmicCluster>(SphericalCoord(2.0, 0.3, 0.6), 5);
+    karmic->setKarmicResonance(0.7);
+    karmic->updateKarmicCharge(2, -0.4);
+    karmic->deactivateElement(3);
+    auto mercy = std::make_shared<SpiritualMercy>(SphericalCoord(3.0, 0.2, 1.1), 0.8);
+    mercy->setCompassionRadius(2.5);
+    mercy->setVibrationEnabled(true);
+    auto resonance = std::make_shared<QuantumResonanceDevice>(SphericalCoord(4.0, 1.0, 2.0), 528.0);
+    resonance->setQuantumCoherence(0.6);
+    resonance->setActive(false);
+    devices.addDevice(karmic);
+    devices.addDevice(mercy);
+    devices.addDevice(resonance);
+
+    std::string path = (std::filesystem::temp_directory_path() / "anantasound_scene.bin").string();
+    assert(saveScene(path, core, &devices));
+
+    // The image exposes the stored arrays in place
+    SceneImage image;
+    assert(image.open(path) && image.isOpen());
+    assert(image.getDomeRadius() == 12.0 && image.getDomeHeight() == 7.0 && image.getPhaseCoupling() == 0.25);
+    SceneFieldArrays sound = image.soundFields();
+    std::vector<QuantumSoundField> outputs = core.getOutputFields();
+    assert(sound.count == outputs.size());
+    for (size_t i = 0; i < sound.count; ++i) {
+        assert(sameField(sound.get(i), outputs[i]));
+    }
+    size_t field_count = 0, pair_count = 0, device_count = 0, element_count = 0;
+    const SceneInterferenceRecord* records = image.interferenceFields(field_count);
+    image.entanglement(pair_count);
+    image.devices(device_count);
+    image.clusterElements(element_count);
+    assert(field_count == 2 && records[1].source_count == 19 && pair_count == 4);
+    assert(device_count == 3 && element_count == 5);
+    assert(reinterpret_cast<uintptr_t>(sound.phase) % 64 == 0);
+
+    // Restoring into a fresh core reproduces fields, interference and devices
+    AnantaSoundCore restored(image.getDomeRadius(), image.getDomeHeight());
+    assert(!image.restore(restored));
+    assert(restored.initialize());
+    MechanicalDeviceManager restored_devices;
+    assert(image.restore(restored, &restored_devices));
+    assert(restored.getPhaseCoupling() == 0.25);
+    std::vector<QuantumSoundField> restored_outputs = restored.getOutputFields();
+    assert(restored_outputs.size() == outputs.size());
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        assert(sameField(restored_outputs[i], outputs[i]));
+    }
+    assert(restored.getInterferenceFieldCount() == 2);
+    std::vector<SphericalCoord> points;
+    for (int i = 0; i < 16; ++i) {
+        points.push_back({0.5 + 0.2 * i, 0.1 * i, 0.3 * i, 1.0});
+    }
+    for (size_t f = 0; f < 2; ++f) {
+        const InterferenceField* original = core.getInterferenceField(core.getInterferenceFieldHandle(f));
+        const InterferenceField* copy = restored.getInterferenceField(restored.getInterferenceFieldHandle(f));
+        assert(copy->getType() == original->getType() && copy->getFieldRadius() == original->getFieldRadius());
+        assert(copy->getEntangledPairs() == original->getEntangledPairs());
+        assert(copy->calculateInterference(points, 0.01) == original->calculateInterference(points, 0.01));
+    }
+    assert(restored_devices.getDeviceCount() == 3);
+    std::vector<QuantumSoundField> device_fields = devices.generateAllDeviceFields();
+    std::vector<QuantumSoundField> restored_device_fields = restored_devices.generateAllDeviceFields();
+    assert(device_fields.size() == restored_device_fields.size());
+    for (size_t i = 0; i < device_fields.size(); ++i) {
+        assert(device_fields[i].amplitude == restored_device_fields[i].amplitude);
+        assert(device_fields[i].frequency == restored_device_fields[i].frequency);
+    }
+    assert(restored_devices.getDevice(1)->isVibrationEnabled() && !restored_devices.getDevice(2)->isActive());
+    image.close();
+    assert(!image.isOpen());
+
+    // Truncated or foreign files are rejected
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 64);
+    assert(!image.open(path));
+    {
+        std::ofstream foreign(path, std::ios::binary | std::ios::trunc);
+        foreign << std::string(256, 'x');
+    }
+    assert(!image.open(path));
+    assert(!image.open("/nonexistent/scene.bin"));
+    std::remove(path.c_str());
+
+    restored.shutdown();
+    core.shutdown();
+
+    std::cout << "✓ Scene snapshot test passed" << std::endl;
+}
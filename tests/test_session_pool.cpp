@@ -0,0 +1,127 @@
+#include "session_pool.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+// Amplitude-modulated noise, a different breathing rate per listener
+std::vector<float> listenerSignal(size_t listener, size_t samples, size_t sample_rate) {
+    std::vector<float> signal(samples);
+    uint32_t state = 1000u + static_cast<uint32_t>(listener);
+    double frequency = (10.0 + 2.0 * static_cast<double>(listener % 8)) / 60.0;
+    for (size_t i = 0; i < samples; ++i) {
+        state = state * 1664525u + 1013904223u;
+        double noise = static_cast<double>(state >> 8) / 8388608.0 - 1.0;
+        double t = static_cast<double>(i) / sample_rate;
+        double amplitude = 0.1 + 0.4 * (0.5 - 0.5 * std::cos(2.0 * M_PI * frequency * t));
+        signal[i] = static_cast<float>(amplitude * noise);
+    }
+    return signal;
+}
+
+} // namespace
+
+void test_session_pool() {
+    std::cout << "Testing SessionPool..." << std::endl;
+
+    const size_t rate = 44100;
+    const size_t block = 1024;
+    const size_t listeners = 12;
+
+    // Slot arena: fixed capacity, ids reused after removal
+    SessionPoolF pool(1024, rate, listeners);
+    assert(pool.initialize());
+    assert(pool.getCapacity() == listeners && pool.getSessionCount() == 0);
+    for (size_t i = 0; i < listeners; ++i) {
+        assert(pool.addSession() == i);
+    }
+    assert(pool.addSession() == SessionPoolF::npos);
+    assert(pool.removeSession(5) && !pool.hasSession(5) && !pool.removeSession(5));
+    assert(pool.getBreathingAnalyzer(5) == nullptr);
+    assert(pool.addSession() == 5 && pool.getSessionCount() == listeners);
+
+    // Reference: a standalone analyzer and processor for listener 0
+    BreathingAnalyzer reference_breathing(1024, rate);
+    AdaptiveAudioProcessor reference(1024, rate);
+    assert(reference.initialize() && reference.prepareRealtime());
+
+    // The same pipeline split across threads must give identical results
+    SessionPoolF parallel(1024, rate, listeners);
+    assert(parallel.initialize());
+    for (size_t i = 0; i < listeners; ++i) {
+        parallel.addSession();
+    }
+    ThreadPool threads(3);
+
+    const size_t blocks_per_listener = 20 * rate / block;
+    std::vector<std::vector<float>> signals;
+    for (size_t i = 0; i < listeners; ++i) {
+        signals.push_back(listenerSignal(i, blocks_per_listener * block, rate));
+    }
+    std::vector<std::vector<float>> out(listeners, std::vector<float>(block));
+    std::vector<std::vector<float>> out_parallel(listeners, std::vector<float>(block));
+    std::vector<float> reference_out(block);
+    std::vector<SessionBlockF> batch(listeners + 1), batch_parallel(listeners);
+    std::vector<SessionResult> results, results_parallel;
+    BreathingAnalysisResult reference_result;
+    RealtimeAdaptation reference_adaptation;
+    size_t allocations = 0;
+
+    for (size_t b = 0; b < blocks_per_listener; ++b) {
+        for (size_t i = 0; i < listeners; ++i) {
+            const float* input = signals[i].data() + b * block;
+            batch[i] = SessionBlockF{i, input, out[i].data(), block};
+            batch_parallel[i] = SessionBlockF{i, input, out_parallel[i].data(), block};
+        }
+        batch[listeners] = SessionBlockF{99, signals[0].data(), nullptr, block};     // Unknown id
+
+        size_t before = TestSupport::allocationCount();
+        pool.process(batch, results);
+        if (b > 1) {                    // Warm once the first envelope sample is out
+            allocations += TestSupport::allocationCount() - before;
+        }
+        parallel.process(batch_parallel, results_parallel, threads);
+
+        const float* input = signals[0].data() + b * block;
+        reference_result = reference_breathing.analyzeBreathing(input, block);
+        reference_adaptation = reference.processRealtime(input, reference_out.data(), block);
+
+        assert(results.size() == listeners + 1 && !results[listeners].processed);
+        for (size_t i = 0; i < listeners; ++i) {
+            assert(results[i].processed && results_parallel[i].processed);
+            assert(results[i].adaptation.detected_emotion == results_parallel[i].adaptation.detected_emotion);
+            assert(results[i].breathing.breathing_rate == results_parallel[i].breathing.breathing_rate);
+            assert(out[i] == out_parallel[i]);
+        }
+
+        // Sharing the analyzer does not change what a session computes
+        assert(results[0].breathing.breathing_rate == reference_result.breathing_rate);
+        assert(results[0].breathing.current_state == reference_result.current_state);
+        assert(results[0].adaptation.detected_emotion == reference_adaptation.detected_emotion);
+        assert(results[0].adaptation.confidence == reference_adaptation.confidence);
+        assert(out[0] == reference_out);
+    }
+    assert(allocations == 0);
+
+    // Each listener's breathing rate is resolved independently
+    for (size_t i = 0; i < listeners; ++i) {
+        double expected = 10.0 + 2.0 * static_cast<double>(i % 8);
+        assert(std::abs(results[i].breathing.breathing_rate - expected) < 1.0);
+        assert(pool.getMostCommonEmotion(i) != EmotionalState::UNKNOWN);
+        assert(pool.getBreathingAnalyzer(i)->getStatistics().total_analyses == 20);
+    }
+    assert(pool.getMostCommonEmotion(99) == EmotionalState::UNKNOWN);
+
+    // Removing a session forgets its state; the slot starts over
+    assert(pool.removeSession(3) && pool.addSession() == 3);
+    assert(pool.getBreathingAnalyzer(3)->getStatistics().total_analyses == 0);
+    assert(pool.getMostCommonEmotion(3) == EmotionalState::UNKNOWN);
+
+    std::cout << "✓ SessionPool test passed" << std::endl;
+}
@@ -0,0 +1,137 @@
+#include "session_recorder.hpp"
+#include "scene_snapshot.hpp"
+#include "thread_pool.hpp"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+bool sameFields(const std::vector<QuantumSoundField>& a, const std::vector<QuantumSoundField>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].amplitude != b[i].amplitude || a[i].phase != b[i].phase || a[i].frequency != b[i].frequency ||
+            a[i].quantum_state != b[i].quantum_state || a[i].position.r != b[i].position.r ||
+            a[i].position.theta != b[i].position.theta || a[i].position.phi != b[i].position.phi ||
+            a[i].position.height != b[i].position.height) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void test_session_recorder() {
+    std::cout << "Testing session recording and replay..." << std::endl;
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+    std::string scene_path = (directory / "anantasound_session.scene").string();
+    std::string log_path = (directory / "anantasound_session.log").string();
+
+    // A show already running when recording starts: starting scene plus an
+    // unseeded core with elapsed decoherence time
+    AnantaSoundCore live(10.0, 5.0);
+    assert(live.initialize());
+    std::vector<QuantumSoundField> opening;
+    for (int i = 0; i < 40; ++i) {
+        opening.push_back(live.createQuantumSoundField(110.0 + 3.0 * i, {1.0 + 0.1 * i, 0.03 * i, 0.07 * i},
+                                                       QuantumSoundState::SUPERPOSITION));
+    }
+    live.processSoundFields(opening);
+    live.update(0.037);
+    assert(saveScene(scene_path, live));
+
+    ThreadPool pool(2);
+    SessionRecorder recorder;
+    assert(recorder.start(live, log_path) && recorder.isRecording());
+    assert(!recorder.start(live, log_path));
+    for (int step = 0; step < 30; ++step) {
+        live.processSoundField(live.createQuantumSoundField(220.0 + step, {2.0, 0.1 * step, 0.2 * step},
+                                                            step % 3 ? QuantumSoundState::SUPERPOSITION
+                                                                     : QuantumSoundState::COHERENT));
+        if (step % 5 == 0) {
+            std::vector<QuantumSoundField> batch;
+            for (int i = 0; i < 8; ++i) {
+                batch.push_back(live.createQuantumSoundField(300.0 + i, {3.0 + i, 0.2, 0.1 * step},
+                                                             QuantumSoundState::EXCITED));
+            }
+            live.processSoundFields(batch);
+        }
+        if (step == 10) {
+            live.setPhaseCoupling(0.5);
+        }
+        if (step == 20) {
+            live.setNoiseSeed(1234);
+        }
+        if (step % 2) {
+            live.update(0.011, pool);
+        } else {
+            live.update(0.016);
+        }
+    }
+    recorder.stop();
+    assert(!recorder.isRecording());
+    assert(recorder.getDroppedEvents() == 0);
+    assert(recorder.getRecordedEvents() == 30 + 6 * 9 + 2 + 30);
+
+    // Replaying onto the saved scene reproduces the recorded output exactly
+    SessionReplay replay;
+    assert(replay.open(log_path) && replay.isComplete());
+    assert(replay.getEventCount() == recorder.getRecordedEvents());
+    assert(replay.getCallCount() == 30 + 6 + 2 + 30);
+    SceneImage scene;
+    assert(scene.open(scene_path));
+    AnantaSoundCore offline(replay.getHeader().dome_radius, replay.getHeader().dome_height);
+    assert(!replay.run(offline));
+    assert(offline.initialize());
+    assert(scene.restore(offline));
+    SessionReplayStatistics statistics;
+    assert(replay.run(offline, &pool, &statistics));
+    assert(statistics.calls == replay.getCallCount() && statistics.updates == 30);
+    assert(statistics.fields == 30 + 6 * 8);
+    assert(std::abs(statistics.simulated_seconds - (15 * 0.011 + 15 * 0.016)) < 1e-12);
+    std::vector<QuantumSoundField> recorded_output = live.getOutputFields();
+    assert(sameFields(offline.getOutputFields(), recorded_output));
+    assert(offline.getPhaseCoupling() == 0.5);
+    assert(offline.getClock().current().sample == live.getClock().current().sample);
+
+    // A second replay from the same scene gives the same result again
+    AnantaSoundCore again(10.0, 5.0);
+    assert(again.initialize() && scene.restore(again));
+    assert(replay.run(again));
+    assert(sameFields(again.getOutputFields(), recorded_output));
+
+    // A batch that cannot fit the ring is dropped whole and counted
+    SessionRecorder small(4);
+    assert(small.start(again, log_path));
+    std::vector<QuantumSoundField> large(opening.begin(), opening.begin() + 10);
+    again.processSoundFields(large);
+    again.update(0.01);
+    small.stop();
+    assert(small.getDroppedEvents() == 11 && small.getRecordedEvents() == 1);
+    assert(replay.open(log_path) && replay.getCallCount() == 1 && replay.getHeader().dropped_events == 11);
+
+    // Truncated and foreign logs are rejected
+    std::filesystem::resize_file(log_path, std::filesystem::file_size(log_path) - 8);
+    assert(!replay.open(log_path) && !replay.isOpen());
+    {
+        std::ofstream foreign(log_path, std::ios::binary | std::ios::trunc);
+        foreign << std::string(512, 'x');
+    }
+    assert(!replay.open(log_path));
+
+    scene.close();
+    std::remove(scene_path.c_str());
+    std::remove(log_path.c_str());
+
+    std::cout << "✓ Session recording and replay test passed" << std::endl;
+}
@@ -0,0 +1,130 @@
+#include "shared_field_output.hpp"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_shared_field_output() {
+    std::cout << "Testing shared-memory field output..." << std::endl;
+
+    std::string path = (std::filesystem::temp_directory_path() / "anantasound_shared_fields").string();
+
+    AnantaSoundCore core(10.0, 5.0);
+    assert(core.initialize());
+    std::vector<QuantumSoundField> fields;
+    for (int i = 0; i < 100; ++i) {
+        fields.push_back(core.createQuantumSoundField(200.0 + i, {1.0 + 0.05 * i, 0.01 * i, 0.02 * i},
+                                                      QuantumSoundState::COHERENT));
+    }
+    core.processSoundFields(std::vector<QuantumSoundField>(fields.begin(), fields.begin() + 40));
+
+    SharedFieldOutput output;
+    assert(output.open(path, 64) && output.getCapacity() == 64);
+    SharedFieldReader reader;
+    assert(reader.open(path));
+    std::vector<QuantumSoundField> shared;
+    assert(reader.readFields(shared) == 0 && shared.empty());
+
+    // Attaching publishes the current fields right away
+    core.attachSharedOutput(&output);
+    assert(reader.readFields(shared) == 1);
+    std::vector<QuantumSoundField> expected = core.getOutputFields();
+    assert(shared.size() == expected.size());
+    for (size_t i = 0; i < shared.size(); ++i) {
+        assert(shared[i].frequency == expected[i].frequency);
+        assert(shared[i].phase == expected[i].phase);
+        assert(shared[i].amplitude == expected[i].amplitude);
+        assert(shared[i].quantum_state == expected[i].quantum_state);
+        assert(shared[i].position.r == expected[i].position.r);
+    }
+
+    // One frame per update; statistics and clock travel with it
+    core.update(0.01);
+    SharedFieldFrame frame;
+    assert(reader.acquire(frame) && frame.frame == 2 && frame.count == 40);
+    assert(frame.clock_sample == core.getClock().current().sample);
+    assert(frame.coherence_ratio == core.getStatistics().coherence_ratio);
+    assert(reader.validate(frame));
+
+    // Fields beyond capacity are left out and counted
+    core.processSoundFields(std::vector<QuantumSoundField>(fields.begin() + 40, fields.end()));
+    core.update(0.01);
+    assert(reader.acquire(frame) && frame.count == 64 && frame.total_count == 100);
+
+    // A reader two frames behind sees its slot overwritten
+    core.update(0.01);
+    core.update(0.01);
+    core.update(0.01);
+    assert(!reader.validate(frame));
+    assert(reader.acquire(frame) && frame.frame == 6);
+
+    // Concurrent reader: every frame it accepts is complete and in order
+    std::atomic<bool> done{false};
+    std::thread visualizer([&]() {
+        SharedFieldReader concurrent;
+        assert(concurrent.open(path));
+        uint64_t last = 0;
+        std::vector<QuantumSoundField> view;
+        while (!done.load()) {
+            uint64_t number = concurrent.readFields(view);
+            if (number != 0) {
+                assert(number >= last && view.size() == 64);
+                last = number;
+            }
+        }
+    });
+    for (int i = 0; i < 500; ++i) {
+        core.update(0.001);
+    }
+    done = true;
+    visualizer.join();
+    assert(output.getFrame() == 506);
+
+    // Detached: updates no longer write frames
+    core.attachSharedOutput(nullptr);
+    core.update(0.01);
+    assert(reader.getLatestFrame() == 506);
+
+    // Reopening replaces the file whole: an attached reader keeps reading
+    // the old region, a reader opening the path again gets the new one
+    assert(output.open(path, 128) && output.getCapacity() == 128);
+    assert(reader.readFields(shared) == 506 && shared.size() == 64);
+    core.attachSharedOutput(&output);
+    SharedFieldReader reopened;
+    assert(reopened.open(path) && reopened.readFields(shared) == 1 && shared.size() == 100);
+    core.attachSharedOutput(nullptr);
+
+    // A header rewritten in place no longer matches the layout the reader
+    // validated: nothing is indexed with it and the reader asks to reopen
+    {
+        std::fstream patch(path, std::ios::binary | std::ios::in | std::ios::out);
+        uint32_t capacity = 1u << 30;
+        patch.seekp(offsetof(SharedFieldHeader, capacity));
+        patch.write(reinterpret_cast<const char*>(&capacity), sizeof(capacity));
+    }
+    assert(!reopened.reopenRequired());
+    assert(reopened.readFields(shared) == 0 && shared.empty() && reopened.reopenRequired());
+    assert(!reopened.acquire(frame));
+    reopened.close();
+    assert(!reopened.reopenRequired() && !reopened.open(path));
+
+    // Files of another format are rejected
+    output.close();
+    reader.close();
+    {
+        std::ofstream foreign(path, std::ios::binary | std::ios::trunc);
+        foreign << std::string(4096, 'x');
+    }
+    assert(!reader.open(path));
+    std::remove(path.c_str());
+
+    std::cout << "✓ Shared-memory field output test passed" << std::endl;
+}
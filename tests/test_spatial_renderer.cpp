@@ -0,0 +1,159 @@
+#include "spatial_renderer.hpp"
+#include "spectral_kernels.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+double energyOf(const std::vector<double>& gains) {
+    double energy = 0.0;
+    for (double gain : gains) {
+        energy += gain * gain;
+    }
+    return energy;
+}
+
+QuantumSoundField fieldAt(double theta, double phi, double frequency, double amplitude) {
+    QuantumSoundField field;
+    field.amplitude = std::complex<double>(amplitude, 0.0);
+    field.frequency = frequency;
+    field.position = SphericalCoord(1.0, theta, phi);
+    return field;
+}
+
+} // namespace
+
+void test_spatial_renderer() {
+    std::cout << "Testing spatial renderer (VBAP / ambisonics)..." << std::endl;
+
+    // mix_matrix agrees with the scalar kernel at every level, odd sizes included
+    const size_t rows = 3, inputs = 5, frames = 37;
+    std::vector<double> gains(rows * inputs);
+    std::vector<double> input(inputs * frames);
+    for (size_t i = 0; i < gains.size(); ++i) {
+        gains[i] = std::sin(0.7 * i + 0.1);
+    }
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = std::cos(0.31 * i);
+    }
+    std::vector<double> expected(rows * frames, 0.5);
+    getSpectralKernels(SIMDLevel::SCALAR).mix_matrix(gains.data(), rows, inputs, input.data(), frames,
+                                                      expected.data(), frames, frames);
+    std::vector<float> gains_f(gains.begin(), gains.end());
+    std::vector<float> input_f(input.begin(), input.end());
+    for (SIMDLevel level : {SIMDLevel::AVX2, SIMDLevel::AVX512, SIMDLevel::NEON}) {
+        std::vector<double> mixed(rows * frames, 0.5);
+        getSpectralKernels(level).mix_matrix(gains.data(), rows, inputs, input.data(), frames,
+                                             mixed.data(), frames, frames);
+        std::vector<float> mixed_f(rows * frames, 0.5f);
+        getSpectralKernelsF(level).mix_matrix(gains_f.data(), rows, inputs, input_f.data(), frames,
+                                              mixed_f.data(), frames, frames);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            assert(std::abs(mixed[i] - expected[i]) < 1e-12);
+            assert(std::abs(mixed_f[i] - expected[i]) < 1e-5);
+        }
+    }
+
+    // A dome of two rings and a zenith speaker: only the nadir is imaginary
+    SpeakerLayout dome = SpeakerLayout::dome({8, 6}, true);
+    assert(dome.size() == 15);
+    SpatialRendererOptions vbap_options;
+    vbap_options.method = SpatialMethod::VBAP;
+    SpatialRenderer vbap(dome, 48000, vbap_options);
+    assert(vbap.getImaginarySpeakerCount() == 1 && vbap.getTriangleCount() > 0);
+
+    // On a speaker only that speaker sounds; between speakers the gains are
+    // non-negative with unit energy; at the nadir the horizon ring shares it
+    std::vector<double> panning(dome.size());
+    for (size_t speaker = 0; speaker < dome.size(); ++speaker) {
+        vbap.panningGains(dome[speaker], panning.data());
+        for (size_t l = 0; l < dome.size(); ++l) {
+            assert(std::abs(panning[l] - (l == speaker ? 1.0 : 0.0)) < 1e-9);
+        }
+    }
+    for (double theta = 0.05; theta < M_PI; theta += 0.37) {
+        for (double phi = 0.0; phi < 2.0 * M_PI; phi += 0.41) {
+            vbap.panningGains(SpatialDirection::fromSpherical(theta, phi), panning.data());
+            assert(std::abs(energyOf(panning) - 1.0) < 1e-9);
+            assert(std::count_if(panning.begin(), panning.end(), [](double g) { return g < 0.0; }) == 0);
+        }
+    }
+    vbap.panningGains(SpatialDirection{0.0, 0.0, -1.0}, panning.data());
+    for (size_t l = 0; l < 8; ++l) {
+        assert(std::abs(panning[l] - panning[0]) < 1e-9 && panning[l] > 0.0);
+    }
+
+    // AllRAD decoding points a source at its nearest speaker with about unit energy
+    SpatialRenderer ambisonics(dome, 48000);
+    assert(ambisonics.getAmbisonicChannelCount() == 16);
+    for (size_t speaker = 0; speaker < dome.size(); ++speaker) {
+        ambisonics.panningGains(dome[speaker], panning.data());
+        size_t loudest = std::max_element(panning.begin(), panning.end()) - panning.begin();
+        assert(loudest == speaker);
+        assert(energyOf(panning) > 0.5 && energyOf(panning) < 2.0);
+    }
+
+    // Rendering: one field on a speaker drives only that speaker with the
+    // field's sinusoid, and split blocks continue the same waveform
+    std::vector<QuantumSoundField> fields;
+    fields.push_back(fieldAt(M_PI / 2.0, 2.0 * M_PI * 3.0 / 8.0, 440.0, 0.5));
+    FieldBuffer buffer(fields);
+    AudioBuffer whole;
+    vbap.render(buffer, 512, whole);
+    assert(whole.getChannelCount() == dome.size() && !whole.isInterleaved());
+    for (size_t t = 0; t < 512; t += 17) {
+        double expected_sample = 0.5 * std::cos(2.0 * M_PI * 440.0 * t / 48000.0);
+        assert(std::abs(whole.at(t, 3) - expected_sample) < 1e-9);
+        assert(std::abs(whole.at(t, 2)) < 1e-9 && std::abs(whole.at(t, 4)) < 1e-9);
+    }
+    vbap.reset();
+    AudioBuffer first;
+    AudioBuffer second;
+    vbap.render(buffer, 200, first);
+    vbap.render(buffer, 312, second);
+    for (size_t t = 0; t < 312; ++t) {
+        assert(std::abs(second.at(t, 3) - whole.at(200 + t, 3)) < 1e-9);
+    }
+
+    // Ambisonic rendering of many fields equals the sum of their panned sinusoids
+    fields.clear();
+    for (size_t i = 0; i < 100; ++i) {
+        fields.push_back(fieldAt(0.2 + 0.013 * i, 0.37 * i, 100.0 + 37.0 * i, 0.01 * (i % 7 + 1)));
+    }
+    buffer.assign(fields);
+    AudioBuffer rendered;
+    ambisonics.reset();
+    ambisonics.render(buffer, 256, rendered);
+    std::vector<double> reference(dome.size() * 256, 0.0);
+    for (const QuantumSoundField& field : fields) {
+        ambisonics.panningGains(SpatialDirection::fromSpherical(field.position), panning.data());
+        for (size_t t = 0; t < 256; ++t) {
+            double sample = field.amplitude.real() * std::cos(2.0 * M_PI * field.frequency * t / 48000.0);
+            for (size_t l = 0; l < dome.size(); ++l) {
+                reference[l * 256 + t] += panning[l] * sample;
+            }
+        }
+    }
+    for (size_t i = 0; i < reference.size(); ++i) {
+        assert(std::abs(rendered.samples()[i] - reference[i]) < 1e-9);
+    }
+
+    // Steady-state blocks render without allocating
+    size_t before = TestSupport::allocationCount();
+    {
+        TestSupport::AllocationTrap trap;
+        for (int block = 0; block < 4; ++block) {
+            ambisonics.render(buffer, 256, rendered);
+            vbap.render(buffer, 256, rendered);
+        }
+    }
+    assert(TestSupport::allocationCount() == before);
+
+    std::cout << "✓ Spatial renderer test passed (" << ambisonics.getTriangleCount() << " triangles)" << std::endl;
+}
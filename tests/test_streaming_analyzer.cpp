@@ -0,0 +1,98 @@
+#include "streaming_analyzer.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_streaming_analyzer_frames() {
+    std::cout << "Testing StreamingAnalyzer frames..." << std::endl;
+    
+    const size_t fft_size = 512;
+    const size_t hop_size = 128;
+    std::vector<double> signal(4096);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 0.4 * std::sin(2.0 * M_PI * 440.0 * i / 44100.0) +
+                    0.2 * std::sin(2.0 * M_PI * 1750.0 * i / 44100.0);
+    }
+    
+    AudioAnalyzer reference(fft_size, 44100);
+    assert(reference.initialize());
+    reference.setHopSize(hop_size);
+    auto expected = reference.analyzeAudioWithOverlap(signal);
+    assert(expected.size() == (signal.size() - fft_size) / hop_size + 1);
+    
+    StreamingAnalyzer streaming(fft_size, 44100, hop_size);
+    assert(streaming.initialize());
+    assert(streaming.getLatencySamples() == fft_size);
+    
+    std::vector<AudioAnalysisResult> frames;
+    streaming.setFrameCallback([&frames](const AudioAnalysisResult& frame) {
+        frames.push_back(frame);
+    });
+    
+    // Irregular chunk sizes, as a capture callback would deliver them
+    const size_t chunk_sizes[] = {1, 37, 128, 300, 511, 1000, 64};
+    size_t position = 0;
+    size_t chunk_index = 0;
+    size_t emitted = 0;
+    while (position < signal.size()) {
+        size_t chunk = std::min(chunk_sizes[chunk_index++ % 7], signal.size() - position);
+        emitted += streaming.pushSamples(signal.data() + position, chunk);
+        position += chunk;
+    }
+    
+    assert(emitted == expected.size());
+    assert(frames.size() == expected.size());
+    assert(streaming.getFramesEmitted() == expected.size());
+    assert(streaming.getSamplesPushed() == signal.size());
+    
+    for (size_t f = 0; f < frames.size(); ++f) {
+        assert(frames[f].magnitude_spectrum.size() == expected[f].magnitude_spectrum.size());
+        for (size_t k = 0; k < frames[f].magnitude_spectrum.size(); ++k) {
+            assert(std::abs(frames[f].magnitude_spectrum[k] - expected[f].magnitude_spectrum[k]) < 1e-9);
+        }
+        assert(std::abs(frames[f].volume_level - expected[f].volume_level) < 1e-12);
+        assert(std::abs(frames[f].fundamental_frequency - expected[f].fundamental_frequency) < 1e-9);
+    }
+    
+    // Window view holds the most recent samples in order
+    const double* window = streaming.getCurrentWindow();
+    for (size_t i = 0; i < fft_size; ++i) {
+        assert(window[i] == signal[signal.size() - fft_size + i]);
+    }
+    
+    streaming.reset();
+    assert(streaming.getFramesEmitted() == 0);
+    assert(streaming.pushSamples(signal.data(), fft_size - 1) == 0);
+    assert(streaming.pushSamples(signal.data() + fft_size - 1, 1) == 1);
+    
+    std::cout << "✓ StreamingAnalyzer frames test passed" << std::endl;
+}
+
+void test_streaming_analyzer_no_allocation() {
+    std::cout << "Testing StreamingAnalyzer steady-state allocations..." << std::endl;
+    
+    StreamingAnalyzer streaming(1024, 44100, 256);
+    assert(streaming.initialize());
+    
+    std::vector<double> block(256);
+    for (size_t i = 0; i < block.size(); ++i) {
+        block[i] = std::sin(2.0 * M_PI * 880.0 * i / 44100.0);
+    }
+    
+    // Warm up until the first frame has sized the result vectors
+    while (streaming.getFramesEmitted() == 0) {
+        streaming.pushSamples(block);
+    }
+    
+    size_t before = TestSupport::allocationCount();
+    for (int i = 0; i < 100; ++i) {
+        assert(streaming.pushSamples(block) == 1);
+    }
+    assert(TestSupport::allocationCount() == before);
+    
+    std::cout << "✓ StreamingAnalyzer steady-state allocation test passed" << std::endl;
+}
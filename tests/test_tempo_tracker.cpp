@@ -0,0 +1,95 @@
+#include "tempo_tracker.hpp"
+#include "streaming_analyzer.hpp"
+#include "allocation_counter.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaSound;
+
+namespace {
+
+// Decaying 1 kHz clicks on every beat over a quiet low hum
+std::vector<double> clickTrack(double bpm, size_t sample_rate, double seconds) {
+    std::vector<double> samples(static_cast<size_t>(seconds * sample_rate));
+    double period = 60.0 * sample_rate / bpm;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        double since_beat = std::fmod(static_cast<double>(i), period) / sample_rate;
+        samples[i] = 0.05 * std::sin(2.0 * M_PI * 110.0 * i / sample_rate) +
+                     0.8 * std::exp(-since_beat * 60.0) * std::sin(2.0 * M_PI * 1000.0 * i / sample_rate);
+    }
+    return samples;
+}
+
+double streamTempo(const std::vector<double>& signal, size_t sample_rate) {
+    StreamingAnalyzer stream(1024, sample_rate, 256);
+    assert(stream.initialize());
+    double tempo = 0.0;
+    stream.setFrameCallback([&tempo](const AudioAnalysisResult& frame) { tempo = frame.tempo; });
+    stream.pushSamples(signal);
+    assert(tempo == stream.getTempoTracker().getTempo());
+    return tempo;
+}
+
+} // namespace
+
+void test_tempo_tracker() {
+    std::cout << "Testing spectral-flux tempo tracker..." << std::endl;
+
+    const size_t sample_rate = 22050;
+
+    // Tempos across the range, including ones the old ZCR estimate clamped
+    for (double bpm : {72.0, 96.0, 120.0, 150.0, 185.0}) {
+        double tempo = streamTempo(clickTrack(bpm, sample_rate, 12.0), sample_rate);
+        assert(std::abs(tempo - bpm) < bpm * 0.02);
+    }
+
+    // No estimate until two periods of the slowest tempo are buffered
+    TempoTracker tracker(1024, sample_rate, 256);
+    std::vector<double> magnitude(513, 0.0);
+    for (int frame = 0; frame < 100; ++frame) {
+        magnitude[40] = frame % 43 == 0 ? 1.0 : 0.0;
+        assert(tracker.pushSpectrum(magnitude.data(), magnitude.size()) == 0.0);
+    }
+    assert(tracker.getOnsetStrength() == 0.0);
+
+    // Pushing allocates nothing; the estimate runs a few times per second
+    size_t before = TestSupport::allocationCount();
+    for (int frame = 100; frame < 1000; ++frame) {
+        magnitude[40] = frame % 43 == 0 ? 1.0 : 0.0;
+        tracker.pushSpectrum(magnitude.data(), magnitude.size());
+    }
+    assert(TestSupport::allocationCount() == before);
+    double expected = 60.0 * sample_rate / 256.0 / 43.0;
+    assert(std::abs(tracker.getTempo() - expected) < 1.0 && tracker.getConfidence() > 0.5);
+
+    // Float spectra give the same envelope
+    TempoTracker single(1024, sample_rate, 256, TempoTrackerOptions(), tracker.getPlan());
+    std::vector<float> magnitude_f(513, 0.0f);
+    for (int frame = 0; frame < 1000; ++frame) {
+        magnitude_f[40] = frame % 43 == 0 ? 1.0f : 0.0f;
+        single.pushSpectrum(magnitude_f.data(), magnitude_f.size());
+    }
+    assert(single.getPlan() == tracker.getPlan() && std::abs(single.getTempo() - tracker.getTempo()) < 1e-9);
+
+    // Silence and a changed hop clear the estimate
+    tracker.setHopSize(512);
+    assert(tracker.getTempo() == 0.0 && tracker.getFramesPushed() == 0);
+    std::vector<double> silence(513, 0.0);
+    for (int frame = 0; frame < 400; ++frame) {
+        tracker.pushSpectrum(silence.data(), silence.size());
+    }
+    assert(tracker.getTempo() == 0.0 && tracker.getConfidence() == 0.0);
+
+    // Overlapped analysis carries the running tempo; lone frames carry none
+    std::vector<double> beat = clickTrack(120.0, sample_rate, 10.0);
+    AudioAnalyzer analyzer(1024, sample_rate);
+    assert(analyzer.initialize());
+    analyzer.setHopSize(256);
+    auto frames = analyzer.analyzeAudioWithOverlap(beat);
+    assert(frames.front().tempo == 0.0 && std::abs(frames.back().tempo - 120.0) < 2.4);
+    assert(analyzer.analyzeAudio(std::vector<double>(beat.begin(), beat.begin() + 1024)).tempo == 0.0);
+
+    std::cout << "✓ Spectral-flux tempo tracker test passed" << std::endl;
+}
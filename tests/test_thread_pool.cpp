@@ -0,0 +1,176 @@
+#include "thread_pool.hpp"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+
+using namespace AnantaSound;
+
+void test_thread_pool_parallel_for() {
+    std::cout << "Testing ThreadPool parallelFor..." << std::endl;
+    
+    ThreadPool pool(4);
+    assert(pool.getWorkerCount() == 4);
+    assert(pool.getConcurrency() == 5);
+    
+    // Every index visited exactly once, slots within range
+    std::vector<std::atomic<int>> visits(10007);
+    std::atomic<bool> slot_in_range{true};
+    pool.parallelFor(visits.size(), 13, [&](size_t begin, size_t end, size_t slot) {
+        if (slot >= pool.getConcurrency()) {
+            slot_in_range = false;
+        }
+        for (size_t i = begin; i < end; ++i) {
+            visits[i].fetch_add(1);
+        }
+    });
+    assert(slot_in_range);
+    for (const auto& v : visits) {
+        assert(v.load() == 1);
+    }
+    
+    // Nested calls complete without deadlock
+    std::atomic<size_t> nested_total{0};
+    pool.parallelFor(8, 1, [&](size_t, size_t, size_t) {
+        pool.parallelFor(100, 10, [&](size_t begin, size_t end, size_t) {
+            nested_total.fetch_add(end - begin);
+        });
+    });
+    assert(nested_total.load() == 800);
+    
+    // Exceptions surface in the caller
+    bool caught = false;
+    try {
+        pool.parallelFor(64, 1, [](size_t begin, size_t, size_t) {
+            if (begin == 17) {
+                throw std::runtime_error("chunk failed");
+            }
+        });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+    
+    // Pool without workers runs inline
+    ThreadPool inline_pool(0);
+    size_t total = 0;
+    inline_pool.parallelFor(50, 7, [&](size_t begin, size_t end, size_t) {
+        total += end - begin;
+    });
+    assert(total == 50);
+    
+    std::cout << "✓ ThreadPool parallelFor test passed" << std::endl;
+}
+
+void test_thread_pool_submit() {
+    std::cout << "Testing ThreadPool submit..." << std::endl;
+    
+    std::atomic<int> counter{0};
+    {
+        ThreadPool pool(3);
+        for (int i = 0; i < 1000; ++i) {
+            pool.submit([&counter]() { counter.fetch_add(1); });
+        }
+        // Destructor drains queued tasks
+    }
+    assert(counter.load() == 1000);
+    
+    std::cout << "✓ ThreadPool submit test passed" << std::endl;
+}
+
+void test_thread_pool_lanes() {
+    std::cout << "Testing ThreadPool lanes and timers..." << std::endl;
+    
+    auto waitFor = [](auto condition) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!condition() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        return condition();
+    };
+    
+    ThreadPoolOptions options;
+    options.worker_count = 3;
+    options.numa_aware = true;
+    ThreadPool pool(options);
+    assert(pool.getWorkerCount() == 3);
+    assert(pool.getBackgroundWorkerLimit() == 2);
+    auto topology = ThreadPool::getNumaTopology();
+    assert(!topology.empty() && !topology.front().empty());
+    for (size_t i = 0; i < pool.getWorkerCount(); ++i) {
+        assert(pool.getWorkerNode(i) < topology.size());
+    }
+    
+    // Background work never takes the last worker: with every background
+    // slot blocked, HIGH and NORMAL tasks still run
+    std::atomic<bool> release{false};
+    std::atomic<int> background_running{0}, background_peak{0}, background_done{0};
+    for (int i = 0; i < 6; ++i) {
+        pool.submit([&]() {
+            int running = background_running.fetch_add(1) + 1;
+            int peak = background_peak.load();
+            while (running > peak && !background_peak.compare_exchange_weak(peak, running)) {
+            }
+            while (!release.load()) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            background_running.fetch_sub(1);
+            background_done.fetch_add(1);
+        }, TaskPriority::BACKGROUND);
+    }
+    assert(waitFor([&]() { return background_running.load() == 2; }));
+    std::atomic<int> urgent{0};
+    for (int i = 0; i < 20; ++i) {
+        pool.submit([&]() { urgent.fetch_add(1); }, i % 2 ? TaskPriority::HIGH : TaskPriority::NORMAL);
+    }
+    assert(waitFor([&]() { return urgent.load() == 20; }));
+    assert(background_done.load() == 0 && pool.getPendingTasks(TaskPriority::BACKGROUND) == 4);
+    release = true;
+    assert(waitFor([&]() { return background_done.load() == 6; }));
+    assert(background_peak.load() == 2);
+    
+    // Timed tasks run no earlier than due, in deadline order
+    std::mutex order_mutex;
+    std::vector<int> order;
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<long long> first_delay_us{0};
+    for (int i : {3, 1, 2}) {
+        pool.submitAt(start + std::chrono::milliseconds(5 * i), [&, i]() {
+            if (i == 1) {
+                first_delay_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+            }
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.push_back(i);
+        }, TaskPriority::HIGH);
+    }
+    assert(waitFor([&]() { std::lock_guard<std::mutex> lock(order_mutex); return order.size() == 3; }));
+    assert(first_delay_us.load() >= 5000);
+    assert((order == std::vector<int>{1, 2, 3}));
+    
+    // A far-off timer is dropped with the pool
+    std::atomic<bool> fired{false};
+    {
+        ThreadPool short_lived(1);
+        short_lived.submitAfter(std::chrono::seconds(30), [&fired]() { fired = true; });
+    }
+    assert(!fired.load());
+    
+    // The shared pool is configured before first use only
+    ThreadPool::shared();
+    assert(!ThreadPool::configureShared(options));
+    
+    // Pinning a thread to CPUs it may use succeeds where supported
+#if defined(__linux__)
+    bool pinned = false;
+    std::thread pinning([&]() { pinned = ThreadPool::setCurrentThreadAffinity(topology.front()); });
+    pinning.join();
+    assert(pinned);
+#endif
+    
+    std::cout << "✓ ThreadPool lanes and timers test passed (" << topology.size() << " NUMA node(s))" << std::endl;
+}
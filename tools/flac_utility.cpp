@@ -1,9 +1,12 @@
 #include "../src/audio_analyzer.hpp"
+#include "../src/batch_analyzer.hpp"
+#include "../src/feature_cache.hpp"
 #include <iostream>
 #include <string>
 #include <filesystem>
 #include <vector>
 #include <algorithm>
+#include <iomanip>
 
 using namespace AnantaSound;
 namespace fs = std::filesystem;
@@ -15,8 +18,10 @@ void printUsage() {
     std::cout << "Commands:" << std::endl;
     std::cout << "  validate <file>     - Validate FLAC file quality" << std::endl;
     std::cout << "  info <file>         - Show detailed file information" << std::endl;
-    std::cout << "  analyze <file>      - Perform full audio analysis" << std::endl;
-    std::cout << "  batch <directory>   - Analyze all FLAC files in directory" << std::endl;
+    std::cout << "  analyze <file> [--cache <dir>|--no-cache]" << std::endl;
+    std::cout << "                      - Perform full audio analysis (features cached in .anantasound_cache)" << std::endl;
+    std::cout << "  batch <directory> [report.csv|report.json] [--jobs N] [--decoders N]" << std::endl;
+    std::cout << "                      - Analyze all FLAC/WAV files under directory in parallel" << std::endl;
     std::cout << "  convert <input> <output> - Convert audio format" << std::endl;
     std::cout << "  normalize <input> <output> [level] - Normalize audio" << std::endl;
     std::cout << "  resample <input> <output> <rate> - Change sample rate" << std::endl;
@@ -25,7 +30,7 @@ void printUsage() {
     std::cout << "  flac_utility validate sample.flac" << std::endl;
     std::cout << "  flac_utility info sample.flac" << std::endl;
     std::cout << "  flac_utility analyze sample.flac" << std::endl;
-    std::cout << "  flac_utility batch ./samples" << std::endl;
+    std::cout << "  flac_utility batch ./samples features.json --jobs 8" << std::endl;
     std::cout << "  flac_utility convert input.wav output.flac" << std::endl;
     std::cout << "  flac_utility normalize input.flac output.flac -1.0" << std::endl;
     std::cout << "  flac_utility resample input.flac output.flac 48000" << std::endl;
@@ -71,11 +76,15 @@ void showFileInfo(const std::string& filepath) {
     std::cout << info << std::endl;
 }
 
-void analyzeAudioFile(const std::string& filepath) {
+void analyzeAudioFile(const std::string& filepath, const std::string& cache_directory) {
     std::cout << "🔬 Full Audio Analysis: " << filepath << std::endl;
     std::cout << "=====================================" << std::endl;
     
     AudioAnalyzer analyzer;
+    FeatureCache cache(cache_directory);
+    if (!cache_directory.empty()) {
+        analyzer.setFeatureCache(&cache);
+    }
     
     if (!analyzer.loadAudioFile(filepath)) {
         std::cerr << "❌ Failed to load audio file" << std::endl;
@@ -111,6 +120,10 @@ void analyzeAudioFile(const std::string& filepath) {
               << spectral.spectral_centroid << " Hz" << std::endl;
     std::cout << "  Spectral Bandwidth: " << std::fixed << std::setprecision(1) 
               << spectral.spectral_bandwidth << " Hz" << std::endl;
+    if (!cache_directory.empty()) {
+        std::cout << "  Feature Cache: " << (cache.getHits() > 0 ? "hit" : "miss")
+                  << " (" << cache_directory << ")" << std::endl;
+    }
     
     // Экспортируем отчет
     std::string report_path = "analysis_report_" + 
@@ -120,7 +133,8 @@ void analyzeAudioFile(const std::string& filepath) {
     }
 }
 
-void batchAnalyzeDirectory(const std::string& directory) {
+void batchAnalyzeDirectory(const std::string& directory, const std::string& report_path,
+                           const BatchAnalysisOptions& options) {
     std::cout << "📁 Batch Analysis of Directory: " << directory << std::endl;
     std::cout << "=====================================" << std::endl;
     
@@ -129,45 +143,36 @@ void batchAnalyzeDirectory(const std::string& directory) {
         return;
     }
     
-    std::vector<std::string> flac_files;
-    
-    // Собираем все FLAC файлы
-    for (const auto& entry : fs::directory_iterator(directory)) {
-        if (entry.is_regular_file()) {
-            std::string ext = entry.path().extension().string();
-            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-            
-            if (ext == ".flac") {
-                flac_files.push_back(entry.path().string());
-            }
-        }
-    }
-    
-    if (flac_files.empty()) {
-        std::cout << "ℹ️  No FLAC files found in directory" << std::endl;
+    BatchReportWriter writer;
+    if (!writer.open(report_path)) {
         return;
     }
     
-    std::cout << "Found " << flac_files.size() << " FLAC files:" << std::endl;
-    for (const auto& file : flac_files) {
-        std::cout << "  - " << fs::path(file).filename().string() << std::endl;
-    }
-    
-    std::cout << "\nStarting batch analysis..." << std::endl;
+    BatchAnalyzer batch(options);
+    std::cout << "Decoders: " << batch.getOptions().decoder_threads
+              << ", analyzers: " << batch.getOptions().analyzer_threads << std::endl;
     
-    int success_count = 0;
-    for (const auto& file : flac_files) {
-        std::cout << "\n🔍 Analyzing: " << fs::path(file).filename().string() << std::endl;
-        
-        if (validateFLACFile(file)) {
-            success_count++;
+    // Reports arrive in completion order while decoding and analysis continue
+    BatchAnalysisSummary summary = batch.run(directory, [&](const BatchFileReport& report) {
+        writer.write(report);
+        if (report.ok) {
+            std::cout << "✅ " << report.path << std::endl;
+        } else {
+            std::cerr << "❌ " << report.path << ": " << report.error << std::endl;
         }
-        
-        std::cout << "---" << std::endl;
+    });
+    writer.close();
+    
+    if (summary.files == 0) {
+        std::cout << "ℹ️  No audio files found in directory" << std::endl;
+        return;
     }
     
     std::cout << "\n📊 Batch Analysis Complete!" << std::endl;
-    std::cout << "Successfully analyzed: " << success_count << "/" << flac_files.size() << " files" << std::endl;
+    std::cout << "Successfully analyzed: " << summary.succeeded << "/" << summary.files << " files" << std::endl;
+    std::cout << "Audio: " << std::fixed << std::setprecision(1) << summary.audio_seconds << " s in "
+              << summary.elapsed_seconds << " s" << std::endl;
+    std::cout << "📄 Report written to: " << report_path << std::endl;
 }
 
 void convertAudioFormat(const std::string& input, const std::string& output) {
@@ -225,9 +230,30 @@ int main(int argc, char* argv[]) {
         } else if (command == "info" && argc >= 3) {
             showFileInfo(argv[2]);
         } else if (command == "analyze" && argc >= 3) {
-            analyzeAudioFile(argv[2]);
+            std::string cache_directory = ".anantasound_cache";
+            for (int i = 3; i < argc; ++i) {
+                std::string argument = argv[i];
+                if (argument == "--cache" && i + 1 < argc) {
+                    cache_directory = argv[++i];
+                } else if (argument == "--no-cache") {
+                    cache_directory.clear();
+                }
+            }
+            analyzeAudioFile(argv[2], cache_directory);
         } else if (command == "batch" && argc >= 3) {
-            batchAnalyzeDirectory(argv[2]);
+            std::string report_path = "batch_report.csv";
+            BatchAnalysisOptions options;
+            for (int i = 3; i < argc; ++i) {
+                std::string argument = argv[i];
+                if (argument == "--jobs" && i + 1 < argc) {
+                    options.analyzer_threads = static_cast<size_t>(std::stoul(argv[++i]));
+                } else if (argument == "--decoders" && i + 1 < argc) {
+                    options.decoder_threads = static_cast<size_t>(std::stoul(argv[++i]));
+                } else {
+                    report_path = argument;
+                }
+            }
+            batchAnalyzeDirectory(argv[2], report_path, options);
         } else if (command == "convert" && argc >= 4) {
             convertAudioFormat(argv[2], argv[3]);
         } else if (command == "normalize" && argc >= 4) {